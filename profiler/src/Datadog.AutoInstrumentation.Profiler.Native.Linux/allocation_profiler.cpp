@@ -0,0 +1,336 @@
+#include "allocation_profiler.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "logging.h"
+#include "stack_sampler.h"
+
+namespace datadog::profiler
+{
+
+namespace
+{
+    const WCHAR runtime_provider_name[] = u"Microsoft-Windows-DotNETRuntime";
+    const size_t runtime_provider_name_length = sizeof(runtime_provider_name) / sizeof(WCHAR) - 1;
+
+    struct AllocationThreadState
+    {
+        // Interval the counter was drawn for, 0 until the thread allocates for the first time
+        uint64_t interval;
+        int64_t bytes_until_sample;
+        uint64_t random;
+        uintptr_t stack_low;
+        uintptr_t stack_high;
+    };
+
+    // Zero-initialized, the first allocation of a thread takes the slow path which initializes it. initial-exec
+    // saves the __tls_get_addr call of a dlopen'ed library, the state fits in the static TLS surplus.
+    thread_local AllocationThreadState t_allocation_state __attribute__((tls_model("initial-exec"))) = {};
+
+    int64_t NextSampleDistance(AllocationThreadState* state)
+    {
+        // xorshift64, then an exponentially distributed distance whose mean is the interval
+        state->random ^= state->random << 13;
+        state->random ^= state->random >> 7;
+        state->random ^= state->random << 17;
+        const double uniform = (double) ((state->random >> 11) + 1) / 9007199254740992.0;
+        return (int64_t) (-std::log(uniform) * (double) state->interval) + 1;
+    }
+
+    template <typename T>
+    bool Read(const BYTE* data, ULONG size, ULONG* offset, T* value)
+    {
+        if (*offset + sizeof(T) > size)
+        {
+            return false;
+        }
+        memcpy(value, data + *offset, sizeof(T));
+        *offset += sizeof(T);
+        return true;
+    }
+} // namespace
+
+bool ParseAllocationTick(DWORD eventVersion, const BYTE* data, ULONG size, AllocationTick* tick)
+{
+    // AllocationAmount, AllocationKind, ClrInstanceID, AllocationAmount64, TypeID, TypeName, HeapIndex,
+    // Address (version 3+) and ObjectSize (version 4+)
+    if (eventVersion < 2)
+    {
+        return false;
+    }
+
+    ULONG offset = 0;
+    uint32_t amount32 = 0;
+    uint32_t kind = 0;
+    uint16_t clrInstanceId = 0;
+    uint64_t amount = 0;
+    uintptr_t classId = 0;
+    if (!Read(data, size, &offset, &amount32) || !Read(data, size, &offset, &kind) ||
+        !Read(data, size, &offset, &clrInstanceId) || !Read(data, size, &offset, &amount) ||
+        !Read(data, size, &offset, &classId))
+    {
+        return false;
+    }
+
+    const auto* typeName = reinterpret_cast<const WCHAR*>(data + offset);
+    size_t typeNameLength = 0;
+    uint16_t character = 0;
+    while (Read(data, size, &offset, &character) && character != 0)
+    {
+        typeNameLength++;
+    }
+    if (character != 0)
+    {
+        return false;
+    }
+
+    uint32_t heapIndex = 0;
+    uintptr_t address = 0;
+    uint64_t objectSize = 0;
+    if (eventVersion >= 4 &&
+        !(Read(data, size, &offset, &heapIndex) && Read(data, size, &offset, &address) &&
+          Read(data, size, &offset, &objectSize)))
+    {
+        objectSize = 0;
+    }
+
+    tick->amount = amount;
+    tick->class_id = classId;
+    tick->object_size = objectSize;
+    tick->type_name = typeName;
+    tick->type_name_length = typeNameLength;
+    return true;
+}
+
+AllocationProfiler::AllocationProfiler(ICorProfilerInfo4* info, ICorProfilerInfo12* eventPipeInfo,
+                                       uint64_t samplingInterval, size_t capacity) :
+    m_info(info),
+    m_event_pipe_info(eventPipeInfo),
+    m_source(eventPipeInfo != nullptr ? AllocationSource::EventPipe : AllocationSource::ObjectAllocated),
+    m_sampling_interval(samplingInterval == 0 ? 1 : samplingInterval),
+    m_table(capacity)
+{
+}
+
+AllocationProfiler::~AllocationProfiler()
+{
+    Stop();
+}
+
+HRESULT AllocationProfiler::Start()
+{
+    if (m_source != AllocationSource::EventPipe || m_session != 0)
+    {
+        return S_OK;
+    }
+
+    COR_PRF_EVENTPIPE_PROVIDER_CONFIG config = {runtime_provider_name, runtime_gc_keyword, runtime_verbose_level,
+                                                nullptr};
+    const HRESULT hr = m_event_pipe_info->EventPipeStartSession(1, &config, FALSE, &m_session);
+    if (FAILED(hr))
+    {
+        Warn("AllocationProfiler: unable to start the EventPipe session, hr=", hr);
+        m_session = 0;
+    }
+    return hr;
+}
+
+void AllocationProfiler::Stop()
+{
+    if (m_session != 0)
+    {
+        m_event_pipe_info->EventPipeStopSession(m_session);
+        m_session = 0;
+    }
+}
+
+AllocationSource AllocationProfiler::GetSource() const
+{
+    return m_source;
+}
+
+uint64_t AllocationProfiler::GetSamplingInterval() const
+{
+    return m_sampling_interval;
+}
+
+void AllocationProfiler::OnObjectAllocated(ObjectID objectId, ClassID classId)
+{
+    // The counter is in bytes, so the size comes before the sampling decision. GetObjectSize2 only reads the
+    // object header: on .NET Core 3.1 it adds about 1ns to the ~60ns of the ObjectAllocated callback itself,
+    // within the noise, where a plain allocation takes ~15ns.
+    SIZE_T size = 0;
+    if (m_info == nullptr || FAILED(m_info->GetObjectSize2(objectId, &size)))
+    {
+        return;
+    }
+    RecordAllocation(classId, size);
+}
+
+void AllocationProfiler::RecordAllocation(uintptr_t classId, uint64_t size)
+{
+    // Every allocation of the process gets here, the common case must stay a subtraction and a branch
+    auto& state = t_allocation_state;
+    state.bytes_until_sample -= (int64_t) size;
+    if (state.bytes_until_sample > 0)
+    {
+        return;
+    }
+
+    Sample(classId, size);
+}
+
+__attribute__((noinline)) void AllocationProfiler::Sample(uintptr_t classId, uint64_t size)
+{
+    auto& state = t_allocation_state;
+    if (state.interval != m_sampling_interval)
+    {
+        // First allocation of the thread, its counter was never drawn
+        state.interval = m_sampling_interval;
+        state.random = ((uint64_t) syscall(SYS_gettid) * 0x9E3779B97F4A7C15ull) ^
+                       (uint64_t) std::chrono::steady_clock::now().time_since_epoch().count();
+        if (state.random == 0)
+        {
+            state.random = 1;
+        }
+        GetCurrentThreadStack(&state.stack_low, &state.stack_high);
+        state.bytes_until_sample = NextSampleDistance(&state);
+        return;
+    }
+
+    state.bytes_until_sample = NextSampleDistance(&state);
+
+    const double probability = 1 - std::exp(-(double) size / (double) m_sampling_interval);
+    const auto count = (uint64_t) std::llround(1 / probability);
+    const auto bytes = (uint64_t) std::llround((double) size / probability);
+
+    uintptr_t frames[max_allocation_stack_depth];
+    uint32_t frameCount = 0;
+    bool truncated = false;
+    if (state.stack_high != 0)
+    {
+        const auto fp = reinterpret_cast<uintptr_t>(__builtin_frame_address(0));
+        frameCount = WalkFramePointers(fp, fp, state.stack_high, frames, max_allocation_stack_depth, &truncated);
+    }
+
+    m_table.Add(classId, frames, frameCount, truncated, count, bytes);
+    m_samples.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool AllocationProfiler::IsRuntimeProvider(EVENTPIPE_PROVIDER provider)
+{
+    const auto runtimeProvider = m_runtime_provider.load(std::memory_order_relaxed);
+    if (runtimeProvider != 0)
+    {
+        return provider == runtimeProvider;
+    }
+
+    if (m_event_pipe_info == nullptr)
+    {
+        return false;
+    }
+
+    WCHAR name[64];
+    ULONG length = 0;
+    if (FAILED(m_event_pipe_info->EventPipeGetProviderInfo(provider, 64, &length, name)))
+    {
+        return false;
+    }
+
+    // length includes the null terminator
+    if (length == runtime_provider_name_length + 1 &&
+        memcmp(name, runtime_provider_name, runtime_provider_name_length * sizeof(WCHAR)) == 0)
+    {
+        m_runtime_provider = provider;
+        return true;
+    }
+    return false;
+}
+
+void AllocationProfiler::OnEventDelivered(EVENTPIPE_PROVIDER provider, DWORD eventId, DWORD eventVersion,
+                                          const BYTE* data, ULONG size, ULONG frameCount, const UINT_PTR frames[])
+{
+    if (eventId == allocation_tick_event_id && IsRuntimeProvider(provider))
+    {
+        OnAllocationTick(eventVersion, data, size, frameCount, frames);
+    }
+}
+
+void AllocationProfiler::OnAllocationTick(DWORD eventVersion, const BYTE* data, ULONG size, ULONG frameCount,
+                                          const UINT_PTR frames[])
+{
+    AllocationTick tick;
+    if (!ParseAllocationTick(eventVersion, data, size, &tick))
+    {
+        return;
+    }
+    m_events.fetch_add(1, std::memory_order_relaxed);
+
+    // The event stands for every byte allocated since the previous one, the objects are assumed to be of the
+    // size of the one that triggered it
+    const auto count = tick.object_size > 0 && tick.amount > tick.object_size ? tick.amount / tick.object_size : 1;
+    const auto truncated = frameCount > max_allocation_stack_depth;
+    m_table.Add(tick.class_id, reinterpret_cast<const uintptr_t*>(frames),
+                truncated ? max_allocation_stack_depth : frameCount, truncated, count, tick.amount);
+    m_samples.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> guard(m_type_names_mutex);
+    if (tick.type_name_length > 0 && m_type_names.find(tick.class_id) == m_type_names.end())
+    {
+        // Only ASCII is kept as is, type names rarely have anything else
+        std::string name(tick.type_name_length, '?');
+        for (size_t i = 0; i < tick.type_name_length; i++)
+        {
+            uint16_t character;
+            memcpy(&character, tick.type_name + i, sizeof(character));
+            if (character < 0x80)
+            {
+                name[i] = (char) character;
+            }
+        }
+        m_type_names.emplace(tick.class_id, std::move(name));
+    }
+}
+
+size_t AllocationProfiler::Drain(std::vector<AllocationEntry>* entries)
+{
+    return m_table.Drain(entries);
+}
+
+bool AllocationProfiler::GetTypeName(uintptr_t classId, std::string* name)
+{
+    std::lock_guard<std::mutex> guard(m_type_names_mutex);
+    const auto found = m_type_names.find(classId);
+    if (found == m_type_names.end())
+    {
+        return false;
+    }
+    *name = found->second;
+    return true;
+}
+
+uint64_t AllocationProfiler::GetSampleCount() const
+{
+    return m_samples.load();
+}
+
+uint64_t AllocationProfiler::GetDroppedCount()
+{
+    return m_table.GetDroppedCount();
+}
+
+std::string AllocationProfiler::ToString()
+{
+    std::ostringstream ss;
+    ss << "AllocationProfiler [Source=" << (m_source == AllocationSource::EventPipe ? "EventPipe" : "ObjectAllocated")
+       << ", Interval=" << m_sampling_interval << "B, Samples=" << m_samples.load()
+       << ", AllocationTicks=" << m_events.load() << ", Dropped=" << m_table.GetDroppedCount() << "]";
+    return ss.str();
+}
+
+} // namespace datadog::profiler
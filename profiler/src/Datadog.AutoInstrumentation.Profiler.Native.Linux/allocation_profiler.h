@@ -0,0 +1,117 @@
+#ifndef DD_PROFILER_ALLOCATION_PROFILER_H_
+#define DD_PROFILER_ALLOCATION_PROFILER_H_
+
+#include "cor.h"
+#include "corprof.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "allocation_table.h"
+
+namespace datadog::profiler
+{
+
+// AllocationTick of the runtime provider, raised every 100KB allocated or so, see ClrEtwAll.man in dotnet/runtime
+const DWORD allocation_tick_event_id = 10;
+const uint64_t runtime_gc_keyword = 0x1;
+const uint32_t runtime_verbose_level = 5;
+
+struct AllocationTick
+{
+    // Bytes allocated since the previous event, in objects of any type
+    uint64_t amount;
+    uintptr_t class_id;
+    // Size of the object that triggered the event, 0 before version 4
+    uint64_t object_size;
+    // Points into the payload
+    const WCHAR* type_name;
+    size_t type_name_length;
+};
+
+// Parses an AllocationTick payload, version 2 and later carry the ClassID.
+bool ParseAllocationTick(DWORD eventVersion, const BYTE* data, ULONG size, AllocationTick* tick);
+
+enum class AllocationSource
+{
+    // AllocationTick events of an in-process EventPipe session (ICorProfilerInfo12, .NET 5+)
+    EventPipe,
+    // ObjectAllocated callbacks, sampled by the profiler
+    ObjectAllocated
+};
+
+/// <summary>
+/// Samples allocations and aggregates them by class and stack in a bounded AllocationTable.
+///
+/// With EventPipe the runtime already samples: each AllocationTick comes with the managed stack of the
+/// allocation and stands for the bytes allocated since the previous one. Otherwise every allocation goes through
+/// ObjectAllocated, which only decrements a per-thread byte counter; when it crosses zero the allocation is
+/// sampled, its stack captured by walking frame pointers, and the counter reset to an exponentially distributed
+/// number of bytes (a Poisson process over the allocated bytes, as in Go and tcmalloc). A sampled allocation of
+/// size s stands for 1 / (1 - e^(-s / interval)) allocations, which keeps the estimates unbiased for objects much
+/// smaller than the interval.
+/// </summary>
+class AllocationProfiler
+{
+private:
+    ICorProfilerInfo4* m_info;
+    ICorProfilerInfo12* m_event_pipe_info;
+    AllocationSource m_source;
+    uint64_t m_sampling_interval;
+    EVENTPIPE_SESSION m_session = 0;
+    std::atomic<EVENTPIPE_PROVIDER> m_runtime_provider = {0};
+
+    AllocationTable m_table;
+
+    // Type names of the AllocationTick payloads, saves resolving the classes through the metadata
+    std::mutex m_type_names_mutex;
+    std::unordered_map<uintptr_t, std::string> m_type_names;
+
+    std::atomic<uint64_t> m_samples = {0};
+    std::atomic<uint64_t> m_events = {0};
+
+    bool IsRuntimeProvider(EVENTPIPE_PROVIDER provider);
+    void Sample(uintptr_t classId, uint64_t size);
+
+public:
+    // eventPipeInfo is null on runtimes without EventPipe, allocations are then sampled from ObjectAllocated.
+    // Both can be null, allocations are then only fed through RecordAllocation and OnAllocationTick.
+    AllocationProfiler(ICorProfilerInfo4* info, ICorProfilerInfo12* eventPipeInfo, uint64_t samplingInterval,
+                       size_t capacity = default_allocation_table_capacity);
+    ~AllocationProfiler();
+
+    // Starts the EventPipe session. The profiler must have set COR_PRF_HIGH_MONITOR_EVENT_PIPE, or
+    // COR_PRF_ENABLE_OBJECT_ALLOCATED and COR_PRF_MONITOR_OBJECT_ALLOCATED without EventPipe.
+    HRESULT Start();
+    void Stop();
+
+    AllocationSource GetSource() const;
+    uint64_t GetSamplingInterval() const;
+
+    // ObjectAllocated callback
+    void OnObjectAllocated(ObjectID objectId, ClassID classId);
+    // Counts the allocation towards the next sample of the calling thread
+    void RecordAllocation(uintptr_t classId, uint64_t size);
+
+    // EventPipeEventDelivered callback, the other events are ignored
+    void OnEventDelivered(EVENTPIPE_PROVIDER provider, DWORD eventId, DWORD eventVersion, const BYTE* data,
+                          ULONG size, ULONG frameCount, const UINT_PTR frames[]);
+    void OnAllocationTick(DWORD eventVersion, const BYTE* data, ULONG size, ULONG frameCount,
+                          const UINT_PTR frames[]);
+
+    // Moves the aggregated samples out, see AllocationTable::Drain.
+    size_t Drain(std::vector<AllocationEntry>* entries);
+    // Type name received with the AllocationTick events
+    bool GetTypeName(uintptr_t classId, std::string* name);
+
+    uint64_t GetSampleCount() const;
+    uint64_t GetDroppedCount();
+    std::string ToString();
+};
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_ALLOCATION_PROFILER_H_
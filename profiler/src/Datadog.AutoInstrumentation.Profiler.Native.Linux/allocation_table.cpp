@@ -0,0 +1,120 @@
+#include "allocation_table.h"
+
+#include <cstring>
+
+namespace datadog::profiler
+{
+
+namespace
+{
+    uint64_t Hash(uintptr_t classId, const uintptr_t* frames, uint32_t frameCount)
+    {
+        // FNV-1a over the class and the frames, never 0 so that 0 can mark empty entries
+        uint64_t hash = 14695981039346656037ull ^ classId;
+        hash *= 1099511628211ull;
+        for (uint32_t i = 0; i < frameCount; i++)
+        {
+            hash ^= frames[i];
+            hash *= 1099511628211ull;
+        }
+        return hash == 0 ? 1 : hash;
+    }
+} // namespace
+
+AllocationTable::AllocationTable(size_t capacity)
+{
+    size_t size = 16;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+    m_entries.resize(size);
+    memset(m_entries.data(), 0, size * sizeof(AllocationEntry));
+    m_max_size = size * 3 / 4;
+}
+
+bool AllocationTable::Add(uintptr_t classId, const uintptr_t* frames, uint32_t frameCount, bool truncated,
+                          uint64_t count, uint64_t bytes)
+{
+    if (frameCount > max_allocation_stack_depth)
+    {
+        frameCount = max_allocation_stack_depth;
+        truncated = true;
+    }
+    const auto hash = Hash(classId, frames, frameCount);
+    const auto mask = m_entries.size() - 1;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (size_t i = hash & mask;; i = (i + 1) & mask)
+    {
+        auto& entry = m_entries[i];
+        if (entry.hash == 0)
+        {
+            if (m_size >= m_max_size)
+            {
+                m_dropped++;
+                return false;
+            }
+
+            entry.hash = hash;
+            entry.class_id = classId;
+            entry.frame_count = frameCount;
+            entry.truncated = truncated ? 1 : 0;
+            memcpy(entry.frames, frames, frameCount * sizeof(uintptr_t));
+            entry.samples = 1;
+            entry.count = count;
+            entry.bytes = bytes;
+            m_size++;
+            return true;
+        }
+
+        if (entry.hash == hash && entry.class_id == classId && entry.frame_count == frameCount &&
+            memcmp(entry.frames, frames, frameCount * sizeof(uintptr_t)) == 0)
+        {
+            entry.samples++;
+            entry.count += count;
+            entry.bytes += bytes;
+            return true;
+        }
+    }
+}
+
+size_t AllocationTable::Drain(std::vector<AllocationEntry>* entries)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    const auto size = m_size;
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    for (auto& entry : m_entries)
+    {
+        if (entry.hash != 0)
+        {
+            entries->push_back(entry);
+            entry.hash = 0;
+        }
+    }
+    m_size = 0;
+    return size;
+}
+
+size_t AllocationTable::GetSize()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_size;
+}
+
+size_t AllocationTable::GetCapacity() const
+{
+    return m_entries.size();
+}
+
+uint64_t AllocationTable::GetDroppedCount()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_dropped;
+}
+
+} // namespace datadog::profiler
@@ -0,0 +1,63 @@
+#ifndef DD_PROFILER_ALLOCATION_TABLE_H_
+#define DD_PROFILER_ALLOCATION_TABLE_H_
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace datadog::profiler
+{
+
+// Deeper allocation stacks are truncated, the outermost frames are lost
+const uint32_t max_allocation_stack_depth = 32;
+
+const size_t default_allocation_table_capacity = 4096;
+
+struct AllocationEntry
+{
+    uint64_t hash;
+    // ClassID of the allocated objects
+    uintptr_t class_id;
+    uint32_t frame_count;
+    uint32_t truncated;
+    // Return addresses, the allocating frame first
+    uintptr_t frames[max_allocation_stack_depth];
+    // Allocations sampled, then the allocations and bytes they stand for
+    uint64_t samples;
+    uint64_t count;
+    uint64_t bytes;
+};
+
+/// <summary>
+/// Fixed-capacity open addressing table aggregating allocation samples by class and stack, so that memory
+/// doesn't grow with the number of distinct stacks. Once three quarters full, samples of new keys are dropped,
+/// and counted, until Drain empties it. Only sampled allocations get here, the lock is rarely contended.
+/// </summary>
+class AllocationTable
+{
+private:
+    std::mutex m_mutex;
+    std::vector<AllocationEntry> m_entries;
+    size_t m_size = 0;
+    size_t m_max_size;
+    uint64_t m_dropped = 0;
+
+public:
+    // The capacity is rounded up to a power of two.
+    explicit AllocationTable(size_t capacity = default_allocation_table_capacity);
+
+    // Returns false when the sample was dropped because the table is full.
+    bool Add(uintptr_t classId, const uintptr_t* frames, uint32_t frameCount, bool truncated, uint64_t count,
+             uint64_t bytes);
+
+    // Moves the entries out and empties the table. Returns the entry count.
+    size_t Drain(std::vector<AllocationEntry>* entries);
+
+    size_t GetSize();
+    size_t GetCapacity() const;
+    uint64_t GetDroppedCount();
+};
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_ALLOCATION_TABLE_H_
@@ -0,0 +1,102 @@
+#include "configuration.h"
+
+#include <cstdlib>
+#include <strings.h>
+
+#include "environment_variables.h"
+#include "logging.h"
+
+namespace datadog::profiler
+{
+
+namespace
+{
+    std::string GetEnvironmentValue(const std::string& name)
+    {
+        const char* value = std::getenv(name.c_str());
+        return value == nullptr ? std::string() : std::string(value);
+    }
+
+    bool IsTrue(const std::string& value)
+    {
+        return value == "1" || strcasecmp(value.c_str(), "true") == 0 || strcasecmp(value.c_str(), "yes") == 0;
+    }
+
+    bool TryParseUInt(const std::string& value, uint32_t min, uint32_t max, uint32_t* result)
+    {
+        if (value.empty())
+        {
+            return false;
+        }
+
+        char* end = nullptr;
+        const unsigned long parsed = std::strtoul(value.c_str(), &end, 10);
+        if (*end != '\0' || parsed < min || parsed > max)
+        {
+            return false;
+        }
+
+        *result = (uint32_t) parsed;
+        return true;
+    }
+} // namespace
+
+Configuration Configuration::FromEnvironment()
+{
+    Configuration configuration;
+    configuration.enabled = IsTrue(GetEnvironmentValue(environment::profiling_enabled));
+
+    const auto mode = GetEnvironmentValue(environment::profiling_sampling_mode);
+    if (strcasecmp(mode.c_str(), "wall") == 0)
+    {
+        configuration.mode = SamplingMode::Wall;
+    }
+    else if (!mode.empty() && strcasecmp(mode.c_str(), "cpu") != 0)
+    {
+        Warn("Configuration: unknown ", environment::profiling_sampling_mode, " value '", mode, "', using cpu.");
+    }
+
+    const auto frequency = GetEnvironmentValue(environment::profiling_sampling_frequency);
+    if (!frequency.empty() && !TryParseUInt(frequency, 1, max_sampling_frequency, &configuration.frequency))
+    {
+        Warn("Configuration: invalid ", environment::profiling_sampling_frequency, " value '", frequency,
+             "', using ", default_sampling_frequency, ".");
+    }
+
+    const auto directory = GetEnvironmentValue(environment::profiling_output_directory);
+    if (!directory.empty())
+    {
+        configuration.output_directory = directory;
+    }
+
+    const auto interval = GetEnvironmentValue(environment::profiling_export_interval);
+    uint32_t seconds = 0;
+    if (TryParseUInt(interval, 1, 3600, &seconds))
+    {
+        configuration.export_interval = std::chrono::seconds(seconds);
+    }
+    else if (!interval.empty())
+    {
+        Warn("Configuration: invalid ", environment::profiling_export_interval, " value '", interval,
+             "', using ", configuration.export_interval.count(), ".");
+    }
+
+    configuration.allocation_enabled = IsTrue(GetEnvironmentValue(environment::profiling_allocation_enabled));
+
+    const auto allocationInterval = GetEnvironmentValue(environment::profiling_allocation_sampling_interval);
+    if (!allocationInterval.empty() && !TryParseUInt(allocationInterval, 1024, 1024 * 1024 * 1024,
+                                                     &configuration.allocation_sampling_interval))
+    {
+        Warn("Configuration: invalid ", environment::profiling_allocation_sampling_interval, " value '",
+             allocationInterval, "', using ", default_allocation_sampling_interval, ".");
+    }
+
+    return configuration;
+}
+
+const char* GetSamplingModeName(SamplingMode mode)
+{
+    return mode == SamplingMode::Wall ? "wall" : "cpu";
+}
+
+} // namespace datadog::profiler
@@ -0,0 +1,42 @@
+#ifndef DD_PROFILER_CONFIGURATION_H_
+#define DD_PROFILER_CONFIGURATION_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace datadog::profiler
+{
+
+const uint32_t default_sampling_frequency = 100;
+const uint32_t max_sampling_frequency = 1000;
+const uint32_t default_allocation_sampling_interval = 512 * 1024;
+const char* const default_output_directory = "/var/log/datadog/dotnet/profiles";
+
+enum class SamplingMode
+{
+    // Thread CPU time clocks, idle threads are not sampled
+    Cpu,
+    // Monotonic clock, every registered thread is sampled
+    Wall
+};
+
+struct Configuration
+{
+    bool enabled = false;
+    SamplingMode mode = SamplingMode::Cpu;
+    uint32_t frequency = default_sampling_frequency;
+    std::string output_directory = default_output_directory;
+    std::chrono::seconds export_interval = std::chrono::seconds(60);
+    bool allocation_enabled = false;
+    uint32_t allocation_sampling_interval = default_allocation_sampling_interval;
+
+    // Reads the DD_PROFILING_* environment variables, invalid values are logged and replaced by the defaults.
+    static Configuration FromEnvironment();
+};
+
+const char* GetSamplingModeName(SamplingMode mode);
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_CONFIGURATION_H_
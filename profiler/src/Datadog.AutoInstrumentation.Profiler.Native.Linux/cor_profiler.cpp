@@ -0,0 +1,153 @@
+#include "cor_profiler.h"
+
+#include "logging.h"
+
+namespace datadog::profiler
+{
+
+HRESULT STDMETHODCALLTYPE CorProfiler::Initialize(IUnknown* cor_profiler_info_unknown)
+{
+    const auto configuration = Configuration::FromEnvironment();
+    if (!configuration.enabled)
+    {
+        Info("CorProfiler::Initialize: the profiler is disabled, set DD_PROFILING_ENABLED to enable it.");
+        return E_FAIL;
+    }
+
+    HRESULT hr = cor_profiler_info_unknown->QueryInterface(__uuidof(ICorProfilerInfo4), (void**) &info_);
+    if (FAILED(hr))
+    {
+        Warn("CorProfiler::Initialize: interface ICorProfilerInfo4 not found.");
+        info_ = nullptr;
+        return E_FAIL;
+    }
+
+    DWORD event_mask = COR_PRF_MONITOR_THREADS;
+    DWORD high_event_mask = COR_PRF_HIGH_MONITOR_NONE;
+    if (configuration.allocation_enabled)
+    {
+        // EventPipe (.NET 5+) gives sampled allocations with their managed stacks, ObjectAllocated is the fallback
+        // and makes small allocations about five times slower
+        if (FAILED(cor_profiler_info_unknown->QueryInterface(__uuidof(ICorProfilerInfo12),
+                                                            (void**) &event_pipe_info_)))
+        {
+            event_pipe_info_ = nullptr;
+        }
+
+        if (event_pipe_info_ != nullptr)
+        {
+            high_event_mask |= COR_PRF_HIGH_MONITOR_EVENT_PIPE;
+        }
+        else
+        {
+            event_mask |= COR_PRF_ENABLE_OBJECT_ALLOCATED | COR_PRF_MONITOR_OBJECT_ALLOCATED;
+        }
+    }
+
+    hr = event_pipe_info_ != nullptr ? event_pipe_info_->SetEventMask2(event_mask, high_event_mask)
+                                     : info_->SetEventMask(event_mask);
+    if (FAILED(hr))
+    {
+        Warn("CorProfiler::Initialize: unable to set the event mask, hr=", hr);
+        return E_FAIL;
+    }
+
+    sampling_profiler_ = std::make_unique<SamplingProfiler>(configuration, info_);
+    if (configuration.allocation_enabled && StartAllocationProfiler(configuration))
+    {
+        sampling_profiler_->SetAllocationProfiler(allocation_profiler_.get());
+    }
+
+    if (!sampling_profiler_->Start())
+    {
+        sampling_profiler_ = nullptr;
+        if (allocation_profiler_ != nullptr)
+        {
+            allocation_profiler_->Stop();
+        }
+        return E_FAIL;
+    }
+
+    return S_OK;
+}
+
+bool CorProfiler::StartAllocationProfiler(const Configuration& configuration)
+{
+    allocation_profiler_ =
+        std::make_unique<AllocationProfiler>(info_, event_pipe_info_, configuration.allocation_sampling_interval);
+
+    const HRESULT hr = allocation_profiler_->Start();
+    if (FAILED(hr))
+    {
+        // The event mask can't be changed back, the callbacks only check for the allocation profiler
+        Warn("CorProfiler::Initialize: allocation profiling is disabled, hr=", hr);
+        allocation_profiler_ = nullptr;
+        return false;
+    }
+
+    Info("CorProfiler::Initialize: allocation profiling enabled, source=",
+         allocation_profiler_->GetSource() == AllocationSource::EventPipe ? "EventPipe" : "ObjectAllocated",
+         " interval=", configuration.allocation_sampling_interval, "B");
+    return true;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::Shutdown()
+{
+    // No new allocation sample once the session is stopped, the sampling profiler exports the last ones
+    if (allocation_profiler_ != nullptr)
+    {
+        allocation_profiler_->Stop();
+    }
+
+    if (sampling_profiler_ != nullptr)
+    {
+        sampling_profiler_->Stop();
+        Info(sampling_profiler_->ToString());
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::ThreadDestroyed(ThreadID threadId)
+{
+    if (sampling_profiler_ != nullptr)
+    {
+        sampling_profiler_->UnregisterThread(threadId);
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::ThreadAssignedToOSThread(ThreadID managedThreadId, DWORD osThreadId)
+{
+    // Called on the thread itself when it starts running managed code, its stack bounds can be read then
+    if (sampling_profiler_ != nullptr)
+    {
+        sampling_profiler_->RegisterThread(managedThreadId, (pid_t) osThreadId);
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::ObjectAllocated(ObjectID objectId, ClassID classId)
+{
+    if (allocation_profiler_ != nullptr)
+    {
+        allocation_profiler_->OnObjectAllocated(objectId, classId);
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::EventPipeEventDelivered(EVENTPIPE_PROVIDER provider, DWORD eventId,
+                                                               DWORD eventVersion, ULONG cbMetadataBlob,
+                                                               LPCBYTE metadataBlob, ULONG cbEventData,
+                                                               LPCBYTE eventData, LPCGUID pActivityId,
+                                                               LPCGUID pRelatedActivityId, ThreadID eventThread,
+                                                               ULONG numStackFrames, UINT_PTR stackFrames[])
+{
+    if (allocation_profiler_ != nullptr)
+    {
+        allocation_profiler_->OnEventDelivered(provider, eventId, eventVersion, eventData, cbEventData,
+                                               numStackFrames, stackFrames);
+    }
+    return S_OK;
+}
+
+} // namespace datadog::profiler
@@ -0,0 +1,45 @@
+#ifndef DD_PROFILER_COR_PROFILER_H_
+#define DD_PROFILER_COR_PROFILER_H_
+
+#include <memory>
+
+#include "allocation_profiler.h"
+#include "cor_profiler_base.h"
+#include "sampling_profiler.h"
+
+namespace datadog::profiler
+{
+
+/// <summary>
+/// Continuous profiler, loaded directly with CORECLR_PROFILER_PATH until the native loader ships on Linux, where
+/// it will run next to the tracer under the same CLSID as the Windows profiler. It subscribes to the thread callbacks,
+/// to register every managed thread with the sampler, and when allocation profiling is enabled to the
+/// EventPipe events or, on runtimes without EventPipe, to ObjectAllocated.
+/// </summary>
+class CorProfiler : public CorProfilerBase
+{
+private:
+    std::unique_ptr<SamplingProfiler> sampling_profiler_;
+    std::unique_ptr<AllocationProfiler> allocation_profiler_;
+    ICorProfilerInfo12* event_pipe_info_ = nullptr;
+
+    bool StartAllocationProfiler(const Configuration& configuration);
+
+public:
+    CorProfiler() = default;
+
+    HRESULT STDMETHODCALLTYPE Initialize(IUnknown* cor_profiler_info_unknown) override;
+    HRESULT STDMETHODCALLTYPE Shutdown() override;
+    HRESULT STDMETHODCALLTYPE ThreadDestroyed(ThreadID threadId) override;
+    HRESULT STDMETHODCALLTYPE ThreadAssignedToOSThread(ThreadID managedThreadId, DWORD osThreadId) override;
+    HRESULT STDMETHODCALLTYPE ObjectAllocated(ObjectID objectId, ClassID classId) override;
+    HRESULT STDMETHODCALLTYPE EventPipeEventDelivered(EVENTPIPE_PROVIDER provider, DWORD eventId, DWORD eventVersion,
+                                                      ULONG cbMetadataBlob, LPCBYTE metadataBlob, ULONG cbEventData,
+                                                      LPCBYTE eventData, LPCGUID pActivityId,
+                                                      LPCGUID pRelatedActivityId, ThreadID eventThread,
+                                                      ULONG numStackFrames, UINT_PTR stackFrames[]) override;
+};
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_COR_PROFILER_H_
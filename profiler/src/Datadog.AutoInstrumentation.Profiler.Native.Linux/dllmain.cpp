@@ -0,0 +1,36 @@
+// Copyright (c) .NET Foundation and contributors. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full
+// license information.
+
+#include "class_factory.h"
+
+const IID IID_IUnknown = {0x00000000, 0x0000, 0x0000, {0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46}};
+
+const IID IID_IClassFactory = {0x00000001, 0x0000, 0x0000, {0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x46}};
+
+extern "C"
+{
+    HRESULT STDMETHODCALLTYPE DllGetClassObject(REFCLSID rclsid, REFIID riid, LPVOID* ppv)
+    {
+        // {BD1A650D-AC5D-4896-B64F-D6FA25D6B26A}, the continuous profiler of the native loader configuration
+        const GUID CLSID_CorProfiler = {0xbd1a650d, 0xac5d, 0x4896, {0xb6, 0x4f, 0xd6, 0xfa, 0x25, 0xd6, 0xb2, 0x6a}};
+
+        if (ppv == NULL || rclsid != CLSID_CorProfiler)
+        {
+            return E_FAIL;
+        }
+
+        auto factory = new ClassFactory;
+        if (factory == NULL)
+        {
+            return E_FAIL;
+        }
+
+        return factory->QueryInterface(riid, ppv);
+    }
+
+    HRESULT STDMETHODCALLTYPE DllCanUnloadNow()
+    {
+        return S_OK;
+    }
+}
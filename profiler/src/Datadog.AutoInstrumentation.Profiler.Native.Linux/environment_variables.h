@@ -0,0 +1,37 @@
+#ifndef DD_PROFILER_ENVIRONMENT_VARIABLES_H_
+#define DD_PROFILER_ENVIRONMENT_VARIABLES_H_
+
+#include <string>
+
+namespace datadog::profiler::environment
+{
+
+// Sets whether the sampling profiler is enabled. Default is false, the profiler
+// fails its initialization and the runtime unloads it.
+const std::string profiling_enabled = "DD_PROFILING_ENABLED";
+
+// Sets the clock driving the sampling timers: "cpu" samples threads while they
+// consume CPU time, "wall" samples every managed thread, running or not. Default is "cpu".
+const std::string profiling_sampling_mode = "DD_PROFILING_SAMPLING_MODE";
+
+// Sets the number of samples per second and per thread, between 1 and 1000. Default is 100.
+const std::string profiling_sampling_frequency = "DD_PROFILING_SAMPLING_FREQUENCY";
+
+// Sets the directory the pprof files are written to.
+// Default is /var/log/datadog/dotnet/profiles.
+const std::string profiling_output_directory = "DD_PROFILING_OUTPUT_DIR";
+
+// Sets the number of seconds covered by each pprof file. Default is 60.
+const std::string profiling_export_interval = "DD_PROFILING_EXPORT_INTERVAL";
+
+// Sets whether allocations are sampled. Default is false. .NET 5+ runtimes report them through the
+// AllocationTick events of an EventPipe session, older runtimes through ObjectAllocated.
+const std::string profiling_allocation_enabled = "DD_PROFILING_ALLOCATION_ENABLED";
+
+// Sets the average number of bytes allocated by a thread between two allocation samples on runtimes without
+// EventPipe. Default is 524288.
+const std::string profiling_allocation_sampling_interval = "DD_PROFILING_ALLOCATION_SAMPLING_INTERVAL";
+
+} // namespace datadog::profiler::environment
+
+#endif // DD_PROFILER_ENVIRONMENT_VARIABLES_H_
@@ -0,0 +1,40 @@
+#ifndef DD_PROFILER_LOGGING_H_
+#define DD_PROFILER_LOGGING_H_
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+namespace datadog::profiler
+{
+
+template <typename... Args>
+std::string LogToString(Args const&... args)
+{
+    std::ostringstream oss;
+    int a[] = {0, ((void) (oss << args), 0)...};
+    (void) a;
+    return oss.str();
+}
+
+template <typename... Args>
+void Debug(const Args... args)
+{
+    // std::cout << "[DBG] : " << LogToString(args...) << std::endl;
+}
+
+template <typename... Args>
+void Info(const Args... args)
+{
+    std::cout << "[INF] : " << LogToString(args...) << std::endl;
+}
+
+template <typename... Args>
+void Warn(const Args... args)
+{
+    std::cout << "[WRN] : " << LogToString(args...) << std::endl;
+}
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_LOGGING_H_
@@ -0,0 +1,276 @@
+#include "pprof_builder.h"
+
+#include <utility>
+
+namespace datadog::profiler
+{
+
+namespace
+{
+    // Field numbers of profile.proto
+    const uint32_t profile_sample_type = 1;
+    const uint32_t profile_sample = 2;
+    const uint32_t profile_location = 4;
+    const uint32_t profile_function = 5;
+    const uint32_t profile_string_table = 6;
+    const uint32_t profile_time_nanos = 9;
+    const uint32_t profile_duration_nanos = 10;
+    const uint32_t profile_period_type = 11;
+    const uint32_t profile_period = 12;
+    const uint32_t value_type_type = 1;
+    const uint32_t value_type_unit = 2;
+    const uint32_t sample_location_id = 1;
+    const uint32_t sample_value = 2;
+    const uint32_t sample_label = 3;
+    const uint32_t label_key = 1;
+    const uint32_t label_str = 2;
+    const uint32_t location_id = 1;
+    const uint32_t location_line = 4;
+    const uint32_t line_function_id = 1;
+    const uint32_t function_id = 1;
+    const uint32_t function_name = 2;
+    const uint32_t function_system_name = 3;
+    const uint32_t function_filename = 4;
+
+    const uint32_t wire_type_varint = 0;
+    const uint32_t wire_type_length_delimited = 2;
+
+    void WriteVarint(std::string* buffer, uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            buffer->push_back((char) ((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        buffer->push_back((char) value);
+    }
+
+    void WriteTag(std::string* buffer, uint32_t field, uint32_t wireType)
+    {
+        WriteVarint(buffer, ((uint64_t) field << 3) | wireType);
+    }
+
+    // Zero is the default value, proto3 leaves it out
+    void WriteVarintField(std::string* buffer, uint32_t field, uint64_t value)
+    {
+        if (value != 0)
+        {
+            WriteTag(buffer, field, wire_type_varint);
+            WriteVarint(buffer, value);
+        }
+    }
+
+    void WriteBytesField(std::string* buffer, uint32_t field, const std::string& value)
+    {
+        WriteTag(buffer, field, wire_type_length_delimited);
+        WriteVarint(buffer, value.size());
+        buffer->append(value);
+    }
+
+    template <typename T>
+    void WritePackedField(std::string* buffer, std::string* scratch, uint32_t field, const T* values, size_t count)
+    {
+        scratch->clear();
+        for (size_t i = 0; i < count; i++)
+        {
+            WriteVarint(scratch, (uint64_t) values[i]);
+        }
+        WriteBytesField(buffer, field, *scratch);
+    }
+
+    std::string EncodeValueType(int64_t type, int64_t unit)
+    {
+        std::string message;
+        WriteVarintField(&message, value_type_type, type);
+        WriteVarintField(&message, value_type_unit, unit);
+        return message;
+    }
+} // namespace
+
+size_t PprofBuilder::LocationIdsHash::operator()(const std::vector<uint64_t>& ids) const
+{
+    // FNV-1a over the ids
+    uint64_t hash = 14695981039346656037ull;
+    for (const auto id : ids)
+    {
+        hash ^= id;
+        hash *= 1099511628211ull;
+    }
+    return (size_t) hash;
+}
+
+PprofBuilder::PprofBuilder(std::vector<ValueType> sampleTypes, ValueType periodType, int64_t period) :
+    m_sample_types(std::move(sampleTypes)), m_period_type(std::move(periodType)), m_period(period)
+{
+    Reset();
+}
+
+int64_t PprofBuilder::GetStringId(const std::string& value)
+{
+    const auto found = m_string_ids.find(value);
+    if (found != m_string_ids.end())
+    {
+        return found->second;
+    }
+
+    const auto id = (int64_t) m_strings.size();
+    m_strings.push_back(value);
+    m_string_ids.emplace(value, id);
+    return id;
+}
+
+uint64_t PprofBuilder::AddLocation(const std::string& function, const std::string& fileName)
+{
+    std::string key;
+    key.reserve(function.size() + fileName.size() + 1);
+    key.append(function).push_back('\0');
+    key.append(fileName);
+
+    const auto found = m_function_ids.find(key);
+    if (found != m_function_ids.end())
+    {
+        return found->second;
+    }
+
+    m_functions.emplace_back(GetStringId(function), GetStringId(fileName));
+    const auto id = (uint64_t) m_functions.size();
+    m_function_ids.emplace(std::move(key), id);
+    return id;
+}
+
+void PprofBuilder::AddSample(const uint64_t* locationIds, size_t count, const int64_t* values)
+{
+    m_stack.assign(locationIds, locationIds + count);
+    AddSample(values, count, 0, 0);
+}
+
+void PprofBuilder::AddSample(const uint64_t* locationIds, size_t count, const int64_t* values,
+                             const std::string& labelKey, const std::string& labelValue)
+{
+    const auto key = GetStringId(labelKey);
+    const auto value = GetStringId(labelValue);
+    m_stack.assign(locationIds, locationIds + count);
+    m_stack.push_back(0);
+    m_stack.push_back((uint64_t) key);
+    m_stack.push_back((uint64_t) value);
+    AddSample(values, count, key, value);
+}
+
+void PprofBuilder::AddSample(const int64_t* values, size_t locationCount, int64_t labelKey, int64_t labelValue)
+{
+    const auto valueCount = m_sample_types.size();
+    auto found = m_sample_ids.find(m_stack);
+    if (found == m_sample_ids.end())
+    {
+        found = m_sample_ids.emplace(m_stack, m_samples.size()).first;
+        m_samples.push_back({&found->first, locationCount, labelKey, labelValue});
+        m_sample_values.resize(m_sample_values.size() + valueCount, 0);
+    }
+
+    auto* sampleValues = &m_sample_values[found->second * valueCount];
+    for (size_t i = 0; i < valueCount; i++)
+    {
+        sampleValues[i] += values[i];
+    }
+}
+
+size_t PprofBuilder::GetLocationCount() const
+{
+    return m_functions.size();
+}
+
+size_t PprofBuilder::GetSampleCount() const
+{
+    return m_samples.size();
+}
+
+std::string PprofBuilder::Serialize(int64_t timeNanos, int64_t durationNanos) const
+{
+    // Sample and period types were added to the string table by Reset
+    std::string profile;
+    std::string message;
+    std::string scratch;
+
+    for (const auto& sampleType : m_sample_types)
+    {
+        const auto type = m_string_ids.at(sampleType.type);
+        const auto unit = m_string_ids.at(sampleType.unit);
+        WriteBytesField(&profile, profile_sample_type, EncodeValueType(type, unit));
+    }
+
+    const auto valueCount = m_sample_types.size();
+    for (size_t i = 0; i < m_samples.size(); i++)
+    {
+        const auto& sample = m_samples[i];
+        message.clear();
+        WritePackedField(&message, &scratch, sample_location_id, sample.key->data(), sample.location_count);
+        WritePackedField(&message, &scratch, sample_value, &m_sample_values[i * valueCount], valueCount);
+        if (sample.label_key != 0)
+        {
+            std::string label;
+            WriteVarintField(&label, label_key, sample.label_key);
+            WriteVarintField(&label, label_str, sample.label_value);
+            WriteBytesField(&message, sample_label, label);
+        }
+        WriteBytesField(&profile, profile_sample, message);
+    }
+
+    for (size_t i = 0; i < m_functions.size(); i++)
+    {
+        const auto id = (uint64_t) i + 1;
+
+        std::string line;
+        WriteVarintField(&line, line_function_id, id);
+
+        message.clear();
+        WriteVarintField(&message, location_id, id);
+        WriteBytesField(&message, location_line, line);
+        WriteBytesField(&profile, profile_location, message);
+    }
+
+    for (size_t i = 0; i < m_functions.size(); i++)
+    {
+        message.clear();
+        WriteVarintField(&message, function_id, (uint64_t) i + 1);
+        WriteVarintField(&message, function_name, m_functions[i].first);
+        WriteVarintField(&message, function_system_name, m_functions[i].first);
+        WriteVarintField(&message, function_filename, m_functions[i].second);
+        WriteBytesField(&profile, profile_function, message);
+    }
+
+    for (const auto& value : m_strings)
+    {
+        WriteBytesField(&profile, profile_string_table, value);
+    }
+
+    WriteVarintField(&profile, profile_time_nanos, (uint64_t) timeNanos);
+    WriteVarintField(&profile, profile_duration_nanos, (uint64_t) durationNanos);
+    WriteBytesField(&profile, profile_period_type,
+                    EncodeValueType(m_string_ids.at(m_period_type.type), m_string_ids.at(m_period_type.unit)));
+    WriteVarintField(&profile, profile_period, (uint64_t) m_period);
+
+    return profile;
+}
+
+void PprofBuilder::Reset()
+{
+    m_strings.clear();
+    m_string_ids.clear();
+    m_functions.clear();
+    m_function_ids.clear();
+    m_sample_ids.clear();
+    m_samples.clear();
+    m_sample_values.clear();
+
+    // The first string of the table must be empty
+    GetStringId(std::string());
+    for (const auto& sampleType : m_sample_types)
+    {
+        GetStringId(sampleType.type);
+        GetStringId(sampleType.unit);
+    }
+    GetStringId(m_period_type.type);
+    GetStringId(m_period_type.unit);
+}
+
+} // namespace datadog::profiler
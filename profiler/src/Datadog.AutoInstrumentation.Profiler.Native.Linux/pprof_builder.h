@@ -0,0 +1,84 @@
+#ifndef DD_PROFILER_PPROF_BUILDER_H_
+#define DD_PROFILER_PPROF_BUILDER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace datadog::profiler
+{
+
+struct ValueType
+{
+    std::string type;
+    std::string unit;
+};
+
+/// <summary>
+/// Aggregates samples by stack and encodes them as a pprof Profile message (profile.proto of
+/// github.com/google/pprof), without the protobuf runtime. Locations are functions, there is no line
+/// information nor mapping, and samples carry at most one string label. The output is not gzipped, the pprof
+/// tools accept both.
+/// </summary>
+class PprofBuilder
+{
+private:
+    struct LocationIdsHash
+    {
+        size_t operator()(const std::vector<uint64_t>& ids) const;
+    };
+
+    std::vector<ValueType> m_sample_types;
+    ValueType m_period_type;
+    int64_t m_period;
+
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, int64_t> m_string_ids;
+
+    // Function name and file name string ids of each location, location i + 1 is function i + 1
+    std::vector<std::pair<int64_t, int64_t>> m_functions;
+    std::unordered_map<std::string, uint64_t> m_function_ids;
+
+    struct Sample
+    {
+        // Location ids, then 0 and the label string ids when the sample has a label
+        const std::vector<uint64_t>* key;
+        size_t location_count;
+        int64_t label_key;
+        int64_t label_value;
+    };
+
+    std::unordered_map<std::vector<uint64_t>, size_t, LocationIdsHash> m_sample_ids;
+    std::vector<Sample> m_samples;
+    std::vector<int64_t> m_sample_values;
+    std::vector<uint64_t> m_stack;
+
+    int64_t GetStringId(const std::string& value);
+    void AddSample(const int64_t* values, size_t locationCount, int64_t labelKey, int64_t labelValue);
+
+public:
+    PprofBuilder(std::vector<ValueType> sampleTypes, ValueType periodType, int64_t period);
+
+    // Returns the id of the location of the function, added on first use.
+    uint64_t AddLocation(const std::string& function, const std::string& fileName);
+
+    // Adds the values, one per sample type, to the sample of the stack. Locations go from the leaf to the root.
+    void AddSample(const uint64_t* locationIds, size_t count, const int64_t* values);
+    // Same as AddSample, samples of the same stack with different label values are kept apart.
+    void AddSample(const uint64_t* locationIds, size_t count, const int64_t* values, const std::string& labelKey,
+                   const std::string& labelValue);
+
+    size_t GetLocationCount() const;
+    // Distinct stacks
+    size_t GetSampleCount() const;
+
+    std::string Serialize(int64_t timeNanos, int64_t durationNanos) const;
+
+    // Forgets the samples, locations and strings, the location ids returned so far are not valid anymore.
+    void Reset();
+};
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_PPROF_BUILDER_H_
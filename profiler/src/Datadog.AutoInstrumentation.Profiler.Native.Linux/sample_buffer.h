@@ -0,0 +1,91 @@
+#ifndef DD_PROFILER_SAMPLE_BUFFER_H_
+#define DD_PROFILER_SAMPLE_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+
+namespace datadog::profiler
+{
+
+// Deeper stacks are truncated, the outermost frames are lost
+const uint32_t max_stack_depth = 64;
+
+struct StackSample
+{
+    // CLOCK_MONOTONIC
+    uint64_t timestamp_ns;
+    uint32_t frame_count;
+    uint32_t truncated;
+    // Instruction pointer of the interrupted frame first, then the return addresses
+    uintptr_t frames[max_stack_depth];
+};
+
+/// <summary>
+/// Fixed-capacity single producer, single consumer queue of stack samples. The producer is the SIGPROF handler
+/// running on the sampled thread, so reserving and committing a sample is wait-free and only touches lock-free
+/// atomics; the consumer is the collector thread. Samples are dropped, and counted, when the queue is full.
+/// </summary>
+class SampleBuffer
+{
+public:
+    static const uint32_t capacity = 64;
+
+private:
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "the signal handler needs lock-free atomics");
+
+    alignas(64) std::atomic<uint64_t> m_write = {0};
+    alignas(64) std::atomic<uint64_t> m_read = {0};
+    std::atomic<uint64_t> m_dropped = {0};
+    StackSample m_samples[capacity];
+
+public:
+    // Producer: returns the slot to fill, or null when the queue is full.
+    StackSample* TryReserve()
+    {
+        const auto write = m_write.load(std::memory_order_relaxed);
+        if (write - m_read.load(std::memory_order_acquire) >= capacity)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &m_samples[write & (capacity - 1)];
+    }
+
+    // Producer: publishes the slot returned by TryReserve.
+    void Commit()
+    {
+        m_write.store(m_write.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: returns the oldest sample, or null when the queue is empty. It stays valid until Pop.
+    const StackSample* Peek() const
+    {
+        const auto read = m_read.load(std::memory_order_relaxed);
+        if (read == m_write.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &m_samples[read & (capacity - 1)];
+    }
+
+    // Consumer: releases the sample returned by Peek.
+    void Pop()
+    {
+        m_read.store(m_read.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool IsEmpty() const
+    {
+        return m_read.load(std::memory_order_relaxed) == m_write.load(std::memory_order_acquire);
+    }
+
+    uint64_t GetDroppedCount() const
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+};
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_SAMPLE_BUFFER_H_
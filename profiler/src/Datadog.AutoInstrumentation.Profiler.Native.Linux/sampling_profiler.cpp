@@ -0,0 +1,374 @@
+#include "sampling_profiler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logging.h"
+
+namespace datadog::profiler
+{
+
+namespace
+{
+    const auto max_collect_interval = std::chrono::milliseconds(100);
+    const auto min_collect_interval = std::chrono::milliseconds(10);
+
+    bool CreateDirectories(const std::string& path)
+    {
+        for (size_t i = 1; i <= path.size(); i++)
+        {
+            if (i == path.size() || path[i] == '/')
+            {
+                const auto parent = path.substr(0, i);
+                if (mkdir(parent.c_str(), 0755) != 0 && errno != EEXIST)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Sample count and sampled time, the period is the time represented by each sample
+    PprofBuilder CreateBuilder(SamplingMode mode, uint64_t periodNs)
+    {
+        const std::string time = GetSamplingModeName(mode);
+        return PprofBuilder({{"samples", "count"}, {time, "nanoseconds"}}, {time, "nanoseconds"}, (int64_t) periodNs);
+    }
+
+    int64_t ToNanoseconds(std::chrono::system_clock::time_point time)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+    }
+} // namespace
+
+SamplingProfiler::SamplingProfiler(const Configuration& configuration, ICorProfilerInfo4* info) :
+    m_configuration(configuration),
+    m_sampler(configuration.mode, configuration.frequency),
+    m_symbolizer(info),
+    m_builder(CreateBuilder(configuration.mode, m_sampler.GetPeriodNs())),
+    m_profile_start(std::chrono::system_clock::now())
+{
+    // Collect when the thread buffers are half full at most
+    const auto halfBuffer = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::nanoseconds(m_sampler.GetPeriodNs() * SampleBuffer::capacity / 2));
+    m_collect_interval = (std::max)(min_collect_interval, (std::min)(max_collect_interval, halfBuffer));
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    Stop();
+}
+
+bool SamplingProfiler::Start()
+{
+    if (m_running)
+    {
+        return true;
+    }
+
+    if (!m_sampler.Start())
+    {
+        return false;
+    }
+
+    m_profile_start = std::chrono::system_clock::now();
+    m_running = true;
+    m_thread = std::make_unique<std::thread>(CollectorThreadLoop, this);
+    Info("SamplingProfiler: started, mode=", GetSamplingModeName(m_configuration.mode), " frequency=",
+         m_configuration.frequency, "Hz output=", m_configuration.output_directory);
+    return true;
+}
+
+void SamplingProfiler::Stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    m_sampler.Stop();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wake_condition.notify_all();
+    }
+    if (m_thread != nullptr && m_thread->joinable())
+    {
+        m_thread->join();
+    }
+    m_thread = nullptr;
+
+    CollectSamples();
+    Export();
+}
+
+bool SamplingProfiler::IsRunning() const
+{
+    return m_running;
+}
+
+void SamplingProfiler::SetAllocationProfiler(AllocationProfiler* allocationProfiler)
+{
+    m_allocation_profiler = allocationProfiler;
+}
+
+bool SamplingProfiler::RegisterThread(uint64_t threadId, pid_t tid)
+{
+    return m_sampler.RegisterThread(threadId, tid);
+}
+
+void SamplingProfiler::UnregisterThread(uint64_t threadId)
+{
+    m_sampler.UnregisterThread(threadId);
+}
+
+void SamplingProfiler::CollectorThreadLoop(SamplingProfiler* profiler)
+{
+    Debug("SamplingProfiler: collector thread started.");
+    auto nextExport = std::chrono::steady_clock::now() + profiler->m_configuration.export_interval;
+
+    while (profiler->m_running)
+    {
+        {
+            std::unique_lock<std::mutex> lock(profiler->m_mutex);
+            profiler->m_wake_condition.wait_for(lock, profiler->m_collect_interval,
+                                                [profiler] { return !profiler->m_running; });
+        }
+
+        profiler->CollectSamples();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= nextExport)
+        {
+            profiler->Export();
+            nextExport = now + profiler->m_configuration.export_interval;
+        }
+    }
+
+    Debug("SamplingProfiler: collector thread stopped.");
+}
+
+size_t SamplingProfiler::CollectSamples()
+{
+    std::lock_guard<std::mutex> guard(m_collect_mutex);
+
+    m_samples.clear();
+    const auto count = m_sampler.Collect(&m_samples);
+    const int64_t values[] = {1, (int64_t) m_sampler.GetPeriodNs()};
+
+    for (const auto& collected : m_samples)
+    {
+        const auto& sample = collected.sample;
+        m_location_ids.clear();
+        for (uint32_t i = 0; i < sample.frame_count; i++)
+        {
+            // Return addresses point after the call, which can be the first instruction of the next function
+            const auto address = i == 0 ? sample.frames[i] : sample.frames[i] - 1;
+
+            auto found = m_locations.find(address);
+            if (found == m_locations.end())
+            {
+                m_symbolizer.Resolve(address, &m_frame);
+                found = m_locations.emplace(address, m_builder.AddLocation(m_frame.function, m_frame.file)).first;
+            }
+            m_location_ids.push_back(found->second);
+        }
+
+        if (sample.truncated)
+        {
+            m_location_ids.push_back(m_builder.AddLocation("[truncated]", std::string()));
+        }
+
+        m_builder.AddSample(m_location_ids.data(), m_location_ids.size(), values);
+    }
+
+    m_samples_aggregated += count;
+    return count;
+}
+
+bool SamplingProfiler::Export()
+{
+    std::lock_guard<std::mutex> guard(m_collect_mutex);
+
+    const auto now = std::chrono::system_clock::now();
+    const auto start = m_profile_start;
+    const auto hasSamples = m_builder.GetSampleCount() > 0;
+    std::string profile;
+    if (hasSamples)
+    {
+        profile = m_builder.Serialize(ToNanoseconds(start), ToNanoseconds(now) - ToNanoseconds(start));
+    }
+
+    // Addresses can be reused by other functions, the cache doesn't outlive the profile
+    m_builder.Reset();
+    m_locations.clear();
+
+    auto written = false;
+    if (hasSamples && WriteProfile("profile", m_export_count, profile, &m_last_profile_path))
+    {
+        m_export_count++;
+        written = true;
+    }
+
+    if (m_allocation_profiler != nullptr && ExportAllocations(start, now))
+    {
+        written = true;
+    }
+
+    m_symbolizer.Clear();
+    m_profile_start = now;
+    return written;
+}
+
+bool SamplingProfiler::ExportAllocations(std::chrono::system_clock::time_point start,
+                                         std::chrono::system_clock::time_point end)
+{
+    m_allocations.clear();
+    if (m_allocation_profiler->Drain(&m_allocations) == 0)
+    {
+        return false;
+    }
+
+    // Allocations sampled and their estimated bytes, the period is the mean distance between two samples
+    PprofBuilder builder({{"alloc_samples", "count"}, {"alloc_space", "bytes"}}, {"space", "bytes"},
+                         (int64_t) m_allocation_profiler->GetSamplingInterval());
+    std::unordered_map<uintptr_t, std::pair<uint64_t, bool>> locations;
+
+    for (const auto& entry : m_allocations)
+    {
+        m_location_ids.clear();
+        size_t firstManaged = entry.frame_count;
+        for (uint32_t i = 0; i < entry.frame_count; i++)
+        {
+            const auto address = entry.frames[i] - 1;
+            auto found = locations.find(address);
+            if (found == locations.end())
+            {
+                m_symbolizer.Resolve(address, &m_frame);
+                found = locations
+                            .emplace(address, std::make_pair(builder.AddLocation(m_frame.function, m_frame.file),
+                                                             m_frame.managed))
+                            .first;
+            }
+            if (found->second.second && firstManaged == entry.frame_count)
+            {
+                firstManaged = i;
+            }
+            m_location_ids.push_back(found->second.first);
+        }
+
+        // The frames of the profiler and of the runtime allocation helpers come first on the ObjectAllocated
+        // path, the allocation is attributed to the managed code calling them
+        if (firstManaged < m_location_ids.size())
+        {
+            m_location_ids.erase(m_location_ids.begin(), m_location_ids.begin() + firstManaged);
+        }
+
+        if (entry.truncated)
+        {
+            m_location_ids.push_back(builder.AddLocation("[truncated]", std::string()));
+        }
+
+        if (!m_allocation_profiler->GetTypeName(entry.class_id, &m_allocation_type) &&
+            !m_symbolizer.ResolveClass(entry.class_id, &m_allocation_type))
+        {
+            std::ostringstream name;
+            name << "[class 0x" << std::hex << entry.class_id << "]";
+            m_allocation_type = name.str();
+        }
+
+        const int64_t values[] = {(int64_t) entry.count, (int64_t) entry.bytes};
+        builder.AddSample(m_location_ids.data(), m_location_ids.size(), values, "allocation class",
+                          m_allocation_type);
+    }
+
+    const auto profile = builder.Serialize(ToNanoseconds(start), ToNanoseconds(end) - ToNanoseconds(start));
+    if (!WriteProfile("allocations", m_allocation_export_count, profile, &m_last_allocation_profile_path))
+    {
+        return false;
+    }
+
+    m_allocation_export_count++;
+    return true;
+}
+
+bool SamplingProfiler::WriteProfile(const char* prefix, uint32_t sequence, const std::string& profile,
+                                    std::string* path)
+{
+    const auto& directory = m_configuration.output_directory;
+    if (!CreateDirectories(directory))
+    {
+        Warn("SamplingProfiler: unable to create ", directory, ", errno=", errno);
+        return false;
+    }
+
+    std::ostringstream name;
+    name << directory << "/" << prefix << "_" << getpid() << "_" << sequence << ".pprof";
+    const auto finalPath = name.str();
+    const auto temporaryPath = finalPath + ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(profile.data(), (std::streamsize) profile.size());
+        if (!file.good())
+        {
+            Warn("SamplingProfiler: unable to write ", temporaryPath);
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    // Readers watching the directory never see a partial file
+    if (std::rename(temporaryPath.c_str(), finalPath.c_str()) != 0)
+    {
+        Warn("SamplingProfiler: unable to rename ", temporaryPath, ", errno=", errno);
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+
+    *path = finalPath;
+    Debug("SamplingProfiler: wrote ", finalPath, " (", profile.size(), " bytes)");
+    return true;
+}
+
+std::string SamplingProfiler::GetLastProfilePath()
+{
+    std::lock_guard<std::mutex> guard(m_collect_mutex);
+    return m_last_profile_path;
+}
+
+std::string SamplingProfiler::GetLastAllocationProfilePath()
+{
+    std::lock_guard<std::mutex> guard(m_collect_mutex);
+    return m_last_allocation_profile_path;
+}
+
+const StackSampler& SamplingProfiler::GetSampler() const
+{
+    return m_sampler;
+}
+
+std::string SamplingProfiler::ToString()
+{
+    std::lock_guard<std::mutex> guard(m_collect_mutex);
+    std::ostringstream ss;
+    ss << "SamplingProfiler [Mode=" << GetSamplingModeName(m_configuration.mode)
+       << ", Frequency=" << m_configuration.frequency << "Hz, Threads=" << m_sampler.GetThreadCount()
+       << ", Samples=" << m_sampler.GetSampleCount() << ", Dropped=" << m_sampler.GetDroppedCount()
+       << ", HandlerTime=" << m_sampler.GetHandlerNanoseconds() / 1000 << "us"
+       << ", Aggregated=" << m_samples_aggregated << ", Profiles=" << m_export_count
+       << ", ManagedFrames=" << m_symbolizer.GetManagedCount() << ", NativeFrames=" << m_symbolizer.GetNativeCount()
+       << ", UnknownFrames=" << m_symbolizer.GetUnknownCount() << "]";
+    if (m_allocation_profiler != nullptr)
+    {
+        ss << " " << m_allocation_profiler->ToString();
+    }
+    return ss.str();
+}
+
+} // namespace datadog::profiler
@@ -0,0 +1,96 @@
+#ifndef DD_PROFILER_SAMPLING_PROFILER_H_
+#define DD_PROFILER_SAMPLING_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "allocation_profiler.h"
+#include "configuration.h"
+#include "pprof_builder.h"
+#include "stack_sampler.h"
+#include "symbolizer.h"
+
+namespace datadog::profiler
+{
+
+/// <summary>
+/// Runs the sampler and the collector thread. The collector wakes up often enough for the per-thread buffers
+/// never to fill up at the configured frequency, symbolizes the new samples and aggregates them; every export
+/// interval the aggregated stacks are written as a pprof file, profile_[pid]_[sequence].pprof, in the output
+/// directory. When allocation profiling is enabled, the allocation samples are exported at the same time to
+/// allocations_[pid]_[sequence].pprof.
+/// </summary>
+class SamplingProfiler
+{
+private:
+    Configuration m_configuration;
+    StackSampler m_sampler;
+    std::chrono::milliseconds m_collect_interval;
+
+    // Only touched under m_collect_mutex
+    std::mutex m_collect_mutex;
+    Symbolizer m_symbolizer;
+    PprofBuilder m_builder;
+    std::unordered_map<uintptr_t, uint64_t> m_locations;
+    std::vector<CollectedSample> m_samples;
+    std::vector<uint64_t> m_location_ids;
+    FrameName m_frame;
+    std::chrono::system_clock::time_point m_profile_start;
+    uint32_t m_export_count = 0;
+    std::string m_last_profile_path;
+    uint64_t m_samples_aggregated = 0;
+
+    AllocationProfiler* m_allocation_profiler = nullptr;
+    std::vector<AllocationEntry> m_allocations;
+    std::string m_allocation_type;
+    std::string m_last_allocation_profile_path;
+    uint32_t m_allocation_export_count = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake_condition;
+    std::atomic_bool m_running = {false};
+    std::unique_ptr<std::thread> m_thread;
+
+    static void CollectorThreadLoop(SamplingProfiler* profiler);
+    bool ExportAllocations(std::chrono::system_clock::time_point start, std::chrono::system_clock::time_point end);
+    bool WriteProfile(const char* prefix, uint32_t sequence, const std::string& profile, std::string* path);
+
+public:
+    // info can be null, only native frames are symbolized then.
+    SamplingProfiler(const Configuration& configuration, ICorProfilerInfo4* info);
+    ~SamplingProfiler();
+
+    bool Start();
+    // Stops sampling, then collects and exports the remaining samples.
+    void Stop();
+    bool IsRunning() const;
+
+    // The allocation samples are drained and exported with the CPU or wall time profile. Must be called
+    // before Start, the allocation profiler must outlive this one.
+    void SetAllocationProfiler(AllocationProfiler* allocationProfiler);
+
+    bool RegisterThread(uint64_t threadId, pid_t tid);
+    void UnregisterThread(uint64_t threadId);
+
+    // Moves the samples out of the thread buffers, symbolizes and aggregates them. Returns the sample count.
+    size_t CollectSamples();
+    // Writes the aggregated stacks to a new pprof file and starts a new profile, along with the allocation
+    // profile. Nothing is written for a profile without sample. Returns true when a file was written.
+    bool Export();
+
+    std::string GetLastProfilePath();
+    std::string GetLastAllocationProfilePath();
+    const StackSampler& GetSampler() const;
+    std::string ToString();
+};
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_SAMPLING_PROFILER_H_
@@ -0,0 +1,462 @@
+#include "stack_sampler.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/syscall.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "logging.h"
+
+// Older glibc versions only expose the union member
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace datadog::profiler
+{
+
+namespace
+{
+    // The cookie sent with each signal is the slot of the thread in the low bits and a generation above them,
+    // so that a signal queued before a slot was reused is ignored
+    const uintptr_t cookie_slot_bits = 16;
+    static_assert(max_sampled_threads <= (1u << cookie_slot_bits), "slots must fit in the cookie");
+
+    // Retired threads are freed once no signal can be running their handler anymore
+    const auto retired_thread_grace_period = std::chrono::seconds(1);
+
+    std::atomic<SampledThread*> g_slots[max_sampled_threads] = {};
+    std::atomic<uint64_t> g_generation = {0};
+
+    std::mutex g_handler_mutex;
+    bool g_handler_installed = false;
+    struct sigaction g_previous_action;
+
+    pid_t GetCurrentThreadId()
+    {
+        return (pid_t) syscall(SYS_gettid);
+    }
+
+    // CPU time clock of any thread of the process, MAKE_THREAD_CPUCLOCK(tid, CPUCLOCK_SCHED) in the kernel
+    clockid_t GetThreadCpuClock(pid_t tid)
+    {
+        return (clockid_t) ((~(uint32_t) tid << 3) | 6);
+    }
+
+    void ForwardSignal(int signal, siginfo_t* info, void* context)
+    {
+        if ((g_previous_action.sa_flags & SA_SIGINFO) != 0)
+        {
+            if (g_previous_action.sa_sigaction != nullptr)
+            {
+                g_previous_action.sa_sigaction(signal, info, context);
+            }
+        }
+        else if (g_previous_action.sa_handler != SIG_DFL && g_previous_action.sa_handler != SIG_IGN)
+        {
+            g_previous_action.sa_handler(signal);
+        }
+    }
+
+    // Captures the interrupted frame, then the return addresses of its callers
+    uint32_t CaptureStack(const ucontext_t* context, uintptr_t stackLow, uintptr_t stackHigh, StackSample* sample)
+    {
+#if defined(__x86_64__)
+        const auto pc = (uintptr_t) context->uc_mcontext.gregs[REG_RIP];
+        const auto fp = (uintptr_t) context->uc_mcontext.gregs[REG_RBP];
+        const auto sp = (uintptr_t) context->uc_mcontext.gregs[REG_RSP];
+#elif defined(__aarch64__)
+        const auto pc = (uintptr_t) context->uc_mcontext.pc;
+        const auto fp = (uintptr_t) context->uc_mcontext.regs[29];
+        const auto sp = (uintptr_t) context->uc_mcontext.sp;
+#else
+        // Frame pointers are not walked on the other architectures, only the interrupted frame is captured
+        const uintptr_t pc = 0;
+        const uintptr_t fp = 0;
+        const uintptr_t sp = 0;
+        stackHigh = 0;
+#endif
+
+        sample->frames[0] = pc;
+        sample->truncated = 0;
+        if (stackHigh == 0 || sp < stackLow || sp >= stackHigh)
+        {
+            return 1;
+        }
+
+        bool truncated = false;
+        const auto count = WalkFramePointers(fp, sp, stackHigh, sample->frames + 1, max_stack_depth - 1, &truncated);
+        sample->truncated = truncated ? 1 : 0;
+        return count + 1;
+    }
+
+    void SignalHandler(int signal, siginfo_t* info, void* context)
+    {
+        const int savedErrno = errno;
+
+        SampledThread* thread = nullptr;
+        if (info != nullptr && info->si_code == SI_TIMER)
+        {
+            const auto cookie = reinterpret_cast<uintptr_t>(info->si_value.sival_ptr);
+            const auto slot = cookie & ((1u << cookie_slot_bits) - 1);
+            if (slot < max_sampled_threads)
+            {
+                thread = g_slots[slot].load(std::memory_order_acquire);
+                if (thread != nullptr && thread->cookie != cookie)
+                {
+                    thread = nullptr;
+                }
+            }
+        }
+
+        if (thread == nullptr)
+        {
+            ForwardSignal(signal, info, context);
+            errno = savedErrno;
+            return;
+        }
+
+        // CLOCK_MONOTONIC is read from the vDSO, without a system call
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        const auto start = (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+
+        auto* sample = thread->buffer.TryReserve();
+        if (sample != nullptr)
+        {
+            sample->timestamp_ns = start;
+            sample->frame_count = CaptureStack(static_cast<const ucontext_t*>(context), thread->stack_low,
+                                               thread->stack_high, sample);
+            thread->buffer.Commit();
+        }
+        thread->samples.fetch_add(1, std::memory_order_relaxed);
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        thread->handler_ns.fetch_add((uint64_t) now.tv_sec * 1000000000 + now.tv_nsec - start,
+                                     std::memory_order_relaxed);
+
+        errno = savedErrno;
+    }
+
+    bool InstallSignalHandler()
+    {
+        std::lock_guard<std::mutex> guard(g_handler_mutex);
+        if (g_handler_installed)
+        {
+            return true;
+        }
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = SignalHandler;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        if (sigaction(SIGPROF, &action, &g_previous_action) != 0)
+        {
+            Warn("StackSampler: unable to install the SIGPROF handler, errno=", errno);
+            return false;
+        }
+
+        g_handler_installed = true;
+        return true;
+    }
+
+    bool AcquireSlot(SampledThread* thread)
+    {
+        for (uint32_t i = 0; i < max_sampled_threads; i++)
+        {
+            SampledThread* expected = nullptr;
+            if (g_slots[i].load(std::memory_order_relaxed) == nullptr &&
+                g_slots[i].compare_exchange_strong(expected, thread, std::memory_order_acq_rel))
+            {
+                thread->slot = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+} // namespace
+
+uint32_t WalkFramePointers(uintptr_t fp, uintptr_t sp, uintptr_t stackHigh, uintptr_t* frames, uint32_t maxFrames,
+                           bool* truncated)
+{
+    uint32_t count = 0;
+    *truncated = false;
+
+    // A frame record is the caller frame pointer followed by the return address
+    while (fp >= sp && fp <= stackHigh - 2 * sizeof(uintptr_t) && (fp & (sizeof(uintptr_t) - 1)) == 0)
+    {
+        if (count == maxFrames)
+        {
+            *truncated = true;
+            break;
+        }
+
+        const auto* record = reinterpret_cast<const uintptr_t*>(fp);
+        const auto next = record[0];
+        const auto returnAddress = record[1];
+        if (returnAddress == 0)
+        {
+            break;
+        }
+
+        frames[count++] = returnAddress;
+        if (next <= fp)
+        {
+            break;
+        }
+        fp = next;
+    }
+
+    return count;
+}
+
+bool GetCurrentThreadStack(uintptr_t* stackLow, uintptr_t* stackHigh)
+{
+    pthread_attr_t attributes;
+    if (pthread_getattr_np(pthread_self(), &attributes) != 0)
+    {
+        return false;
+    }
+
+    void* address = nullptr;
+    size_t size = 0;
+    const auto found = pthread_attr_getstack(&attributes, &address, &size) == 0;
+    if (found)
+    {
+        *stackLow = reinterpret_cast<uintptr_t>(address);
+        *stackHigh = *stackLow + size;
+    }
+    pthread_attr_destroy(&attributes);
+    return found;
+}
+
+StackSampler::StackSampler(SamplingMode mode, uint32_t frequency) : m_mode(mode)
+{
+    frequency = (std::min)((std::max)(frequency, 1u), max_sampling_frequency);
+    m_period_ns = 1000000000ull / frequency;
+}
+
+StackSampler::~StackSampler()
+{
+    Stop();
+}
+
+bool StackSampler::Start()
+{
+    if (!InstallSignalHandler())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_started = true;
+    return true;
+}
+
+void StackSampler::Stop()
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_started = false;
+    for (auto& thread : m_threads)
+    {
+        if (!thread->retired)
+        {
+            Retire(thread.get());
+        }
+    }
+}
+
+void StackSampler::Retire(SampledThread* thread)
+{
+    // Clearing the slot first makes the signals still queued for the timer no-ops
+    g_slots[thread->slot].store(nullptr, std::memory_order_release);
+    timer_delete(thread->timer);
+    thread->retired = true;
+    thread->retired_at = std::chrono::steady_clock::now();
+}
+
+bool StackSampler::RegisterThread(uint64_t threadId, pid_t tid)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (!m_started)
+    {
+        return false;
+    }
+
+    for (auto& existing : m_threads)
+    {
+        if (!existing->retired && existing->id == threadId)
+        {
+            Retire(existing.get());
+        }
+    }
+
+    auto thread = std::make_unique<SampledThread>();
+    thread->id = threadId;
+    thread->tid = tid;
+    thread->stack_low = 0;
+    thread->stack_high = 0;
+    thread->retired = false;
+    if (tid == GetCurrentThreadId())
+    {
+        GetCurrentThreadStack(&thread->stack_low, &thread->stack_high);
+    }
+
+    if (!AcquireSlot(thread.get()))
+    {
+        m_registration_failures++;
+        Warn("StackSampler: more than ", max_sampled_threads, " threads, thread ", tid, " is not sampled.");
+        return false;
+    }
+    thread->cookie = (uintptr_t) ((++g_generation << cookie_slot_bits) | thread->slot);
+
+    sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_value.sival_ptr = reinterpret_cast<void*>(thread->cookie);
+    event.sigev_notify_thread_id = tid;
+
+    const clockid_t clock = m_mode == SamplingMode::Cpu ? GetThreadCpuClock(tid) : CLOCK_MONOTONIC;
+    if (timer_create(clock, &event, &thread->timer) != 0)
+    {
+        g_slots[thread->slot].store(nullptr, std::memory_order_release);
+        m_registration_failures++;
+        Warn("StackSampler: unable to create the timer of thread ", tid, ", errno=", errno);
+        return false;
+    }
+
+    // Wall clock timers of different threads are spread over the period instead of all firing together
+    const uint64_t first = m_mode == SamplingMode::Wall ? 1 + ((uint64_t) tid * 2654435761u) % m_period_ns
+                                                        : m_period_ns;
+    itimerspec spec;
+    spec.it_interval.tv_sec = (time_t) (m_period_ns / 1000000000);
+    spec.it_interval.tv_nsec = (long) (m_period_ns % 1000000000);
+    spec.it_value.tv_sec = (time_t) (first / 1000000000);
+    spec.it_value.tv_nsec = (long) (first % 1000000000);
+    if (timer_settime(thread->timer, 0, &spec, nullptr) != 0)
+    {
+        g_slots[thread->slot].store(nullptr, std::memory_order_release);
+        timer_delete(thread->timer);
+        m_registration_failures++;
+        Warn("StackSampler: unable to start the timer of thread ", tid, ", errno=", errno);
+        return false;
+    }
+
+    Debug("StackSampler: registered thread ", tid, " stack=[", thread->stack_low, ", ", thread->stack_high, "]");
+    m_threads.push_back(std::move(thread));
+    return true;
+}
+
+void StackSampler::UnregisterThread(uint64_t threadId)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto& thread : m_threads)
+    {
+        if (!thread->retired && thread->id == threadId)
+        {
+            Retire(thread.get());
+        }
+    }
+}
+
+size_t StackSampler::Collect(std::vector<CollectedSample>* samples)
+{
+    const auto now = std::chrono::steady_clock::now();
+    size_t count = 0;
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto& thread : m_threads)
+    {
+        while (const auto* sample = thread->buffer.Peek())
+        {
+            samples->emplace_back();
+            auto& collected = samples->back();
+            collected.thread_id = thread->id;
+            collected.sample.timestamp_ns = sample->timestamp_ns;
+            collected.sample.frame_count = sample->frame_count;
+            collected.sample.truncated = sample->truncated;
+            memcpy(collected.sample.frames, sample->frames, sample->frame_count * sizeof(uintptr_t));
+            thread->buffer.Pop();
+            count++;
+        }
+    }
+
+    auto retired = std::remove_if(m_threads.begin(), m_threads.end(), [&](const std::unique_ptr<SampledThread>& t) {
+        if (!t->retired || now - t->retired_at < retired_thread_grace_period || !t->buffer.IsEmpty())
+        {
+            return false;
+        }
+        m_retired_samples += t->samples.load(std::memory_order_relaxed);
+        m_retired_dropped += t->buffer.GetDroppedCount();
+        m_retired_handler_ns += t->handler_ns.load(std::memory_order_relaxed);
+        return true;
+    });
+    m_threads.erase(retired, m_threads.end());
+
+    return count;
+}
+
+SamplingMode StackSampler::GetMode() const
+{
+    return m_mode;
+}
+
+uint64_t StackSampler::GetPeriodNs() const
+{
+    return m_period_ns;
+}
+
+size_t StackSampler::GetThreadCount() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return std::count_if(m_threads.begin(), m_threads.end(),
+                         [](const std::unique_ptr<SampledThread>& t) { return !t->retired; });
+}
+
+uint64_t StackSampler::GetSampleCount() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    uint64_t count = m_retired_samples;
+    for (const auto& thread : m_threads)
+    {
+        count += thread->samples.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+uint64_t StackSampler::GetDroppedCount() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    uint64_t count = m_retired_dropped;
+    for (const auto& thread : m_threads)
+    {
+        count += thread->buffer.GetDroppedCount();
+    }
+    return count;
+}
+
+uint64_t StackSampler::GetHandlerNanoseconds() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    uint64_t total = m_retired_handler_ns;
+    for (const auto& thread : m_threads)
+    {
+        total += thread->handler_ns.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t StackSampler::GetRegistrationFailureCount() const
+{
+    return m_registration_failures.load();
+}
+
+} // namespace datadog::profiler
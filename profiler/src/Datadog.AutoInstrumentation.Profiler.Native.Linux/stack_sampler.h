@@ -0,0 +1,113 @@
+#ifndef DD_PROFILER_STACK_SAMPLER_H_
+#define DD_PROFILER_STACK_SAMPLER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sys/types.h>
+#include <time.h>
+#include <vector>
+
+#include "configuration.h"
+#include "sample_buffer.h"
+
+namespace datadog::profiler
+{
+
+// Threads sampled at the same time, the others are not registered
+const uint32_t max_sampled_threads = 4096;
+
+// Walks the frame pointer chain starting at fp and stores the return addresses. Every frame record read must lie
+// between sp and the top of the stack and records must go up the stack, so that a register that doesn't hold a
+// frame pointer (code compiled without them) ends the walk instead of faulting. Async-signal-safe.
+uint32_t WalkFramePointers(uintptr_t fp, uintptr_t sp, uintptr_t stackHigh, uintptr_t* frames, uint32_t maxFrames,
+                           bool* truncated);
+
+// Bounds of the stack of the calling thread. Not async-signal-safe, it can read /proc/self/maps.
+bool GetCurrentThreadStack(uintptr_t* stackLow, uintptr_t* stackHigh);
+
+struct SampledThread
+{
+    uint64_t id;
+    pid_t tid;
+    // Value sent with the signal, checked by the handler before touching the thread
+    uintptr_t cookie;
+    uint32_t slot;
+    // Stack of the thread, the handler only walks frame pointers inside it. Both are 0 when unknown, only the
+    // interrupted frame is captured then.
+    uintptr_t stack_low;
+    uintptr_t stack_high;
+    timer_t timer;
+    bool retired;
+    std::chrono::steady_clock::time_point retired_at;
+    std::atomic<uint64_t> samples = {0};
+    // Time spent in the signal handler, without the kernel delivering the signal
+    std::atomic<uint64_t> handler_ns = {0};
+    SampleBuffer buffer;
+};
+
+struct CollectedSample
+{
+    uint64_t thread_id;
+    StackSample sample;
+};
+
+/// <summary>
+/// Samples registered threads with one POSIX timer per thread (timer_create with SIGEV_THREAD_ID), so that
+/// each SIGPROF is delivered to the thread it samples. The handler walks the frame pointers from the
+/// interrupted context and copies the raw addresses into the lock-free buffer of the thread: it doesn't
+/// allocate, lock nor symbolize. Collect moves the samples out of the buffers on another thread.
+///
+/// The signal handler is installed once per process and stays installed, a signal still pending after its
+/// timer was deleted must not fall back to the default action, which terminates the process. SIGPROF signals
+/// that don't come from these timers are forwarded to the handler installed before.
+/// </summary>
+class StackSampler
+{
+private:
+    SamplingMode m_mode;
+    uint64_t m_period_ns;
+
+    mutable std::mutex m_mutex;
+    // Registered threads, then the retired ones until their buffer is drained
+    std::vector<std::unique_ptr<SampledThread>> m_threads;
+    bool m_started = false;
+    std::atomic<uint64_t> m_registration_failures = {0};
+    uint64_t m_retired_samples = 0;
+    uint64_t m_retired_dropped = 0;
+    uint64_t m_retired_handler_ns = 0;
+
+    void Retire(SampledThread* thread);
+
+public:
+    StackSampler(SamplingMode mode, uint32_t frequency);
+    ~StackSampler();
+
+    // Installs the SIGPROF handler. Threads are only sampled once registered.
+    bool Start();
+    // Deletes the timers of every thread, the samples already taken can still be collected.
+    void Stop();
+
+    // Creates the sampling timer of the thread. The stack bounds, needed to walk past the interrupted frame,
+    // are only known when registering the calling thread.
+    bool RegisterThread(uint64_t threadId, pid_t tid);
+    void UnregisterThread(uint64_t threadId);
+
+    // Appends the samples taken since the last call and frees the threads retired long enough ago.
+    size_t Collect(std::vector<CollectedSample>* samples);
+
+    SamplingMode GetMode() const;
+    uint64_t GetPeriodNs() const;
+    size_t GetThreadCount() const;
+    uint64_t GetSampleCount() const;
+    // Samples lost because the buffer of the thread was full
+    uint64_t GetDroppedCount() const;
+    uint64_t GetHandlerNanoseconds() const;
+    uint64_t GetRegistrationFailureCount() const;
+};
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_STACK_SAMPLER_H_
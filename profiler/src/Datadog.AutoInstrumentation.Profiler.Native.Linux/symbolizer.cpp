@@ -0,0 +1,294 @@
+#include "symbolizer.h"
+
+#include <algorithm>
+#include <cxxabi.h>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+
+namespace datadog::profiler
+{
+
+namespace
+{
+    const ULONG max_name_length = 1024;
+
+    // Lengths returned by the metadata include the terminating null character
+    size_t GetNameLength(ULONG length)
+    {
+        return length == 0 ? 0 : (std::min)(length, max_name_length) - 1;
+    }
+
+    std::string GetFileName(const std::string& path)
+    {
+        const auto separator = path.find_last_of('/');
+        return separator == std::string::npos ? path : path.substr(separator + 1);
+    }
+
+    std::string FormatAddress(uintptr_t address)
+    {
+        char buffer[2 + sizeof(uintptr_t) * 2 + 1];
+        snprintf(buffer, sizeof(buffer), "0x%lx", (unsigned long) address);
+        return buffer;
+    }
+
+    void AppendUtf8(std::string* result, uint32_t codePoint)
+    {
+        if (codePoint < 0x80)
+        {
+            result->push_back((char) codePoint);
+        }
+        else if (codePoint < 0x800)
+        {
+            result->push_back((char) (0xC0 | (codePoint >> 6)));
+            result->push_back((char) (0x80 | (codePoint & 0x3F)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            result->push_back((char) (0xE0 | (codePoint >> 12)));
+            result->push_back((char) (0x80 | ((codePoint >> 6) & 0x3F)));
+            result->push_back((char) (0x80 | (codePoint & 0x3F)));
+        }
+        else
+        {
+            result->push_back((char) (0xF0 | (codePoint >> 18)));
+            result->push_back((char) (0x80 | ((codePoint >> 12) & 0x3F)));
+            result->push_back((char) (0x80 | ((codePoint >> 6) & 0x3F)));
+            result->push_back((char) (0x80 | (codePoint & 0x3F)));
+        }
+    }
+} // namespace
+
+std::string ToUtf8(const WCHAR* value, size_t length)
+{
+    std::string result;
+    result.reserve(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        uint32_t codePoint = value[i];
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF && i + 1 < length && value[i + 1] >= 0xDC00 &&
+            value[i + 1] <= 0xDFFF)
+        {
+            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (value[i + 1] - 0xDC00);
+            i++;
+        }
+        else if (codePoint >= 0xD800 && codePoint <= 0xDFFF)
+        {
+            codePoint = 0xFFFD;
+        }
+        AppendUtf8(&result, codePoint);
+    }
+    return result;
+}
+
+Symbolizer::Symbolizer(ICorProfilerInfo4* info) : m_info(info)
+{
+    m_name.resize(max_name_length);
+}
+
+void Symbolizer::Resolve(uintptr_t address, FrameName* frame)
+{
+    FunctionID functionId = 0;
+    if (m_info != nullptr && SUCCEEDED(m_info->GetFunctionFromIP((LPCBYTE) address, &functionId)) &&
+        functionId != 0 && ResolveManaged(functionId, frame))
+    {
+        m_managed_count++;
+        return;
+    }
+
+    Dl_info info;
+    frame->managed = false;
+    if (dladdr((void*) address, &info) != 0 && info.dli_fname != nullptr)
+    {
+        frame->file = GetFileName(info.dli_fname);
+        if (info.dli_sname != nullptr)
+        {
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            frame->function = status == 0 && demangled != nullptr ? demangled : info.dli_sname;
+            free(demangled);
+        }
+        else
+        {
+            // Stripped library, the offset in the file still tells the function apart
+            frame->function = "[" + frame->file + "+" + FormatAddress(address - (uintptr_t) info.dli_fbase) + "]";
+        }
+        m_native_count++;
+        return;
+    }
+
+    frame->function = "[unknown " + FormatAddress(address) + "]";
+    frame->file.clear();
+    m_unknown_count++;
+}
+
+bool Symbolizer::ResolveManaged(FunctionID functionId, FrameName* frame)
+{
+    const auto cached = m_functions.find(functionId);
+    if (cached != m_functions.end())
+    {
+        *frame = cached->second;
+        return true;
+    }
+
+    ClassID classId = 0;
+    ModuleID moduleId = 0;
+    mdToken token = mdTokenNil;
+    if (FAILED(m_info->GetFunctionInfo(functionId, &classId, &moduleId, &token)))
+    {
+        return false;
+    }
+
+    IMetaDataImport* metadataImport = nullptr;
+    if (FAILED(m_info->GetModuleMetaData(moduleId, ofRead, IID_IMetaDataImport, (IUnknown**) &metadataImport)))
+    {
+        return false;
+    }
+
+    FrameName name;
+    mdTypeDef typeDef = mdTypeDefNil;
+    ULONG length = 0;
+    if (SUCCEEDED(metadataImport->GetMethodProps(token, &typeDef, m_name.data(), max_name_length, &length, nullptr,
+                                                 nullptr, nullptr, nullptr, nullptr)))
+    {
+        name.function = ToUtf8(m_name.data(), GetNameLength(length));
+    }
+    else
+    {
+        name.function = "[method " + FormatAddress(token) + "]";
+    }
+
+    // Namespace.Outer+Nested.Method, as in the managed stack traces
+    const auto typeName = GetTypeName(metadataImport, typeDef);
+    metadataImport->Release();
+
+    if (!typeName.empty())
+    {
+        name.function = typeName + "." + name.function;
+    }
+    name.file = GetModuleName(moduleId);
+    name.managed = true;
+
+    *frame = name;
+    m_functions.emplace(functionId, std::move(name));
+    return true;
+}
+
+std::string Symbolizer::GetTypeName(IMetaDataImport* metadataImport, mdTypeDef typeDef)
+{
+    std::string typeName;
+    ULONG length = 0;
+    for (int depth = 0; typeDef != mdTypeDefNil && depth < 8; depth++)
+    {
+        if (FAILED(metadataImport->GetTypeDefProps(typeDef, m_name.data(), max_name_length, &length, nullptr,
+                                                   nullptr)))
+        {
+            break;
+        }
+
+        auto outer = ToUtf8(m_name.data(), GetNameLength(length));
+        typeName = typeName.empty() ? outer : outer + "+" + typeName;
+
+        mdTypeDef enclosing = mdTypeDefNil;
+        if (FAILED(metadataImport->GetNestedClassProps(typeDef, &enclosing)))
+        {
+            break;
+        }
+        typeDef = enclosing;
+    }
+    return typeName;
+}
+
+bool Symbolizer::ResolveClass(ClassID classId, std::string* name)
+{
+    if (m_info == nullptr || classId == 0)
+    {
+        return false;
+    }
+
+    const auto cached = m_classes.find(classId);
+    if (cached != m_classes.end())
+    {
+        *name = cached->second;
+        return true;
+    }
+
+    CorElementType elementType;
+    ClassID elementClassId = 0;
+    ULONG rank = 0;
+    if (m_info->IsArrayClass(classId, &elementType, &elementClassId, &rank) == S_OK)
+    {
+        std::string elementName;
+        if (!ResolveClass(elementClassId, &elementName))
+        {
+            return false;
+        }
+        *name = elementName + "[" + std::string(rank > 1 ? rank - 1 : 0, ',') + "]";
+    }
+    else
+    {
+        ModuleID moduleId = 0;
+        mdTypeDef typeDef = mdTypeDefNil;
+        if (FAILED(m_info->GetClassIDInfo(classId, &moduleId, &typeDef)) || typeDef == mdTypeDefNil)
+        {
+            return false;
+        }
+
+        IMetaDataImport* metadataImport = nullptr;
+        if (FAILED(m_info->GetModuleMetaData(moduleId, ofRead, IID_IMetaDataImport, (IUnknown**) &metadataImport)))
+        {
+            return false;
+        }
+        *name = GetTypeName(metadataImport, typeDef);
+        metadataImport->Release();
+
+        if (name->empty())
+        {
+            return false;
+        }
+    }
+
+    m_classes.emplace(classId, *name);
+    return true;
+}
+
+const std::string& Symbolizer::GetModuleName(ModuleID moduleId)
+{
+    auto found = m_modules.find(moduleId);
+    if (found != m_modules.end())
+    {
+        return found->second;
+    }
+
+    ULONG length = 0;
+    std::string name;
+    if (SUCCEEDED(m_info->GetModuleInfo(moduleId, nullptr, max_name_length, &length, m_name.data(), nullptr)))
+    {
+        name = GetFileName(ToUtf8(m_name.data(), GetNameLength(length)));
+    }
+    return m_modules.emplace(moduleId, std::move(name)).first->second;
+}
+
+void Symbolizer::Clear()
+{
+    m_functions.clear();
+    m_modules.clear();
+    m_classes.clear();
+}
+
+uint64_t Symbolizer::GetManagedCount() const
+{
+    return m_managed_count;
+}
+
+uint64_t Symbolizer::GetNativeCount() const
+{
+    return m_native_count;
+}
+
+uint64_t Symbolizer::GetUnknownCount() const
+{
+    return m_unknown_count;
+}
+
+} // namespace datadog::profiler
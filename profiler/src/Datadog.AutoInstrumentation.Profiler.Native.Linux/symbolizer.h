@@ -0,0 +1,67 @@
+#ifndef DD_PROFILER_SYMBOLIZER_H_
+#define DD_PROFILER_SYMBOLIZER_H_
+
+#include "cor.h"
+#include "corprof.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace datadog::profiler
+{
+
+struct FrameName
+{
+    std::string function;
+    // Assembly or shared library file name, without the directory
+    std::string file;
+    bool managed = false;
+};
+
+/// <summary>
+/// Names the addresses captured by the sampler, away from the signal handler. Managed code is resolved through
+/// GetFunctionFromIP, GetFunctionInfo and the module metadata, native code through dladdr. Managed functions
+/// and classes are cached by id. Only used by the collector thread.
+/// </summary>
+class Symbolizer
+{
+private:
+    ICorProfilerInfo4* m_info;
+    std::unordered_map<FunctionID, FrameName> m_functions;
+    std::unordered_map<ModuleID, std::string> m_modules;
+    std::unordered_map<ClassID, std::string> m_classes;
+    std::vector<WCHAR> m_name;
+
+    uint64_t m_managed_count = 0;
+    uint64_t m_native_count = 0;
+    uint64_t m_unknown_count = 0;
+
+    bool ResolveManaged(FunctionID functionId, FrameName* frame);
+    const std::string& GetModuleName(ModuleID moduleId);
+    std::string GetTypeName(IMetaDataImport* metadataImport, mdTypeDef typeDef);
+
+public:
+    // info can be null, only native frames are resolved then.
+    explicit Symbolizer(ICorProfilerInfo4* info);
+
+    void Resolve(uintptr_t address, FrameName* frame);
+
+    // Namespace and name of the class, generic arguments are left out and arrays end with []. Returns false
+    // when the class can't be resolved, or without ICorProfilerInfo.
+    bool ResolveClass(ClassID classId, std::string* name);
+
+    // Forgets the managed functions, their ids can be reused once their assembly is unloaded.
+    void Clear();
+
+    uint64_t GetManagedCount() const;
+    uint64_t GetNativeCount() const;
+    uint64_t GetUnknownCount() const;
+};
+
+// Converts a UTF-16 string of the runtime to UTF-8, unpaired surrogates become U+FFFD.
+std::string ToUtf8(const WCHAR* value, size_t length);
+
+} // namespace datadog::profiler
+
+#endif // DD_PROFILER_SYMBOLIZER_H_
@@ -0,0 +1,228 @@
+#include "gtest/gtest.h"
+
+#include "allocation_profiler.h"
+#include "configuration.h"
+#include "sampling_profiler.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+#include <thread>
+
+using namespace datadog::profiler;
+
+namespace
+{
+// AllocationTick payload as written by the runtime, see ClrEtwAll.man
+std::vector<BYTE> CreateAllocationTick(uint32_t version, uint64_t amount, uintptr_t classId,
+                                       const std::u16string& typeName, uint64_t objectSize)
+{
+  std::vector<BYTE> payload;
+  const auto append = [&payload](const void* value, size_t size) {
+    const auto* bytes = static_cast<const BYTE*>(value);
+    payload.insert(payload.end(), bytes, bytes + size);
+  };
+
+  const auto amount32 = (uint32_t) amount;
+  const uint32_t kind = 0;
+  const uint16_t clrInstanceId = 0;
+  const uint32_t heapIndex = 0;
+  const uintptr_t address = 0x7f0000001000;
+  append(&amount32, sizeof(amount32));
+  append(&kind, sizeof(kind));
+  append(&clrInstanceId, sizeof(clrInstanceId));
+  append(&amount, sizeof(amount));
+  append(&classId, sizeof(classId));
+  append(typeName.c_str(), (typeName.size() + 1) * sizeof(char16_t));
+  append(&heapIndex, sizeof(heapIndex));
+  if (version >= 3)
+  {
+    append(&address, sizeof(address));
+  }
+  if (version >= 4)
+  {
+    append(&objectSize, sizeof(objectSize));
+  }
+  return payload;
+}
+
+// Allocations of the given size until the given number of bytes, the sampled bytes are returned
+uint64_t Allocate(AllocationProfiler* profiler, uintptr_t classId, uint64_t size, uint64_t total)
+{
+  for (uint64_t allocated = 0; allocated < total; allocated += size)
+  {
+    profiler->RecordAllocation(classId, size);
+  }
+
+  std::vector<AllocationEntry> entries;
+  profiler->Drain(&entries);
+  uint64_t bytes = 0;
+  for (const auto& entry : entries)
+  {
+    EXPECT_EQ(classId, entry.class_id);
+    bytes += entry.bytes;
+  }
+  return bytes;
+}
+} // namespace
+
+TEST(AllocationProfilerTest, ParsesAllocationTick) {
+  const auto payload = CreateAllocationTick(4, 102400, 0x1234, u"System.String", 48);
+
+  AllocationTick tick;
+  ASSERT_TRUE(ParseAllocationTick(4, payload.data(), (ULONG) payload.size(), &tick));
+  EXPECT_EQ(102400u, tick.amount);
+  EXPECT_EQ(0x1234u, tick.class_id);
+  EXPECT_EQ(48u, tick.object_size);
+  ASSERT_EQ(13u, tick.type_name_length);
+  EXPECT_EQ(0, memcmp(u"System.String", tick.type_name, 13 * sizeof(char16_t)));
+
+  const auto older = CreateAllocationTick(3, 102400, 0x1234, u"System.String", 0);
+  ASSERT_TRUE(ParseAllocationTick(3, older.data(), (ULONG) older.size(), &tick));
+  EXPECT_EQ(0u, tick.object_size);
+
+  EXPECT_FALSE(ParseAllocationTick(1, payload.data(), (ULONG) payload.size(), &tick));
+  EXPECT_FALSE(ParseAllocationTick(4, payload.data(), 30, &tick));
+}
+
+TEST(AllocationProfilerTest, AggregatesAllocationTicks) {
+  AllocationProfiler profiler(nullptr, nullptr, 102400);
+  const auto payload = CreateAllocationTick(4, 102400, 0x1234, u"System.Byte[]", 1024);
+  const UINT_PTR frames[] = {0x1000, 0x2000};
+
+  profiler.OnAllocationTick(4, payload.data(), (ULONG) payload.size(), 2, frames);
+  profiler.OnAllocationTick(4, payload.data(), (ULONG) payload.size(), 2, frames);
+  EXPECT_EQ(2u, profiler.GetSampleCount());
+
+  std::vector<AllocationEntry> entries;
+  ASSERT_EQ(1u, profiler.Drain(&entries));
+  EXPECT_EQ(2u, entries[0].samples);
+  EXPECT_EQ(200u, entries[0].count);
+  EXPECT_EQ(204800u, entries[0].bytes);
+  EXPECT_EQ(2u, entries[0].frame_count);
+
+  std::string name;
+  ASSERT_TRUE(profiler.GetTypeName(0x1234, &name));
+  EXPECT_EQ("System.Byte[]", name);
+  EXPECT_FALSE(profiler.GetTypeName(0x5678, &name));
+}
+
+TEST(AllocationProfilerTest, EstimatesAllocatedBytes) {
+  // Each thread draws its own sampling distances, a new thread starts from a fresh counter
+  std::thread([] {
+    AllocationProfiler profiler(nullptr, nullptr, 64 * 1024);
+    const uint64_t total = 1024ull * 1024 * 1024;
+
+    // Small objects are sampled rarely but each sample stands for many of them, large objects are almost always
+    // sampled; both estimates stay within a few percent of the actual bytes
+    for (const uint64_t size : {32ull, 1000ull, 256ull * 1024})
+    {
+      const auto estimated = (double) Allocate(&profiler, 1, size, total);
+      EXPECT_NEAR(1.0, estimated / (double) total, 0.05) << size << " bytes";
+    }
+  }).join();
+}
+
+TEST(AllocationProfilerTest, CapturesAllocatingStack) {
+  std::thread([] {
+    AllocationProfiler profiler(nullptr, nullptr, 1024);
+    for (int i = 0; i < 100; i++)
+    {
+      profiler.RecordAllocation(1, 4096);
+    }
+
+    std::vector<AllocationEntry> entries;
+    ASSERT_GT(profiler.Drain(&entries), 0u);
+    EXPECT_GT(entries[0].frame_count, 1u);
+  }).join();
+}
+
+TEST(AllocationProfilerTest, ExportsAllocationProfile) {
+  Configuration configuration;
+  char directory[] = "/tmp/dd-profiler-test-XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(directory));
+  configuration.output_directory = directory;
+
+  AllocationProfiler allocationProfiler(nullptr, nullptr, 1024);
+  SamplingProfiler profiler(configuration, nullptr);
+  profiler.SetAllocationProfiler(&allocationProfiler);
+  ASSERT_TRUE(profiler.Start());
+
+  const auto payload = CreateAllocationTick(4, 102400, 0x1234, u"System.Byte[]", 1024);
+  const UINT_PTR frames[] = {0x1000, 0x2000};
+  allocationProfiler.OnAllocationTick(4, payload.data(), (ULONG) payload.size(), 2, frames);
+  std::thread([&allocationProfiler] {
+    for (int i = 0; i < 100; i++)
+    {
+      allocationProfiler.RecordAllocation(0x5678, 4096);
+    }
+  }).join();
+  profiler.Stop();
+
+  // No CPU sample, only the allocation profile is written
+  EXPECT_TRUE(profiler.GetLastProfilePath().empty());
+  const auto path = profiler.GetLastAllocationProfilePath();
+  ASSERT_FALSE(path.empty());
+  EXPECT_NE(std::string::npos, path.find("/allocations_" + std::to_string(getpid()) + "_0.pprof"));
+
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream content;
+  content << file.rdbuf();
+  const auto profile = content.str();
+  EXPECT_NE(std::string::npos, profile.find("alloc_space"));
+  EXPECT_NE(std::string::npos, profile.find("allocation class"));
+  EXPECT_NE(std::string::npos, profile.find("System.Byte[]"));
+  EXPECT_NE(std::string::npos, profile.find("[class 0x5678]"));
+
+  std::remove(path.c_str());
+  rmdir(directory);
+}
+
+namespace
+{
+double GetProcessCpuTime()
+{
+  timespec now;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+  return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+} // namespace
+
+// Run with --gtest_also_run_disabled_tests --gtest_filter=AllocationProfilerTest.DISABLED_Benchmark
+TEST(AllocationProfilerTest, DISABLED_Benchmark) {
+  std::thread([] {
+    const uint64_t allocations = 500000000;
+    const uint64_t size = 64;
+
+    AllocationProfiler profiler(nullptr, nullptr, default_allocation_sampling_interval);
+    auto start = GetProcessCpuTime();
+    for (uint64_t i = 0; i < allocations; i++)
+    {
+      profiler.RecordAllocation(i & 0xF, size);
+    }
+    const auto perAllocation = (GetProcessCpuTime() - start) / (double) allocations * 1e9;
+    const auto samples = profiler.GetSampleCount();
+
+    // Every allocation sampled, to measure the cost of a sample
+    AllocationProfiler everyAllocation(nullptr, nullptr, 1);
+    const uint64_t sampled = 2000000;
+    start = GetProcessCpuTime();
+    for (uint64_t i = 0; i < sampled; i++)
+    {
+      everyAllocation.RecordAllocation(i & 0xF, size);
+    }
+    const auto perSample = (GetProcessCpuTime() - start) / (double) sampled * 1e9;
+
+    // A service allocating 500MB/s of 64B objects
+    const double rate = 500.0 * 1024 * 1024;
+    const auto overhead = (rate / size * perAllocation + rate / default_allocation_sampling_interval * perSample) / 1e9;
+    std::cout << "AllocationProfiler: " << perAllocation << "ns per allocation (" << samples << " samples), "
+              << perSample << "ns per sample, " << overhead * 100 << "% of a CPU at 500MB/s of " << size
+              << "B objects" << std::endl;
+  }).join();
+}
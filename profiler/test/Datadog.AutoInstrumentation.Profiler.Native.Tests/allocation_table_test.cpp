@@ -0,0 +1,67 @@
+#include "gtest/gtest.h"
+
+#include "allocation_table.h"
+
+using namespace datadog::profiler;
+
+TEST(AllocationTableTest, AggregatesByClassAndStack) {
+  AllocationTable table(16);
+  const uintptr_t stack[] = {0x1000, 0x2000, 0x3000};
+
+  EXPECT_TRUE(table.Add(1, stack, 3, false, 10, 640));
+  EXPECT_TRUE(table.Add(1, stack, 3, false, 20, 1280));
+  EXPECT_TRUE(table.Add(2, stack, 3, false, 1, 24));
+  EXPECT_TRUE(table.Add(1, stack + 1, 2, false, 1, 64));
+  EXPECT_EQ(3u, table.GetSize());
+
+  std::vector<AllocationEntry> entries;
+  EXPECT_EQ(3u, table.Drain(&entries));
+  ASSERT_EQ(3u, entries.size());
+  EXPECT_EQ(0u, table.GetSize());
+
+  const auto found = std::find_if(entries.begin(), entries.end(), [](const AllocationEntry& entry) {
+    return entry.class_id == 1 && entry.frame_count == 3;
+  });
+  ASSERT_NE(entries.end(), found);
+  EXPECT_EQ(2u, found->samples);
+  EXPECT_EQ(30u, found->count);
+  EXPECT_EQ(1920u, found->bytes);
+  EXPECT_EQ(0x1000u, found->frames[0]);
+  EXPECT_EQ(0x3000u, found->frames[2]);
+}
+
+TEST(AllocationTableTest, TruncatesDeepStacks) {
+  AllocationTable table(16);
+  uintptr_t stack[max_allocation_stack_depth + 8];
+  for (size_t i = 0; i < max_allocation_stack_depth + 8; i++)
+  {
+    stack[i] = 0x1000 + i;
+  }
+
+  EXPECT_TRUE(table.Add(1, stack, max_allocation_stack_depth + 8, false, 1, 8));
+
+  std::vector<AllocationEntry> entries;
+  ASSERT_EQ(1u, table.Drain(&entries));
+  EXPECT_EQ(max_allocation_stack_depth, entries[0].frame_count);
+  EXPECT_EQ(1u, entries[0].truncated);
+}
+
+TEST(AllocationTableTest, DropsNewKeysWhenFull) {
+  AllocationTable table(16);
+  EXPECT_EQ(16u, table.GetCapacity());
+
+  // Three quarters of the capacity
+  for (uintptr_t classId = 1; classId <= 12; classId++)
+  {
+    EXPECT_TRUE(table.Add(classId, nullptr, 0, false, 1, 8));
+  }
+  EXPECT_FALSE(table.Add(13, nullptr, 0, false, 1, 8));
+  EXPECT_EQ(1u, table.GetDroppedCount());
+
+  // Existing keys are still aggregated
+  EXPECT_TRUE(table.Add(1, nullptr, 0, false, 1, 8));
+
+  std::vector<AllocationEntry> entries;
+  EXPECT_EQ(12u, table.Drain(&entries));
+  EXPECT_TRUE(table.Add(13, nullptr, 0, false, 1, 8));
+}
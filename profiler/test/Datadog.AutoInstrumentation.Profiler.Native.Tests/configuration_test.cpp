@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+
+#include "configuration.h"
+#include "environment_variables.h"
+
+#include <cstdlib>
+
+using namespace datadog::profiler;
+
+namespace
+{
+void ClearEnvironment()
+{
+  unsetenv(environment::profiling_enabled.c_str());
+  unsetenv(environment::profiling_sampling_mode.c_str());
+  unsetenv(environment::profiling_sampling_frequency.c_str());
+  unsetenv(environment::profiling_output_directory.c_str());
+  unsetenv(environment::profiling_export_interval.c_str());
+  unsetenv(environment::profiling_allocation_enabled.c_str());
+  unsetenv(environment::profiling_allocation_sampling_interval.c_str());
+}
+} // namespace
+
+TEST(ConfigurationTest, UsesDefaults) {
+  ClearEnvironment();
+  const auto configuration = Configuration::FromEnvironment();
+  EXPECT_FALSE(configuration.enabled);
+  EXPECT_EQ(SamplingMode::Cpu, configuration.mode);
+  EXPECT_EQ(default_sampling_frequency, configuration.frequency);
+  EXPECT_EQ(default_output_directory, configuration.output_directory);
+  EXPECT_EQ(std::chrono::seconds(60), configuration.export_interval);
+  EXPECT_FALSE(configuration.allocation_enabled);
+  EXPECT_EQ(default_allocation_sampling_interval, configuration.allocation_sampling_interval);
+}
+
+TEST(ConfigurationTest, ReadsEnvironment) {
+  ClearEnvironment();
+  setenv(environment::profiling_enabled.c_str(), "true", 1);
+  setenv(environment::profiling_sampling_mode.c_str(), "Wall", 1);
+  setenv(environment::profiling_sampling_frequency.c_str(), "250", 1);
+  setenv(environment::profiling_output_directory.c_str(), "/tmp/profiles", 1);
+  setenv(environment::profiling_export_interval.c_str(), "15", 1);
+  setenv(environment::profiling_allocation_enabled.c_str(), "1", 1);
+  setenv(environment::profiling_allocation_sampling_interval.c_str(), "65536", 1);
+
+  const auto configuration = Configuration::FromEnvironment();
+  EXPECT_TRUE(configuration.enabled);
+  EXPECT_EQ(SamplingMode::Wall, configuration.mode);
+  EXPECT_EQ(250u, configuration.frequency);
+  EXPECT_EQ("/tmp/profiles", configuration.output_directory);
+  EXPECT_EQ(std::chrono::seconds(15), configuration.export_interval);
+  EXPECT_TRUE(configuration.allocation_enabled);
+  EXPECT_EQ(65536u, configuration.allocation_sampling_interval);
+  ClearEnvironment();
+}
+
+TEST(ConfigurationTest, IgnoresInvalidValues) {
+  ClearEnvironment();
+  setenv(environment::profiling_sampling_mode.c_str(), "io", 1);
+  setenv(environment::profiling_sampling_frequency.c_str(), "5000", 1);
+  setenv(environment::profiling_export_interval.c_str(), "soon", 1);
+  setenv(environment::profiling_allocation_sampling_interval.c_str(), "16", 1);
+
+  const auto configuration = Configuration::FromEnvironment();
+  EXPECT_EQ(SamplingMode::Cpu, configuration.mode);
+  EXPECT_EQ(default_sampling_frequency, configuration.frequency);
+  EXPECT_EQ(std::chrono::seconds(60), configuration.export_interval);
+  EXPECT_EQ(default_allocation_sampling_interval, configuration.allocation_sampling_interval);
+  ClearEnvironment();
+}
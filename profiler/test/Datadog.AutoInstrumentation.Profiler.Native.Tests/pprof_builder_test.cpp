@@ -0,0 +1,216 @@
+#include "gtest/gtest.h"
+
+#include "pprof_builder.h"
+
+#include <map>
+
+using namespace datadog::profiler;
+
+namespace
+{
+// Just enough of a protobuf reader to check the messages written by PprofBuilder
+struct Field
+{
+  uint32_t number;
+  uint64_t value;
+  std::string bytes;
+};
+
+uint64_t ReadVarint(const std::string& data, size_t* offset)
+{
+  uint64_t value = 0;
+  for (int shift = 0; *offset < data.size(); shift += 7)
+  {
+    const auto byte = (uint8_t) data[(*offset)++];
+    value |= (uint64_t)(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      break;
+    }
+  }
+  return value;
+}
+
+std::vector<Field> ReadFields(const std::string& data)
+{
+  std::vector<Field> fields;
+  size_t offset = 0;
+  while (offset < data.size())
+  {
+    const auto tag = ReadVarint(data, &offset);
+    Field field{(uint32_t)(tag >> 3), 0, {}};
+    if ((tag & 7) == 0)
+    {
+      field.value = ReadVarint(data, &offset);
+    }
+    else
+    {
+      const auto length = ReadVarint(data, &offset);
+      field.bytes = data.substr(offset, length);
+      offset += length;
+    }
+    fields.push_back(field);
+  }
+  return fields;
+}
+
+std::vector<uint64_t> ReadPacked(const std::string& data)
+{
+  std::vector<uint64_t> values;
+  size_t offset = 0;
+  while (offset < data.size())
+  {
+    values.push_back(ReadVarint(data, &offset));
+  }
+  return values;
+}
+
+PprofBuilder CreateBuilder()
+{
+  return PprofBuilder({{"samples", "count"}, {"cpu", "nanoseconds"}}, {"cpu", "nanoseconds"}, 10000000);
+}
+} // namespace
+
+TEST(PprofBuilderTest, DeduplicatesLocations) {
+  auto builder = CreateBuilder();
+  const auto main = builder.AddLocation("Program.Main", "App.dll");
+  const auto work = builder.AddLocation("Program.Work", "App.dll");
+
+  EXPECT_EQ(1u, main);
+  EXPECT_EQ(2u, work);
+  EXPECT_EQ(main, builder.AddLocation("Program.Main", "App.dll"));
+  EXPECT_NE(main, builder.AddLocation("Program.Main", "Other.dll"));
+  EXPECT_EQ(3u, builder.GetLocationCount());
+}
+
+TEST(PprofBuilderTest, AggregatesSamplesByStack) {
+  auto builder = CreateBuilder();
+  const uint64_t main = builder.AddLocation("Program.Main", "App.dll");
+  const uint64_t work = builder.AddLocation("Program.Work", "App.dll");
+  const uint64_t stack[] = {work, main};
+  const int64_t values[] = {1, 10000000};
+
+  builder.AddSample(stack, 2, values);
+  builder.AddSample(stack, 2, values);
+  builder.AddSample(stack + 1, 1, values);
+  EXPECT_EQ(2u, builder.GetSampleCount());
+
+  const auto fields = ReadFields(builder.Serialize(1000, 2000));
+
+  std::vector<std::string> strings;
+  std::vector<std::pair<std::vector<uint64_t>, std::vector<uint64_t>>> samples;
+  std::map<uint64_t, uint64_t> functionNames;
+  int sampleTypes = 0;
+  int locations = 0;
+  uint64_t period = 0;
+  uint64_t duration = 0;
+  for (const auto& field : fields)
+  {
+    switch (field.number)
+    {
+      case 1:
+        sampleTypes++;
+        break;
+      case 2:
+      {
+        const auto sample = ReadFields(field.bytes);
+        ASSERT_EQ(2u, sample.size());
+        samples.emplace_back(ReadPacked(sample[0].bytes), ReadPacked(sample[1].bytes));
+        break;
+      }
+      case 4:
+        locations++;
+        break;
+      case 5:
+      {
+        const auto function = ReadFields(field.bytes);
+        functionNames[function[0].value] = function[1].value;
+        break;
+      }
+      case 6:
+        strings.push_back(field.bytes);
+        break;
+      case 10:
+        duration = field.value;
+        break;
+      case 12:
+        period = field.value;
+        break;
+    }
+  }
+
+  ASSERT_FALSE(strings.empty());
+  EXPECT_EQ("", strings[0]);
+  EXPECT_EQ(2, sampleTypes);
+  EXPECT_EQ(2, locations);
+  EXPECT_EQ(10000000u, period);
+  EXPECT_EQ(2000u, duration);
+  EXPECT_EQ("Program.Work", strings[functionNames[work]]);
+
+  ASSERT_EQ(2u, samples.size());
+  EXPECT_EQ((std::vector<uint64_t>{work, main}), samples[0].first);
+  EXPECT_EQ((std::vector<uint64_t>{2, 20000000}), samples[0].second);
+  EXPECT_EQ((std::vector<uint64_t>{main}), samples[1].first);
+  EXPECT_EQ((std::vector<uint64_t>{1, 10000000}), samples[1].second);
+}
+
+TEST(PprofBuilderTest, ResetForgetsSamplesAndLocations) {
+  auto builder = CreateBuilder();
+  const uint64_t main = builder.AddLocation("Program.Main", "App.dll");
+  const int64_t values[] = {1, 1};
+  builder.AddSample(&main, 1, values);
+
+  builder.Reset();
+  EXPECT_EQ(0u, builder.GetSampleCount());
+  EXPECT_EQ(0u, builder.GetLocationCount());
+  EXPECT_EQ(1u, builder.AddLocation("Program.Work", "App.dll"));
+}
+
+TEST(PprofBuilderTest, KeepsLabeledSamplesApart) {
+  auto builder = CreateBuilder();
+  const uint64_t main = builder.AddLocation("Program.Main", "App.dll");
+  const int64_t values[] = {1, 64};
+
+  builder.AddSample(&main, 1, values, "allocation class", "System.String");
+  builder.AddSample(&main, 1, values, "allocation class", "System.String");
+  builder.AddSample(&main, 1, values, "allocation class", "System.Byte[]");
+  builder.AddSample(&main, 1, values);
+  EXPECT_EQ(3u, builder.GetSampleCount());
+
+  const auto fields = ReadFields(builder.Serialize(1000, 2000));
+
+  std::vector<std::string> strings;
+  std::vector<std::pair<std::vector<uint64_t>, std::vector<Field>>> samples;
+  for (const auto& field : fields)
+  {
+    if (field.number == 6)
+    {
+      strings.push_back(field.bytes);
+    }
+    else if (field.number == 2)
+    {
+      const auto sample = ReadFields(field.bytes);
+      std::vector<Field> labels;
+      for (size_t i = 2; i < sample.size(); i++)
+      {
+        EXPECT_EQ(3u, sample[i].number);
+        labels.push_back(sample[i]);
+      }
+      samples.emplace_back(ReadPacked(sample[1].bytes), labels);
+    }
+  }
+
+  ASSERT_EQ(3u, samples.size());
+  EXPECT_EQ((std::vector<uint64_t>{2, 128}), samples[0].first);
+  EXPECT_EQ((std::vector<uint64_t>{1, 64}), samples[1].first);
+  EXPECT_EQ((std::vector<uint64_t>{1, 64}), samples[2].first);
+  EXPECT_TRUE(samples[2].second.empty());
+
+  ASSERT_EQ(1u, samples[0].second.size());
+  const auto label = ReadFields(samples[0].second[0].bytes);
+  ASSERT_EQ(2u, label.size());
+  EXPECT_EQ("allocation class", strings[label[0].value]);
+  EXPECT_EQ("System.String", strings[label[1].value]);
+  const auto other = ReadFields(samples[1].second[0].bytes);
+  EXPECT_EQ("System.Byte[]", strings[other[1].value]);
+}
@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+
+#include "sample_buffer.h"
+
+using namespace datadog::profiler;
+
+TEST(SampleBufferTest, ReturnsSamplesInOrder) {
+  SampleBuffer buffer;
+  ASSERT_TRUE(buffer.IsEmpty());
+  ASSERT_EQ(nullptr, buffer.Peek());
+
+  for (uint64_t i = 0; i < 3; i++)
+  {
+    auto* sample = buffer.TryReserve();
+    ASSERT_NE(nullptr, sample);
+    sample->timestamp_ns = i;
+    sample->frame_count = 1;
+    buffer.Commit();
+  }
+
+  for (uint64_t i = 0; i < 3; i++)
+  {
+    const auto* sample = buffer.Peek();
+    ASSERT_NE(nullptr, sample);
+    EXPECT_EQ(i, sample->timestamp_ns);
+    buffer.Pop();
+  }
+  EXPECT_TRUE(buffer.IsEmpty());
+}
+
+TEST(SampleBufferTest, DropsSamplesWhenFull) {
+  SampleBuffer buffer;
+  for (uint32_t i = 0; i < SampleBuffer::capacity; i++)
+  {
+    ASSERT_NE(nullptr, buffer.TryReserve());
+    buffer.Commit();
+  }
+
+  EXPECT_EQ(nullptr, buffer.TryReserve());
+  EXPECT_EQ(nullptr, buffer.TryReserve());
+  EXPECT_EQ(2u, buffer.GetDroppedCount());
+
+  // Room again once the consumer catches up
+  buffer.Pop();
+  EXPECT_NE(nullptr, buffer.TryReserve());
+}
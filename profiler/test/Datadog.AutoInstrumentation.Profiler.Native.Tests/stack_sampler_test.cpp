@@ -0,0 +1,308 @@
+#include "gtest/gtest.h"
+
+#include "sampling_profiler.h"
+#include "stack_sampler.h"
+#include "symbolizer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <signal.h>
+#include <sstream>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace datadog::profiler;
+
+// Not inlined and exported, so that the samples show them and dladdr names them
+extern "C" __attribute__((noinline)) uint64_t ProfilerTestMix(uint64_t hash, uint64_t value)
+{
+  hash ^= value;
+  hash *= 1099511628211ull;
+  return hash;
+}
+
+extern "C" __attribute__((noinline)) uint64_t ProfilerTestWork(uint64_t iterations)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (uint64_t i = 0; i < iterations; i++)
+  {
+    hash = ProfilerTestMix(hash, i);
+  }
+  return hash;
+}
+
+namespace
+{
+volatile uint64_t sink;
+
+pid_t GetTid()
+{
+  return (pid_t) syscall(SYS_gettid);
+}
+
+std::chrono::nanoseconds GetThreadCpuTime()
+{
+  timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+}
+
+// Runs for the given CPU time, however long the thread waits for a CPU
+void BurnCpu(std::chrono::milliseconds duration)
+{
+  const auto end = GetThreadCpuTime() + duration;
+  while (GetThreadCpuTime() < end)
+  {
+    sink = ProfilerTestWork(100000);
+  }
+}
+
+bool Contains(const std::vector<CollectedSample>& samples, const std::string& function)
+{
+  Symbolizer symbolizer(nullptr);
+  FrameName frame;
+  for (const auto& collected : samples)
+  {
+    for (uint32_t i = 0; i < collected.sample.frame_count; i++)
+    {
+      symbolizer.Resolve(i == 0 ? collected.sample.frames[i] : collected.sample.frames[i] - 1, &frame);
+      if (frame.function == function)
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+std::string CreateTemporaryDirectory()
+{
+  char path[] = "/tmp/dd-profiler-test-XXXXXX";
+  return mkdtemp(path) == nullptr ? std::string() : std::string(path);
+}
+} // namespace
+
+TEST(StackSamplerTest, SamplesRegisteredThread) {
+  StackSampler sampler(SamplingMode::Cpu, 1000);
+  ASSERT_TRUE(sampler.Start());
+  ASSERT_TRUE(sampler.RegisterThread(1, GetTid()));
+  EXPECT_EQ(1u, sampler.GetThreadCount());
+
+  // Collected as often as the profiler does, the thread buffer only holds 64 samples
+  std::vector<CollectedSample> samples;
+  for (int i = 0; i < 10; i++)
+  {
+    BurnCpu(std::chrono::milliseconds(20));
+    sampler.Collect(&samples);
+  }
+  sampler.UnregisterThread(1);
+  sampler.Collect(&samples);
+
+  // 200 samples expected, timers of a loaded machine can be late
+  EXPECT_GE(samples.size(), 50u);
+  EXPECT_EQ(sampler.GetSampleCount(), samples.size() + sampler.GetDroppedCount());
+  EXPECT_GT(sampler.GetHandlerNanoseconds(), 0U);
+  EXPECT_EQ(0u, sampler.GetThreadCount());
+
+  // The frame pointer walk goes past the interrupted function
+  const auto deepest = std::max_element(samples.begin(), samples.end(), [](const auto& a, const auto& b) {
+    return a.sample.frame_count < b.sample.frame_count;
+  });
+  ASSERT_NE(samples.end(), deepest);
+  EXPECT_GE(deepest->sample.frame_count, 3u);
+  EXPECT_EQ(1u, deepest->thread_id);
+  EXPECT_TRUE(Contains(samples, "ProfilerTestWork"));
+}
+
+TEST(StackSamplerTest, StopsSamplingUnregisteredThread) {
+  StackSampler sampler(SamplingMode::Cpu, 1000);
+  ASSERT_TRUE(sampler.Start());
+  ASSERT_TRUE(sampler.RegisterThread(1, GetTid()));
+  BurnCpu(std::chrono::milliseconds(50));
+  sampler.UnregisterThread(1);
+
+  std::vector<CollectedSample> samples;
+  sampler.Collect(&samples);
+  EXPECT_GT(samples.size(), 0u);
+
+  samples.clear();
+  BurnCpu(std::chrono::milliseconds(50));
+  sampler.Collect(&samples);
+  EXPECT_EQ(0u, samples.size());
+}
+
+TEST(StackSamplerTest, WallModeSamplesWaitingThread) {
+  StackSampler sampler(SamplingMode::Wall, 1000);
+  ASSERT_TRUE(sampler.Start());
+  ASSERT_TRUE(sampler.RegisterThread(1, GetTid()));
+
+  // The CPU clock wouldn't advance while sleeping
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  sampler.UnregisterThread(1);
+
+  std::vector<CollectedSample> samples;
+  sampler.Collect(&samples);
+  EXPECT_GE(samples.size(), 10u);
+}
+
+TEST(StackSamplerTest, OnlyCapturesInterruptedFrameOfOtherThreads) {
+  StackSampler sampler(SamplingMode::Cpu, 1000);
+  ASSERT_TRUE(sampler.Start());
+
+  // Registered from another thread, the stack bounds of the worker are unknown
+  std::atomic<pid_t> workerTid = {0};
+  std::atomic_bool registered = {false};
+  std::thread worker([&] {
+    workerTid = GetTid();
+    while (!registered)
+    {
+      std::this_thread::yield();
+    }
+    BurnCpu(std::chrono::milliseconds(100));
+  });
+
+  while (workerTid == 0)
+  {
+    std::this_thread::yield();
+  }
+  ASSERT_TRUE(sampler.RegisterThread(2, workerTid));
+  registered = true;
+  worker.join();
+  sampler.UnregisterThread(2);
+
+  std::vector<CollectedSample> samples;
+  sampler.Collect(&samples);
+  ASSERT_GT(samples.size(), 0u);
+  for (const auto& collected : samples)
+  {
+    EXPECT_EQ(2u, collected.thread_id);
+    EXPECT_EQ(1u, collected.sample.frame_count);
+  }
+}
+
+TEST(SamplingProfilerTest, WritesPprofFile) {
+  Configuration configuration;
+  configuration.enabled = true;
+  configuration.frequency = 1000;
+  configuration.output_directory = CreateTemporaryDirectory() + "/profiles";
+
+  SamplingProfiler profiler(configuration, nullptr);
+  ASSERT_TRUE(profiler.Start());
+  ASSERT_TRUE(profiler.RegisterThread(1, GetTid()));
+  BurnCpu(std::chrono::milliseconds(100));
+  profiler.Stop();
+
+  const auto path = profiler.GetLastProfilePath();
+  ASSERT_FALSE(path.empty());
+  EXPECT_NE(std::string::npos, path.find("/profile_" + std::to_string(getpid()) + "_0.pprof"));
+
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream content;
+  content << file.rdbuf();
+  const auto profile = content.str();
+  EXPECT_NE(std::string::npos, profile.find("ProfilerTestWork"));
+  EXPECT_NE(std::string::npos, profile.find("nanoseconds"));
+  EXPECT_NE(std::string::npos, profiler.ToString().find("Profiles=1"));
+
+  std::remove(path.c_str());
+  rmdir(configuration.output_directory.c_str());
+  rmdir(configuration.output_directory.substr(0, configuration.output_directory.rfind('/')).c_str());
+}
+
+TEST(SamplingProfilerTest, DoesNotWriteEmptyProfiles) {
+  Configuration configuration;
+  configuration.output_directory = CreateTemporaryDirectory();
+
+  SamplingProfiler profiler(configuration, nullptr);
+  ASSERT_TRUE(profiler.Start());
+  profiler.Stop();
+
+  EXPECT_TRUE(profiler.GetLastProfilePath().empty());
+  rmdir(configuration.output_directory.c_str());
+}
+
+namespace
+{
+// Process CPU time covers the signal handler, the kernel side of the timers and the collector thread, but not
+// the other processes of the machine
+double RunWork(uint64_t iterations)
+{
+  timespec start;
+  timespec end;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &start);
+  sink = ProfilerTestWork(iterations);
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &end);
+  return (double) (end.tv_sec - start.tv_sec) + (double) (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+// Round trip of a SIGPROF the sampler handler doesn't own: kernel entry, delivery, handler lookup and sigreturn.
+// Timer signals are raised by the kernel and skip the system call, so this is an upper bound.
+double MeasureSignalDeliveryNs()
+{
+  const int signals = 100000;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < signals; i++)
+  {
+    raise(SIGPROF);
+  }
+  return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+             .count() /
+         signals;
+}
+
+void MeasureOverhead(uint32_t frequency)
+{
+  Configuration configuration;
+  configuration.frequency = frequency;
+  configuration.output_directory = CreateTemporaryDirectory();
+  SamplingProfiler profiler(configuration, nullptr);
+  ASSERT_TRUE(profiler.Start());
+
+  // Around a quarter of a second of work per run, each sampled run is compared with the run just before it
+  const uint64_t iterations = 200000000;
+  const int rounds = 15;
+  std::vector<double> overheads;
+  double baselineTotal = 0;
+  for (int round = 0; round < rounds; round++)
+  {
+    const auto baseline = RunWork(iterations);
+    ASSERT_TRUE(profiler.RegisterThread(1, GetTid()));
+    const auto sampled = RunWork(iterations);
+    profiler.UnregisterThread(1);
+
+    baselineTotal += baseline;
+    overheads.push_back((sampled - baseline) / baseline * 100);
+  }
+  const auto deliveryNs = MeasureSignalDeliveryNs();
+  profiler.Stop();
+
+  // Comparing CPU times only bounds the overhead as tightly as the run-to-run noise of the machine allows, the
+  // cost of a sample times the samples per second of a busy thread gives the overhead itself
+  const auto& sampler = profiler.GetSampler();
+  const auto handlerNs = (double) sampler.GetHandlerNanoseconds() / sampler.GetSampleCount();
+  const auto estimated = (handlerNs + deliveryNs) * frequency / 1e9 * 100;
+
+  std::sort(overheads.begin(), overheads.end());
+  std::cout << "SamplingProfiler: " << frequency << "Hz, " << baselineTotal / rounds * 1000
+            << "ms CPU per run, measured overhead median " << overheads[rounds / 2] << "% (min " << overheads.front()
+            << "%, max " << overheads.back() << "%), " << sampler.GetSampleCount() << " samples, "
+            << sampler.GetDroppedCount() << " dropped" << std::endl;
+  std::cout << "SamplingProfiler: " << frequency << "Hz, " << handlerNs << "ns in the handler + " << deliveryNs
+            << "ns of signal delivery per sample, estimated overhead " << estimated << "% of a busy thread"
+            << std::endl;
+
+  std::remove(profiler.GetLastProfilePath().c_str());
+  rmdir(configuration.output_directory.c_str());
+}
+} // namespace
+
+// Run with --gtest_also_run_disabled_tests --gtest_filter=SamplingProfilerTest.DISABLED_Benchmark
+TEST(SamplingProfilerTest, DISABLED_Benchmark) {
+  MeasureOverhead(100);
+  // Ten times the samples, to tell the cost of sampling apart from the noise
+  MeasureOverhead(1000);
+}
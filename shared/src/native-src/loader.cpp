@@ -29,7 +29,7 @@ namespace shared
 
     // We exclude here the direct references of the loader to avoid a cyclic reference problem.
     // Also well-known assemblies we want to avoid.
-    const WSTRING _assembliesExclusionList[] =
+    const std::unordered_set<WSTRING> _assembliesExclusionSet =
     {
         WStr("netstandard"),
         WStr("System"),
@@ -167,11 +167,6 @@ namespace shared
 
     HRESULT Loader::InjectLoaderToModuleInitializer(const ModuleID moduleId)
     {
-        //
-        // global lock
-        //
-        std::lock_guard<std::mutex> guard(_loadersLoadedMutex);
-
         // **************************************************************************************************************
         //
         // retrieve AssemblyID from ModuleID
@@ -225,7 +220,7 @@ namespace shared
         //
         // check if the loader has been already loaded for this AppDomain
         //
-        if (_loadersLoadedSet.find(appDomainId) != _loadersLoadedSet.end())
+        if (IsLoaderLoadedInAppDomain(appDomainId))
         {
             if (_loaderOptions.LogDebugIsEnabled)
             {
@@ -238,17 +233,14 @@ namespace shared
         //
         // skip libraries from the exclusion list.
         //
-        for (const auto asm_name : _assembliesExclusionList)
+        if (_assembliesExclusionSet.find(assemblyNameString) != _assembliesExclusionSet.end())
         {
-            if (assemblyNameString == asm_name)
+            if (_loaderOptions.LogDebugIsEnabled)
             {
-                if (_loaderOptions.LogDebugIsEnabled)
-                {
-                    Debug("Loader::InjectLoaderToModuleInitializer: Skipping " + ToString(assemblyNameString) + " [AppDomainID=" + appDomainIdHex + "]");
-                }
-
-                return S_FALSE;
+                Debug("Loader::InjectLoaderToModuleInitializer: Skipping " + ToString(assemblyNameString) + " [AppDomainID=" + appDomainIdHex + "]");
             }
+
+            return S_FALSE;
         }
 
         // **************************************************************************************************************
@@ -284,6 +276,8 @@ namespace shared
             mdAssembly corLibAssembly;
             assemblyImport->GetAssemblyFromScope(&corLibAssembly);
 
+            std::lock_guard<std::mutex> guard(_injectionMutex);
+
             _corlibMetadata.ModuleId = moduleId;
             _corlibMetadata.Id = assemblyId;
             _corlibMetadata.Token = corLibAssembly;
@@ -395,7 +389,7 @@ namespace shared
             // Rewrite Module EntryPoint
             //
             const mdToken moduleEntryPoint = GetModuleEntryPointToken(moduleBaseLoadAddress, moduleFlags);
-            if (moduleEntryPoint != NULL && moduleEntryPoint != mdTokenNil && _corlibMetadata.Token != mdAssemblyNil)
+            if (moduleEntryPoint != NULL && moduleEntryPoint != mdTokenNil && IsCorlibMetadataAvailable())
             {
                 constexpr DWORD NameBuffSize = 1024;
 
@@ -435,6 +429,8 @@ namespace shared
                           moduleEntryPointHex + " (" + moduleEntryPointFullName + ").");
                 }
 
+                std::lock_guard<std::mutex> guard(_injectionMutex);
+
                 mdAssemblyRef corlibAssemblyRef = mdAssemblyRefNil;
                 hr = assmeblyEmit->DefineAssemblyRef(_corlibMetadata.pPublicKey,
                                                      _corlibMetadata.PublicKeyLength,
@@ -558,7 +554,11 @@ namespace shared
             //  }
             //
             // **************************************************************************************************************
-            hr = EmitLoaderInModule(metadataImport, metadataEmit, moduleId, appDomainId, assemblyNameString);
+            {
+                std::lock_guard<std::mutex> guard(_injectionMutex);
+                hr = EmitLoaderInModule(metadataImport, metadataEmit, moduleId, appDomainId, assemblyNameString);
+            }
+
             if (FAILED(hr))
             {
                 return hr;
@@ -613,7 +613,7 @@ namespace shared
 
         // Disable NGEN images for any entrypoint we processed.
         {
-            std::lock_guard<std::mutex> guard(_loadersLoadedMutex);
+            std::lock_guard<std::mutex> guard(_injectionMutex);
             for (const auto& entrypoint : _processedEntryPoints)
             {
                 if (entrypoint.ModuleId == moduleId && entrypoint.Token == functionToken)
@@ -712,6 +712,24 @@ namespace shared
 
     //
 
+    bool Loader::IsLoaderLoadedInAppDomain(AppDomainID appDomainId)
+    {
+        std::lock_guard<std::mutex> guard(_loadersLoadedMutex);
+        return _loadersLoadedSet.find(appDomainId) != _loadersLoadedSet.end();
+    }
+
+    bool Loader::TryMarkLoaderLoadedInAppDomain(AppDomainID appDomainId)
+    {
+        std::lock_guard<std::mutex> guard(_loadersLoadedMutex);
+        return _loadersLoadedSet.insert(appDomainId).second;
+    }
+
+    bool Loader::IsCorlibMetadataAvailable()
+    {
+        std::lock_guard<std::mutex> guard(_injectionMutex);
+        return _corlibMetadata.Token != mdAssemblyNil;
+    }
+
     HRESULT Loader::EmitLoaderCallInMethod(ModuleID moduleId, mdMethodDef methodDef, mdMethodDef loaderMethodDef) {
         HRESULT hr;
         std::string moduleIdHex = "0x" + HexStr(moduleId);
@@ -1695,11 +1713,6 @@ namespace shared
 
     bool Loader::GetAssemblyAndSymbolsBytes(void** ppAssemblyArray, int* pAssemblySize, void** ppSymbolsArray, int* pSymbolsSize, WCHAR* pModuleName)
     {
-        //
-        // global lock
-        //
-        std::lock_guard<std::mutex> guard(_loadersLoadedMutex);
-
         //
         // gets module name
         //
@@ -1732,7 +1745,7 @@ namespace shared
         //
         // check if the loader has been already loaded for this AppDomain
         //
-        if (_loadersLoadedSet.find(appDomainId) != _loadersLoadedSet.end())
+        if (!TryMarkLoaderLoadedInAppDomain(appDomainId))
         {
             if (_loaderOptions.LogDebugIsEnabled)
             {
@@ -1743,7 +1756,6 @@ namespace shared
         }
 
         Info("Loader::GetAssemblyAndSymbolsBytes: Loading loader data. " + trait);
-        _loadersLoadedSet.insert(appDomainId);
 
 #ifdef _WIN32
         HINSTANCE hInstance = DllHandle;
@@ -126,8 +126,12 @@ namespace shared
         RuntimeInfo _runtimeInformation;
         ICorProfilerInfo4* _pCorProfilerInfo;
 
+        // Guards only _loadersLoadedSet, so the per-AppDomain check stays cheap for every module load.
         std::mutex _loadersLoadedMutex;
         std::unordered_set<AppDomainID> _loadersLoadedSet;
+
+        // Guards the metadata emission of the injected type and the state it shares across modules.
+        std::mutex _injectionMutex;
         std::vector<EntryPointItem> _processedEntryPoints;
         AssemblyMetadata _corlibMetadata{};
 
@@ -183,6 +187,10 @@ namespace shared
             }
         }
 
+        bool IsLoaderLoadedInAppDomain(AppDomainID appDomainId);
+        bool TryMarkLoaderLoadedInAppDomain(AppDomainID appDomainId);
+        bool IsCorlibMetadataAvailable();
+
         HRESULT EmitLoaderCallInMethod(ModuleID moduleId, mdMethodDef methodDef, mdMethodDef loaderMethodDef);
 
         HRESULT EmitLoaderInModule(
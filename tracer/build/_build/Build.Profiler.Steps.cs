@@ -6,6 +6,7 @@ using System.Collections.Generic;
 using Nuke.Common.Tooling;
 using Nuke.Common.Tools.MSBuild;
 using static Nuke.Common.EnvironmentInfo;
+using static Nuke.Common.IO.FileSystemTasks;
 using static Nuke.Common.Tools.DotNet.DotNetTasks;
 using static Nuke.Common.Tools.MSBuild.MSBuildTasks;
 
@@ -33,7 +34,8 @@ partial class Build
     Target CompileProfilerNativeSrc => _ => _
         .Unlisted()
         .Description("Compiles the native profiler assets")
-        .DependsOn(CompileProfilerNativeSrcWindows);
+        .DependsOn(CompileProfilerNativeSrcWindows)
+        .DependsOn(CompileProfilerNativeSrcLinux);
 
     Target CompileProfilerNativeSrcWindows => _ => _
         .Unlisted()
@@ -62,4 +64,21 @@ partial class Build
                 .CombineWith(platforms, (m, platform) => m
                     .SetTargetPlatform(platform)));
         });
+
+    Target CompileProfilerNativeSrcLinux => _ => _
+        .Unlisted()
+        .After(CompileProfilerManagedSrc)
+        .OnlyWhenStatic(() => IsLinux)
+        .Executes(() =>
+        {
+            // The Linux sampling profiler lives in this repository, next to the tracer
+            var projectDirectory = RootDirectory / "profiler" / "src" / "Datadog.AutoInstrumentation.Profiler.Native.Linux";
+            var buildDirectory = projectDirectory / "build";
+            EnsureExistingDirectory(buildDirectory);
+
+            CMake.Value(
+                arguments: "../ -DCMAKE_BUILD_TYPE=Release",
+                workingDirectory: buildDirectory);
+            Make.Value(workingDirectory: buildDirectory);
+        });
 }
@@ -35,6 +35,8 @@ namespace PrepareRelease
 
         public string WrapperType { get; init; }
 
+        public ushort CallTargetKind { get; init; }
+
         protected bool Equals(CallTargetDefinitionSource other) =>
             IntegrationName == other.IntegrationName &&
             TargetAssembly == other.TargetAssembly &&
@@ -48,6 +50,7 @@ namespace PrepareRelease
             TargetMaximumMinor == other.TargetMaximumMinor &&
             TargetMaximumPatch == other.TargetMaximumPatch &&
             WrapperAssembly == other.WrapperAssembly &&
+            CallTargetKind == other.CallTargetKind &&
             WrapperType == other.WrapperType &&
             string.Join(',', TargetSignatureTypes ?? Array.Empty<string>()) == string.Join(',', other.TargetSignatureTypes ?? Array.Empty<string>());
 
@@ -140,7 +140,8 @@ namespace PrepareRelease
                                              TargetMaximumMinor = GetPropertyValue<ushort>(versionRange, "MaximumMinor"),
                                              TargetMaximumPatch = GetPropertyValue<ushort>(versionRange, "MaximumPatch"),
                                              WrapperAssembly = assembly.FullName,
-                                             WrapperType = wrapperType.FullName
+                                             WrapperType = wrapperType.FullName,
+                                             CallTargetKind = Convert.ToUInt16(GetPropertyValue<object>(attribute, "CallTargetKind")),
                                          };
             var cTargetInt = callTargetIntegrations.ToList();
             return callTargetIntegrations.ToList();
@@ -194,7 +195,13 @@ namespace PrepareRelease
                     swriter.Write($"{integration.TargetMaximumMinor}, ");
                     swriter.Write($"{integration.TargetMaximumPatch}, ");
                     swriter.Write($"assemblyFullName, ");
-                    swriter.Write($"\"{integration.WrapperType}\"");
+                    swriter.Write($"\"{integration.WrapperType}\", ");
+                    swriter.Write($"\"{integration.IntegrationName}\"");
+                    if (integration.CallTargetKind != 0)
+                    {
+                        swriter.Write($", (CallTarget.CallTargetKind){integration.CallTargetKind}");
+                    }
+
                     swriter.WriteLine($"),");
                 }
                 swriter.WriteLine();
@@ -0,0 +1,5 @@
+@echo off
+echo *********************
+echo .NET 5.0
+echo *********************
+%GOPATH%\\bin\\timeit.exe Samples.AspNetCoreSimpleController.windows.net50.json
@@ -44,10 +44,49 @@ namespace datadog::shared::nativeloader
     }                                                                                                                  \
     return gHR;
 
+#define RunInSubscribedProfilers(GROUP, EXPR)                                                                          \
+    HRESULT gHR = S_OK;                                                                                                \
+    for (const ProfilerDispatchEntry* entry = m_dispatchTable[(int) GROUP]; entry->Profiler != nullptr; entry++)       \
+    {                                                                                                                  \
+        HRESULT hr = entry->Profiler->EXPR;                                                                            \
+        if (FAILED(hr))                                                                                                \
+        {                                                                                                              \
+            WarnCallbackFailure(entry->Name, STR(EXPR), hr);                                                           \
+            gHR = hr;                                                                                                  \
+        }                                                                                                              \
+    }                                                                                                                  \
+    return gHR;
+
+    struct EventGroupMask
+    {
+        DWORD Low;
+        DWORD High;
+    };
+
+    // Event mask bits that make the runtime raise the callbacks of each EventGroup.
+    static const EventGroupMask EventGroupMasks[(int) EventGroup::Count] = {
+        /* AppDomainLoads  */ {COR_PRF_MONITOR_APPDOMAIN_LOADS, 0},
+        /* AssemblyLoads   */ {COR_PRF_MONITOR_ASSEMBLY_LOADS, 0},
+        /* ModuleLoads     */ {COR_PRF_MONITOR_MODULE_LOADS, 0},
+        /* ClassLoads      */ {COR_PRF_MONITOR_CLASS_LOADS, 0},
+        /* JitCompilation  */ {COR_PRF_MONITOR_JIT_COMPILATION, 0},
+        /* CacheSearches   */ {COR_PRF_MONITOR_CACHE_SEARCHES, 0},
+        /* Threads         */ {COR_PRF_MONITOR_THREADS, 0},
+        /* CodeTransitions */ {COR_PRF_MONITOR_CODE_TRANSITIONS, 0},
+        /* Remoting        */ {COR_PRF_MONITOR_REMOTING, 0},
+        /* Suspends        */ {COR_PRF_MONITOR_SUSPENDS, 0},
+        /* GC              */ {COR_PRF_MONITOR_GC, COR_PRF_HIGH_BASIC_GC | COR_PRF_HIGH_MONITOR_GC_MOVED_OBJECTS},
+        /* ObjectAllocated */ {COR_PRF_MONITOR_OBJECT_ALLOCATED, COR_PRF_HIGH_MONITOR_LARGEOBJECT_ALLOCATED},
+        /* Exceptions      */ {COR_PRF_MONITOR_EXCEPTIONS, 0},
+        /* ClrExceptions   */ {COR_PRF_MONITOR_CLR_EXCEPTIONS, 0},
+        /* EventPipe       */ {0, COR_PRF_HIGH_MONITOR_EVENT_PIPE},
+    };
+
     CorProfiler::CorProfiler(IDynamicDispatcher* dispatcher) :
         m_refCount(0), m_dispatcher(dispatcher), m_cpProfiler(nullptr), m_tracerProfiler(nullptr), m_customProfiler(nullptr)
     {
         Debug("CorProfiler::.ctor");
+        BuildDispatchTable();
     }
 
     CorProfiler::~CorProfiler()
@@ -214,6 +253,9 @@ namespace datadog::shared::nativeloader
                     Debug("CorProfiler::Initialize: *LocalMaskLow: ", local_mask_low);
                     Debug("CorProfiler::Initialize: *LocalMaskHi : ", local_mask_hi);
                     Info("CorProfiler::Initialize: Continuous Profiler initialized successfully.");
+
+                    m_cpProfilerEventMask.Low = local_mask_low;
+                    m_cpProfilerEventMask.High = info5 != nullptr ? local_mask_hi : 0;
                 }
                 else
                 {
@@ -255,6 +297,9 @@ namespace datadog::shared::nativeloader
                     Debug("CorProfiler::Initialize: *LocalMaskLow: ", local_mask_low);
                     Debug("CorProfiler::Initialize: *LocalMaskHi : ", local_mask_hi);
                     Info("CorProfiler::Initialize: Tracer Profiler initialized successfully.");
+
+                    m_tracerProfilerEventMask.Low = local_mask_low;
+                    m_tracerProfilerEventMask.High = info5 != nullptr ? local_mask_hi : 0;
                 }
                 else
                 {
@@ -296,6 +341,9 @@ namespace datadog::shared::nativeloader
                     Debug("CorProfiler::Initialize: *LocalMaskLow: ", local_mask_low);
                     Debug("CorProfiler::Initialize: *LocalMaskHi : ", local_mask_hi);
                     Info("CorProfiler::Initialize: Custom Profiler initialized successfully.");
+
+                    m_customProfilerEventMask.Low = local_mask_low;
+                    m_customProfilerEventMask.High = info5 != nullptr ? local_mask_hi : 0;
                 }
                 else
                 {
@@ -330,9 +378,48 @@ namespace datadog::shared::nativeloader
             return E_FAIL;
         }
 
+        BuildDispatchTable();
+
         return S_OK;
     }
 
+    void CorProfiler::BuildDispatchTable()
+    {
+        const ProfilerDispatchEntry profilers[MaxProfilers] = {
+            {m_cpProfiler, "Continuous Profiler"}, {m_tracerProfiler, "Tracer"}, {m_customProfiler, "Custom"}};
+        const ProfilerEventMask* masks[MaxProfilers] = {&m_cpProfilerEventMask, &m_tracerProfilerEventMask,
+                                                        &m_customProfilerEventMask};
+
+        for (int group = 0; group < (int) EventGroup::Count; group++)
+        {
+            const EventGroupMask& groupMask = EventGroupMasks[group];
+            int count = 0;
+            for (int i = 0; i < MaxProfilers; i++)
+            {
+                if (profilers[i].Profiler == nullptr)
+                {
+                    continue;
+                }
+
+                if ((masks[i]->Low & groupMask.Low) != 0 || (masks[i]->High & groupMask.High) != 0)
+                {
+                    m_dispatchTable[group][count++] = profilers[i];
+                }
+            }
+
+            m_dispatchTable[group][count] = {};
+            Debug("CorProfiler::BuildDispatchTable: EventGroup ", group, " dispatched to ", count, " profiler(s).");
+        }
+    }
+
+    void CorProfiler::WarnCallbackFailure(const char* profilerName, const char* callbackName, HRESULT hr)
+    {
+        std::ostringstream hexValue;
+        hexValue << std::hex << hr;
+        Warn("CorProfiler::", callbackName, ": [", profilerName, "] Error in ", callbackName,
+             " call: ", hexValue.str());
+    }
+
     HRESULT STDMETHODCALLTYPE CorProfiler::Shutdown()
     {
         RunInAllProfilers(Shutdown());
@@ -341,91 +428,91 @@ namespace datadog::shared::nativeloader
 
     HRESULT STDMETHODCALLTYPE CorProfiler::AppDomainCreationStarted(AppDomainID appDomainId)
     {
-        RunInAllProfilers(AppDomainCreationStarted(appDomainId));
+        RunInSubscribedProfilers(EventGroup::AppDomainLoads, AppDomainCreationStarted(appDomainId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::AppDomainCreationFinished(AppDomainID appDomainId, HRESULT hrStatus)
     {
-        RunInAllProfilers(AppDomainCreationFinished(appDomainId, hrStatus));
+        RunInSubscribedProfilers(EventGroup::AppDomainLoads, AppDomainCreationFinished(appDomainId, hrStatus));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::AppDomainShutdownStarted(AppDomainID appDomainId)
     {
-        RunInAllProfilers(AppDomainShutdownStarted(appDomainId));
+        RunInSubscribedProfilers(EventGroup::AppDomainLoads, AppDomainShutdownStarted(appDomainId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::AppDomainShutdownFinished(AppDomainID appDomainId, HRESULT hrStatus)
     {
-        RunInAllProfilers(AppDomainShutdownFinished(appDomainId, hrStatus));
+        RunInSubscribedProfilers(EventGroup::AppDomainLoads, AppDomainShutdownFinished(appDomainId, hrStatus));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::AssemblyLoadStarted(AssemblyID assemblyId)
     {
-        RunInAllProfilers(AssemblyLoadStarted(assemblyId));
+        RunInSubscribedProfilers(EventGroup::AssemblyLoads, AssemblyLoadStarted(assemblyId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::AssemblyLoadFinished(AssemblyID assemblyId, HRESULT hrStatus)
     {
-        RunInAllProfilers(AssemblyLoadFinished(assemblyId, hrStatus));
+        RunInSubscribedProfilers(EventGroup::AssemblyLoads, AssemblyLoadFinished(assemblyId, hrStatus));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::AssemblyUnloadStarted(AssemblyID assemblyId)
     {
-        RunInAllProfilers(AssemblyUnloadStarted(assemblyId));
+        RunInSubscribedProfilers(EventGroup::AssemblyLoads, AssemblyUnloadStarted(assemblyId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::AssemblyUnloadFinished(AssemblyID assemblyId, HRESULT hrStatus)
     {
-        RunInAllProfilers(AssemblyUnloadFinished(assemblyId, hrStatus));
+        RunInSubscribedProfilers(EventGroup::AssemblyLoads, AssemblyUnloadFinished(assemblyId, hrStatus));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ModuleLoadStarted(ModuleID moduleId)
     {
-        RunInAllProfilers(ModuleLoadStarted(moduleId));
+        RunInSubscribedProfilers(EventGroup::ModuleLoads, ModuleLoadStarted(moduleId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ModuleLoadFinished(ModuleID moduleId, HRESULT hrStatus)
     {
-        RunInAllProfilers(ModuleLoadFinished(moduleId, hrStatus));
+        RunInSubscribedProfilers(EventGroup::ModuleLoads, ModuleLoadFinished(moduleId, hrStatus));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ModuleUnloadStarted(ModuleID moduleId)
     {
-        RunInAllProfilers(ModuleUnloadStarted(moduleId));
+        RunInSubscribedProfilers(EventGroup::ModuleLoads, ModuleUnloadStarted(moduleId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ModuleUnloadFinished(ModuleID moduleId, HRESULT hrStatus)
     {
-        RunInAllProfilers(ModuleUnloadFinished(moduleId, hrStatus));
+        RunInSubscribedProfilers(EventGroup::ModuleLoads, ModuleUnloadFinished(moduleId, hrStatus));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ModuleAttachedToAssembly(ModuleID moduleId, AssemblyID AssemblyId)
     {
-        RunInAllProfilers(ModuleAttachedToAssembly(moduleId, AssemblyId));
+        RunInSubscribedProfilers(EventGroup::ModuleLoads, ModuleAttachedToAssembly(moduleId, AssemblyId));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ClassLoadStarted(ClassID classId)
     {
-        RunInAllProfilers(ClassLoadStarted(classId));
+        RunInSubscribedProfilers(EventGroup::ClassLoads, ClassLoadStarted(classId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ClassLoadFinished(ClassID classId, HRESULT hrStatus)
     {
-        RunInAllProfilers(ClassLoadFinished(classId, hrStatus));
+        RunInSubscribedProfilers(EventGroup::ClassLoads, ClassLoadFinished(classId, hrStatus));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ClassUnloadStarted(ClassID classId)
     {
-        RunInAllProfilers(ClassUnloadStarted(classId));
+        RunInSubscribedProfilers(EventGroup::ClassLoads, ClassUnloadStarted(classId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ClassUnloadFinished(ClassID classId, HRESULT hrStatus)
     {
-        RunInAllProfilers(ClassUnloadFinished(classId, hrStatus));
+        RunInSubscribedProfilers(EventGroup::ClassLoads, ClassUnloadFinished(classId, hrStatus));
     }
 
 
@@ -437,141 +524,143 @@ namespace datadog::shared::nativeloader
 
     HRESULT STDMETHODCALLTYPE CorProfiler::JITCompilationStarted(FunctionID functionId, BOOL fIsSafeToBlock)
     {
-        RunInAllProfilers(JITCompilationStarted(functionId, fIsSafeToBlock));
+        RunInSubscribedProfilers(EventGroup::JitCompilation, JITCompilationStarted(functionId, fIsSafeToBlock));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::JITCompilationFinished(FunctionID functionId, HRESULT hrStatus,
                                                                   BOOL fIsSafeToBlock)
     {
-        RunInAllProfilers(JITCompilationFinished(functionId, hrStatus, fIsSafeToBlock));
+        RunInSubscribedProfilers(EventGroup::JitCompilation,
+                                 JITCompilationFinished(functionId, hrStatus, fIsSafeToBlock));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::JITCachedFunctionSearchStarted(FunctionID functionId,
                                                                           BOOL* pbUseCachedFunction)
     {
-        RunInAllProfilers(JITCachedFunctionSearchStarted(functionId, pbUseCachedFunction));
+        RunInSubscribedProfilers(EventGroup::CacheSearches,
+                                 JITCachedFunctionSearchStarted(functionId, pbUseCachedFunction));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::JITCachedFunctionSearchFinished(FunctionID functionId,
                                                                            COR_PRF_JIT_CACHE result)
     {
-        RunInAllProfilers(JITCachedFunctionSearchFinished(functionId, result));
+        RunInSubscribedProfilers(EventGroup::CacheSearches, JITCachedFunctionSearchFinished(functionId, result));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::JITFunctionPitched(FunctionID functionId)
     {
-        RunInAllProfilers(JITFunctionPitched(functionId));
+        RunInSubscribedProfilers(EventGroup::JitCompilation, JITFunctionPitched(functionId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::JITInlining(FunctionID callerId, FunctionID calleeId, BOOL* pfShouldInline)
     {
-        RunInAllProfilers(JITInlining(callerId, calleeId, pfShouldInline));
+        RunInSubscribedProfilers(EventGroup::JitCompilation, JITInlining(callerId, calleeId, pfShouldInline));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ThreadCreated(ThreadID threadId)
     {
-        RunInAllProfilers(ThreadCreated(threadId));
+        RunInSubscribedProfilers(EventGroup::Threads, ThreadCreated(threadId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ThreadDestroyed(ThreadID threadId)
     {
-        RunInAllProfilers(ThreadDestroyed(threadId));
+        RunInSubscribedProfilers(EventGroup::Threads, ThreadDestroyed(threadId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ThreadAssignedToOSThread(ThreadID managedThreadId, DWORD osThreadId)
     {
-        RunInAllProfilers(ThreadAssignedToOSThread(managedThreadId, osThreadId));
+        RunInSubscribedProfilers(EventGroup::Threads, ThreadAssignedToOSThread(managedThreadId, osThreadId));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RemotingClientInvocationStarted()
     {
-        RunInAllProfilers(RemotingClientInvocationStarted());
+        RunInSubscribedProfilers(EventGroup::Remoting, RemotingClientInvocationStarted());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RemotingClientSendingMessage(GUID* pCookie, BOOL fIsAsync)
     {
-        RunInAllProfilers(RemotingClientSendingMessage(pCookie, fIsAsync));
+        RunInSubscribedProfilers(EventGroup::Remoting, RemotingClientSendingMessage(pCookie, fIsAsync));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RemotingClientReceivingReply(GUID* pCookie, BOOL fIsAsync)
     {
-        RunInAllProfilers(RemotingClientReceivingReply(pCookie, fIsAsync));
+        RunInSubscribedProfilers(EventGroup::Remoting, RemotingClientReceivingReply(pCookie, fIsAsync));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RemotingClientInvocationFinished()
     {
-        RunInAllProfilers(RemotingClientInvocationFinished());
+        RunInSubscribedProfilers(EventGroup::Remoting, RemotingClientInvocationFinished());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RemotingServerReceivingMessage(GUID* pCookie, BOOL fIsAsync)
     {
-        RunInAllProfilers(RemotingServerReceivingMessage(pCookie, fIsAsync));
+        RunInSubscribedProfilers(EventGroup::Remoting, RemotingServerReceivingMessage(pCookie, fIsAsync));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RemotingServerInvocationStarted()
     {
-        RunInAllProfilers(RemotingServerInvocationStarted());
+        RunInSubscribedProfilers(EventGroup::Remoting, RemotingServerInvocationStarted());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RemotingServerInvocationReturned()
     {
-        RunInAllProfilers(RemotingServerInvocationReturned());
+        RunInSubscribedProfilers(EventGroup::Remoting, RemotingServerInvocationReturned());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RemotingServerSendingReply(GUID* pCookie, BOOL fIsAsync)
     {
-        RunInAllProfilers(RemotingServerSendingReply(pCookie, fIsAsync));
+        RunInSubscribedProfilers(EventGroup::Remoting, RemotingServerSendingReply(pCookie, fIsAsync));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::UnmanagedToManagedTransition(FunctionID functionId,
                                                                         COR_PRF_TRANSITION_REASON reason)
     {
-        RunInAllProfilers(UnmanagedToManagedTransition(functionId, reason));
+        RunInSubscribedProfilers(EventGroup::CodeTransitions, UnmanagedToManagedTransition(functionId, reason));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ManagedToUnmanagedTransition(FunctionID functionId,
                                                                         COR_PRF_TRANSITION_REASON reason)
     {
-        RunInAllProfilers(ManagedToUnmanagedTransition(functionId, reason));
+        RunInSubscribedProfilers(EventGroup::CodeTransitions, ManagedToUnmanagedTransition(functionId, reason));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeSuspendStarted(COR_PRF_SUSPEND_REASON suspendReason)
     {
-        RunInAllProfilers(RuntimeSuspendStarted(suspendReason));
+        RunInSubscribedProfilers(EventGroup::Suspends, RuntimeSuspendStarted(suspendReason));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeSuspendFinished()
     {
-        RunInAllProfilers(RuntimeSuspendFinished());
+        RunInSubscribedProfilers(EventGroup::Suspends, RuntimeSuspendFinished());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeSuspendAborted()
     {
-        RunInAllProfilers(RuntimeSuspendAborted());
+        RunInSubscribedProfilers(EventGroup::Suspends, RuntimeSuspendAborted());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeResumeStarted()
     {
-        RunInAllProfilers(RuntimeResumeStarted());
+        RunInSubscribedProfilers(EventGroup::Suspends, RuntimeResumeStarted());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeResumeFinished()
     {
-        RunInAllProfilers(RuntimeResumeFinished());
+        RunInSubscribedProfilers(EventGroup::Suspends, RuntimeResumeFinished());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeThreadSuspended(ThreadID threadId)
     {
-        RunInAllProfilers(RuntimeThreadSuspended(threadId));
+        RunInSubscribedProfilers(EventGroup::Suspends, RuntimeThreadSuspended(threadId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeThreadResumed(ThreadID threadId)
     {
-        RunInAllProfilers(RuntimeThreadResumed(threadId));
+        RunInSubscribedProfilers(EventGroup::Suspends, RuntimeThreadResumed(threadId));
     }
 
 
@@ -579,13 +668,13 @@ namespace datadog::shared::nativeloader
                                                            ObjectID newObjectIDRangeStart[],
                                                            ULONG cObjectIDRangeLength[])
     {
-        RunInAllProfilers(
-            MovedReferences(cMovedObjectIDRanges, oldObjectIDRangeStart, newObjectIDRangeStart, cObjectIDRangeLength));
+        RunInSubscribedProfilers(EventGroup::GC, MovedReferences(cMovedObjectIDRanges, oldObjectIDRangeStart,
+                                                                 newObjectIDRangeStart, cObjectIDRangeLength));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ObjectAllocated(ObjectID objectId, ClassID classId)
     {
-        RunInAllProfilers(ObjectAllocated(objectId, classId));
+        RunInSubscribedProfilers(EventGroup::ObjectAllocated, ObjectAllocated(objectId, classId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ObjectsAllocatedByClass(ULONG cClassCount, ClassID classIds[],
@@ -597,43 +686,43 @@ namespace datadog::shared::nativeloader
     HRESULT STDMETHODCALLTYPE CorProfiler::ObjectReferences(ObjectID objectId, ClassID classId, ULONG cObjectRefs,
                                                             ObjectID objectRefIds[])
     {
-        RunInAllProfilers(ObjectReferences(objectId, classId, cObjectRefs, objectRefIds));
+        RunInSubscribedProfilers(EventGroup::GC, ObjectReferences(objectId, classId, cObjectRefs, objectRefIds));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RootReferences(ULONG cRootRefs, ObjectID rootRefIds[])
     {
-        RunInAllProfilers(RootReferences(cRootRefs, rootRefIds));
+        RunInSubscribedProfilers(EventGroup::GC, RootReferences(cRootRefs, rootRefIds));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionThrown(ObjectID thrownObjectId)
     {
-        RunInAllProfilers(ExceptionThrown(thrownObjectId));
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionThrown(thrownObjectId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionSearchFunctionEnter(FunctionID functionId)
     {
-        RunInAllProfilers(ExceptionSearchFunctionEnter(functionId));
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionSearchFunctionEnter(functionId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionSearchFunctionLeave()
     {
-        RunInAllProfilers(ExceptionSearchFunctionLeave());
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionSearchFunctionLeave());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionSearchFilterEnter(FunctionID functionId)
     {
-        RunInAllProfilers(ExceptionSearchFilterEnter(functionId));
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionSearchFilterEnter(functionId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionSearchFilterLeave()
     {
-        RunInAllProfilers(ExceptionSearchFilterLeave());
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionSearchFilterLeave());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionSearchCatcherFound(FunctionID functionId)
     {
-        RunInAllProfilers(ExceptionSearchCatcherFound(functionId));
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionSearchCatcherFound(functionId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionOSHandlerEnter(UINT_PTR __unused)
@@ -648,32 +737,32 @@ namespace datadog::shared::nativeloader
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionUnwindFunctionEnter(FunctionID functionId)
     {
-        RunInAllProfilers(ExceptionUnwindFunctionEnter(functionId));
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionUnwindFunctionEnter(functionId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionUnwindFunctionLeave()
     {
-        RunInAllProfilers(ExceptionUnwindFunctionLeave());
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionUnwindFunctionLeave());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionUnwindFinallyEnter(FunctionID functionId)
     {
-        RunInAllProfilers(ExceptionUnwindFinallyEnter(functionId));
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionUnwindFinallyEnter(functionId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionUnwindFinallyLeave()
     {
-        RunInAllProfilers(ExceptionUnwindFinallyLeave());
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionUnwindFinallyLeave());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionCatcherEnter(FunctionID functionId, ObjectID objectId)
     {
-        RunInAllProfilers(ExceptionCatcherEnter(functionId, objectId));
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionCatcherEnter(functionId, objectId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionCatcherLeave()
     {
-        RunInAllProfilers(ExceptionCatcherLeave());
+        RunInSubscribedProfilers(EventGroup::Exceptions, ExceptionCatcherLeave());
     }
 
 
@@ -692,60 +781,62 @@ namespace datadog::shared::nativeloader
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionCLRCatcherFound()
     {
-        RunInAllProfilers(ExceptionCLRCatcherFound());
+        RunInSubscribedProfilers(EventGroup::ClrExceptions, ExceptionCLRCatcherFound());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionCLRCatcherExecute()
     {
-        RunInAllProfilers(ExceptionCLRCatcherExecute());
+        RunInSubscribedProfilers(EventGroup::ClrExceptions, ExceptionCLRCatcherExecute());
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ThreadNameChanged(ThreadID threadId, ULONG cchName, WCHAR name[])
     {
-        RunInAllProfilers(ThreadNameChanged(threadId, cchName, name));
+        RunInSubscribedProfilers(EventGroup::Threads, ThreadNameChanged(threadId, cchName, name));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::GarbageCollectionStarted(int cGenerations, BOOL generationCollected[],
                                                                     COR_PRF_GC_REASON reason)
     {
-        RunInAllProfilers(GarbageCollectionStarted(cGenerations, generationCollected, reason));
+        RunInSubscribedProfilers(EventGroup::GC, GarbageCollectionStarted(cGenerations, generationCollected, reason));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::SurvivingReferences(ULONG cSurvivingObjectIDRanges,
                                                                ObjectID objectIDRangeStart[],
                                                                ULONG cObjectIDRangeLength[])
     {
-        RunInAllProfilers(SurvivingReferences(cSurvivingObjectIDRanges, objectIDRangeStart, cObjectIDRangeLength));
+        RunInSubscribedProfilers(EventGroup::GC,
+                                 SurvivingReferences(cSurvivingObjectIDRanges, objectIDRangeStart,
+                                                     cObjectIDRangeLength));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::GarbageCollectionFinished()
     {
-        RunInAllProfilers(GarbageCollectionFinished());
+        RunInSubscribedProfilers(EventGroup::GC, GarbageCollectionFinished());
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::FinalizeableObjectQueued(DWORD finalizerFlags, ObjectID objectID)
     {
-        RunInAllProfilers(FinalizeableObjectQueued(finalizerFlags, objectID));
+        RunInSubscribedProfilers(EventGroup::GC, FinalizeableObjectQueued(finalizerFlags, objectID));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::RootReferences2(ULONG cRootRefs, ObjectID rootRefIds[],
                                                            COR_PRF_GC_ROOT_KIND rootKinds[],
                                                            COR_PRF_GC_ROOT_FLAGS rootFlags[], UINT_PTR rootIds[])
     {
-        RunInAllProfilers(RootReferences2(cRootRefs, rootRefIds, rootKinds, rootFlags, rootIds));
+        RunInSubscribedProfilers(EventGroup::GC, RootReferences2(cRootRefs, rootRefIds, rootKinds, rootFlags, rootIds));
     }
 
 
     HRESULT STDMETHODCALLTYPE CorProfiler::HandleCreated(GCHandleID handleId, ObjectID initialObjectId)
     {
-        RunInAllProfilers(HandleCreated(handleId, initialObjectId));
+        RunInSubscribedProfilers(EventGroup::GC, HandleCreated(handleId, initialObjectId));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::HandleDestroyed(GCHandleID handleId)
     {
-        RunInAllProfilers(HandleDestroyed(handleId));
+        RunInSubscribedProfilers(EventGroup::GC, HandleDestroyed(handleId));
     }
 
 
@@ -796,22 +887,25 @@ namespace datadog::shared::nativeloader
                                                             ObjectID newObjectIDRangeStart[],
                                                             SIZE_T cObjectIDRangeLength[])
     {
-        RunInAllProfilers(
-            MovedReferences2(cMovedObjectIDRanges, oldObjectIDRangeStart, newObjectIDRangeStart, cObjectIDRangeLength));
+        RunInSubscribedProfilers(EventGroup::GC, MovedReferences2(cMovedObjectIDRanges, oldObjectIDRangeStart,
+                                                                  newObjectIDRangeStart, cObjectIDRangeLength));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::SurvivingReferences2(ULONG cSurvivingObjectIDRanges,
                                                                 ObjectID objectIDRangeStart[],
                                                                 SIZE_T cObjectIDRangeLength[])
     {
-        RunInAllProfilers(SurvivingReferences2(cSurvivingObjectIDRanges, objectIDRangeStart, cObjectIDRangeLength));
+        RunInSubscribedProfilers(EventGroup::GC,
+                                 SurvivingReferences2(cSurvivingObjectIDRanges, objectIDRangeStart,
+                                                      cObjectIDRangeLength));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::ConditionalWeakTableElementReferences(ULONG cRootRefs, ObjectID keyRefIds[],
                                                                                  ObjectID valueRefIds[],
                                                                                  GCHandleID rootIds[])
     {
-        RunInAllProfilers(ConditionalWeakTableElementReferences(cRootRefs, keyRefIds, valueRefIds, rootIds));
+        RunInSubscribedProfilers(EventGroup::GC,
+                                 ConditionalWeakTableElementReferences(cRootRefs, keyRefIds, valueRefIds, rootIds));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::GetAssemblyReferences(const WCHAR* wszAssemblyPath,
@@ -830,13 +924,15 @@ namespace datadog::shared::nativeloader
                                                                               BOOL fIsSafeToBlock, LPCBYTE ilHeader,
                                                                               ULONG cbILHeader)
     {
-        RunInAllProfilers(DynamicMethodJITCompilationStarted(functionId, fIsSafeToBlock, ilHeader, cbILHeader));
+        RunInSubscribedProfilers(EventGroup::JitCompilation,
+                                 DynamicMethodJITCompilationStarted(functionId, fIsSafeToBlock, ilHeader, cbILHeader));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::DynamicMethodJITCompilationFinished(FunctionID functionId, HRESULT hrStatus,
                                                                                BOOL fIsSafeToBlock)
     {
-        RunInAllProfilers(DynamicMethodJITCompilationFinished(functionId, hrStatus, fIsSafeToBlock));
+        RunInSubscribedProfilers(EventGroup::JitCompilation,
+                                 DynamicMethodJITCompilationFinished(functionId, hrStatus, fIsSafeToBlock));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::DynamicMethodUnloaded(FunctionID functionId)
@@ -852,14 +948,15 @@ namespace datadog::shared::nativeloader
                                                                    LPCGUID pRelatedActivityId, ThreadID eventThread,
                                                                    ULONG numStackFrames, UINT_PTR stackFrames[])
     {
-        RunInAllProfilers(EventPipeEventDelivered(provider, eventId, eventVersion, cbMetadataBlob, metadataBlob,
-                                                  cbEventData, eventData, pActivityId, pRelatedActivityId, eventThread,
-                                                  numStackFrames, stackFrames));
+        RunInSubscribedProfilers(EventGroup::EventPipe,
+                                 EventPipeEventDelivered(provider, eventId, eventVersion, cbMetadataBlob, metadataBlob,
+                                                         cbEventData, eventData, pActivityId, pRelatedActivityId,
+                                                         eventThread, numStackFrames, stackFrames));
     }
 
     HRESULT STDMETHODCALLTYPE CorProfiler::EventPipeProviderCreated(EVENTPIPE_PROVIDER provider)
     {
-        RunInAllProfilers(EventPipeProviderCreated(provider));
+        RunInSubscribedProfilers(EventGroup::EventPipe, EventPipeProviderCreated(provider));
     }
 
     void CorProfiler::InspectRuntimeCompatibility(IUnknown* corProfilerInfoUnk)
@@ -8,15 +8,61 @@ namespace datadog::shared::nativeloader
 
     class IDynamicDispatcher;
 
+    // Groups of high-frequency callbacks that the runtime only raises when the matching event mask bits are set.
+    enum class EventGroup : int
+    {
+        AppDomainLoads = 0,
+        AssemblyLoads,
+        ModuleLoads,
+        ClassLoads,
+        JitCompilation,
+        CacheSearches,
+        Threads,
+        CodeTransitions,
+        Remoting,
+        Suspends,
+        GC,
+        ObjectAllocated,
+        Exceptions,
+        ClrExceptions,
+        EventPipe,
+        Count
+    };
+
+    struct ProfilerEventMask
+    {
+        // Until the mask of a profiler is known, it receives every callback.
+        DWORD Low = 0xFFFFFFFF;
+        DWORD High = 0xFFFFFFFF;
+    };
+
+    struct ProfilerDispatchEntry
+    {
+        ICorProfilerCallback10* Profiler = nullptr;
+        const char* Name = nullptr;
+    };
+
     class CorProfiler : public ICorProfilerCallback10
     {
     private:
+        static const int MaxProfilers = 3;
+
         std::atomic<int> m_refCount;
         IDynamicDispatcher* m_dispatcher;
         ICorProfilerCallback10* m_cpProfiler;
         ICorProfilerCallback10* m_tracerProfiler;
         ICorProfilerCallback10* m_customProfiler;
 
+        ProfilerEventMask m_cpProfilerEventMask;
+        ProfilerEventMask m_tracerProfilerEventMask;
+        ProfilerEventMask m_customProfilerEventMask;
+
+        // For each event group, the profilers that requested it, terminated by an entry with a null Profiler.
+        ProfilerDispatchEntry m_dispatchTable[(int) EventGroup::Count][MaxProfilers + 1];
+
+        void BuildDispatchTable();
+        static void WarnCallbackFailure(const char* profilerName, const char* callbackName, HRESULT hr);
+
         void InspectRuntimeCompatibility(IUnknown* corProfilerInfoUnk);
         void InspectRuntimeVersion(ICorProfilerInfo4* pCorProfilerInfo);
 
@@ -1,9 +1,11 @@
 #include "calltarget_tokens.h"
 
 #include "dd_profiler_constants.h"
+#include "environment_variables.h"
 #include "il_rewriter_wrapper.h"
 #include "logger.h"
 #include "module_metadata.h"
+#include "stats.h"
 
 namespace trace
 {
@@ -41,6 +43,73 @@ ModuleMetadata* CallTargetTokens::GetMetadata()
     return module_metadata_ptr;
 }
 
+static std::string GetEmittedTokenKey(char kind, mdToken parent, LPCWSTR name, PCCOR_SIGNATURE signature,
+                                      ULONG signatureLength)
+{
+    const size_t nameLength = name == nullptr ? 0 : WSTRING(name).size();
+
+    std::string key;
+    key.reserve(1 + sizeof(mdToken) + sizeof(ULONG) + nameLength * sizeof(WCHAR) + signatureLength);
+    key.push_back(kind);
+    key.append((const char*) &parent, sizeof(mdToken));
+    const ULONG nameSize = (ULONG) (nameLength * sizeof(WCHAR));
+    key.append((const char*) &nameSize, sizeof(ULONG));
+    if (nameLength > 0)
+    {
+        key.append((const char*) name, nameSize);
+    }
+    key.append((const char*) signature, signatureLength);
+    return key;
+}
+
+template <typename TEmit>
+HRESULT CallTargetTokens::EmitCached(const std::string& key, mdToken* token, TEmit emit)
+{
+    std::lock_guard<std::mutex> guard(emitted_tokens_lock);
+
+    const auto it = emitted_tokens.find(key);
+    if (it != emitted_tokens.end())
+    {
+        Stats::Instance()->CallTargetEmitCacheHit();
+        *token = it->second;
+        return S_OK;
+    }
+
+    Stats::Instance()->CallTargetEmitCall();
+    const auto hr = emit();
+    if (SUCCEEDED(hr))
+    {
+        emitted_tokens[key] = *token;
+    }
+    return hr;
+}
+
+HRESULT CallTargetTokens::EmitTypeSpec(PCCOR_SIGNATURE signature, ULONG signatureLength, mdTypeSpec* typeSpec)
+{
+    const auto key = GetEmittedTokenKey('T', mdTokenNil, nullptr, signature, signatureLength);
+    return EmitCached(key, typeSpec, [&]() {
+        return GetMetadata()->metadata_emit->GetTokenFromTypeSpec(signature, signatureLength, typeSpec);
+    });
+}
+
+HRESULT CallTargetTokens::EmitMemberRef(mdToken parent, LPCWSTR name, PCCOR_SIGNATURE signature,
+                                        ULONG signatureLength, mdMemberRef* memberRef)
+{
+    const auto key = GetEmittedTokenKey('R', parent, name, signature, signatureLength);
+    return EmitCached(key, memberRef, [&]() {
+        return GetMetadata()->metadata_emit->DefineMemberRef(parent, name, signature, signatureLength, memberRef);
+    });
+}
+
+HRESULT CallTargetTokens::EmitMethodSpec(mdToken parent, PCCOR_SIGNATURE signature, ULONG signatureLength,
+                                         mdMethodSpec* methodSpec)
+{
+    const auto key = GetEmittedTokenKey('S', parent, nullptr, signature, signatureLength);
+    return EmitCached(key, methodSpec, [&]() {
+        return GetMetadata()->metadata_emit->DefineMethodSpec(parent, signature, signatureLength, methodSpec);
+    });
+}
+
 HRESULT CallTargetTokens::EnsureCorLibTokens()
 {
     ModuleMetadata* module_metadata = GetMetadata();
@@ -126,8 +195,7 @@ HRESULT CallTargetTokens::EnsureCorLibTokens()
         memcpy(&signature[offset], &runtimeTypeHandle_buffer, runtimeTypeHandle_size);
         offset += runtimeTypeHandle_size;
 
-        auto hr = module_metadata->metadata_emit->DefineMemberRef(typeRef, GetTypeFromHandleMethodName, signature,
-                                                                  offset, &getTypeFromHandleToken);
+        auto hr = EmitMemberRef(typeRef, GetTypeFromHandleMethodName, signature, offset, &getTypeFromHandleToken);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper getTypeFromHandleToken could not be defined.");
@@ -239,9 +307,8 @@ HRESULT CallTargetTokens::EnsureBaseCalltargetTokens()
         memcpy(&signature[offset], &callTargetStateTypeBuffer, callTargetStateTypeSize);
         offset += callTargetStateTypeSize;
 
-        auto hr = module_metadata->metadata_emit->DefineMemberRef(
-            callTargetStateTypeRef, managed_profiler_calltarget_statetype_getdefault_name.data(), signature,
-            signatureLength, &callTargetStateTypeGetDefault);
+        auto hr = EmitMemberRef(callTargetStateTypeRef, managed_profiler_calltarget_statetype_getdefault_name.data(),
+                                signature, signatureLength, &callTargetStateTypeGetDefault);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper callTargetStateTypeGetDefault could not be defined.");
@@ -329,7 +396,7 @@ mdTypeSpec CallTargetTokens::GetTargetReturnValueTypeRef(FunctionMethodArgument*
     memcpy(&signature[offset], returnSignatureBuffer, returnSignatureLength);
     offset += returnSignatureLength;
 
-    hr = module_metadata->metadata_emit->GetTokenFromTypeSpec(signature, signatureLength, &returnValueTypeSpec);
+    hr = EmitTypeSpec(signature, signatureLength, &returnValueTypeSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating return value type spec");
@@ -360,8 +427,6 @@ mdMemberRef CallTargetTokens::GetCallTargetReturnVoidDefaultMemberRef()
     // *** Ensure CallTargetReturn.GetDefault() member ref
     if (callTargetReturnVoidTypeGetDefault == mdMemberRefNil)
     {
-        ModuleMetadata* module_metadata = GetMetadata();
-
         unsigned callTargetReturnVoidTypeBuffer;
         auto callTargetReturnVoidTypeSize =
             CorSigCompressToken(callTargetReturnVoidTypeRef, &callTargetReturnVoidTypeBuffer);
@@ -377,9 +442,8 @@ mdMemberRef CallTargetTokens::GetCallTargetReturnVoidDefaultMemberRef()
         memcpy(&signature[offset], &callTargetReturnVoidTypeBuffer, callTargetReturnVoidTypeSize);
         offset += callTargetReturnVoidTypeSize;
 
-        hr = module_metadata->metadata_emit->DefineMemberRef(
-            callTargetReturnVoidTypeRef, managed_profiler_calltarget_returntype_getdefault_name.data(), signature,
-            signatureLength, &callTargetReturnVoidTypeGetDefault);
+        hr = EmitMemberRef(callTargetReturnVoidTypeRef, managed_profiler_calltarget_returntype_getdefault_name.data(),
+                           signature, signatureLength, &callTargetReturnVoidTypeGetDefault);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper callTargetReturnVoidTypeGetDefault could not be defined.");
@@ -406,7 +470,6 @@ mdMemberRef CallTargetTokens::GetCallTargetReturnValueDefaultMemberRef(mdTypeSpe
     mdMemberRef callTargetReturnTypeGetDefault = mdMemberRefNil;
 
     // *** Ensure CallTargetReturn<T>.GetDefault() member ref
-    ModuleMetadata* module_metadata = GetMetadata();
 
     unsigned callTargetReturnTypeRefBuffer;
     auto callTargetReturnTypeRefSize = CorSigCompressToken(callTargetReturnTypeRef, &callTargetReturnTypeRefBuffer);
@@ -425,9 +488,8 @@ mdMemberRef CallTargetTokens::GetCallTargetReturnValueDefaultMemberRef(mdTypeSpe
     signature[offset++] = ELEMENT_TYPE_VAR;
     signature[offset++] = 0x00;
 
-    hr = module_metadata->metadata_emit->DefineMemberRef(callTargetReturnTypeSpec,
-                                                         managed_profiler_calltarget_returntype_getdefault_name.data(),
-                                                         signature, signatureLength, &callTargetReturnTypeGetDefault);
+    hr = EmitMemberRef(callTargetReturnTypeSpec, managed_profiler_calltarget_returntype_getdefault_name.data(),
+                       signature, signatureLength, &callTargetReturnTypeGetDefault);
     if (FAILED(hr))
     {
         Logger::Warn("Wrapper callTargetReturnTypeGetDefault could not be defined.");
@@ -446,7 +508,6 @@ mdMethodSpec CallTargetTokens::GetCallTargetDefaultValueMethodSpec(FunctionMetho
     }
 
     mdMethodSpec getDefaultMethodSpec = mdMethodSpecNil;
-    ModuleMetadata* module_metadata = GetMetadata();
 
     // *** Ensure we have the CallTargetInvoker.GetDefaultValue<> memberRef
     if (getDefaultMemberRef == mdMemberRefNil)
@@ -462,9 +523,8 @@ mdMethodSpec CallTargetTokens::GetCallTargetDefaultValueMethodSpec(FunctionMetho
         signature[offset++] = ELEMENT_TYPE_MVAR;
         signature[offset++] = 0x00;
 
-        auto hr = module_metadata->metadata_emit->DefineMemberRef(
-            callTargetTypeRef, managed_profiler_calltarget_getdefaultvalue_name.data(), signature, signatureLength,
-            &getDefaultMemberRef);
+        auto hr = EmitMemberRef(callTargetTypeRef, managed_profiler_calltarget_getdefaultvalue_name.data(), signature,
+                                signatureLength, &getDefaultMemberRef);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper getDefaultMemberRef could not be defined.");
@@ -488,8 +548,7 @@ mdMethodSpec CallTargetTokens::GetCallTargetDefaultValueMethodSpec(FunctionMetho
     memcpy(&signature[offset], methodArgumentSignature, methodArgumentSignatureSize);
     offset += methodArgumentSignatureSize;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(getDefaultMemberRef, signature, signatureLength,
-                                                          &getDefaultMethodSpec);
+    hr = EmitMethodSpec(getDefaultMemberRef, signature, signatureLength, &getDefaultMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating getDefaultMethodSpec.");
@@ -529,7 +588,7 @@ HRESULT CallTargetTokens::ModifyLocalSig(ILRewriter* reWriter, FunctionMethodArg
                                          ULONG* callTargetStateIndex, ULONG* exceptionIndex,
                                          ULONG* callTargetReturnIndex, ULONG* returnValueIndex,
                                          mdToken* callTargetStateToken, mdToken* exceptionToken,
-                                         mdToken* callTargetReturnToken)
+                                         mdToken* callTargetReturnToken, bool endMethodOnly)
 {
     auto hr = EnsureBaseCalltargetTokens();
     if (FAILED(hr))
@@ -565,7 +624,9 @@ HRESULT CallTargetTokens::ModifyLocalSig(ILRewriter* reWriter, FunctionMethodArg
         }
     }
 
-    ULONG newLocalsCount = 3;
+    // EndOnly methods don't keep the exception nor the state, and only need the CallTargetReturn<T> local
+    // to read the return value back
+    ULONG newLocalsCount = endMethodOnly ? 0 : 3;
 
     // Gets the calltarget state type buffer and size
     unsigned callTargetStateTypeRefBuffer;
@@ -603,18 +664,35 @@ HRESULT CallTargetTokens::ModifyLocalSig(ILRewriter* reWriter, FunctionMethodArg
 
         callTargetReturnSizeForNewSignature = callTargetReturnSignatureSize;
 
-        newLocalsCount++;
+        newLocalsCount += endMethodOnly ? 2 : 1;
     }
     else
     {
         callTargetReturn = GetTargetVoidReturnTypeRef();
         callTargetReturnSize = CorSigCompressToken(callTargetReturn, &callTargetReturnBuffer);
-        callTargetReturnSizeForNewSignature = 1 + callTargetReturnSize;
+        callTargetReturnSizeForNewSignature = endMethodOnly ? 0 : 1 + callTargetReturnSize;
+    }
+
+    *callTargetStateToken = callTargetStateTypeRef;
+    *exceptionToken = exTypeRef;
+    *callTargetReturnToken = callTargetReturn;
+    *returnValueIndex = static_cast<ULONG>(ULONG_MAX);
+    *exceptionIndex = static_cast<ULONG>(ULONG_MAX);
+    *callTargetReturnIndex = static_cast<ULONG>(ULONG_MAX);
+    *callTargetStateIndex = static_cast<ULONG>(ULONG_MAX);
+
+    if (newLocalsCount == 0)
+    {
+        // EndOnly on a void method, the local var signature is left untouched
+        return S_OK;
     }
 
     // New signature size
-    ULONG newSignatureSize = originalSignatureSize + returnSignatureTypeSize + (1 + exTypeRefSize) +
-                             callTargetReturnSizeForNewSignature + (1 + callTargetStateTypeRefSize);
+    ULONG newSignatureSize = originalSignatureSize + returnSignatureTypeSize + callTargetReturnSizeForNewSignature;
+    if (!endMethodOnly)
+    {
+        newSignatureSize += (1 + exTypeRefSize) + (1 + callTargetStateTypeRefSize);
+    }
     ULONG newSignatureOffset = 0;
 
     ULONG oldLocalsBuffer;
@@ -662,9 +740,12 @@ HRESULT CallTargetTokens::ModifyLocalSig(ILRewriter* reWriter, FunctionMethodArg
     }
 
     // Exception value
-    newSignatureBuffer[newSignatureOffset++] = ELEMENT_TYPE_CLASS;
-    memcpy(&newSignatureBuffer[newSignatureOffset], &exTypeRefBuffer, exTypeRefSize);
-    newSignatureOffset += exTypeRefSize;
+    if (!endMethodOnly)
+    {
+        newSignatureBuffer[newSignatureOffset++] = ELEMENT_TYPE_CLASS;
+        memcpy(&newSignatureBuffer[newSignatureOffset], &exTypeRefBuffer, exTypeRefSize);
+        newSignatureOffset += exTypeRefSize;
+    }
 
     // CallTarget Return value
     if (callTargetReturnSignature != nullptr)
@@ -680,9 +761,12 @@ HRESULT CallTargetTokens::ModifyLocalSig(ILRewriter* reWriter, FunctionMethodArg
     }
 
     // CallTarget state value
-    newSignatureBuffer[newSignatureOffset++] = ELEMENT_TYPE_VALUETYPE;
-    memcpy(&newSignatureBuffer[newSignatureOffset], &callTargetStateTypeRefBuffer, callTargetStateTypeRefSize);
-    newSignatureOffset += callTargetStateTypeRefSize;
+    if (!endMethodOnly)
+    {
+        newSignatureBuffer[newSignatureOffset++] = ELEMENT_TYPE_VALUETYPE;
+        memcpy(&newSignatureBuffer[newSignatureOffset], &callTargetStateTypeRefBuffer, callTargetStateTypeRefSize);
+        newSignatureOffset += callTargetStateTypeRefSize;
+    }
 
     // Get new locals token
     mdToken newLocalVarSig;
@@ -694,16 +778,16 @@ HRESULT CallTargetTokens::ModifyLocalSig(ILRewriter* reWriter, FunctionMethodArg
     }
 
     reWriter->SetTkLocalVarSig(newLocalVarSig);
-    *callTargetStateToken = callTargetStateTypeRef;
-    *exceptionToken = exTypeRef;
-    *callTargetReturnToken = callTargetReturn;
-    if (returnSignatureType != nullptr)
+    if (endMethodOnly)
     {
-        *returnValueIndex = newLocalsCount - 4;
+        *returnValueIndex = newLocalsCount - 2;
+        *callTargetReturnIndex = newLocalsCount - 1;
+        return hr;
     }
-    else
+
+    if (returnSignatureType != nullptr)
     {
-        *returnValueIndex = static_cast<ULONG>(ULONG_MAX);
+        *returnValueIndex = newLocalsCount - 4;
     }
     *exceptionIndex = newLocalsCount - 3;
     *callTargetReturnIndex = newLocalsCount - 2;
@@ -721,7 +805,6 @@ HRESULT CallTargetTokens::WriteBeginMethodWithArgumentsArray(void* rewriterWrapp
         return hr;
     }
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
 
     if (beginArrayMemberRef == mdMemberRefNil)
     {
@@ -746,9 +829,8 @@ HRESULT CallTargetTokens::WriteBeginMethodWithArgumentsArray(void* rewriterWrapp
         signature[offset++] = ELEMENT_TYPE_SZARRAY;
         signature[offset++] = ELEMENT_TYPE_OBJECT;
 
-        auto hr = module_metadata->metadata_emit->DefineMemberRef(callTargetTypeRef,
-                                                                  managed_profiler_calltarget_beginmethod_name.data(),
-                                                                  signature, signatureLength, &beginArrayMemberRef);
+        auto hr = EmitMemberRef(callTargetTypeRef, managed_profiler_calltarget_beginmethod_name.data(), signature,
+                                signatureLength, &beginArrayMemberRef);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper beginArrayMemberRef could not be defined.");
@@ -788,8 +870,7 @@ HRESULT CallTargetTokens::WriteBeginMethodWithArgumentsArray(void* rewriterWrapp
     memcpy(&signature[offset], &currentTypeBuffer, currentTypeSize);
     offset += currentTypeSize;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(beginArrayMemberRef, signature, signatureLength,
-                                                          &beginArrayMethodSpec);
+    hr = EmitMethodSpec(beginArrayMemberRef, signature, signatureLength, &beginArrayMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating begin method spec.");
@@ -813,6 +894,40 @@ CallTargetTokens::CallTargetTokens(ModuleMetadata* module_metadata_ptr)
     }
 }
 
+int CallTargetTokens::GetFastPathMaxArguments()
+{
+    static const int maxArguments = []() {
+        const auto value = GetEnvironmentValue(environment::calltarget_fastpath_max_arguments);
+        if (value.empty())
+        {
+            return FASTPATH_MAX_ARGUMENTS;
+        }
+
+        int parsed;
+        try
+        {
+            parsed = std::stoi(ToString(value));
+        }
+        catch (...)
+        {
+            Logger::Warn("Invalid value for ", environment::calltarget_fastpath_max_arguments, ": ", value,
+                         ". Using ", FASTPATH_MAX_ARGUMENTS, ".");
+            return FASTPATH_MAX_ARGUMENTS;
+        }
+
+        if (parsed < 0 || parsed > FASTPATH_MAX_ARGUMENTS)
+        {
+            Logger::Warn(environment::calltarget_fastpath_max_arguments, " must be between 0 and ",
+                         FASTPATH_MAX_ARGUMENTS, ". Using ", FASTPATH_MAX_ARGUMENTS, ".");
+            return FASTPATH_MAX_ARGUMENTS;
+        }
+
+        return parsed;
+    }();
+
+    return maxArguments;
+}
+
 mdTypeRef CallTargetTokens::GetObjectTypeRef()
 {
     return objectTypeRef;
@@ -830,7 +945,8 @@ HRESULT CallTargetTokens::ModifyLocalSigAndInitialize(void* rewriterWrapperPtr,
                                                       ULONG* callTargetStateIndex, ULONG* exceptionIndex,
                                                       ULONG* callTargetReturnIndex, ULONG* returnValueIndex,
                                                       mdToken* callTargetStateToken, mdToken* exceptionToken,
-                                                      mdToken* callTargetReturnToken, ILInstr** firstInstruction)
+                                                      mdToken* callTargetReturnToken, ILInstr** firstInstruction,
+                                                      bool endMethodOnly)
 {
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
 
@@ -839,7 +955,7 @@ HRESULT CallTargetTokens::ModifyLocalSigAndInitialize(void* rewriterWrapperPtr,
 
     auto hr = ModifyLocalSig(rewriterWrapper->GetILRewriter(), &returnFunctionMethod, callTargetStateIndex,
                              exceptionIndex, callTargetReturnIndex, returnValueIndex, callTargetStateToken,
-                             exceptionToken, callTargetReturnToken);
+                             exceptionToken, callTargetReturnToken, endMethodOnly);
 
     if (FAILED(hr))
     {
@@ -847,6 +963,24 @@ HRESULT CallTargetTokens::ModifyLocalSigAndInitialize(void* rewriterWrapperPtr,
         return hr;
     }
 
+    if (endMethodOnly)
+    {
+        // The return value is read in the finally block so it must be initialized before the try block, the
+        // CallTargetReturn<T> local is always written by EndMethod before being read. Void methods don't have
+        // new locals, a nop opens the try block so it never starts on an original instruction.
+        if (*returnValueIndex != static_cast<ULONG>(ULONG_MAX))
+        {
+            *firstInstruction =
+                rewriterWrapper->CallMember(GetCallTargetDefaultValueMethodSpec(&returnFunctionMethod), false);
+            rewriterWrapper->StLocal(*returnValueIndex);
+        }
+        else
+        {
+            *firstInstruction = rewriterWrapper->NOP();
+        }
+        return S_OK;
+    }
+
     // Init locals
     if (*returnValueIndex != static_cast<ULONG>(ULONG_MAX))
     {
@@ -873,7 +1007,8 @@ HRESULT CallTargetTokens::ModifyLocalSigAndInitialize(void* rewriterWrapperPtr,
 
 HRESULT CallTargetTokens::WriteBeginMethod(void* rewriterWrapperPtr, mdTypeRef integrationTypeRef,
                                            const TypeInfo* currentType,
-                                           std::vector<FunctionMethodArgument>& methodArguments, ILInstr** instruction)
+                                           const std::vector<FunctionMethodArgument>& methodArguments,
+                                           ILInstr** instruction)
 {
     auto hr = EnsureBaseCalltargetTokens();
     if (FAILED(hr))
@@ -882,10 +1017,9 @@ HRESULT CallTargetTokens::WriteBeginMethod(void* rewriterWrapperPtr, mdTypeRef i
     }
 
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
 
     auto numArguments = (int) methodArguments.size();
-    if (numArguments >= FASTPATH_COUNT)
+    if (numArguments > GetFastPathMaxArguments())
     {
         return WriteBeginMethodWithArgumentsArray(rewriterWrapperPtr, integrationTypeRef, currentType, instruction);
     }
@@ -920,9 +1054,8 @@ HRESULT CallTargetTokens::WriteBeginMethod(void* rewriterWrapperPtr, mdTypeRef i
             signature[offset++] = 0x01 + (i + 1);
         }
 
-        auto hr = module_metadata->metadata_emit->DefineMemberRef(
-            callTargetTypeRef, managed_profiler_calltarget_beginmethod_name.data(), signature, signatureLength,
-            &beginMethodFastPathRefs[numArguments]);
+        auto hr = EmitMemberRef(callTargetTypeRef, managed_profiler_calltarget_beginmethod_name.data(), signature,
+                                signatureLength, &beginMethodFastPathRefs[numArguments]);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper beginMethod for ", numArguments, " arguments could not be defined.");
@@ -979,8 +1112,7 @@ HRESULT CallTargetTokens::WriteBeginMethod(void* rewriterWrapperPtr, mdTypeRef i
         offset += argumentsSignatureSize[i];
     }
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(beginMethodFastPathRefs[numArguments], signature,
-                                                          signatureLength, &beginMethodSpec);
+    hr = EmitMethodSpec(beginMethodFastPathRefs[numArguments], signature, signatureLength, &beginMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating begin method spec.");
@@ -1001,7 +1133,6 @@ HRESULT CallTargetTokens::WriteEndVoidReturnMemberRef(void* rewriterWrapperPtr,
         return hr;
     }
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
 
     if (endVoidMemberRef == mdMemberRefNil)
     {
@@ -1037,9 +1168,8 @@ HRESULT CallTargetTokens::WriteEndVoidReturnMemberRef(void* rewriterWrapperPtr,
         memcpy(&signature[offset], &callTargetStateBuffer, callTargetStateSize);
         offset += callTargetStateSize;
 
-        auto hr = module_metadata->metadata_emit->DefineMemberRef(callTargetTypeRef,
-                                                                  managed_profiler_calltarget_endmethod_name.data(),
-                                                                  signature, signatureLength, &endVoidMemberRef);
+        auto hr = EmitMemberRef(callTargetTypeRef, managed_profiler_calltarget_endmethod_name.data(), signature,
+                                signatureLength, &endVoidMemberRef);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper endVoidMemberRef could not be defined.");
@@ -1079,8 +1209,7 @@ HRESULT CallTargetTokens::WriteEndVoidReturnMemberRef(void* rewriterWrapperPtr,
     memcpy(&signature[offset], &currentTypeBuffer, currentTypeSize);
     offset += currentTypeSize;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(endVoidMemberRef, signature, signatureLength,
-                                                          &endVoidMethodSpec);
+    hr = EmitMethodSpec(endVoidMemberRef, signature, signatureLength, &endVoidMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating end void method method spec.");
@@ -1102,7 +1231,6 @@ HRESULT CallTargetTokens::WriteEndReturnMemberRef(void* rewriterWrapperPtr, mdTy
         return hr;
     }
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
     GetTargetReturnValueTypeRef(returnArgument);
 
     // *** Define base MethodMemberRef for the type
@@ -1148,9 +1276,8 @@ HRESULT CallTargetTokens::WriteEndReturnMemberRef(void* rewriterWrapperPtr, mdTy
     memcpy(&signature[offset], &callTargetStateBuffer, callTargetStateSize);
     offset += callTargetStateSize;
 
-    hr = module_metadata->metadata_emit->DefineMemberRef(callTargetTypeRef,
-                                                         managed_profiler_calltarget_endmethod_name.data(), signature,
-                                                         signatureLength, &endMethodMemberRef);
+    hr = EmitMemberRef(callTargetTypeRef, managed_profiler_calltarget_endmethod_name.data(), signature, signatureLength,
+                       &endMethodMemberRef);
     if (FAILED(hr))
     {
         Logger::Warn("Wrapper endMethodMemberRef could not be defined.");
@@ -1197,8 +1324,7 @@ HRESULT CallTargetTokens::WriteEndReturnMemberRef(void* rewriterWrapperPtr, mdTy
     memcpy(&signature[offset], returnSignatureBuffer, returnSignatureLength);
     offset += returnSignatureLength;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(endMethodMemberRef, signature, signatureLength,
-                                                          &endMethodSpec);
+    hr = EmitMethodSpec(endMethodMemberRef, signature, signatureLength, &endMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating end method member spec.");
@@ -1219,7 +1345,6 @@ HRESULT CallTargetTokens::WriteLogException(void* rewriterWrapperPtr, mdTypeRef
         return hr;
     }
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
 
     if (logExceptionRef == mdMemberRefNil)
     {
@@ -1239,9 +1364,8 @@ HRESULT CallTargetTokens::WriteLogException(void* rewriterWrapperPtr, mdTypeRef
         memcpy(&signature[offset], &exTypeRefBuffer, exTypeRefSize);
         offset += exTypeRefSize;
 
-        auto hr = module_metadata->metadata_emit->DefineMemberRef(callTargetTypeRef,
-                                                                  managed_profiler_calltarget_logexception_name.data(),
-                                                                  signature, signatureLength, &logExceptionRef);
+        auto hr = EmitMemberRef(callTargetTypeRef, managed_profiler_calltarget_logexception_name.data(), signature,
+                                signatureLength, &logExceptionRef);
         if (FAILED(hr))
         {
             Logger::Warn("Wrapper logExceptionRef could not be defined.");
@@ -1281,8 +1405,7 @@ HRESULT CallTargetTokens::WriteLogException(void* rewriterWrapperPtr, mdTypeRef
     memcpy(&signature[offset], &currentTypeBuffer, currentTypeSize);
     offset += currentTypeSize;
 
-    hr = module_metadata->metadata_emit->DefineMethodSpec(logExceptionRef, signature, signatureLength,
-                                                          &logExceptionMethodSpec);
+    hr = EmitMethodSpec(logExceptionRef, signature, signatureLength, &logExceptionMethodSpec);
     if (FAILED(hr))
     {
         Logger::Warn("Error creating log exception method spec.");
@@ -1303,7 +1426,6 @@ HRESULT CallTargetTokens::WriteCallTargetReturnGetReturnValue(void* rewriterWrap
         return mdMemberRefNil;
     }
     ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
-    ModuleMetadata* module_metadata = GetMetadata();
 
     // Ensure T CallTargetReturn<T>.GetReturnValue() member ref
     mdMemberRef callTargetReturnGetValueMemberRef = mdMemberRefNil;
@@ -1316,9 +1438,8 @@ HRESULT CallTargetTokens::WriteCallTargetReturnGetReturnValue(void* rewriterWrap
     signature[offset++] = 0x00;
     signature[offset++] = ELEMENT_TYPE_VAR;
     signature[offset++] = 0x00;
-    hr = module_metadata->metadata_emit->DefineMemberRef(
-        callTargetReturnTypeSpec, managed_profiler_calltarget_returntype_getreturnvalue_name.data(), signature,
-        signatureLength, &callTargetReturnGetValueMemberRef);
+    hr = EmitMemberRef(callTargetReturnTypeSpec, managed_profiler_calltarget_returntype_getreturnvalue_name.data(),
+                       signature, signatureLength, &callTargetReturnGetValueMemberRef);
     if (FAILED(hr))
     {
         Logger::Warn("Wrapper callTargetReturnGetValueMemberRef could not be defined.");
@@ -1329,4 +1450,19 @@ HRESULT CallTargetTokens::WriteCallTargetReturnGetReturnValue(void* rewriterWrap
     return S_OK;
 }
 
+HRESULT CallTargetTokens::WriteCallTargetStateGetDefault(void* rewriterWrapperPtr, ILInstr** instruction)
+{
+    ILRewriterWrapper* rewriterWrapper = (ILRewriterWrapper*) rewriterWrapperPtr;
+
+    // Ensure CallTargetState.GetDefault() member ref
+    const mdMemberRef callTargetStateGetDefault = GetCallTargetStateDefaultMemberRef();
+    if (callTargetStateGetDefault == mdMemberRefNil)
+    {
+        return E_FAIL;
+    }
+
+    *instruction = rewriterWrapper->CallMember(callTargetStateGetDefault, false);
+    return S_OK;
+}
+
 } // namespace trace
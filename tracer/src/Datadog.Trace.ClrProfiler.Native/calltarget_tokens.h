@@ -13,7 +13,10 @@
 #include "integration.h"
 #include "string.h" // NOLINT
 
-#define FASTPATH_COUNT 9
+// Highest arity with a fixed-arity CallTargetInvoker.BeginMethod overload in the managed profiler.
+// Methods with more arguments always use the object[] overload.
+#define FASTPATH_MAX_ARGUMENTS 16
+#define FASTPATH_COUNT (FASTPATH_MAX_ARGUMENTS + 1)
 
 namespace trace
 {
@@ -53,7 +56,19 @@ private:
     mdMemberRef callTargetReturnVoidTypeGetDefault = mdMemberRefNil;
     mdMemberRef getDefaultMemberRef = mdMemberRefNil;
 
+    // TypeSpec, MemberRef and MethodSpec tokens already emitted in this module, keyed by
+    // the parent token, member name and signature bytes.
+    std::mutex emitted_tokens_lock;
+    std::unordered_map<std::string, mdToken> emitted_tokens;
+
     ModuleMetadata* GetMetadata();
+    HRESULT EmitTypeSpec(PCCOR_SIGNATURE signature, ULONG signatureLength, mdTypeSpec* typeSpec);
+    HRESULT EmitMemberRef(mdToken parent, LPCWSTR name, PCCOR_SIGNATURE signature, ULONG signatureLength,
+                          mdMemberRef* memberRef);
+    HRESULT EmitMethodSpec(mdToken parent, PCCOR_SIGNATURE signature, ULONG signatureLength,
+                           mdMethodSpec* methodSpec);
+    template <typename TEmit>
+    HRESULT EmitCached(const std::string& key, mdToken* token, TEmit emit);
     HRESULT EnsureCorLibTokens();
     HRESULT EnsureBaseCalltargetTokens();
     mdTypeRef GetTargetStateTypeRef();
@@ -67,7 +82,8 @@ private:
 
     HRESULT ModifyLocalSig(ILRewriter* reWriter, FunctionMethodArgument* methodReturnValue, ULONG* callTargetStateIndex,
                            ULONG* exceptionIndex, ULONG* callTargetReturnIndex, ULONG* returnValueIndex,
-                           mdToken* callTargetStateToken, mdToken* exceptionToken, mdToken* callTargetReturnToken);
+                           mdToken* callTargetStateToken, mdToken* exceptionToken, mdToken* callTargetReturnToken,
+                           bool endMethodOnly);
 
     HRESULT WriteBeginMethodWithArgumentsArray(void* rewriterWrapperPtr, mdTypeRef integrationTypeRef,
                                                const TypeInfo* currentType, ILInstr** instruction);
@@ -75,6 +91,10 @@ private:
 public:
     CallTargetTokens(ModuleMetadata* module_metadata_ptr);
 
+    // Number of arguments up to which BeginMethod is called through a fixed-arity overload.
+    // Configured with DD_TRACE_CALLTARGET_FASTPATH_MAX_ARGUMENTS and capped at FASTPATH_MAX_ARGUMENTS.
+    static int GetFastPathMaxArguments();
+
     mdTypeRef GetObjectTypeRef();
     mdTypeRef GetExceptionTypeRef();
     mdAssemblyRef GetCorLibAssemblyRef();
@@ -83,10 +103,11 @@ public:
                                         ULONG* callTargetStateIndex, ULONG* exceptionIndex,
                                         ULONG* callTargetReturnIndex, ULONG* returnValueIndex,
                                         mdToken* callTargetStateToken, mdToken* exceptionToken,
-                                        mdToken* callTargetReturnToken, ILInstr** firstInstruction);
+                                        mdToken* callTargetReturnToken, ILInstr** firstInstruction,
+                                        bool endMethodOnly = false);
 
     HRESULT WriteBeginMethod(void* rewriterWrapperPtr, mdTypeRef integrationTypeRef, const TypeInfo* currentType,
-                             std::vector<FunctionMethodArgument>& methodArguments, ILInstr** instruction);
+                             const std::vector<FunctionMethodArgument>& methodArguments, ILInstr** instruction);
 
     HRESULT WriteEndVoidReturnMemberRef(void* rewriterWrapperPtr, mdTypeRef integrationTypeRef,
                                         const TypeInfo* currentType, ILInstr** instruction);
@@ -99,6 +120,8 @@ public:
 
     HRESULT WriteCallTargetReturnGetReturnValue(void* rewriterWrapperPtr, mdTypeSpec callTargetReturnTypeSpec,
                                                 ILInstr** instruction);
+
+    HRESULT WriteCallTargetStateGetDefault(void* rewriterWrapperPtr, ILInstr** instruction);
 };
 
 } // namespace trace
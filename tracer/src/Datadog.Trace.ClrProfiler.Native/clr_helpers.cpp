@@ -8,6 +8,7 @@
 #include "macros.h"
 #include "pal.h"
 #include "sig_helpers.h"
+#include "stats.h"
 #include <set>
 #include <stack>
 
@@ -194,6 +195,17 @@ FunctionInfo GetFunctionInfo(const ComPtr<IMetaDataImport2>& metadata_import, co
             FunctionMethodSignature(raw_signature, raw_signature_len)};
 }
 
+size_t EstimateMemory(const FunctionInfo& function_info)
+{
+    return sizeof(FunctionInfo) + EstimateMemory(function_info.name) + EstimateMemory(function_info.type.name) +
+           function_info.signature.data.size() + function_info.function_spec_signature.data.size();
+}
+
+size_t EstimateMemory(const DecodedMethodSignature& signature)
+{
+    return sizeof(DecodedMethodSignature) + signature.params.capacity() * sizeof(FunctionMethodArgument);
+}
+
 ModuleInfo GetModuleInfo(ICorProfilerInfo4* info, const ModuleID& module_id)
 {
     const DWORD module_path_size = 260;
@@ -202,8 +214,20 @@ ModuleInfo GetModuleInfo(ICorProfilerInfo4* info, const ModuleID& module_id)
     LPCBYTE base_load_address;
     AssemblyID assembly_id = 0;
     DWORD module_flags = 0;
-    const HRESULT hr = info->GetModuleInfo2(module_id, &base_load_address, module_path_size, &module_path_len,
-                                            module_path, &assembly_id, &module_flags);
+    HRESULT hr = info->GetModuleInfo2(module_id, &base_load_address, module_path_size, &module_path_len,
+                                      module_path, &assembly_id, &module_flags);
+    if (module_path_len > module_path_size)
+    {
+        // The path didn't fit in the stack buffer, query it again with the size reported by the runtime.
+        std::vector<WCHAR> long_module_path(module_path_len, 0);
+        hr = info->GetModuleInfo2(module_id, &base_load_address, module_path_len, &module_path_len,
+                                  long_module_path.data(), &assembly_id, &module_flags);
+        if (FAILED(hr) || module_path_len == 0)
+        {
+            return {};
+        }
+        return {module_id, WSTRING(long_module_path.data()), GetAssemblyInfo(info, assembly_id), module_flags};
+    }
     if (FAILED(hr) || module_path_len == 0)
     {
         return {};
@@ -211,6 +235,49 @@ ModuleInfo GetModuleInfo(ICorProfilerInfo4* info, const ModuleID& module_id)
     return {module_id, WSTRING(module_path), GetAssemblyInfo(info, assembly_id), module_flags};
 }
 
+ModuleInfo ModuleInfoCache::Add(ICorProfilerInfo4* info, const ModuleID& module_id)
+{
+    const auto module_info = trace::GetModuleInfo(info, module_id);
+    if (module_info.IsValid())
+    {
+        std::unique_lock<std::shared_mutex> guard(m_lock);
+        m_modules.erase(module_id);
+        m_modules.emplace(module_id, module_info);
+    }
+    return module_info;
+}
+
+ModuleInfo ModuleInfoCache::GetModuleInfo(ICorProfilerInfo4* info, const ModuleID& module_id)
+{
+    {
+        std::shared_lock<std::shared_mutex> guard(m_lock);
+        const auto find_res = m_modules.find(module_id);
+        if (find_res != m_modules.end())
+        {
+            return find_res->second;
+        }
+    }
+    return trace::GetModuleInfo(info, module_id);
+}
+
+void ModuleInfoCache::Remove(const ModuleID& module_id)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    m_modules.erase(module_id);
+}
+
+void ModuleInfoCache::Clear()
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    m_modules.clear();
+}
+
+size_t ModuleInfoCache::Size()
+{
+    std::shared_lock<std::shared_mutex> guard(m_lock);
+    return m_modules.size();
+}
+
 TypeInfo GetTypeInfo(const ComPtr<IMetaDataImport2>& metadata_import, const mdToken& token)
 {
     mdToken parent_token = mdTokenNil;
@@ -904,7 +971,9 @@ bool ReturnTypeIsValueTypeOrGeneric(const ComPtr<IMetaDataImport2>& metadata_imp
 
             PCCOR_SIGNATURE p_start_byte = PCCOR_SIGNATURE(&targetFunctionSignature.data[method_def_sig_index]);
             PCCOR_SIGNATURE p_end_byte = p_start_byte;
-            if (!ParseType(&p_end_byte))
+            const PCCOR_SIGNATURE p_sig_end =
+                PCCOR_SIGNATURE(targetFunctionSignature.data.data() + targetFunctionSignature.data.size());
+            if (!ParseType(p_end_byte, p_sig_end, SignatureGrammar::Full))
             {
                 return false;
             }
@@ -1024,13 +1093,14 @@ bool ReturnTypeIsValueTypeOrGeneric(const ComPtr<IMetaDataImport2>& metadata_imp
 
             // Get a pointer to first type after GenArgCount that we can increment to read the signature
             PCCOR_SIGNATURE p_current_byte = spec_signature + parent_token_index;
+            const PCCOR_SIGNATURE p_spec_end = spec_signature + spec_signature_length;
 
             // Iterate to specified generic type argument index and return the appropriate class token or TypeSpec
             for (size_t i = 0; i < num_generic_arguments; i++)
             {
                 if (i != generic_type_index)
                 {
-                    if (!ParseType(&p_current_byte))
+                    if (!ParseType(p_current_byte, p_spec_end, SignatureGrammar::Full))
                     {
                         Logger::Warn("[trace::ReturnTypeIsValueTypeOrGeneric] element_type=", ret_type,
                                      ": Unable to parse "
@@ -1058,7 +1128,7 @@ bool ReturnTypeIsValueTypeOrGeneric(const ComPtr<IMetaDataImport2>& metadata_imp
 
                     PCCOR_SIGNATURE p_start_byte = p_current_byte;
                     PCCOR_SIGNATURE p_end_byte = p_start_byte;
-                    if (!ParseType(&p_end_byte))
+                    if (!ParseType(p_end_byte, p_spec_end, SignatureGrammar::Full))
                     {
                         return false;
                     }
@@ -1087,56 +1157,8 @@ bool ReturnTypeIsValueTypeOrGeneric(const ComPtr<IMetaDataImport2>& metadata_imp
 // FunctionMethodArgument
 int FunctionMethodArgument::GetTypeFlags(unsigned& elementType) const
 {
-    int flag = 0;
-    PCCOR_SIGNATURE pbCur = &pbBase[offset];
-
-    if (*pbCur == ELEMENT_TYPE_VOID)
-    {
-        elementType = ELEMENT_TYPE_VOID;
-        flag |= TypeFlagVoid;
-        return flag;
-    }
-
-    if (*pbCur == ELEMENT_TYPE_BYREF)
-    {
-        pbCur++;
-        flag |= TypeFlagByRef;
-    }
-
-    elementType = *pbCur;
-
-    switch (*pbCur)
-    {
-        case ELEMENT_TYPE_BOOLEAN:
-        case ELEMENT_TYPE_CHAR:
-        case ELEMENT_TYPE_I1:
-        case ELEMENT_TYPE_U1:
-        case ELEMENT_TYPE_U2:
-        case ELEMENT_TYPE_I2:
-        case ELEMENT_TYPE_I4:
-        case ELEMENT_TYPE_U4:
-        case ELEMENT_TYPE_I8:
-        case ELEMENT_TYPE_U8:
-        case ELEMENT_TYPE_R4:
-        case ELEMENT_TYPE_R8:
-        case ELEMENT_TYPE_I:
-        case ELEMENT_TYPE_U:
-        case ELEMENT_TYPE_VALUETYPE:
-        case ELEMENT_TYPE_MVAR:
-        case ELEMENT_TYPE_VAR:
-            flag |= TypeFlagBoxedType;
-            break;
-        case ELEMENT_TYPE_GENERICINST:
-            pbCur++;
-            if (*pbCur == ELEMENT_TYPE_VALUETYPE)
-            {
-                flag |= TypeFlagBoxedType;
-            }
-            break;
-        default:
-            break;
-    }
-    return flag;
+    elementType = this->elementType;
+    return typeFlags;
 }
 
 mdToken FunctionMethodArgument::GetTypeTok(ComPtr<IMetaDataEmit2>& pEmit, mdAssemblyRef corLibRef) const
@@ -1201,12 +1223,8 @@ mdToken FunctionMethodArgument::GetTypeTok(ComPtr<IMetaDataEmit2>& pEmit, mdAsse
             pEmit->DefineTypeRefByName(corLibRef, SystemObject, &token);
             break;
         case ELEMENT_TYPE_CLASS:
-            pbCur++;
-            token = CorSigUncompressToken(pbCur);
-            break;
         case ELEMENT_TYPE_VALUETYPE:
-            pbCur++;
-            token = CorSigUncompressToken(pbCur);
+            token = typeToken;
             break;
         case ELEMENT_TYPE_GENERICINST:
         case ELEMENT_TYPE_SZARRAY:
@@ -1358,6 +1376,16 @@ WSTRING GetSigTypeTokName(PCCOR_SIGNATURE& pbCur, const ComPtr<IMetaDataImport2>
 
 WSTRING FunctionMethodArgument::GetTypeTokName(ComPtr<IMetaDataImport2>& pImport) const
 {
+    if (elementType == ELEMENT_TYPE_CLASS || elementType == ELEMENT_TYPE_VALUETYPE)
+    {
+        auto tokenName = GetTypeInfo(pImport, typeToken).name;
+        if (typeFlags & TypeFlagByRef)
+        {
+            tokenName += WStr("&");
+        }
+        return tokenName;
+    }
+
     PCCOR_SIGNATURE pbCur = &pbBase[offset];
     return GetSigTypeTokName(pbCur, pImport);
 }
@@ -1369,114 +1397,30 @@ ULONG FunctionMethodArgument::GetSignature(PCCOR_SIGNATURE& data) const
 }
 
 // FunctionMethodSignature
-bool ParseByte(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, unsigned char* pbOut)
+namespace
 {
-    if (pbCur < pbEnd)
-    {
-        *pbOut = *pbCur;
-        pbCur++;
-        return true;
-    }
-
-    return false;
-}
-
-bool ParseNumber(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, unsigned* pOut)
+// Fills the decoded fields of an argument whose bytes were already validated by ParseParam/ParseRetType.
+void DescribeArgument(FunctionMethodArgument& argument)
 {
-    // parse the variable length number format (0-4 bytes)
+    PCCOR_SIGNATURE pbCur = &argument.pbBase[argument.offset];
+    const PCCOR_SIGNATURE pbEnd = pbCur + argument.length;
 
-    unsigned char b1 = 0, b2 = 0, b3 = 0, b4 = 0;
-
-    // at least one byte in the encoding, read that
-
-    if (!ParseByte(pbCur, pbEnd, &b1)) return false;
-
-    if (b1 == 0xff)
-    {
-        // special encoding of 'NULL'
-        // not sure what this means as a number, don't expect to see it except for
-        // string lengths which we don't encounter anyway so calling it an error
-        return false;
-    }
-
-    // early out on 1 byte encoding
-    if ((b1 & 0x80) == 0)
-    {
-        *pOut = (int) b1;
-        return true;
-    }
-
-    // now at least 2 bytes in the encoding, read 2nd byte
-    if (!ParseByte(pbCur, pbEnd, &b2)) return false;
-
-    // early out on 2 byte encoding
-    if ((b1 & 0x40) == 0)
+    if (*pbCur == ELEMENT_TYPE_VOID)
     {
-        *pOut = (((b1 & 0x3f) << 8) | b2);
-        return true;
+        argument.elementType = ELEMENT_TYPE_VOID;
+        argument.typeFlags = TypeFlagVoid;
+        return;
     }
 
-    // must be a 4 byte encoding
-    if ((b1 & 0x20) != 0)
+    if (*pbCur == ELEMENT_TYPE_BYREF)
     {
-        // 4 byte encoding has this bit clear -- error if not
-        return false;
+        pbCur++;
+        argument.typeFlags |= TypeFlagByRef;
     }
 
-    if (!ParseByte(pbCur, pbEnd, &b3)) return false;
-
-    if (!ParseByte(pbCur, pbEnd, &b4)) return false;
-
-    *pOut = ((b1 & 0x1f) << 24) | (b2 << 16) | (b3 << 8) | b4;
-    return true;
-}
-
-bool ParseTypeDefOrRefEncoded(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, unsigned char* pIndexTypeOut,
-                              unsigned* pIndexOut)
-{
-    // parse an encoded typedef or typeref
-    unsigned encoded = 0;
-
-    if (!ParseNumber(pbCur, pbEnd, &encoded)) return false;
-
-    *pIndexTypeOut = (unsigned char) (encoded & 0x3);
-    *pIndexOut = (encoded >> 2);
-    return true;
-}
-
-/*  we don't support
-    PTR CustomMod* VOID
-    PTR CustomMod* Type
-    FNPTR MethodDefSig
-    FNPTR MethodRefSig
-    ARRAY Type ArrayShape
-    SZARRAY CustomMod+ Type (but we do support SZARRAY Type)
- */
-bool ParseType(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd)
-{
-    /*
-    Type ::= ( BOOLEAN | CHAR | I1 | U1 | U2 | U2 | I4 | U4 | I8 | U8 | R4 | R8 |
-    I | U | | VALUETYPE TypeDefOrRefEncoded | CLASS TypeDefOrRefEncoded | STRING
-    | OBJECT
-    | PTR CustomMod* VOID
-    | PTR CustomMod* Type
-    | FNPTR MethodDefSig
-    | FNPTR MethodRefSig
-    | ARRAY Type ArrayShape
-    | SZARRAY CustomMod* Type
-    | GENERICINST (CLASS | VALUETYPE) TypeDefOrRefEncoded GenArgCount Type *
-    | VAR Number
-    | MVAR Number
-    */
-
-    unsigned char elem_type;
-    unsigned index;
-    unsigned number;
-    unsigned char indexType;
-
-    if (!ParseByte(pbCur, pbEnd, &elem_type)) return false;
+    argument.elementType = *pbCur++;
 
-    switch (elem_type)
+    switch (argument.elementType)
     {
         case ELEMENT_TYPE_BOOLEAN:
         case ELEMENT_TYPE_CHAR:
@@ -1492,120 +1436,34 @@ bool ParseType(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd)
         case ELEMENT_TYPE_R8:
         case ELEMENT_TYPE_I:
         case ELEMENT_TYPE_U:
-        case ELEMENT_TYPE_STRING:
-        case ELEMENT_TYPE_OBJECT:
-            // simple types
-            break;
-
-        case ELEMENT_TYPE_PTR:
-            return false;
-
-        case ELEMENT_TYPE_CLASS:
-            // CLASS TypeDefOrRefEncoded
-            if (!ParseTypeDefOrRefEncoded(pbCur, pbEnd, &indexType, &index)) return false;
+        case ELEMENT_TYPE_MVAR:
+        case ELEMENT_TYPE_VAR:
+            argument.typeFlags |= TypeFlagBoxedType;
             break;
-
         case ELEMENT_TYPE_VALUETYPE:
-            // VALUETYPE TypeDefOrRefEncoded
-            if (!ParseTypeDefOrRefEncoded(pbCur, pbEnd, &indexType, &index)) return false;
-
+            argument.typeFlags |= TypeFlagBoxedType;
+            ParseTypeDefOrRefEncoded(pbCur, pbEnd, &argument.typeToken);
             break;
-
-        case ELEMENT_TYPE_FNPTR:
-            // FNPTR MethodDefSig
-            // FNPTR MethodRefSig
-
-            return false;
-
-        case ELEMENT_TYPE_ARRAY:
-            // ARRAY Type ArrayShape
-            return false;
-
-        case ELEMENT_TYPE_SZARRAY:
-            // SZARRAY Type
-
-            if (*pbCur == ELEMENT_TYPE_CMOD_OPT || *pbCur == ELEMENT_TYPE_CMOD_REQD) return false;
-
-            if (!ParseType(pbCur, pbEnd)) return false;
-
+        case ELEMENT_TYPE_CLASS:
+            ParseTypeDefOrRefEncoded(pbCur, pbEnd, &argument.typeToken);
             break;
-
         case ELEMENT_TYPE_GENERICINST:
-            // GENERICINST (CLASS | VALUETYPE) TypeDefOrRefEncoded GenArgCount Type *
-            if (!ParseByte(pbCur, pbEnd, &elem_type)) return false;
-
-            if (elem_type != ELEMENT_TYPE_CLASS && elem_type != ELEMENT_TYPE_VALUETYPE) return false;
-
-            if (!ParseTypeDefOrRefEncoded(pbCur, pbEnd, &indexType, &index)) return false;
-
-            if (!ParseNumber(pbCur, pbEnd, &number)) return false;
-
-            for (unsigned i = 0; i < number; i++)
+            if (*pbCur++ == ELEMENT_TYPE_VALUETYPE)
             {
-                if (!ParseType(pbCur, pbEnd)) return false;
+                argument.typeFlags |= TypeFlagBoxedType;
             }
+            ParseTypeDefOrRefEncoded(pbCur, pbEnd, &argument.typeToken);
             break;
-
-        case ELEMENT_TYPE_VAR:
-            // VAR Number
-            if (!ParseNumber(pbCur, pbEnd, &number)) return false;
-
-            break;
-
-        case ELEMENT_TYPE_MVAR:
-            // MVAR Number
-            if (!ParseNumber(pbCur, pbEnd, &number)) return false;
-
+        default:
             break;
     }
-
-    return true;
-}
-
-// Param ::= CustomMod* ( TYPEDBYREF | [BYREF] Type )
-// CustomMod* TYPEDBYREF we don't support
-bool ParseParam(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd)
-{
-    if (*pbCur == ELEMENT_TYPE_CMOD_OPT || *pbCur == ELEMENT_TYPE_CMOD_REQD)
-    {
-        return false;
-    }
-
-    if (pbCur >= pbEnd) return false;
-
-    if (*pbCur == ELEMENT_TYPE_TYPEDBYREF) return false;
-
-    if (*pbCur == ELEMENT_TYPE_BYREF) pbCur++;
-
-    return ParseType(pbCur, pbEnd);
-}
-
-// RetType ::= CustomMod* ( VOID | TYPEDBYREF | [BYREF] Type )
-// CustomMod* TYPEDBYREF we don't support
-bool ParseRetType(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd)
-{
-
-    if (*pbCur == ELEMENT_TYPE_CMOD_OPT || *pbCur == ELEMENT_TYPE_CMOD_REQD) return false;
-
-    if (pbCur >= pbEnd) return false;
-
-    if (*pbCur == ELEMENT_TYPE_TYPEDBYREF) return false;
-
-    if (*pbCur == ELEMENT_TYPE_VOID)
-    {
-        pbCur++;
-        return true;
-    }
-
-    if (*pbCur == ELEMENT_TYPE_BYREF) pbCur++;
-
-    return ParseType(pbCur, pbEnd);
 }
 
-HRESULT FunctionMethodSignature::TryParse()
+HRESULT Decode(DecodedMethodSignature& decoded)
 {
+    const PCCOR_SIGNATURE pbBase = decoded.pbBase;
     PCCOR_SIGNATURE pbCur = pbBase;
-    PCCOR_SIGNATURE pbEnd = pbBase + len;
+    PCCOR_SIGNATURE pbEnd = pbBase + decoded.len;
     unsigned char elem_type;
 
     IfFalseRetFAIL(ParseByte(pbCur, pbEnd, &elem_type));
@@ -1614,19 +1472,25 @@ HRESULT FunctionMethodSignature::TryParse()
     {
         unsigned gen_param_count;
         IfFalseRetFAIL(ParseNumber(pbCur, pbEnd, &gen_param_count));
-        numberOfTypeArguments = gen_param_count;
+        decoded.numberOfTypeArguments = gen_param_count;
     }
 
     unsigned param_count;
     IfFalseRetFAIL(ParseNumber(pbCur, pbEnd, &param_count));
-    numberOfArguments = param_count;
+
+    // Every param takes at least one byte, don't let a corrupted count reserve a huge vector
+    IfFalseRetFAIL(param_count <= (unsigned) (pbEnd - pbCur));
+    decoded.numberOfArguments = param_count;
 
     const PCCOR_SIGNATURE pbRet = pbCur;
 
-    IfFalseRetFAIL(ParseRetType(pbCur, pbEnd));
-    ret.pbBase = pbBase;
-    ret.length = (ULONG)(pbCur - pbRet);
-    ret.offset = (ULONG)(pbCur - pbBase - ret.length);
+    IfFalseRetFAIL(ParseRetType(pbCur, pbEnd, SignatureGrammar::CallTarget));
+    decoded.ret.pbBase = pbBase;
+    decoded.ret.length = (ULONG)(pbCur - pbRet);
+    decoded.ret.offset = (ULONG)(pbRet - pbBase);
+    DescribeArgument(decoded.ret);
+
+    decoded.params.reserve(param_count);
 
     auto fEncounteredSentinal = false;
     for (unsigned i = 0; i < param_count; i++)
@@ -1643,18 +1507,125 @@ HRESULT FunctionMethodSignature::TryParse()
 
         const PCCOR_SIGNATURE pbParam = pbCur;
 
-        IfFalseRetFAIL(ParseParam(pbCur, pbEnd));
+        IfFalseRetFAIL(ParseParam(pbCur, pbEnd, SignatureGrammar::CallTarget));
 
         FunctionMethodArgument argument{};
         argument.pbBase = pbBase;
         argument.length = (ULONG)(pbCur - pbParam);
-        argument.offset = (ULONG)(pbCur - pbBase - argument.length);
+        argument.offset = (ULONG)(pbParam - pbBase);
+        DescribeArgument(argument);
 
-        params.push_back(argument);
+        decoded.params.push_back(argument);
     }
 
     return S_OK;
 }
+} // namespace
+
+std::shared_ptr<const DecodedMethodSignature> DecodeMethodSignature(PCCOR_SIGNATURE pbBase, unsigned len)
+{
+    auto decoded = std::make_shared<DecodedMethodSignature>();
+    decoded->pbBase = pbBase;
+    decoded->len = len;
+    decoded->hr = Decode(*decoded);
+    return decoded;
+}
+
+std::shared_ptr<const DecodedMethodSignature> MethodSignatureCache::GetOrDecode(ModuleID module_id, mdToken token,
+                                                                                PCCOR_SIGNATURE pbBase, unsigned len)
+{
+    {
+        std::shared_lock<std::shared_mutex> guard(m_lock);
+        const auto module_res = m_modules.find(module_id);
+        if (module_res != m_modules.end())
+        {
+            const auto find_res = module_res->second.find(token);
+
+            // The blob is compared too, in case the ModuleID was reused before we saw the unload
+            if (find_res != module_res->second.end() && find_res->second->pbBase == pbBase &&
+                find_res->second->len == len)
+            {
+                trace::Stats::Instance()->RejitSignatureParsesSaved(1);
+                return find_res->second;
+            }
+        }
+    }
+
+    auto decoded = DecodeMethodSignature(pbBase, len);
+
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    auto& entry = m_modules[module_id][token];
+    if (entry != nullptr)
+    {
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::MethodSignature, EstimateMemory(*entry));
+    }
+    entry = decoded;
+    trace::Stats::Instance()->MemoryAllocated(MemoryCategory::MethodSignature, EstimateMemory(*entry));
+    return decoded;
+}
+
+void MethodSignatureCache::Remove(const ModuleID& module_id)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    const auto find_res = m_modules.find(module_id);
+    if (find_res != m_modules.end())
+    {
+        for (const auto& entry : find_res->second)
+        {
+            trace::Stats::Instance()->MemoryReleased(MemoryCategory::MethodSignature,
+                                                     EstimateMemory(*entry.second));
+        }
+        m_modules.erase(find_res);
+    }
+}
+
+void MethodSignatureCache::Clear()
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    for (const auto& module : m_modules)
+    {
+        for (const auto& entry : module.second)
+        {
+            trace::Stats::Instance()->MemoryReleased(MemoryCategory::MethodSignature,
+                                                     EstimateMemory(*entry.second));
+        }
+    }
+    m_modules.clear();
+}
+
+size_t MethodSignatureCache::Size()
+{
+    std::shared_lock<std::shared_mutex> guard(m_lock);
+    size_t size = 0;
+    for (const auto& module : m_modules)
+    {
+        size += module.second.size();
+    }
+    return size;
+}
+
+const DecodedMethodSignature& FunctionMethodSignature::Empty()
+{
+    static const DecodedMethodSignature empty{};
+    return empty;
+}
+
+HRESULT FunctionMethodSignature::TryParse()
+{
+    decoded = DecodeMethodSignature(pbBase, len);
+    return decoded->hr;
+}
+
+HRESULT FunctionMethodSignature::TryParse(MethodSignatureCache* cache, ModuleID module_id, mdToken token)
+{
+    if (cache == nullptr)
+    {
+        return TryParse();
+    }
+
+    decoded = cache->GetOrDecode(module_id, token, pbBase, len);
+    return decoded->hr;
+}
 
 bool FindTypeDefByName(const trace::WSTRING instrumentationTargetMethodTypeName, const trace::WSTRING assemblyName,
                        const ComPtr<IMetaDataImport2>& metadata_import, mdTypeDef& typeDef)
@@ -4,6 +4,9 @@
 #include <corhlpr.h>
 #include <corprof.h>
 #include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
 #include <utility>
 
 #include "com_ptr.h"
@@ -405,21 +408,72 @@ struct FunctionMethodArgument
     ULONG offset;
     ULONG length;
     PCCOR_SIGNATURE pbBase;
+
+    // Filled in by the signature decoder so consumers don't walk the signature bytes again.
+    // elementType is the element type after an optional BYREF, typeFlags a MethodArgumentTypeFlag mask and
+    // typeToken the TypeDefOrRef of a CLASS, VALUETYPE or GENERICINST type (mdTokenNil for any other type).
+    unsigned elementType = ELEMENT_TYPE_END;
+    int typeFlags = 0;
+    mdToken typeToken = mdTokenNil;
+
     mdToken GetTypeTok(ComPtr<IMetaDataEmit2>& pEmit, mdAssemblyRef corLibRef) const;
     WSTRING GetTypeTokName(ComPtr<IMetaDataImport2>& pImport) const;
     int GetTypeFlags(unsigned& elementType) const;
     ULONG GetSignature(PCCOR_SIGNATURE& data) const;
 };
 
-struct FunctionMethodSignature
+/// <summary>
+/// Flat description of a method signature produced by a single validating pass over its bytes.
+/// The arguments point into the signature blob of the module metadata, which lives as long as the module.
+/// </summary>
+struct DecodedMethodSignature
 {
-private:
-    PCCOR_SIGNATURE pbBase;
-    unsigned len;
+    PCCOR_SIGNATURE pbBase = nullptr;
+    unsigned len = 0;
+    HRESULT hr = E_FAIL;
     ULONG numberOfTypeArguments = 0;
     ULONG numberOfArguments = 0;
     FunctionMethodArgument ret{};
     std::vector<FunctionMethodArgument> params;
+};
+
+// Decodes a MethodDefSig/MethodRefSig, accepting only the types CallTarget can instrument.
+std::shared_ptr<const DecodedMethodSignature> DecodeMethodSignature(PCCOR_SIGNATURE pbBase, unsigned len);
+
+/// <summary>
+/// Decoded method signatures per (module, method token), so the overloads of a target method are decoded only
+/// once no matter how many integrations, ReJIT requests or rewrites look at them.
+/// Entries of a module are removed on ModuleUnloadStarted.
+/// </summary>
+class MethodSignatureCache
+{
+private:
+    std::shared_mutex m_lock;
+    std::unordered_map<ModuleID, std::unordered_map<mdToken, std::shared_ptr<const DecodedMethodSignature>>> m_modules;
+
+public:
+    // Returns the cached signature of the method, decoding and storing it if it is not cached yet.
+    std::shared_ptr<const DecodedMethodSignature> GetOrDecode(ModuleID module_id, mdToken token, PCCOR_SIGNATURE pbBase,
+                                                              unsigned len);
+
+    void Remove(const ModuleID& module_id);
+    void Clear();
+    size_t Size();
+};
+
+struct FunctionMethodSignature
+{
+private:
+    PCCOR_SIGNATURE pbBase;
+    unsigned len;
+    std::shared_ptr<const DecodedMethodSignature> decoded;
+
+    static const DecodedMethodSignature& Empty();
+
+    const DecodedMethodSignature& Decoded() const
+    {
+        return decoded != nullptr ? *decoded : Empty();
+    }
 
 public:
     FunctionMethodSignature() : pbBase(nullptr), len(0)
@@ -432,25 +486,27 @@ public:
     };
     ULONG NumberOfTypeArguments() const
     {
-        return numberOfTypeArguments;
+        return Decoded().numberOfTypeArguments;
     }
     ULONG NumberOfArguments() const
     {
-        return numberOfArguments;
+        return Decoded().numberOfArguments;
     }
     WSTRING str() const
     {
         return HexStr(pbBase, len);
     }
-    FunctionMethodArgument GetRet() const
+    const FunctionMethodArgument& GetRet() const
     {
-        return ret;
+        return Decoded().ret;
     }
-    std::vector<FunctionMethodArgument> GetMethodArguments() const
+    const std::vector<FunctionMethodArgument>& GetMethodArguments() const
     {
-        return params;
+        return Decoded().params;
     }
     HRESULT TryParse();
+    // Same as TryParse, but shares the decoded signature with every other lookup of the method in the module.
+    HRESULT TryParse(MethodSignatureCache* cache, ModuleID module_id, mdToken token);
     bool operator==(const FunctionMethodSignature& other) const
     {
         return memcmp(pbBase, other.pbBase, len);
@@ -525,8 +581,34 @@ AssemblyMetadata GetReferencedAssemblyMetadata(const ComPtr<IMetaDataAssemblyImp
 
 FunctionInfo GetFunctionInfo(const ComPtr<IMetaDataImport2>& metadata_import, const mdToken& token);
 
+// Approximate native memory held by the structure, reported by the memory accounting in Stats.
+size_t EstimateMemory(const FunctionInfo& function_info);
+size_t EstimateMemory(const DecodedMethodSignature& signature);
+
 ModuleInfo GetModuleInfo(ICorProfilerInfo4* info, const ModuleID& module_id);
 
+/// <summary>
+/// Keeps the ModuleInfo of loaded modules so it is queried from the runtime only once.
+/// Entries are added on ModuleLoadFinished and removed on ModuleUnloadStarted.
+/// </summary>
+class ModuleInfoCache
+{
+private:
+    std::shared_mutex m_lock;
+    std::unordered_map<ModuleID, ModuleInfo> m_modules;
+
+public:
+    // Queries the runtime for the module info and stores it if valid.
+    ModuleInfo Add(ICorProfilerInfo4* info, const ModuleID& module_id);
+
+    // Returns the cached module info, or queries the runtime (without storing it) if the module is not cached.
+    ModuleInfo GetModuleInfo(ICorProfilerInfo4* info, const ModuleID& module_id);
+
+    void Remove(const ModuleID& module_id);
+    void Clear();
+    size_t Size();
+};
+
 TypeInfo GetTypeInfo(const ComPtr<IMetaDataImport2>& metadata_import, const mdToken& token);
 
 mdAssemblyRef FindAssemblyRef(const ComPtr<IMetaDataAssemblyImport>& assembly_import, const WSTRING& assembly_name);
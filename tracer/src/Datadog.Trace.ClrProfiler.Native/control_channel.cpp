@@ -0,0 +1,445 @@
+#include "control_channel.h"
+
+#include "logger.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+namespace trace
+{
+
+const size_t kControlChannelMaxRequestSize = 4096;
+const int kControlChannelPollTimeoutMs = 200;
+const int kControlChannelIoTimeoutMs = 1000;
+
+#ifdef _WIN32
+const std::string kPipePrefix = R"(\\.\pipe\)";
+
+static std::string GetPipeName(const std::string& path)
+{
+    if (path.rfind(kPipePrefix, 0) == 0)
+    {
+        return path;
+    }
+    return kPipePrefix + path;
+}
+
+// Waits for an overlapped pipe operation, the operation is cancelled when the channel stops or the timeout expires
+static bool WaitForPipeIo(HANDLE pipe, OVERLAPPED* overlapped, HANDLE stopEvent, DWORD timeoutMs, DWORD* transferred)
+{
+    HANDLE handles[] = {overlapped->hEvent, stopEvent};
+    if (WaitForMultipleObjects(2, handles, FALSE, timeoutMs) != WAIT_OBJECT_0)
+    {
+        CancelIoEx(pipe, overlapped);
+        GetOverlappedResult(pipe, overlapped, transferred, TRUE);
+        return false;
+    }
+    return GetOverlappedResult(pipe, overlapped, transferred, FALSE) != FALSE;
+}
+
+// Starts an overlapped read or write and waits for it
+static bool PipeIo(HANDLE pipe, bool write, void* buffer, DWORD size, OVERLAPPED* overlapped, HANDLE stopEvent,
+                   DWORD* transferred)
+{
+    *transferred = 0;
+    const BOOL completed = write ? WriteFile(pipe, buffer, size, nullptr, overlapped)
+                                 : ReadFile(pipe, buffer, size, nullptr, overlapped);
+    if (completed)
+    {
+        return GetOverlappedResult(pipe, overlapped, transferred, FALSE) != FALSE;
+    }
+    if (GetLastError() != ERROR_IO_PENDING)
+    {
+        return false;
+    }
+    return WaitForPipeIo(pipe, overlapped, stopEvent, kControlChannelIoTimeoutMs, transferred);
+}
+#endif
+
+ControlChannel::ControlChannel(const std::string& path, std::function<std::string(const std::string&)> handler) :
+    m_path(path), m_handler(handler)
+{
+}
+
+ControlChannel::~ControlChannel()
+{
+    Stop();
+}
+
+bool ControlChannel::IsRunning() const
+{
+    return m_running;
+}
+
+const std::string& ControlChannel::GetPath() const
+{
+    return m_path;
+}
+
+std::string ControlChannel::HandleRequest(const std::string& request)
+{
+    try
+    {
+        return m_handler(request);
+    }
+    catch (...)
+    {
+        return "error: request failed\n";
+    }
+}
+
+#ifdef _WIN32
+
+bool ControlChannel::Start()
+{
+    if (m_running || m_path.empty())
+    {
+        return false;
+    }
+
+    m_stop_event = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (m_stop_event == nullptr)
+    {
+        Logger::Warn("ControlChannel: CreateEvent failed with error ", GetLastError());
+        return false;
+    }
+
+    m_running = true;
+    m_thread = std::make_unique<std::thread>(ServerThreadLoop, this);
+    Logger::Info("ControlChannel: listening on ", GetPipeName(m_path));
+    return true;
+}
+
+void ControlChannel::Stop()
+{
+    // The server thread clears the flag itself when the pipe can't be created, it still has to be joined
+    m_running = false;
+    if (m_thread == nullptr)
+    {
+        return;
+    }
+
+    // Cancels the pending ConnectNamedPipe, ReadFile or WriteFile of the server thread
+    SetEvent(m_stop_event);
+
+    if (m_thread != nullptr && m_thread->joinable())
+    {
+        m_thread->join();
+    }
+    m_thread = nullptr;
+
+    CloseHandle(m_stop_event);
+    m_stop_event = nullptr;
+}
+
+void ControlChannel::ServerThreadLoop(ControlChannel* channel)
+{
+    const auto pipeName = GetPipeName(channel->m_path);
+    const HANDLE stopEvent = channel->m_stop_event;
+
+    OVERLAPPED overlapped{};
+    overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (overlapped.hEvent == nullptr)
+    {
+        Logger::Warn("ControlChannel: CreateEvent failed with error ", GetLastError());
+        channel->m_running = false;
+        return;
+    }
+
+    while (channel->m_running)
+    {
+        HANDLE pipe = CreateNamedPipeA(pipeName.c_str(), PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
+                                       PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS,
+                                       1, (DWORD) kControlChannelMaxRequestSize, (DWORD) kControlChannelMaxRequestSize,
+                                       0, nullptr);
+        if (pipe == INVALID_HANDLE_VALUE)
+        {
+            Logger::Warn("ControlChannel: CreateNamedPipe failed with error ", GetLastError());
+            channel->m_running = false;
+            break;
+        }
+
+        DWORD transferred = 0;
+        bool connected = ConnectNamedPipe(pipe, &overlapped) != FALSE;
+        if (!connected)
+        {
+            const auto error = GetLastError();
+            connected = error == ERROR_PIPE_CONNECTED ||
+                        (error == ERROR_IO_PENDING &&
+                         WaitForPipeIo(pipe, &overlapped, stopEvent, INFINITE, &transferred));
+        }
+
+        if (!connected || !channel->m_running)
+        {
+            CloseHandle(pipe);
+            continue;
+        }
+
+        // Don't let a stalled client hold the channel, every read and write times out
+        std::string request;
+        char buffer[512];
+        while (request.size() < kControlChannelMaxRequestSize &&
+               PipeIo(pipe, false, buffer, sizeof(buffer), &overlapped, stopEvent, &transferred) && transferred > 0)
+        {
+            request.append(buffer, transferred);
+            if (request.find('\n') != std::string::npos)
+            {
+                break;
+            }
+        }
+
+        const auto newLine = request.find_first_of("\r\n");
+        if (newLine != std::string::npos)
+        {
+            request.erase(newLine);
+        }
+
+        if (channel->m_running)
+        {
+            auto response = channel->HandleRequest(request);
+            PipeIo(pipe, true, &response[0], (DWORD) response.size(), &overlapped, stopEvent, &transferred);
+            FlushFileBuffers(pipe);
+        }
+        DisconnectNamedPipe(pipe);
+        CloseHandle(pipe);
+    }
+
+    CloseHandle(overlapped.hEvent);
+}
+
+bool ControlChannel::SendRequest(const std::string& path, const std::string& request, std::string& response)
+{
+    const auto pipeName = GetPipeName(path);
+    if (!WaitNamedPipeA(pipeName.c_str(), 2000))
+    {
+        return false;
+    }
+
+    HANDLE pipe = CreateFileA(pipeName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (pipe == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    const auto line = request + "\n";
+    DWORD written = 0;
+    if (!WriteFile(pipe, line.c_str(), (DWORD) line.size(), &written, nullptr))
+    {
+        CloseHandle(pipe);
+        return false;
+    }
+
+    response.clear();
+    char buffer[512];
+    DWORD read = 0;
+    while (ReadFile(pipe, buffer, sizeof(buffer), &read, nullptr) && read > 0)
+    {
+        response.append(buffer, read);
+    }
+
+    CloseHandle(pipe);
+    return true;
+}
+
+#else
+
+bool ControlChannel::Start()
+{
+    if (m_running || m_path.empty())
+    {
+        return false;
+    }
+
+    sockaddr_un address{};
+    if (m_path.size() >= sizeof(address.sun_path))
+    {
+        Logger::Warn("ControlChannel: socket path is too long: ", m_path);
+        return false;
+    }
+
+    m_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (m_socket < 0)
+    {
+        Logger::Warn("ControlChannel: socket creation failed with error ", errno);
+        return false;
+    }
+
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+
+    // Remove a stale socket left by a previous process of the same user, never any other kind of file.
+    struct stat existing;
+    if (lstat(m_path.c_str(), &existing) == 0)
+    {
+        if (!S_ISSOCK(existing.st_mode) || existing.st_uid != geteuid())
+        {
+            Logger::Warn("ControlChannel: ", m_path, " exists and is not a socket owned by this user");
+            close(m_socket);
+            m_socket = -1;
+            return false;
+        }
+        unlink(m_path.c_str());
+    }
+
+    // Only the user running the process can talk to the channel: the socket file is created without group and
+    // other permissions, so nobody else can connect between bind and listen.
+    const auto previousMask = umask(S_IRWXG | S_IRWXO);
+    const auto bound = bind(m_socket, (sockaddr*) &address, sizeof(address)) == 0;
+    umask(previousMask);
+
+    if (!bound || listen(m_socket, 4) != 0)
+    {
+        Logger::Warn("ControlChannel: unable to listen on ", m_path, " error ", errno);
+        close(m_socket);
+        m_socket = -1;
+        return false;
+    }
+
+    m_running = true;
+    m_thread = std::make_unique<std::thread>(ServerThreadLoop, this);
+    Logger::Info("ControlChannel: listening on ", m_path);
+    return true;
+}
+
+void ControlChannel::Stop()
+{
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    // The server thread polls with a timeout, so it exits shortly after the flag changes.
+    if (m_thread != nullptr && m_thread->joinable())
+    {
+        m_thread->join();
+    }
+    m_thread = nullptr;
+
+    close(m_socket);
+    m_socket = -1;
+    unlink(m_path.c_str());
+}
+
+void ControlChannel::ServerThreadLoop(ControlChannel* channel)
+{
+    pollfd listener{};
+    listener.fd = channel->m_socket;
+    listener.events = POLLIN;
+
+    while (channel->m_running)
+    {
+        listener.revents = 0;
+        const int ready = poll(&listener, 1, kControlChannelPollTimeoutMs);
+        if (ready <= 0 || (listener.revents & POLLIN) == 0)
+        {
+            continue;
+        }
+
+        const int client = accept(channel->m_socket, nullptr, nullptr);
+        if (client < 0)
+        {
+            continue;
+        }
+
+#ifdef SO_NOSIGPIPE
+        const int noSigPipe = 1;
+        setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+        // Don't let a stalled client hold the channel.
+        timeval timeout{};
+        timeout.tv_sec = 1;
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        std::string request;
+        char buffer[512];
+        ssize_t read = 0;
+        while (request.size() < kControlChannelMaxRequestSize && (read = recv(client, buffer, sizeof(buffer), 0)) > 0)
+        {
+            request.append(buffer, (size_t) read);
+            if (request.find('\n') != std::string::npos)
+            {
+                break;
+            }
+        }
+
+        const auto newLine = request.find_first_of("\r\n");
+        if (newLine != std::string::npos)
+        {
+            request.erase(newLine);
+        }
+
+        const auto response = channel->HandleRequest(request);
+        size_t sent = 0;
+        while (sent < response.size())
+        {
+            const auto res = send(client, response.c_str() + sent, response.size() - sent, MSG_NOSIGNAL);
+            if (res <= 0)
+            {
+                break;
+            }
+            sent += (size_t) res;
+        }
+        close(client);
+    }
+}
+
+bool ControlChannel::SendRequest(const std::string& path, const std::string& request, std::string& response)
+{
+    sockaddr_un address{};
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+
+    const int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client < 0)
+    {
+        return false;
+    }
+
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (connect(client, (sockaddr*) &address, sizeof(address)) != 0)
+    {
+        close(client);
+        return false;
+    }
+
+    const auto line = request + "\n";
+    if (send(client, line.c_str(), line.size(), MSG_NOSIGNAL) != (ssize_t) line.size())
+    {
+        close(client);
+        return false;
+    }
+    shutdown(client, SHUT_WR);
+
+    response.clear();
+    char buffer[512];
+    ssize_t read = 0;
+    while ((read = recv(client, buffer, sizeof(buffer), 0)) > 0)
+    {
+        response.append(buffer, (size_t) read);
+    }
+
+    close(client);
+    return true;
+}
+
+#endif
+
+} // namespace trace
@@ -0,0 +1,52 @@
+#ifndef DD_CLR_PROFILER_CONTROL_CHANNEL_H_
+#define DD_CLR_PROFILER_CONTROL_CHANNEL_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace trace
+{
+
+/// <summary>
+/// Local endpoint used to query and reconfigure the profiler from outside the process.
+/// A Unix domain socket is used on Linux and macOS, and a named pipe on Windows.
+/// Each connection carries a single request line and receives a single text response,
+/// requests are served on a dedicated thread so they never run on a CLR callback thread.
+/// </summary>
+class ControlChannel
+{
+private:
+    std::string m_path;
+    std::function<std::string(const std::string&)> m_handler;
+    std::atomic_bool m_running = {false};
+    std::unique_ptr<std::thread> m_thread;
+
+#ifdef _WIN32
+    // Manual reset event (HANDLE) that cancels the pending pipe I/O of the server thread
+    void* m_stop_event = nullptr;
+#else
+    int m_socket = -1;
+#endif
+
+    static void ServerThreadLoop(ControlChannel* channel);
+    std::string HandleRequest(const std::string& request);
+
+public:
+    ControlChannel(const std::string& path, std::function<std::string(const std::string&)> handler);
+    ~ControlChannel();
+
+    bool Start();
+    void Stop();
+    bool IsRunning() const;
+    const std::string& GetPath() const;
+
+    // Client side helper: sends a request to the channel at the given path and returns the response.
+    static bool SendRequest(const std::string& path, const std::string& request, std::string& response);
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_CONTROL_CHANNEL_H_
@@ -18,6 +18,7 @@
 #include "pal.h"
 #include "resource.h"
 #include "sig_helpers.h"
+#include "skip_assembly_matcher.h"
 #include "stats.h"
 #include "util.h"
 #include "version.h"
@@ -48,6 +49,9 @@ HRESULT STDMETHODCALLTYPE CorProfiler::Initialize(IUnknown* cor_profiler_info_un
     // check if dump il rewrite is enabled
     dump_il_rewrite_enabled = IsDumpILRewriteEnabled();
 
+    // check if instrumented method bodies are exported with the compact IL encoding
+    il_compact_encoding_enabled = IsILCompactEncodingEnabled();
+
     CorProfilerBase::Initialize(cor_profiler_info_unknown);
 
     // check if tracing is completely disabled
@@ -185,6 +189,9 @@ HRESULT STDMETHODCALLTYPE CorProfiler::Initialize(IUnknown* cor_profiler_info_un
         rejit_handler =
             info10 != nullptr ? new RejitHandler(info10, callback) :
             is_net46_or_greater ? new RejitHandler(info6, callback) : new RejitHandler(this->info_, callback);
+        rejit_handler->SetModuleInfoCache(&module_info_cache_);
+        rejit_handler->SetMethodSignatureCache(&method_signature_cache_);
+        rejit_handler->SetPrecompiledCodeIndex(&precompiled_code_index_);
     }
     else
     {
@@ -250,10 +257,46 @@ HRESULT STDMETHODCALLTYPE CorProfiler::Initialize(IUnknown* cor_profiler_info_un
         instrument_domain_neutral_assemblies = true;
     }
 
+    if (IsNativeExceptionMetricsEnabled())
+    {
+        // Only adds callbacks to exceptions being thrown, which are already expensive
+        Logger::Info("Native exception metrics are enabled.");
+        event_mask |= COR_PRF_MONITOR_EXCEPTIONS;
+        exception_metrics_ = std::make_unique<ExceptionMetrics>(this->info_);
+    }
+
+    // COR_PRF_MONITOR_GC would disable concurrent GC, the native GC metrics only use the high flags that don't
+    // and the suspension callbacks to measure the pauses
+    const DWORD gc_event_mask = COR_PRF_MONITOR_SUSPENDS;
+    const DWORD gc_event_mask_high = COR_PRF_HIGH_BASIC_GC;
+    const bool gc_metrics_requested = IsNativeGCMetricsEnabled();
+    if (gc_metrics_requested && !is_net46_or_greater)
+    {
+        Logger::Warn("Native GC metrics are not supported on this runtime.");
+    }
+
     // set event mask to subscribe to events and disable NGEN images
     if (is_net46_or_greater)
     {
-        hr = info6->SetEventMask2(event_mask, COR_PRF_HIGH_ADD_ASSEMBLY_REFERENCES);
+        if (gc_metrics_requested)
+        {
+            hr = info6->SetEventMask2(event_mask | gc_event_mask,
+                                      COR_PRF_HIGH_ADD_ASSEMBLY_REFERENCES | gc_event_mask_high);
+            if (SUCCEEDED(hr))
+            {
+                Logger::Info("Native GC metrics are enabled.");
+                gc_metrics_ = std::make_unique<GCMetrics>(this->info_);
+            }
+            else
+            {
+                Logger::Warn("Native GC metrics are not supported on this runtime: SetEventMask2 failed with ", hr);
+            }
+        }
+
+        if (gc_metrics_ == nullptr)
+        {
+            hr = info6->SetEventMask2(event_mask, COR_PRF_HIGH_ADD_ASSEMBLY_REFERENCES);
+        }
 
         if (instrument_domain_neutral_assemblies)
         {
@@ -283,6 +326,11 @@ HRESULT STDMETHODCALLTYPE CorProfiler::Initialize(IUnknown* cor_profiler_info_un
     }
 
     runtime_information_ = GetRuntimeInformation(this->info_);
+    if (rejit_handler != nullptr)
+    {
+        rejit_handler->ConfigureRejitWithInliners(runtime_information_, IsRejitWithInlinersEnabled());
+    }
+
     if (process_name == WStr("w3wp.exe") || process_name == WStr("iisexpress.exe"))
     {
         is_desktop_iis = runtime_information_.is_desktop();
@@ -307,6 +355,11 @@ HRESULT STDMETHODCALLTYPE CorProfiler::Initialize(IUnknown* cor_profiler_info_un
     is_attached_.store(true);
     profiler = this;
 
+    StartControlChannel();
+    StartILFlightRecorder();
+    StartSpanFlusher();
+    StartEventPipeConsumer();
+
 #ifndef _WIN32
     if (IsDebugEnabled())
     {
@@ -414,6 +467,20 @@ HRESULT STDMETHODCALLTYPE CorProfiler::AssemblyLoadFinished(AssemblyID assembly_
                              " matched profiler version v", expected_version);
                 managed_profiler_loaded_app_domains.insert(assembly_info.app_domain_id);
 
+                {
+                    std::lock_guard<std::mutex> guard(startup_hook_lock_);
+                    const auto start_time = startup_hook_start_times_.find(assembly_info.app_domain_id);
+                    if (start_time != startup_hook_start_times_.end())
+                    {
+                        const auto elapsed = std::chrono::steady_clock::now() - start_time->second;
+                        trace::Stats::Instance()->StartupHookCompleted(elapsed.count());
+                        Logger::Debug("AssemblyLoadFinished: Startup hook of AppDomain ", assembly_info.app_domain_id,
+                                      " loaded Datadog.Trace.dll in ",
+                                      std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(), "us");
+                        startup_hook_start_times_.erase(start_time);
+                    }
+                }
+
                 if (runtime_information_.is_desktop() && corlib_module_loaded)
                 {
                     // Set the managed_profiler_loaded_domain_neutral flag whenever the
@@ -562,7 +629,7 @@ HRESULT STDMETHODCALLTYPE CorProfiler::ModuleLoadFinished(ModuleID module_id, HR
         return S_OK;
     }
 
-    const auto module_info = GetModuleInfo(this->info_, module_id);
+    const auto module_info = module_info_cache_.Add(this->info_, module_id);
     if (!module_info.IsValid())
     {
         return S_OK;
@@ -655,22 +722,17 @@ HRESULT STDMETHODCALLTYPE CorProfiler::ModuleLoadFinished(ModuleID module_id, HR
         return S_OK;
     }
 
-    for (auto&& skip_assembly : skip_assemblies)
+    const auto skip_match = SkipAssemblyMatcher::Default().Match(module_info.assembly.name);
+    if (skip_match == SkipAssemblyMatch::Exact)
     {
-        if (module_info.assembly.name == skip_assembly)
-        {
-            Logger::Debug("ModuleLoadFinished skipping known module: ", module_id, " ", module_info.assembly.name);
-            return S_OK;
-        }
+        Logger::Debug("ModuleLoadFinished skipping known module: ", module_id, " ", module_info.assembly.name);
+        return S_OK;
     }
 
-    for (auto&& skip_assembly_pattern : skip_assembly_prefixes)
+    if (skip_match == SkipAssemblyMatch::Prefix)
     {
-        if (module_info.assembly.name.rfind(skip_assembly_pattern, 0) == 0)
-        {
-            Logger::Debug("ModuleLoadFinished skipping module by pattern: ", module_id, " ", module_info.assembly.name);
-            return S_OK;
-        }
+        Logger::Debug("ModuleLoadFinished skipping module by pattern: ", module_id, " ", module_info.assembly.name);
+        return S_OK;
     }
 
     if (IsCallTargetEnabled(is_net46_or_greater))
@@ -716,7 +778,14 @@ HRESULT STDMETHODCALLTYPE CorProfiler::ModuleLoadFinished(ModuleID module_id, HR
         }
         else
         {
-            module_ids_.push_back(module_id);
+            module_ids_.Add(module_id);
+
+            // JITCompilationStarted can insert the startup hook in this module, so its NGEN code is skipped
+            // until the loader is injected in the AppDomain.
+            if (IsStartupHookCallSiteModule(module_info.assembly.name))
+            {
+                precompiled_code_index_.AddStartupHookModule(module_id, app_domain_id);
+            }
 
             // We call the function to analyze the module and request the ReJIT of integrations defined in this module.
             if (rejit_handler != nullptr && !integration_methods_.empty())
@@ -826,7 +895,7 @@ HRESULT STDMETHODCALLTYPE CorProfiler::ModuleUnloadStarted(ModuleID module_id)
 
     if (Logger::IsDebugEnabled())
     {
-        const auto module_info = GetModuleInfo(this->info_, module_id);
+        const auto module_info = module_info_cache_.GetModuleInfo(this->info_, module_id);
 
         if (module_info.IsValid())
         {
@@ -866,11 +935,18 @@ HRESULT STDMETHODCALLTYPE CorProfiler::ModuleUnloadStarted(ModuleID module_id)
         delete metadata;
     }
 
+    // remove the module from the list of modules analyzed for CallTarget
+    module_ids_.Remove(module_id);
+
     if (rejit_handler != nullptr)
     {
         rejit_handler->RemoveModule(module_id);
     }
 
+    module_info_cache_.Remove(module_id);
+    method_signature_cache_.Remove(module_id);
+    precompiled_code_index_.RemoveModule(module_id);
+
     return S_OK;
 }
 
@@ -880,6 +956,24 @@ HRESULT STDMETHODCALLTYPE CorProfiler::Shutdown()
 
     CorProfilerBase::Shutdown();
 
+    // Stops answering control channel commands before the state they read is released
+    if (control_channel_ != nullptr)
+    {
+        control_channel_->Stop();
+    }
+
+    // Writes what is left in the span buffer before the process goes away
+    if (span_flusher_ != nullptr)
+    {
+        span_flusher_->Stop();
+    }
+
+    // Ends the EventPipe session, the events already delivered are still aggregated
+    if (event_pipe_consumer_ != nullptr)
+    {
+        event_pipe_consumer_->Stop();
+    }
+
     // keep this lock until we are done using the module,
     // to prevent it from unloading while in use
     std::lock_guard<std::mutex> guard(module_id_to_info_map_lock_);
@@ -892,12 +986,27 @@ HRESULT STDMETHODCALLTYPE CorProfiler::Shutdown()
     }
     Logger::Info("Exiting...");
     Logger::Debug("   ModuleMetadata: ", module_id_to_info_map_.size());
-    Logger::Debug("   ModuleIds: ", module_ids_.size());
+    Logger::Debug("   ModuleIds: ", module_ids_.Size());
+    Logger::Debug("   ModuleInfos: ", module_info_cache_.Size());
+    Logger::Debug("   MethodSignatures: ", method_signature_cache_.Size());
+    Logger::Debug("   PrecompiledCodeRejectedMethods: ", precompiled_code_index_.MethodCount());
     Logger::Debug("   IntegrationMethods: ", integration_methods_.size());
     Logger::Debug("   DefinitionsIds: ", definitions_ids_.size());
     Logger::Debug("   ManagedProfilerLoadedAppDomains: ", managed_profiler_loaded_app_domains.size());
     Logger::Debug("   FirstJitCompilationAppDomains: ", first_jit_compilation_app_domains.size());
     Logger::Info("Stats: ", Stats::Instance()->ToString());
+    if (gc_metrics_ != nullptr)
+    {
+        Logger::Info(gc_metrics_->ToString());
+    }
+    if (event_pipe_consumer_ != nullptr)
+    {
+        Logger::Info(event_pipe_consumer_->ToString());
+    }
+    if (exception_metrics_ != nullptr)
+    {
+        Logger::Info(exception_metrics_->ToString());
+    }
     Logger::Shutdown();
     return S_OK;
 }
@@ -977,9 +1086,9 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCompilationStarted(FunctionID function
         // if the Id is in the module_ids_ vector.
         // In case is True we create a local ModuleMetadata to inject the loader.
 
-        if (is_calltarget_enabled && Contains(module_ids_, module_id))
+        if (is_calltarget_enabled && module_ids_.Contains(module_id))
         {
-            const auto module_info = GetModuleInfo(this->info_, module_id);
+            const auto module_info = module_info_cache_.GetModuleInfo(this->info_, module_id);
 
             has_loader_injected_in_appdomain = first_jit_compilation_app_domains.find(module_info.assembly.app_domain_id) !=
                                                first_jit_compilation_app_domains.end();
@@ -1045,18 +1154,12 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCompilationStarted(FunctionID function
     //
     // Note: This check must only run on desktop because it is possible (and the default) to host
     // ASP.NET Core in-process, so a new .NET Core runtime is instantiated and run in the same w3wp.exe process
-    auto valid_startup_hook_callsite = true;
-    if (is_desktop_iis)
+    auto valid_startup_hook_callsite = IsStartupHookCallSiteModule(module_metadata->assemblyName);
+    if (valid_startup_hook_callsite && is_desktop_iis)
     {
-        valid_startup_hook_callsite = module_metadata->assemblyName == WStr("System.Web") &&
-                                      caller.type.name == WStr("System.Web.Compilation.BuildManager") &&
+        valid_startup_hook_callsite = caller.type.name == WStr("System.Web.Compilation.BuildManager") &&
                                       caller.name == WStr("InvokePreStartInitMethods");
     }
-    else if (module_metadata->assemblyName == WStr("System") ||
-             module_metadata->assemblyName == WStr("System.Net.Http"))
-    {
-        valid_startup_hook_callsite = false;
-    }
 
     // The first time a method is JIT compiled in an AppDomain, insert our startup
     // hook, which, at a minimum, must add an AssemblyResolve event so we can find
@@ -1158,6 +1261,12 @@ HRESULT STDMETHODCALLTYPE CorProfiler::AppDomainShutdownFinished(AppDomainID app
     // remove appdomain metadata from map
     auto count = first_jit_compilation_app_domains.erase(appDomainId);
 
+    // The startup hook of an AppDomain that never loaded the managed profiler
+    {
+        std::lock_guard<std::mutex> startup_hook_guard(startup_hook_lock_);
+        startup_hook_start_times_.erase(appDomainId);
+    }
+
     Logger::Debug("AppDomainShutdownFinished: AppDomain: ", appDomainId, ", removed ", count, " elements");
 
     return S_OK;
@@ -1186,6 +1295,19 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITInlining(FunctionID callerId, Function
 
     if (is_attached_ && rejit_handler != nullptr && rejit_handler->HasModuleAndMethod(calleeModuleId, calleFunctionToken))
     {
+        // RequestReJITWithInliners blocks the inlining of the instrumented methods and rejits their inliners. The
+        // caller is remembered in case the runtime rejects the request and the inliners have to be rejitted here.
+        if (rejit_handler->IsInliningTrackedByRuntime())
+        {
+            ModuleID callerModuleId;
+            mdToken callerFunctionToken = mdTokenNil;
+            hr = this->info_->GetFunctionInfo(callerId, NULL, &callerModuleId, &callerFunctionToken);
+            if (SUCCEEDED(hr) && rejit_handler->AddRuntimeTrackedInliner(callerModuleId, callerFunctionToken))
+            {
+                return S_OK;
+            }
+        }
+
         Logger::Debug("*** JITInlining: Inlining disabled for [ModuleId=", calleeModuleId,
                       ", MethodDef=", TokenStr(&calleFunctionToken), "]");
         *pfShouldInline = false;
@@ -1241,6 +1363,7 @@ void CorProfiler::InitializeProfiler(WCHAR* id, CallTargetDefinition* items, int
 
             WSTRING wrapperAssembly;
             WSTRING wrapperType;
+            WSTRING integrationName;
 
             if (current.wrapperAssembly != nullptr)
             {
@@ -1250,6 +1373,10 @@ void CorProfiler::InitializeProfiler(WCHAR* id, CallTargetDefinition* items, int
             {
                 wrapperType = WSTRING(current.wrapperType);
             }
+            if (current.integrationName != nullptr)
+            {
+                integrationName = WSTRING(current.integrationName);
+            }
 
             std::vector<WSTRING> signatureTypes;
             for (int sIdx = 0; sIdx < current.signatureTypesLength; sIdx++)
@@ -1267,19 +1394,19 @@ void CorProfiler::InitializeProfiler(WCHAR* id, CallTargetDefinition* items, int
                 Version(current.targetMaximumMajor, current.targetMaximumMinor, current.targetMaximumPatch, 0);
 
             const auto integration = IntegrationMethod(
-                EmptyWStr,
+                integrationName,
                 MethodReplacement(
                     {},
                     MethodReference(targetAssembly, targetType, targetMethod, EmptyWStr, minVersion, maxVersion,
                         {}, signatureTypes),
                     MethodReference(wrapperAssembly, wrapperType, EmptyWStr, calltarget_modification_action, {}, {}, {},
-                                    {})));
+                                    {}, static_cast<CallTargetKind>(current.callTargetKind))));
 
             if (Logger::IsDebugEnabled())
             {
                 Logger::Debug("  * Target: ", targetAssembly, " | ", targetType, ".", targetMethod, "(", signatureTypes.size(), ") { ",
                               minVersion.str(), " - ", maxVersion.str(), " } [", wrapperAssembly,
-                              " | ", wrapperType, "]");
+                              " | ", wrapperType, " | ", integrationName, " | Kind=", current.callTargetKind, "]");
             }
 
             integrationMethods.push_back(integration);
@@ -1289,12 +1416,12 @@ void CorProfiler::InitializeProfiler(WCHAR* id, CallTargetDefinition* items, int
 
         definitions_ids_.emplace(definitionsId);
 
-        Logger::Info("Total number of modules to analyze: ", module_ids_.size());
+        Logger::Info("Total number of modules to analyze: ", module_ids_.Size());
         if (rejit_handler != nullptr)
         {
             std::promise<ULONG> promise;
             std::future<ULONG> future = promise.get_future();
-            rejit_handler->EnqueueProcessModule(module_ids_, integrationMethods, &promise);
+            rejit_handler->EnqueueProcessModule(module_ids_.Get(), integrationMethods, &promise);
 
             // wait and get the value from the future<int>
             const auto numReJITs = future.get();
@@ -1311,6 +1438,250 @@ void CorProfiler::InitializeProfiler(WCHAR* id, CallTargetDefinition* items, int
     }
 }
 
+//
+// SetIntegrationEnabled method
+//
+ULONG CorProfiler::SetIntegrationEnabled(WCHAR* integrationName, BOOL enabled)
+{
+    if (integrationName == nullptr || rejit_handler == nullptr)
+    {
+        return 0;
+    }
+
+    const WSTRING name = WSTRING(integrationName);
+
+    if (!enabled)
+    {
+        // Restore the original IL of every method rewritten for this integration.
+        const auto reverted = rejit_handler->DisableIntegration(name);
+        Logger::Info("SetIntegrationEnabled: ", name, " disabled, ", reverted, " methods reverted.");
+        return reverted;
+    }
+
+    if (!rejit_handler->EnableIntegration(name))
+    {
+        Logger::Info("SetIntegrationEnabled: ", name, " is not disabled.");
+        return 0;
+    }
+
+    std::scoped_lock<std::mutex> definitionsLock(definitions_ids_lock_);
+
+    // Request the ReJIT again for the integration in all the loaded modules,
+    // this also covers the modules loaded while the integration was disabled.
+    std::vector<IntegrationMethod> integrationMethods;
+    for (const auto& integration : integration_methods_)
+    {
+        if (RejitHandler::GetIntegrationName(integration) == name)
+        {
+            integrationMethods.push_back(integration);
+        }
+    }
+
+    if (integrationMethods.empty())
+    {
+        return 0;
+    }
+
+    std::scoped_lock<std::mutex> moduleLock(module_id_to_info_map_lock_);
+
+    std::promise<ULONG> promise;
+    std::future<ULONG> future = promise.get_future();
+    rejit_handler->EnqueueProcessModule(module_ids_.Get(), integrationMethods, &promise);
+
+    const auto numReJITs = future.get();
+    Logger::Info("SetIntegrationEnabled: ", name, " enabled, ", numReJITs, " methods requested for ReJIT.");
+    return numReJITs;
+}
+
+//
+// GetIntegrationRewrittenMethodCount method
+//
+ULONG CorProfiler::GetIntegrationRewrittenMethodCount(WCHAR* integrationName)
+{
+    if (integrationName == nullptr || rejit_handler == nullptr)
+    {
+        return 0;
+    }
+
+    return rejit_handler->GetIntegrationRewrittenMethodCount(WSTRING(integrationName));
+}
+
+//
+// Native span buffer
+//
+HRESULT CorProfiler::EnqueueSpans(const BYTE* buffer, int size)
+{
+    if (span_flusher_ == nullptr)
+    {
+        return E_NOTIMPL;
+    }
+
+    // Stopped by Shutdown, the spans would never be written
+    if (!span_flusher_->IsRunning())
+    {
+        return E_ABORT;
+    }
+
+    if (size < 0)
+    {
+        return E_INVALIDARG;
+    }
+
+    return span_flusher_->Enqueue(buffer, (size_t) size);
+}
+
+HRESULT CorProfiler::FlushSpans(int timeout_ms)
+{
+    if (span_flusher_ == nullptr)
+    {
+        return E_NOTIMPL;
+    }
+
+    return span_flusher_->Flush(std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms))
+               ? S_OK
+               : HRESULT_FROM_WIN32(ERROR_TIMEOUT);
+}
+
+//
+// Native GC metrics
+//
+HRESULT CorProfiler::GetGCMetrics(GCMetricsSnapshot* snapshot, int size) const
+{
+    if (gc_metrics_ == nullptr)
+    {
+        return E_NOTIMPL;
+    }
+
+    if (snapshot == nullptr || size < (int) sizeof(GCMetricsSnapshot))
+    {
+        return E_INVALIDARG;
+    }
+
+    gc_metrics_->GetSnapshot(snapshot);
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeSuspendStarted(COR_PRF_SUSPEND_REASON suspendReason)
+{
+    if (gc_metrics_ != nullptr)
+    {
+        gc_metrics_->OnRuntimeSuspendStarted(suspendReason);
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeSuspendAborted()
+{
+    if (gc_metrics_ != nullptr)
+    {
+        gc_metrics_->OnRuntimeSuspendAborted();
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::RuntimeResumeFinished()
+{
+    if (gc_metrics_ != nullptr)
+    {
+        gc_metrics_->OnRuntimeResumeFinished();
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::GarbageCollectionStarted(int cGenerations, BOOL generationCollected[],
+                                                                COR_PRF_GC_REASON reason)
+{
+    if (gc_metrics_ != nullptr)
+    {
+        gc_metrics_->OnGarbageCollectionStarted(cGenerations, generationCollected, reason);
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::GarbageCollectionFinished()
+{
+    if (gc_metrics_ != nullptr)
+    {
+        gc_metrics_->OnGarbageCollectionFinished();
+    }
+    return S_OK;
+}
+
+//
+// Native exception metrics
+//
+HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionThrown(ObjectID thrownObjectId)
+{
+    if (exception_metrics_ != nullptr)
+    {
+        exception_metrics_->OnExceptionThrown(thrownObjectId);
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionSearchFunctionEnter(FunctionID functionId)
+{
+    if (exception_metrics_ != nullptr)
+    {
+        exception_metrics_->OnExceptionSearchFunctionEnter(functionId);
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionUnwindFunctionLeave()
+{
+    if (exception_metrics_ != nullptr)
+    {
+        exception_metrics_->OnExceptionSearchFinished();
+    }
+    return S_OK;
+}
+
+HRESULT STDMETHODCALLTYPE CorProfiler::ExceptionCatcherEnter(FunctionID functionId, ObjectID objectId)
+{
+    if (exception_metrics_ != nullptr)
+    {
+        exception_metrics_->OnExceptionSearchFinished();
+    }
+    return S_OK;
+}
+
+//
+// Native EventPipe consumer
+//
+HRESULT CorProfiler::GetRuntimeEventMetrics(RuntimeEventMetricsSnapshot* snapshot, int size) const
+{
+    if (event_pipe_consumer_ == nullptr)
+    {
+        return E_NOTIMPL;
+    }
+
+    if (snapshot == nullptr || size < (int) sizeof(RuntimeEventMetricsSnapshot))
+    {
+        return E_INVALIDARG;
+    }
+
+    event_pipe_consumer_->GetSnapshot(snapshot);
+    return S_OK;
+}
+
+//
+// ICorProfilerCallback10 methods
+//
+HRESULT STDMETHODCALLTYPE CorProfiler::EventPipeEventDelivered(EVENTPIPE_PROVIDER provider, DWORD eventId,
+                                                               DWORD eventVersion, ULONG cbMetadataBlob,
+                                                               LPCBYTE metadataBlob, ULONG cbEventData,
+                                                               LPCBYTE eventData, LPCGUID pActivityId,
+                                                               LPCGUID pRelatedActivityId, ThreadID eventThread,
+                                                               ULONG numStackFrames, UINT_PTR stackFrames[])
+{
+    if (event_pipe_consumer_ != nullptr)
+    {
+        event_pipe_consumer_->OnEventDelivered(provider, eventId, eventVersion, eventData, cbEventData, eventThread);
+    }
+    return S_OK;
+}
+
 //
 // ICorProfilerCallback6 methods
 //
@@ -1325,42 +1696,34 @@ HRESULT STDMETHODCALLTYPE CorProfiler::GetAssemblyReferences(const WCHAR* wszAss
         return S_OK;
     }
 
-    // Convert the assembly path to the assembly name, assuming the assembly name
+    // Get the assembly name from the assembly path, assuming the assembly name
     // is either <assembly_name.ni.dll> or <assembly_name>.dll
-    auto assemblyPathString = ToString(wszAssemblyPath);
-    auto filename = assemblyPathString.substr(assemblyPathString.find_last_of("\\/") + 1);
-    auto lastNiDllPeriodIndex = filename.rfind(".ni.dll");
-    auto lastDllPeriodIndex = filename.rfind(".dll");
-    if (lastNiDllPeriodIndex != std::string::npos)
-    {
-        filename.erase(lastNiDllPeriodIndex, 7);
-    }
-    else if (lastDllPeriodIndex != std::string::npos)
-    {
-        filename.erase(lastDllPeriodIndex, 4);
-    }
-
-    const WSTRING assembly_name = ToWSTRING(filename);
+    const WCHAR* assembly_name_start;
+    size_t assembly_name_length;
+    SkipAssemblyMatcher::GetAssemblyNameFromPath(wszAssemblyPath, &assembly_name_start, &assembly_name_length);
 
     // Skip known framework assemblies that we will not instrument and,
     // as a result, will not need an assembly reference to the
     // managed profiler
-    for (auto&& skip_assembly_pattern : skip_assembly_prefixes)
+    const auto skip_match = SkipAssemblyMatcher::Default().Match(assembly_name_start, assembly_name_length);
+    if (skip_match == SkipAssemblyMatch::Prefix)
     {
-        if (assembly_name.rfind(skip_assembly_pattern, 0) == 0)
+        if (Logger::IsDebugEnabled())
         {
-            Logger::Debug("GetAssemblyReferences skipping module by pattern: Name=", assembly_name, " Path=", wszAssemblyPath);
-            return S_OK;
+            Logger::Debug("GetAssemblyReferences skipping module by pattern: Name=",
+                          WSTRING(assembly_name_start, assembly_name_length), " Path=", wszAssemblyPath);
         }
+        return S_OK;
     }
 
-    for (auto&& skip_assembly : skip_assemblies)
+    if (skip_match == SkipAssemblyMatch::Exact)
     {
-        if (assembly_name == skip_assembly)
+        if (Logger::IsDebugEnabled())
         {
-            Logger::Debug("GetAssemblyReferences skipping known assembly: Name=", assembly_name, " Path=", wszAssemblyPath);
-            return S_OK;
+            Logger::Debug("GetAssemblyReferences skipping known assembly: Name=",
+                          WSTRING(assembly_name_start, assembly_name_length), " Path=", wszAssemblyPath);
         }
+        return S_OK;
     }
 
     // Construct an ASSEMBLYMETADATA structure for the managed profiler that can
@@ -1406,8 +1769,12 @@ HRESULT STDMETHODCALLTYPE CorProfiler::GetAssemblyReferences(const WCHAR* wszAss
         return S_OK;
     }
 
-    Logger::Debug("GetAssemblyReferences extending assembly closure for ", assembly_name, " to include ", asmRefInfo.szName,
-                  ". Path=", wszAssemblyPath);
+    if (Logger::IsDebugEnabled())
+    {
+        Logger::Debug("GetAssemblyReferences extending assembly closure for ",
+                      WSTRING(assembly_name_start, assembly_name_length), " to include ", asmRefInfo.szName,
+                      ". Path=", wszAssemblyPath);
+    }
     instrument_domain_neutral_assemblies = true;
 
     return S_OK;
@@ -1492,6 +1859,7 @@ HRESULT CorProfiler::ProcessReplacementCalls(ModuleMetadata* module_metadata, co
                                              const std::vector<MethodReplacement> method_replacements)
 {
     ILRewriter rewriter(this->info_, nullptr, module_id, function_token);
+    rewriter.SetCompactEncoding(il_compact_encoding_enabled);
     bool modified = false;
     auto hr = rewriter.Import();
 
@@ -1803,12 +2171,16 @@ HRESULT CorProfiler::ProcessReplacementCalls(ModuleMetadata* module_metadata, co
             size_t return_type_index = target.signature.IndexOfReturnType();
             PCCOR_SIGNATURE pSigCurrent =
                 PCCOR_SIGNATURE(&target.signature.data[return_type_index]); // index to the location of the return type
+            const PCCOR_SIGNATURE pSigEnd = PCCOR_SIGNATURE(target.signature.data.data() + target.signature.data.size());
             bool signature_read_success = true;
 
             // iterate until the pointer is pointing at the last argument
             for (size_t signature_types_index = 0; signature_types_index < argument_count; signature_types_index++)
             {
-                if (!ParseType(&pSigCurrent))
+                const bool parsed = signature_types_index == 0
+                                        ? ParseRetType(pSigCurrent, pSigEnd, SignatureGrammar::Full)
+                                        : ParseParam(pSigCurrent, pSigEnd, SignatureGrammar::Full);
+                if (!parsed)
                 {
                     signature_read_success = false;
                     break;
@@ -1848,7 +2220,7 @@ HRESULT CorProfiler::ProcessReplacementCalls(ModuleMetadata* module_metadata, co
                     // perform the boxing regardless of type
                     if (GetTypeInfo(module_metadata->metadata_import, valuetype_type_token).name ==
                             WStr("System.ReadOnlyMemory`1") &&
-                        ParseType(&p_end_byte))
+                        ParseType(p_end_byte, pSigEnd, SignatureGrammar::Full))
                     {
                         size_t length = p_end_byte - p_start_byte;
                         mdTypeSpec type_token;
@@ -1912,6 +2284,8 @@ HRESULT CorProfiler::ProcessReplacementCalls(ModuleMetadata* module_metadata, co
     if (modified)
     {
         hr = rewriter.Export();
+        RecordILRewrite(ILFlightRecorderRewriteKind::CallSiteReplacement, hr, module_id, function_token, caller,
+                        &rewriter, module_metadata);
 
         if (FAILED(hr))
         {
@@ -1937,6 +2311,7 @@ HRESULT CorProfiler::ProcessInsertionCalls(ModuleMetadata* module_metadata, cons
 {
 
     ILRewriter rewriter(this->info_, nullptr, module_id, function_token);
+    rewriter.SetCompactEncoding(il_compact_encoding_enabled);
     bool modified = false;
 
     auto hr = rewriter.Import();
@@ -1998,6 +2373,8 @@ HRESULT CorProfiler::ProcessInsertionCalls(ModuleMetadata* module_metadata, cons
     if (modified)
     {
         hr = rewriter.Export();
+        RecordILRewrite(ILFlightRecorderRewriteKind::CallSiteInsertion, hr, module_id, function_token, caller,
+                        &rewriter, module_metadata);
 
         if (FAILED(hr))
         {
@@ -2021,7 +2398,7 @@ bool CorProfiler::GetWrapperMethodRef(ModuleMetadata* module_metadata, ModuleID
     // later to define a MethodSpec
     if (!module_metadata->TryGetWrapperMemberRef(wrapper_method_key, wrapper_method_ref))
     {
-        const auto module_info = GetModuleInfo(this->info_, module_id);
+        const auto module_info = module_info_cache_.GetModuleInfo(this->info_, module_id);
         if (!module_info.IsValid())
         {
             return false;
@@ -2078,6 +2455,17 @@ bool CorProfiler::ProfilerAssemblyIsLoadedIntoAppDomain(AppDomainID app_domain_i
            managed_profiler_loaded_app_domains.find(app_domain_id) != managed_profiler_loaded_app_domains.end();
 }
 
+bool CorProfiler::IsStartupHookCallSiteModule(const WSTRING& assembly_name) const
+{
+    if (is_desktop_iis)
+    {
+        // Only System.Web.Compilation.BuildManager.InvokePreStartInitMethods
+        return assembly_name == WStr("System.Web");
+    }
+
+    return assembly_name != WStr("System") && assembly_name != WStr("System.Net.Http");
+}
+
 const std::string indent_values[] = {
     "",
     std::string(2 * 1, ' '),
@@ -2289,25 +2677,232 @@ std::string CorProfiler::GetILCodes(const std::string& title, ILRewriter* rewrit
     return orig_sstream.str();
 }
 
-//
-// Startup methods
-//
-HRESULT CorProfiler::RunILStartupHook(const ComPtr<IMetaDataEmit2>& metadata_emit, const ModuleID module_id,
-                                      const mdToken function_token)
+void CorProfiler::StartILFlightRecorder()
 {
-    mdMethodDef ret_method_token;
-    auto hr = GenerateVoidILStartupMethod(module_id, &ret_method_token);
+    if (!IsILFlightRecorderEnabled())
+    {
+        return;
+    }
 
-    if (FAILED(hr))
+    uint64_t capacity = kILFlightRecorderDefaultCapacity;
+    const auto size = GetEnvironmentValue(environment::il_flight_recorder_size);
+    if (!size.empty())
     {
-        Logger::Warn("RunILStartupHook: Call to GenerateVoidILStartupMethod failed for ", module_id);
-        return hr;
+        try
+        {
+            capacity = std::stoull(ToString(size));
+        }
+        catch (...)
+        {
+            Logger::Warn("Invalid value for ", environment::il_flight_recorder_size, ": ", size, ". Using ",
+                         kILFlightRecorderDefaultCapacity, ".");
+        }
     }
 
-    ILRewriter rewriter(this->info_, nullptr, module_id, function_token);
-    hr = rewriter.Import();
+    // The ring lives next to the native log file, one file per process
+    auto path = std::filesystem::path(ToString(GetDatadogLogFilePath<TracerLoggerPolicy>(""))).parent_path();
+    std::error_code ec;
+    std::filesystem::create_directories(path, ec);
+    path /= "dotnet-tracer-il-" + std::to_string(GetPID()) + ".bin";
 
-    if (FAILED(hr))
+    il_flight_recorder_ = std::make_unique<ILFlightRecorder>();
+    if (!il_flight_recorder_->Open(path.string(), capacity))
+    {
+        Logger::Warn("IL flight recorder could not be created at: ", path.string());
+        il_flight_recorder_ = nullptr;
+        return;
+    }
+
+    Logger::Info("IL flight recorder enabled at: ", path.string());
+}
+
+static size_t GetSpanBufferOption(const WSTRING& name, size_t default_value)
+{
+    const auto value = GetEnvironmentValue(name);
+    if (value.empty())
+    {
+        return default_value;
+    }
+
+    try
+    {
+        const auto parsed = std::stoull(ToString(value));
+        if (parsed > 0)
+        {
+            return (size_t) parsed;
+        }
+    }
+    catch (...)
+    {
+    }
+
+    Logger::Warn("Invalid value for ", name, ": ", value, ". Using ", default_value, ".");
+    return default_value;
+}
+
+void CorProfiler::StartSpanFlusher()
+{
+    const auto output = GetEnvironmentValue(environment::span_buffer_output);
+    if (output.empty())
+    {
+        return;
+    }
+
+    auto sink = CreateSpanSink(ToString(output));
+    if (sink == nullptr)
+    {
+        Logger::Warn("Invalid value for ", environment::span_buffer_output, ": ", output,
+                     ". Expected file:<path> or unix:<path>.");
+        return;
+    }
+
+    SpanFlusherOptions options;
+    options.capacity = GetSpanBufferOption(environment::span_buffer_size, options.capacity);
+    options.batch_size = GetSpanBufferOption(environment::span_buffer_batch_size, options.batch_size);
+    options.max_record_size = GetSpanBufferOption(environment::span_buffer_record_size, options.max_record_size);
+    options.flush_interval = std::chrono::milliseconds(
+        GetSpanBufferOption(environment::span_buffer_flush_interval, (size_t) options.flush_interval.count()));
+
+    span_flusher_ = std::make_unique<SpanFlusher>(std::move(sink), options);
+    if (!span_flusher_->Start())
+    {
+        Logger::Warn("Native span buffer could not be started for: ", output);
+        span_flusher_ = nullptr;
+        return;
+    }
+
+    Logger::Info("Native span buffer enabled, writing to: ", output);
+}
+
+void CorProfiler::StartEventPipeConsumer()
+{
+    if (!IsNativeEventPipeEnabled())
+    {
+        return;
+    }
+
+    ICorProfilerInfo12* info12 = nullptr;
+    HRESULT hr = this->info_->QueryInterface(__uuidof(ICorProfilerInfo12), (void**) &info12);
+    if (FAILED(hr))
+    {
+        Logger::Warn("Native EventPipe consumer is not supported on this runtime: .NET 5.0 or greater is required.");
+        return;
+    }
+
+    EventPipeConsumerOptions options;
+    const auto providers = GetEnvironmentValue(environment::native_eventpipe_providers);
+    if (!ParseEventPipeProviders(providers, &options.providers))
+    {
+        Logger::Warn("Invalid value for ", environment::native_eventpipe_providers, ": ", providers,
+                     ". Expected Provider[:Keywords[:Level]] separated by commas.");
+        return;
+    }
+
+    // Events are only delivered to the profiler with COR_PRF_HIGH_MONITOR_EVENT_PIPE
+    DWORD event_mask_low = 0;
+    DWORD event_mask_high = 0;
+    hr = info12->GetEventMask2(&event_mask_low, &event_mask_high);
+    if (SUCCEEDED(hr))
+    {
+        hr = info12->SetEventMask2(event_mask_low, event_mask_high | COR_PRF_HIGH_MONITOR_EVENT_PIPE);
+    }
+    if (FAILED(hr))
+    {
+        Logger::Warn("Native EventPipe consumer could not be started: SetEventMask2 failed with ", hr);
+        return;
+    }
+
+    event_pipe_consumer_ = std::make_unique<EventPipeConsumer>(info12, options);
+    hr = event_pipe_consumer_->Start();
+    if (FAILED(hr))
+    {
+        Logger::Warn("Native EventPipe consumer could not be started: EventPipeStartSession failed with ", hr);
+        event_pipe_consumer_ = nullptr;
+        info12->SetEventMask2(event_mask_low, event_mask_high);
+        return;
+    }
+
+    Logger::Info("Native EventPipe consumer enabled for ", options.providers.size(), " provider(s).");
+}
+
+void CorProfiler::RecordILRewrite(ILFlightRecorderRewriteKind kind, HRESULT hr, ModuleID module_id,
+                                  mdToken function_token, const FunctionInfo& caller, ILRewriter* rewriter,
+                                  ModuleMetadata* module_metadata)
+{
+    static_assert(sizeof(IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT) == sizeof(ILFlightRecorderEHClause),
+                  "The recorder stores EH clauses in the fat format");
+
+    if (il_flight_recorder_ == nullptr)
+    {
+        return;
+    }
+
+    const auto getLocalSignature = [&](mdToken localVarSig, ILFlightRecorderBody& body) {
+        PCCOR_SIGNATURE signature = nullptr;
+        ULONG signatureLength = 0;
+        if (localVarSig != mdTokenNil &&
+            SUCCEEDED(module_metadata->metadata_import->GetSigFromToken(localVarSig, &signature, &signatureLength)))
+        {
+            body.localSignature = signature;
+            body.localSignatureSize = signatureLength;
+        }
+    };
+
+    ILFlightRecorderBody original;
+    std::vector<IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT> originalEH(rewriter->GetOriginalEHCount());
+    if (rewriter->GetOriginalCode() != nullptr)
+    {
+        original.code = rewriter->GetOriginalCode();
+        original.codeSize = rewriter->GetOriginalCodeSize();
+        for (unsigned i = 0; i < originalEH.size(); i++)
+        {
+            rewriter->GetOriginalEHClause(i, &originalEH[i]);
+        }
+        original.ehClauses = reinterpret_cast<const ILFlightRecorderEHClause*>(originalEH.data());
+        original.ehCount = (uint32_t) originalEH.size();
+        getLocalSignature(rewriter->GetOriginalTkLocalVarSig(), original);
+    }
+
+    // The new body is only meaningful when Export() succeeded
+    ILFlightRecorderBody rewritten;
+    std::vector<IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT> rewrittenEH;
+    if (SUCCEEDED(hr))
+    {
+        rewrittenEH.resize(rewriter->GetEHCount());
+        rewritten.code = rewriter->GetExportedCode();
+        rewritten.codeSize = rewriter->GetExportedCodeSize();
+        for (unsigned i = 0; i < rewrittenEH.size(); i++)
+        {
+            rewriter->GetExportedEHClause(i, &rewrittenEH[i]);
+        }
+        rewritten.ehClauses = reinterpret_cast<const ILFlightRecorderEHClause*>(rewrittenEH.data());
+        rewritten.ehCount = (uint32_t) rewrittenEH.size();
+        getLocalSignature(rewriter->GetTkLocalVarSig(), rewritten);
+    }
+
+    const auto name = ToString(caller.type.name + WStr(".") + caller.name);
+    il_flight_recorder_->Record(module_id, function_token, kind, hr, name, original, rewritten);
+}
+
+//
+// Startup methods
+//
+HRESULT CorProfiler::RunILStartupHook(const ComPtr<IMetaDataEmit2>& metadata_emit, const ModuleID module_id,
+                                      const mdToken function_token)
+{
+    mdMethodDef ret_method_token;
+    auto hr = GenerateVoidILStartupMethod(module_id, &ret_method_token);
+
+    if (FAILED(hr))
+    {
+        Logger::Warn("RunILStartupHook: Call to GenerateVoidILStartupMethod failed for ", module_id);
+        return hr;
+    }
+
+    ILRewriter rewriter(this->info_, nullptr, module_id, function_token);
+    hr = rewriter.Import();
+
+    if (FAILED(hr))
     {
         Logger::Warn("RunILStartupHook: Call to ILRewriter.Import() failed for ", module_id, " ", function_token);
         return hr;
@@ -2831,6 +3426,22 @@ HRESULT CorProfiler::GenerateVoidILStartupMethod(const ModuleID module_id, mdMet
     pNewInstr->m_Arg32 = pinvoke_method_def;
     rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
 
+    // ldloc.1 : Load the "assemblySize" variable (locals index 1)
+    pNewInstr = rewriter_void.NewILInstr();
+    pNewInstr->m_opcode = CEE_LDLOC_1;
+    rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
+
+    // brtrue.s : Continue when the profiler handed out the assembly
+    pNewInstr = rewriter_void.NewILInstr();
+    pNewInstr->m_opcode = CEE_BRTRUE_S;
+    rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
+    ILInstr* pAssemblyBranchInstr = pNewInstr;
+
+    // return when "assemblySize" is 0, the embedded assembly couldn't be decompressed and "assemblyPtr" is null
+    pNewInstr = rewriter_void.NewILInstr();
+    pNewInstr->m_opcode = CEE_RET;
+    rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
+
     // Step 2) Call void Marshal.Copy(IntPtr source, byte[] destination, int startIndex, int length) to populate the
     // managed assembly bytes
 
@@ -2839,6 +3450,9 @@ HRESULT CorProfiler::GenerateVoidILStartupMethod(const ModuleID module_id, mdMet
     pNewInstr->m_opcode = CEE_LDLOC_1;
     rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
 
+    // Set the assembly branch target
+    pAssemblyBranchInstr->m_pTarget = pNewInstr;
+
     // newarr System.Byte : Create a new Byte[] to hold a managed copy of the assembly data
     pNewInstr = rewriter_void.NewILInstr();
     pNewInstr->m_opcode = CEE_NEWARR;
@@ -2879,7 +3493,29 @@ HRESULT CorProfiler::GenerateVoidILStartupMethod(const ModuleID module_id, mdMet
     rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
 
     // Step 3) Call void Marshal.Copy(IntPtr source, byte[] destination, int startIndex, int length) to populate the
-    // symbols bytes
+    // symbols bytes, only when the profiler exposes them
+
+    // ldnull : The "symbolsBytes" variable stays null without symbols
+    pNewInstr = rewriter_void.NewILInstr();
+    pNewInstr->m_opcode = CEE_LDNULL;
+    rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
+
+    // stloc.s 5 : Assign null to the "symbolsBytes" variable (locals index 5)
+    pNewInstr = rewriter_void.NewILInstr();
+    pNewInstr->m_opcode = CEE_STLOC_S;
+    pNewInstr->m_Arg8 = 5;
+    rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
+
+    // ldloc.3 : Load the "symbolsSize" variable (locals index 3)
+    pNewInstr = rewriter_void.NewILInstr();
+    pNewInstr->m_opcode = CEE_LDLOC_3;
+    rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
+
+    // brfalse.s : Skip the copy when "symbolsSize" is 0, Marshal.Copy throws on a null pointer
+    pNewInstr = rewriter_void.NewILInstr();
+    pNewInstr->m_opcode = CEE_BRFALSE_S;
+    rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
+    ILInstr* pNoSymbolsBranchInstr = pNewInstr;
 
     // ldloc.3 : Load the "symbolsSize" variable (locals index 3)
     pNewInstr = rewriter_void.NewILInstr();
@@ -2934,6 +3570,9 @@ HRESULT CorProfiler::GenerateVoidILStartupMethod(const ModuleID module_id, mdMet
     pNewInstr->m_Arg8 = 4;
     rewriter_void.InsertBefore(pFirstInstr, pNewInstr);
 
+    // Set the no symbols branch target
+    pNoSymbolsBranchInstr->m_pTarget = pNewInstr;
+
     // ldloc.s 5 : Load the "symbolsBytes" variable (locals index 5) for the second byte[] parameter of
     // AppDomain.Load(byte[], byte[])
     pNewInstr = rewriter_void.NewILInstr();
@@ -3172,7 +3811,64 @@ extern uint8_t pdb_end[] asm("_binary_Datadog_Trace_ClrProfiler_Managed_Loader_p
 #endif
 
 void CorProfiler::GetAssemblyAndSymbolsBytes(BYTE** pAssemblyArray, int* assemblySize, BYTE** pSymbolsArray,
-                                             int* symbolsSize) const
+                                             int* symbolsSize)
+{
+    auto _ = trace::Stats::Instance()->GetAssemblyAndSymbolsBytesMeasure();
+
+    *pAssemblyArray = nullptr;
+    *assemblySize = 0;
+    *pSymbolsArray = nullptr;
+    *symbolsSize = 0;
+
+    std::call_once(managed_loader_once_, [this] {
+        BYTE* assembly = nullptr;
+        int embeddedAssemblySize = 0;
+        BYTE* symbols = nullptr;
+        int embeddedSymbolsSize = 0;
+        GetEmbeddedManagedLoader(&assembly, &embeddedAssemblySize, &symbols, &embeddedSymbolsSize);
+
+        managed_loader_assembly_ = std::make_unique<ManagedLoaderImage>(assembly, embeddedAssemblySize);
+
+        // The symbols are only useful to debug the loader, the startup hook doesn't load them otherwise
+        if (IsDebugEnabled())
+        {
+            managed_loader_symbols_ = std::make_unique<ManagedLoaderImage>(symbols, embeddedSymbolsSize);
+        }
+    });
+
+    const uint8_t* data;
+    size_t size;
+    if (!managed_loader_assembly_->Get(&data, &size))
+    {
+        Logger::Warn("GetAssemblyAndSymbolsBytes: Unable to load the embedded managed loader assembly.");
+        return;
+    }
+    *pAssemblyArray = (BYTE*) data;
+    *assemblySize = (int) size;
+
+    if (managed_loader_symbols_ != nullptr && managed_loader_symbols_->Get(&data, &size))
+    {
+        *pSymbolsArray = (BYTE*) data;
+        *symbolsSize = (int) size;
+    }
+
+    // The startup hook of the AppDomain ends when it loads the managed profiler
+    ThreadID thread_id;
+    AppDomainID app_domain_id;
+    if (SUCCEEDED(this->info_->GetCurrentThreadID(&thread_id)) &&
+        SUCCEEDED(this->info_->GetThreadAppDomain(thread_id, &app_domain_id)))
+    {
+        std::lock_guard<std::mutex> guard(startup_hook_lock_);
+        startup_hook_start_times_.emplace(app_domain_id, std::chrono::steady_clock::now());
+    }
+
+    trace::Stats::Instance()->ManagedLoaderDelivered(managed_loader_assembly_->GetCompressedSize(),
+                                                     *assemblySize + *symbolsSize,
+                                                     managed_loader_assembly_->GetDecompressNanoseconds());
+}
+
+void CorProfiler::GetEmbeddedManagedLoader(BYTE** pAssemblyArray, int* assemblySize, BYTE** pSymbolsArray,
+                                           int* symbolsSize) const
 {
 #ifdef _WIN32
     HINSTANCE hInstance = DllHandle;
@@ -3272,7 +3968,7 @@ HRESULT STDMETHODCALLTYPE CorProfiler::ReJITCompilationFinished(FunctionID funct
 
     Logger::Debug("ReJITCompilationFinished: [functionId: ", functionId, ", rejitId: ", rejitId, ", hrStatus: ", hrStatus,
                   ", safeToBlock: ", fIsSafeToBlock, "]");
-    return S_OK;
+    return rejit_handler->NotifyReJITCompilationFinished(functionId, rejitId, hrStatus);
 }
 
 HRESULT STDMETHODCALLTYPE CorProfiler::ReJITError(ModuleID moduleId, mdMethodDef methodId, FunctionID functionId,
@@ -3297,11 +3993,6 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCachedFunctionSearchStarted(FunctionID
         return S_OK;
     }
 
-    // keep this lock until we are done using the module,
-    // to prevent it from unloading while in use
-    std::lock_guard<std::mutex> guard(module_id_to_info_map_lock_);
-
-    // Extract Module metadata
     ModuleID module_id;
     mdToken function_token = mdTokenNil;
 
@@ -3313,47 +4004,30 @@ HRESULT STDMETHODCALLTYPE CorProfiler::JITCachedFunctionSearchStarted(FunctionID
         return S_OK;
     }
 
-    // Verify that we have the metadata for this module
-    ModuleMetadata* module_metadata = nullptr;
-
-    auto findRes = module_id_to_info_map_.find(module_id);
-    if (findRes != module_id_to_info_map_.end())
+    // CallTarget targets and the NGEN methods inlining them always go through the JIT.
+    if (precompiled_code_index_.ContainsMethod(module_id, function_token))
     {
-        module_metadata = findRes->second;
+        trace::Stats::Instance()->PrecompiledCodeRejected();
+        *pbUseCachedFunction = false;
+        return S_OK;
     }
 
-    AppDomainID appDomainId = 0;
-
-    if (module_metadata == nullptr)
+    AppDomainID app_domain_id = 0;
+    if (precompiled_code_index_.TryGetStartupHookAppDomain(module_id, &app_domain_id))
     {
-        if (!IsCallTargetEnabled(is_net46_or_greater) || !Contains(module_ids_, module_id))
+        std::lock_guard<std::mutex> guard(module_id_to_info_map_lock_);
+
+        if (first_jit_compilation_app_domains.find(app_domain_id) == first_jit_compilation_app_domains.end())
         {
-            // we haven't stored a ModuleMetadata for this module,
-            // so there's nothing to do here, we accept the NGEN image.
-            *pbUseCachedFunction = true;
+            Logger::Debug("Disabling NGEN due to missing loader.");
+            // The loader is missing in this AppDomain, we skip the NGEN image to allow the JITCompilationStart inject it.
+            trace::Stats::Instance()->PrecompiledCodeRejected();
+            *pbUseCachedFunction = false;
             return S_OK;
         }
-
-        const auto module_info = GetModuleInfo(this->info_, module_id);
-        appDomainId = module_info.assembly.app_domain_id;
-    }
-    else
-    {
-        appDomainId = module_metadata->app_domain_id;
-    }
-
-    const bool has_loader_injected_in_appdomain =
-        first_jit_compilation_app_domains.find(appDomainId) !=
-        first_jit_compilation_app_domains.end();
-
-    if (!has_loader_injected_in_appdomain)
-    {
-        Logger::Debug("Disabling NGEN due to missing loader.");
-        // The loader is missing in this AppDomain, we skip the NGEN image to allow the JITCompilationStart inject it.
-        *pbUseCachedFunction = false;
-        return S_OK;
     }
 
+    trace::Stats::Instance()->PrecompiledCodeAccepted();
     *pbUseCachedFunction = true;
     return S_OK;
 }
@@ -3431,7 +4105,7 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
     int retTypeFlags = retFuncArg.GetTypeFlags(retFuncElementType);
     bool isVoid = (retTypeFlags & TypeFlagVoid) > 0;
     bool isStatic = !(caller->method_signature.CallingConvention() & IMAGE_CEE_CS_CALLCONV_HASTHIS);
-    std::vector<FunctionMethodArgument> methodArguments = caller->method_signature.GetMethodArguments();
+    const auto& methodArguments = caller->method_signature.GetMethodArguments();
     int numArgs = caller->method_signature.NumberOfArguments();
     auto metaEmit = module_metadata->metadata_emit;
     auto metaImport = module_metadata->metadata_import;
@@ -3457,6 +4131,7 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
 
     // *** Create rewriter
     ILRewriter rewriter(this->info_, methodHandler->GetFunctionControl(), module_id, function_token);
+    rewriter.SetCompactEncoding(il_compact_encoding_enabled);
     bool modified = false;
     auto hr = rewriter.Import();
     if (FAILED(hr))
@@ -3466,9 +4141,10 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
         return S_FALSE;
     }
 
-    // *** Store the original il code text if the dump_il option is enabled.
+    // *** Store the original il code text if the dump_il option is enabled or requested for this method.
+    const bool dump_il = dump_il_rewrite_enabled || IsDumpILRequested(*caller);
     std::string original_code;
-    if (dump_il_rewrite_enabled)
+    if (dump_il)
     {
         original_code =
             GetILCodes("*** CallTarget_RewriterCallback(): Original Code: ", &rewriter, *caller, module_metadata);
@@ -3478,6 +4154,12 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
     ILRewriterWrapper reWriterWrapper(&rewriter);
     reWriterWrapper.SetILPosition(rewriter.GetILList()->m_pNext);
 
+    // *** Select the rewrite variant, integrations that only implement one of the hooks get a smaller method body
+    const CallTargetKind kind = method_replacement->wrapper_method.calltarget_kind;
+    const bool writeBeginMethod = kind != CallTargetKind::EndOnly;
+    const bool writeEndMethod = kind != CallTargetKind::BeginOnly;
+    const unsigned originalCodeSize = rewriter.GetOriginalCodeSize();
+
     // *** Modify the Local Var Signature of the method and initialize the new local vars
     ULONG callTargetStateIndex = static_cast<ULONG>(ULONG_MAX);
     ULONG exceptionIndex = static_cast<ULONG>(ULONG_MAX);
@@ -3486,170 +4168,228 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
     mdToken callTargetStateToken = mdTokenNil;
     mdToken exceptionToken = mdTokenNil;
     mdToken callTargetReturnToken = mdTokenNil;
-    ILInstr* firstInstruction;
-    callTargetTokens->ModifyLocalSigAndInitialize(&reWriterWrapper, caller, &callTargetStateIndex, &exceptionIndex,
-                                                  &callTargetReturnIndex, &returnValueIndex, &callTargetStateToken,
-                                                  &exceptionToken, &callTargetReturnToken, &firstInstruction);
-
-    // ***
-    // BEGIN METHOD PART
-    // ***
-
-    // *** Load instance into the stack (if not static)
-    if (isStatic)
+    ILInstr* firstInstruction = nullptr;
+    if (writeEndMethod)
     {
-        if (caller->type.valueType)
+        hr = callTargetTokens->ModifyLocalSigAndInitialize(&reWriterWrapper, caller, &callTargetStateIndex,
+                                                           &exceptionIndex, &callTargetReturnIndex, &returnValueIndex,
+                                                           &callTargetStateToken, &exceptionToken,
+                                                           &callTargetReturnToken, &firstInstruction, !writeBeginMethod);
+        if (FAILED(hr))
         {
-            // Static methods in a ValueType can't be instrumented.
-            // In the future this can be supported by adding a local for the valuetype and initialize it to the default
-            // value. After the signature modification we need to emit the following IL to initialize and load into the
-            // stack.
-            //    ldloca.s [localIndex]
-            //    initobj [valueType]
-            //    ldloc.s [localIndex]
-            Logger::Warn("*** CallTarget_RewriterCallback(): Static methods in a ValueType cannot be instrumented. ");
+            // Error message is written to the log in ModifyLocalSigAndInitialize.
             return S_FALSE;
         }
-        reWriterWrapper.LoadNull();
     }
-    else
+
+    // *** Write the modified method body
+    const auto exportRewrittenMethod = [&]() {
+        if (dump_il)
+        {
+            Logger::Info(original_code);
+            Logger::Info(GetILCodes("*** CallTarget_RewriterCallback(): Modified Code: ", &rewriter, *caller,
+                                    module_metadata));
+        }
+
+        hr = rewriter.Export();
+        RecordILRewrite((ILFlightRecorderRewriteKind) kind, hr, module_id, function_token, *caller, &rewriter,
+                        module_metadata);
+
+        if (FAILED(hr))
+        {
+            Logger::Warn("*** CallTarget_RewriterCallback(): Call to ILRewriter.Export() failed for "
+                         "ModuleID=",
+                         module_id, " ", function_token);
+            return S_FALSE;
+        }
+
+        Stats::Instance()->CallTargetKindRewritten((unsigned int) kind, originalCodeSize,
+                                                   rewriter.GetExportedCodeSize());
+
+        Logger::Info("*** CallTarget_RewriterCallback() Finished: ", caller->type.name, ".", caller->name,
+                     "() [IsVoid=", isVoid, ", IsStatic=", isStatic,
+                     ", IntegrationType=", method_replacement->wrapper_method.type_name, ", Arguments=", numArgs,
+                     ", Kind=", (int) kind, "]");
+        return S_OK;
+    };
+
+    // ***
+    // BEGIN METHOD PART
+    // ***
+
+    EHClause beginMethodExClause{};
+    ILInstr* pStateLeaveToBeginOriginalMethodInstr = nullptr;
+    ILInstr* beginMethodCatchLeaveInstr = nullptr;
+    if (writeBeginMethod)
     {
-        reWriterWrapper.LoadArgument(0);
-        if (caller->type.valueType)
+        // *** Load instance into the stack (if not static)
+        if (isStatic)
         {
-            if (caller->type.type_spec != mdTypeSpecNil)
-            {
-                reWriterWrapper.LoadObj(caller->type.type_spec);
-            }
-            else if (!caller->type.isGeneric)
-            {
-                reWriterWrapper.LoadObj(caller->type.id);
-            }
-            else
+            if (caller->type.valueType)
             {
-                // Generic struct instrumentation is not supported
-                // IMetaDataImport::GetMemberProps and IMetaDataImport::GetMemberRefProps returns
-                // The parent token as mdTypeDef and not as a mdTypeSpec
-                // that's because the method definition is stored in the mdTypeDef
-                // The problem is that we don't have the exact Spec of that generic
-                // We can't emit LoadObj or Box because that would result in an invalid IL.
-                // This problem doesn't occur on a class type because we can always relay in the
-                // object type.
+                // Static methods in a ValueType can't be instrumented.
+                // In the future this can be supported by adding a local for the valuetype and initialize it to the default
+                // value. After the signature modification we need to emit the following IL to initialize and load into the
+                // stack.
+                //    ldloca.s [localIndex]
+                //    initobj [valueType]
+                //    ldloc.s [localIndex]
+                Logger::Warn("*** CallTarget_RewriterCallback(): Static methods in a ValueType cannot be instrumented. ");
                 return S_FALSE;
             }
+            reWriterWrapper.LoadNull();
         }
-    }
-
-    // *** Load the method arguments to the stack
-    unsigned elementType;
-    if (numArgs < FASTPATH_COUNT)
-    {
-        // Load the arguments directly (FastPath)
-        for (int i = 0; i < numArgs; i++)
+        else
         {
-            reWriterWrapper.LoadArgument(i + (isStatic ? 0 : 1));
-            auto argTypeFlags = methodArguments[i].GetTypeFlags(elementType);
-            if (argTypeFlags & TypeFlagByRef)
+            reWriterWrapper.LoadArgument(0);
+            if (caller->type.valueType)
             {
-                Logger::Warn("*** CallTarget_RewriterCallback(): Methods with ref parameters "
-                             "cannot be instrumented. ");
-                return S_FALSE;
+                if (caller->type.type_spec != mdTypeSpecNil)
+                {
+                    reWriterWrapper.LoadObj(caller->type.type_spec);
+                }
+                else if (!caller->type.isGeneric)
+                {
+                    reWriterWrapper.LoadObj(caller->type.id);
+                }
+                else
+                {
+                    // Generic struct instrumentation is not supported
+                    // IMetaDataImport::GetMemberProps and IMetaDataImport::GetMemberRefProps returns
+                    // The parent token as mdTypeDef and not as a mdTypeSpec
+                    // that's because the method definition is stored in the mdTypeDef
+                    // The problem is that we don't have the exact Spec of that generic
+                    // We can't emit LoadObj or Box because that would result in an invalid IL.
+                    // This problem doesn't occur on a class type because we can always relay in the
+                    // object type.
+                    return S_FALSE;
+                }
             }
         }
-    }
-    else
-    {
-        // Load the arguments inside an object array (SlowPath)
-        reWriterWrapper.CreateArray(callTargetTokens->GetObjectTypeRef(), numArgs);
-        for (int i = 0; i < numArgs; i++)
+
+        // *** Load the method arguments to the stack
+        unsigned elementType;
+        if (numArgs <= CallTargetTokens::GetFastPathMaxArguments())
         {
-            reWriterWrapper.BeginLoadValueIntoArray(i);
-            reWriterWrapper.LoadArgument(i + (isStatic ? 0 : 1));
-            auto argTypeFlags = methodArguments[i].GetTypeFlags(elementType);
-            if (argTypeFlags & TypeFlagByRef)
+            // Load the arguments directly (FastPath)
+            for (int i = 0; i < numArgs; i++)
             {
-                Logger::Warn("*** CallTarget_RewriterCallback(): Methods with ref parameters "
-                             "cannot be instrumented. ");
-                return S_FALSE;
+                reWriterWrapper.LoadArgument(i + (isStatic ? 0 : 1));
+                auto argTypeFlags = methodArguments[i].GetTypeFlags(elementType);
+                if (argTypeFlags & TypeFlagByRef)
+                {
+                    Logger::Warn("*** CallTarget_RewriterCallback(): Methods with ref parameters "
+                                 "cannot be instrumented. ");
+                    return S_FALSE;
+                }
             }
-            if (argTypeFlags & TypeFlagBoxedType)
+        }
+        else
+        {
+            // Load the arguments inside an object array (SlowPath)
+            reWriterWrapper.CreateArray(callTargetTokens->GetObjectTypeRef(), numArgs);
+            for (int i = 0; i < numArgs; i++)
             {
-                auto tok = methodArguments[i].GetTypeTok(metaEmit, callTargetTokens->GetCorLibAssemblyRef());
-                if (tok == mdTokenNil)
+                reWriterWrapper.BeginLoadValueIntoArray(i);
+                reWriterWrapper.LoadArgument(i + (isStatic ? 0 : 1));
+                auto argTypeFlags = methodArguments[i].GetTypeFlags(elementType);
+                if (argTypeFlags & TypeFlagByRef)
                 {
+                    Logger::Warn("*** CallTarget_RewriterCallback(): Methods with ref parameters "
+                                 "cannot be instrumented. ");
                     return S_FALSE;
                 }
-                reWriterWrapper.Box(tok);
+                if (argTypeFlags & TypeFlagBoxedType)
+                {
+                    auto tok = methodArguments[i].GetTypeTok(metaEmit, callTargetTokens->GetCorLibAssemblyRef());
+                    if (tok == mdTokenNil)
+                    {
+                        return S_FALSE;
+                    }
+                    reWriterWrapper.Box(tok);
+                }
+                reWriterWrapper.EndLoadValueIntoArray();
             }
-            reWriterWrapper.EndLoadValueIntoArray();
         }
-    }
 
-    // *** Emit BeginMethod call
-    if (Logger::IsDebugEnabled())
-    {
-        Logger::Debug("Caller Type.Id: ", HexStr(&caller->type.id, sizeof(mdToken)));
-        Logger::Debug("Caller Type.IsGeneric: ", caller->type.isGeneric);
-        Logger::Debug("Caller Type.IsValid: ", caller->type.IsValid());
-        Logger::Debug("Caller Type.Name: ", caller->type.name);
-        Logger::Debug("Caller Type.TokenType: ", caller->type.token_type);
-        Logger::Debug("Caller Type.Spec: ", HexStr(&caller->type.type_spec, sizeof(mdTypeSpec)));
-        Logger::Debug("Caller Type.ValueType: ", caller->type.valueType);
-        //
-        if (caller->type.extend_from != nullptr)
+        // *** Emit BeginMethod call
+        if (Logger::IsDebugEnabled())
+        {
+            Logger::Debug("Caller Type.Id: ", HexStr(&caller->type.id, sizeof(mdToken)));
+            Logger::Debug("Caller Type.IsGeneric: ", caller->type.isGeneric);
+            Logger::Debug("Caller Type.IsValid: ", caller->type.IsValid());
+            Logger::Debug("Caller Type.Name: ", caller->type.name);
+            Logger::Debug("Caller Type.TokenType: ", caller->type.token_type);
+            Logger::Debug("Caller Type.Spec: ", HexStr(&caller->type.type_spec, sizeof(mdTypeSpec)));
+            Logger::Debug("Caller Type.ValueType: ", caller->type.valueType);
+            //
+            if (caller->type.extend_from != nullptr)
+            {
+                Logger::Debug("Caller Type Extend From.Id: ", HexStr(&caller->type.extend_from->id, sizeof(mdToken)));
+                Logger::Debug("Caller Type Extend From.IsGeneric: ", caller->type.extend_from->isGeneric);
+                Logger::Debug("Caller Type Extend From.IsValid: ", caller->type.extend_from->IsValid());
+                Logger::Debug("Caller Type Extend From.Name: ", caller->type.extend_from->name);
+                Logger::Debug("Caller Type Extend From.TokenType: ", caller->type.extend_from->token_type);
+                Logger::Debug("Caller Type Extend From.Spec: ", HexStr(&caller->type.extend_from->type_spec, sizeof(mdTypeSpec)));
+                Logger::Debug("Caller Type Extend From.ValueType: ", caller->type.extend_from->valueType);
+            }
+            //
+            if (caller->type.parent_type != nullptr)
+            {
+                Logger::Debug("Caller ParentType.Id: ", HexStr(&caller->type.parent_type->id, sizeof(mdToken)));
+                Logger::Debug("Caller ParentType.IsGeneric: ", caller->type.parent_type->isGeneric);
+                Logger::Debug("Caller ParentType.IsValid: ", caller->type.parent_type->IsValid());
+                Logger::Debug("Caller ParentType.Name: ", caller->type.parent_type->name);
+                Logger::Debug("Caller ParentType.TokenType: ", caller->type.parent_type->token_type);
+                Logger::Debug("Caller ParentType.Spec: ", HexStr(&caller->type.parent_type->type_spec, sizeof(mdTypeSpec)));
+                Logger::Debug("Caller ParentType.ValueType: ", caller->type.parent_type->valueType);
+            }
+        }
+
+        ILInstr* beginCallInstruction;
+        hr = callTargetTokens->WriteBeginMethod(&reWriterWrapper, wrapper_type_ref, &caller->type, methodArguments,
+                                                &beginCallInstruction);
+        if (FAILED(hr))
         {
-            Logger::Debug("Caller Type Extend From.Id: ", HexStr(&caller->type.extend_from->id, sizeof(mdToken)));
-            Logger::Debug("Caller Type Extend From.IsGeneric: ", caller->type.extend_from->isGeneric);
-            Logger::Debug("Caller Type Extend From.IsValid: ", caller->type.extend_from->IsValid());
-            Logger::Debug("Caller Type Extend From.Name: ", caller->type.extend_from->name);
-            Logger::Debug("Caller Type Extend From.TokenType: ", caller->type.extend_from->token_type);
-            Logger::Debug("Caller Type Extend From.Spec: ", HexStr(&caller->type.extend_from->type_spec, sizeof(mdTypeSpec)));
-            Logger::Debug("Caller Type Extend From.ValueType: ", caller->type.extend_from->valueType);
+            // Error message is written to the log in WriteBeginMethod.
+            return S_FALSE;
         }
-        //
-        if (caller->type.parent_type != nullptr)
+        if (!writeEndMethod)
         {
-            Logger::Debug("Caller ParentType.Id: ", HexStr(&caller->type.parent_type->id, sizeof(mdToken)));
-            Logger::Debug("Caller ParentType.IsGeneric: ", caller->type.parent_type->isGeneric);
-            Logger::Debug("Caller ParentType.IsValid: ", caller->type.parent_type->IsValid());
-            Logger::Debug("Caller ParentType.Name: ", caller->type.parent_type->name);
-            Logger::Debug("Caller ParentType.TokenType: ", caller->type.parent_type->token_type);
-            Logger::Debug("Caller ParentType.Spec: ", HexStr(&caller->type.parent_type->type_spec, sizeof(mdTypeSpec)));
-            Logger::Debug("Caller ParentType.ValueType: ", caller->type.parent_type->valueType);
+            // *** BeginOnly: nothing reads the CallTargetState so it's discarded and the original method body
+            // runs right after the call. There are no new locals nor exception handling clauses, an exception
+            // thrown by the integration is not caught and reaches the caller.
+            reWriterWrapper.Pop();
+            return exportRewrittenMethod();
         }
-    }
 
-    ILInstr* beginCallInstruction;
-    hr = callTargetTokens->WriteBeginMethod(&reWriterWrapper, wrapper_type_ref, &caller->type, methodArguments,
-                                            &beginCallInstruction);
-    if (FAILED(hr))
-    {
-        // Error message is written to the log in WriteBeginMethod.
-        return S_FALSE;
-    }
-    reWriterWrapper.StLocal(callTargetStateIndex);
-    ILInstr* pStateLeaveToBeginOriginalMethodInstr = reWriterWrapper.CreateInstr(CEE_LEAVE_S);
+        reWriterWrapper.StLocal(callTargetStateIndex);
+        pStateLeaveToBeginOriginalMethodInstr = reWriterWrapper.CreateInstr(CEE_LEAVE_S);
 
-    // *** BeginMethod call catch
-    ILInstr* beginMethodCatchFirstInstr = nullptr;
-    callTargetTokens->WriteLogException(&reWriterWrapper, wrapper_type_ref, &caller->type, &beginMethodCatchFirstInstr);
-    ILInstr* beginMethodCatchLeaveInstr = reWriterWrapper.CreateInstr(CEE_LEAVE_S);
+        // *** BeginMethod call catch
+        ILInstr* beginMethodCatchFirstInstr = nullptr;
+        callTargetTokens->WriteLogException(&reWriterWrapper, wrapper_type_ref, &caller->type,
+                                            &beginMethodCatchFirstInstr);
+        beginMethodCatchLeaveInstr = reWriterWrapper.CreateInstr(CEE_LEAVE_S);
 
-    // *** BeginMethod exception handling clause
-    EHClause beginMethodExClause{};
-    beginMethodExClause.m_Flags = COR_ILEXCEPTION_CLAUSE_NONE;
-    beginMethodExClause.m_pTryBegin = firstInstruction;
-    beginMethodExClause.m_pTryEnd = beginMethodCatchFirstInstr;
-    beginMethodExClause.m_pHandlerBegin = beginMethodCatchFirstInstr;
-    beginMethodExClause.m_pHandlerEnd = beginMethodCatchLeaveInstr;
-    beginMethodExClause.m_ClassToken = callTargetTokens->GetExceptionTypeRef();
+        // *** BeginMethod exception handling clause
+        beginMethodExClause.m_Flags = COR_ILEXCEPTION_CLAUSE_NONE;
+        beginMethodExClause.m_pTryBegin = firstInstruction;
+        beginMethodExClause.m_pTryEnd = beginMethodCatchFirstInstr;
+        beginMethodExClause.m_pHandlerBegin = beginMethodCatchFirstInstr;
+        beginMethodExClause.m_pHandlerEnd = beginMethodCatchLeaveInstr;
+        beginMethodExClause.m_ClassToken = callTargetTokens->GetExceptionTypeRef();
+    }
 
     // ***
     // METHOD EXECUTION
     // ***
     ILInstr* beginOriginalMethodInstr = reWriterWrapper.GetCurrentILInstr();
-    pStateLeaveToBeginOriginalMethodInstr->m_pTarget = beginOriginalMethodInstr;
-    beginMethodCatchLeaveInstr->m_pTarget = beginOriginalMethodInstr;
+    if (writeBeginMethod)
+    {
+        pStateLeaveToBeginOriginalMethodInstr->m_pTarget = beginOriginalMethodInstr;
+        beginMethodCatchLeaveInstr->m_pTarget = beginOriginalMethodInstr;
+    }
 
     // ***
     // ENDING OF THE METHOD EXECUTION
@@ -3664,9 +4404,15 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
     // ***
     // EXCEPTION CATCH
     // ***
-    ILInstr* startExceptionCatch = reWriterWrapper.StLocal(exceptionIndex);
-    reWriterWrapper.SetILPosition(methodReturnInstr);
-    ILInstr* rethrowInstr = reWriterWrapper.Rethrow();
+    // *** EndOnly: nothing reads the exception, there is no catch/rethrow and the finally block runs alone
+    ILInstr* startExceptionCatch = nullptr;
+    ILInstr* rethrowInstr = nullptr;
+    if (writeBeginMethod)
+    {
+        startExceptionCatch = reWriterWrapper.StLocal(exceptionIndex);
+        reWriterWrapper.SetILPosition(methodReturnInstr);
+        rethrowInstr = reWriterWrapper.Rethrow();
+    }
 
     // ***
     // EXCEPTION FINALLY / END METHOD PART
@@ -3726,8 +4472,26 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
         reWriterWrapper.LoadLocal(returnValueIndex);
     }
 
-    reWriterWrapper.LoadLocal(exceptionIndex);
-    reWriterWrapper.LoadLocal(callTargetStateIndex);
+    if (writeBeginMethod)
+    {
+        reWriterWrapper.LoadLocal(exceptionIndex);
+        reWriterWrapper.LoadLocal(callTargetStateIndex);
+    }
+    else
+    {
+        // *** EndOnly: there is no BeginMethod to create a state and the exception is not caught, EndMethod
+        // receives a null exception and CallTargetState.GetDefault()
+        reWriterWrapper.LoadNull();
+        ILInstr* callTargetStateGetDefaultInstr;
+        hr = callTargetTokens->WriteCallTargetStateGetDefault(&reWriterWrapper, &callTargetStateGetDefaultInstr);
+        if (FAILED(hr))
+        {
+            Logger::Warn("*** CallTarget_RewriterCallback(): CallTargetState.GetDefault() could not be written "
+                         "for ModuleID=",
+                         module_id, " ", function_token);
+            return S_FALSE;
+        }
+    }
 
     ILInstr* endMethodCallInstr;
     if (isVoid)
@@ -3740,7 +4504,15 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
         callTargetTokens->WriteEndReturnMemberRef(&reWriterWrapper, wrapper_type_ref, &caller->type, &retFuncArg,
                                                   &endMethodCallInstr);
     }
-    reWriterWrapper.StLocal(callTargetReturnIndex);
+    if (callTargetReturnIndex != static_cast<ULONG>(ULONG_MAX))
+    {
+        reWriterWrapper.StLocal(callTargetReturnIndex);
+    }
+    else
+    {
+        // *** EndOnly void methods don't keep the CallTargetReturn
+        reWriterWrapper.Pop();
+    }
 
     if (!isVoid)
     {
@@ -3818,8 +4590,8 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
     EHClause finallyClause{};
     finallyClause.m_Flags = COR_ILEXCEPTION_CLAUSE_FINALLY;
     finallyClause.m_pTryBegin = firstInstruction;
-    finallyClause.m_pTryEnd = rethrowInstr->m_pNext;
-    finallyClause.m_pHandlerBegin = rethrowInstr->m_pNext;
+    finallyClause.m_pTryEnd = endMethodTryStartInstr;
+    finallyClause.m_pHandlerBegin = endMethodTryStartInstr;
     finallyClause.m_pHandlerEnd = endFinallyInstr;
 
     // ***
@@ -3833,34 +4605,152 @@ HRESULT CorProfiler::CallTarget_RewriterCallback(RejitHandlerModule* moduleHandl
         newEHClauses[i] = ehPointer[i];
     }
 
-    // *** Add the new EH clauses
-    ehCount += 4;
-    newEHClauses[ehCount - 4] = beginMethodExClause;
-    newEHClauses[ehCount - 3] = endMethodExClause;
-    newEHClauses[ehCount - 2] = exClause;
-    newEHClauses[ehCount - 1] = finallyClause;
+    // *** Add the new EH clauses, EndOnly methods don't get the BeginMethod catch nor the catch/rethrow
+    if (writeBeginMethod)
+    {
+        newEHClauses[ehCount++] = beginMethodExClause;
+    }
+    newEHClauses[ehCount++] = endMethodExClause;
+    if (writeBeginMethod)
+    {
+        newEHClauses[ehCount++] = exClause;
+    }
+    newEHClauses[ehCount++] = finallyClause;
     rewriter.SetEHClause(newEHClauses, ehCount);
 
-    if (dump_il_rewrite_enabled)
+    return exportRewrittenMethod();
+}
+
+//
+// Control channel methods
+//
+void CorProfiler::StartControlChannel()
+{
+    const auto path = GetEnvironmentValue(environment::control_channel_path);
+    if (path.empty())
     {
-        Logger::Info(original_code);
-        Logger::Info(GetILCodes("*** CallTarget_RewriterCallback(): Modified Code: ", &rewriter, *caller, module_metadata));
+        return;
     }
 
-    hr = rewriter.Export();
+    control_channel_ = std::make_unique<ControlChannel>(
+        ToString(path), [this](const std::string& request) { return this->HandleControlRequest(request); });
+    if (!control_channel_->Start())
+    {
+        Logger::Warn("Control channel could not be started on: ", path);
+        control_channel_ = nullptr;
+    }
+}
 
-    if (FAILED(hr))
+std::string CorProfiler::HandleControlRequest(const std::string& request)
+{
+    const auto separator = request.find(' ');
+    const auto command = request.substr(0, separator);
+    const auto argument = separator == std::string::npos ? std::string() : request.substr(separator + 1);
+
+    Logger::Debug("Control channel request: ", request);
+
+    if (command == "stats")
     {
-        Logger::Warn("*** CallTarget_RewriterCallback(): Call to ILRewriter.Export() failed for "
-                     "ModuleID=",
-                     module_id, " ", function_token);
-        return S_FALSE;
+        return Stats::Instance()->ToString() + "\n";
     }
 
-    Logger::Info("*** CallTarget_RewriterCallback() Finished: ", caller->type.name, ".", caller->name, "() [IsVoid=", isVoid,
-                 ", IsStatic=", isStatic, ", IntegrationType=", method_replacement->wrapper_method.type_name,
-                 ", Arguments=", numArgs, "]");
-    return S_OK;
+    if (command == "histogram")
+    {
+        return Stats::Instance()->HistogramsToString();
+    }
+
+    if (command == "gc")
+    {
+        if (gc_metrics_ == nullptr)
+        {
+            return "error: native gc metrics are not enabled\n";
+        }
+        return gc_metrics_->ToString();
+    }
+
+    if (command == "events")
+    {
+        if (event_pipe_consumer_ == nullptr)
+        {
+            return "error: native eventpipe consumer is not enabled\n";
+        }
+        return event_pipe_consumer_->ToString();
+    }
+
+    if (command == "exceptions")
+    {
+        if (exception_metrics_ == nullptr)
+        {
+            return "error: native exception metrics are not enabled\n";
+        }
+
+        const auto count =
+            argument.empty() ? exception_metrics_default_top_count : std::strtoul(argument.c_str(), nullptr, 10);
+        if (count == 0)
+        {
+            return "error: expected 'exceptions [count]'\n";
+        }
+        return exception_metrics_->ToString(count, &exception_rates_control_channel_);
+    }
+
+    if (command == "methods")
+    {
+        if (rejit_handler == nullptr)
+        {
+            return "error: calltarget is not enabled\n";
+        }
+        return rejit_handler->InstrumentedMethodsToString();
+    }
+
+    if (command == "loglevel")
+    {
+        if (argument == "debug")
+        {
+            Logger::EnableDebug();
+        }
+        else if (argument == "info")
+        {
+            Logger::DisableDebug();
+        }
+        else
+        {
+            return "error: expected 'loglevel debug' or 'loglevel info'\n";
+        }
+        return "ok\n";
+    }
+
+    if (command == "dumpil")
+    {
+        if (argument.empty())
+        {
+            return "error: expected 'dumpil <Type.Method>'\n";
+        }
+
+        const auto methodName = ToWSTRING(argument);
+        {
+            std::lock_guard<std::mutex> guard(dump_il_methods_lock_);
+            dump_il_methods_.insert(methodName);
+            has_dump_il_methods_ = true;
+        }
+
+        // Rewrite the already instrumented methods again so the IL is dumped now.
+        const auto count = rejit_handler != nullptr ? rejit_handler->RequestRejitForMethod(methodName) : 0;
+        return "ok " + std::to_string(count) + "\n";
+    }
+
+    return "commands: stats | histogram | gc | events | exceptions [count] | methods | loglevel <debug|info> | "
+           "dumpil <Type.Method>\n";
+}
+
+bool CorProfiler::IsDumpILRequested(const FunctionInfo& caller)
+{
+    if (!has_dump_il_methods_)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(dump_il_methods_lock_);
+    return dump_il_methods_.find(caller.type.name + WStr(".") + caller.name) != dump_il_methods_.end();
 }
 
-} // namespace trace
\ No newline at end of file
+} // namespace trace
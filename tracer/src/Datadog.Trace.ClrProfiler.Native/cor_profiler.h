@@ -4,18 +4,28 @@
 #include "cor.h"
 #include "corprof.h"
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "control_channel.h"
 #include "cor_profiler_base.h"
 #include "environment_variables.h"
+#include "event_pipe_consumer.h"
+#include "exception_metrics.h"
+#include "gc_metrics.h"
+#include "il_flight_recorder.h"
 #include "il_rewriter.h"
 #include "integration.h"
+#include "managed_loader_image.h"
+#include "module_id_list.h"
 #include "module_metadata.h"
 #include "pal.h"
+#include "precompiled_code_index.h"
 #include "rejit_handler.h"
+#include "span_flusher.h"
 
 namespace trace
 {
@@ -34,6 +44,7 @@ private:
     bool first_jit_compilation_completed = false;
 
     bool instrument_domain_neutral_assemblies = false;
+    bool il_compact_encoding_enabled = true;
     bool corlib_module_loaded = false;
     AppDomainID corlib_app_domain_id = 0;
     bool managed_profiler_loaded_domain_neutral = false;
@@ -48,6 +59,59 @@ private:
     //
     RejitHandler* rejit_handler = nullptr;
 
+    // ModuleInfo of the loaded modules
+    ModuleInfoCache module_info_cache_;
+
+    // Decoded signatures of the CallTarget candidate methods
+    MethodSignatureCache method_signature_cache_;
+
+    // Methods that must be JIT compiled even when NGEN/ReadyToRun code is available
+    PrecompiledCodeIndex precompiled_code_index_;
+
+    //
+    // Control channel
+    //
+    std::unique_ptr<ControlChannel> control_channel_;
+    std::mutex dump_il_methods_lock_;
+    std::unordered_set<WSTRING> dump_il_methods_;
+    std::atomic_bool has_dump_il_methods_ = {false};
+
+    //
+    // IL flight recorder
+    //
+    std::unique_ptr<ILFlightRecorder> il_flight_recorder_;
+
+    //
+    // Native span buffer
+    //
+    std::unique_ptr<SpanFlusher> span_flusher_;
+
+    //
+    // Native GC metrics
+    //
+    std::unique_ptr<GCMetrics> gc_metrics_;
+
+    //
+    // Native EventPipe consumer
+    //
+    std::unique_ptr<EventPipeConsumer> event_pipe_consumer_;
+
+    //
+    // Native exception metrics
+    //
+    std::unique_ptr<ExceptionMetrics> exception_metrics_;
+    // Rates of the "exceptions" control channel command, only used on the control channel thread
+    ExceptionRateBaseline exception_rates_control_channel_;
+
+    //
+    // Managed loader image, shared by the startup hook of every AppDomain
+    //
+    std::once_flag managed_loader_once_;
+    std::unique_ptr<ManagedLoaderImage> managed_loader_assembly_;
+    std::unique_ptr<ManagedLoaderImage> managed_loader_symbols_;
+    std::mutex startup_hook_lock_;
+    std::unordered_map<AppDomainID, std::chrono::steady_clock::time_point> startup_hook_start_times_;
+
     // Cor assembly properties
     AssemblyProperty corAssemblyProperty{};
     AssemblyReference* managed_profiler_assembly_reference;
@@ -62,7 +126,7 @@ private:
     //
     std::mutex module_id_to_info_map_lock_;
     std::unordered_map<ModuleID, ModuleMetadata*> module_id_to_info_map_;
-    std::vector<ModuleID> module_ids_;
+    ModuleIdList module_ids_;
 
     //
     // Helper methods
@@ -80,8 +144,12 @@ private:
                                   const ModuleID module_id, const mdToken function_token, const FunctionInfo& caller,
                                   const std::vector<MethodReplacement> method_replacements);
     bool ProfilerAssemblyIsLoadedIntoAppDomain(AppDomainID app_domain_id);
+    bool IsStartupHookCallSiteModule(const WSTRING& assembly_name) const;
     std::string GetILCodes(const std::string& title, ILRewriter* rewriter, const FunctionInfo& caller,
                            ModuleMetadata* module_metadata);
+    void StartILFlightRecorder();
+    void RecordILRewrite(ILFlightRecorderRewriteKind kind, HRESULT hr, ModuleID module_id, mdToken function_token,
+                         const FunctionInfo& caller, ILRewriter* rewriter, ModuleMetadata* module_metadata);
     //
     // Startup methods
     //
@@ -94,13 +162,38 @@ private:
     //
     HRESULT CallTarget_RewriterCallback(RejitHandlerModule* moduleHandler, RejitHandlerModuleMethod* methodHandler);
 
+    //
+    // Control channel methods
+    //
+    void StartControlChannel();
+    bool IsDumpILRequested(const FunctionInfo& caller);
+
+    //
+    // Native span buffer methods
+    //
+    void StartSpanFlusher();
+
+    //
+    // Native EventPipe consumer methods
+    //
+    void StartEventPipeConsumer();
+
+    //
+    // Managed loader methods
+    //
+    void GetEmbeddedManagedLoader(BYTE** pAssemblyArray, int* assemblySize, BYTE** pSymbolsArray,
+                                  int* symbolsSize) const;
+
 public:
     CorProfiler() = default;
 
     bool IsAttached() const;
 
     void GetAssemblyAndSymbolsBytes(BYTE** pAssemblyArray, int* assemblySize, BYTE** pSymbolsArray,
-                                    int* symbolsSize) const;
+                                    int* symbolsSize);
+
+    // Answers a control channel request, called on the channel thread
+    std::string HandleControlRequest(const std::string& request);
 
     //
     // ICorProfilerCallback methods
@@ -140,6 +233,40 @@ public:
 
     HRESULT STDMETHODCALLTYPE JITCachedFunctionSearchStarted(FunctionID functionId, BOOL* pbUseCachedFunction) override;
 
+    //
+    // GC methods
+    //
+    HRESULT STDMETHODCALLTYPE RuntimeSuspendStarted(COR_PRF_SUSPEND_REASON suspendReason) override;
+
+    HRESULT STDMETHODCALLTYPE RuntimeSuspendAborted() override;
+
+    HRESULT STDMETHODCALLTYPE RuntimeResumeFinished() override;
+
+    HRESULT STDMETHODCALLTYPE GarbageCollectionStarted(int cGenerations, BOOL generationCollected[],
+                                                       COR_PRF_GC_REASON reason) override;
+
+    HRESULT STDMETHODCALLTYPE GarbageCollectionFinished() override;
+
+    //
+    // Exception methods
+    //
+    HRESULT STDMETHODCALLTYPE ExceptionThrown(ObjectID thrownObjectId) override;
+
+    HRESULT STDMETHODCALLTYPE ExceptionSearchFunctionEnter(FunctionID functionId) override;
+
+    HRESULT STDMETHODCALLTYPE ExceptionUnwindFunctionLeave() override;
+
+    HRESULT STDMETHODCALLTYPE ExceptionCatcherEnter(FunctionID functionId, ObjectID objectId) override;
+
+    //
+    // ICorProfilerCallback10 methods
+    //
+    HRESULT STDMETHODCALLTYPE EventPipeEventDelivered(EVENTPIPE_PROVIDER provider, DWORD eventId, DWORD eventVersion,
+                                                      ULONG cbMetadataBlob, LPCBYTE metadataBlob, ULONG cbEventData,
+                                                      LPCBYTE eventData, LPCGUID pActivityId,
+                                                      LPCGUID pRelatedActivityId, ThreadID eventThread,
+                                                      ULONG numStackFrames, UINT_PTR stackFrames[]) override;
+
     //
     // ICorProfilerCallback6 methods
     //
@@ -150,6 +277,28 @@ public:
     // Add Integrations methods
     //
     void InitializeProfiler(WCHAR* id, CallTargetDefinition* items, int size);
+
+    //
+    // Enable / Disable integrations at runtime
+    //
+    ULONG SetIntegrationEnabled(WCHAR* integrationName, BOOL enabled);
+    ULONG GetIntegrationRewrittenMethodCount(WCHAR* integrationName);
+
+    //
+    // Native span buffer
+    //
+    HRESULT EnqueueSpans(const BYTE* buffer, int size);
+    HRESULT FlushSpans(int timeout_ms);
+
+    //
+    // Native GC metrics
+    //
+    HRESULT GetGCMetrics(GCMetricsSnapshot* snapshot, int size) const;
+
+    //
+    // Native EventPipe consumer
+    //
+    HRESULT GetRuntimeEventMetrics(RuntimeEventMetricsSnapshot* snapshot, int size) const;
 };
 
 // Note: Generally you should not have a single, global callback implementation,
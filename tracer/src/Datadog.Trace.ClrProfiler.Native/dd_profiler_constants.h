@@ -27,8 +27,22 @@ const WSTRING env_vars_to_display[]{environment::tracing_enabled,
                                     environment::clr_disable_optimizations,
                                     environment::clr_enable_inlining,
                                     environment::clr_enable_ngen,
+                                    environment::clr_enable_rejit_with_inliners,
+                                    environment::calltarget_fastpath_max_arguments,
                                     environment::domain_neutral_instrumentation,
                                     environment::dump_il_rewrite_enabled,
+                                    environment::il_compact_encoding_enabled,
+                                    environment::il_flight_recorder_enabled,
+                                    environment::il_flight_recorder_size,
+                                    environment::span_buffer_output,
+                                    environment::span_buffer_size,
+                                    environment::span_buffer_batch_size,
+                                    environment::span_buffer_record_size,
+                                    environment::span_buffer_flush_interval,
+                                    environment::native_gc_metrics_enabled,
+                                    environment::native_eventpipe_enabled,
+                                    environment::native_eventpipe_providers,
+                                    environment::native_exception_metrics_enabled,
                                     environment::netstandard_enabled,
                                     environment::azure_app_services,
                                     environment::azure_app_services_app_pool_id,
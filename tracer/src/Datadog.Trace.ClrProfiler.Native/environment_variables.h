@@ -121,9 +121,67 @@ namespace environment
     // Custom internal tracer profiler path
     const WSTRING internal_trace_profiler_path = WStr("DD_INTERNAL_TRACE_NATIVE_ENGINE_PATH");
 
-    // Sets whether to enable NGEN images.
+    // Sets whether to use NGEN/ReadyToRun images. Default is true, only the CallTarget targets, their inliners
+    // and the startup hook call sites are JIT compiled. Set to false to JIT compile every method.
     const WSTRING clr_enable_ngen = WStr("DD_CLR_ENABLE_NGEN");
 
+    // Sets whether ReJIT requests use RequestReJITWithInliners on the runtimes where it is known to work,
+    // instead of vetoing the inlining of every instrumented method. Default is false: a runtime that crashes
+    // in RequestReJITWithInliners can't be detected by the self-test or by the failed request.
+    const WSTRING clr_enable_rejit_with_inliners = WStr("DD_CLR_ENABLE_REJIT_WITH_INLINERS");
+
+    // Sets the number of arguments up to which CallTarget calls the fixed-arity BeginMethod
+    // overloads instead of boxing the arguments into an object array. Default and maximum is 16.
+    const WSTRING calltarget_fastpath_max_arguments = WStr("DD_TRACE_CALLTARGET_FASTPATH_MAX_ARGUMENTS");
+
+    // Sets whether instrumented method bodies are exported with the shortest IL encoding
+    // (short branches, macro opcodes, tiny headers). Default is true.
+    const WSTRING il_compact_encoding_enabled = WStr("DD_TRACE_IL_COMPACT_ENCODING_ENABLED");
+
+    // Enables the IL flight recorder: a fixed-size memory mapped ring next to the native log file that
+    // keeps the raw IL, EH clauses and local signatures of the last rewrites. Default is false.
+    const WSTRING il_flight_recorder_enabled = WStr("DD_TRACE_IL_FLIGHT_RECORDER_ENABLED");
+
+    // Size in bytes of the IL flight recorder ring. Default is 4 MB.
+    const WSTRING il_flight_recorder_size = WStr("DD_TRACE_IL_FLIGHT_RECORDER_SIZE");
+
+    // Path of the local control channel (Unix domain socket or named pipe name).
+    // The channel is only started when this is set.
+    const WSTRING control_channel_path = WStr("DD_TRACE_CONTROL_CHANNEL_PATH");
+
+    // Destination of the spans handed to the native span buffer: "file:<path>" or "unix:<path>" (agent socket).
+    // The buffer and its flush thread are only started when this is set.
+    const WSTRING span_buffer_output = WStr("DD_TRACE_SPAN_BUFFER_OUTPUT");
+
+    // Number of span buffer records the native span buffer holds before dropping. Default is 4096.
+    const WSTRING span_buffer_size = WStr("DD_TRACE_SPAN_BUFFER_SIZE");
+
+    // Number of records that triggers a flush of the native span buffer. Default is 256.
+    const WSTRING span_buffer_batch_size = WStr("DD_TRACE_SPAN_BUFFER_BATCH_SIZE");
+
+    // Size in bytes of the largest span buffer record the native span buffer accepts, larger records are
+    // dropped. Every slot is allocated this size upfront (4096 x 8 KB by default). Default is 8192.
+    const WSTRING span_buffer_record_size = WStr("DD_TRACE_SPAN_BUFFER_RECORD_SIZE");
+
+    // Maximum time in milliseconds between two flushes of the native span buffer. Default is 1000.
+    const WSTRING span_buffer_flush_interval = WStr("DD_TRACE_SPAN_BUFFER_FLUSH_INTERVAL");
+
+    // Enables the native GC metrics fed by the profiler GC callbacks (collections, pauses, heap sizes).
+    // Requires a runtime supporting COR_PRF_HIGH_BASIC_GC. Default is false.
+    const WSTRING native_gc_metrics_enabled = WStr("DD_TRACE_NATIVE_GC_METRICS_ENABLED");
+
+    // Enables the in-process EventPipe session aggregating runtime events (contention, thread pool, exceptions)
+    // natively. Requires .NET 5+. Default is false.
+    const WSTRING native_eventpipe_enabled = WStr("DD_TRACE_NATIVE_EVENTPIPE_ENABLED");
+
+    // Providers of the native EventPipe session, as "Provider[:Keywords[:Level]]" separated by commas.
+    // Default is the runtime provider with the contention, exception and threading keywords.
+    const WSTRING native_eventpipe_providers = WStr("DD_TRACE_NATIVE_EVENTPIPE_PROVIDERS");
+
+    // Enables the native first-chance exception counters, by exception type and throwing function, fed by the
+    // profiler exception callbacks. Default is false.
+    const WSTRING native_exception_metrics_enabled = WStr("DD_TRACE_NATIVE_EXCEPTION_METRICS_ENABLED");
+
 } // namespace environment
 } // namespace trace
 
@@ -69,7 +69,12 @@ bool IsCallTargetEnabled(bool defaultValue) {
 
 bool IsNGENEnabled()
 {
-    ToBooleanWithDefault(GetEnvironmentValue(environment::clr_enable_ngen), false);
+    ToBooleanWithDefault(GetEnvironmentValue(environment::clr_enable_ngen), true);
+}
+
+bool IsRejitWithInlinersEnabled()
+{
+    ToBooleanWithDefault(GetEnvironmentValue(environment::clr_enable_rejit_with_inliners), false);
 }
 
 bool IsDebugEnabled()
@@ -82,6 +87,31 @@ bool IsDumpILRewriteEnabled()
     CheckIfTrue(GetEnvironmentValue(environment::dump_il_rewrite_enabled));
 }
 
+bool IsILCompactEncodingEnabled()
+{
+    ToBooleanWithDefault(GetEnvironmentValue(environment::il_compact_encoding_enabled), true);
+}
+
+bool IsILFlightRecorderEnabled()
+{
+    CheckIfTrue(GetEnvironmentValue(environment::il_flight_recorder_enabled));
+}
+
+bool IsNativeGCMetricsEnabled()
+{
+    CheckIfTrue(GetEnvironmentValue(environment::native_gc_metrics_enabled));
+}
+
+bool IsNativeEventPipeEnabled()
+{
+    CheckIfTrue(GetEnvironmentValue(environment::native_eventpipe_enabled));
+}
+
+bool IsNativeExceptionMetricsEnabled()
+{
+    CheckIfTrue(GetEnvironmentValue(environment::native_exception_metrics_enabled));
+}
+
 bool IsTracingDisabled()
 {
     CheckIfFalse(GetEnvironmentValue(environment::tracing_enabled));
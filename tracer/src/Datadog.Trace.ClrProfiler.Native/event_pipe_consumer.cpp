@@ -0,0 +1,569 @@
+#include "event_pipe_consumer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "logger.h"
+#include "util.h"
+
+namespace trace
+{
+
+// Exception types beyond this are counted under a single entry
+const size_t runtime_event_max_exception_types = 256;
+
+// Exception types listed by ToString
+const size_t runtime_event_top_exception_types = 10;
+
+const WSTRING runtime_event_other_exception_types = WStr("(other)");
+
+namespace
+{
+    uint64_t NowNanoseconds()
+    {
+        return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // Payloads are little endian and not aligned
+    template <typename T>
+    bool ReadValue(const BYTE* data, ULONG size, ULONG* offset, T* value)
+    {
+        if (size < sizeof(T) || *offset > size - sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(value, data + *offset, sizeof(T));
+        *offset += sizeof(T);
+        return true;
+    }
+
+    // Reads a null-terminated UTF-16 string, copying at most capacity characters of it
+    bool ReadString(const BYTE* data, ULONG size, ULONG* offset, WCHAR* buffer, uint32_t capacity, uint32_t* length)
+    {
+        uint32_t copied = 0;
+        uint16_t character = 0;
+        while (ReadValue(data, size, offset, &character))
+        {
+            if (character == 0)
+            {
+                if (length != nullptr)
+                {
+                    *length = copied;
+                }
+                return true;
+            }
+            if (buffer != nullptr && copied < capacity)
+            {
+                buffer[copied++] = (WCHAR) character;
+            }
+        }
+        return false;
+    }
+} // namespace
+
+bool ParseRuntimeEvent(DWORD eventId, DWORD eventVersion, const BYTE* data, ULONG size, RuntimeEvent* event)
+{
+    ULONG offset = 0;
+    event->worker_count = 0;
+    event->reason = 0;
+    event->type_name_length = 0;
+    event->duration_ns = 0;
+    event->throughput = 0;
+
+    switch (eventId)
+    {
+        case runtime_event_contention_start_id:
+        {
+            // ContentionFlags, ClrInstanceID, and the lock ids in version 2
+            event->kind = RuntimeEventKind::ContentionStart;
+            return size >= 3;
+        }
+        case runtime_event_contention_stop_id:
+        {
+            // ContentionFlags, ClrInstanceID, and DurationNs in version 1
+            event->kind = RuntimeEventKind::ContentionStop;
+            uint8_t flags = 0;
+            uint16_t clrInstanceId = 0;
+            if (!ReadValue(data, size, &offset, &flags) || !ReadValue(data, size, &offset, &clrInstanceId))
+            {
+                return false;
+            }
+            double durationNs = 0;
+            if (eventVersion >= 1 && ReadValue(data, size, &offset, &durationNs) && durationNs > 0)
+            {
+                event->duration_ns = (uint64_t) durationNs;
+            }
+            return true;
+        }
+        case runtime_event_threadpool_worker_start_id:
+        case runtime_event_threadpool_worker_stop_id:
+        case runtime_event_threadpool_worker_wait_id:
+        {
+            // ActiveWorkerThreadCount, RetiredWorkerThreadCount, ClrInstanceID
+            event->kind = RuntimeEventKind::ThreadPoolWorkerWait;
+            if (eventId == runtime_event_threadpool_worker_start_id)
+            {
+                event->kind = RuntimeEventKind::ThreadPoolWorkerStart;
+            }
+            else if (eventId == runtime_event_threadpool_worker_stop_id)
+            {
+                event->kind = RuntimeEventKind::ThreadPoolWorkerStop;
+            }
+            return ReadValue(data, size, &offset, &event->worker_count);
+        }
+        case runtime_event_threadpool_adjustment_id:
+        {
+            // AverageThroughput, NewWorkerThreadCount, Reason, ClrInstanceID
+            event->kind = RuntimeEventKind::ThreadPoolAdjustment;
+            return ReadValue(data, size, &offset, &event->throughput) &&
+                   ReadValue(data, size, &offset, &event->worker_count) &&
+                   ReadValue(data, size, &offset, &event->reason);
+        }
+        case runtime_event_exception_thrown_id:
+        {
+            // ExceptionType, ExceptionMessage, ExceptionEIP, ExceptionHRESULT, ExceptionFlags, ClrInstanceID
+            event->kind = RuntimeEventKind::ExceptionThrown;
+            void* eip = nullptr;
+            return eventVersion >= 1 &&
+                   ReadString(data, size, &offset, event->type_name, runtime_event_type_name_length,
+                              &event->type_name_length) &&
+                   ReadString(data, size, &offset, nullptr, 0, nullptr) && ReadValue(data, size, &offset, &eip) &&
+                   ReadValue(data, size, &offset, &event->reason);
+        }
+        default:
+            return false;
+    }
+}
+
+bool ParseEventPipeProviders(const WSTRING& value, std::vector<EventPipeProviderOptions>* providers)
+{
+    providers->clear();
+
+    const auto trimmed = Trim(value);
+    if (trimmed.empty())
+    {
+        providers->push_back({runtime_event_provider_name,
+                              runtime_event_contention_keyword | runtime_event_exception_keyword |
+                                  runtime_event_threading_keyword,
+                              runtime_event_default_level});
+        return true;
+    }
+
+    for (auto&& entry : Split(trimmed, ','))
+    {
+        const auto parts = Split(Trim(entry), ':');
+        if (parts.empty() || parts.size() > 3 || Trim(parts[0]).empty())
+        {
+            return false;
+        }
+
+        EventPipeProviderOptions provider{Trim(parts[0]), UINT64_MAX, runtime_event_default_level};
+        try
+        {
+            if (parts.size() > 1 && !Trim(parts[1]).empty())
+            {
+                size_t end = 0;
+                const auto keywords = ToString(Trim(parts[1]));
+                provider.keywords = std::stoull(keywords, &end, 16);
+                if (end != keywords.size())
+                {
+                    return false;
+                }
+            }
+            if (parts.size() > 2 && !Trim(parts[2]).empty())
+            {
+                size_t end = 0;
+                const auto level = ToString(Trim(parts[2]));
+                provider.level = (uint32_t) std::stoul(level, &end, 10);
+                if (end != level.size() || provider.level > 5)
+                {
+                    return false;
+                }
+            }
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        providers->push_back(provider);
+    }
+
+    return true;
+}
+
+EventPipeConsumer::EventPipeConsumer(ICorProfilerInfo12* info, const EventPipeConsumerOptions& options) :
+    m_info(info), m_options(options), m_queue(options.capacity, sizeof(RuntimeEvent), sizeof(RuntimeEvent))
+{
+    if (m_options.batch_size == 0)
+    {
+        m_options.batch_size = 1;
+    }
+    m_batch.resize(m_options.batch_size);
+}
+
+EventPipeConsumer::~EventPipeConsumer()
+{
+    Stop();
+}
+
+HRESULT EventPipeConsumer::Start()
+{
+    if (m_running)
+    {
+        return S_FALSE;
+    }
+
+    m_running = true;
+    m_thread = std::make_unique<std::thread>(AggregationThreadLoop, this);
+
+    if (m_info == nullptr)
+    {
+        return S_OK;
+    }
+
+    // The provider names must outlive the call
+    std::vector<COR_PRF_EVENTPIPE_PROVIDER_CONFIG> configs;
+    for (auto&& provider : m_options.providers)
+    {
+        configs.push_back({provider.name.c_str(), provider.keywords, provider.level, nullptr});
+    }
+
+    const HRESULT hr = m_info->EventPipeStartSession((UINT32) configs.size(), configs.data(), FALSE, &m_session);
+    if (FAILED(hr))
+    {
+        m_session = 0;
+        Stop();
+    }
+    return hr;
+}
+
+void EventPipeConsumer::Stop()
+{
+    if (m_session != 0 && m_info != nullptr)
+    {
+        m_info->EventPipeStopSession(m_session);
+        m_session = 0;
+    }
+
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_wake_condition.notify_one();
+    }
+
+    if (m_thread != nullptr && m_thread->joinable())
+    {
+        m_thread->join();
+    }
+    m_thread = nullptr;
+}
+
+bool EventPipeConsumer::IsRunning() const
+{
+    return m_running;
+}
+
+bool EventPipeConsumer::IsRuntimeProvider(EVENTPIPE_PROVIDER provider)
+{
+    const auto runtimeProvider = m_runtime_provider.load(std::memory_order_relaxed);
+    if (runtimeProvider != 0)
+    {
+        return provider == runtimeProvider;
+    }
+
+    for (auto&& other : m_other_providers)
+    {
+        const auto otherProvider = other.load(std::memory_order_relaxed);
+        if (otherProvider == provider)
+        {
+            return false;
+        }
+        if (otherProvider == 0)
+        {
+            break;
+        }
+    }
+
+    if (m_info == nullptr)
+    {
+        return false;
+    }
+
+    WCHAR name[128];
+    ULONG length = 0;
+    if (FAILED(m_info->EventPipeGetProviderInfo(provider, 128, &length, name)))
+    {
+        return false;
+    }
+
+    // length includes the null terminator
+    if (length == runtime_event_provider_name.size() + 1 &&
+        runtime_event_provider_name.compare(0, runtime_event_provider_name.size(), name,
+                                            runtime_event_provider_name.size()) == 0)
+    {
+        m_runtime_provider = provider;
+        return true;
+    }
+
+    // Remembered so the name is only resolved once, unless the cache is full
+    for (auto&& other : m_other_providers)
+    {
+        EVENTPIPE_PROVIDER expected = 0;
+        if (other.compare_exchange_strong(expected, provider) || expected == provider)
+        {
+            break;
+        }
+    }
+    return false;
+}
+
+void EventPipeConsumer::OnEventDelivered(EVENTPIPE_PROVIDER provider, DWORD eventId, DWORD eventVersion,
+                                         const BYTE* data, ULONG size, ThreadID thread)
+{
+    if (!IsRuntimeProvider(provider))
+    {
+        m_events_ignored++;
+        return;
+    }
+
+    OnRuntimeEvent(eventId, eventVersion, data, size, thread);
+}
+
+bool EventPipeConsumer::OnRuntimeEvent(DWORD eventId, DWORD eventVersion, const BYTE* data, ULONG size,
+                                       ThreadID thread)
+{
+    RuntimeEvent event;
+    if (!ParseRuntimeEvent(eventId, eventVersion, data, size, &event))
+    {
+        m_events_ignored++;
+        return false;
+    }
+    event.thread = thread;
+    event.timestamp_ns = NowNanoseconds();
+
+    // Only the used part of the type name is copied
+    const auto recordSize = offsetof(RuntimeEvent, type_name) + event.type_name_length * sizeof(WCHAR);
+    switch (m_queue.TryEnqueue(reinterpret_cast<const uint8_t*>(&event), recordSize))
+    {
+        case RecordEnqueueResult::Accepted:
+            if (m_queue.ApproximateSize() >= m_options.batch_size)
+            {
+                Wake();
+            }
+            return true;
+        case RecordEnqueueResult::AcceptedAboveWatermark:
+            Wake();
+            return true;
+        default:
+            m_events_dropped++;
+            Wake();
+            return false;
+    }
+}
+
+void EventPipeConsumer::Wake()
+{
+    // Same as the span flusher: a lost wake up only delays the aggregation until the next interval
+    if (!m_wake.load(std::memory_order_relaxed) && !m_wake.exchange(true))
+    {
+        m_wake_condition.notify_one();
+    }
+}
+
+bool EventPipeConsumer::Drain(std::chrono::milliseconds timeout)
+{
+    if (!m_running)
+    {
+        return false;
+    }
+
+    const auto target = m_queue.EnqueuePosition();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wake = true;
+    m_wake_condition.notify_one();
+    return m_aggregated_condition.wait_for(lock, timeout,
+                                           [this, target] { return m_queue.DequeuePosition() >= target; });
+}
+
+void EventPipeConsumer::Aggregate(const RuntimeEvent& event)
+{
+    switch (event.kind)
+    {
+        case RuntimeEventKind::ContentionStart:
+            m_contention_starts[event.thread] = event.timestamp_ns;
+            break;
+        case RuntimeEventKind::ContentionStop:
+        {
+            auto duration = event.duration_ns;
+            const auto start = m_contention_starts.find(event.thread);
+            if (start != m_contention_starts.end())
+            {
+                if (duration == 0 && event.timestamp_ns > start->second)
+                {
+                    duration = event.timestamp_ns - start->second;
+                }
+                m_contention_starts.erase(start);
+            }
+
+            m_contention_count++;
+            m_contention_total_ns += duration;
+            if (duration > m_contention_max_ns.load(std::memory_order_relaxed))
+            {
+                m_contention_max_ns = duration;
+            }
+            m_contention_histogram.Add(duration);
+            break;
+        }
+        case RuntimeEventKind::ThreadPoolWorkerStart:
+            m_threadpool_worker_starts++;
+            m_threadpool_active_workers = event.worker_count;
+            break;
+        case RuntimeEventKind::ThreadPoolWorkerStop:
+            m_threadpool_worker_stops++;
+            m_threadpool_active_workers = event.worker_count;
+            break;
+        case RuntimeEventKind::ThreadPoolWorkerWait:
+            m_threadpool_active_workers = event.worker_count;
+            break;
+        case RuntimeEventKind::ThreadPoolAdjustment:
+            m_threadpool_adjustments++;
+            m_threadpool_adjustment_reason = event.reason;
+            m_threadpool_throughput = event.throughput;
+            break;
+        case RuntimeEventKind::ExceptionThrown:
+        {
+            m_exception_count++;
+            const auto length = (std::min)(event.type_name_length, (uint32_t) runtime_event_type_name_length);
+            // Reuses the capacity of the scratch string, only new types allocate
+            m_type_name.assign(event.type_name, length);
+
+            auto existing = m_exception_types.find(m_type_name);
+            if (existing != m_exception_types.end())
+            {
+                existing->second++;
+            }
+            else if (m_exception_types.size() < runtime_event_max_exception_types)
+            {
+                m_exception_types[m_type_name] = 1;
+            }
+            else
+            {
+                m_exception_types[runtime_event_other_exception_types]++;
+            }
+            break;
+        }
+    }
+
+    m_events_aggregated++;
+}
+
+size_t EventPipeConsumer::AggregateBatch()
+{
+    const auto count = m_queue.Peek(m_batch.data(), m_batch.size());
+
+    // Exception types are updated under the lock, taken once per batch
+    std::lock_guard<std::mutex> guard(m_exception_types_mutex);
+    for (size_t i = 0; i < count; i++)
+    {
+        // Records are copied out, the queue only guarantees byte alignment
+        RuntimeEvent event;
+        std::memcpy(&event, m_batch[i].data, (std::min)(m_batch[i].size, sizeof(RuntimeEvent)));
+        Aggregate(event);
+    }
+
+    m_queue.Release(count);
+    return count;
+}
+
+void EventPipeConsumer::AggregateAll()
+{
+    while (AggregateBatch() > 0)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_aggregated_condition.notify_all();
+    }
+}
+
+void EventPipeConsumer::AggregationThreadLoop(EventPipeConsumer* consumer)
+{
+    while (consumer->m_running)
+    {
+        {
+            std::unique_lock<std::mutex> lock(consumer->m_mutex);
+            consumer->m_wake_condition.wait_for(lock, consumer->m_options.aggregation_interval,
+                                                [consumer] { return consumer->m_wake || !consumer->m_running; });
+            consumer->m_wake = false;
+        }
+
+        consumer->AggregateAll();
+    }
+
+    // Everything enqueued before Stop
+    consumer->AggregateAll();
+}
+
+void EventPipeConsumer::GetSnapshot(RuntimeEventMetricsSnapshot* snapshot) const
+{
+    snapshot->version = runtime_event_metrics_version;
+    snapshot->histogram_bucket_count = SWHistogram::BucketCount;
+    snapshot->events_aggregated = m_events_aggregated.load();
+    snapshot->events_dropped = m_events_dropped.load();
+    snapshot->events_ignored = m_events_ignored.load();
+    snapshot->contention_count = m_contention_count.load();
+    snapshot->contention_total_ns = m_contention_total_ns.load();
+    snapshot->contention_max_ns = m_contention_max_ns.load();
+    snapshot->threadpool_worker_starts = m_threadpool_worker_starts.load();
+    snapshot->threadpool_worker_stops = m_threadpool_worker_stops.load();
+    snapshot->threadpool_adjustments = m_threadpool_adjustments.load();
+    snapshot->threadpool_active_workers = m_threadpool_active_workers.load();
+    snapshot->threadpool_adjustment_reason = m_threadpool_adjustment_reason.load();
+    snapshot->threadpool_throughput = m_threadpool_throughput.load();
+    snapshot->exception_count = m_exception_count.load();
+    for (int i = 0; i < SWHistogram::BucketCount; i++)
+    {
+        snapshot->contention_histogram[i] = m_contention_histogram.GetBucket(i);
+    }
+}
+
+std::string EventPipeConsumer::ToString() const
+{
+    RuntimeEventMetricsSnapshot snapshot;
+    GetSnapshot(&snapshot);
+
+    std::vector<std::pair<WSTRING, uint64_t>> exceptionTypes;
+    {
+        std::lock_guard<std::mutex> guard(m_exception_types_mutex);
+        exceptionTypes.assign(m_exception_types.begin(), m_exception_types.end());
+    }
+    std::sort(exceptionTypes.begin(), exceptionTypes.end(),
+              [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    std::stringstream ss;
+    ss << "EventPipe [Aggregated=" << snapshot.events_aggregated << ", Dropped=" << snapshot.events_dropped
+       << ", Ignored=" << snapshot.events_ignored << "]";
+    ss << " Contention [Count=" << snapshot.contention_count
+       << ", Total=" << snapshot.contention_total_ns / 1000000 << "ms"
+       << ", Max=" << snapshot.contention_max_ns / 1000 << "us]";
+    ss << " ThreadPool [Workers=" << snapshot.threadpool_active_workers
+       << ", Starts=" << snapshot.threadpool_worker_starts << ", Stops=" << snapshot.threadpool_worker_stops
+       << ", Adjustments=" << snapshot.threadpool_adjustments
+       << ", Throughput=" << snapshot.threadpool_throughput << "]";
+    ss << " Exceptions [Count=" << snapshot.exception_count << "]\n";
+    ss << "Contention:\n" << m_contention_histogram.ToString();
+    ss << "Exceptions:\n";
+    for (size_t i = 0; i < exceptionTypes.size() && i < runtime_event_top_exception_types; i++)
+    {
+        ss << "  " << trace::ToString(exceptionTypes[i].first) << ": " << exceptionTypes[i].second << "\n";
+    }
+    return ss.str();
+}
+
+} // namespace trace
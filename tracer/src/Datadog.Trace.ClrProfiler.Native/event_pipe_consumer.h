@@ -0,0 +1,221 @@
+#ifndef DD_CLR_PROFILER_EVENT_PIPE_CONSUMER_H_
+#define DD_CLR_PROFILER_EVENT_PIPE_CONSUMER_H_
+
+#include "cor.h"
+#include "corprof.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "record_ring_buffer.h"
+#include "stats.h"
+#include "string.h"
+
+namespace trace
+{
+
+const uint32_t runtime_event_metrics_version = 1;
+
+const WSTRING runtime_event_provider_name = WStr("Microsoft-Windows-DotNETRuntime");
+
+// Keywords of the runtime provider parsed by the consumer
+const uint64_t runtime_event_contention_keyword = 0x4000;
+const uint64_t runtime_event_exception_keyword = 0x8000;
+const uint64_t runtime_event_threading_keyword = 0x10000;
+
+// Informational, the runtime events are defined at Informational or lower
+const uint32_t runtime_event_default_level = 4;
+
+// Exception type names are truncated to this many characters
+const int runtime_event_type_name_length = 64;
+
+// Event ids of the runtime provider, see ClrEtwAll.man in dotnet/runtime
+const DWORD runtime_event_threadpool_worker_start_id = 50;
+const DWORD runtime_event_threadpool_worker_stop_id = 51;
+const DWORD runtime_event_threadpool_adjustment_id = 55;
+const DWORD runtime_event_threadpool_worker_wait_id = 57;
+const DWORD runtime_event_exception_thrown_id = 80;
+const DWORD runtime_event_contention_start_id = 81;
+const DWORD runtime_event_contention_stop_id = 91;
+
+enum class RuntimeEventKind : uint32_t
+{
+    ContentionStart,
+    ContentionStop,
+    ThreadPoolWorkerStart,
+    ThreadPoolWorkerStop,
+    ThreadPoolWorkerWait,
+    ThreadPoolAdjustment,
+    ExceptionThrown
+};
+
+//
+// Fixed-size record parsed from an event payload on the thread that raised the event. It doesn't point into
+// the payload, which is only valid during the callback, and is copied as is into the consumer queue.
+//
+struct RuntimeEvent
+{
+    RuntimeEventKind kind;
+    // Active worker threads (ThreadPoolWorker*) or new worker thread count (ThreadPoolAdjustment)
+    uint32_t worker_count;
+    // Adjustment reason (ThreadPoolAdjustment) or HRESULT (ExceptionThrown)
+    uint32_t reason;
+    uint32_t type_name_length;
+    ThreadID thread;
+    uint64_t timestamp_ns;
+    // Only set by ContentionStop version 1 (.NET 8+), computed from ContentionStart otherwise
+    uint64_t duration_ns;
+    double throughput;
+    WCHAR type_name[runtime_event_type_name_length];
+};
+
+// Parses the payload of a runtime provider event without allocating. Returns false for the events the
+// consumer doesn't handle and for truncated payloads.
+bool ParseRuntimeEvent(DWORD eventId, DWORD eventVersion, const BYTE* data, ULONG size, RuntimeEvent* event);
+
+//
+// Snapshot returned by the GetRuntimeEventMetrics export. Counters are cumulative since the session started,
+// thread pool values are the ones of the last event.
+//
+// Must keep this layout in sync with NativeRuntimeEventMetrics.cs!
+//
+struct RuntimeEventMetricsSnapshot
+{
+    uint32_t version;
+    uint32_t histogram_bucket_count;
+    // Events aggregated, events dropped because the queue was full and events not handled by the consumer
+    uint64_t events_aggregated;
+    uint64_t events_dropped;
+    uint64_t events_ignored;
+    uint64_t contention_count;
+    uint64_t contention_total_ns;
+    uint64_t contention_max_ns;
+    uint64_t threadpool_worker_starts;
+    uint64_t threadpool_worker_stops;
+    uint64_t threadpool_adjustments;
+    uint32_t threadpool_active_workers;
+    uint32_t threadpool_adjustment_reason;
+    double threadpool_throughput;
+    uint64_t exception_count;
+    // Contention durations, bucket i counts the contentions under 2^i microseconds (see SWHistogram)
+    uint32_t contention_histogram[SWHistogram::BucketCount];
+};
+
+static_assert(sizeof(RuntimeEventMetricsSnapshot) == 184,
+              "RuntimeEventMetricsSnapshot layout is shared with the managed side");
+
+struct EventPipeProviderOptions
+{
+    WSTRING name;
+    uint64_t keywords;
+    uint32_t level;
+};
+
+// Parses "Provider[:Keywords[:Level]][,...]", keywords in hexadecimal, the same format as dotnet-trace.
+// An empty value gives the runtime provider with the contention, exception and threading keywords.
+bool ParseEventPipeProviders(const WSTRING& value, std::vector<EventPipeProviderOptions>* providers);
+
+struct EventPipeConsumerOptions
+{
+    std::vector<EventPipeProviderOptions> providers;
+    // Number of events the queue holds, rounded up to a power of two
+    size_t capacity = 8192;
+    // Events aggregated per pass, the aggregation thread is woken up as soon as this many are waiting
+    size_t batch_size = 512;
+    std::chrono::milliseconds aggregation_interval = std::chrono::milliseconds(1000);
+};
+
+/// <summary>
+/// In-process EventPipe session (ICorProfilerInfo12, .NET 5+) whose events are delivered to the profiler
+/// through EventPipeEventDelivered, on the thread that raised them. That thread only parses the payload
+/// into a RuntimeEvent and enqueues it, without locking nor allocating; a native thread aggregates the
+/// queued events into counters and histograms. Events are dropped when the queue is full.
+/// </summary>
+class EventPipeConsumer
+{
+private:
+    static const int provider_cache_size = 8;
+
+    ICorProfilerInfo12* m_info;
+    EventPipeConsumerOptions m_options;
+    EVENTPIPE_SESSION m_session = 0;
+
+    RecordRingBuffer m_queue;
+    std::vector<RingBufferRecord> m_batch;
+
+    // Providers seen by EventPipeEventDelivered, resolved once by name
+    std::atomic<EVENTPIPE_PROVIDER> m_runtime_provider = {0};
+    std::atomic<EVENTPIPE_PROVIDER> m_other_providers[provider_cache_size] = {};
+
+    std::atomic_ullong m_events_aggregated = {0};
+    std::atomic_ullong m_events_dropped = {0};
+    std::atomic_ullong m_events_ignored = {0};
+    std::atomic_ullong m_contention_count = {0};
+    std::atomic_ullong m_contention_total_ns = {0};
+    std::atomic_ullong m_contention_max_ns = {0};
+    SWHistogram m_contention_histogram;
+    std::atomic_ullong m_threadpool_worker_starts = {0};
+    std::atomic_ullong m_threadpool_worker_stops = {0};
+    std::atomic_ullong m_threadpool_adjustments = {0};
+    std::atomic_uint m_threadpool_active_workers = {0};
+    std::atomic_uint m_threadpool_adjustment_reason = {0};
+    std::atomic<double> m_threadpool_throughput = {0};
+    std::atomic_ullong m_exception_count = {0};
+
+    // Only touched by the aggregation thread, except for the exception types read under the lock
+    std::unordered_map<ThreadID, uint64_t> m_contention_starts;
+    mutable std::mutex m_exception_types_mutex;
+    std::unordered_map<WSTRING, uint64_t> m_exception_types;
+    WSTRING m_type_name;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake_condition;
+    std::condition_variable m_aggregated_condition;
+    std::atomic_bool m_running = {false};
+    std::atomic_bool m_wake = {false};
+    std::unique_ptr<std::thread> m_thread;
+
+    static void AggregationThreadLoop(EventPipeConsumer* consumer);
+    size_t AggregateBatch();
+    void AggregateAll();
+    void Aggregate(const RuntimeEvent& event);
+    void Wake();
+    bool IsRuntimeProvider(EVENTPIPE_PROVIDER provider);
+
+public:
+    // info can be null, events are then only fed through OnRuntimeEvent.
+    EventPipeConsumer(ICorProfilerInfo12* info, const EventPipeConsumerOptions& options);
+    ~EventPipeConsumer();
+
+    // Starts the aggregation thread, then the EventPipe session. The profiler must have set
+    // COR_PRF_HIGH_MONITOR_EVENT_PIPE in its event mask.
+    HRESULT Start();
+    // Stops the session and the aggregation thread after aggregating the queued events.
+    void Stop();
+    bool IsRunning() const;
+
+    // EventPipeEventDelivered callback, events of the other providers are only counted.
+    void OnEventDelivered(EVENTPIPE_PROVIDER provider, DWORD eventId, DWORD eventVersion, const BYTE* data,
+                          ULONG size, ThreadID thread);
+    // Same as OnEventDelivered for an event of the runtime provider. Returns false when the event was ignored
+    // or dropped.
+    bool OnRuntimeEvent(DWORD eventId, DWORD eventVersion, const BYTE* data, ULONG size, ThreadID thread);
+
+    // Waits until everything enqueued before the call has been aggregated.
+    bool Drain(std::chrono::milliseconds timeout);
+
+    void GetSnapshot(RuntimeEventMetricsSnapshot* snapshot) const;
+    // Counters, contention histogram and the most thrown exception types
+    std::string ToString() const;
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_EVENT_PIPE_CONSUMER_H_
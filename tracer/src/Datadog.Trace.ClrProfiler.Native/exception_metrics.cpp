@@ -0,0 +1,286 @@
+#include "exception_metrics.h"
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+#include "clr_helpers.h"
+#include "com_ptr.h"
+
+namespace trace
+{
+
+namespace
+{
+    struct PendingException
+    {
+        const ExceptionMetrics* metrics;
+        ClassID class_id;
+    };
+
+    // Exception thrown by the thread whose throwing function is not known yet
+    thread_local PendingException pending_exception = {nullptr, 0};
+
+    uint64_t HashSite(ClassID classId, FunctionID functionId)
+    {
+        uint64_t hash = (uint64_t) classId * 0x9E3779B97F4A7C15ull;
+        hash ^= (uint64_t) functionId + 0x632BE59BD9B4E019ull + (hash << 6) + (hash >> 2);
+        hash ^= hash >> 31;
+        return hash == 0 ? 1 : hash;
+    }
+
+    std::string ToHex(uintptr_t value)
+    {
+        std::stringstream ss;
+        ss << "0x" << std::hex << value;
+        return ss.str();
+    }
+} // namespace
+
+ExceptionMetrics::ExceptionMetrics(ICorProfilerInfo4* info, size_t capacity) :
+    m_info(info), m_start(std::chrono::steady_clock::now())
+{
+    m_capacity = 16;
+    while (m_capacity < capacity)
+    {
+        m_capacity *= 2;
+    }
+    m_slots = std::make_unique<Slot[]>(m_capacity);
+}
+
+void ExceptionMetrics::OnExceptionThrown(ObjectID thrownObjectId)
+{
+    m_thrown++;
+
+    // A previous exception of the thread that never reached a managed frame nor reported its unwind
+    auto& pending = pending_exception;
+    if (pending.metrics == this)
+    {
+        Record(pending.class_id, 0);
+    }
+
+    ClassID classId = 0;
+    if (m_info != nullptr && FAILED(m_info->GetClassFromObject(thrownObjectId, &classId)))
+    {
+        classId = 0;
+    }
+
+    pending.metrics = this;
+    pending.class_id = classId;
+}
+
+void ExceptionMetrics::OnExceptionSearchFunctionEnter(FunctionID functionId)
+{
+    // The search phase walks the stack from the throwing frame, only the first function is the throw site
+    auto& pending = pending_exception;
+    if (pending.metrics != this)
+    {
+        return;
+    }
+
+    pending.metrics = nullptr;
+    Record(pending.class_id, functionId);
+}
+
+void ExceptionMetrics::OnExceptionSearchFinished()
+{
+    // Unwinding or catching: the search phase is over without entering a managed frame
+    auto& pending = pending_exception;
+    if (pending.metrics != this)
+    {
+        return;
+    }
+
+    pending.metrics = nullptr;
+    Record(pending.class_id, 0);
+}
+
+bool ExceptionMetrics::Record(ClassID classId, FunctionID functionId)
+{
+    const auto hash = HashSite(classId, functionId);
+    const auto mask = m_capacity - 1;
+
+    for (size_t probe = 0; probe < m_capacity; probe++)
+    {
+        auto& slot = m_slots[(hash + probe) & mask];
+        auto slotHash = slot.hash.load(std::memory_order_acquire);
+
+        if (slotHash == 0)
+        {
+            unsigned long long expected = 0;
+            if (slot.hash.compare_exchange_strong(expected, hash, std::memory_order_acq_rel))
+            {
+                slot.class_id.store(classId, std::memory_order_relaxed);
+                slot.function_id.store(functionId, std::memory_order_relaxed);
+                slot.type_name = GetTypeName(classId);
+                slot.function_name = GetFunctionName(functionId);
+                slot.ready.store(true, std::memory_order_release);
+                slot.count.fetch_add(1, std::memory_order_relaxed);
+                m_sites++;
+                return true;
+            }
+            slotHash = expected;
+        }
+
+        if (slotHash != hash)
+        {
+            continue;
+        }
+
+        // Claimed by another thread that is storing the key and resolving its names
+        while (!slot.ready.load(std::memory_order_acquire))
+        {
+            std::this_thread::yield();
+        }
+
+        if (slot.class_id.load(std::memory_order_relaxed) == classId &&
+            slot.function_id.load(std::memory_order_relaxed) == functionId)
+        {
+            slot.count.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    m_dropped++;
+    return false;
+}
+
+void ExceptionMetrics::GetTopSites(size_t count, std::vector<ExceptionSiteCount>* sites,
+                                   ExceptionRateBaseline* baseline)
+{
+    const auto now = std::chrono::steady_clock::now();
+    const auto first = baseline == nullptr || baseline->counts.empty();
+    const auto elapsed = std::chrono::duration<double>(now - (first ? m_start : baseline->time)).count();
+    if (baseline != nullptr)
+    {
+        baseline->time = now;
+        baseline->counts.resize(m_capacity);
+    }
+
+    std::vector<ExceptionSiteCount> all;
+    for (size_t i = 0; i < m_capacity; i++)
+    {
+        const auto& slot = m_slots[i];
+        if (!slot.ready.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        const auto total = slot.count.load(std::memory_order_relaxed);
+        auto increase = total;
+        if (baseline != nullptr)
+        {
+            increase -= baseline->counts[i];
+            baseline->counts[i] = total;
+        }
+        all.push_back({slot.class_id.load(std::memory_order_relaxed), slot.function_id.load(std::memory_order_relaxed),
+                       total, elapsed > 0 ? (double) increase / elapsed : 0, slot.type_name, slot.function_name});
+    }
+
+    const auto top = (std::min)(count, all.size());
+    std::partial_sort(all.begin(), all.begin() + top, all.end(),
+                      [](const auto& a, const auto& b) { return a.count > b.count; });
+    sites->assign(all.begin(), all.begin() + top);
+}
+
+uint64_t ExceptionMetrics::GetThrownCount() const
+{
+    return m_thrown.load();
+}
+
+uint64_t ExceptionMetrics::GetDroppedCount() const
+{
+    return m_dropped.load();
+}
+
+uint64_t ExceptionMetrics::GetSiteCount() const
+{
+    return m_sites.load();
+}
+
+std::string ExceptionMetrics::GetTypeName(ClassID classId) const
+{
+    std::string name;
+    ModuleID moduleId = 0;
+    mdTypeDef typeDef = mdTypeDefNil;
+    ComPtr<IUnknown> metadataInterfaces;
+    if (m_info != nullptr && classId != 0 && SUCCEEDED(m_info->GetClassIDInfo(classId, &moduleId, &typeDef)) &&
+        SUCCEEDED(m_info->GetModuleMetaData(moduleId, ofRead, IID_IMetaDataImport2,
+                                            metadataInterfaces.GetAddressOf())))
+    {
+        const auto metadataImport = metadataInterfaces.As<IMetaDataImport2>(IID_IMetaDataImport2);
+        const auto typeInfo = GetTypeInfo(metadataImport, typeDef);
+        name = trace::ToString(typeInfo.name);
+    }
+
+    if (name.empty())
+    {
+        name = classId == 0 ? "[unknown type]" : "[class " + ToHex(classId) + "]";
+    }
+    return name;
+}
+
+std::string ExceptionMetrics::GetFunctionName(FunctionID functionId) const
+{
+    std::string name;
+    mdToken token = mdTokenNil;
+    ComPtr<IUnknown> metadataInterfaces;
+    if (m_info != nullptr && functionId != 0 &&
+        SUCCEEDED(m_info->GetTokenAndMetaDataFromFunction(functionId, IID_IMetaDataImport2,
+                                                          metadataInterfaces.GetAddressOf(), &token)))
+    {
+        const auto metadataImport = metadataInterfaces.As<IMetaDataImport2>(IID_IMetaDataImport2);
+        const auto functionInfo = GetFunctionInfo(metadataImport, token);
+        if (functionInfo.IsValid())
+        {
+            name = trace::ToString(functionInfo.type.name) + "." + trace::ToString(functionInfo.name);
+        }
+    }
+
+    if (name.empty())
+    {
+        name = functionId == 0 ? "[native code]" : "[function " + ToHex(functionId) + "]";
+    }
+    return name;
+}
+
+std::string ExceptionMetrics::ToString(size_t topCount, ExceptionRateBaseline* baseline)
+{
+    std::vector<ExceptionSiteCount> sites;
+    GetTopSites(m_capacity, &sites, baseline);
+
+    // Sites are sorted by count, the types by the sum of their sites
+    std::unordered_map<ClassID, std::pair<uint64_t, double>> types;
+    std::unordered_map<ClassID, const std::string*> typeNames;
+    for (const auto& site : sites)
+    {
+        auto& type = types[site.class_id];
+        type.first += site.count;
+        type.second += site.rate;
+        typeNames.emplace(site.class_id, &site.type_name);
+    }
+    std::vector<std::pair<ClassID, std::pair<uint64_t, double>>> topTypes(types.begin(), types.end());
+    std::sort(topTypes.begin(), topTypes.end(),
+              [](const auto& a, const auto& b) { return a.second.first > b.second.first; });
+
+    std::stringstream ss;
+    ss.precision(1);
+    ss << std::fixed;
+    ss << "Exceptions [Thrown=" << m_thrown.load() << ", Sites=" << m_sites.load()
+       << ", Dropped=" << m_dropped.load() << "]\n";
+    ss << "ExceptionTypes:\n";
+    for (size_t i = 0; i < topTypes.size() && i < topCount; i++)
+    {
+        ss << "  " << *typeNames[topTypes[i].first] << ": " << topTypes[i].second.first << " ("
+           << topTypes[i].second.second << "/s)\n";
+    }
+    ss << "ExceptionSites:\n";
+    for (size_t i = 0; i < sites.size() && i < topCount; i++)
+    {
+        ss << "  " << sites[i].type_name << " at " << sites[i].function_name << ": " << sites[i].count << " ("
+           << sites[i].rate << "/s)\n";
+    }
+    return ss.str();
+}
+
+} // namespace trace
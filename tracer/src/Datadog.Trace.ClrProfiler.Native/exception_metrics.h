@@ -0,0 +1,113 @@
+#ifndef DD_CLR_PROFILER_EXCEPTION_METRICS_H_
+#define DD_CLR_PROFILER_EXCEPTION_METRICS_H_
+
+#include "cor.h"
+#include "corprof.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trace
+{
+
+// Distinct (exception type, throwing function) pairs, the exceptions of the other pairs are dropped and counted
+const size_t exception_metrics_default_capacity = 4096;
+
+// Sites and types listed by ToString
+const size_t exception_metrics_default_top_count = 10;
+
+struct ExceptionSiteCount
+{
+    ClassID class_id;
+    // 0 when the exception was thrown without any managed frame being searched
+    FunctionID function_id;
+    uint64_t count;
+    // Exceptions per second since the previous read with the same baseline
+    double rate;
+    // Resolved when the site was first counted, the ids may belong to an unloaded collectible assembly since
+    std::string type_name;
+    std::string function_name;
+};
+
+// The site counts and time of a reader's previous read. Every reader keeps its own, so reads by one reader
+// don't reset the rates seen by another.
+struct ExceptionRateBaseline
+{
+    std::chrono::steady_clock::time_point time;
+    // By slot, empty before the first read
+    std::vector<uint64_t> counts;
+};
+
+/// <summary>
+/// First-chance exception counters fed by the ExceptionThrown and ExceptionSearchFunctionEnter callbacks
+/// (COR_PRF_MONITOR_EXCEPTIONS). ExceptionThrown only remembers the exception class on the throwing thread; the
+/// first ExceptionSearchFunctionEnter that follows names the function that threw, and the pair is counted in a
+/// fixed-size open addressing table. An exception whose search never reaches a managed frame is counted without
+/// a function once its dispatch ends (ExceptionUnwindFunctionLeave or ExceptionCatcherEnter).
+/// Slots are claimed with a compare-and-swap and counters are atomics, so the throwing threads take no lock. The
+/// first exception of a site resolves the type and function names into the slot, while the ids are known to be
+/// valid: that is the only time a throwing thread allocates. Other threads throwing at that site meanwhile
+/// spin, yielding, until the names are stored.
+/// </summary>
+class ExceptionMetrics
+{
+private:
+    struct Slot
+    {
+        // 0 while the slot is free, the key is only valid once ready is set
+        std::atomic_ullong hash = {0};
+        std::atomic<ClassID> class_id = {0};
+        std::atomic<FunctionID> function_id = {0};
+        std::atomic_bool ready = {false};
+        std::atomic_ullong count = {0};
+        // Written before ready is set, never changed after
+        std::string type_name;
+        std::string function_name;
+    };
+
+    ICorProfilerInfo4* m_info;
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity;
+
+    std::atomic_ullong m_thrown = {0};
+    std::atomic_ullong m_dropped = {0};
+    std::atomic_ullong m_sites = {0};
+
+    const std::chrono::steady_clock::time_point m_start;
+
+    std::string GetTypeName(ClassID classId) const;
+    std::string GetFunctionName(FunctionID functionId) const;
+
+public:
+    // info can be null, types and functions are then named by their ids.
+    explicit ExceptionMetrics(ICorProfilerInfo4* info, size_t capacity = exception_metrics_default_capacity);
+
+    void OnExceptionThrown(ObjectID thrownObjectId);
+    void OnExceptionSearchFunctionEnter(FunctionID functionId);
+    // ExceptionUnwindFunctionLeave and ExceptionCatcherEnter, the search phase of the exception is over
+    void OnExceptionSearchFinished();
+
+    // Counts an exception of the given class thrown by the given function. Returns false when the table is full.
+    bool Record(ClassID classId, FunctionID functionId);
+
+    // Copies the count sites with the most exceptions, most thrown first, and their rates since the previous read
+    // with baseline, which is then updated. Without a baseline, or on its first read, the rates cover the whole
+    // lifetime of the metrics.
+    void GetTopSites(size_t count, std::vector<ExceptionSiteCount>* sites, ExceptionRateBaseline* baseline = nullptr);
+
+    uint64_t GetThrownCount() const;
+    uint64_t GetDroppedCount() const;
+    uint64_t GetSiteCount() const;
+
+    // Totals, then the most thrown types and sites with their rates, see GetTopSites
+    std::string ToString(size_t topCount = exception_metrics_default_top_count,
+                         ExceptionRateBaseline* baseline = nullptr);
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_EXCEPTION_METRICS_H_
@@ -0,0 +1,168 @@
+#include "gc_metrics.h"
+
+#include <sstream>
+
+namespace trace
+{
+
+// Large enough for segments, regions (.NET 7+) make the runtime report more ranges and the buffer grows once
+const ULONG gc_metrics_initial_range_count = 64;
+
+GCMetrics::GCMetrics(ICorProfilerInfo2* info) : m_info(info)
+{
+    m_ranges.resize(gc_metrics_initial_range_count);
+}
+
+void GCMetrics::OnRuntimeSuspendStarted(COR_PRF_SUSPEND_REASON reason)
+{
+    // Other suspensions (debugger, ReJIT, shutdown) are not GC pauses
+    m_suspended_for_gc = reason == COR_PRF_SUSPEND_FOR_GC || reason == COR_PRF_SUSPEND_FOR_GC_PREP;
+    if (m_suspended_for_gc)
+    {
+        m_suspend_start = std::chrono::steady_clock::now();
+    }
+}
+
+void GCMetrics::OnRuntimeSuspendAborted()
+{
+    m_suspended_for_gc = false;
+}
+
+void GCMetrics::OnRuntimeResumeFinished()
+{
+    if (!m_suspended_for_gc)
+    {
+        // Not a GC, or the profiler was initialized while the runtime was suspended
+        return;
+    }
+    m_suspended_for_gc = false;
+
+    RecordPause((uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                                 m_suspend_start)
+                    .count());
+}
+
+void GCMetrics::RecordPause(uint64_t pause)
+{
+    m_pause_total_ns += pause;
+    m_last_pause_ns = pause;
+    if (pause > m_pause_max_ns.load(std::memory_order_relaxed))
+    {
+        m_pause_max_ns = pause;
+    }
+    m_pause_histogram.Add(pause);
+}
+
+void GCMetrics::OnGarbageCollectionStarted(int cGenerations, const BOOL generationCollected[],
+                                           COR_PRF_GC_REASON reason)
+{
+    m_collections_in_progress++;
+
+    // LOH and POH are only collected with gen2, the oldest small object generation tells the kind of collection
+    int oldest = -1;
+    for (int i = 0; i < cGenerations && i < gc_metrics_collection_count; i++)
+    {
+        if (generationCollected[i])
+        {
+            oldest = i;
+        }
+    }
+
+    if (oldest >= 0)
+    {
+        m_collections[oldest]++;
+    }
+
+    if (reason == COR_PRF_GC_INDUCED)
+    {
+        m_induced_collections++;
+    }
+}
+
+void GCMetrics::OnGarbageCollectionFinished()
+{
+    if (m_collections_in_progress == 0)
+    {
+        // The profiler was initialized in the middle of a collection
+        return;
+    }
+    m_collections_in_progress--;
+
+    if (m_info == nullptr)
+    {
+        return;
+    }
+
+    ULONG count = 0;
+    HRESULT hr = m_info->GetGenerationBounds((ULONG) m_ranges.size(), &count, m_ranges.data());
+    if (SUCCEEDED(hr) && count > m_ranges.size())
+    {
+        m_ranges.resize(count * 2);
+        hr = m_info->GetGenerationBounds((ULONG) m_ranges.size(), &count, m_ranges.data());
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        RecordGenerationBounds(m_ranges.data(), (std::min)(count, (ULONG) m_ranges.size()));
+    }
+}
+
+void GCMetrics::RecordGenerationBounds(const COR_PRF_GC_GENERATION_RANGE* ranges, ULONG count)
+{
+    uint64_t sizes[gc_metrics_heap_count] = {};
+    for (ULONG i = 0; i < count; i++)
+    {
+        const auto generation = (int) ranges[i].generation;
+        if (generation >= 0 && generation < gc_metrics_heap_count)
+        {
+            sizes[generation] += ranges[i].rangeLength;
+        }
+    }
+
+    for (int i = 0; i < gc_metrics_heap_count; i++)
+    {
+        m_heap_size[i] = sizes[i];
+    }
+}
+
+void GCMetrics::GetSnapshot(GCMetricsSnapshot* snapshot) const
+{
+    snapshot->version = gc_metrics_version;
+    snapshot->histogram_bucket_count = SWHistogram::BucketCount;
+    for (int i = 0; i < gc_metrics_collection_count; i++)
+    {
+        snapshot->collections[i] = m_collections[i].load();
+    }
+    snapshot->induced_collections = m_induced_collections.load();
+    snapshot->pause_total_ns = m_pause_total_ns.load();
+    snapshot->pause_max_ns = m_pause_max_ns.load();
+    snapshot->last_pause_ns = m_last_pause_ns.load();
+    for (int i = 0; i < gc_metrics_heap_count; i++)
+    {
+        snapshot->heap_size[i] = m_heap_size[i].load();
+    }
+    for (int i = 0; i < SWHistogram::BucketCount; i++)
+    {
+        snapshot->pause_histogram[i] = m_pause_histogram.GetBucket(i);
+    }
+}
+
+std::string GCMetrics::ToString() const
+{
+    GCMetricsSnapshot snapshot;
+    GetSnapshot(&snapshot);
+
+    std::stringstream ss;
+    ss << "GC [Gen0=" << snapshot.collections[0] << ", Gen1=" << snapshot.collections[1]
+       << ", Gen2=" << snapshot.collections[2] << ", Induced=" << snapshot.induced_collections
+       << ", Pause=" << snapshot.pause_total_ns / 1000000 << "ms"
+       << ", MaxPause=" << snapshot.pause_max_ns / 1000 << "us"
+       << ", LastPause=" << snapshot.last_pause_ns / 1000 << "us]";
+    ss << " Heap [Gen0=" << snapshot.heap_size[0] << "B, Gen1=" << snapshot.heap_size[1]
+       << "B, Gen2=" << snapshot.heap_size[2] << "B, LOH=" << snapshot.heap_size[3]
+       << "B, POH=" << snapshot.heap_size[4] << "B]\n";
+    ss << "GCPause:\n" << m_pause_histogram.ToString();
+    return ss.str();
+}
+
+} // namespace trace
@@ -0,0 +1,99 @@
+#ifndef DD_CLR_PROFILER_GC_METRICS_H_
+#define DD_CLR_PROFILER_GC_METRICS_H_
+
+#include "cor.h"
+#include "corprof.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "stats.h"
+
+namespace trace
+{
+
+const uint32_t gc_metrics_version = 1;
+
+// Collected generations: gen0, gen1 and gen2
+const int gc_metrics_collection_count = 3;
+
+// Heap generations as reported by GetGenerationBounds: gen0, gen1, gen2, LOH and POH (.NET 5+)
+const int gc_metrics_heap_count = 5;
+
+//
+// Snapshot returned by the GetGCMetrics export. Counters are cumulative since the profiler started, heap sizes
+// are the ones of the last collection.
+//
+// Must keep this layout in sync with NativeGCMetrics.cs!
+//
+struct GCMetricsSnapshot
+{
+    uint32_t version;
+    uint32_t histogram_bucket_count;
+    // Collections by the oldest generation collected
+    uint64_t collections[gc_metrics_collection_count];
+    uint64_t induced_collections;
+    uint64_t pause_total_ns;
+    uint64_t pause_max_ns;
+    uint64_t last_pause_ns;
+    uint64_t heap_size[gc_metrics_heap_count];
+    // Runtime suspensions for a GC, bucket i counts the pauses under 2^i microseconds (see SWHistogram)
+    uint32_t pause_histogram[SWHistogram::BucketCount];
+};
+
+static_assert(sizeof(GCMetricsSnapshot) == 184, "GCMetricsSnapshot layout is shared with the managed side");
+
+/// <summary>
+/// GC pause and heap metrics fed by the profiler callbacks. Collections and heap sizes come from
+/// COR_PRF_HIGH_BASIC_GC.
+/// A background gen2 collection runs alongside the application and can let ephemeral collections start and
+/// finish before it does, so collections are tracked as a stack and pauses are measured from the runtime
+/// suspension for a GC to the end of the resume (COR_PRF_MONITOR_SUSPENDS) instead of from the start to the
+/// end of a collection. A background collection thus shows up as its two short suspensions.
+/// The runtime serializes suspensions and these callbacks, so there is a single writer at a time; readers only
+/// load atomics and never block the GC. A snapshot taken during a collection can mix values of two collections.
+/// </summary>
+class GCMetrics
+{
+private:
+    ICorProfilerInfo2* m_info;
+
+    std::atomic_ullong m_collections[gc_metrics_collection_count] = {};
+    std::atomic_ullong m_induced_collections = {0};
+    std::atomic_ullong m_pause_total_ns = {0};
+    std::atomic_ullong m_pause_max_ns = {0};
+    std::atomic_ullong m_last_pause_ns = {0};
+    std::atomic_ullong m_heap_size[gc_metrics_heap_count] = {};
+    SWHistogram m_pause_histogram;
+
+    // Only touched by the GC callbacks
+    std::chrono::steady_clock::time_point m_suspend_start;
+    bool m_suspended_for_gc = false;
+    // A background gen2 and the ephemeral collections running during it
+    int m_collections_in_progress = 0;
+    std::vector<COR_PRF_GC_GENERATION_RANGE> m_ranges;
+
+    void RecordPause(uint64_t pause);
+
+public:
+    // info can be null, heap sizes are then only updated through RecordGenerationBounds.
+    explicit GCMetrics(ICorProfilerInfo2* info);
+
+    void OnRuntimeSuspendStarted(COR_PRF_SUSPEND_REASON reason);
+    void OnRuntimeSuspendAborted();
+    void OnRuntimeResumeFinished();
+
+    void OnGarbageCollectionStarted(int cGenerations, const BOOL generationCollected[], COR_PRF_GC_REASON reason);
+    void OnGarbageCollectionFinished();
+
+    void RecordGenerationBounds(const COR_PRF_GC_GENERATION_RANGE* ranges, ULONG count);
+
+    void GetSnapshot(GCMetricsSnapshot* snapshot) const;
+    std::string ToString() const;
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_GC_METRICS_H_
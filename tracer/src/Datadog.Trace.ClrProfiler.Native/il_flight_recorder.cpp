@@ -0,0 +1,659 @@
+#include "il_flight_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <new>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace trace
+{
+
+static_assert(sizeof(ILFlightRecorderFileHeader) == 64, "The file header layout is part of the file format");
+static_assert(sizeof(ILFlightRecorderRecordHeader) == 72, "The record header layout is part of the file format");
+static_assert(sizeof(ILFlightRecorderEHClause) == 24, "EH clauses are stored in the fat format");
+
+const uint32_t kILFlightRecorderMaxNameLength = 1024;
+
+static uint64_t AlignRecordSize(uint64_t size)
+{
+    return (size + 7) & ~((uint64_t) 7);
+}
+
+static uint64_t GetTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+static uint32_t GetBodySize(const ILFlightRecorderBody& body)
+{
+    return body.codeSize + body.ehCount * (uint32_t) sizeof(ILFlightRecorderEHClause) + body.localSignatureSize;
+}
+
+ILFlightRecorder::~ILFlightRecorder()
+{
+    Close();
+}
+
+bool ILFlightRecorder::Open(const std::string& path, uint64_t capacity)
+{
+    Close();
+
+    capacity = AlignRecordSize((std::max)(capacity, kILFlightRecorderMinimumCapacity));
+    const uint64_t mappingSize = sizeof(ILFlightRecorderFileHeader) + capacity;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, (DWORD)(mappingSize >> 32),
+                                        (DWORD)(mappingSize & 0xFFFFFFFF), nullptr);
+    if (mapping == nullptr)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T) mappingSize);
+    if (view == nullptr)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+#else
+    // The ring keeps method bodies of the application, only the user running it can read them. A file left by
+    // an earlier process with the same pid keeps its mode on open, so it is set again.
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd == -1)
+    {
+        return false;
+    }
+
+    if (fchmod(fd, 0600) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    if (ftruncate(fd, (off_t) mappingSize) != 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+#endif
+
+    m_mapping = view;
+    m_mappingSize = mappingSize;
+    m_capacity = capacity;
+    m_header = new (view) ILFlightRecorderFileHeader();
+    m_data = static_cast<uint8_t*>(view) + sizeof(ILFlightRecorderFileHeader);
+
+    m_header->version = kILFlightRecorderVersion;
+    m_header->headerSize = sizeof(ILFlightRecorderFileHeader);
+#ifdef _WIN32
+    m_header->processId = (uint32_t) GetCurrentProcessId();
+#else
+    m_header->processId = (uint32_t) getpid();
+#endif
+    m_header->capacity = capacity;
+    m_header->startTimestamp = GetTimestamp();
+    m_header->writePosition.store(0, std::memory_order_relaxed);
+    reinterpret_cast<std::atomic<uint32_t>*>(&m_header->magic)->store(kILFlightRecorderFileMagic,
+                                                                       std::memory_order_release);
+    return true;
+}
+
+void ILFlightRecorder::Close()
+{
+    if (m_mapping == nullptr)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    FlushViewOfFile(m_mapping, 0);
+    UnmapViewOfFile(m_mapping);
+    CloseHandle(m_mappingHandle);
+    CloseHandle(m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    munmap(m_mapping, m_mappingSize);
+#endif
+
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_header = nullptr;
+    m_data = nullptr;
+    m_capacity = 0;
+}
+
+bool ILFlightRecorder::IsOpen() const
+{
+    return m_mapping != nullptr;
+}
+
+void ILFlightRecorder::Write(uint64_t position, const void* source, size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(source);
+    while (size > 0)
+    {
+        const uint64_t offset = position % m_capacity;
+        const size_t chunk = (size_t) std::min<uint64_t>(size, m_capacity - offset);
+        std::memcpy(m_data + offset, bytes, chunk);
+        position += chunk;
+        bytes += chunk;
+        size -= chunk;
+    }
+}
+
+void ILFlightRecorder::Record(uint64_t moduleId, uint32_t methodToken, ILFlightRecorderRewriteKind kind,
+                              int32_t hresult, const std::string& name, const ILFlightRecorderBody& original,
+                              const ILFlightRecorderBody& rewritten)
+{
+    if (m_mapping == nullptr)
+    {
+        return;
+    }
+
+    ILFlightRecorderRecordHeader header{};
+    header.timestamp = GetTimestamp();
+    header.moduleId = moduleId;
+    header.methodToken = methodToken;
+    header.hresult = hresult;
+    header.kind = (uint16_t) kind;
+    header.nameLength = (uint32_t) std::min<size_t>(name.size(), kILFlightRecorderMaxNameLength);
+
+    // A record never takes more than half of the ring, so a reader always finds the previous one intact
+    // next to it. Bodies that don't fit are dropped and only the method identity is kept.
+    uint64_t size = sizeof(header) + header.nameLength + GetBodySize(original) + GetBodySize(rewritten);
+    const bool truncated = AlignRecordSize(size) > m_capacity / 2;
+    if (truncated)
+    {
+        header.flags = ILFlightRecorderTruncated;
+        size = sizeof(header) + header.nameLength;
+    }
+    else
+    {
+        header.originalCodeSize = original.codeSize;
+        header.originalEHCount = original.ehCount;
+        header.originalLocalSignatureSize = original.localSignatureSize;
+        header.newCodeSize = rewritten.codeSize;
+        header.newEHCount = rewritten.ehCount;
+        header.newLocalSignatureSize = rewritten.localSignatureSize;
+    }
+
+    header.size = (uint32_t) AlignRecordSize(size);
+    header.position = m_header->writePosition.fetch_add(header.size, std::memory_order_relaxed);
+
+    // Records start 8 byte aligned and the capacity is a multiple of 8, so the magic never wraps.
+    // It is cleared first so a reader never pairs a stale magic with a half written record.
+    auto* magic = reinterpret_cast<std::atomic<uint32_t>*>(m_data + header.position % m_capacity);
+    magic->store(0, std::memory_order_relaxed);
+
+    uint64_t position = header.position + sizeof(uint32_t);
+    Write(position, reinterpret_cast<const uint8_t*>(&header) + sizeof(uint32_t), sizeof(header) - sizeof(uint32_t));
+    position += sizeof(header) - sizeof(uint32_t);
+
+    Write(position, name.data(), header.nameLength);
+    position += header.nameLength;
+
+    if (!truncated)
+    {
+        for (const auto* body : {&original, &rewritten})
+        {
+            Write(position, body->code, body->codeSize);
+            position += body->codeSize;
+            Write(position, body->ehClauses, body->ehCount * sizeof(ILFlightRecorderEHClause));
+            position += body->ehCount * sizeof(ILFlightRecorderEHClause);
+            Write(position, body->localSignature, body->localSignatureSize);
+            position += body->localSignatureSize;
+        }
+    }
+
+    magic->store(kILFlightRecorderRecordMagic, std::memory_order_release);
+}
+
+//
+// Offline decoder
+//
+
+namespace
+{
+    enum OperandType : uint8_t
+    {
+        OperandNone,
+        OperandVar8,
+        OperandVar16,
+        OperandInt8,
+        OperandInt32,
+        OperandInt64,
+        OperandFloat32,
+        OperandFloat64,
+        OperandBranch8,
+        OperandBranch32,
+        OperandToken,
+        OperandSwitch
+    };
+
+    struct OpcodeInfo
+    {
+        const char* name = nullptr;
+        OperandType operand = OperandNone;
+    };
+
+    struct OpcodeTables
+    {
+        OpcodeInfo oneByte[256];
+        OpcodeInfo twoByte[256];
+
+        OpcodeTables()
+        {
+#define InlineNone OperandNone
+#define ShortInlineVar OperandVar8
+#define InlineVar OperandVar16
+#define ShortInlineI OperandInt8
+#define InlineI OperandInt32
+#define InlineI8 OperandInt64
+#define ShortInlineR OperandFloat32
+#define InlineR OperandFloat64
+#define ShortInlineBrTarget OperandBranch8
+#define InlineBrTarget OperandBranch32
+#define InlineMethod OperandToken
+#define InlineField OperandToken
+#define InlineType OperandToken
+#define InlineString OperandToken
+#define InlineSig OperandToken
+#define InlineRVA OperandToken
+#define InlineTok OperandToken
+#define InlineSwitch OperandSwitch
+#define OPDEF(c, s, pop, push, args, type, l, s1, s2, flow)                                                            \
+    if ((l) == 1)                                                                                                      \
+        oneByte[s2] = {s, args};                                                                                       \
+    else if ((l) == 2)                                                                                                 \
+        twoByte[s2] = {s, args};
+#include "opcode.def"
+#undef OPDEF
+#undef InlineNone
+#undef ShortInlineVar
+#undef InlineVar
+#undef ShortInlineI
+#undef InlineI
+#undef InlineI8
+#undef ShortInlineR
+#undef InlineR
+#undef ShortInlineBrTarget
+#undef InlineBrTarget
+#undef InlineMethod
+#undef InlineField
+#undef InlineType
+#undef InlineString
+#undef InlineSig
+#undef InlineRVA
+#undef InlineTok
+#undef InlineSwitch
+        }
+    };
+
+    template <typename T>
+    T ReadValue(const uint8_t* bytes)
+    {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    std::ostream& Label(std::ostream& output, int64_t offset)
+    {
+        return output << "IL_" << std::hex << std::setw(4) << std::setfill('0') << offset << std::dec
+                      << std::setfill(' ');
+    }
+
+    std::ostream& Hex(std::ostream& output, uint64_t value)
+    {
+        return output << "0x" << std::hex << std::uppercase << value << std::nouppercase << std::dec;
+    }
+
+    const char* GetKindName(uint16_t kind)
+    {
+        switch ((ILFlightRecorderRewriteKind) kind)
+        {
+            case ILFlightRecorderRewriteKind::CallTargetDefault:
+                return "CallTarget";
+            case ILFlightRecorderRewriteKind::CallTargetBeginOnly:
+                return "CallTarget.BeginOnly";
+            case ILFlightRecorderRewriteKind::CallTargetEndOnly:
+                return "CallTarget.EndOnly";
+            case ILFlightRecorderRewriteKind::CallSiteReplacement:
+                return "CallSite.Replacement";
+            case ILFlightRecorderRewriteKind::CallSiteInsertion:
+                return "CallSite.Insertion";
+        }
+        return "Unknown";
+    }
+
+    const char* GetEHClauseName(uint32_t flags)
+    {
+        // COR_ILEXCEPTION_CLAUSE_FILTER, _FINALLY and _FAULT
+        if ((flags & 0x0001) != 0) return "filter";
+        if ((flags & 0x0002) != 0) return "finally";
+        if ((flags & 0x0004) != 0) return "fault";
+        return "catch";
+    }
+
+    // Copies bytes out of the ring, following the wrap-around at the end of the data area.
+    class RingReader
+    {
+    private:
+        const uint8_t* m_data;
+        uint64_t m_capacity;
+
+    public:
+        RingReader(const uint8_t* data, uint64_t capacity) : m_data(data), m_capacity(capacity)
+        {
+        }
+
+        void Read(uint64_t position, void* destination, size_t size) const
+        {
+            uint8_t* bytes = static_cast<uint8_t*>(destination);
+            while (size > 0)
+            {
+                const uint64_t offset = position % m_capacity;
+                const size_t chunk = (size_t) std::min<uint64_t>(size, m_capacity - offset);
+                std::memcpy(bytes, m_data + offset, chunk);
+                position += chunk;
+                bytes += chunk;
+                size -= chunk;
+            }
+        }
+    };
+
+    void RenderBody(const char* title, const uint8_t* bytes, uint32_t codeSize, uint32_t ehCount,
+                    uint32_t localSignatureSize, std::ostream& output)
+    {
+        output << "  " << title << ": " << codeSize << " bytes of IL, " << ehCount << " EH clauses, "
+               << localSignatureSize << " bytes of local signature" << std::endl;
+
+        ILFlightRecorder::Disassemble(bytes, codeSize, output);
+        bytes += codeSize;
+
+        for (uint32_t i = 0; i < ehCount; i++)
+        {
+            const auto clause = ReadValue<ILFlightRecorderEHClause>(bytes + i * sizeof(ILFlightRecorderEHClause));
+            output << "    .try ";
+            Label(output, clause.tryOffset) << " to ";
+            Label(output, (int64_t) clause.tryOffset + clause.tryLength) << " " << GetEHClauseName(clause.flags);
+            if ((clause.flags & 0x0001) != 0)
+            {
+                output << " ";
+                Label(output, clause.classTokenOrFilterOffset);
+            }
+            else if ((clause.flags & 0x0006) == 0)
+            {
+                output << " ";
+                Hex(output, clause.classTokenOrFilterOffset);
+            }
+            output << " handler ";
+            Label(output, clause.handlerOffset) << " to ";
+            Label(output, (int64_t) clause.handlerOffset + clause.handlerLength) << std::endl;
+        }
+        bytes += ehCount * sizeof(ILFlightRecorderEHClause);
+
+        if (localSignatureSize > 0)
+        {
+            output << "    .locals";
+            for (uint32_t i = 0; i < localSignatureSize; i++)
+            {
+                output << " " << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << (int) bytes[i]
+                       << std::nouppercase << std::dec << std::setfill(' ');
+            }
+            output << std::endl;
+        }
+    }
+} // namespace
+
+void ILFlightRecorder::Disassemble(const uint8_t* code, uint32_t codeSize, std::ostream& output)
+{
+    static const OpcodeTables tables;
+    static const uint8_t operandSizes[] = {0, 1, 2, 1, 4, 8, 4, 8, 1, 4, 4, 4};
+
+    uint32_t offset = 0;
+    while (offset < codeSize)
+    {
+        const uint32_t start = offset;
+        const OpcodeInfo* info = nullptr;
+        if (code[offset] == 0xFE && offset + 1 < codeSize)
+        {
+            info = &tables.twoByte[code[offset + 1]];
+            offset += 2;
+        }
+        else
+        {
+            info = &tables.oneByte[code[offset]];
+            offset += 1;
+        }
+
+        output << "    ";
+        Label(output, start) << ": ";
+
+        const uint32_t operandSize = operandSizes[info->operand];
+        if (info->name == nullptr || offset + operandSize > codeSize)
+        {
+            output << ".byte ";
+            Hex(output, code[start]) << std::endl;
+            offset = start + 1;
+            continue;
+        }
+
+        output << info->name;
+        const uint8_t* operand = code + offset;
+        offset += operandSize;
+
+        switch (info->operand)
+        {
+            case OperandNone:
+                break;
+            case OperandVar8:
+                output << " " << (int) operand[0];
+                break;
+            case OperandVar16:
+                output << " " << ReadValue<uint16_t>(operand);
+                break;
+            case OperandInt8:
+                output << " " << (int) (int8_t) operand[0];
+                break;
+            case OperandInt32:
+                output << " " << ReadValue<int32_t>(operand);
+                break;
+            case OperandInt64:
+                output << " " << ReadValue<int64_t>(operand);
+                break;
+            case OperandFloat32:
+                output << " " << ReadValue<float>(operand);
+                break;
+            case OperandFloat64:
+                output << " " << ReadValue<double>(operand);
+                break;
+            case OperandBranch8:
+                output << " ";
+                Label(output, (int64_t) offset + (int8_t) operand[0]);
+                break;
+            case OperandBranch32:
+                output << " ";
+                Label(output, (int64_t) offset + ReadValue<int32_t>(operand));
+                break;
+            case OperandToken:
+                output << " ";
+                Hex(output, ReadValue<uint32_t>(operand));
+                break;
+            case OperandSwitch:
+            {
+                const uint32_t count = ReadValue<uint32_t>(operand);
+                if ((uint64_t) offset + (uint64_t) count * 4 > codeSize)
+                {
+                    output << " <truncated>";
+                    offset = codeSize;
+                    break;
+                }
+                const uint32_t next = offset + count * 4;
+                output << " (";
+                for (uint32_t i = 0; i < count; i++)
+                {
+                    if (i > 0) output << ", ";
+                    Label(output, (int64_t) next + ReadValue<int32_t>(code + offset + i * 4));
+                }
+                output << ")";
+                offset = next;
+                break;
+            }
+        }
+
+        output << std::endl;
+    }
+}
+
+bool ILFlightRecorder::Decode(const std::string& path, std::ostream& output)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        output << "Unable to open " << path << std::endl;
+        return false;
+    }
+
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return Decode(bytes.data(), bytes.size(), output);
+}
+
+bool ILFlightRecorder::Decode(const uint8_t* file, size_t fileSize, std::ostream& output)
+{
+    if (fileSize < sizeof(ILFlightRecorderFileHeader))
+    {
+        output << "Not an IL flight recorder file" << std::endl;
+        return false;
+    }
+
+    const auto magic = ReadValue<uint32_t>(file + offsetof(ILFlightRecorderFileHeader, magic));
+    const auto version = ReadValue<uint32_t>(file + offsetof(ILFlightRecorderFileHeader, version));
+    const auto headerSize = ReadValue<uint32_t>(file + offsetof(ILFlightRecorderFileHeader, headerSize));
+    const auto processId = ReadValue<uint32_t>(file + offsetof(ILFlightRecorderFileHeader, processId));
+    const auto capacity = ReadValue<uint64_t>(file + offsetof(ILFlightRecorderFileHeader, capacity));
+    const auto writePosition = ReadValue<uint64_t>(file + offsetof(ILFlightRecorderFileHeader, writePosition));
+
+    if (magic != kILFlightRecorderFileMagic || headerSize != sizeof(ILFlightRecorderFileHeader))
+    {
+        output << "Not an IL flight recorder file" << std::endl;
+        return false;
+    }
+
+    if (version != kILFlightRecorderVersion)
+    {
+        output << "Unsupported IL flight recorder version " << version << std::endl;
+        return false;
+    }
+
+    if (capacity == 0 || capacity % 8 != 0 || capacity > fileSize - headerSize)
+    {
+        output << "Corrupted IL flight recorder header" << std::endl;
+        return false;
+    }
+
+    output << "IL flight recorder: pid " << processId << ", " << capacity << " bytes ring, " << writePosition
+           << " bytes written" << std::endl;
+
+    const RingReader ring(file + headerSize, capacity);
+    std::vector<uint8_t> payload;
+    uint64_t recordCount = 0;
+
+    // Only the last lap is still in the ring. The oldest record in it is usually partially overwritten,
+    // so scan forward on 8 byte boundaries until a header that points to its own position is found.
+    uint64_t position = writePosition > capacity ? AlignRecordSize(writePosition - capacity) : 0;
+    while (position + sizeof(ILFlightRecorderRecordHeader) <= writePosition)
+    {
+        ILFlightRecorderRecordHeader header;
+        ring.Read(position, &header, sizeof(header));
+
+        const uint64_t payloadSize = (uint64_t) header.nameLength + header.originalCodeSize +
+                                     (uint64_t) header.originalEHCount * sizeof(ILFlightRecorderEHClause) +
+                                     header.originalLocalSignatureSize + header.newCodeSize +
+                                     (uint64_t) header.newEHCount * sizeof(ILFlightRecorderEHClause) +
+                                     header.newLocalSignatureSize;
+
+        const bool valid = header.magic == kILFlightRecorderRecordMagic && header.position == position &&
+                           header.size % 8 == 0 && header.size <= capacity && position + header.size <= writePosition &&
+                           sizeof(header) + payloadSize <= header.size;
+        if (!valid)
+        {
+            position += 8;
+            continue;
+        }
+
+        payload.resize((size_t) payloadSize);
+        ring.Read(position + sizeof(header), payload.data(), payload.size());
+
+        const std::time_t seconds = (std::time_t)(header.timestamp / 1000000000);
+        char time[32] = {};
+        std::strftime(time, sizeof(time), "%Y-%m-%dT%H:%M:%S", std::gmtime(&seconds));
+
+        output << std::endl
+               << "#" << ++recordCount << " " << time << "." << std::setw(6) << std::setfill('0')
+               << (header.timestamp % 1000000000) / 1000 << std::setfill(' ') << "Z "
+               << std::string(reinterpret_cast<const char*>(payload.data()), header.nameLength) << std::endl;
+        output << "  module ";
+        Hex(output, header.moduleId) << ", token ";
+        Hex(output, header.methodToken) << ", " << GetKindName(header.kind) << ", hr ";
+        Hex(output, (uint32_t) header.hresult) << std::endl;
+
+        if ((header.flags & ILFlightRecorderTruncated) != 0)
+        {
+            output << "  method bodies too large for the ring, not recorded" << std::endl;
+        }
+        else
+        {
+            const uint8_t* body = payload.data() + header.nameLength;
+            RenderBody("original", body, header.originalCodeSize, header.originalEHCount,
+                       header.originalLocalSignatureSize, output);
+            body += header.originalCodeSize + header.originalEHCount * sizeof(ILFlightRecorderEHClause) +
+                    header.originalLocalSignatureSize;
+            RenderBody("rewritten", body, header.newCodeSize, header.newEHCount, header.newLocalSignatureSize,
+                       output);
+        }
+
+        position += header.size;
+    }
+
+    output << std::endl << recordCount << " records" << std::endl;
+    return true;
+}
+
+} // namespace trace
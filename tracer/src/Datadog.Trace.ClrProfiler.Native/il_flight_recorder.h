@@ -0,0 +1,137 @@
+#ifndef DD_CLR_PROFILER_IL_FLIGHT_RECORDER_H_
+#define DD_CLR_PROFILER_IL_FLIGHT_RECORDER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace trace
+{
+
+const uint32_t kILFlightRecorderFileMagic = 0x4C494444;   // "DDIL"
+const uint32_t kILFlightRecorderRecordMagic = 0x43524C49; // "ILRC"
+const uint32_t kILFlightRecorderVersion = 1;
+const uint64_t kILFlightRecorderDefaultCapacity = 4 * 1024 * 1024;
+const uint64_t kILFlightRecorderMinimumCapacity = 64 * 1024;
+
+// Same layout as IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT, offsets are relative to the IL code.
+struct ILFlightRecorderEHClause
+{
+    uint32_t flags;
+    uint32_t tryOffset;
+    uint32_t tryLength;
+    uint32_t handlerOffset;
+    uint32_t handlerLength;
+    uint32_t classTokenOrFilterOffset;
+};
+
+// One side (before or after the rewrite) of a recorded method body.
+struct ILFlightRecorderBody
+{
+    const uint8_t* code = nullptr;
+    uint32_t codeSize = 0;
+    const ILFlightRecorderEHClause* ehClauses = nullptr;
+    uint32_t ehCount = 0;
+    const uint8_t* localSignature = nullptr;
+    uint32_t localSignatureSize = 0;
+};
+
+struct ILFlightRecorderFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t processId;
+    uint64_t capacity;
+    uint64_t startTimestamp;
+    std::atomic<uint64_t> writePosition;
+    uint64_t reserved[3];
+};
+
+// The CallTarget values match CallTargetKind.
+enum class ILFlightRecorderRewriteKind : uint16_t
+{
+    CallTargetDefault = 0,
+    CallTargetBeginOnly = 1,
+    CallTargetEndOnly = 2,
+    CallSiteReplacement = 3,
+    CallSiteInsertion = 4
+};
+
+enum ILFlightRecorderRecordFlags : uint16_t
+{
+    // The bodies did not fit in the ring and were left out of the record.
+    ILFlightRecorderTruncated = 1
+};
+
+// Every record starts on an 8 byte boundary with this header, followed by the UTF-8 method name,
+// the original code, EH clauses and local signature, and then the same three for the new body.
+struct ILFlightRecorderRecordHeader
+{
+    uint32_t magic;
+    uint32_t size;
+    uint64_t position;
+    uint64_t timestamp;
+    uint64_t moduleId;
+    uint32_t methodToken;
+    int32_t hresult;
+    uint16_t kind;
+    uint16_t flags;
+    uint32_t nameLength;
+    uint32_t originalCodeSize;
+    uint32_t originalEHCount;
+    uint32_t originalLocalSignatureSize;
+    uint32_t newCodeSize;
+    uint32_t newEHCount;
+    uint32_t newLocalSignatureSize;
+};
+
+/// <summary>
+/// Binary log of IL rewrites, enabled with DD_TRACE_IL_FLIGHT_RECORDER_ENABLED. Once enabled it records
+/// every rewrite: records are appended to a fixed-size ring that lives in a memory mapped file, so the
+/// last rewrites before a crash can be recovered from the file without the process having flushed anything.
+/// Writers reserve space with a single atomic add and publish the record by storing its magic last; the
+/// offline decoder skips records that were torn or overwritten and renders the rest as text.
+/// </summary>
+class ILFlightRecorder
+{
+private:
+    void* m_mapping = nullptr;
+    uint64_t m_mappingSize = 0;
+    ILFlightRecorderFileHeader* m_header = nullptr;
+    uint8_t* m_data = nullptr;
+    uint64_t m_capacity = 0;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+
+    void Write(uint64_t position, const void* source, size_t size);
+
+public:
+    ILFlightRecorder() = default;
+    ~ILFlightRecorder();
+
+    ILFlightRecorder(const ILFlightRecorder&) = delete;
+    ILFlightRecorder& operator=(const ILFlightRecorder&) = delete;
+
+    // Creates (or truncates) the file at path and maps a ring of the given capacity.
+    bool Open(const std::string& path, uint64_t capacity);
+    void Close();
+    bool IsOpen() const;
+
+    void Record(uint64_t moduleId, uint32_t methodToken, ILFlightRecorderRewriteKind kind, int32_t hresult,
+                const std::string& name,
+                const ILFlightRecorderBody& original, const ILFlightRecorderBody& rewritten);
+
+    // Offline decoder: renders every intact record of a recorder file, oldest first.
+    static bool Decode(const std::string& path, std::ostream& output);
+    static bool Decode(const uint8_t* file, size_t fileSize, std::ostream& output);
+    static void Disassemble(const uint8_t* code, uint32_t codeSize, std::ostream& output);
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_IL_FLIGHT_RECORDER_H_
@@ -0,0 +1,17 @@
+#include <iostream>
+
+#include "il_flight_recorder.h"
+
+// Offline decoder for the files written by the IL flight recorder (DD_TRACE_IL_FLIGHT_RECORDER_ENABLED), found
+// next to the native log files as dotnet-tracer-il-<pid>.bin.
+// Usage: Datadog.Trace.ClrProfiler.ILFlightRecorderDecoder <file>
+int main(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <il flight recorder file>" << std::endl;
+        return 2;
+    }
+
+    return trace::ILFlightRecorder::Decode(argv[1], std::cout) ? 0 : 1;
+}
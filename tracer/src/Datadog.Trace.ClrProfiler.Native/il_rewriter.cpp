@@ -113,13 +113,19 @@ ILRewriter::ILRewriter(ICorProfilerInfo* pICorProfilerInfo, ICorProfilerFunction
     m_moduleId(moduleID),
     m_tkMethod(tkMethod),
     m_fGenerateTinyHeader(false),
+    m_fCompactEncoding(false),
     m_pEH(nullptr),
+    m_pOriginalCode(nullptr),
+    m_pOriginalEH(nullptr),
+    m_nOriginalEH(0),
+    m_tkOriginalLocalVarSig(mdTokenNil),
     m_pOffsetToInstr(nullptr),
     m_pOutputBuffer(nullptr),
     m_pIMethodMalloc(nullptr)
 {
     m_IL.m_pNext = &m_IL;
     m_IL.m_pPrev = &m_IL;
+    m_IL.m_offset = 0;
 
     m_nInstrs = 0;
 }
@@ -169,11 +175,70 @@ unsigned ILRewriter::GetEHCount()
     return m_nEH;
 }
 
+unsigned ILRewriter::GetOriginalCodeSize()
+{
+    // Size of the IL code read by Import()
+    return m_CodeSize;
+}
+
+unsigned ILRewriter::GetExportedCodeSize()
+{
+    // Export() stores the size of the generated IL code in the list head offset
+    return m_IL.m_offset;
+}
+
 EHClause* ILRewriter::GetEHPointer()
 {
     return m_pEH;
 }
 
+void ILRewriter::SetCompactEncoding(bool enabled)
+{
+    m_fCompactEncoding = enabled;
+}
+
+LPCBYTE ILRewriter::GetOriginalCode()
+{
+    return m_pOriginalCode;
+}
+
+unsigned ILRewriter::GetOriginalEHCount()
+{
+    return m_nOriginalEH;
+}
+
+void ILRewriter::GetOriginalEHClause(unsigned index, IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT* pClause)
+{
+    // Tiny clauses are expanded into the scratch buffer
+    COR_ILMETHOD_SECT_EH_CLAUSE_FAT scratch;
+    *pClause = *(const IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT*) m_pOriginalEH->EHClause(index, &scratch);
+}
+
+mdToken ILRewriter::GetOriginalTkLocalVarSig()
+{
+    return m_tkOriginalLocalVarSig;
+}
+
+LPCBYTE ILRewriter::GetExportedCode()
+{
+    return m_pOutputBuffer;
+}
+
+void ILRewriter::GetExportedEHClause(unsigned index, IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT* pClause)
+{
+    EHClause* pSrc = &(m_pEH[index]);
+
+    pClause->Flags = pSrc->m_Flags;
+    pClause->TryOffset = pSrc->m_pTryBegin->m_offset;
+    pClause->TryLength = pSrc->m_pTryEnd->m_offset - pSrc->m_pTryBegin->m_offset;
+    pClause->HandlerOffset = pSrc->m_pHandlerBegin->m_offset;
+    pClause->HandlerLength = pSrc->m_pHandlerEnd->m_pNext->m_offset - pSrc->m_pHandlerBegin->m_offset;
+    if ((pSrc->m_Flags & COR_ILEXCEPTION_CLAUSE_FILTER) == 0)
+        pClause->ClassToken = pSrc->m_ClassToken;
+    else
+        pClause->FilterOffset = pSrc->m_pFilter->m_offset;
+}
+
 void ILRewriter::SetEHClause(EHClause* ehPointer, unsigned ehLength)
 {
     if (m_pEH != nullptr)
@@ -193,6 +258,11 @@ HRESULT ILRewriter::Import()
 
     IfFailRet(m_pICorProfilerInfo->GetILFunctionBody(m_moduleId, m_tkMethod, &pMethodBytes, nullptr));
 
+    return ImportMethodBody(pMethodBytes);
+}
+
+HRESULT ILRewriter::ImportMethodBody(LPCBYTE pMethodBytes)
+{
     COR_ILMETHOD_DECODER decoder((COR_ILMETHOD*) pMethodBytes);
 
     // Import the header flags
@@ -202,6 +272,11 @@ HRESULT ILRewriter::Import()
 
     m_CodeSize = decoder.GetCodeSize();
 
+    m_pOriginalCode = decoder.Code;
+    m_pOriginalEH = decoder.EH;
+    m_nOriginalEH = decoder.EHCount();
+    m_tkOriginalLocalVarSig = m_tkLocalVarSig;
+
     IfFailRet(ImportIL(decoder.Code));
 
     IfFailRet(ImportEH(decoder.EH, decoder.EHCount()));
@@ -453,12 +528,119 @@ ILInstr* ILRewriter::GetILList()
     return &m_IL;
 }
 
-HRESULT ILRewriter::Export()
+void ILRewriter::CompactEncoding()
 {
+    static const unsigned ldargOpcodes[] = {CEE_LDARG_0, CEE_LDARG_1, CEE_LDARG_2, CEE_LDARG_3};
+    static const unsigned ldlocOpcodes[] = {CEE_LDLOC_0, CEE_LDLOC_1, CEE_LDLOC_2, CEE_LDLOC_3};
+    static const unsigned stlocOpcodes[] = {CEE_STLOC_0, CEE_STLOC_1, CEE_STLOC_2, CEE_STLOC_3};
+
+    for (ILInstr* pInstr = m_IL.m_pNext; pInstr != &m_IL; pInstr = pInstr->m_pNext)
+    {
+        const unsigned opcode = pInstr->m_opcode;
+
+        // Variable access: ldarg/ldloc/stloc N -> the macro form for 0..3, the .s form up to 255
+        const unsigned* macroOpcodes = nullptr;
+        unsigned shortOpcode = 0;
+        unsigned index = 0;
+        switch (opcode)
+        {
+            case CEE_LDARG:
+            case CEE_LDLOC:
+            case CEE_STLOC:
+            case CEE_LDARGA:
+            case CEE_LDLOCA:
+            case CEE_STARG:
+                index = (UINT16) pInstr->m_Arg16;
+                break;
+            case CEE_LDARG_S:
+            case CEE_LDLOC_S:
+            case CEE_STLOC_S:
+                index = (BYTE) pInstr->m_Arg8;
+                break;
+        }
+
+        switch (opcode)
+        {
+            case CEE_LDARG:
+            case CEE_LDARG_S:
+                macroOpcodes = ldargOpcodes;
+                shortOpcode = CEE_LDARG_S;
+                break;
+            case CEE_LDLOC:
+            case CEE_LDLOC_S:
+                macroOpcodes = ldlocOpcodes;
+                shortOpcode = CEE_LDLOC_S;
+                break;
+            case CEE_STLOC:
+            case CEE_STLOC_S:
+                macroOpcodes = stlocOpcodes;
+                shortOpcode = CEE_STLOC_S;
+                break;
+            case CEE_LDARGA:
+                shortOpcode = CEE_LDARGA_S;
+                break;
+            case CEE_LDLOCA:
+                shortOpcode = CEE_LDLOCA_S;
+                break;
+            case CEE_STARG:
+                shortOpcode = CEE_STARG_S;
+                break;
+        }
+
+        if (shortOpcode != 0)
+        {
+            if (macroOpcodes != nullptr && index <= 3)
+            {
+                pInstr->m_opcode = macroOpcodes[index];
+            }
+            else if (index <= 0xFF)
+            {
+                pInstr->m_opcode = shortOpcode;
+                pInstr->m_Arg8 = (INT8) index;
+            }
+            continue;
+        }
+
+        // Constants: ldc.i4 -> ldc.i4.m1 .. ldc.i4.8, or ldc.i4.s for a signed byte
+        if (opcode == CEE_LDC_I4 || opcode == CEE_LDC_I4_S)
+        {
+            const INT32 value = opcode == CEE_LDC_I4 ? pInstr->m_Arg32 : pInstr->m_Arg8;
+            if (value >= -1 && value <= 8)
+            {
+                pInstr->m_opcode = CEE_LDC_I4_0 + value;
+            }
+            else if ((INT8) value == value)
+            {
+                pInstr->m_opcode = CEE_LDC_I4_S;
+                pInstr->m_Arg8 = (INT8) value;
+            }
+            continue;
+        }
+
+        // Branches: start from the short form, Export() widens the ones whose target is out of range
+        if (opcode >= CEE_BR && opcode <= CEE_BLT_UN)
+        {
+            pInstr->m_opcode = opcode - CEE_BR + CEE_BR_S;
+        }
+        else if (opcode == CEE_LEAVE)
+        {
+            pInstr->m_opcode = CEE_LEAVE_S;
+        }
+    }
+}
+
+HRESULT ILRewriter::ExportCode()
+{
+    if (m_fCompactEncoding)
+    {
+        CompactEncoding();
+    }
+
     // One instruction produces 2 + sizeof(native int) bytes in the worst case
     // which can be 10 bytes for 64-bit. For simplification we just use 10 here.
     unsigned maxSize = m_nInstrs * 10;
 
+    delete[] m_pOutputBuffer;
     m_pOutputBuffer = new BYTE[maxSize];
     IfNullRet(m_pOutputBuffer);
 
@@ -604,10 +786,20 @@ again:
         if (fTryAgain) goto again;
     }
 
-    unsigned codeSize = offset;
+    return S_OK;
+}
+
+HRESULT ILRewriter::Export()
+{
+    IfFailRet(ExportCode());
+
+    const unsigned codeSize = GetExportedCodeSize();
     unsigned totalSize;
     LPBYTE pBody = NULL;
-    if (m_fGenerateTinyHeader)
+
+    // A tiny header saves 11 bytes but can't describe locals, EH clauses or a max stack above 8
+    const bool fTinyHeaderFits = codeSize < 64 && m_tkLocalVarSig == mdTokenNil && m_nEH == 0 && m_maxStack <= 8;
+    if (m_fGenerateTinyHeader || (m_fCompactEncoding && fTinyHeaderFits))
     {
         // Make sure we can fit in a tiny header
         if (codeSize >= 64) return E_FAIL;
@@ -629,7 +821,7 @@ again:
     {
         // Use FAT header
 
-        unsigned alignedCodeSize = (offset + 3) & ~3;
+        unsigned alignedCodeSize = (codeSize + 3) & ~3;
 
         totalSize =
             sizeof(IMAGE_COR_ILMETHOD_FAT) + alignedCodeSize +
@@ -644,7 +836,7 @@ again:
         pHeader->Flags = m_flags | (m_nEH ? CorILMethod_MoreSects : 0) | CorILMethod_FatFormat;
         pHeader->Size = sizeof(IMAGE_COR_ILMETHOD_FAT) / sizeof(DWORD);
         pHeader->MaxStack = m_maxStack;
-        pHeader->CodeSize = offset;
+        pHeader->CodeSize = codeSize;
         pHeader->LocalVarSigTok = m_tkLocalVarSig;
 
         pCurrent = (BYTE*) (pHeader + 1);
@@ -663,18 +855,8 @@ again:
 
             for (unsigned iEH = 0; iEH < m_nEH; iEH++)
             {
-                EHClause* pSrc = &(m_pEH[iEH]);
                 IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT* pDst = (IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT*) pCurrent;
-
-                pDst->Flags = pSrc->m_Flags;
-                pDst->TryOffset = pSrc->m_pTryBegin->m_offset;
-                pDst->TryLength = pSrc->m_pTryEnd->m_offset - pSrc->m_pTryBegin->m_offset;
-                pDst->HandlerOffset = pSrc->m_pHandlerBegin->m_offset;
-                pDst->HandlerLength = pSrc->m_pHandlerEnd->m_pNext->m_offset - pSrc->m_pHandlerBegin->m_offset;
-                if ((pSrc->m_Flags & COR_ILEXCEPTION_CLAUSE_FILTER) == 0)
-                    pDst->ClassToken = pSrc->m_ClassToken;
-                else
-                    pDst->FilterOffset = pSrc->m_pFilter->m_offset;
+                GetExportedEHClause(iEH, pDst);
 
                 pCurrent = (BYTE*) (pDst + 1);
             }
@@ -64,12 +64,19 @@ private:
     unsigned m_maxStack;
     unsigned m_flags;
     bool m_fGenerateTinyHeader;
+    bool m_fCompactEncoding;
 
     ILInstr m_IL; // Double linked list of all il instructions
 
     unsigned m_nEH;
     EHClause* m_pEH;
 
+    // Method body read by Import(), kept for the IL flight recorder
+    LPCBYTE m_pOriginalCode;
+    const COR_ILMETHOD_SECT_EH* m_pOriginalEH;
+    unsigned m_nOriginalEH;
+    mdToken m_tkOriginalLocalVarSig;
+
     // Helper table for importing.  Sparse array that maps BYTE offset of
     // beginning of an instruction to that instruction's ILInstr*.  BYTE offsets
     // that don't correspond to the beginning of an instruction are mapped to
@@ -97,10 +104,32 @@ public:
 
     unsigned GetEHCount();
 
+    unsigned GetOriginalCodeSize();
+
+    unsigned GetExportedCodeSize();
+
     EHClause* GetEHPointer();
 
+    LPCBYTE GetOriginalCode();
+
+    unsigned GetOriginalEHCount();
+
+    void GetOriginalEHClause(unsigned index, IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT* pClause);
+
+    mdToken GetOriginalTkLocalVarSig();
+
+    // Code generated by the last Export(), GetExportedCodeSize() bytes long
+    LPCBYTE GetExportedCode();
+
+    void GetExportedEHClause(unsigned index, IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT* pClause);
+
     void SetEHClause(EHClause* ehPointer, unsigned ehLength);
 
+    // When enabled, Export() rewrites instructions to their shortest encoding (macro and .s forms of
+    // ldarg/ldloc/stloc/ldc.i4, short branches widened only when the target is out of range) and
+    // uses a tiny header whenever the method allows it. The stack behaviour is unchanged.
+    void SetCompactEncoding(bool enabled);
+
     /////////////////////////////////////////////////////////////////////////////////////////////////
     //
     // I M P O R T
@@ -109,6 +138,9 @@ public:
 
     HRESULT Import();
 
+    // Imports a method body (header, code and EH sections) that was not obtained from the runtime
+    HRESULT ImportMethodBody(LPCBYTE pMethodBytes);
+
     HRESULT ImportIL(LPCBYTE pIL);
 
     HRESULT ImportEH(const COR_ILMETHOD_SECT_EH* pILEH, unsigned nEH);
@@ -131,6 +163,12 @@ public:
     //
     ////////////////////////////////////////////////////////////////////////////////////////////////
 
+    void CompactEncoding();
+
+    // Lays out the instructions and resolves the branches, the result is available through
+    // GetExportedCode() / GetExportedCodeSize() / GetExportedEHClause()
+    HRESULT ExportCode();
+
     HRESULT Export();
 
     HRESULT SetILFunctionBody(unsigned size, LPBYTE pBody);
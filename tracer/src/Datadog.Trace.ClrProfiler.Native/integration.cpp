@@ -12,6 +12,7 @@
 
 #include "util.h"
 #include "logger.h"
+#include "stats.h"
 
 namespace trace
 {
@@ -19,6 +20,27 @@ namespace trace
 std::mutex m_assemblyReferenceCacheMutex;
 std::unordered_map<WSTRING, std::unique_ptr<AssemblyReference>> m_assemblyReferenceCache;
 
+std::mutex m_internedNamesMutex;
+std::unordered_map<WSTRING, ULONG> m_internedNames;
+
+ULONG InternName(const WSTRING& name)
+{
+    if (name.empty())
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> guard(m_internedNamesMutex);
+    auto findRes = m_internedNames.find(name);
+    if (findRes != m_internedNames.end())
+    {
+        return findRes->second;
+    }
+    const ULONG id = static_cast<ULONG>(m_internedNames.size() + 1);
+    m_internedNames[name] = id;
+    return id;
+}
+
 
 AssemblyReference::AssemblyReference(const WSTRING& str) :
     name(GetNameFromAssemblyReferenceString(str)),
@@ -38,9 +60,65 @@ AssemblyReference* AssemblyReference::GetFromCache(const WSTRING& str)
     }
     AssemblyReference* aref = new AssemblyReference(str);
     m_assemblyReferenceCache[str] = std::unique_ptr<AssemblyReference>(aref);
+    trace::Stats::Instance()->MemoryAllocated(MemoryCategory::AssemblyReference,
+                                              EstimateMemory(*aref) + EstimateMemory(str));
     return aref;
 }
 
+size_t EstimateMemory(const WSTRING& str)
+{
+    return str.size() * sizeof(WCHAR);
+}
+
+namespace
+{
+    // Heap memory owned by the members, without the structure itself
+    size_t OwnedMemory(const AssemblyReference& assembly_reference)
+    {
+        return EstimateMemory(assembly_reference.name) + EstimateMemory(assembly_reference.locale);
+    }
+
+    size_t OwnedMemory(const MethodReference& method_reference)
+    {
+        size_t size = OwnedMemory(method_reference.assembly) + EstimateMemory(method_reference.type_name) +
+                      EstimateMemory(method_reference.method_name) + EstimateMemory(method_reference.action) +
+                      method_reference.method_signature.data.size() +
+                      method_reference.signature_types.size() * sizeof(WSTRING);
+        for (const auto& signature_type : method_reference.signature_types)
+        {
+            size += EstimateMemory(signature_type);
+        }
+        return size;
+    }
+
+    size_t OwnedMemory(const MethodReplacement& method_replacement)
+    {
+        return OwnedMemory(method_replacement.caller_method) + OwnedMemory(method_replacement.target_method) +
+               OwnedMemory(method_replacement.wrapper_method);
+    }
+} // namespace
+
+size_t EstimateMemory(const AssemblyReference& assembly_reference)
+{
+    return sizeof(AssemblyReference) + OwnedMemory(assembly_reference);
+}
+
+size_t EstimateMemory(const MethodReference& method_reference)
+{
+    return sizeof(MethodReference) + OwnedMemory(method_reference);
+}
+
+size_t EstimateMemory(const MethodReplacement& method_replacement)
+{
+    return sizeof(MethodReplacement) + OwnedMemory(method_replacement);
+}
+
+size_t EstimateMemory(const IntegrationMethod& integration_method)
+{
+    return sizeof(IntegrationMethod) + EstimateMemory(integration_method.integration_name) +
+           OwnedMemory(integration_method.replacement);
+}
+
 namespace
 {
 
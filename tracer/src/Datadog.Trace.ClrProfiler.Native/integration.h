@@ -2,6 +2,7 @@
 #define DD_CLR_PROFILER_INTEGRATION_H_
 
 #include <corhlpr.h>
+#include <cstdint>
 #include <iomanip>
 #include <sstream>
 #include <vector>
@@ -82,6 +83,13 @@ struct Version
         return ToWSTRING(ss.str());
     }
 
+    // Packs the four components into a single integer preserving equality, used for cache keys.
+    inline uint64_t packed() const
+    {
+        return (static_cast<uint64_t>(major) << 48) | (static_cast<uint64_t>(minor) << 32) |
+               (static_cast<uint64_t>(build) << 16) | static_cast<uint64_t>(revision);
+    }
+
     inline bool operator<(const Version& other) const
     {
         if (major < other.major)
@@ -237,6 +245,65 @@ public:
     }
 };
 
+// Returns a process wide id for the given name. The empty name is always 0.
+ULONG InternName(const WSTRING& name);
+
+enum class WrapperCacheKind : ULONG
+{
+    Type = 1,
+    Method = 2
+};
+
+// WrapperCacheKey identifies a wrapper type or member inside a module without
+// building a string, names are interned ids and versions are packed.
+struct WrapperCacheKey
+{
+    WrapperCacheKind kind;
+    ULONG assembly_name_id;
+    ULONG type_name_id;
+    ULONG method_name_id;
+    uint64_t min_version;
+    uint64_t max_version;
+
+    inline bool operator==(const WrapperCacheKey& other) const
+    {
+        return kind == other.kind && assembly_name_id == other.assembly_name_id &&
+               type_name_id == other.type_name_id && method_name_id == other.method_name_id &&
+               min_version == other.min_version && max_version == other.max_version;
+    }
+};
+
+struct WrapperCacheKeyHash
+{
+    static inline uint64_t Mix(uint64_t h, uint64_t v)
+    {
+        h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        return h;
+    }
+
+    inline size_t operator()(const WrapperCacheKey& key) const
+    {
+        uint64_t h = (static_cast<uint64_t>(key.kind) << 32) | key.assembly_name_id;
+        h = Mix(h, (static_cast<uint64_t>(key.type_name_id) << 32) | key.method_name_id);
+        h = Mix(h, key.min_version);
+        h = Mix(h, key.max_version);
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+// CallTargetKind selects which CallTarget hooks are written into an instrumented method.
+// Integrations that only implement one side get a smaller method body.
+enum class CallTargetKind : USHORT
+{
+    // BeginMethod and EndMethod with the full try/catch/finally pattern.
+    Default = 0,
+    // BeginMethod call in the prologue, no extra locals nor exception handling clauses.
+    BeginOnly = 1,
+    // EndMethod call in a finally block without catch, the state argument is always CallTargetState.GetDefault()
+    // and the exception argument is always null.
+    EndOnly = 2,
+};
+
 struct MethodReference
 {
     const AssemblyReference assembly;
@@ -247,15 +314,25 @@ struct MethodReference
     const Version min_version;
     const Version max_version;
     const std::vector<WSTRING> signature_types;
+    const ULONG assembly_name_id;
+    const ULONG type_name_id;
+    const ULONG method_name_id;
+    const CallTargetKind calltarget_kind;
 
     MethodReference() :
-        min_version(Version(0, 0, 0, 0)), max_version(Version(USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX))
+        min_version(Version(0, 0, 0, 0)),
+        max_version(Version(USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX)),
+        assembly_name_id(0),
+        type_name_id(0),
+        method_name_id(0),
+        calltarget_kind(CallTargetKind::Default)
     {
     }
 
     MethodReference(const WSTRING& assembly_name, WSTRING type_name, WSTRING method_name, WSTRING action,
                     Version min_version, Version max_version, const std::vector<BYTE>& method_signature,
-                    const std::vector<WSTRING>& signature_types) :
+                    const std::vector<WSTRING>& signature_types,
+                    CallTargetKind calltarget_kind = CallTargetKind::Default) :
         assembly(*AssemblyReference::GetFromCache(assembly_name)),
         type_name(type_name),
         method_name(method_name),
@@ -263,20 +340,23 @@ struct MethodReference
         method_signature(method_signature),
         min_version(min_version),
         max_version(max_version),
-        signature_types(signature_types)
+        signature_types(signature_types),
+        assembly_name_id(InternName(assembly.name)),
+        type_name_id(InternName(type_name)),
+        method_name_id(InternName(method_name)),
+        calltarget_kind(calltarget_kind)
     {
     }
 
-    inline WSTRING get_type_cache_key() const
+    inline WrapperCacheKey get_type_cache_key() const
     {
-        return WStr("[") + assembly.name + WStr("]") + type_name + WStr("_vMin_") + min_version.str() + WStr("_vMax_") +
-               max_version.str();
+        return {WrapperCacheKind::Type, assembly_name_id, type_name_id, 0, min_version.packed(), max_version.packed()};
     }
 
-    inline WSTRING get_method_cache_key() const
+    inline WrapperCacheKey get_method_cache_key() const
     {
-        return WStr("[") + assembly.name + WStr("]") + type_name + WStr(".") + method_name + WStr("_vMin_") +
-               min_version.str() + WStr("_vMax_") + max_version.str();
+        return {WrapperCacheKind::Method, assembly_name_id, type_name_id, method_name_id, min_version.packed(),
+                max_version.packed()};
     }
 
     inline bool operator==(const MethodReference& other) const
@@ -329,6 +409,13 @@ struct IntegrationMethod
     }
 };
 
+// Approximate native memory held by the structure, reported by the memory accounting in Stats.
+size_t EstimateMemory(const WSTRING& str);
+size_t EstimateMemory(const AssemblyReference& assembly_reference);
+size_t EstimateMemory(const MethodReference& method_reference);
+size_t EstimateMemory(const MethodReplacement& method_replacement);
+size_t EstimateMemory(const IntegrationMethod& integration_method);
+
 typedef struct _CallTargetDefinition
 {
     WCHAR* targetAssembly;
@@ -344,6 +431,8 @@ typedef struct _CallTargetDefinition
     USHORT targetMaximumPatch;
     WCHAR* wrapperAssembly;
     WCHAR* wrapperType;
+    WCHAR* integrationName;
+    USHORT callTargetKind;
 } CallTargetDefinition;
 
 namespace
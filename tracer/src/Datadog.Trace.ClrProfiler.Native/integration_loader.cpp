@@ -213,6 +213,7 @@ namespace
         USHORT max_patch = USHRT_MAX;
         std::vector<WSTRING> signature_type_array;
         WSTRING action = EmptyWStr;
+        CallTargetKind calltarget_kind = CallTargetKind::Default;
 
         if (is_target_method)
         {
@@ -258,6 +259,16 @@ namespace
         else if (is_wrapper_method)
         {
             action = ToWSTRING(src.value("action", ""));
+
+            const auto kind = src.value("calltarget_kind", "");
+            if (kind == "BeginOnly")
+            {
+                calltarget_kind = CallTargetKind::BeginOnly;
+            }
+            else if (kind == "EndOnly")
+            {
+                calltarget_kind = CallTargetKind::EndOnly;
+            }
         }
 
         std::vector<BYTE> signature;
@@ -306,7 +317,8 @@ namespace
             }
         }
         return MethodReference(assembly, type, method, action, Version(min_major, min_minor, min_patch, 0),
-                               Version(max_major, max_minor, max_patch, USHRT_MAX), signature, signature_type_array);
+                               Version(max_major, max_minor, max_patch, USHRT_MAX), signature, signature_type_array,
+                               calltarget_kind);
     }
 
 } // namespace
@@ -7,6 +7,9 @@
 //---------------------------------------------------------------------------------------
 
 #include "cor_profiler.h"
+#include "span_serializer.h"
+
+#include <climits>
 
 #ifndef _WIN32
 #include <dlfcn.h>
@@ -28,6 +31,76 @@ EXTERN_C VOID STDAPICALLTYPE InitializeProfiler(WCHAR* id, trace::CallTargetDefi
     return trace::profiler->InitializeProfiler(id, items, size);
 }
 
+EXTERN_C ULONG STDAPICALLTYPE SetIntegrationEnabled(WCHAR* integrationName, BOOL enabled)
+{
+    return trace::profiler->SetIntegrationEnabled(integrationName, enabled);
+}
+
+EXTERN_C ULONG STDAPICALLTYPE GetIntegrationRewrittenMethodCount(WCHAR* integrationName)
+{
+    return trace::profiler->GetIntegrationRewrittenMethodCount(integrationName);
+}
+
+EXTERN_C HRESULT STDAPICALLTYPE SerializeSpans(const BYTE* buffer, int size, const BYTE** payload, int* payloadSize)
+{
+    if (size < 0 || payloadSize == nullptr)
+    {
+        return E_INVALIDARG;
+    }
+
+    size_t length = 0;
+    const auto hr = trace::SpanSerializer::ForCurrentThread().Serialize(buffer, (size_t) size, payload, &length);
+    if (SUCCEEDED(hr) && length > (size_t) INT_MAX)
+    {
+        // The payload size does not fit the managed int
+        *payloadSize = 0;
+        return E_OUTOFMEMORY;
+    }
+
+    *payloadSize = SUCCEEDED(hr) ? (int) length : 0;
+    return hr;
+}
+
+EXTERN_C HRESULT STDAPICALLTYPE EnqueueSpans(const BYTE* buffer, int size)
+{
+    if (trace::profiler == nullptr)
+    {
+        return E_NOTIMPL;
+    }
+
+    return trace::profiler->EnqueueSpans(buffer, size);
+}
+
+EXTERN_C HRESULT STDAPICALLTYPE FlushSpans(int timeoutMilliseconds)
+{
+    if (trace::profiler == nullptr)
+    {
+        return E_NOTIMPL;
+    }
+
+    return trace::profiler->FlushSpans(timeoutMilliseconds);
+}
+
+EXTERN_C HRESULT STDAPICALLTYPE GetGCMetrics(trace::GCMetricsSnapshot* snapshot, int size)
+{
+    if (trace::profiler == nullptr)
+    {
+        return E_NOTIMPL;
+    }
+
+    return trace::profiler->GetGCMetrics(snapshot, size);
+}
+
+EXTERN_C HRESULT STDAPICALLTYPE GetRuntimeEventMetrics(trace::RuntimeEventMetricsSnapshot* snapshot, int size)
+{
+    if (trace::profiler == nullptr)
+    {
+        return E_NOTIMPL;
+    }
+
+    return trace::profiler->GetRuntimeEventMetrics(snapshot, size);
+}
+
 #ifndef _WIN32
 EXTERN_C void *dddlopen (const char *__file, int __mode)
 {
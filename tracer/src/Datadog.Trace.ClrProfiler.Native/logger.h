@@ -69,6 +69,11 @@ public:
         LoggerImpl<TracerLoggerPolicy>::Instance()->EnableDebug();
     }
 
+    static void DisableDebug()
+    {
+        LoggerImpl<TracerLoggerPolicy>::Instance()->DisableDebug();
+    }
+
     static bool IsDebugEnabled()
     {
         return LoggerImpl<TracerLoggerPolicy>::Instance()->IsDebugEnabled();
@@ -14,6 +14,7 @@ typedef struct stat Stat;
 
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <filesystem>
@@ -51,6 +52,7 @@ public:
     void Flush();
 
     void EnableDebug();
+    void DisableDebug();
     bool IsDebugEnabled() const;
 
     static void Shutdown()
@@ -59,7 +61,7 @@ public:
     }
 
 private:
-    bool m_debug_logging_enabled;
+    std::atomic_bool m_debug_logging_enabled;
 };
 
 #ifndef _WIN32
@@ -228,6 +230,12 @@ void LoggerImpl<TLoggerPolicy>::EnableDebug()
     m_debug_logging_enabled = true;
 }
 
+template <typename TLoggerPolicy>
+void LoggerImpl<TLoggerPolicy>::DisableDebug()
+{
+    m_debug_logging_enabled = false;
+}
+
 template <typename TLoggerPolicy>
 bool LoggerImpl<TLoggerPolicy>::IsDebugEnabled() const
 {
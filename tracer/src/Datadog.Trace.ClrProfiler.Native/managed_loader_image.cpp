@@ -0,0 +1,181 @@
+#include "managed_loader_image.h"
+
+#include <chrono>
+#include <climits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <zlib.h>
+#endif
+
+namespace trace
+{
+
+namespace
+{
+    const size_t gzip_header_size = 10;
+    const size_t gzip_trailer_size = 8;
+
+    void ReleaseMapping(void* mapping, size_t size)
+    {
+#ifdef _WIN32
+        VirtualFree(mapping, 0, MEM_RELEASE);
+#else
+        munmap(mapping, size);
+#endif
+    }
+} // namespace
+
+bool IsGzip(const uint8_t* source, size_t sourceSize)
+{
+    return source != nullptr && sourceSize >= gzip_header_size + gzip_trailer_size && source[0] == 0x1F &&
+           source[1] == 0x8B;
+}
+
+size_t GetGzipSize(const uint8_t* source, size_t sourceSize)
+{
+    if (!IsGzip(source, sourceSize))
+    {
+        return 0;
+    }
+
+    const auto trailer = source + sourceSize - 4;
+    return (size_t) trailer[0] | ((size_t) trailer[1] << 8) | ((size_t) trailer[2] << 16) |
+           ((size_t) trailer[3] << 24);
+}
+
+bool GzipDecompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize)
+{
+    if (!IsGzip(source, sourceSize) || GetGzipSize(source, sourceSize) != destinationSize)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    // The Windows resources are embedded uncompressed
+    return false;
+#else
+    if (sourceSize > UINT_MAX || destinationSize > UINT_MAX)
+    {
+        return false;
+    }
+
+    z_stream stream = {};
+    stream.next_in = const_cast<Bytef*>(source);
+    stream.avail_in = (uInt) sourceSize;
+    stream.next_out = destination;
+    stream.avail_out = (uInt) destinationSize;
+
+    // 16 + MAX_WBITS: gzip wrapper, zlib checks the header, the CRC-32 and the size
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK)
+    {
+        return false;
+    }
+
+    const auto result = inflate(&stream, Z_FINISH);
+    const auto complete = result == Z_STREAM_END && stream.total_out == destinationSize && stream.avail_in == 0;
+    inflateEnd(&stream);
+    return complete;
+#endif
+}
+
+ManagedLoaderImage::ManagedLoaderImage(const uint8_t* source, size_t sourceSize) :
+    m_source(source), m_source_size(sourceSize)
+{
+}
+
+ManagedLoaderImage::~ManagedLoaderImage()
+{
+    if (m_mapping != nullptr)
+    {
+        ReleaseMapping(m_mapping, m_mapping_size);
+    }
+}
+
+void ManagedLoaderImage::Load()
+{
+    if (!IsGzip(m_source, m_source_size))
+    {
+        if (m_source != nullptr && m_source_size > 0)
+        {
+            m_data = m_source;
+            m_size = m_source_size;
+        }
+        return;
+    }
+
+    const auto size = GetGzipSize(m_source, m_source_size);
+    if (size == 0)
+    {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+#ifdef _WIN32
+    void* mapping = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (mapping == nullptr)
+    {
+        return;
+    }
+#else
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+    {
+        return;
+    }
+#endif
+
+    if (!GzipDecompress(m_source, m_source_size, static_cast<uint8_t*>(mapping), size))
+    {
+        ReleaseMapping(mapping, size);
+        return;
+    }
+
+    // Nothing writes to the image once it is handed out
+#ifdef _WIN32
+    DWORD oldProtect;
+    VirtualProtect(mapping, size, PAGE_READONLY, &oldProtect);
+#else
+    mprotect(mapping, size, PROT_READ);
+#endif
+
+    m_mapping = mapping;
+    m_mapping_size = size;
+    m_data = static_cast<const uint8_t*>(mapping);
+    m_size = size;
+    m_decompress_ns = (std::chrono::steady_clock::now() - start).count();
+}
+
+bool ManagedLoaderImage::Get(const uint8_t** data, size_t* size)
+{
+    std::call_once(m_once, [this] { Load(); });
+
+    if (m_data == nullptr)
+    {
+        return false;
+    }
+
+    *data = m_data;
+    *size = m_size;
+    return true;
+}
+
+bool ManagedLoaderImage::IsCompressed() const
+{
+    return IsGzip(m_source, m_source_size);
+}
+
+size_t ManagedLoaderImage::GetCompressedSize() const
+{
+    return m_source_size;
+}
+
+unsigned long long ManagedLoaderImage::GetDecompressNanoseconds() const
+{
+    return m_decompress_ns;
+}
+
+} // namespace trace
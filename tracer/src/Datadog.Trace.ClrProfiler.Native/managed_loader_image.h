@@ -0,0 +1,62 @@
+#ifndef DD_CLR_PROFILER_MANAGED_LOADER_IMAGE_H_
+#define DD_CLR_PROFILER_MANAGED_LOADER_IMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace trace
+{
+
+// True when the bytes start with the gzip magic number (RFC 1952)
+bool IsGzip(const uint8_t* source, size_t sourceSize);
+
+// Uncompressed size stored in the gzip trailer (ISIZE), 0 when the bytes are not gzip
+size_t GetGzipSize(const uint8_t* source, size_t sourceSize);
+
+// Inflates a single member gzip stream into destination, which must be GetGzipSize bytes long.
+// Returns false when the stream is malformed, truncated or fails the CRC-32 and size checks, and always on Windows.
+bool GzipDecompress(const uint8_t* source, size_t sourceSize, uint8_t* destination, size_t destinationSize);
+
+/// <summary>
+/// Managed loader assembly or symbols embedded in the native library. The Linux and macOS builds store them gzip
+/// compressed and the first Get inflates them with the system zlib into an anonymous mapping, which is then made
+/// read-only: every AppDomain startup hook copies from that single mapping. The mapping lives as long as the
+/// process, the startup hooks of several modules can still be copying from it after one of them has loaded the
+/// managed profiler. Bytes that are not gzip compressed, like the Windows resources, are handed out as they are,
+/// straight from the file-backed image.
+/// </summary>
+class ManagedLoaderImage
+{
+private:
+    const uint8_t* m_source;
+    size_t m_source_size;
+
+    std::once_flag m_once;
+    void* m_mapping = nullptr;
+    size_t m_mapping_size = 0;
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    unsigned long long m_decompress_ns = 0;
+
+    void Load();
+
+public:
+    ManagedLoaderImage(const uint8_t* source, size_t sourceSize);
+    ~ManagedLoaderImage();
+
+    ManagedLoaderImage(const ManagedLoaderImage&) = delete;
+    ManagedLoaderImage& operator=(const ManagedLoaderImage&) = delete;
+
+    // Uncompressed bytes, decompressed by the first caller. Returns false when they can't be decompressed.
+    bool Get(const uint8_t** data, size_t* size);
+
+    bool IsCompressed() const;
+    size_t GetCompressedSize() const;
+    // Time spent by the decompression, 0 before the first Get or for uncompressed bytes
+    unsigned long long GetDecompressNanoseconds() const;
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_MANAGED_LOADER_IMAGE_H_
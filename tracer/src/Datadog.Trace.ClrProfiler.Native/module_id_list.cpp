@@ -0,0 +1,44 @@
+#include "module_id_list.h"
+
+#include <algorithm>
+
+#include "stats.h"
+
+namespace trace
+{
+
+void ModuleIdList::Add(ModuleID moduleId)
+{
+    m_module_ids.push_back(moduleId);
+    Stats::Instance()->MemoryAllocated(MemoryCategory::ModuleId, sizeof(ModuleID));
+}
+
+bool ModuleIdList::Remove(ModuleID moduleId)
+{
+    const auto find_res = std::find(m_module_ids.begin(), m_module_ids.end(), moduleId);
+    if (find_res == m_module_ids.end())
+    {
+        return false;
+    }
+
+    m_module_ids.erase(find_res);
+    Stats::Instance()->MemoryReleased(MemoryCategory::ModuleId, sizeof(ModuleID));
+    return true;
+}
+
+bool ModuleIdList::Contains(ModuleID moduleId) const
+{
+    return std::find(m_module_ids.begin(), m_module_ids.end(), moduleId) != m_module_ids.end();
+}
+
+const std::vector<ModuleID>& ModuleIdList::Get() const
+{
+    return m_module_ids;
+}
+
+size_t ModuleIdList::Size() const
+{
+    return m_module_ids.size();
+}
+
+} // namespace trace
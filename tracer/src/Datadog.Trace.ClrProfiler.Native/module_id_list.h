@@ -0,0 +1,33 @@
+#ifndef DD_CLR_PROFILER_MODULE_ID_LIST_H_
+#define DD_CLR_PROFILER_MODULE_ID_LIST_H_
+
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+namespace trace
+{
+
+/// <summary>
+/// Modules analyzed for CallTarget. ModuleLoadFinished adds them and ModuleUnloadStarted removes them, so
+/// InitializeProfiler and the integration toggles never enqueue a module that has been unloaded. Every add and
+/// remove is reported to the ModuleId memory counter of Stats. The caller synchronizes the accesses.
+/// </summary>
+class ModuleIdList
+{
+private:
+    std::vector<ModuleID> m_module_ids;
+
+public:
+    void Add(ModuleID moduleId);
+    // Returns false if the module was not in the list.
+    bool Remove(ModuleID moduleId);
+    bool Contains(ModuleID moduleId) const;
+    const std::vector<ModuleID>& Get() const;
+    size_t Size() const;
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_MODULE_ID_LIST_H_
@@ -4,27 +4,37 @@
 #include <corhlpr.h>
 #include <mutex>
 #include <unordered_map>
-#include <unordered_set>
 
 #include "calltarget_tokens.h"
 #include "clr_helpers.h"
 #include "com_ptr.h"
 #include "integration.h"
+#include "stats.h"
 #include "string.h"
 
 namespace trace
 {
 
+struct WrapperCacheEntry
+{
+    mdToken token;
+    bool failed;
+};
+
 class ModuleMetadata
 {
 private:
     std::mutex wrapper_mutex;
-    std::unique_ptr<std::unordered_map<WSTRING, mdMemberRef>> wrapper_refs = nullptr;
-    std::unique_ptr<std::unordered_map<WSTRING, mdTypeRef>> wrapper_parent_type = nullptr;
-    std::unique_ptr<std::unordered_set<WSTRING>> failed_wrapper_keys = nullptr;
+    // Wrapper type refs, member refs and failed member keys share a single table,
+    // the key kind tells type entries and member entries apart.
+    std::unique_ptr<std::unordered_map<WrapperCacheKey, WrapperCacheEntry, WrapperCacheKeyHash>> wrapper_cache =
+        nullptr;
     std::unique_ptr<CallTargetTokens> calltargetTokens = nullptr;
     std::unique_ptr<std::vector<IntegrationMethod>> integrations = nullptr;
 
+    // Bytes reported to Stats for this module, released in the destructor
+    size_t accounted_bytes = 0;
+
 public:
     const ComPtr<IMetaDataImport2> metadata_import{};
     const ComPtr<IMetaDataEmit2> metadata_emit{};
@@ -50,6 +60,7 @@ public:
         integrations(std::move(integrations)),
         corAssemblyProperty(corAssemblyProperty)
     {
+        AccountConstruction();
     }
 
     ModuleMetadata(ComPtr<IMetaDataImport2> metadata_import, ComPtr<IMetaDataEmit2> metadata_emit,
@@ -64,92 +75,57 @@ public:
         module_version_id(),
         corAssemblyProperty(corAssemblyProperty)
     {
+        AccountConstruction();
     }
 
-    bool TryGetWrapperMemberRef(const WSTRING& keyIn, mdMemberRef& valueOut) const
+    ~ModuleMetadata()
     {
-        if (wrapper_refs == nullptr)
-        {
-            return false;
-        }
-
-        const auto search = wrapper_refs->find(keyIn);
-
-        if (search != wrapper_refs->end())
-        {
-            valueOut = search->second;
-            return true;
-        }
-
-        return false;
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::ModuleMetadata, accounted_bytes);
     }
 
-    bool TryGetWrapperParentTypeRef(const WSTRING& keyIn, mdTypeRef& valueOut) const
+    bool TryGetWrapperMemberRef(const WrapperCacheKey& keyIn, mdMemberRef& valueOut) const
     {
-        if (wrapper_parent_type == nullptr)
+        const auto entry = FindWrapperEntry(keyIn);
+        if (entry == nullptr || entry->failed)
         {
             return false;
         }
 
-        const auto search = wrapper_parent_type->find(keyIn);
-
-        if (search != wrapper_parent_type->end())
-        {
-            valueOut = search->second;
-            return true;
-        }
-
-        return false;
+        valueOut = entry->token;
+        return true;
     }
 
-    bool IsFailedWrapperMemberKey(const WSTRING& key) const
+    bool TryGetWrapperParentTypeRef(const WrapperCacheKey& keyIn, mdTypeRef& valueOut) const
     {
-        if (failed_wrapper_keys == nullptr)
+        const auto entry = FindWrapperEntry(keyIn);
+        if (entry == nullptr || entry->failed)
         {
             return false;
         }
 
-        const auto search = failed_wrapper_keys->find(key);
-
-        if (search != failed_wrapper_keys->end())
-        {
-            return true;
-        }
-
-        return false;
+        valueOut = entry->token;
+        return true;
     }
 
-    void SetWrapperMemberRef(const WSTRING& keyIn, const mdMemberRef valueIn)
+    bool IsFailedWrapperMemberKey(const WrapperCacheKey& key) const
     {
-        std::scoped_lock<std::mutex> lock(wrapper_mutex);
-        if (wrapper_refs == nullptr)
-        {
-            wrapper_refs = std::make_unique<std::unordered_map<WSTRING, mdMemberRef>>();
-        }
-
-        (*wrapper_refs)[keyIn] = valueIn;
+        const auto entry = FindWrapperEntry(key);
+        return entry != nullptr && entry->failed;
     }
 
-    void SetWrapperParentTypeRef(const WSTRING& keyIn, const mdTypeRef valueIn)
+    void SetWrapperMemberRef(const WrapperCacheKey& keyIn, const mdMemberRef valueIn)
     {
-        std::scoped_lock<std::mutex> lock(wrapper_mutex);
-        if (wrapper_parent_type == nullptr)
-        {
-            wrapper_parent_type = std::make_unique<std::unordered_map<WSTRING, mdTypeRef>>();
-        }
-
-        (*wrapper_parent_type)[keyIn] = valueIn;
+        SetWrapperEntry(keyIn, {valueIn, false});
     }
 
-    void SetFailedWrapperMemberKey(const WSTRING& key)
+    void SetWrapperParentTypeRef(const WrapperCacheKey& keyIn, const mdTypeRef valueIn)
     {
-        std::scoped_lock<std::mutex> lock(wrapper_mutex);
-        if (failed_wrapper_keys == nullptr)
-        {
-            failed_wrapper_keys = std::make_unique<std::unordered_set<WSTRING>>();
-        }
+        SetWrapperEntry(keyIn, {valueIn, false});
+    }
 
-        failed_wrapper_keys->insert(key);
+    void SetFailedWrapperMemberKey(const WrapperCacheKey& key)
+    {
+        SetWrapperEntry(key, {mdTokenNil, true});
     }
 
     std::vector<MethodReplacement> GetMethodReplacementsForCaller(const trace::FunctionInfo& caller)
@@ -178,9 +154,62 @@ public:
         if (calltargetTokens == nullptr)
         {
             calltargetTokens = std::make_unique<CallTargetTokens>(this);
+            AccountMemory(sizeof(CallTargetTokens));
         }
         return calltargetTokens.get();
     }
+
+private:
+    void AccountConstruction()
+    {
+        accounted_bytes = sizeof(ModuleMetadata) + EstimateMemory(assemblyName);
+        if (integrations != nullptr)
+        {
+            for (const auto& integration : *integrations)
+            {
+                accounted_bytes += EstimateMemory(integration);
+            }
+        }
+        trace::Stats::Instance()->MemoryAllocated(MemoryCategory::ModuleMetadata, accounted_bytes);
+    }
+
+    void AccountMemory(size_t bytes)
+    {
+        accounted_bytes += bytes;
+        trace::Stats::Instance()->MemoryAllocated(MemoryCategory::ModuleMetadata, bytes, 0);
+    }
+
+    const WrapperCacheEntry* FindWrapperEntry(const WrapperCacheKey& key) const
+    {
+        if (wrapper_cache == nullptr)
+        {
+            return nullptr;
+        }
+
+        const auto search = wrapper_cache->find(key);
+        if (search != wrapper_cache->end())
+        {
+            return &search->second;
+        }
+
+        return nullptr;
+    }
+
+    void SetWrapperEntry(const WrapperCacheKey& key, const WrapperCacheEntry& entry)
+    {
+        std::scoped_lock<std::mutex> lock(wrapper_mutex);
+        if (wrapper_cache == nullptr)
+        {
+            wrapper_cache =
+                std::make_unique<std::unordered_map<WrapperCacheKey, WrapperCacheEntry, WrapperCacheKeyHash>>();
+        }
+
+        if (wrapper_cache->insert_or_assign(key, entry).second)
+        {
+            // key, entry and the node pointers of the bucket list
+            AccountMemory(sizeof(WrapperCacheKey) + sizeof(WrapperCacheEntry) + 2 * sizeof(void*));
+        }
+    }
 };
 
 } // namespace trace
@@ -0,0 +1,83 @@
+#include "precompiled_code_index.h"
+
+#include <mutex>
+
+namespace trace
+{
+
+bool PrecompiledCodeIndex::AddMethod(ModuleID moduleId, mdMethodDef methodDef)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    if (m_methods[moduleId].insert(methodDef).second)
+    {
+        m_methodCount++;
+        return true;
+    }
+
+    return false;
+}
+
+void PrecompiledCodeIndex::AddMethods(const std::vector<ModuleID>& modules, const std::vector<mdMethodDef>& methodDefs)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    for (size_t i = 0; i < modules.size() && i < methodDefs.size(); i++)
+    {
+        if (m_methods[modules[i]].insert(methodDefs[i]).second)
+        {
+            m_methodCount++;
+        }
+    }
+}
+
+bool PrecompiledCodeIndex::ContainsMethod(ModuleID moduleId, mdMethodDef methodDef) const
+{
+    std::shared_lock<std::shared_mutex> guard(m_lock);
+    const auto find_res = m_methods.find(moduleId);
+    return find_res != m_methods.end() && find_res->second.find(methodDef) != find_res->second.end();
+}
+
+void PrecompiledCodeIndex::AddStartupHookModule(ModuleID moduleId, AppDomainID appDomainId)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    m_startupHookModules[moduleId] = appDomainId;
+}
+
+bool PrecompiledCodeIndex::TryGetStartupHookAppDomain(ModuleID moduleId, AppDomainID* appDomainId) const
+{
+    std::shared_lock<std::shared_mutex> guard(m_lock);
+    const auto find_res = m_startupHookModules.find(moduleId);
+    if (find_res == m_startupHookModules.end())
+    {
+        return false;
+    }
+
+    *appDomainId = find_res->second;
+    return true;
+}
+
+void PrecompiledCodeIndex::RemoveModule(ModuleID moduleId)
+{
+    std::unique_lock<std::shared_mutex> guard(m_lock);
+    const auto find_res = m_methods.find(moduleId);
+    if (find_res != m_methods.end())
+    {
+        m_methodCount -= find_res->second.size();
+        m_methods.erase(find_res);
+    }
+
+    m_startupHookModules.erase(moduleId);
+}
+
+size_t PrecompiledCodeIndex::MethodCount() const
+{
+    std::shared_lock<std::shared_mutex> guard(m_lock);
+    return m_methodCount;
+}
+
+size_t PrecompiledCodeIndex::StartupHookModuleCount() const
+{
+    std::shared_lock<std::shared_mutex> guard(m_lock);
+    return m_startupHookModules.size();
+}
+
+} // namespace trace
@@ -0,0 +1,46 @@
+#ifndef DD_CLR_PROFILER_PRECOMPILED_CODE_INDEX_H_
+#define DD_CLR_PROFILER_PRECOMPILED_CODE_INDEX_H_
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "cor.h"
+#include "corprof.h"
+
+namespace trace
+{
+
+/// <summary>
+/// Methods whose NGEN/ReadyToRun code must not be used, so JITCachedFunctionSearchStarted can keep the
+/// precompiled code of everything else. It holds the CallTarget targets found by the ReJIT planning, the
+/// NGEN methods known to inline them, and the modules that can host the startup hook of their AppDomain.
+/// Every lookup is two hash probes under a shared lock.
+/// </summary>
+class PrecompiledCodeIndex
+{
+private:
+    mutable std::shared_mutex m_lock;
+    std::unordered_map<ModuleID, std::unordered_set<mdMethodDef>> m_methods;
+    std::unordered_map<ModuleID, AppDomainID> m_startupHookModules;
+    size_t m_methodCount = 0;
+
+public:
+    // A CallTarget target or an inliner of one. Returns false if the method was already indexed.
+    bool AddMethod(ModuleID moduleId, mdMethodDef methodDef);
+    void AddMethods(const std::vector<ModuleID>& modules, const std::vector<mdMethodDef>& methodDefs);
+    bool ContainsMethod(ModuleID moduleId, mdMethodDef methodDef) const;
+
+    // A module whose first JIT compiled method can receive the startup hook of its AppDomain.
+    void AddStartupHookModule(ModuleID moduleId, AppDomainID appDomainId);
+    bool TryGetStartupHookAppDomain(ModuleID moduleId, AppDomainID* appDomainId) const;
+
+    void RemoveModule(ModuleID moduleId);
+    size_t MethodCount() const;
+    size_t StartupHookModuleCount() const;
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_PRECOMPILED_CODE_INDEX_H_
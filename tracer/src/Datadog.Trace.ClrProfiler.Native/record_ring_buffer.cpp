@@ -0,0 +1,124 @@
+#include "record_ring_buffer.h"
+
+#include <cstring>
+
+namespace trace
+{
+
+namespace
+{
+    uint64_t RoundUpToPowerOfTwo(size_t value)
+    {
+        uint64_t result = 2;
+        while (result < value)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+} // namespace
+
+RecordRingBuffer::RecordRingBuffer(size_t capacity, size_t maxRecordSize, size_t initialRecordSize) :
+    m_capacity(RoundUpToPowerOfTwo(capacity)),
+    m_mask(m_capacity - 1),
+    m_max_record_size(maxRecordSize),
+    m_watermark(m_capacity - m_capacity / 4)
+{
+    m_slots = std::make_unique<Slot[]>((size_t) m_capacity);
+    for (uint64_t i = 0; i < m_capacity; i++)
+    {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        if (initialRecordSize > 0)
+        {
+            m_slots[i].data.reset(new uint8_t[initialRecordSize]);
+            m_slots[i].capacity = initialRecordSize;
+        }
+    }
+}
+
+RecordEnqueueResult RecordRingBuffer::TryEnqueue(const uint8_t* data, size_t size)
+{
+    if (size > m_max_record_size)
+    {
+        return RecordEnqueueResult::TooLarge;
+    }
+
+    uint64_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true)
+    {
+        slot = &m_slots[pos & m_mask];
+        const auto sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto diff = (int64_t) (sequence - pos);
+        if (diff == 0)
+        {
+            if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The consumer hasn't released this slot since the previous lap
+            return RecordEnqueueResult::Full;
+        }
+        else
+        {
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (slot->capacity < size)
+    {
+        slot->data.reset(new uint8_t[size]);
+        slot->capacity = size;
+    }
+    if (size > 0)
+    {
+        std::memcpy(slot->data.get(), data, size);
+    }
+    slot->size = size;
+
+    // Read before publishing: the consumer can't go past this slot yet
+    const auto used = pos - m_dequeue_pos.load(std::memory_order_relaxed);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    return used >= m_watermark ? RecordEnqueueResult::AcceptedAboveWatermark : RecordEnqueueResult::Accepted;
+}
+
+size_t RecordRingBuffer::Peek(RingBufferRecord* records, size_t maxCount) const
+{
+    const uint64_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    size_t count = 0;
+    while (count < maxCount && count < m_capacity)
+    {
+        const Slot& slot = m_slots[(pos + count) & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != pos + count + 1)
+        {
+            // Empty, or still being written by its producer
+            break;
+        }
+        records[count] = {slot.data.get(), slot.size};
+        count++;
+    }
+    return count;
+}
+
+void RecordRingBuffer::Release(size_t count)
+{
+    const uint64_t pos = m_dequeue_pos.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; i++)
+    {
+        m_slots[(pos + i) & m_mask].sequence.store(pos + i + m_capacity, std::memory_order_release);
+    }
+    m_dequeue_pos.store(pos + count, std::memory_order_release);
+}
+
+size_t RecordRingBuffer::ApproximateSize() const
+{
+    const auto enqueued = m_enqueue_pos.load(std::memory_order_relaxed);
+    const auto dequeued = m_dequeue_pos.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? (size_t) (enqueued - dequeued) : 0;
+}
+
+} // namespace trace
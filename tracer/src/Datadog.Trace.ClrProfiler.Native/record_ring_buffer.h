@@ -0,0 +1,88 @@
+#ifndef DD_CLR_PROFILER_RECORD_RING_BUFFER_H_
+#define DD_CLR_PROFILER_RECORD_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace trace
+{
+
+const size_t cache_line_size = 64;
+
+// A record in the ring buffer, read in place by the consumer until it releases it.
+struct RingBufferRecord
+{
+    const uint8_t* data;
+    size_t size;
+};
+
+enum class RecordEnqueueResult
+{
+    Accepted,
+    // Accepted, but the buffer is filling up faster than it is flushed
+    AcceptedAboveWatermark,
+    Full,
+    TooLarge
+};
+
+/// <summary>
+/// Bounded multi-producer, single-consumer queue of records. It doesn't look into them: the span flusher queues
+/// span buffers (see span_serializer.h) and the EventPipe consumer queues runtime events.
+/// Producers claim a slot with a compare-and-swap on the enqueue position and copy the record into the slot's
+/// own memory, which is kept and reused. Enqueueing never takes a lock, nor allocates when the slots are
+/// pre-sized to the maximum record size; otherwise a slot grows the first time it gets a larger record.
+/// The consumer reads records in place and releases them in order after they have been written to the sink.
+/// Slots and positions are padded to a cache line so producers don't invalidate each other's lines.
+/// </summary>
+class RecordRingBuffer
+{
+private:
+    struct alignas(cache_line_size) Slot
+    {
+        // pos when free for the producer at pos, pos + 1 when its record is ready for the consumer
+        std::atomic<uint64_t> sequence;
+        size_t size = 0;
+        size_t capacity = 0;
+        std::unique_ptr<uint8_t[]> data;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    const uint64_t m_capacity;
+    const uint64_t m_mask;
+    const size_t m_max_record_size;
+    const uint64_t m_watermark;
+
+    alignas(cache_line_size) std::atomic<uint64_t> m_enqueue_pos = {0};
+    alignas(cache_line_size) std::atomic<uint64_t> m_dequeue_pos = {0};
+
+public:
+    // The capacity is rounded up to the next power of two. Every slot is allocated initialRecordSize bytes
+    // upfront, producers of fixed-size records then never allocate.
+    RecordRingBuffer(size_t capacity, size_t maxRecordSize, size_t initialRecordSize = 0);
+
+    RecordEnqueueResult TryEnqueue(const uint8_t* data, size_t size);
+
+    // Consumer side: fills records with up to maxCount ready records, in order, without removing them.
+    size_t Peek(RingBufferRecord* records, size_t maxCount) const;
+    // Consumer side: frees the first count records returned by Peek.
+    void Release(size_t count);
+
+    size_t Capacity() const
+    {
+        return (size_t) m_capacity;
+    }
+    size_t ApproximateSize() const;
+    uint64_t EnqueuePosition() const
+    {
+        return m_enqueue_pos.load(std::memory_order_acquire);
+    }
+    uint64_t DequeuePosition() const
+    {
+        return m_dequeue_pos.load(std::memory_order_acquire);
+    }
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_RECORD_RING_BUFFER_H_
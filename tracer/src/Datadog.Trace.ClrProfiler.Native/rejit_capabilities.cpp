@@ -0,0 +1,99 @@
+#include "rejit_capabilities.h"
+
+namespace trace
+{
+
+// Newest versions first, the first matching row wins.
+const RejitCapabilityRule rejit_capability_matrix[] = {
+    {COR_PRF_CORE_CLR, 6, 0, true, "the runtime tracks the inliners of ReJIT requests"},
+    {COR_PRF_CORE_CLR, 3, 0, false,
+     "RequestReJITWithInliners fails with an internal CLR error (0x80131506) before .NET 6"},
+    {COR_PRF_CORE_CLR, 0, 0, false, "ICorProfilerInfo10 requires .NET Core 3.0"},
+    {COR_PRF_DESKTOP_CLR, 0, 0, false, "ICorProfilerInfo10 is not available on .NET Framework"},
+};
+
+const RejitCapabilityRule* FindRejitCapabilityRule(const RuntimeInformation& runtime)
+{
+    for (const auto& rule : rejit_capability_matrix)
+    {
+        if (rule.runtime_type != runtime.runtime_type)
+        {
+            continue;
+        }
+
+        if (runtime.major_version > rule.min_major_version ||
+            (runtime.major_version == rule.min_major_version && runtime.minor_version >= rule.min_minor_version))
+        {
+            return &rule;
+        }
+    }
+
+    return nullptr;
+}
+
+bool IsRequestReJITWithInlinersSupported(const RuntimeInformation& runtime)
+{
+    const auto rule = FindRejitCapabilityRule(runtime);
+    return rule != nullptr && rule->rejit_with_inliners;
+}
+
+void RejitInlinersCapability::Configure(bool supported)
+{
+    m_mode = (int) (supported ? RejitInlinersMode::Pending : RejitInlinersMode::Manual);
+}
+
+RejitInlinersMode RejitInlinersCapability::GetMode() const
+{
+    return (RejitInlinersMode) m_mode.load();
+}
+
+bool RejitInlinersCapability::ApplySelfTest(HRESULT hr)
+{
+    int expected = (int) RejitInlinersMode::Pending;
+    const auto result = hr == E_INVALIDARG ? RejitInlinersMode::Runtime : RejitInlinersMode::Manual;
+    m_mode.compare_exchange_strong(expected, (int) result);
+    return IsRuntimeTracked();
+}
+
+bool RejitInlinersCapability::Fallback()
+{
+    // Under the lock so AddRuntimeTrackedInliner either sees the new mode or has its caller taken after the switch.
+    std::lock_guard<std::mutex> guard(m_inliners_lock);
+    return m_mode.exchange((int) RejitInlinersMode::Manual) != (int) RejitInlinersMode::Manual;
+}
+
+bool RejitInlinersCapability::AddRuntimeTrackedInliner(ModuleID moduleId, mdMethodDef methodDef)
+{
+    std::lock_guard<std::mutex> guard(m_inliners_lock);
+    if (!IsRuntimeTracked())
+    {
+        return false;
+    }
+
+    m_inliners.emplace(moduleId, methodDef);
+    return true;
+}
+
+void RejitInlinersCapability::TakeRuntimeTrackedInliners(std::vector<ModuleID>* modules,
+                                                         std::vector<mdMethodDef>* methodDefs)
+{
+    std::lock_guard<std::mutex> guard(m_inliners_lock);
+    for (const auto& inliner : m_inliners)
+    {
+        modules->push_back(inliner.first);
+        methodDefs->push_back(inliner.second);
+    }
+    m_inliners.clear();
+}
+
+void RejitInlinersCapability::RemoveModule(ModuleID moduleId)
+{
+    std::lock_guard<std::mutex> guard(m_inliners_lock);
+    auto it = m_inliners.lower_bound(std::make_pair(moduleId, (mdMethodDef) 0));
+    while (it != m_inliners.end() && it->first == moduleId)
+    {
+        it = m_inliners.erase(it);
+    }
+}
+
+} // namespace trace
@@ -0,0 +1,84 @@
+#ifndef DD_CLR_PROFILER_REJIT_CAPABILITIES_H_
+#define DD_CLR_PROFILER_REJIT_CAPABILITIES_H_
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "clr_helpers.h"
+
+namespace trace
+{
+
+/// <summary>
+/// A row of the ReJIT capability matrix: the first row matching the runtime type and a version at or above
+/// the minimum decides whether ICorProfilerInfo10::RequestReJITWithInliners can be used.
+/// </summary>
+struct RejitCapabilityRule
+{
+    COR_PRF_RUNTIME_TYPE runtime_type;
+    USHORT min_major_version;
+    USHORT min_minor_version;
+    bool rejit_with_inliners;
+    const char* reason;
+};
+
+// Returns the matching row of the capability matrix, or nullptr for an unknown runtime.
+const RejitCapabilityRule* FindRejitCapabilityRule(const RuntimeInformation& runtime);
+bool IsRequestReJITWithInlinersSupported(const RuntimeInformation& runtime);
+
+enum class RejitInlinersMode
+{
+    // RequestReJIT plus the NGEN inliner enumeration and the JITInlining veto
+    Manual = 0,
+    // Allowed by the capability matrix, waiting for the self-test on the ReJIT thread
+    Pending = 1,
+    // RequestReJITWithInliners(COR_PRF_REJIT_BLOCK_INLINING), the runtime tracks the inliners
+    Runtime = 2
+};
+
+/// <summary>
+/// How the ReJIT requests deal with the methods that inline an instrumented method. Starts from the
+/// capability matrix, is confirmed by a self-test before the first request and falls back to Manual for
+/// the rest of the process as soon as the runtime rejects a RequestReJITWithInliners call. While the runtime
+/// tracks the inliners, the JIT compiled callers of instrumented methods are remembered so their ReJIT can be
+/// requested after a fallback.
+/// </summary>
+class RejitInlinersCapability
+{
+private:
+    std::atomic<int> m_mode = {(int) RejitInlinersMode::Manual};
+
+    std::mutex m_inliners_lock;
+    std::set<std::pair<ModuleID, mdMethodDef>> m_inliners;
+
+public:
+    void Configure(bool supported);
+    RejitInlinersMode GetMode() const;
+
+    // Applies the result of RequestReJITWithInliners(COR_PRF_REJIT_BLOCK_INLINING, 0, nullptr, nullptr).
+    // The runtime only validates the arguments after checking that ReJIT and the inline tracking are enabled,
+    // so E_INVALIDARG is the expected answer. Returns true if the runtime tracks the inliners from now on.
+    bool ApplySelfTest(HRESULT hr);
+
+    // Switches to Manual. Returns true if the mode changed.
+    bool Fallback();
+
+    // Remembers a caller that inlined an instrumented method while the runtime tracks the inliners. Returns false
+    // once the mode is not Runtime anymore, the inlining has to be vetoed instead.
+    bool AddRuntimeTrackedInliner(ModuleID moduleId, mdMethodDef methodDef);
+    // Hands out and forgets the callers remembered by AddRuntimeTrackedInliner.
+    void TakeRuntimeTrackedInliners(std::vector<ModuleID>* modules, std::vector<mdMethodDef>* methodDefs);
+    void RemoveModule(ModuleID moduleId);
+
+    bool IsRuntimeTracked() const
+    {
+        return GetMode() == RejitInlinersMode::Runtime;
+    }
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_REJIT_CAPABILITIES_H_
@@ -1,5 +1,7 @@
 #include "rejit_handler.h"
 
+#include <algorithm>
+
 #include "dd_profiler_constants.h"
 #include "logger.h"
 #include "stats.h"
@@ -37,6 +39,14 @@ std::unique_ptr<RejitItem> RejitItem::CreateEndRejitThread()
     return std::make_unique<RejitItem>();
 }
 
+std::unique_ptr<RejitItem> RejitItem::CreateRevert(std::unique_ptr<std::vector<ModuleID>>&& modulesId,
+                                                   std::unique_ptr<std::vector<mdMethodDef>>&& methodDefs)
+{
+    auto item = std::make_unique<RejitItem>(std::move(modulesId), std::move(methodDefs));
+    item->m_type = 3;
+    return item;
+}
+
 //
 // RejitHandlerModuleMethod
 //
@@ -48,6 +58,23 @@ RejitHandlerModuleMethod::RejitHandlerModuleMethod(mdMethodDef methodDef, RejitH
     m_module = module;
     m_functionInfo = nullptr;
     m_methodReplacement = nullptr;
+    trace::Stats::Instance()->MemoryAllocated(MemoryCategory::RejitMethod, sizeof(RejitHandlerModuleMethod));
+}
+
+RejitHandlerModuleMethod::~RejitHandlerModuleMethod()
+{
+    if (m_functionInfo != nullptr)
+    {
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::FunctionInfo, EstimateMemory(*m_functionInfo));
+    }
+    if (m_methodReplacement != nullptr)
+    {
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::MethodReplacement,
+                                                 EstimateMemory(*m_methodReplacement));
+    }
+    trace::Stats::Instance()->MemoryReleased(MemoryCategory::RejitMethod,
+                                             sizeof(RejitHandlerModuleMethod) +
+                                                 m_ngenModules.size() * sizeof(std::pair<ModuleID, bool>));
 }
 
 mdMethodDef RejitHandlerModuleMethod::GetMethodDef()
@@ -77,7 +104,12 @@ FunctionInfo* RejitHandlerModuleMethod::GetFunctionInfo()
 
 void RejitHandlerModuleMethod::SetFunctionInfo(const FunctionInfo& functionInfo)
 {
+    if (m_functionInfo != nullptr)
+    {
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::FunctionInfo, EstimateMemory(*m_functionInfo));
+    }
     m_functionInfo = std::make_unique<FunctionInfo>(functionInfo);
+    trace::Stats::Instance()->MemoryAllocated(MemoryCategory::FunctionInfo, EstimateMemory(*m_functionInfo));
 }
 
 MethodReplacement* RejitHandlerModuleMethod::GetMethodReplacement()
@@ -87,7 +119,34 @@ MethodReplacement* RejitHandlerModuleMethod::GetMethodReplacement()
 
 void RejitHandlerModuleMethod::SetMethodReplacement(const MethodReplacement& methodReplacement)
 {
+    if (m_methodReplacement != nullptr)
+    {
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::MethodReplacement,
+                                                 EstimateMemory(*m_methodReplacement));
+    }
     m_methodReplacement = std::make_unique<MethodReplacement>(methodReplacement);
+    trace::Stats::Instance()->MemoryAllocated(MemoryCategory::MethodReplacement,
+                                              EstimateMemory(*m_methodReplacement));
+}
+
+const WSTRING& RejitHandlerModuleMethod::GetIntegrationName()
+{
+    return m_integrationName;
+}
+
+void RejitHandlerModuleMethod::SetIntegrationName(const WSTRING& integrationName)
+{
+    m_integrationName = integrationName;
+}
+
+bool RejitHandlerModuleMethod::IsRewritten()
+{
+    return m_rewritten;
+}
+
+void RejitHandlerModuleMethod::SetRewritten(bool rewritten)
+{
+    m_rewritten = rewritten;
 }
 
 void RejitHandlerModuleMethod::RequestRejitForInlinersInModule(ModuleID moduleId)
@@ -136,6 +195,11 @@ void RejitHandlerModuleMethod::RequestRejitForInlinersInModule(ModuleID moduleId
             methodEnum = nullptr;
             if (total > 0)
             {
+                // The inliners have to be JIT compiled too, their NGEN code has the original body inlined.
+                if (handler->GetPrecompiledCodeIndex() != nullptr)
+                {
+                    handler->GetPrecompiledCodeIndex()->AddMethods(modules, methods);
+                }
                 handler->EnqueueForRejit(modules, methods);
                 Logger::Info("NGEN:: Processed with ", total, " inliners [ModuleId=", currentModuleId,
                              ",MethodDef=", currentMethodDef, "]");
@@ -143,7 +207,12 @@ void RejitHandlerModuleMethod::RequestRejitForInlinersInModule(ModuleID moduleId
 
             if (!incompleteData)
             {
-                m_ngenModules[moduleId] = true;
+                if (m_ngenModules.insert_or_assign(moduleId, true).second)
+                {
+                    trace::Stats::Instance()->MemoryAllocated(MemoryCategory::RejitMethod,
+                                                              sizeof(std::pair<ModuleID, bool>), 0);
+                    handler->AddInlinersModule(moduleId, currentModuleId, currentMethodDef);
+                }
             }
             else
             {
@@ -173,6 +242,15 @@ void RejitHandlerModuleMethod::RequestRejitForInlinersInModule(ModuleID moduleId
     }
 }
 
+void RejitHandlerModuleMethod::RemoveInlinersModule(ModuleID moduleId)
+{
+    std::lock_guard<std::mutex> guard(m_ngenModulesLock);
+    if (m_ngenModules.erase(moduleId) > 0)
+    {
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::RejitMethod, sizeof(std::pair<ModuleID, bool>), 0);
+    }
+}
+
 //
 // RejitHandlerModule
 //
@@ -182,6 +260,12 @@ RejitHandlerModule::RejitHandlerModule(ModuleID moduleId, RejitHandler* handler)
     m_moduleId = moduleId;
     m_metadata = nullptr;
     m_handler = handler;
+    trace::Stats::Instance()->MemoryAllocated(MemoryCategory::RejitModule, sizeof(RejitHandlerModule));
+}
+
+RejitHandlerModule::~RejitHandlerModule()
+{
+    trace::Stats::Instance()->MemoryReleased(MemoryCategory::RejitModule, sizeof(RejitHandlerModule));
 }
 
 ModuleID RejitHandlerModule::GetModuleId()
@@ -225,6 +309,58 @@ bool RejitHandlerModule::ContainsMethod(mdMethodDef methodDef)
     return m_methods.find(methodDef) != m_methods.end();
 }
 
+void RejitHandlerModule::GetMethodsForIntegration(const WSTRING& integrationName,
+                                                  std::vector<mdMethodDef>& methodDefs, bool onlyRewritten)
+{
+    std::lock_guard<std::mutex> guard(m_methods_lock);
+    for (const auto& method : m_methods)
+    {
+        const auto methodHandler = method.second.get();
+        if (methodHandler->GetIntegrationName() != integrationName)
+        {
+            continue;
+        }
+        if (onlyRewritten && !methodHandler->IsRewritten())
+        {
+            continue;
+        }
+        methodDefs.push_back(method.first);
+    }
+}
+
+void RejitHandlerModule::GetMethodsByName(const WSTRING& fullMethodName, std::vector<mdMethodDef>& methodDefs)
+{
+    std::lock_guard<std::mutex> guard(m_methods_lock);
+    for (const auto& method : m_methods)
+    {
+        const auto functionInfo = method.second->GetFunctionInfo();
+        if (functionInfo != nullptr && functionInfo->type.name + WStr(".") + functionInfo->name == fullMethodName)
+        {
+            methodDefs.push_back(method.first);
+        }
+    }
+}
+
+void RejitHandlerModule::GetMethodSnapshots(std::vector<InstrumentedMethodSnapshot>& methods)
+{
+    const auto assemblyName = m_metadata != nullptr ? m_metadata->assemblyName : WSTRING();
+
+    std::lock_guard<std::mutex> guard(m_methods_lock);
+    for (const auto& method : m_methods)
+    {
+        const auto methodHandler = method.second.get();
+        const auto functionInfo = methodHandler->GetFunctionInfo();
+        InstrumentedMethodSnapshot snapshot{m_moduleId,
+                                            method.first,
+                                            assemblyName,
+                                            functionInfo != nullptr ? functionInfo->type.name : EmptyWStr,
+                                            functionInfo != nullptr ? functionInfo->name : EmptyWStr,
+                                            methodHandler->GetIntegrationName(),
+                                            methodHandler->IsRewritten()};
+        methods.push_back(std::move(snapshot));
+    }
+}
+
 void RejitHandlerModule::RequestRejitForInlinersInModule(ModuleID moduleId)
 {
     std::lock_guard<std::mutex> guard(m_methods_lock);
@@ -234,6 +370,19 @@ void RejitHandlerModule::RequestRejitForInlinersInModule(ModuleID moduleId)
     }
 }
 
+void RejitHandlerModule::RemoveInlinersModule(ModuleID moduleId, const std::vector<mdMethodDef>& methodDefs)
+{
+    std::lock_guard<std::mutex> guard(m_methods_lock);
+    for (const auto methodDef : methodDefs)
+    {
+        auto find_res = m_methods.find(methodDef);
+        if (find_res != m_methods.end())
+        {
+            find_res->second->RemoveInlinersModule(moduleId);
+        }
+    }
+}
+
 //
 // RejitHandler
 //
@@ -275,6 +424,17 @@ void RejitHandler::EnqueueThreadLoop(RejitHandler* handler)
                 handler->RequestRejit(*item->m_modulesId.get(), *item->m_methodDefs.get());
             }
         }
+        else if (item->m_type == 3)
+        {
+            // *************************************
+            // Request Revert
+            // *************************************
+
+            if (item->m_modulesId->size() > 0 && item->m_methodDefs->size() > 0)
+            {
+                handler->RequestRevert(*item->m_modulesId.get(), *item->m_methodDefs.get());
+            }
+        }
         else if (item->m_type == 2)
         {
             // *************************************
@@ -336,20 +496,28 @@ void RejitHandler::RequestRejit(std::vector<ModuleID>& modulesVector,
         // Request ReJIT
         // *************************************
 
-        if (m_profilerInfo10 != nullptr)
+        if (m_profilerInfo10 != nullptr && m_inliners.GetMode() == RejitInlinersMode::Pending)
         {
-            // RequestReJITWithInliners is currently always failing with `Fatal error. Internal CLR error.
-            // (0x80131506)` more research is required, meanwhile we fallback to the normal RequestReJIT and
-            // manual track of inliners.
+            RunRejitWithInlinersSelfTest();
+        }
 
-            /*hr = m_profilerInfo10->RequestReJITWithInliners(COR_PRF_REJIT_BLOCK_INLINING, (ULONG) modulesVector.size(),
-            &modulesVector[0], &modulesMethodDef[0]); if (FAILED(hr))
+        if (m_profilerInfo10 != nullptr && m_inliners.IsRuntimeTracked())
+        {
+            // The runtime also rejits the methods that already inlined these ones and blocks further inlining.
+            hr = m_profilerInfo10->RequestReJITWithInliners(COR_PRF_REJIT_BLOCK_INLINING, (ULONG) modulesVector.size(),
+                                                            &modulesVector[0], &modulesMethodDef[0]);
+            if (FAILED(hr))
             {
-                Warn("Error requesting ReJITWithInliners for ", vtModules.size(),
-                     " methods, falling back to a normal RequestReJIT");
-                hr = m_profilerInfo10->RequestReJIT((ULONG) modulesVector.size(), &modulesVector[0], &modulesMethodDef[0]);
-            }*/
-
+                Logger::Warn("Error requesting ReJITWithInliners for ", modulesVector.size(), " methods (HRESULT ", hr,
+                             "), falling back to RequestReJIT and the manual tracking of inliners.");
+                m_inliners.Fallback();
+                hr = m_profilerInfo10->RequestReJIT((ULONG) modulesVector.size(), &modulesVector[0],
+                                                    &modulesMethodDef[0]);
+                RequestRejitForRuntimeTrackedInliners();
+            }
+        }
+        else if (m_profilerInfo10 != nullptr)
+        {
             hr = m_profilerInfo10->RequestReJIT((ULONG) modulesVector.size(), &modulesVector[0], &modulesMethodDef[0]);
         }
         else
@@ -366,7 +534,106 @@ void RejitHandler::RequestRejit(std::vector<ModuleID>& modulesVector,
         }
 
         // Request for NGen Inliners
-        RequestRejitForNGenInliners();
+        if (!m_inliners.IsRuntimeTracked())
+        {
+            RequestRejitForNGenInliners();
+        }
+    }
+}
+
+void RejitHandler::RunRejitWithInlinersSelfTest()
+{
+    // An empty request goes through every capability check of the runtime and stops at the argument validation.
+    const HRESULT hr = m_profilerInfo10->RequestReJITWithInliners(COR_PRF_REJIT_BLOCK_INLINING, 0, nullptr, nullptr);
+
+    if (m_inliners.ApplySelfTest(hr))
+    {
+        Logger::Info("ReJIT self-test passed, the runtime tracks the inliners of the instrumented methods.");
+    }
+    else
+    {
+        Logger::Warn("ReJIT self-test failed (HRESULT ", hr,
+                     "), using RequestReJIT and the manual tracking of inliners.");
+    }
+}
+
+void RejitHandler::RequestRejitForRuntimeTrackedInliners()
+{
+    // JIT compiled while the runtime was trusted to track the inliners, their code has the original body of an
+    // instrumented method inlined. The JITInlining veto applies to the new code.
+    std::vector<ModuleID> modules;
+    std::vector<mdMethodDef> methodDefs;
+    m_inliners.TakeRuntimeTrackedInliners(&modules, &methodDefs);
+    if (modules.empty())
+    {
+        return;
+    }
+
+    const HRESULT hr = m_profilerInfo->RequestReJIT((ULONG) modules.size(), &modules[0], &methodDefs[0]);
+    if (SUCCEEDED(hr))
+    {
+        Logger::Info("Request ReJIT done for ", modules.size(), " inliners of instrumented methods");
+    }
+    else
+    {
+        Logger::Warn("Error requesting ReJIT for ", modules.size(), " inliners of instrumented methods (HRESULT ",
+                     hr, ")");
+    }
+}
+
+void RejitHandler::RequestRevert(std::vector<ModuleID>& modulesVector, std::vector<mdMethodDef>& modulesMethodDef)
+{
+    ReadLock r_lock(m_shutdown_lock);
+    if (m_shutdown)
+    {
+        return;
+    }
+
+    if (modulesVector.empty())
+    {
+        return;
+    }
+
+    std::vector<HRESULT> status(modulesVector.size(), S_OK);
+    HRESULT hr = m_profilerInfo->RequestRevert((ULONG) modulesVector.size(), &modulesVector[0], &modulesMethodDef[0],
+                                               &status[0]);
+    if (FAILED(hr))
+    {
+        Logger::Warn("Error requesting Revert for ", modulesVector.size(), " methods");
+        return;
+    }
+
+    ULONG reverted = 0;
+    std::lock_guard<std::mutex> guard(m_modules_lock);
+    for (size_t i = 0; i < modulesVector.size(); i++)
+    {
+        if (FAILED(status[i]))
+        {
+            Logger::Debug("Revert failed for [ModuleId=", modulesVector[i], ", MethodDef=",
+                          TokenStr(&modulesMethodDef[i]), "]");
+            continue;
+        }
+
+        const auto find_res = m_modules.find(modulesVector[i]);
+        if (find_res != m_modules.end() && find_res->second->ContainsMethod(modulesMethodDef[i]))
+        {
+            find_res->second->GetOrAddMethod(modulesMethodDef[i])->SetRewritten(false);
+        }
+        reverted++;
+    }
+
+    Logger::Info("Request Revert done for ", reverted, " of ", modulesVector.size(), " methods");
+}
+
+void RejitHandler::GetMethodsForIntegration(const WSTRING& integrationName, std::vector<ModuleID>& modulesVector,
+                                            std::vector<mdMethodDef>& modulesMethodDef, bool onlyRewritten)
+{
+    std::lock_guard<std::mutex> guard(m_modules_lock);
+    for (const auto& mod : m_modules)
+    {
+        const auto previousSize = modulesMethodDef.size();
+        mod.second->GetMethodsForIntegration(integrationName, modulesMethodDef, onlyRewritten);
+        modulesVector.insert(modulesVector.end(), modulesMethodDef.size() - previousSize, mod.first);
     }
 }
 
@@ -450,8 +717,60 @@ void RejitHandler::RemoveModule(ModuleID moduleId)
         return;
     }
 
+    {
+        std::lock_guard<std::mutex> guard(m_ngenModules_lock);
+        m_ngenModules.erase(std::remove(m_ngenModules.begin(), m_ngenModules.end(), moduleId), m_ngenModules.end());
+    }
+    m_inliners.RemoveModule(moduleId);
+
+    // Drop the module and forget it as an inliner of the methods in the other modules, a new module
+    // loaded later with the same ModuleID has to be scanned again anyway.
     std::lock_guard<std::mutex> guard(m_modules_lock);
     m_modules.erase(moduleId);
+
+    std::unordered_map<ModuleID, std::vector<mdMethodDef>> inlinedMethods;
+    {
+        std::lock_guard<std::mutex> inlinersGuard(m_inlinersModules_lock);
+        size_t entries = 0;
+        auto find_res = m_inlinersModules.find(moduleId);
+        if (find_res != m_inlinersModules.end())
+        {
+            inlinedMethods = std::move(find_res->second);
+            m_inlinersModules.erase(find_res);
+            for (const auto& methods : inlinedMethods)
+            {
+                entries += methods.second.size();
+            }
+        }
+
+        // The methods of the unloaded module are gone with it
+        for (auto& inliners : m_inlinersModules)
+        {
+            auto methods = inliners.second.find(moduleId);
+            if (methods != inliners.second.end())
+            {
+                entries += methods->second.size();
+                inliners.second.erase(methods);
+            }
+        }
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::RejitMethod, entries * sizeof(mdMethodDef), 0);
+    }
+
+    for (const auto& methods : inlinedMethods)
+    {
+        auto find_res = m_modules.find(methods.first);
+        if (find_res != m_modules.end())
+        {
+            find_res->second->RemoveInlinersModule(moduleId, methods.second);
+        }
+    }
+}
+
+void RejitHandler::AddInlinersModule(ModuleID inlinersModuleId, ModuleID moduleId, mdMethodDef methodDef)
+{
+    std::lock_guard<std::mutex> guard(m_inlinersModules_lock);
+    m_inlinersModules[inlinersModuleId][moduleId].push_back(methodDef);
+    trace::Stats::Instance()->MemoryAllocated(MemoryCategory::RejitMethod, sizeof(mdMethodDef), 0);
 }
 
 void RejitHandler::AddNGenModule(ModuleID moduleId)
@@ -464,7 +783,10 @@ void RejitHandler::AddNGenModule(ModuleID moduleId)
 
     std::lock_guard<std::mutex> guard(m_ngenModules_lock);
     m_ngenModules.push_back(moduleId);
-    RequestRejitForInlinersInModule(moduleId);
+    if (!m_inliners.IsRuntimeTracked())
+    {
+        RequestRejitForInlinersInModule(moduleId);
+    }
 }
 
 void RejitHandler::EnqueueProcessModule(const std::vector<ModuleID>& modulesVector,
@@ -523,6 +845,19 @@ void RejitHandler::Shutdown()
     m_shutdown.store(true);
 
     m_modules.clear();
+    {
+        std::lock_guard<std::mutex> inlinersGuard(m_inlinersModules_lock);
+        size_t entries = 0;
+        for (const auto& inliners : m_inlinersModules)
+        {
+            for (const auto& methods : inliners.second)
+            {
+                entries += methods.second.size();
+            }
+        }
+        m_inlinersModules.clear();
+        trace::Stats::Instance()->MemoryReleased(MemoryCategory::RejitMethod, entries * sizeof(mdMethodDef), 0);
+    }
     m_profilerInfo = nullptr;
     m_profilerInfo10 = nullptr;
     m_profilerInfo6 = nullptr;
@@ -596,11 +931,76 @@ HRESULT RejitHandler::NotifyReJITParameters(ModuleID moduleId, mdMethodDef metho
         return S_FALSE;
     }
 
-    return m_rewriteCallback(moduleHandler, methodHandler);
+    if (IsIntegrationDisabled(methodHandler->GetIntegrationName()))
+    {
+        Logger::Debug("NotifyReJITCompilationStarted: Integration ", methodHandler->GetIntegrationName(),
+                      " is disabled, skipping MethodDef: ", methodId);
+        return S_FALSE;
+    }
+
+    const auto hr = m_rewriteCallback(moduleHandler, methodHandler);
+    if (hr == S_OK)
+    {
+        methodHandler->SetRewritten(true);
+    }
+    return hr;
 }
 
 HRESULT RejitHandler::NotifyReJITCompilationStarted(FunctionID functionId, ReJITID rejitId)
 {
+    ReadLock r_lock(m_shutdown_lock);
+    if (m_shutdown)
+    {
+        return S_OK;
+    }
+
+    ClassID classId;
+    ModuleID moduleId;
+    mdToken methodDef;
+    if (FAILED(m_profilerInfo->GetFunctionInfo(functionId, &classId, &moduleId, &methodDef)))
+    {
+        return S_OK;
+    }
+
+    CallTargetKind kind;
+    {
+        std::lock_guard<std::mutex> guard(m_modules_lock);
+        auto find_res = m_modules.find(moduleId);
+        if (find_res == m_modules.end() || !find_res->second->ContainsMethod(methodDef))
+        {
+            return S_OK;
+        }
+
+        auto methodHandler = find_res->second->GetOrAddMethod(methodDef);
+        if (!methodHandler->IsRewritten() || methodHandler->GetMethodReplacement() == nullptr)
+        {
+            return S_OK;
+        }
+        kind = methodHandler->GetMethodReplacement()->wrapper_method.calltarget_kind;
+    }
+
+    std::lock_guard<std::mutex> guard(m_rejitCompilations_lock);
+    m_rejitCompilations[functionId] = {kind, std::chrono::steady_clock::now()};
+    return S_OK;
+}
+
+HRESULT RejitHandler::NotifyReJITCompilationFinished(FunctionID functionId, ReJITID rejitId, HRESULT hrStatus)
+{
+    std::lock_guard<std::mutex> guard(m_rejitCompilations_lock);
+    auto find_res = m_rejitCompilations.find(functionId);
+    if (find_res == m_rejitCompilations.end())
+    {
+        return S_OK;
+    }
+
+    if (SUCCEEDED(hrStatus))
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - find_res->second.second;
+        Stats::Instance()->CallTargetKindJitted(
+            (unsigned int) find_res->second.first,
+            (unsigned long long) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    m_rejitCompilations.erase(find_res);
     return S_OK;
 }
 
@@ -619,6 +1019,52 @@ void RejitHandler::SetCorAssemblyProfiler(AssemblyProperty* pCorAssemblyProfiler
     m_pCorAssemblyProperty = pCorAssemblyProfiler;
 }
 
+void RejitHandler::SetModuleInfoCache(ModuleInfoCache* pModuleInfoCache)
+{
+    m_pModuleInfoCache = pModuleInfoCache;
+}
+
+void RejitHandler::SetMethodSignatureCache(MethodSignatureCache* pMethodSignatureCache)
+{
+    m_pMethodSignatureCache = pMethodSignatureCache;
+}
+
+void RejitHandler::SetPrecompiledCodeIndex(PrecompiledCodeIndex* pPrecompiledCodeIndex)
+{
+    m_pPrecompiledCodeIndex = pPrecompiledCodeIndex;
+}
+
+void RejitHandler::ConfigureRejitWithInliners(const RuntimeInformation& runtime, bool enabled)
+{
+    const auto rule = FindRejitCapabilityRule(runtime);
+    const bool supported = enabled && m_profilerInfo10 != nullptr && rule != nullptr && rule->rejit_with_inliners;
+    m_inliners.Configure(supported);
+
+    if (!enabled)
+    {
+        Logger::Info("RequestReJITWithInliners is disabled by configuration.");
+    }
+    else if (rule != nullptr)
+    {
+        Logger::Info("RequestReJITWithInliners is ", supported ? "allowed" : "not used", ": ", rule->reason);
+    }
+}
+
+bool RejitHandler::IsInliningTrackedByRuntime()
+{
+    return m_inliners.IsRuntimeTracked();
+}
+
+bool RejitHandler::AddRuntimeTrackedInliner(ModuleID moduleId, mdMethodDef methodDef)
+{
+    return m_inliners.AddRuntimeTrackedInliner(moduleId, methodDef);
+}
+
+PrecompiledCodeIndex* RejitHandler::GetPrecompiledCodeIndex()
+{
+    return m_pPrecompiledCodeIndex;
+}
+
 void RejitHandler::RequestRejitForNGenInliners()
 {
     ReadLock r_lock(m_shutdown_lock);
@@ -637,6 +1083,58 @@ void RejitHandler::RequestRejitForNGenInliners()
     }
 }
 
+std::vector<RejitMethodCandidate> RejitHandler::GetRejitMethodCandidates(ModuleID moduleId,
+                                                                         ComPtr<IMetaDataImport2>& metadataImport,
+                                                                         mdTypeDef typeDef, const WSTRING& methodName)
+{
+    std::vector<RejitMethodCandidate> candidates;
+
+    // Now we enumerate all methods with the same target method name. (All overloads of the method)
+    auto enumMethods = Enumerator<mdMethodDef>(
+        [&metadataImport, &methodName, typeDef](HCORENUM* ptr, mdMethodDef arr[], ULONG max, ULONG* cnt) -> HRESULT {
+            return metadataImport->EnumMethodsWithName(ptr, typeDef, methodName.c_str(), arr, max, cnt);
+        },
+        [&metadataImport](HCORENUM ptr) -> void { metadataImport->CloseEnum(ptr); });
+
+    auto enumIterator = enumMethods.begin();
+    while (enumIterator != enumMethods.end())
+    {
+        auto methodDef = *enumIterator;
+        enumIterator = ++enumIterator;
+
+        // Extract the function info from the mdMethodDef
+        const auto caller = GetFunctionInfo(metadataImport, methodDef);
+        if (!caller.IsValid())
+        {
+            Logger::Warn("    * The caller for the methoddef: ", TokenStr(&methodDef), " is not valid!");
+            continue;
+        }
+
+        // We create a new function info into the heap from the caller functionInfo in the stack, to
+        // be used later in the ReJIT process
+        auto functionInfo = FunctionInfo(caller);
+        auto hr = functionInfo.method_signature.TryParse(m_pMethodSignatureCache, moduleId, methodDef);
+        if (FAILED(hr))
+        {
+            Logger::Warn("    * The method signature: ", functionInfo.method_signature.str(), " cannot be parsed.");
+            continue;
+        }
+
+        // Resolve the argument type names once, they are compared against every integration of the type.
+        std::vector<WSTRING> argumentTypeNames;
+        const auto& methodArguments = functionInfo.method_signature.GetMethodArguments();
+        argumentTypeNames.reserve(methodArguments.size());
+        for (const auto& argument : methodArguments)
+        {
+            argumentTypeNames.push_back(argument.GetTypeTokName(metadataImport));
+        }
+
+        candidates.push_back({methodDef, functionInfo, std::move(argumentTypeNames)});
+    }
+
+    return candidates;
+}
+
 ULONG RejitHandler::ProcessModuleForRejit(const std::vector<ModuleID>& modules,
                                           const std::vector<IntegrationMethod>& integrations,
                                           bool enqueueInSameThread)
@@ -658,7 +1156,9 @@ ULONG RejitHandler::ProcessModuleForRejit(const std::vector<ModuleID>& modules,
     for (const auto& module : modules)
     {
         auto _ = trace::Stats::Instance()->CallTargetRequestRejitMeasure();
-        const ModuleInfo& moduleInfo = GetModuleInfo(m_profilerInfo, module);
+        const ModuleInfo& moduleInfo = m_pModuleInfoCache != nullptr
+                                           ? m_pModuleInfoCache->GetModuleInfo(m_profilerInfo, module)
+                                           : GetModuleInfo(m_profilerInfo, module);
         Logger::Debug("Requesting Rejit for Module: ", moduleInfo.assembly.name);
 
         ComPtr<IUnknown> metadataInterfaces;
@@ -668,6 +1168,10 @@ ULONG RejitHandler::ProcessModuleForRejit(const std::vector<ModuleID>& modules,
         ComPtr<IMetaDataAssemblyEmit> assemblyEmit;
         std::unique_ptr<AssemblyMetadata> assemblyMetadata = nullptr;
 
+        // Group the integrations that apply to this module by target type, so each type is resolved only once.
+        std::vector<WSTRING> targetTypes;
+        std::unordered_map<WSTRING, std::vector<const IntegrationMethod*>> integrationsByType;
+
         for (const IntegrationMethod& integration : integrations)
         {
             // If the integration mode is not CallTarget we skip.
@@ -715,135 +1219,144 @@ ULONG RejitHandler::ProcessModuleForRejit(const std::vector<ModuleID>& modules,
                 continue;
             }
 
+            // Skip integrations disabled at runtime, they are requested again when re-enabled.
+            if (IsIntegrationDisabled(GetIntegrationName(integration)))
+            {
+                continue;
+            }
+
+            const auto& typeName = integration.replacement.target_method.type_name;
+            auto& typeIntegrations = integrationsByType[typeName];
+            if (typeIntegrations.empty())
+            {
+                targetTypes.push_back(typeName);
+            }
+            typeIntegrations.push_back(&integration);
+        }
+
+        for (const auto& typeName : targetTypes)
+        {
+            const auto& typeIntegrations = integrationsByType[typeName];
+
             // We are in the right module, so we try to load the mdTypeDef from the integration target type name.
             mdTypeDef typeDef = mdTypeDefNil;
-            auto foundType = FindTypeDefByName(integration.replacement.target_method.type_name,
-                                               moduleInfo.assembly.name, metadataImport, typeDef);
+            auto foundType = FindTypeDefByName(typeName, moduleInfo.assembly.name, metadataImport, typeDef);
+            trace::Stats::Instance()->RejitTypeLookupsSaved((ULONG) typeIntegrations.size() - 1);
             if (!foundType)
             {
                 continue;
             }
 
-            Logger::Debug("  Looking for '", integration.replacement.target_method.type_name, ".",
-                          integration.replacement.target_method.method_name, "(",
-                          (integration.replacement.target_method.signature_types.size() - 1), " params)' method.");
-
-            // Now we enumerate all methods with the same target method name. (All overloads of the method)
-            auto enumMethods = Enumerator<mdMethodDef>(
-                [&metadataImport, &integration, typeDef](HCORENUM* ptr, mdMethodDef arr[], ULONG max,
-                                                         ULONG* cnt) -> HRESULT {
-                    return metadataImport->EnumMethodsWithName(
-                        ptr, typeDef, integration.replacement.target_method.method_name.c_str(), arr, max, cnt);
-                },
-                [&metadataImport](HCORENUM ptr) -> void { metadataImport->CloseEnum(ptr); });
-
-            auto enumIterator = enumMethods.begin();
-            while (enumIterator != enumMethods.end())
+            // Overloads already enumerated and parsed for this type, by method name.
+            std::unordered_map<WSTRING, std::vector<RejitMethodCandidate>> overloadsByName;
+
+            for (const IntegrationMethod* pIntegration : typeIntegrations)
             {
-                auto methodDef = *enumIterator;
+                const auto& integration = *pIntegration;
+                const auto& targetMethod = integration.replacement.target_method;
 
-                // Extract the function info from the mdMethodDef
-                const auto caller = GetFunctionInfo(metadataImport, methodDef);
-                if (!caller.IsValid())
-                {
-                    Logger::Warn("    * The caller for the methoddef: ", TokenStr(&methodDef), " is not valid!");
-                    enumIterator = ++enumIterator;
-                    continue;
-                }
+                Logger::Debug("  Looking for '", targetMethod.type_name, ".", targetMethod.method_name, "(",
+                              (targetMethod.signature_types.size() - 1), " params)' method.");
 
-                // We create a new function info into the heap from the caller functionInfo in the stack, to
-                // be used later in the ReJIT process
-                auto functionInfo = FunctionInfo(caller);
-                auto hr = functionInfo.method_signature.TryParse();
-                if (FAILED(hr))
+                auto overloadsIterator = overloadsByName.find(targetMethod.method_name);
+                if (overloadsIterator != overloadsByName.end())
                 {
-                    Logger::Warn("    * The method signature: ", functionInfo.method_signature.str(),
-                                 " cannot be parsed.");
-                    enumIterator = ++enumIterator;
-                    continue;
+                    trace::Stats::Instance()->RejitMethodEnumerationsSaved(1);
+                    trace::Stats::Instance()->RejitSignatureParsesSaved((ULONG) overloadsIterator->second.size());
                 }
-
-                // Compare if the current mdMethodDef contains the same number of arguments as the
-                // instrumentation target
-                const auto numOfArgs = functionInfo.method_signature.NumberOfArguments();
-                if (numOfArgs != integration.replacement.target_method.signature_types.size() - 1)
+                else
                 {
-                    Logger::Debug(
-                        "    * The caller for the methoddef: ", integration.replacement.target_method.method_name,
-                        " doesn't have the right number of arguments (", numOfArgs, " arguments).");
-                    enumIterator = ++enumIterator;
-                    continue;
+                    overloadsIterator =
+                        overloadsByName
+                            .emplace(targetMethod.method_name,
+                                     GetRejitMethodCandidates(module, metadataImport, typeDef, targetMethod.method_name))
+                            .first;
                 }
 
-                // Compare each mdMethodDef argument type to the instrumentation target
-                bool argumentsMismatch = false;
-                const auto methodArguments = functionInfo.method_signature.GetMethodArguments();
-                Logger::Debug("    * Comparing signature for method: ", integration.replacement.target_method.type_name,
-                              ".", integration.replacement.target_method.method_name);
-                for (unsigned int i = 0; i < numOfArgs; i++)
+                for (const auto& candidate : overloadsIterator->second)
                 {
-                    const auto argumentTypeName = methodArguments[i].GetTypeTokName(metadataImport);
-                    const auto integrationArgumentTypeName =
-                        integration.replacement.target_method.signature_types[i + 1];
-                    Logger::Debug("        -> ", argumentTypeName, " = ", integrationArgumentTypeName);
-                    if (argumentTypeName != integrationArgumentTypeName && integrationArgumentTypeName != WStr("_"))
+                    const auto methodDef = candidate.methodDef;
+                    const auto& functionInfo = candidate.functionInfo;
+
+                    // Compare if the current mdMethodDef contains the same number of arguments as the
+                    // instrumentation target
+                    const auto numOfArgs = (ULONG) candidate.argumentTypeNames.size();
+                    if (numOfArgs != targetMethod.signature_types.size() - 1)
                     {
-                        argumentsMismatch = true;
-                        break;
+                        Logger::Debug("    * The caller for the methoddef: ", targetMethod.method_name,
+                                      " doesn't have the right number of arguments (", numOfArgs, " arguments).");
+                        continue;
                     }
-                }
-                if (argumentsMismatch)
-                {
-                    Logger::Debug(
-                        "    * The caller for the methoddef: ", integration.replacement.target_method.method_name,
-                        " doesn't have the right type of arguments.");
-                    enumIterator = ++enumIterator;
-                    continue;
-                }
 
-                // As we are in the right method, we gather all information we need and stored it in to the
-                // ReJIT handler.
-                auto moduleHandler = GetOrAddModule(moduleInfo.id);
-                if (moduleHandler == nullptr)
-                {
-                    Logger::Warn("Module handler is null, this only happens if the RejitHandler has been shutdown.");
-                    break;
-                }
-                if (moduleHandler->GetModuleMetadata() == nullptr)
-                {
-                    Logger::Debug("Creating ModuleMetadata...");
+                    // Compare each mdMethodDef argument type to the instrumentation target
+                    bool argumentsMismatch = false;
+                    Logger::Debug("    * Comparing signature for method: ", targetMethod.type_name, ".",
+                                  targetMethod.method_name);
+                    for (unsigned int i = 0; i < numOfArgs; i++)
+                    {
+                        const auto& argumentTypeName = candidate.argumentTypeNames[i];
+                        const auto& integrationArgumentTypeName = targetMethod.signature_types[i + 1];
+                        Logger::Debug("        -> ", argumentTypeName, " = ", integrationArgumentTypeName);
+                        if (argumentTypeName != integrationArgumentTypeName &&
+                            integrationArgumentTypeName != WStr("_"))
+                        {
+                            argumentsMismatch = true;
+                            break;
+                        }
+                    }
+                    if (argumentsMismatch)
+                    {
+                        Logger::Debug("    * The caller for the methoddef: ", targetMethod.method_name,
+                                      " doesn't have the right type of arguments.");
+                        continue;
+                    }
 
-                    const auto moduleMetadata = new ModuleMetadata(
-                        metadataImport, metadataEmit, assemblyImport, assemblyEmit, moduleInfo.assembly.name,
-                        moduleInfo.assembly.app_domain_id, m_pCorAssemblyProperty);
+                    // As we are in the right method, we gather all information we need and stored it in to the
+                    // ReJIT handler.
+                    auto moduleHandler = GetOrAddModule(moduleInfo.id);
+                    if (moduleHandler == nullptr)
+                    {
+                        Logger::Warn(
+                            "Module handler is null, this only happens if the RejitHandler has been shutdown.");
+                        break;
+                    }
+                    if (moduleHandler->GetModuleMetadata() == nullptr)
+                    {
+                        Logger::Debug("Creating ModuleMetadata...");
 
-                    Logger::Info("ReJIT handler stored metadata for ", moduleInfo.id, " ", moduleInfo.assembly.name,
-                                 " AppDomain ", moduleInfo.assembly.app_domain_id, " ",
-                                 moduleInfo.assembly.app_domain_name);
+                        const auto moduleMetadata = new ModuleMetadata(
+                            metadataImport, metadataEmit, assemblyImport, assemblyEmit, moduleInfo.assembly.name,
+                            moduleInfo.assembly.app_domain_id, m_pCorAssemblyProperty);
 
-                    moduleHandler->SetModuleMetadata(moduleMetadata);
-                }
+                        Logger::Info("ReJIT handler stored metadata for ", moduleInfo.id, " ",
+                                     moduleInfo.assembly.name, " AppDomain ", moduleInfo.assembly.app_domain_id, " ",
+                                     moduleInfo.assembly.app_domain_name);
 
-                auto methodHandler = moduleHandler->GetOrAddMethod(methodDef);
-                if (methodHandler->GetFunctionInfo() == nullptr)
-                {
-                    methodHandler->SetFunctionInfo(functionInfo);
-                }
-                if (methodHandler->GetMethodReplacement() == nullptr)
-                {
-                    methodHandler->SetMethodReplacement(integration.replacement);
-                }
+                        moduleHandler->SetModuleMetadata(moduleMetadata);
+                    }
+
+                    auto methodHandler = moduleHandler->GetOrAddMethod(methodDef);
+                    if (methodHandler->GetFunctionInfo() == nullptr)
+                    {
+                        methodHandler->SetFunctionInfo(functionInfo);
+                    }
+                    if (methodHandler->GetMethodReplacement() == nullptr)
+                    {
+                        methodHandler->SetMethodReplacement(integration.replacement);
+                        methodHandler->SetIntegrationName(GetIntegrationName(integration));
+                    }
 
-                // Store module_id and methodDef to request the ReJIT after analyzing all integrations.
-                vtModules.push_back(moduleInfo.id);
-                vtMethodDefs.push_back(methodDef);
+                    // Store module_id and methodDef to request the ReJIT after analyzing all integrations.
+                    vtModules.push_back(moduleInfo.id);
+                    vtMethodDefs.push_back(methodDef);
 
-                Logger::Debug("    * Enqueue for ReJIT [ModuleId=", moduleInfo.id, ", MethodDef=", TokenStr(&methodDef),
-                              ", AppDomainId=", moduleHandler->GetModuleMetadata()->app_domain_id,
-                              ", Assembly=", moduleHandler->GetModuleMetadata()->assemblyName,
-                              ", Type=", caller.type.name, ", Method=", caller.name, "(", numOfArgs,
-                              " params), Signature=", caller.signature.str(), "]");
-                enumIterator = ++enumIterator;
+                    Logger::Debug("    * Enqueue for ReJIT [ModuleId=", moduleInfo.id,
+                                  ", MethodDef=", TokenStr(&methodDef),
+                                  ", AppDomainId=", moduleHandler->GetModuleMetadata()->app_domain_id,
+                                  ", Assembly=", moduleHandler->GetModuleMetadata()->assemblyName,
+                                  ", Type=", functionInfo.type.name, ", Method=", functionInfo.name, "(", numOfArgs,
+                                  " params), Signature=", functionInfo.signature.str(), "]");
+                }
             }
         }
     }
@@ -853,6 +1366,11 @@ ULONG RejitHandler::ProcessModuleForRejit(const std::vector<ModuleID>& modules,
     // Request the ReJIT for all integrations found in the module.
     if (rejitCount > 0)
     {
+        if (m_pPrecompiledCodeIndex != nullptr)
+        {
+            m_pPrecompiledCodeIndex->AddMethods(vtModules, vtMethodDefs);
+        }
+
         if (enqueueInSameThread)
         {
             RequestRejit(vtModules, vtMethodDefs);
@@ -866,4 +1384,148 @@ ULONG RejitHandler::ProcessModuleForRejit(const std::vector<ModuleID>& modules,
     return rejitCount;
 }
 
-} // namespace trace
\ No newline at end of file
+WSTRING RejitHandler::GetIntegrationName(const IntegrationMethod& integration)
+{
+    // CallTarget definitions without a name are identified by their wrapper type.
+    if (!integration.integration_name.empty())
+    {
+        return integration.integration_name;
+    }
+    return integration.replacement.wrapper_method.type_name;
+}
+
+bool RejitHandler::IsIntegrationDisabled(const WSTRING& integrationName)
+{
+    std::lock_guard<std::mutex> guard(m_disabledIntegrations_lock);
+    if (m_disabledIntegrations.empty())
+    {
+        return false;
+    }
+    return m_disabledIntegrations.find(integrationName) != m_disabledIntegrations.end();
+}
+
+ULONG RejitHandler::DisableIntegration(const WSTRING& integrationName)
+{
+    ReadLock r_lock(m_shutdown_lock);
+    if (m_shutdown)
+    {
+        return 0;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_disabledIntegrations_lock);
+        if (!m_disabledIntegrations.insert(integrationName).second)
+        {
+            return 0;
+        }
+    }
+
+    auto modules = std::make_unique<std::vector<ModuleID>>();
+    auto methodDefs = std::make_unique<std::vector<mdMethodDef>>();
+    GetMethodsForIntegration(integrationName, *modules, *methodDefs, true);
+
+    const auto count = (ULONG) methodDefs->size();
+    Logger::Info("Disabling integration ", integrationName, ", reverting ", count, " methods.");
+    if (count > 0)
+    {
+        m_rejit_queue->push(RejitItem::CreateRevert(std::move(modules), std::move(methodDefs)));
+    }
+    return count;
+}
+
+bool RejitHandler::EnableIntegration(const WSTRING& integrationName)
+{
+    ReadLock r_lock(m_shutdown_lock);
+    if (m_shutdown)
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_disabledIntegrations_lock);
+        if (m_disabledIntegrations.erase(integrationName) == 0)
+        {
+            return false;
+        }
+    }
+
+    Logger::Info("Enabling integration ", integrationName);
+    return true;
+}
+
+ULONG RejitHandler::GetIntegrationRewrittenMethodCount(const WSTRING& integrationName)
+{
+    ReadLock r_lock(m_shutdown_lock);
+    if (m_shutdown)
+    {
+        return 0;
+    }
+
+    std::vector<ModuleID> modules;
+    std::vector<mdMethodDef> methodDefs;
+    GetMethodsForIntegration(integrationName, modules, methodDefs, true);
+    return (ULONG) methodDefs.size();
+}
+
+std::string RejitHandler::InstrumentedMethodsToString()
+{
+    ReadLock r_lock(m_shutdown_lock);
+    if (m_shutdown)
+    {
+        return std::string();
+    }
+
+    // The JIT and ReJIT callbacks wait on these locks, only the copy is made while holding them
+    std::vector<InstrumentedMethodSnapshot> methods;
+    {
+        std::lock_guard<std::mutex> guard(m_modules_lock);
+        for (const auto& mod : m_modules)
+        {
+            mod.second->GetMethodSnapshots(methods);
+        }
+    }
+
+    std::stringstream ss;
+    for (auto& method : methods)
+    {
+        ss << method.moduleId << " " << ToString(TokenStr(&method.methodDef)) << " [" << ToString(method.assemblyName)
+           << "] ";
+        if (!method.methodName.empty())
+        {
+            ss << ToString(method.typeName) << "." << ToString(method.methodName);
+        }
+        ss << " " << ToString(method.integrationName);
+        ss << (method.rewritten ? " rewritten" : " pending") << "\n";
+    }
+    return ss.str();
+}
+
+ULONG RejitHandler::RequestRejitForMethod(const WSTRING& fullMethodName)
+{
+    ReadLock r_lock(m_shutdown_lock);
+    if (m_shutdown)
+    {
+        return 0;
+    }
+
+    std::vector<ModuleID> modules;
+    std::vector<mdMethodDef> methodDefs;
+    {
+        std::lock_guard<std::mutex> guard(m_modules_lock);
+        for (const auto& mod : m_modules)
+        {
+            const auto previousSize = methodDefs.size();
+            mod.second->GetMethodsByName(fullMethodName, methodDefs);
+            modules.insert(modules.end(), methodDefs.size() - previousSize, mod.first);
+        }
+    }
+
+    const auto count = (ULONG) methodDefs.size();
+    if (count > 0)
+    {
+        EnqueueForRejit(modules, methodDefs);
+    }
+    return count;
+}
+
+} // namespace trace
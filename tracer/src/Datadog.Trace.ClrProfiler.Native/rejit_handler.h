@@ -2,16 +2,20 @@
 #define DD_CLR_PROFILER_REJIT_HANDLER_H_
 
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <future>
 
 #include "cor.h"
 #include "corprof.h"
 #include "module_metadata.h"
+#include "precompiled_code_index.h"
+#include "rejit_capabilities.h"
 
 namespace trace
 {
@@ -38,6 +42,32 @@ struct RejitItem
               std::unique_ptr<std::vector<IntegrationMethod>>&& integrationMethods, std::promise<ULONG>* promise);
 
     static std::unique_ptr<RejitItem> CreateEndRejitThread();
+    static std::unique_ptr<RejitItem> CreateRevert(std::unique_ptr<std::vector<ModuleID>>&& modulesId,
+                                                   std::unique_ptr<std::vector<mdMethodDef>>&& methodDefs);
+};
+
+/// <summary>
+/// A parsed method overload considered as a ReJIT target
+/// </summary>
+struct RejitMethodCandidate
+{
+    mdMethodDef methodDef;
+    FunctionInfo functionInfo;
+    std::vector<WSTRING> argumentTypeNames;
+};
+
+/// <summary>
+/// Copy of an instrumented method, taken under the handler locks and formatted outside of them
+/// </summary>
+struct InstrumentedMethodSnapshot
+{
+    ModuleID moduleId;
+    mdMethodDef methodDef;
+    WSTRING assemblyName;
+    WSTRING typeName;
+    WSTRING methodName;
+    WSTRING integrationName;
+    bool rewritten;
 };
 
 // forward declarations...
@@ -54,6 +84,8 @@ private:
     ICorProfilerFunctionControl* m_pFunctionControl;
     std::unique_ptr<FunctionInfo> m_functionInfo;
     std::unique_ptr<MethodReplacement> m_methodReplacement;
+    WSTRING m_integrationName;
+    std::atomic_bool m_rewritten = {false};
 
     std::mutex m_ngenModulesLock;
     std::unordered_map<ModuleID, bool> m_ngenModules;
@@ -62,6 +94,7 @@ private:
 
 public:
     RejitHandlerModuleMethod(mdMethodDef methodDef, RejitHandlerModule* module);
+    ~RejitHandlerModuleMethod();
     mdMethodDef GetMethodDef();
     RejitHandlerModule* GetModule();
 
@@ -74,7 +107,14 @@ public:
     MethodReplacement* GetMethodReplacement();
     void SetMethodReplacement(const MethodReplacement& methodReplacement);
 
+    const WSTRING& GetIntegrationName();
+    void SetIntegrationName(const WSTRING& integrationName);
+
+    bool IsRewritten();
+    void SetRewritten(bool rewritten);
+
     void RequestRejitForInlinersInModule(ModuleID moduleId);
+    void RemoveInlinersModule(ModuleID moduleId);
 };
 
 /// <summary>
@@ -91,6 +131,7 @@ private:
 
 public:
     RejitHandlerModule(ModuleID moduleId, RejitHandler* handler);
+    ~RejitHandlerModule();
     ModuleID GetModuleId();
     RejitHandler* GetHandler();
 
@@ -99,8 +140,13 @@ public:
 
     RejitHandlerModuleMethod* GetOrAddMethod(mdMethodDef methodDef);
     bool ContainsMethod(mdMethodDef methodDef);
+    void GetMethodsForIntegration(const WSTRING& integrationName, std::vector<mdMethodDef>& methodDefs,
+                                  bool onlyRewritten);
+    void GetMethodsByName(const WSTRING& fullMethodName, std::vector<mdMethodDef>& methodDefs);
+    void GetMethodSnapshots(std::vector<InstrumentedMethodSnapshot>& methods);
 
     void RequestRejitForInlinersInModule(ModuleID moduleId);
+    void RemoveInlinersModule(ModuleID moduleId, const std::vector<mdMethodDef>& methodDefs);
 };
 
 /// <summary>
@@ -116,6 +162,10 @@ private:
     std::mutex m_modules_lock;
     std::unordered_map<ModuleID, std::unique_ptr<RejitHandlerModule>> m_modules;
     AssemblyProperty* m_pCorAssemblyProperty = nullptr;
+    ModuleInfoCache* m_pModuleInfoCache = nullptr;
+    MethodSignatureCache* m_pMethodSignatureCache = nullptr;
+    PrecompiledCodeIndex* m_pPrecompiledCodeIndex = nullptr;
+    RejitInlinersCapability m_inliners;
 
     ICorProfilerInfo4* m_profilerInfo;
     ICorProfilerInfo6* m_profilerInfo6;
@@ -128,10 +178,31 @@ private:
     std::mutex m_ngenModules_lock;
     std::vector<ModuleID> m_ngenModules;
 
+    // Methods whose inliners were enumerated in an NGEN module, by that module and the module of the method. An
+    // unloaded module is only forgotten by these methods instead of by every method of every module.
+    std::mutex m_inlinersModules_lock;
+    std::unordered_map<ModuleID, std::unordered_map<ModuleID, std::vector<mdMethodDef>>> m_inlinersModules;
+
+    std::mutex m_disabledIntegrations_lock;
+    std::unordered_set<WSTRING> m_disabledIntegrations;
+
+    // ReJIT compilations in progress of rewritten methods, used to time the JIT per CallTargetKind
+    std::mutex m_rejitCompilations_lock;
+    std::unordered_map<FunctionID, std::pair<CallTargetKind, std::chrono::steady_clock::time_point>>
+        m_rejitCompilations;
+
     static void EnqueueThreadLoop(RejitHandler* handler);
 
     void RequestRejitForInlinersInModule(ModuleID moduleId);
+    void RunRejitWithInlinersSelfTest();
+    void RequestRejitForRuntimeTrackedInliners();
     void RequestRejit(std::vector<ModuleID>& modulesVector, std::vector<mdMethodDef>& modulesMethodDef);
+    void RequestRevert(std::vector<ModuleID>& modulesVector, std::vector<mdMethodDef>& modulesMethodDef);
+    void GetMethodsForIntegration(const WSTRING& integrationName, std::vector<ModuleID>& modulesVector,
+                                  std::vector<mdMethodDef>& modulesMethodDef, bool onlyRewritten);
+
+    std::vector<RejitMethodCandidate> GetRejitMethodCandidates(ModuleID moduleId, ComPtr<IMetaDataImport2>& metadataImport,
+                                                               mdTypeDef typeDef, const WSTRING& methodName);
 
 public:
     RejitHandler(ICorProfilerInfo4* pInfo,
@@ -147,6 +218,7 @@ public:
     bool HasModuleAndMethod(ModuleID moduleId, mdMethodDef methodDef);
 
     void AddNGenModule(ModuleID moduleId);
+    void AddInlinersModule(ModuleID inlinersModuleId, ModuleID moduleId, mdMethodDef methodDef);
 
     void EnqueueProcessModule(const std::vector<ModuleID>& modulesVector,
                               const std::vector<IntegrationMethod>& integrations,
@@ -158,15 +230,32 @@ public:
     HRESULT NotifyReJITParameters(ModuleID moduleId, mdMethodDef methodId,
                                   ICorProfilerFunctionControl* pFunctionControl);
     HRESULT NotifyReJITCompilationStarted(FunctionID functionId, ReJITID rejitId);
+    HRESULT NotifyReJITCompilationFinished(FunctionID functionId, ReJITID rejitId, HRESULT hrStatus);
 
     ICorProfilerInfo4* GetCorProfilerInfo();
     ICorProfilerInfo6* GetCorProfilerInfo6();
 
     void SetCorAssemblyProfiler(AssemblyProperty* pCorAssemblyProfiler);
+    void SetModuleInfoCache(ModuleInfoCache* pModuleInfoCache);
+    void SetMethodSignatureCache(MethodSignatureCache* pMethodSignatureCache);
+    void SetPrecompiledCodeIndex(PrecompiledCodeIndex* pPrecompiledCodeIndex);
+    void ConfigureRejitWithInliners(const RuntimeInformation& runtime, bool enabled);
+    bool IsInliningTrackedByRuntime();
+    bool AddRuntimeTrackedInliner(ModuleID moduleId, mdMethodDef methodDef);
+    PrecompiledCodeIndex* GetPrecompiledCodeIndex();
     void RequestRejitForNGenInliners();
     ULONG ProcessModuleForRejit(const std::vector<ModuleID>& modules,
                                 const std::vector<IntegrationMethod>& integrations,
                                 bool enqueueInSameThread = false);
+
+    static WSTRING GetIntegrationName(const IntegrationMethod& integration);
+    bool IsIntegrationDisabled(const WSTRING& integrationName);
+    ULONG DisableIntegration(const WSTRING& integrationName);
+    bool EnableIntegration(const WSTRING& integrationName);
+    ULONG GetIntegrationRewrittenMethodCount(const WSTRING& integrationName);
+
+    std::string InstrumentedMethodsToString();
+    ULONG RequestRejitForMethod(const WSTRING& fullMethodName);
 };
 
 } // namespace trace
@@ -3,310 +3,305 @@
 namespace trace
 {
 
-bool ParseNumber(PCCOR_SIGNATURE* p_sig, ULONG* number)
+bool ParseByte(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, unsigned char* pbOut)
 {
-    ULONG result = CorSigUncompressData(*p_sig, number);
-    if (result == -1)
+    if (pbCur < pbEnd)
     {
-        return false;
+        *pbOut = *pbCur;
+        pbCur++;
+        return true;
     }
 
-    *p_sig += result;
-    return true;
+    return false;
 }
 
-bool ParseTypeDefOrRefEncoded(PCCOR_SIGNATURE* p_sig)
+bool ParseNumber(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, unsigned* pOut)
 {
-    mdToken type_token;
-    ULONG result;
-    result = CorSigUncompressToken(*p_sig, &type_token);
-    if (result == -1)
-    {
-        return false;
-    }
+    // parse the variable length number format (0-4 bytes)
 
-    *p_sig += result;
-    return true;
-}
+    unsigned char b1 = 0, b2 = 0, b3 = 0, b4 = 0;
 
-bool ParseCustomMod(PCCOR_SIGNATURE* p_sig)
-{
-    if (**p_sig == ELEMENT_TYPE_CMOD_OPT || **p_sig == ELEMENT_TYPE_CMOD_REQD)
-    {
-        *p_sig += 1;
-        return ParseTypeDefOrRefEncoded(p_sig);
-    }
+    // at least one byte in the encoding, read that
 
-    return false;
-}
+    if (!ParseByte(pbCur, pbEnd, &b1)) return false;
 
-bool ParseOptionalCustomMods(PCCOR_SIGNATURE* p_sig)
-{
-    while (true)
+    if (b1 == 0xff)
     {
-        switch (**p_sig)
-        {
-            case ELEMENT_TYPE_CMOD_OPT:
-            case ELEMENT_TYPE_CMOD_REQD:
-                if (!ParseCustomMod(p_sig))
-                {
-                    return false;
-                }
-                break;
-            default:
-                return true;
-        }
+        // special encoding of 'NULL'
+        // not sure what this means as a number, don't expect to see it except for
+        // string lengths which we don't encounter anyway so calling it an error
+        return false;
     }
 
-    return false;
-}
-
-bool ParseRetType(PCCOR_SIGNATURE* p_sig)
-{
-    if (!ParseOptionalCustomMods(p_sig))
+    // early out on 1 byte encoding
+    if ((b1 & 0x80) == 0)
     {
-        return false;
+        *pOut = (int) b1;
+        return true;
     }
 
-    if (**p_sig == ELEMENT_TYPE_TYPEDBYREF || **p_sig == ELEMENT_TYPE_VOID)
+    // now at least 2 bytes in the encoding, read 2nd byte
+    if (!ParseByte(pbCur, pbEnd, &b2)) return false;
+
+    // early out on 2 byte encoding
+    if ((b1 & 0x40) == 0)
     {
-        *p_sig += 1;
+        *pOut = (((b1 & 0x3f) << 8) | b2);
         return true;
     }
 
-    if (**p_sig == ELEMENT_TYPE_BYREF)
+    // must be a 4 byte encoding
+    if ((b1 & 0x20) != 0)
     {
-        *p_sig += 1;
+        // 4 byte encoding has this bit clear -- error if not
+        return false;
     }
 
-    return ParseType(p_sig);
+    if (!ParseByte(pbCur, pbEnd, &b3)) return false;
+
+    if (!ParseByte(pbCur, pbEnd, &b4)) return false;
+
+    *pOut = ((b1 & 0x1f) << 24) | (b2 << 16) | (b3 << 8) | b4;
+    return true;
 }
 
-bool ParseParam(PCCOR_SIGNATURE* p_sig)
+bool ParseTypeDefOrRefEncoded(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, mdToken* pTokenOut)
 {
-    if (!ParseOptionalCustomMods(p_sig))
-    {
-        return false;
-    }
+    // parse an encoded typedef, typeref or typespec
+    static const mdToken token_types[] = {mdtTypeDef, mdtTypeRef, mdtTypeSpec};
+    unsigned encoded = 0;
 
-    if (**p_sig == ELEMENT_TYPE_TYPEDBYREF)
-    {
-        *p_sig += 1;
-        return true;
-    }
+    if (!ParseNumber(pbCur, pbEnd, &encoded)) return false;
 
-    if (**p_sig == ELEMENT_TYPE_BYREF)
-    {
-        *p_sig += 1;
-    }
+    const unsigned index_type = encoded & 0x3;
+    if (index_type > 2) return false;
 
-    return ParseType(p_sig);
+    *pTokenOut = TokenFromRid(encoded >> 2, token_types[index_type]);
+    return true;
 }
 
-bool ParseMethod(PCCOR_SIGNATURE* p_sig)
+bool ParseCustomMod(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd)
 {
-    // Format:  [[HASTHIS] [EXPLICITTHIS]] (DEFAULT|VARARG|GENERIC GenParamCount)
-    //                    ParamCount RetType Param* [SENTINEL Param+]
-    if (**p_sig == IMAGE_CEE_CS_CALLCONV_GENERIC)
-    {
-        *p_sig += 1;
+    // CustomMod ::= ( CMOD_OPT | CMOD_REQD ) TypeDefOrRefEncoded
+    unsigned char elem_type;
+    mdToken token;
 
-        ULONG generic_count = 0;
-        if (!ParseNumber(p_sig, &generic_count))
-        {
-            return false;
-        }
-    }
+    if (!ParseByte(pbCur, pbEnd, &elem_type)) return false;
 
-    ULONG param_count = 0;
-    if (!ParseNumber(p_sig, &param_count))
-    {
-        return false;
-    }
+    if (elem_type != ELEMENT_TYPE_CMOD_OPT && elem_type != ELEMENT_TYPE_CMOD_REQD) return false;
 
-    if (!ParseRetType(p_sig))
-    {
-        return false;
-    }
+    return ParseTypeDefOrRefEncoded(pbCur, pbEnd, &token);
+}
 
-    bool sentinel_found = false;
-    for (ULONG i = 0; i < param_count; i++)
+bool ParseOptionalCustomMods(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar)
+{
+    while (pbCur < pbEnd && (*pbCur == ELEMENT_TYPE_CMOD_OPT || *pbCur == ELEMENT_TYPE_CMOD_REQD))
     {
-        if (**p_sig == ELEMENT_TYPE_SENTINEL)
-        {
-            if (sentinel_found)
-            {
-                return false;
-            }
+        if (grammar == SignatureGrammar::CallTarget) return false;
 
-            sentinel_found = true;
-            *p_sig += 1;
-        }
-
-        if (!ParseParam(p_sig))
-        {
-            return false;
-        }
+        if (!ParseCustomMod(pbCur, pbEnd)) return false;
     }
 
-    return true;
+    return pbCur < pbEnd;
 }
 
-bool ParseArrayShape(PCCOR_SIGNATURE* p_sig)
+bool ParseArrayShape(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd)
 {
-    // Format: Rank NumSizes Size* NumLoBounds LoBound*
-    ULONG rank = 0, numsizes = 0, size = 0;
-    if (!ParseNumber(p_sig, &rank) || !ParseNumber(p_sig, &numsizes))
-    {
-        return false;
-    }
+    // ArrayShape ::= Rank NumSizes Size* NumLoBounds LoBound*
+    unsigned rank = 0, count = 0, value = 0;
 
-    for (ULONG i = 0; i < numsizes; i++)
-    {
-        if (!ParseNumber(p_sig, &size))
-        {
-            return false;
-        }
-    }
+    if (!ParseNumber(pbCur, pbEnd, &rank)) return false;
+
+    if (!ParseNumber(pbCur, pbEnd, &count)) return false;
 
-    if (!ParseNumber(p_sig, &numsizes))
+    for (unsigned i = 0; i < count; i++)
     {
-        return false;
+        if (!ParseNumber(pbCur, pbEnd, &value)) return false;
     }
 
-    for (ULONG i = 0; i < numsizes; i++)
+    if (!ParseNumber(pbCur, pbEnd, &count)) return false;
+
+    for (unsigned i = 0; i < count; i++)
     {
-        if (!ParseNumber(p_sig, &size))
-        {
-            return false;
-        }
+        // lower bounds are signed, but they use the same compressed width
+        if (!ParseNumber(pbCur, pbEnd, &value)) return false;
     }
 
     return true;
 }
 
-// Returns whether or not the Type signature at the given address could be parsed.
-// If successful, the input pointer will point to the next byte following the Type signature.
-// If not, the input pointer may point to invalid data.
-bool ParseType(PCCOR_SIGNATURE* p_sig)
+bool ParseType(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar)
 {
     /*
-    Format = BOOLEAN | CHAR | I1 | U1 | U2 | U2 | I4 | U4 | I8 | U8 | R4 | R8 | I | U | STRING | OBJECT
-                 | VALUETYPE TypeDefOrRefEncoded
-                 | CLASS TypeDefOrRefEncoded
-                 | PTR CustomMod* VOID
-                 | PTR CustomMod* Type
-                 | FNPTR MethodDefSig
-                 | FNPTR MethodRefSig
-                 | ARRAY Type ArrayShape
-                 | SZARRAY CustomMod* Type
-                 | GENERICINST (CLASS | VALUETYPE) TypeDefOrRefEncoded GenArgCount Type *
-                 | VAR Number
-                 | MVAR Number
+    Type ::= ( BOOLEAN | CHAR | I1 | U1 | U2 | U2 | I4 | U4 | I8 | U8 | R4 | R8 |
+    I | U | | VALUETYPE TypeDefOrRefEncoded | CLASS TypeDefOrRefEncoded | STRING
+    | OBJECT
+    | PTR CustomMod* VOID
+    | PTR CustomMod* Type
+    | FNPTR MethodDefSig
+    | FNPTR MethodRefSig
+    | ARRAY Type ArrayShape
+    | SZARRAY CustomMod* Type
+    | GENERICINST (CLASS | VALUETYPE) TypeDefOrRefEncoded GenArgCount Type *
+    | VAR Number
+    | MVAR Number
     */
 
-    const auto cor_element_type = CorElementType(**p_sig);
-    ULONG number = 0;
-    *p_sig += 1;
+    const bool full = grammar == SignatureGrammar::Full;
+    unsigned char elem_type;
+    unsigned number;
+    mdToken token;
 
-    switch (cor_element_type)
+    if (!ParseByte(pbCur, pbEnd, &elem_type)) return false;
+
+    switch (elem_type)
     {
-        case ELEMENT_TYPE_VOID:
         case ELEMENT_TYPE_BOOLEAN:
         case ELEMENT_TYPE_CHAR:
         case ELEMENT_TYPE_I1:
         case ELEMENT_TYPE_U1:
-        case ELEMENT_TYPE_I2:
         case ELEMENT_TYPE_U2:
+        case ELEMENT_TYPE_I2:
         case ELEMENT_TYPE_I4:
         case ELEMENT_TYPE_U4:
         case ELEMENT_TYPE_I8:
         case ELEMENT_TYPE_U8:
         case ELEMENT_TYPE_R4:
         case ELEMENT_TYPE_R8:
+        case ELEMENT_TYPE_I:
+        case ELEMENT_TYPE_U:
         case ELEMENT_TYPE_STRING:
         case ELEMENT_TYPE_OBJECT:
+            // simple types
             return true;
 
+        case ELEMENT_TYPE_CLASS:
+        case ELEMENT_TYPE_VALUETYPE:
+            // CLASS TypeDefOrRefEncoded
+            // VALUETYPE TypeDefOrRefEncoded
+            return ParseTypeDefOrRefEncoded(pbCur, pbEnd, &token);
+
         case ELEMENT_TYPE_PTR:
-            // Format: PTR CustomMod* VOID
-            // Format: PTR CustomMod* Type
-            if (!ParseOptionalCustomMods(p_sig))
-            {
-                return false;
-            }
+            // PTR CustomMod* VOID
+            // PTR CustomMod* Type
+            if (!full || !ParseOptionalCustomMods(pbCur, pbEnd, grammar)) return false;
 
-            if (**p_sig == ELEMENT_TYPE_VOID)
+            if (*pbCur == ELEMENT_TYPE_VOID)
             {
-                *p_sig += 1;
+                pbCur++;
                 return true;
             }
-            else
-            {
-                return ParseType(p_sig);
-            }
 
-        case ELEMENT_TYPE_VALUETYPE:
-        case ELEMENT_TYPE_CLASS:
-            // Format: CLASS TypeDefOrRefEncoded
-            // Format: VALUETYPE TypeDefOrRefEncoded
-            return ParseTypeDefOrRefEncoded(p_sig);
+            return ParseType(pbCur, pbEnd, grammar);
 
         case ELEMENT_TYPE_FNPTR:
-            // Format: FNPTR MethodDefSig
-            // Format: FNPTR MethodRefSig
-            return ParseMethod(p_sig);
+            // FNPTR MethodDefSig
+            // FNPTR MethodRefSig
+            return full && ParseMethod(pbCur, pbEnd, grammar);
 
         case ELEMENT_TYPE_ARRAY:
-            // Format: ARRAY Type ArrayShape
-            if (!ParseType(p_sig))
-            {
-                return false;
-            }
-            return ParseArrayShape(p_sig);
+            // ARRAY Type ArrayShape
+            return full && ParseType(pbCur, pbEnd, grammar) && ParseArrayShape(pbCur, pbEnd);
 
         case ELEMENT_TYPE_SZARRAY:
-            // Format: SZARRAY CustomMod* Type
-            if (!ParseOptionalCustomMods(p_sig))
-            {
-                return false;
-            }
-            return ParseType(p_sig);
+            // SZARRAY CustomMod* Type
+            return ParseOptionalCustomMods(pbCur, pbEnd, grammar) && ParseType(pbCur, pbEnd, grammar);
 
         case ELEMENT_TYPE_GENERICINST:
-            if (**p_sig != ELEMENT_TYPE_VALUETYPE && **p_sig != ELEMENT_TYPE_CLASS)
-            {
-                return false;
-            }
+            // GENERICINST (CLASS | VALUETYPE) TypeDefOrRefEncoded GenArgCount Type *
+            if (!ParseByte(pbCur, pbEnd, &elem_type)) return false;
 
-            *p_sig += 1;
-            if (!ParseTypeDefOrRefEncoded(p_sig))
-            {
-                return false;
-            }
+            if (elem_type != ELEMENT_TYPE_CLASS && elem_type != ELEMENT_TYPE_VALUETYPE) return false;
 
-            if (!ParseNumber(p_sig, &number))
-            {
-                return false;
-            }
+            if (!ParseTypeDefOrRefEncoded(pbCur, pbEnd, &token)) return false;
+
+            if (!ParseNumber(pbCur, pbEnd, &number)) return false;
 
-            for (ULONG i = 0; i < number; i++)
+            for (unsigned i = 0; i < number; i++)
             {
-                if (!ParseType(p_sig))
-                {
-                    return false;
-                }
+                if (!ParseType(pbCur, pbEnd, grammar)) return false;
             }
             return true;
 
         case ELEMENT_TYPE_VAR:
         case ELEMENT_TYPE_MVAR:
-            // Format: VAR Number
-            // Format: MVAR Number
-            return ParseNumber(p_sig, &number);
+            // VAR Number
+            // MVAR Number
+            return ParseNumber(pbCur, pbEnd, &number);
 
         default:
             return false;
     }
 }
-} // namespace trace
\ No newline at end of file
+
+// Param ::= CustomMod* ( TYPEDBYREF | [BYREF] Type )
+bool ParseParam(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar)
+{
+    if (!ParseOptionalCustomMods(pbCur, pbEnd, grammar)) return false;
+
+    if (*pbCur == ELEMENT_TYPE_TYPEDBYREF)
+    {
+        if (grammar == SignatureGrammar::CallTarget) return false;
+
+        pbCur++;
+        return true;
+    }
+
+    if (*pbCur == ELEMENT_TYPE_BYREF) pbCur++;
+
+    return ParseType(pbCur, pbEnd, grammar);
+}
+
+// RetType ::= CustomMod* ( VOID | TYPEDBYREF | [BYREF] Type )
+bool ParseRetType(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar)
+{
+    if (!ParseOptionalCustomMods(pbCur, pbEnd, grammar)) return false;
+
+    if (*pbCur == ELEMENT_TYPE_VOID)
+    {
+        pbCur++;
+        return true;
+    }
+
+    return ParseParam(pbCur, pbEnd, grammar);
+}
+
+bool ParseMethod(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar)
+{
+    // Format:  [[HASTHIS] [EXPLICITTHIS]] (DEFAULT|VARARG|GENERIC GenParamCount)
+    //                    ParamCount RetType Param* [SENTINEL Param+]
+    unsigned char calling_convention;
+    unsigned number;
+
+    if (!ParseByte(pbCur, pbEnd, &calling_convention)) return false;
+
+    if (calling_convention & IMAGE_CEE_CS_CALLCONV_GENERIC)
+    {
+        if (!ParseNumber(pbCur, pbEnd, &number)) return false;
+    }
+
+    unsigned param_count;
+    if (!ParseNumber(pbCur, pbEnd, &param_count)) return false;
+
+    if (!ParseRetType(pbCur, pbEnd, grammar)) return false;
+
+    bool sentinel_found = false;
+    for (unsigned i = 0; i < param_count; i++)
+    {
+        if (pbCur >= pbEnd) return false;
+
+        if (*pbCur == ELEMENT_TYPE_SENTINEL)
+        {
+            if (sentinel_found) return false;
+
+            sentinel_found = true;
+            pbCur++;
+        }
+
+        if (!ParseParam(pbCur, pbEnd, grammar)) return false;
+    }
+
+    return true;
+}
+
+} // namespace trace
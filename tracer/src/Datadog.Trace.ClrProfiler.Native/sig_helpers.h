@@ -5,6 +5,24 @@
 namespace trace
 {
 
-bool ParseType(PCCOR_SIGNATURE* p_sig);
+// Which part of the ECMA-335 signature grammar the bounds checked parsers accept.
+enum class SignatureGrammar
+{
+    // Every type the runtime can produce
+    Full,
+    // Only what CallTarget can pass to the integrations: no pointers, function pointers, multi-dimensional
+    // arrays, custom modifiers or TYPEDBYREF, and VOID only as a return type
+    CallTarget
+};
+
+// Bounds checked signature readers. They return false when the signature is truncated, malformed or uses
+// something the grammar doesn't accept, and leave pbCur after the parsed element when they succeed.
+bool ParseByte(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, unsigned char* pbOut);
+bool ParseNumber(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, unsigned* pOut);
+bool ParseTypeDefOrRefEncoded(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, mdToken* pTokenOut);
+bool ParseType(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar);
+bool ParseParam(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar);
+bool ParseRetType(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar);
+bool ParseMethod(PCCOR_SIGNATURE& pbCur, PCCOR_SIGNATURE pbEnd, SignatureGrammar grammar);
 
 } // namespace trace
@@ -0,0 +1,195 @@
+#include "skip_assembly_matcher.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+
+#include "dd_profiler_constants.h"
+
+namespace trace
+{
+
+SkipAssemblyMatcher::SkipAssemblyMatcher(const std::vector<WSTRING>& exactNames, const std::vector<WSTRING>& prefixes)
+{
+    for (const auto& name : exactNames)
+    {
+        if (std::find(m_exactNames.begin(), m_exactNames.end(), name) == m_exactNames.end())
+        {
+            m_exactNames.push_back(name);
+        }
+    }
+
+    BuildExactTable();
+    BuildPrefixTrie(prefixes);
+}
+
+uint32_t SkipAssemblyMatcher::Hash(const WCHAR* name, size_t length, uint32_t seed)
+{
+    // FNV-1a over the UTF-16 code units
+    uint32_t hash = 2166136261u ^ seed;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint32_t) name[i];
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 15);
+}
+
+void SkipAssemblyMatcher::BuildExactTable()
+{
+    uint32_t size = 8;
+    while (size < m_exactNames.size() * 2)
+    {
+        size <<= 1;
+    }
+
+    // Look for a seed that places every name in a different slot. With a load factor of at most
+    // one half this usually takes a few attempts; the table grows if none of the seeds work.
+    while (true)
+    {
+        for (uint32_t seed = 0; seed < 64; seed++)
+        {
+            std::vector<int32_t> slots(size, -1);
+            bool collision = false;
+            for (size_t i = 0; i < m_exactNames.size() && !collision; i++)
+            {
+                const auto& name = m_exactNames[i];
+                auto& slot = slots[Hash(name.c_str(), name.size(), seed) & (size - 1)];
+                collision = slot != -1;
+                slot = (int32_t) i;
+            }
+
+            if (!collision)
+            {
+                m_exactSlots = std::move(slots);
+                m_exactSeed = seed;
+                m_exactMask = size - 1;
+                return;
+            }
+        }
+
+        size <<= 1;
+    }
+}
+
+void SkipAssemblyMatcher::BuildPrefixTrie(const std::vector<WSTRING>& prefixes)
+{
+    struct BuilderNode
+    {
+        bool terminal = false;
+        std::map<WCHAR, std::unique_ptr<BuilderNode>> children;
+    };
+
+    BuilderNode root;
+    for (const auto& prefix : prefixes)
+    {
+        BuilderNode* current = &root;
+        for (const auto c : prefix)
+        {
+            auto& child = current->children[c];
+            if (child == nullptr)
+            {
+                child = std::make_unique<BuilderNode>();
+            }
+            current = child.get();
+        }
+        current->terminal = true;
+    }
+
+    // Flatten breadth first; the edges of a node are contiguous and sorted by label.
+    std::vector<const BuilderNode*> queue = {&root};
+    m_nodes.emplace_back();
+    for (size_t i = 0; i < queue.size(); i++)
+    {
+        const BuilderNode* builderNode = queue[i];
+        m_nodes[i].terminal = builderNode->terminal;
+        m_nodes[i].firstEdge = (uint32_t) m_edges.size();
+        m_nodes[i].edgeCount = (uint32_t) builderNode->children.size();
+
+        for (const auto& child : builderNode->children)
+        {
+            m_edges.push_back({child.first, (uint32_t) queue.size()});
+            queue.push_back(child.second.get());
+            m_nodes.emplace_back();
+        }
+    }
+}
+
+SkipAssemblyMatch SkipAssemblyMatcher::Match(const WCHAR* name, size_t length) const
+{
+    if (!m_exactNames.empty())
+    {
+        const int32_t index = m_exactSlots[Hash(name, length, m_exactSeed) & m_exactMask];
+        if (index != -1)
+        {
+            const WSTRING& candidate = m_exactNames[index];
+            if (candidate.size() == length && std::memcmp(candidate.c_str(), name, length * sizeof(WCHAR)) == 0)
+            {
+                return SkipAssemblyMatch::Exact;
+            }
+        }
+    }
+
+    const TrieNode* node = &m_nodes[0];
+    for (size_t i = 0; !node->terminal; i++)
+    {
+        if (i == length || node->edgeCount == 0)
+        {
+            return SkipAssemblyMatch::None;
+        }
+
+        const auto first = m_edges.begin() + node->firstEdge;
+        const auto last = first + node->edgeCount;
+        const WCHAR c = name[i];
+        const auto edge =
+            std::lower_bound(first, last, c, [](const TrieEdge& edge, WCHAR label) { return edge.label < label; });
+        if (edge == last || edge->label != c)
+        {
+            return SkipAssemblyMatch::None;
+        }
+
+        node = &m_nodes[edge->node];
+    }
+
+    return SkipAssemblyMatch::Prefix;
+}
+
+const SkipAssemblyMatcher& SkipAssemblyMatcher::Default()
+{
+    static const SkipAssemblyMatcher matcher(
+        std::vector<WSTRING>(std::begin(skip_assemblies), std::end(skip_assemblies)),
+        std::vector<WSTRING>(std::begin(skip_assembly_prefixes), std::end(skip_assembly_prefixes)));
+    return matcher;
+}
+
+void SkipAssemblyMatcher::GetAssemblyNameFromPath(const WCHAR* path, const WCHAR** name, size_t* length)
+{
+    const WCHAR* start = path;
+    const WCHAR* end = path;
+    for (; *end != 0; end++)
+    {
+        if (*end == '\\' || *end == '/')
+        {
+            start = end + 1;
+        }
+    }
+
+    static const WCHAR niDllExtension[] = {'.', 'n', 'i', '.', 'd', 'l', 'l'};
+    static const WCHAR dllExtension[] = {'.', 'd', 'l', 'l'};
+
+    const size_t segmentLength = end - start;
+    if (segmentLength >= 7 && std::memcmp(end - 7, niDllExtension, sizeof(niDllExtension)) == 0)
+    {
+        end -= 7;
+    }
+    else if (segmentLength >= 4 && std::memcmp(end - 4, dllExtension, sizeof(dllExtension)) == 0)
+    {
+        end -= 4;
+    }
+
+    *name = start;
+    *length = end - start;
+}
+
+} // namespace trace
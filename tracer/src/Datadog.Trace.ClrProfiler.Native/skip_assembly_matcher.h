@@ -0,0 +1,72 @@
+#ifndef DD_CLR_PROFILER_SKIP_ASSEMBLY_MATCHER_H_
+#define DD_CLR_PROFILER_SKIP_ASSEMBLY_MATCHER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "string.h" // NOLINT
+
+namespace trace
+{
+
+enum class SkipAssemblyMatch
+{
+    None = 0,
+    Exact = 1,
+    Prefix = 2
+};
+
+/// <summary>
+/// Decides whether an assembly name belongs to the skip lists, working directly on UTF-16 code units.
+/// Exact names are stored in a collision-free open-addressing table (the hash seed is chosen at
+/// construction time so every name lands in its own slot) and prefixes in a flattened trie, so a
+/// lookup is one hash plus one walk over the name and never allocates.
+/// </summary>
+class SkipAssemblyMatcher
+{
+private:
+    struct TrieNode
+    {
+        uint32_t firstEdge = 0;
+        uint32_t edgeCount = 0;
+        bool terminal = false;
+    };
+
+    struct TrieEdge
+    {
+        WCHAR label;
+        uint32_t node;
+    };
+
+    std::vector<WSTRING> m_exactNames;
+    std::vector<int32_t> m_exactSlots;
+    uint32_t m_exactSeed = 0;
+    uint32_t m_exactMask = 0;
+
+    std::vector<TrieNode> m_nodes;
+    std::vector<TrieEdge> m_edges;
+
+    static uint32_t Hash(const WCHAR* name, size_t length, uint32_t seed);
+    void BuildExactTable();
+    void BuildPrefixTrie(const std::vector<WSTRING>& prefixes);
+
+public:
+    SkipAssemblyMatcher(const std::vector<WSTRING>& exactNames, const std::vector<WSTRING>& prefixes);
+
+    SkipAssemblyMatch Match(const WCHAR* name, size_t length) const;
+    SkipAssemblyMatch Match(const WSTRING& name) const
+    {
+        return Match(name.c_str(), name.size());
+    }
+
+    // Matcher built from skip_assemblies and skip_assembly_prefixes.
+    static const SkipAssemblyMatcher& Default();
+
+    // Returns the assembly name segment of an assembly path, without the directory and the
+    // ".ni.dll" or ".dll" extension. The result points into the given path.
+    static void GetAssemblyNameFromPath(const WCHAR* path, const WCHAR** name, size_t* length);
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_SKIP_ASSEMBLY_MATCHER_H_
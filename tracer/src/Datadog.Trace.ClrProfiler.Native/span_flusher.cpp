@@ -0,0 +1,411 @@
+#include "span_flusher.h"
+
+#include "logger.h"
+#include "stats.h"
+#include "version.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+#endif
+
+namespace trace
+{
+
+const std::string kSpanSinkFilePrefix = "file:";
+const std::string kSpanSinkUnixPrefix = "unix:";
+
+//
+// FileSpanSink
+//
+
+FileSpanSink::FileSpanSink(const std::string& path) : m_path(path)
+{
+    m_file = fopen(path.c_str(), "ab");
+    if (m_file == nullptr)
+    {
+        Logger::Warn("FileSpanSink: unable to open ", path);
+    }
+}
+
+FileSpanSink::~FileSpanSink()
+{
+    if (m_file != nullptr)
+    {
+        fclose(m_file);
+        Logger::Info("FileSpanSink: wrote ", m_traces, " traces in ", m_payloads, " payloads to ", m_path);
+    }
+}
+
+bool FileSpanSink::Write(const uint8_t* payload, size_t size, uint32_t traceCount)
+{
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+
+    if (fwrite(payload, 1, size, m_file) != size || fflush(m_file) != 0)
+    {
+        return false;
+    }
+
+    m_traces += traceCount;
+    m_payloads++;
+    return true;
+}
+
+uint64_t FileSpanSink::GetTraceCount() const
+{
+    return m_traces;
+}
+
+//
+// UnixSocketSpanSink
+//
+
+UnixSocketSpanSink::UnixSocketSpanSink(const std::string& path) : m_path(path)
+{
+}
+
+#ifdef _WIN32
+
+bool UnixSocketSpanSink::Write(const uint8_t* payload, size_t size, uint32_t traceCount)
+{
+    if (!m_failing)
+    {
+        Logger::Warn("UnixSocketSpanSink: Unix domain sockets are not supported on Windows");
+        m_failing = true;
+    }
+    return false;
+}
+
+#else
+
+static bool SendAll(int socket, const char* data, size_t size)
+{
+    size_t sent = 0;
+    while (sent < size)
+    {
+        const auto res = send(socket, data + sent, size - sent, MSG_NOSIGNAL);
+        if (res <= 0)
+        {
+            return false;
+        }
+        sent += (size_t) res;
+    }
+    return true;
+}
+
+bool UnixSocketSpanSink::Write(const uint8_t* payload, size_t size, uint32_t traceCount)
+{
+    sockaddr_un address{};
+    if (m_path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+
+    const int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client < 0)
+    {
+        return false;
+    }
+
+#ifdef SO_NOSIGPIPE
+    const int noSigPipe = 1;
+    setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigPipe, sizeof(noSigPipe));
+#endif
+
+    // A stalled agent must not hold the flush thread for long, records keep piling up meanwhile
+    timeval timeout{};
+    timeout.tv_sec = 2;
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, m_path.c_str(), sizeof(address.sun_path) - 1);
+
+    bool success = false;
+    if (connect(client, (sockaddr*) &address, sizeof(address)) == 0)
+    {
+        std::string request = "PUT /v0.4/traces HTTP/1.1\r\n"
+                              "Host: localhost\r\n"
+                              "Connection: close\r\n"
+                              "Content-Type: application/msgpack\r\n"
+                              "Datadog-Meta-Lang: .NET\r\n"
+                              "Datadog-Meta-Tracer-Version: ";
+        request += PROFILER_VERSION;
+        request += "\r\nX-Datadog-Trace-Count: " + std::to_string(traceCount);
+        request += "\r\nContent-Length: " + std::to_string(size) + "\r\n\r\n";
+
+        if (SendAll(client, request.c_str(), request.size()) &&
+            SendAll(client, reinterpret_cast<const char*>(payload), size))
+        {
+            // Only the status line matters: "HTTP/1.1 200 OK"
+            std::string response;
+            char buffer[256];
+            ssize_t read = 0;
+            while (response.find("\r\n") == std::string::npos &&
+                   (read = recv(client, buffer, sizeof(buffer), 0)) > 0)
+            {
+                response.append(buffer, (size_t) read);
+            }
+            success = response.size() > 9 && response.compare(0, 5, "HTTP/") == 0 && response[9] == '2';
+        }
+    }
+
+    if (!success && !m_failing)
+    {
+        Logger::Warn("UnixSocketSpanSink: unable to send traces to ", m_path, " error ", errno);
+    }
+    m_failing = !success;
+
+    close(client);
+    return success;
+}
+
+#endif
+
+//
+// InProcessSpanSink
+//
+
+bool InProcessSpanSink::Write(const uint8_t* payload, size_t size, uint32_t traceCount)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_failing)
+    {
+        return false;
+    }
+
+    m_payloads.emplace_back(payload, payload + size);
+    m_traces += traceCount;
+    return true;
+}
+
+std::vector<std::vector<uint8_t>> InProcessSpanSink::GetPayloads() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_payloads;
+}
+
+uint64_t InProcessSpanSink::GetTraceCount() const
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    return m_traces;
+}
+
+void InProcessSpanSink::SetFailing(bool failing)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_failing = failing;
+}
+
+std::unique_ptr<SpanSink> CreateSpanSink(const std::string& output)
+{
+    if (output.rfind(kSpanSinkFilePrefix, 0) == 0 && output.size() > kSpanSinkFilePrefix.size())
+    {
+        return std::make_unique<FileSpanSink>(output.substr(kSpanSinkFilePrefix.size()));
+    }
+
+    if (output.rfind(kSpanSinkUnixPrefix, 0) == 0 && output.size() > kSpanSinkUnixPrefix.size())
+    {
+        return std::make_unique<UnixSocketSpanSink>(output.substr(kSpanSinkUnixPrefix.size()));
+    }
+
+    return nullptr;
+}
+
+//
+// SpanFlusher
+//
+
+SpanFlusher::SpanFlusher(std::unique_ptr<SpanSink> sink, const SpanFlusherOptions& options) :
+    m_buffer(options.capacity, options.max_record_size, options.max_record_size),
+    m_sink(std::move(sink)),
+    m_options(options)
+{
+    if (m_options.batch_size == 0)
+    {
+        m_options.batch_size = 1;
+    }
+    m_batch.resize(m_options.batch_size);
+}
+
+SpanFlusher::~SpanFlusher()
+{
+    Stop();
+}
+
+bool SpanFlusher::Start()
+{
+    if (m_running || m_stopped || m_sink == nullptr)
+    {
+        return false;
+    }
+
+    m_running = true;
+    m_thread = std::make_unique<std::thread>(FlushThreadLoop, this);
+    return true;
+}
+
+void SpanFlusher::Stop()
+{
+    m_stopped = true;
+    if (!m_running.exchange(false))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_wake_condition.notify_one();
+    }
+
+    if (m_thread != nullptr && m_thread->joinable())
+    {
+        m_thread->join();
+    }
+    m_thread = nullptr;
+}
+
+bool SpanFlusher::IsRunning() const
+{
+    return m_running;
+}
+
+void SpanFlusher::Wake()
+{
+    // Producers don't take the lock: a wake up lost between the predicate check and the wait of the flush
+    // thread only delays the flush until the next interval.
+    if (!m_wake.load(std::memory_order_relaxed) && !m_wake.exchange(true))
+    {
+        m_wake_condition.notify_one();
+    }
+}
+
+HRESULT SpanFlusher::Enqueue(const uint8_t* data, size_t size)
+{
+    if (data == nullptr && size > 0)
+    {
+        return E_INVALIDARG;
+    }
+
+    // Nothing would drain the buffer anymore
+    if (m_stopped)
+    {
+        Stats::Instance()->SpanBufferDropped();
+        return E_ABORT;
+    }
+
+    switch (m_buffer.TryEnqueue(data, size))
+    {
+        case RecordEnqueueResult::Accepted:
+            Stats::Instance()->SpanBufferEnqueued();
+            if (m_buffer.ApproximateSize() >= m_options.batch_size)
+            {
+                Wake();
+            }
+            return S_OK;
+        case RecordEnqueueResult::AcceptedAboveWatermark:
+            Stats::Instance()->SpanBufferEnqueued();
+            Stats::Instance()->SpanBufferBackpressure();
+            Wake();
+            return S_FALSE;
+        case RecordEnqueueResult::Full:
+            Stats::Instance()->SpanBufferDropped();
+            Wake();
+            return E_OUTOFMEMORY;
+        default:
+            Stats::Instance()->SpanBufferDropped();
+            return E_INVALIDARG;
+    }
+}
+
+bool SpanFlusher::Flush(std::chrono::milliseconds timeout)
+{
+    if (!m_running)
+    {
+        return false;
+    }
+
+    const auto target = m_buffer.EnqueuePosition();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wake = true;
+    m_wake_condition.notify_one();
+    return m_flushed_condition.wait_for(lock, timeout, [this, target] { return m_buffer.DequeuePosition() >= target; });
+}
+
+size_t SpanFlusher::FlushBatch()
+{
+    const auto count = m_buffer.Peek(m_batch.data(), m_batch.size());
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const uint8_t* payload = nullptr;
+    size_t payloadSize = 0;
+    uint32_t traceCount = 0;
+    size_t invalidCount = 0;
+    if (SUCCEEDED(
+            m_serializer.SerializeBatch(m_batch.data(), count, &payload, &payloadSize, &traceCount, &invalidCount)))
+    {
+        if (invalidCount > 0)
+        {
+            Stats::Instance()->SpanBufferInvalid((unsigned int) invalidCount);
+        }
+
+        if (traceCount > 0)
+        {
+            if (m_sink->Write(payload, payloadSize, traceCount))
+            {
+                Stats::Instance()->SpanBufferFlushed(traceCount, payloadSize);
+            }
+            else
+            {
+                Stats::Instance()->SpanBufferSinkError();
+            }
+        }
+    }
+
+    // The records are released even when the sink failed, there is no retry
+    m_buffer.Release(count);
+    return count;
+}
+
+void SpanFlusher::FlushAll()
+{
+    // Flush callers are woken up after every batch, producers may keep the buffer busy for a while
+    while (FlushBatch() > 0)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_flushed_condition.notify_all();
+    }
+}
+
+void SpanFlusher::FlushThreadLoop(SpanFlusher* flusher)
+{
+    while (flusher->m_running)
+    {
+        {
+            std::unique_lock<std::mutex> lock(flusher->m_mutex);
+            flusher->m_wake_condition.wait_for(lock, flusher->m_options.flush_interval,
+                                               [flusher] { return flusher->m_wake || !flusher->m_running; });
+            flusher->m_wake = false;
+        }
+
+        flusher->FlushAll();
+    }
+
+    // Everything enqueued before Stop
+    flusher->FlushAll();
+}
+
+} // namespace trace
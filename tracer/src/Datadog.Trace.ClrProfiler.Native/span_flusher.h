@@ -0,0 +1,147 @@
+#ifndef DD_CLR_PROFILER_SPAN_FLUSHER_H_
+#define DD_CLR_PROFILER_SPAN_FLUSHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "record_ring_buffer.h"
+#include "span_serializer.h"
+
+namespace trace
+{
+
+/// <summary>
+/// Destination of the MessagePack payloads written by the span flusher. Write is only called from the
+/// flush thread.
+/// </summary>
+class SpanSink
+{
+public:
+    virtual ~SpanSink() = default;
+
+    // Returns false when the payload could not be delivered, the flusher counts it and moves on.
+    virtual bool Write(const uint8_t* payload, size_t size, uint32_t traceCount) = 0;
+};
+
+// Appends every payload to a local file, payloads are self-delimiting MessagePack arrays.
+// The number of traces written is logged when the file is closed.
+class FileSpanSink : public SpanSink
+{
+private:
+    std::string m_path;
+    FILE* m_file = nullptr;
+    uint64_t m_traces = 0;
+    uint64_t m_payloads = 0;
+
+public:
+    explicit FileSpanSink(const std::string& path);
+    ~FileSpanSink() override;
+
+    bool Write(const uint8_t* payload, size_t size, uint32_t traceCount) override;
+
+    // Traces written so far, only read it once the flusher is stopped
+    uint64_t GetTraceCount() const;
+};
+
+// Sends every payload to the agent's trace endpoint over its Unix domain socket (not supported on Windows).
+class UnixSocketSpanSink : public SpanSink
+{
+private:
+    std::string m_path;
+    // Only the first failure of a series is logged
+    bool m_failing = false;
+
+public:
+    explicit UnixSocketSpanSink(const std::string& path);
+
+    bool Write(const uint8_t* payload, size_t size, uint32_t traceCount) override;
+};
+
+// Keeps the payloads in memory, for tests.
+class InProcessSpanSink : public SpanSink
+{
+private:
+    mutable std::mutex m_mutex;
+    std::vector<std::vector<uint8_t>> m_payloads;
+    uint64_t m_traces = 0;
+    bool m_failing = false;
+
+public:
+    bool Write(const uint8_t* payload, size_t size, uint32_t traceCount) override;
+
+    std::vector<std::vector<uint8_t>> GetPayloads() const;
+    uint64_t GetTraceCount() const;
+    // Makes the following writes fail
+    void SetFailing(bool failing);
+};
+
+// Creates the sink described by "file:<path>" or "unix:<path>", nullptr for anything else.
+std::unique_ptr<SpanSink> CreateSpanSink(const std::string& output);
+
+struct SpanFlusherOptions
+{
+    // Number of records the ring buffer holds, rounded up to a power of two
+    size_t capacity = 4096;
+    // Records serialized per payload, the flush thread is woken up as soon as this many are waiting
+    size_t batch_size = 256;
+    // Every slot is allocated this many bytes upfront so Enqueue never allocates, larger records are dropped
+    size_t max_record_size = 8 * 1024;
+    std::chrono::milliseconds flush_interval = std::chrono::milliseconds(1000);
+};
+
+/// <summary>
+/// Owns the span ring buffer and the native thread that drains it. Managed threads hand over span
+/// buffers with Enqueue, which never blocks; the flush thread serializes them in batches, either when
+/// batch_size records are waiting or every flush_interval, and writes the payloads to the sink.
+/// </summary>
+class SpanFlusher
+{
+private:
+    RecordRingBuffer m_buffer;
+    std::unique_ptr<SpanSink> m_sink;
+    SpanFlusherOptions m_options;
+    SpanSerializer m_serializer;
+    std::vector<RingBufferRecord> m_batch;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake_condition;
+    std::condition_variable m_flushed_condition;
+    std::atomic_bool m_running = {false};
+    std::atomic_bool m_stopped = {false};
+    std::atomic_bool m_wake = {false};
+    std::unique_ptr<std::thread> m_thread;
+
+    static void FlushThreadLoop(SpanFlusher* flusher);
+    size_t FlushBatch();
+    void FlushAll();
+    void Wake();
+
+public:
+    SpanFlusher(std::unique_ptr<SpanSink> sink, const SpanFlusherOptions& options);
+    ~SpanFlusher();
+
+    // Records enqueued before Start are kept and written once the flush thread runs.
+    bool Start();
+    // Stops the flush thread after writing everything left in the buffer. A stopped flusher can't be restarted.
+    void Stop();
+    bool IsRunning() const;
+
+    // S_OK when accepted, S_FALSE when accepted while the buffer is more than 3/4 full (the caller should
+    // slow down), E_OUTOFMEMORY when the buffer is full, E_INVALIDARG when the record is larger than
+    // max_record_size and E_ABORT once Stop was called. Rejected records are dropped.
+    HRESULT Enqueue(const uint8_t* data, size_t size);
+
+    // Waits until everything enqueued before the call has been written to the sink.
+    bool Flush(std::chrono::milliseconds timeout);
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_SPAN_FLUSHER_H_
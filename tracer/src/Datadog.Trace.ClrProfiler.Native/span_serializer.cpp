@@ -0,0 +1,605 @@
+#include "span_serializer.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "stats.h"
+
+namespace trace
+{
+
+// Shorter strings are cheaper to transcode again than to look up
+const int32_t cached_string_min_length = 8;
+
+namespace
+{
+    // Number of leading ASCII code units, checking four of them per 64-bit word.
+    size_t CountAscii(const WCHAR* value, size_t length)
+    {
+        size_t i = 0;
+        for (; i + 4 <= length; i += 4)
+        {
+            uint64_t block;
+            std::memcpy(&block, value + i, sizeof(block));
+            if ((block & 0xFF80FF80FF80FF80ull) != 0)
+            {
+                break;
+            }
+        }
+
+        while (i < length && (uint16_t) value[i] < 0x80)
+        {
+            i++;
+        }
+
+        return i;
+    }
+
+    void NarrowAscii(const WCHAR* value, size_t length, uint8_t* out)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            out[i] = (uint8_t) value[i];
+        }
+    }
+
+    bool IsHighSurrogate(uint16_t c)
+    {
+        return c >= 0xD800 && c <= 0xDBFF;
+    }
+
+    bool IsLowSurrogate(uint16_t c)
+    {
+        return c >= 0xDC00 && c <= 0xDFFF;
+    }
+
+    size_t Utf8Length(const WCHAR* value, size_t length)
+    {
+        size_t size = 0;
+        for (size_t i = 0; i < length; i++)
+        {
+            const auto c = (uint16_t) value[i];
+            if (c < 0x80)
+            {
+                size += 1;
+            }
+            else if (c < 0x800)
+            {
+                size += 2;
+            }
+            else if (IsHighSurrogate(c) && i + 1 < length && IsLowSurrogate((uint16_t) value[i + 1]))
+            {
+                size += 4;
+                i++;
+            }
+            else
+            {
+                // BMP character or unpaired surrogate (U+FFFD)
+                size += 3;
+            }
+        }
+        return size;
+    }
+
+    void EncodeUtf8(const WCHAR* value, size_t length, uint8_t* out)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            uint32_t c = (uint16_t) value[i];
+            if (c < 0x80)
+            {
+                *out++ = (uint8_t) c;
+                continue;
+            }
+
+            if (c < 0x800)
+            {
+                *out++ = (uint8_t) (0xC0 | (c >> 6));
+                *out++ = (uint8_t) (0x80 | (c & 0x3F));
+                continue;
+            }
+
+            if (IsHighSurrogate((uint16_t) c) && i + 1 < length && IsLowSurrogate((uint16_t) value[i + 1]))
+            {
+                c = 0x10000 + ((c - 0xD800) << 10) + ((uint16_t) value[i + 1] - 0xDC00);
+                i++;
+                *out++ = (uint8_t) (0xF0 | (c >> 18));
+                *out++ = (uint8_t) (0x80 | ((c >> 12) & 0x3F));
+                *out++ = (uint8_t) (0x80 | ((c >> 6) & 0x3F));
+                *out++ = (uint8_t) (0x80 | (c & 0x3F));
+                continue;
+            }
+
+            if (IsHighSurrogate((uint16_t) c) || IsLowSurrogate((uint16_t) c))
+            {
+                c = 0xFFFD;
+            }
+
+            *out++ = (uint8_t) (0xE0 | (c >> 12));
+            *out++ = (uint8_t) (0x80 | ((c >> 6) & 0x3F));
+            *out++ = (uint8_t) (0x80 | (c & 0x3F));
+        }
+    }
+
+    void WriteBigEndian(uint8_t* out, uint64_t value, int size)
+    {
+        for (int i = size - 1; i >= 0; i--)
+        {
+            out[i] = (uint8_t) value;
+            value >>= 8;
+        }
+    }
+
+    // Span map keys, all of them fit in a fixstr
+    template <size_t N>
+    void WriteKey(MessagePackWriter& writer, const char (&key)[N])
+    {
+        static_assert(N - 1 < 32, "span keys are encoded as fixstr");
+        uint8_t encoded[N];
+        encoded[0] = (uint8_t) (0xA0 | (N - 1));
+        std::memcpy(encoded + 1, key, N - 1);
+        writer.WriteRaw(encoded, N);
+    }
+} // namespace
+
+//
+// MessagePackWriter
+//
+
+uint8_t* MessagePackWriter::Reserve(size_t size)
+{
+    if (m_size + size > m_capacity)
+    {
+        const size_t capacity = (std::max)(m_size + size, (std::max)(m_capacity * 2, (size_t) 4096));
+        std::unique_ptr<uint8_t[]> buffer(new uint8_t[capacity]);
+        if (m_size > 0)
+        {
+            std::memcpy(buffer.get(), m_buffer.get(), m_size);
+        }
+        m_buffer = std::move(buffer);
+        m_capacity = capacity;
+    }
+
+    uint8_t* out = m_buffer.get() + m_size;
+    m_size += size;
+    return out;
+}
+
+void MessagePackWriter::WriteArrayHeader(uint32_t count)
+{
+    if (count < 16)
+    {
+        *Reserve(1) = (uint8_t) (0x90 | count);
+    }
+    else if (count <= 0xFFFF)
+    {
+        auto out = Reserve(3);
+        out[0] = 0xDC;
+        WriteBigEndian(out + 1, count, 2);
+    }
+    else
+    {
+        auto out = Reserve(5);
+        out[0] = 0xDD;
+        WriteBigEndian(out + 1, count, 4);
+    }
+}
+
+size_t MessagePackWriter::ReserveArrayHeader()
+{
+    const auto position = m_size;
+    auto out = Reserve(5);
+    out[0] = 0xDD;
+    WriteBigEndian(out + 1, 0, 4);
+    return position;
+}
+
+void MessagePackWriter::PatchArrayHeader(size_t position, uint32_t count)
+{
+    WriteBigEndian(m_buffer.get() + position + 1, count, 4);
+}
+
+void MessagePackWriter::WriteMapHeader(uint32_t count)
+{
+    if (count < 16)
+    {
+        *Reserve(1) = (uint8_t) (0x80 | count);
+    }
+    else if (count <= 0xFFFF)
+    {
+        auto out = Reserve(3);
+        out[0] = 0xDE;
+        WriteBigEndian(out + 1, count, 2);
+    }
+    else
+    {
+        auto out = Reserve(5);
+        out[0] = 0xDF;
+        WriteBigEndian(out + 1, count, 4);
+    }
+}
+
+void MessagePackWriter::WriteNil()
+{
+    *Reserve(1) = 0xC0;
+}
+
+void MessagePackWriter::WriteUInt64(uint64_t value)
+{
+    if (value < 0x80)
+    {
+        *Reserve(1) = (uint8_t) value;
+    }
+    else if (value <= 0xFF)
+    {
+        auto out = Reserve(2);
+        out[0] = 0xCC;
+        out[1] = (uint8_t) value;
+    }
+    else if (value <= 0xFFFF)
+    {
+        auto out = Reserve(3);
+        out[0] = 0xCD;
+        WriteBigEndian(out + 1, value, 2);
+    }
+    else if (value <= 0xFFFFFFFF)
+    {
+        auto out = Reserve(5);
+        out[0] = 0xCE;
+        WriteBigEndian(out + 1, value, 4);
+    }
+    else
+    {
+        auto out = Reserve(9);
+        out[0] = 0xCF;
+        WriteBigEndian(out + 1, value, 8);
+    }
+}
+
+void MessagePackWriter::WriteInt64(int64_t value)
+{
+    if (value >= 0)
+    {
+        WriteUInt64((uint64_t) value);
+    }
+    else if (value >= -32)
+    {
+        *Reserve(1) = (uint8_t) value;
+    }
+    else if (value >= INT8_MIN)
+    {
+        auto out = Reserve(2);
+        out[0] = 0xD0;
+        out[1] = (uint8_t) value;
+    }
+    else if (value >= INT16_MIN)
+    {
+        auto out = Reserve(3);
+        out[0] = 0xD1;
+        WriteBigEndian(out + 1, (uint64_t) value, 2);
+    }
+    else if (value >= INT32_MIN)
+    {
+        auto out = Reserve(5);
+        out[0] = 0xD2;
+        WriteBigEndian(out + 1, (uint64_t) value, 4);
+    }
+    else
+    {
+        auto out = Reserve(9);
+        out[0] = 0xD3;
+        WriteBigEndian(out + 1, (uint64_t) value, 8);
+    }
+}
+
+void MessagePackWriter::WriteDouble(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    auto out = Reserve(9);
+    out[0] = 0xCB;
+    WriteBigEndian(out + 1, bits, 8);
+}
+
+void MessagePackWriter::WriteRaw(const uint8_t* data, size_t size)
+{
+    std::memcpy(Reserve(size), data, size);
+}
+
+void MessagePackWriter::CopyWithin(size_t position, size_t size)
+{
+    // Reserve first, it can move the arena
+    auto out = Reserve(size);
+    std::memcpy(out, m_buffer.get() + position, size);
+}
+
+void MessagePackWriter::WriteStringHeader(uint32_t length)
+{
+    if (length < 32)
+    {
+        *Reserve(1) = (uint8_t) (0xA0 | length);
+    }
+    else if (length <= 0xFF)
+    {
+        auto out = Reserve(2);
+        out[0] = 0xD9;
+        out[1] = (uint8_t) length;
+    }
+    else if (length <= 0xFFFF)
+    {
+        auto out = Reserve(3);
+        out[0] = 0xDA;
+        WriteBigEndian(out + 1, length, 2);
+    }
+    else
+    {
+        auto out = Reserve(5);
+        out[0] = 0xDB;
+        WriteBigEndian(out + 1, length, 4);
+    }
+}
+
+void MessagePackWriter::WriteString(const WCHAR* value, size_t length)
+{
+    const size_t ascii = CountAscii(value, length);
+    const size_t utf8Length = ascii == length ? length : ascii + Utf8Length(value + ascii, length - ascii);
+
+    WriteStringHeader((uint32_t) utf8Length);
+    auto out = Reserve(utf8Length);
+    NarrowAscii(value, ascii, out);
+    if (ascii < length)
+    {
+        EncodeUtf8(value + ascii, length - ascii, out + ascii);
+    }
+}
+
+//
+// SpanSerializer
+//
+
+bool SpanSerializer::IsValidString(const SpanBufferString& value) const
+{
+    return value.length < 0 || (uint64_t) value.offset + (uint64_t) value.length <= m_header->string_length;
+}
+
+bool SpanSerializer::Validate(const uint8_t* buffer, size_t size)
+{
+    if (buffer == nullptr || size < sizeof(SpanBufferHeader))
+    {
+        return false;
+    }
+
+    m_header = reinterpret_cast<const SpanBufferHeader*>(buffer);
+    if (m_header->version != span_buffer_version)
+    {
+        return false;
+    }
+
+    const uint64_t traces = sizeof(SpanBufferHeader);
+    const uint64_t spans = traces + (uint64_t) m_header->trace_count * sizeof(SpanBufferTrace);
+    const uint64_t tags = spans + (uint64_t) m_header->span_count * sizeof(SpanBufferSpan);
+    const uint64_t metrics = tags + (uint64_t) m_header->tag_count * sizeof(SpanBufferTag);
+    const uint64_t chars = metrics + (uint64_t) m_header->metric_count * sizeof(SpanBufferMetric);
+    const uint64_t end = chars + (uint64_t) m_header->string_length * sizeof(WCHAR);
+    if (end > size)
+    {
+        return false;
+    }
+
+    m_traces = reinterpret_cast<const SpanBufferTrace*>(buffer + traces);
+    m_spans = reinterpret_cast<const SpanBufferSpan*>(buffer + spans);
+    m_tags = reinterpret_cast<const SpanBufferTag*>(buffer + tags);
+    m_metrics = reinterpret_cast<const SpanBufferMetric*>(buffer + metrics);
+    m_chars = reinterpret_cast<const WCHAR*>(buffer + chars);
+
+    // Check every reference before writing anything, so a bad buffer never produces half a payload
+    for (uint32_t i = 0; i < m_header->trace_count; i++)
+    {
+        if ((uint64_t) m_traces[i].first_span + m_traces[i].span_count > m_header->span_count)
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < m_header->span_count; i++)
+    {
+        const auto& span = m_spans[i];
+        if ((uint64_t) span.first_tag + span.tag_count > m_header->tag_count ||
+            (uint64_t) span.first_metric + span.metric_count > m_header->metric_count ||
+            !IsValidString(span.name) || !IsValidString(span.resource) || !IsValidString(span.service) ||
+            !IsValidString(span.type))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < m_header->tag_count; i++)
+    {
+        if (!IsValidString(m_tags[i].key) || !IsValidString(m_tags[i].value))
+        {
+            return false;
+        }
+    }
+
+    for (uint32_t i = 0; i < m_header->metric_count; i++)
+    {
+        if (!IsValidString(m_metrics[i].key))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SpanSerializer::WriteString(const SpanBufferString& value)
+{
+    if (value.length < 0)
+    {
+        m_writer.WriteNil();
+        return;
+    }
+
+    if (value.length < cached_string_min_length)
+    {
+        m_writer.WriteString(m_chars + value.offset, (size_t) value.length);
+        return;
+    }
+
+    const uint64_t key = ((uint64_t) value.offset << 32) | (uint32_t) value.length;
+    const auto find_res = m_strings.find(key);
+    if (find_res != m_strings.end())
+    {
+        m_writer.CopyWithin(find_res->second.first, find_res->second.second);
+        return;
+    }
+
+    const auto position = m_writer.Size();
+    m_writer.WriteString(m_chars + value.offset, (size_t) value.length);
+    m_strings.emplace(key, std::make_pair(position, m_writer.Size() - position));
+}
+
+void SpanSerializer::WriteSpan(const SpanBufferSpan& span)
+{
+    // trace_id, span_id, name, resource, service, type, start, duration, meta and metrics
+    uint32_t fields = 10;
+    if (span.parent_id != 0)
+    {
+        fields++;
+    }
+    if (span.error != 0)
+    {
+        fields++;
+    }
+
+    m_writer.WriteMapHeader(fields);
+
+    WriteKey(m_writer, "trace_id");
+    m_writer.WriteUInt64(span.trace_id);
+    WriteKey(m_writer, "span_id");
+    m_writer.WriteUInt64(span.span_id);
+    WriteKey(m_writer, "name");
+    WriteString(span.name);
+    WriteKey(m_writer, "resource");
+    WriteString(span.resource);
+    WriteKey(m_writer, "service");
+    WriteString(span.service);
+    WriteKey(m_writer, "type");
+    WriteString(span.type);
+    WriteKey(m_writer, "start");
+    m_writer.WriteInt64(span.start);
+    WriteKey(m_writer, "duration");
+    m_writer.WriteInt64(span.duration);
+
+    if (span.parent_id != 0)
+    {
+        WriteKey(m_writer, "parent_id");
+        m_writer.WriteUInt64(span.parent_id);
+    }
+
+    if (span.error != 0)
+    {
+        WriteKey(m_writer, "error");
+        m_writer.WriteUInt64(1);
+    }
+
+    WriteKey(m_writer, "meta");
+    m_writer.WriteMapHeader(span.tag_count);
+    for (uint32_t i = span.first_tag; i < span.first_tag + span.tag_count; i++)
+    {
+        WriteString(m_tags[i].key);
+        WriteString(m_tags[i].value);
+    }
+
+    WriteKey(m_writer, "metrics");
+    m_writer.WriteMapHeader(span.metric_count);
+    for (uint32_t i = span.first_metric; i < span.first_metric + span.metric_count; i++)
+    {
+        WriteString(m_metrics[i].key);
+        m_writer.WriteDouble(m_metrics[i].value);
+    }
+}
+
+void SpanSerializer::WriteTraces()
+{
+    for (uint32_t i = 0; i < m_header->trace_count; i++)
+    {
+        const auto& spans = m_traces[i];
+        m_writer.WriteArrayHeader(spans.span_count);
+        for (uint32_t j = spans.first_span; j < spans.first_span + spans.span_count; j++)
+        {
+            WriteSpan(m_spans[j]);
+        }
+    }
+}
+
+HRESULT SpanSerializer::Serialize(const uint8_t* buffer, size_t size, const uint8_t** payload, size_t* payloadSize)
+{
+    if (payload == nullptr || payloadSize == nullptr)
+    {
+        return E_INVALIDARG;
+    }
+
+    m_writer.Reset();
+    m_strings.clear();
+
+    if (!Validate(buffer, size))
+    {
+        return E_INVALIDARG;
+    }
+
+    m_writer.WriteArrayHeader(m_header->trace_count);
+    WriteTraces();
+
+    *payload = m_writer.Data();
+    *payloadSize = m_writer.Size();
+    trace::Stats::Instance()->SpansSerialized(m_header->span_count, m_writer.Size());
+    return S_OK;
+}
+
+HRESULT SpanSerializer::SerializeBatch(const RingBufferRecord* records, size_t count, const uint8_t** payload,
+                                       size_t* payloadSize, uint32_t* traceCount, size_t* invalidCount)
+{
+    if ((records == nullptr && count > 0) || payload == nullptr || payloadSize == nullptr || traceCount == nullptr ||
+        invalidCount == nullptr)
+    {
+        return E_INVALIDARG;
+    }
+
+    m_writer.Reset();
+    *traceCount = 0;
+    *invalidCount = 0;
+    uint32_t spans = 0;
+
+    // The trace count is only known once every buffer has been validated
+    const auto header = m_writer.ReserveArrayHeader();
+    for (size_t i = 0; i < count; i++)
+    {
+        // Cached strings are keyed by their range in the buffer they come from
+        m_strings.clear();
+
+        if (!Validate(records[i].data, records[i].size))
+        {
+            (*invalidCount)++;
+            continue;
+        }
+
+        WriteTraces();
+        *traceCount += m_header->trace_count;
+        spans += m_header->span_count;
+    }
+    m_writer.PatchArrayHeader(header, *traceCount);
+
+    *payload = m_writer.Data();
+    *payloadSize = m_writer.Size();
+    trace::Stats::Instance()->SpansSerialized(spans, m_writer.Size());
+    return S_OK;
+}
+
+SpanSerializer& SpanSerializer::ForCurrentThread()
+{
+    thread_local SpanSerializer serializer;
+    return serializer;
+}
+
+} // namespace trace
@@ -0,0 +1,184 @@
+#ifndef DD_CLR_PROFILER_SPAN_SERIALIZER_H_
+#define DD_CLR_PROFILER_SPAN_SERIALIZER_H_
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "record_ring_buffer.h"
+#include "string.h" // NOLINT
+
+namespace trace
+{
+
+//
+// Flat span buffer written by the managed tracer. Every section follows the previous one without padding:
+//
+//   SpanBufferHeader
+//   SpanBufferTrace[trace_count]
+//   SpanBufferSpan[span_count]
+//   SpanBufferTag[tag_count]
+//   SpanBufferMetric[metric_count]
+//   WCHAR[string_length]            UTF-16 string table referenced by every SpanBufferString
+//
+// Must keep these layouts in sync with the structs in NativeSpanBuffer.cs!
+//
+
+const uint32_t span_buffer_version = 1;
+
+struct SpanBufferHeader
+{
+    uint32_t version;
+    uint32_t trace_count;
+    uint32_t span_count;
+    uint32_t tag_count;
+    uint32_t metric_count;
+    uint32_t string_length;
+};
+
+// A range of the string table, a negative length is a null string.
+struct SpanBufferString
+{
+    uint32_t offset;
+    int32_t length;
+};
+
+struct SpanBufferTrace
+{
+    uint32_t first_span;
+    uint32_t span_count;
+};
+
+struct SpanBufferSpan
+{
+    uint64_t trace_id;
+    uint64_t span_id;
+    // 0 for root spans
+    uint64_t parent_id;
+    // Unix time in nanoseconds
+    int64_t start;
+    int64_t duration;
+    SpanBufferString name;
+    SpanBufferString resource;
+    SpanBufferString service;
+    SpanBufferString type;
+    uint32_t first_tag;
+    uint32_t tag_count;
+    uint32_t first_metric;
+    uint32_t metric_count;
+    int32_t error;
+    uint32_t reserved;
+};
+
+struct SpanBufferTag
+{
+    SpanBufferString key;
+    SpanBufferString value;
+};
+
+struct SpanBufferMetric
+{
+    SpanBufferString key;
+    double value;
+};
+
+static_assert(sizeof(SpanBufferHeader) == 24, "SpanBufferHeader layout is shared with the managed side");
+static_assert(sizeof(SpanBufferString) == 8, "SpanBufferString layout is shared with the managed side");
+static_assert(sizeof(SpanBufferTrace) == 8, "SpanBufferTrace layout is shared with the managed side");
+static_assert(sizeof(SpanBufferSpan) == 96, "SpanBufferSpan layout is shared with the managed side");
+static_assert(sizeof(SpanBufferTag) == 16, "SpanBufferTag layout is shared with the managed side");
+static_assert(sizeof(SpanBufferMetric) == 16, "SpanBufferMetric layout is shared with the managed side");
+
+/// <summary>
+/// Append-only MessagePack encoder over a growable arena. Reset keeps the memory, so a writer reused for
+/// every payload stops allocating once it has seen the largest one.
+/// </summary>
+class MessagePackWriter
+{
+private:
+    std::unique_ptr<uint8_t[]> m_buffer;
+    size_t m_capacity = 0;
+    size_t m_size = 0;
+
+    uint8_t* Reserve(size_t size);
+    void WriteStringHeader(uint32_t length);
+
+public:
+    void Reset()
+    {
+        m_size = 0;
+    }
+    const uint8_t* Data() const
+    {
+        return m_buffer.get();
+    }
+    size_t Size() const
+    {
+        return m_size;
+    }
+    size_t Capacity() const
+    {
+        return m_capacity;
+    }
+
+    void WriteArrayHeader(uint32_t count);
+    // Writes an array32 header with a count set later by PatchArrayHeader, returns its position.
+    size_t ReserveArrayHeader();
+    void PatchArrayHeader(size_t position, uint32_t count);
+    void WriteMapHeader(uint32_t count);
+    void WriteNil();
+    void WriteUInt64(uint64_t value);
+    void WriteInt64(int64_t value);
+    void WriteDouble(double value);
+    void WriteRaw(const uint8_t* data, size_t size);
+    // Appends a copy of bytes already written at the given position.
+    void CopyWithin(size_t position, size_t size);
+
+    // Writes a UTF-16 string as a MessagePack str with its UTF-8 encoding. Runs of ASCII characters are
+    // checked and narrowed four code units at a time, unpaired surrogates become U+FFFD.
+    void WriteString(const WCHAR* value, size_t length);
+};
+
+/// <summary>
+/// Turns a flat span buffer into an agent v0.4 MessagePack payload: an array of traces, each one an array
+/// of span maps. A string referenced several times from the same buffer (same offset and length, which is
+/// what the managed side produces for interned service names and tag keys) is transcoded once and copied
+/// afterwards.
+/// </summary>
+class SpanSerializer
+{
+private:
+    MessagePackWriter m_writer;
+    // (offset, length) of the string -> (position, size) of its encoding in the payload
+    std::unordered_map<uint64_t, std::pair<size_t, size_t>> m_strings;
+
+    const SpanBufferHeader* m_header = nullptr;
+    const SpanBufferTrace* m_traces = nullptr;
+    const SpanBufferSpan* m_spans = nullptr;
+    const SpanBufferTag* m_tags = nullptr;
+    const SpanBufferMetric* m_metrics = nullptr;
+    const WCHAR* m_chars = nullptr;
+
+    bool Validate(const uint8_t* buffer, size_t size);
+    bool IsValidString(const SpanBufferString& value) const;
+    void WriteString(const SpanBufferString& value);
+    void WriteSpan(const SpanBufferSpan& span);
+    void WriteTraces();
+
+public:
+    // Returns E_INVALIDARG if the buffer is truncated or references something outside of it. The payload
+    // stays valid until the next call.
+    HRESULT Serialize(const uint8_t* buffer, size_t size, const uint8_t** payload, size_t* payloadSize);
+
+    // Serializes the traces of several buffers into a single payload. Invalid buffers are skipped and
+    // counted in invalidCount instead of failing the whole batch.
+    HRESULT SerializeBatch(const RingBufferRecord* records, size_t count, const uint8_t** payload,
+                           size_t* payloadSize, uint32_t* traceCount, size_t* invalidCount);
+
+    // Serializer of the calling thread, its arena is reused by every call made from that thread.
+    static SpanSerializer& ForCurrentThread();
+};
+
+} // namespace trace
+
+#endif // DD_CLR_PROFILER_SPAN_SERIALIZER_H_
@@ -1,31 +1,109 @@
 #ifndef DD_CLR_PROFILER_STATS_H_
 #define DD_CLR_PROFILER_STATS_H_
 
+#include <atomic>
 #include <chrono>
+#include <sstream>
 
 #include "util.h"
 
 namespace trace
 {
 
+// Log2 histogram of durations in microseconds, the last bucket collects everything above.
+class SWHistogram
+{
+public:
+    static const int BucketCount = 20;
+
+private:
+    std::atomic_uint _buckets[BucketCount];
+
+public:
+    SWHistogram()
+    {
+        for (int i = 0; i < BucketCount; i++)
+        {
+            _buckets[i] = 0;
+        }
+    }
+    void Add(unsigned long long ns)
+    {
+        auto us = ns / 1000;
+        int bucket = 0;
+        while (us > 0 && bucket < BucketCount - 1)
+        {
+            us >>= 1;
+            bucket++;
+        }
+        _buckets[bucket]++;
+    }
+    unsigned int GetBucket(int bucket) const
+    {
+        return _buckets[bucket].load();
+    }
+    std::string ToString() const
+    {
+        std::stringstream ss;
+        for (int i = 0; i < BucketCount; i++)
+        {
+            const auto count = _buckets[i].load();
+            if (count == 0)
+            {
+                continue;
+            }
+            if (i == BucketCount - 1)
+            {
+                ss << "  >=" << (1ULL << (i - 1)) << "us: " << count << "\n";
+            }
+            else
+            {
+                ss << "  <" << (1ULL << i) << "us: " << count << "\n";
+            }
+        }
+        return ss.str();
+    }
+};
+
 class SWStat
 {
     std::atomic_ullong* _value;
+    SWHistogram* _histogram;
     std::chrono::steady_clock::time_point _startTime;
 
 public:
-    SWStat(std::atomic_ullong* value)
+    SWStat(std::atomic_ullong* value, SWHistogram* histogram = nullptr)
     {
         _value = value;
+        _histogram = histogram;
         _startTime = std::chrono::steady_clock::now();
     }
     ~SWStat()
     {
         auto increment = (std::chrono::steady_clock::now() - _startTime).count();
         _value->fetch_add(increment);
+        if (_histogram != nullptr)
+        {
+            _histogram->Add(increment);
+        }
     }
 };
 
+// Native structures whose live instances and bytes are accounted in Stats.
+// Bytes are the size of the structure plus the heap buffers it owns when they are known up front.
+enum class MemoryCategory : int
+{
+    ModuleMetadata = 0,
+    RejitModule,
+    RejitMethod,
+    FunctionInfo,
+    MethodReplacement,
+    AssemblyReference,
+    ModuleId,
+    MethodSignature,
+    Count
+};
+
 class Stats : public Singleton<Stats>
 {
     friend class Singleton<Stats>;
@@ -41,6 +119,8 @@ private:
     std::atomic_ullong moduleLoadFinished = {0};
     std::atomic_ullong assemblyLoadFinished = {0};
     std::atomic_ullong initialize = {0};
+    std::atomic_ullong getAssemblyAndSymbolsBytes = {0};
+    std::atomic_ullong startupHookToManagedProfiler = {0};
 
     //
     std::atomic_uint initializeProfilerCount = {0};
@@ -52,6 +132,60 @@ private:
     std::atomic_uint moduleUnloadStartedCount = {0};
     std::atomic_uint moduleLoadFinishedCount = {0};
     std::atomic_uint assemblyLoadFinishedCount = {0};
+    std::atomic_uint getAssemblyAndSymbolsBytesCount = {0};
+    std::atomic_uint startupHookToManagedProfilerCount = {0};
+
+    // Duration histograms
+    SWHistogram callTargetRequestRejitHistogram;
+    SWHistogram callTargetRewriterHistogram;
+    SWHistogram jitCompilationStartedHistogram;
+    SWHistogram startupHookToManagedProfilerHistogram;
+
+    // Managed loader image handed to the AppDomain startup hooks
+    std::atomic_ullong managedLoaderEmbeddedBytes = {0};
+    std::atomic_ullong managedLoaderDeliveredBytes = {0};
+    std::atomic_ullong managedLoaderDecompress = {0};
+
+    // Metadata calls avoided by the type-centric ReJIT planning
+    std::atomic_uint rejitTypeLookupsSaved = {0};
+    std::atomic_uint rejitMethodEnumerationsSaved = {0};
+    std::atomic_uint rejitSignatureParsesSaved = {0};
+
+    // CallTarget TypeSpec/MemberRef/MethodSpec emission
+    std::atomic_uint callTargetEmitCalls = {0};
+    std::atomic_uint callTargetEmitCacheHits = {0};
+
+    // JITCachedFunctionSearchStarted decisions
+    std::atomic_uint precompiledCodeAccepted = {0};
+    std::atomic_uint precompiledCodeRejected = {0};
+
+    // Native span serializer
+    std::atomic_uint serializedPayloads = {0};
+    std::atomic_ullong serializedSpans = {0};
+    std::atomic_ullong serializedBytes = {0};
+
+    // Native span ring buffer and flush thread
+    std::atomic_ullong spanBufferEnqueued = {0};
+    std::atomic_ullong spanBufferBackpressure = {0};
+    std::atomic_ullong spanBufferDropped = {0};
+    std::atomic_uint spanBufferInvalid = {0};
+    std::atomic_uint spanBufferFlushes = {0};
+    std::atomic_ullong spanBufferFlushedTraces = {0};
+    std::atomic_ullong spanBufferFlushedBytes = {0};
+    std::atomic_uint spanBufferSinkErrors = {0};
+
+    // CallTarget rewrite variants, indexed by CallTargetKind
+    static const int CallTargetKindCount = 3;
+    std::atomic_uint callTargetKindRewrites[CallTargetKindCount] = {};
+    std::atomic_ullong callTargetKindOriginalILBytes[CallTargetKindCount] = {};
+    std::atomic_ullong callTargetKindRewrittenILBytes[CallTargetKindCount] = {};
+    std::atomic_uint callTargetKindJitCount[CallTargetKindCount] = {};
+    std::atomic_ullong callTargetKindJit[CallTargetKindCount] = {};
+
+    // Live native structures, indexed by MemoryCategory
+    static const int MemoryCategoryCount = (int) MemoryCategory::Count;
+    std::atomic_llong memoryObjects[MemoryCategoryCount] = {};
+    std::atomic_llong memoryBytes[MemoryCategoryCount] = {};
 
 public:
     Stats()
@@ -65,6 +199,8 @@ public:
         moduleLoadFinished = 0;
         assemblyLoadFinished = 0;
         initialize = 0;
+        getAssemblyAndSymbolsBytes = 0;
+        startupHookToManagedProfiler = 0;
 
         initializeProfilerCount = 0;
         jitCachedFunctionSearchStartedCount = 0;
@@ -74,6 +210,50 @@ public:
         moduleUnloadStartedCount = 0;
         moduleLoadFinishedCount = 0;
         assemblyLoadFinishedCount = 0;
+        getAssemblyAndSymbolsBytesCount = 0;
+        startupHookToManagedProfilerCount = 0;
+
+        managedLoaderEmbeddedBytes = 0;
+        managedLoaderDeliveredBytes = 0;
+        managedLoaderDecompress = 0;
+
+        rejitTypeLookupsSaved = 0;
+        rejitMethodEnumerationsSaved = 0;
+        rejitSignatureParsesSaved = 0;
+
+        callTargetEmitCalls = 0;
+        callTargetEmitCacheHits = 0;
+
+        precompiledCodeAccepted = 0;
+        precompiledCodeRejected = 0;
+
+        serializedPayloads = 0;
+        serializedSpans = 0;
+        serializedBytes = 0;
+
+        spanBufferEnqueued = 0;
+        spanBufferBackpressure = 0;
+        spanBufferDropped = 0;
+        spanBufferInvalid = 0;
+        spanBufferFlushes = 0;
+        spanBufferFlushedTraces = 0;
+        spanBufferFlushedBytes = 0;
+        spanBufferSinkErrors = 0;
+
+        for (int i = 0; i < CallTargetKindCount; i++)
+        {
+            callTargetKindRewrites[i] = 0;
+            callTargetKindOriginalILBytes[i] = 0;
+            callTargetKindRewrittenILBytes[i] = 0;
+            callTargetKindJitCount[i] = 0;
+            callTargetKindJit[i] = 0;
+        }
+
+        for (int i = 0; i < MemoryCategoryCount; i++)
+        {
+            memoryObjects[i] = 0;
+            memoryBytes[i] = 0;
+        }
     }
     SWStat InitializeProfilerMeasure()
     {
@@ -88,12 +268,12 @@ public:
     SWStat CallTargetRequestRejitMeasure()
     {
         callTargetRequestRejitCount++;
-        return SWStat(&callTargetRequestRejit);
+        return SWStat(&callTargetRequestRejit, &callTargetRequestRejitHistogram);
     }
     SWStat CallTargetRewriterCallbackMeasure()
     {
         callTargetRewriterCount++;
-        return SWStat(&callTargetRewriter);
+        return SWStat(&callTargetRewriter, &callTargetRewriterHistogram);
     }
     SWStat JITInliningMeasure()
     {
@@ -103,7 +283,7 @@ public:
     SWStat JITCompilationStartedMeasure()
     {
         jitCompilationStartedCount++;
-        return SWStat(&jitCompilationStarted);
+        return SWStat(&jitCompilationStarted, &jitCompilationStartedHistogram);
     }
     SWStat ModuleUnloadStartedMeasure()
     {
@@ -124,6 +304,150 @@ public:
     {
         return SWStat(&initialize);
     }
+    SWStat GetAssemblyAndSymbolsBytesMeasure()
+    {
+        getAssemblyAndSymbolsBytesCount++;
+        return SWStat(&getAssemblyAndSymbolsBytes);
+    }
+    void StartupHookCompleted(unsigned long long ns)
+    {
+        startupHookToManagedProfilerCount++;
+        startupHookToManagedProfiler += ns;
+        startupHookToManagedProfilerHistogram.Add(ns);
+    }
+    void ManagedLoaderDelivered(size_t embeddedBytes, size_t deliveredBytes, unsigned long long decompressNs)
+    {
+        managedLoaderEmbeddedBytes = embeddedBytes;
+        managedLoaderDeliveredBytes += deliveredBytes;
+        managedLoaderDecompress = decompressNs;
+    }
+    void RejitTypeLookupsSaved(unsigned int count)
+    {
+        rejitTypeLookupsSaved += count;
+    }
+    void RejitMethodEnumerationsSaved(unsigned int count)
+    {
+        rejitMethodEnumerationsSaved += count;
+    }
+    void RejitSignatureParsesSaved(unsigned int count)
+    {
+        rejitSignatureParsesSaved += count;
+    }
+    void CallTargetEmitCall()
+    {
+        callTargetEmitCalls++;
+    }
+    void CallTargetEmitCacheHit()
+    {
+        callTargetEmitCacheHits++;
+    }
+    void PrecompiledCodeAccepted()
+    {
+        precompiledCodeAccepted++;
+    }
+    void PrecompiledCodeRejected()
+    {
+        precompiledCodeRejected++;
+    }
+    void SpansSerialized(unsigned int spans, size_t bytes)
+    {
+        serializedPayloads++;
+        serializedSpans += spans;
+        serializedBytes += bytes;
+    }
+    void SpanBufferEnqueued()
+    {
+        spanBufferEnqueued++;
+    }
+    void SpanBufferBackpressure()
+    {
+        spanBufferBackpressure++;
+    }
+    void SpanBufferDropped()
+    {
+        spanBufferDropped++;
+    }
+    void SpanBufferInvalid(unsigned int count)
+    {
+        spanBufferInvalid += count;
+    }
+    void SpanBufferFlushed(unsigned int traces, size_t bytes)
+    {
+        spanBufferFlushes++;
+        spanBufferFlushedTraces += traces;
+        spanBufferFlushedBytes += bytes;
+    }
+    void SpanBufferSinkError()
+    {
+        spanBufferSinkErrors++;
+    }
+    unsigned long long SpanBufferDroppedCount()
+    {
+        return spanBufferDropped.load();
+    }
+    unsigned long long SpanBufferBackpressureCount()
+    {
+        return spanBufferBackpressure.load();
+    }
+    void CallTargetKindRewritten(unsigned int kind, unsigned int originalILSize, unsigned int rewrittenILSize)
+    {
+        if (kind < CallTargetKindCount)
+        {
+            callTargetKindRewrites[kind]++;
+            callTargetKindOriginalILBytes[kind] += originalILSize;
+            callTargetKindRewrittenILBytes[kind] += rewrittenILSize;
+        }
+    }
+    void CallTargetKindJitted(unsigned int kind, unsigned long long ns)
+    {
+        if (kind < CallTargetKindCount)
+        {
+            callTargetKindJitCount[kind]++;
+            callTargetKindJit[kind] += ns;
+        }
+    }
+    void MemoryAllocated(MemoryCategory category, size_t bytes, long long objects = 1)
+    {
+        memoryObjects[(int) category] += objects;
+        memoryBytes[(int) category] += (long long) bytes;
+    }
+    void MemoryReleased(MemoryCategory category, size_t bytes, long long objects = 1)
+    {
+        memoryObjects[(int) category] -= objects;
+        memoryBytes[(int) category] -= (long long) bytes;
+    }
+    long long MemoryObjects(MemoryCategory category)
+    {
+        return memoryObjects[(int) category].load();
+    }
+    long long MemoryBytes(MemoryCategory category)
+    {
+        return memoryBytes[(int) category].load();
+    }
+    std::string MemoryToString()
+    {
+        const char* categoryNames[MemoryCategoryCount] = {"ModuleMetadata",    "RejitModule",       "RejitMethod",
+                                                          "FunctionInfo",      "MethodReplacement", "AssemblyReference",
+                                                          "ModuleId",          "MethodSignature"};
+        std::stringstream ss;
+        long long totalBytes = 0;
+        for (int i = 0; i < MemoryCategoryCount; i++)
+        {
+            const auto bytes = memoryBytes[i].load();
+            totalBytes += bytes;
+            ss << (i > 0 ? ", " : "") << categoryNames[i] << "=" << memoryObjects[i].load() << "/" << bytes << "B";
+        }
+        return "Memory " + std::to_string(totalBytes) + "B [" + ss.str() + "]";
+    }
+    std::string HistogramsToString()
+    {
+        std::stringstream ss;
+        ss << "CallTargetRequestRejit:\n" << callTargetRequestRejitHistogram.ToString();
+        ss << "CallTargetRewriter:\n" << callTargetRewriterHistogram.ToString();
+        ss << "JitCompilationStarted:\n" << jitCompilationStartedHistogram.ToString();
+        ss << "StartupHookToManagedProfiler:\n" << startupHookToManagedProfilerHistogram.ToString();
+        return ss.str();
+    }
     std::string ToString()
     {
         const auto ns_initialize = initialize.load();
@@ -185,6 +509,58 @@ public:
         ss << ns_initializeProfiler / 1000000 << "ms"
            << "/" << count_initializeProfilerCount;
         ss << "]";
+        ss << " RejitPlanningSaved [TypeLookups=" << rejitTypeLookupsSaved.load();
+        ss << ", MethodEnumerations=" << rejitMethodEnumerationsSaved.load();
+        ss << ", SignatureParses=" << rejitSignatureParsesSaved.load();
+        ss << "]";
+        ss << " CallTargetEmit [Calls=" << callTargetEmitCalls.load();
+        ss << ", CacheHits=" << callTargetEmitCacheHits.load();
+        ss << "]";
+        ss << " PrecompiledCode [Accepted=" << precompiledCodeAccepted.load();
+        ss << ", Rejected=" << precompiledCodeRejected.load();
+        ss << "]";
+        ss << " StartupHook [GetAssemblyAndSymbolsBytes=" << getAssemblyAndSymbolsBytes.load() / 1000 << "us"
+           << "/" << getAssemblyAndSymbolsBytesCount.load();
+        ss << ", ToManagedProfiler=" << startupHookToManagedProfiler.load() / 1000000 << "ms"
+           << "/" << startupHookToManagedProfilerCount.load();
+        ss << ", EmbeddedBytes=" << managedLoaderEmbeddedBytes.load();
+        ss << ", DeliveredBytes=" << managedLoaderDeliveredBytes.load();
+        ss << ", Decompress=" << managedLoaderDecompress.load() / 1000 << "us";
+        ss << "]";
+        ss << " SpanSerializer [Payloads=" << serializedPayloads.load();
+        ss << ", Spans=" << serializedSpans.load();
+        ss << ", Bytes=" << serializedBytes.load();
+        ss << "]";
+        ss << " SpanBuffer [Enqueued=" << spanBufferEnqueued.load();
+        ss << ", Backpressure=" << spanBufferBackpressure.load();
+        ss << ", Dropped=" << spanBufferDropped.load();
+        ss << ", Invalid=" << spanBufferInvalid.load();
+        ss << ", Flushes=" << spanBufferFlushes.load();
+        ss << ", FlushedTraces=" << spanBufferFlushedTraces.load();
+        ss << ", FlushedBytes=" << spanBufferFlushedBytes.load();
+        ss << ", SinkErrors=" << spanBufferSinkErrors.load();
+        ss << "]";
+
+        // Average IL size before/after the rewrite and average ReJIT time of each rewrite variant
+        const char* kindNames[CallTargetKindCount] = {"Default", "BeginOnly", "EndOnly"};
+        ss << " CallTargetKinds [";
+        for (int i = 0; i < CallTargetKindCount; i++)
+        {
+            const auto rewrites = callTargetKindRewrites[i].load();
+            const auto jitCount = callTargetKindJitCount[i].load();
+            ss << (i > 0 ? ", " : "") << kindNames[i] << "=" << rewrites;
+            if (rewrites > 0)
+            {
+                ss << "/IL " << callTargetKindOriginalILBytes[i].load() / rewrites << "->"
+                   << callTargetKindRewrittenILBytes[i].load() / rewrites << "B";
+            }
+            if (jitCount > 0)
+            {
+                ss << "/JIT " << callTargetKindJit[i].load() / jitCount / 1000 << "us";
+            }
+        }
+        ss << "]";
+        ss << " " << MemoryToString();
         return ss.str();
     }
 };
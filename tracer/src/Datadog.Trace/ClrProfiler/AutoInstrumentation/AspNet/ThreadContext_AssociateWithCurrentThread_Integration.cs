@@ -3,9 +3,11 @@
 // This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
 // </copyright>
 
+using System;
 using System.ComponentModel;
 using Datadog.Trace.ClrProfiler.CallTarget;
 using Datadog.Trace.Configuration;
+using Datadog.Trace.Logging;
 
 namespace Datadog.Trace.ClrProfiler.AutoInstrumentation.AspNet
 {
@@ -20,7 +22,8 @@ namespace Datadog.Trace.ClrProfiler.AutoInstrumentation.AspNet
         ParameterTypeNames = new[] { ClrNames.Bool },
         MinimumVersion = "4.0.0",
         MaximumVersion = "4.*.*",
-        IntegrationName = IntegrationName)]
+        IntegrationName = IntegrationName,
+        CallTargetKind = CallTargetKind.BeginOnly)]
     [Browsable(false)]
     [EditorBrowsable(EditorBrowsableState.Never)]
     public class ThreadContext_AssociateWithCurrentThread_Integration
@@ -28,6 +31,8 @@ namespace Datadog.Trace.ClrProfiler.AutoInstrumentation.AspNet
         private const string IntegrationName = nameof(IntegrationIds.AspNet);
         private const string HttpContextScopeKey = "__Datadog.Trace.AspNet.TracingHttpModule-aspnet.request";
 
+        private static readonly IDatadogLogger Log = DatadogLogging.GetLoggerFor(typeof(ThreadContext_AssociateWithCurrentThread_Integration));
+
         /// <summary>
         /// OnMethodBegin callback
         /// </summary>
@@ -35,13 +40,21 @@ namespace Datadog.Trace.ClrProfiler.AutoInstrumentation.AspNet
         /// <param name="instance">Instance value, aka `this` of the instrumented method.</param>
         /// <param name="setImpersonationContext">A flag to set the impersonation context</param>
         /// <returns>Calltarget state value</returns>
+        /// <remarks>The BeginOnly rewrite doesn't catch exceptions, they must not escape this method.</remarks>
         public static CallTargetState OnMethodBegin<TTarget>(TTarget instance, bool setImpersonationContext)
             where TTarget : IThreadContext
         {
-            var httpContext = instance.HttpContext;
-            if (httpContext.Items[HttpContextScopeKey] is Scope scope && ((IDatadogTracer)Tracer.Instance).ScopeManager is IScopeRawAccess rawAccess)
+            try
+            {
+                var httpContext = instance.HttpContext;
+                if (httpContext.Items[HttpContextScopeKey] is Scope scope && ((IDatadogTracer)Tracer.Instance).ScopeManager is IScopeRawAccess rawAccess)
+                {
+                    rawAccess.Active = scope;
+                }
+            }
+            catch (Exception ex)
             {
-                rawAccess.Active = scope;
+                Log.Error(ex, "Error instrumenting method {MethodName}", "System.Web.ThreadContext.AssociateWithCurrentThread()");
             }
 
             return CallTargetState.GetDefault();
@@ -3,9 +3,11 @@
 // This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
 // </copyright>
 
+using System;
 using System.ComponentModel;
 using Datadog.Trace.ClrProfiler.CallTarget;
 using Datadog.Trace.Configuration;
+using Datadog.Trace.Logging;
 
 namespace Datadog.Trace.ClrProfiler.AutoInstrumentation.AspNet
 {
@@ -20,25 +22,36 @@ namespace Datadog.Trace.ClrProfiler.AutoInstrumentation.AspNet
         ParameterTypeNames = new string[0],
         MinimumVersion = "4.0.0",
         MaximumVersion = "4.*.*",
-        IntegrationName = IntegrationName)]
+        IntegrationName = IntegrationName,
+        CallTargetKind = CallTargetKind.BeginOnly)]
     [Browsable(false)]
     [EditorBrowsable(EditorBrowsableState.Never)]
     public class ThreadContext_DisassociateFromCurrentThread_Integration
     {
         private const string IntegrationName = nameof(IntegrationIds.AspNet);
 
+        private static readonly IDatadogLogger Log = DatadogLogging.GetLoggerFor(typeof(ThreadContext_DisassociateFromCurrentThread_Integration));
+
         /// <summary>
         /// OnMethodBegin callback
         /// </summary>
         /// <typeparam name="TTarget">Type of the target</typeparam>
         /// <param name="instance">Instance value, aka `this` of the instrumented method.</param>
         /// <returns>Calltarget state value</returns>
+        /// <remarks>The BeginOnly rewrite doesn't catch exceptions, they must not escape this method.</remarks>
         public static CallTargetState OnMethodBegin<TTarget>(TTarget instance)
             where TTarget : IThreadContext
         {
-            if (((IDatadogTracer)Tracer.Instance).ScopeManager is IScopeRawAccess rawAccess)
+            try
+            {
+                if (((IDatadogTracer)Tracer.Instance).ScopeManager is IScopeRawAccess rawAccess)
+                {
+                    rawAccess.Active = null;
+                }
+            }
+            catch (Exception ex)
             {
-                rawAccess.Active = null;
+                Log.Error(ex, "Error instrumenting method {MethodName}", "System.Web.ThreadContext.DisassociateFromCurrentThread()");
             }
 
             return CallTargetState.GetDefault();
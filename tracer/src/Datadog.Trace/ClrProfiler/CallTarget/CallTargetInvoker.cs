@@ -253,6 +253,350 @@ namespace Datadog.Trace.ClrProfiler.CallTarget
             return CallTargetState.GetDefault();
         }
 
+        /// <summary>
+        /// Begin Method Invoker
+        /// </summary>
+        /// <typeparam name="TIntegration">Integration type</typeparam>
+        /// <typeparam name="TTarget">Target type</typeparam>
+        /// <typeparam name="TArg1">First argument type</typeparam>
+        /// <typeparam name="TArg2">Second argument type</typeparam>
+        /// <typeparam name="TArg3">Third argument type</typeparam>
+        /// <typeparam name="TArg4">Fourth argument type</typeparam>
+        /// <typeparam name="TArg5">Fifth argument type</typeparam>
+        /// <typeparam name="TArg6">Sixth argument type</typeparam>
+        /// <typeparam name="TArg7">Seventh argument type</typeparam>
+        /// <typeparam name="TArg8">Eighth argument type</typeparam>
+        /// <typeparam name="TArg9">Ninth argument type</typeparam>
+        /// <param name="instance">Instance value</param>
+        /// <param name="arg1">First argument value</param>
+        /// <param name="arg2">Second argument value</param>
+        /// <param name="arg3">Third argument value</param>
+        /// <param name="arg4">Fourth argument value</param>
+        /// <param name="arg5">Fifth argument value</param>
+        /// <param name="arg6">Sixth argument value</param>
+        /// <param name="arg7">Seventh argument value</param>
+        /// <param name="arg8">Eighth argument value</param>
+        /// <param name="arg9">Ninth argument value</param>
+        /// <returns>Call target state</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static CallTargetState BeginMethod<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9)
+        {
+            if (IntegrationOptions<TIntegration, TTarget>.IsIntegrationEnabled)
+            {
+                return BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9>.Invoke(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9);
+            }
+
+            return CallTargetState.GetDefault();
+        }
+
+        /// <summary>
+        /// Begin Method Invoker
+        /// </summary>
+        /// <typeparam name="TIntegration">Integration type</typeparam>
+        /// <typeparam name="TTarget">Target type</typeparam>
+        /// <typeparam name="TArg1">First argument type</typeparam>
+        /// <typeparam name="TArg2">Second argument type</typeparam>
+        /// <typeparam name="TArg3">Third argument type</typeparam>
+        /// <typeparam name="TArg4">Fourth argument type</typeparam>
+        /// <typeparam name="TArg5">Fifth argument type</typeparam>
+        /// <typeparam name="TArg6">Sixth argument type</typeparam>
+        /// <typeparam name="TArg7">Seventh argument type</typeparam>
+        /// <typeparam name="TArg8">Eighth argument type</typeparam>
+        /// <typeparam name="TArg9">Ninth argument type</typeparam>
+        /// <typeparam name="TArg10">Tenth argument type</typeparam>
+        /// <param name="instance">Instance value</param>
+        /// <param name="arg1">First argument value</param>
+        /// <param name="arg2">Second argument value</param>
+        /// <param name="arg3">Third argument value</param>
+        /// <param name="arg4">Fourth argument value</param>
+        /// <param name="arg5">Fifth argument value</param>
+        /// <param name="arg6">Sixth argument value</param>
+        /// <param name="arg7">Seventh argument value</param>
+        /// <param name="arg8">Eighth argument value</param>
+        /// <param name="arg9">Ninth argument value</param>
+        /// <param name="arg10">Tenth argument value</param>
+        /// <returns>Call target state</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static CallTargetState BeginMethod<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10)
+        {
+            if (IntegrationOptions<TIntegration, TTarget>.IsIntegrationEnabled)
+            {
+                return BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10>.Invoke(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10);
+            }
+
+            return CallTargetState.GetDefault();
+        }
+
+        /// <summary>
+        /// Begin Method Invoker
+        /// </summary>
+        /// <typeparam name="TIntegration">Integration type</typeparam>
+        /// <typeparam name="TTarget">Target type</typeparam>
+        /// <typeparam name="TArg1">First argument type</typeparam>
+        /// <typeparam name="TArg2">Second argument type</typeparam>
+        /// <typeparam name="TArg3">Third argument type</typeparam>
+        /// <typeparam name="TArg4">Fourth argument type</typeparam>
+        /// <typeparam name="TArg5">Fifth argument type</typeparam>
+        /// <typeparam name="TArg6">Sixth argument type</typeparam>
+        /// <typeparam name="TArg7">Seventh argument type</typeparam>
+        /// <typeparam name="TArg8">Eighth argument type</typeparam>
+        /// <typeparam name="TArg9">Ninth argument type</typeparam>
+        /// <typeparam name="TArg10">Tenth argument type</typeparam>
+        /// <typeparam name="TArg11">Eleventh argument type</typeparam>
+        /// <param name="instance">Instance value</param>
+        /// <param name="arg1">First argument value</param>
+        /// <param name="arg2">Second argument value</param>
+        /// <param name="arg3">Third argument value</param>
+        /// <param name="arg4">Fourth argument value</param>
+        /// <param name="arg5">Fifth argument value</param>
+        /// <param name="arg6">Sixth argument value</param>
+        /// <param name="arg7">Seventh argument value</param>
+        /// <param name="arg8">Eighth argument value</param>
+        /// <param name="arg9">Ninth argument value</param>
+        /// <param name="arg10">Tenth argument value</param>
+        /// <param name="arg11">Eleventh argument value</param>
+        /// <returns>Call target state</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static CallTargetState BeginMethod<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10, TArg11 arg11)
+        {
+            if (IntegrationOptions<TIntegration, TTarget>.IsIntegrationEnabled)
+            {
+                return BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11>.Invoke(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11);
+            }
+
+            return CallTargetState.GetDefault();
+        }
+
+        /// <summary>
+        /// Begin Method Invoker
+        /// </summary>
+        /// <typeparam name="TIntegration">Integration type</typeparam>
+        /// <typeparam name="TTarget">Target type</typeparam>
+        /// <typeparam name="TArg1">First argument type</typeparam>
+        /// <typeparam name="TArg2">Second argument type</typeparam>
+        /// <typeparam name="TArg3">Third argument type</typeparam>
+        /// <typeparam name="TArg4">Fourth argument type</typeparam>
+        /// <typeparam name="TArg5">Fifth argument type</typeparam>
+        /// <typeparam name="TArg6">Sixth argument type</typeparam>
+        /// <typeparam name="TArg7">Seventh argument type</typeparam>
+        /// <typeparam name="TArg8">Eighth argument type</typeparam>
+        /// <typeparam name="TArg9">Ninth argument type</typeparam>
+        /// <typeparam name="TArg10">Tenth argument type</typeparam>
+        /// <typeparam name="TArg11">Eleventh argument type</typeparam>
+        /// <typeparam name="TArg12">Twelfth argument type</typeparam>
+        /// <param name="instance">Instance value</param>
+        /// <param name="arg1">First argument value</param>
+        /// <param name="arg2">Second argument value</param>
+        /// <param name="arg3">Third argument value</param>
+        /// <param name="arg4">Fourth argument value</param>
+        /// <param name="arg5">Fifth argument value</param>
+        /// <param name="arg6">Sixth argument value</param>
+        /// <param name="arg7">Seventh argument value</param>
+        /// <param name="arg8">Eighth argument value</param>
+        /// <param name="arg9">Ninth argument value</param>
+        /// <param name="arg10">Tenth argument value</param>
+        /// <param name="arg11">Eleventh argument value</param>
+        /// <param name="arg12">Twelfth argument value</param>
+        /// <returns>Call target state</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static CallTargetState BeginMethod<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10, TArg11 arg11, TArg12 arg12)
+        {
+            if (IntegrationOptions<TIntegration, TTarget>.IsIntegrationEnabled)
+            {
+                return BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12>.Invoke(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12);
+            }
+
+            return CallTargetState.GetDefault();
+        }
+
+        /// <summary>
+        /// Begin Method Invoker
+        /// </summary>
+        /// <typeparam name="TIntegration">Integration type</typeparam>
+        /// <typeparam name="TTarget">Target type</typeparam>
+        /// <typeparam name="TArg1">First argument type</typeparam>
+        /// <typeparam name="TArg2">Second argument type</typeparam>
+        /// <typeparam name="TArg3">Third argument type</typeparam>
+        /// <typeparam name="TArg4">Fourth argument type</typeparam>
+        /// <typeparam name="TArg5">Fifth argument type</typeparam>
+        /// <typeparam name="TArg6">Sixth argument type</typeparam>
+        /// <typeparam name="TArg7">Seventh argument type</typeparam>
+        /// <typeparam name="TArg8">Eighth argument type</typeparam>
+        /// <typeparam name="TArg9">Ninth argument type</typeparam>
+        /// <typeparam name="TArg10">Tenth argument type</typeparam>
+        /// <typeparam name="TArg11">Eleventh argument type</typeparam>
+        /// <typeparam name="TArg12">Twelfth argument type</typeparam>
+        /// <typeparam name="TArg13">Thirteenth argument type</typeparam>
+        /// <param name="instance">Instance value</param>
+        /// <param name="arg1">First argument value</param>
+        /// <param name="arg2">Second argument value</param>
+        /// <param name="arg3">Third argument value</param>
+        /// <param name="arg4">Fourth argument value</param>
+        /// <param name="arg5">Fifth argument value</param>
+        /// <param name="arg6">Sixth argument value</param>
+        /// <param name="arg7">Seventh argument value</param>
+        /// <param name="arg8">Eighth argument value</param>
+        /// <param name="arg9">Ninth argument value</param>
+        /// <param name="arg10">Tenth argument value</param>
+        /// <param name="arg11">Eleventh argument value</param>
+        /// <param name="arg12">Twelfth argument value</param>
+        /// <param name="arg13">Thirteenth argument value</param>
+        /// <returns>Call target state</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static CallTargetState BeginMethod<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12, TArg13>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10, TArg11 arg11, TArg12 arg12, TArg13 arg13)
+        {
+            if (IntegrationOptions<TIntegration, TTarget>.IsIntegrationEnabled)
+            {
+                return BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12, TArg13>.Invoke(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13);
+            }
+
+            return CallTargetState.GetDefault();
+        }
+
+        /// <summary>
+        /// Begin Method Invoker
+        /// </summary>
+        /// <typeparam name="TIntegration">Integration type</typeparam>
+        /// <typeparam name="TTarget">Target type</typeparam>
+        /// <typeparam name="TArg1">First argument type</typeparam>
+        /// <typeparam name="TArg2">Second argument type</typeparam>
+        /// <typeparam name="TArg3">Third argument type</typeparam>
+        /// <typeparam name="TArg4">Fourth argument type</typeparam>
+        /// <typeparam name="TArg5">Fifth argument type</typeparam>
+        /// <typeparam name="TArg6">Sixth argument type</typeparam>
+        /// <typeparam name="TArg7">Seventh argument type</typeparam>
+        /// <typeparam name="TArg8">Eighth argument type</typeparam>
+        /// <typeparam name="TArg9">Ninth argument type</typeparam>
+        /// <typeparam name="TArg10">Tenth argument type</typeparam>
+        /// <typeparam name="TArg11">Eleventh argument type</typeparam>
+        /// <typeparam name="TArg12">Twelfth argument type</typeparam>
+        /// <typeparam name="TArg13">Thirteenth argument type</typeparam>
+        /// <typeparam name="TArg14">Fourteenth argument type</typeparam>
+        /// <param name="instance">Instance value</param>
+        /// <param name="arg1">First argument value</param>
+        /// <param name="arg2">Second argument value</param>
+        /// <param name="arg3">Third argument value</param>
+        /// <param name="arg4">Fourth argument value</param>
+        /// <param name="arg5">Fifth argument value</param>
+        /// <param name="arg6">Sixth argument value</param>
+        /// <param name="arg7">Seventh argument value</param>
+        /// <param name="arg8">Eighth argument value</param>
+        /// <param name="arg9">Ninth argument value</param>
+        /// <param name="arg10">Tenth argument value</param>
+        /// <param name="arg11">Eleventh argument value</param>
+        /// <param name="arg12">Twelfth argument value</param>
+        /// <param name="arg13">Thirteenth argument value</param>
+        /// <param name="arg14">Fourteenth argument value</param>
+        /// <returns>Call target state</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static CallTargetState BeginMethod<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12, TArg13, TArg14>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10, TArg11 arg11, TArg12 arg12, TArg13 arg13, TArg14 arg14)
+        {
+            if (IntegrationOptions<TIntegration, TTarget>.IsIntegrationEnabled)
+            {
+                return BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12, TArg13, TArg14>.Invoke(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14);
+            }
+
+            return CallTargetState.GetDefault();
+        }
+
+        /// <summary>
+        /// Begin Method Invoker
+        /// </summary>
+        /// <typeparam name="TIntegration">Integration type</typeparam>
+        /// <typeparam name="TTarget">Target type</typeparam>
+        /// <typeparam name="TArg1">First argument type</typeparam>
+        /// <typeparam name="TArg2">Second argument type</typeparam>
+        /// <typeparam name="TArg3">Third argument type</typeparam>
+        /// <typeparam name="TArg4">Fourth argument type</typeparam>
+        /// <typeparam name="TArg5">Fifth argument type</typeparam>
+        /// <typeparam name="TArg6">Sixth argument type</typeparam>
+        /// <typeparam name="TArg7">Seventh argument type</typeparam>
+        /// <typeparam name="TArg8">Eighth argument type</typeparam>
+        /// <typeparam name="TArg9">Ninth argument type</typeparam>
+        /// <typeparam name="TArg10">Tenth argument type</typeparam>
+        /// <typeparam name="TArg11">Eleventh argument type</typeparam>
+        /// <typeparam name="TArg12">Twelfth argument type</typeparam>
+        /// <typeparam name="TArg13">Thirteenth argument type</typeparam>
+        /// <typeparam name="TArg14">Fourteenth argument type</typeparam>
+        /// <typeparam name="TArg15">Fifteenth argument type</typeparam>
+        /// <param name="instance">Instance value</param>
+        /// <param name="arg1">First argument value</param>
+        /// <param name="arg2">Second argument value</param>
+        /// <param name="arg3">Third argument value</param>
+        /// <param name="arg4">Fourth argument value</param>
+        /// <param name="arg5">Fifth argument value</param>
+        /// <param name="arg6">Sixth argument value</param>
+        /// <param name="arg7">Seventh argument value</param>
+        /// <param name="arg8">Eighth argument value</param>
+        /// <param name="arg9">Ninth argument value</param>
+        /// <param name="arg10">Tenth argument value</param>
+        /// <param name="arg11">Eleventh argument value</param>
+        /// <param name="arg12">Twelfth argument value</param>
+        /// <param name="arg13">Thirteenth argument value</param>
+        /// <param name="arg14">Fourteenth argument value</param>
+        /// <param name="arg15">Fifteenth argument value</param>
+        /// <returns>Call target state</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static CallTargetState BeginMethod<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12, TArg13, TArg14, TArg15>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10, TArg11 arg11, TArg12 arg12, TArg13 arg13, TArg14 arg14, TArg15 arg15)
+        {
+            if (IntegrationOptions<TIntegration, TTarget>.IsIntegrationEnabled)
+            {
+                return BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12, TArg13, TArg14, TArg15>.Invoke(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15);
+            }
+
+            return CallTargetState.GetDefault();
+        }
+
+        /// <summary>
+        /// Begin Method Invoker
+        /// </summary>
+        /// <typeparam name="TIntegration">Integration type</typeparam>
+        /// <typeparam name="TTarget">Target type</typeparam>
+        /// <typeparam name="TArg1">First argument type</typeparam>
+        /// <typeparam name="TArg2">Second argument type</typeparam>
+        /// <typeparam name="TArg3">Third argument type</typeparam>
+        /// <typeparam name="TArg4">Fourth argument type</typeparam>
+        /// <typeparam name="TArg5">Fifth argument type</typeparam>
+        /// <typeparam name="TArg6">Sixth argument type</typeparam>
+        /// <typeparam name="TArg7">Seventh argument type</typeparam>
+        /// <typeparam name="TArg8">Eighth argument type</typeparam>
+        /// <typeparam name="TArg9">Ninth argument type</typeparam>
+        /// <typeparam name="TArg10">Tenth argument type</typeparam>
+        /// <typeparam name="TArg11">Eleventh argument type</typeparam>
+        /// <typeparam name="TArg12">Twelfth argument type</typeparam>
+        /// <typeparam name="TArg13">Thirteenth argument type</typeparam>
+        /// <typeparam name="TArg14">Fourteenth argument type</typeparam>
+        /// <typeparam name="TArg15">Fifteenth argument type</typeparam>
+        /// <typeparam name="TArg16">Sixteenth argument type</typeparam>
+        /// <param name="instance">Instance value</param>
+        /// <param name="arg1">First argument value</param>
+        /// <param name="arg2">Second argument value</param>
+        /// <param name="arg3">Third argument value</param>
+        /// <param name="arg4">Fourth argument value</param>
+        /// <param name="arg5">Fifth argument value</param>
+        /// <param name="arg6">Sixth argument value</param>
+        /// <param name="arg7">Seventh argument value</param>
+        /// <param name="arg8">Eighth argument value</param>
+        /// <param name="arg9">Ninth argument value</param>
+        /// <param name="arg10">Tenth argument value</param>
+        /// <param name="arg11">Eleventh argument value</param>
+        /// <param name="arg12">Twelfth argument value</param>
+        /// <param name="arg13">Thirteenth argument value</param>
+        /// <param name="arg14">Fourteenth argument value</param>
+        /// <param name="arg15">Fifteenth argument value</param>
+        /// <param name="arg16">Sixteenth argument value</param>
+        /// <returns>Call target state</returns>
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        public static CallTargetState BeginMethod<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12, TArg13, TArg14, TArg15, TArg16>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10, TArg11 arg11, TArg12 arg12, TArg13 arg13, TArg14 arg14, TArg15 arg15, TArg16 arg16)
+        {
+            if (IntegrationOptions<TIntegration, TTarget>.IsIntegrationEnabled)
+            {
+                return BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10, TArg11, TArg12, TArg13, TArg14, TArg15, TArg16>.Invoke(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10, arg11, arg12, arg13, arg14, arg15, arg16);
+            }
+
+            return CallTargetState.GetDefault();
+        }
+
         /// <summary>
         /// Begin Method Invoker Slow Path
         /// </summary>
@@ -0,0 +1,32 @@
+// <copyright file="CallTargetKind.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
+// </copyright>
+
+namespace Datadog.Trace.ClrProfiler.CallTarget
+{
+    /// <summary>
+    /// Selects which CallTarget callbacks the native profiler writes into the target method.
+    /// </summary>
+    internal enum CallTargetKind : ushort
+    {
+        /// <summary>
+        /// BeginMethod and EndMethod are called, the original method body is wrapped
+        /// in a try/catch/finally block.
+        /// </summary>
+        Default = 0,
+
+        /// <summary>
+        /// Only BeginMethod is called, at the beginning of the method body. The original method body
+        /// is not wrapped and exceptions thrown by the integration are not caught, so the integration
+        /// must handle its own exceptions.
+        /// </summary>
+        BeginOnly = 1,
+
+        /// <summary>
+        /// Only EndMethod is called, from a finally block. There is no BeginMethod call nor catch block, so the
+        /// state argument is always <see cref="CallTargetState.GetDefault"/> and the exception argument is always null.
+        /// </summary>
+        EndOnly = 2,
+    }
+}
@@ -0,0 +1,48 @@
+// <copyright file="BeginMethodHandler`10.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
+// </copyright>
+
+using System;
+using System.Reflection.Emit;
+using System.Runtime.CompilerServices;
+#pragma warning disable SA1649 // File name must match first type name
+
+namespace Datadog.Trace.ClrProfiler.CallTarget.Handlers
+{
+    internal static class BeginMethodHandler<TIntegration, TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9, TArg10>
+    {
+        private static readonly InvokeDelegate _invokeDelegate;
+
+        static BeginMethodHandler()
+        {
+            try
+            {
+                DynamicMethod dynMethod = IntegrationMapper.CreateBeginMethodDelegate(typeof(TIntegration), typeof(TTarget), new[] { typeof(TArg1), typeof(TArg2), typeof(TArg3), typeof(TArg4), typeof(TArg5), typeof(TArg6), typeof(TArg7), typeof(TArg8), typeof(TArg9), typeof(TArg10) });
+                if (dynMethod != null)
+                {
+                    _invokeDelegate = (InvokeDelegate)dynMethod.CreateDelegate(typeof(InvokeDelegate));
+                }
+            }
+            catch (Exception ex)
+            {
+                throw new CallTargetInvokerException(ex);
+            }
+            finally
+            {
+                if (_invokeDelegate is null)
+                {
+                    _invokeDelegate = (instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10) => CallTargetState.GetDefault();
+                }
+            }
+        }
+
+        internal delegate CallTargetState InvokeDelegate(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10);
+
+        [MethodImpl(MethodImplOptions.AggressiveInlining)]
+        internal static CallTargetState Invoke(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9, TArg10 arg10)
+        {
+            return new CallTargetState(Tracer.Instance.ActiveScope, _invokeDelegate(instance, arg1, arg2, arg3, arg4, arg5, arg6, arg7, arg8, arg9, arg10));
+        }
+    }
+}
@@ -98,5 +98,11 @@ namespace Datadog.Trace.ClrProfiler
         /// Gets or sets the CallTarget Class used to instrument the method
         /// </summary>
         public Type CallTargetType { get; set; }
+
+        /// <summary>
+        /// Gets or sets which CallTarget callbacks are written into the target method.
+        /// Integrations that only implement OnMethodBegin or OnMethodEnd get a smaller method body.
+        /// </summary>
+        public CallTarget.CallTargetKind CallTargetKind { get; set; } = CallTarget.CallTargetKind.Default;
     }
 }
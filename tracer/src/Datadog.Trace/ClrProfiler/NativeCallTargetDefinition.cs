@@ -42,6 +42,11 @@ namespace Datadog.Trace.ClrProfiler
         [MarshalAs(UnmanagedType.LPWStr)]
         public string WrapperType;
 
+        [MarshalAs(UnmanagedType.LPWStr)]
+        public string IntegrationName;
+
+        public ushort CallTargetKind;
+
         public NativeCallTargetDefinition(
                 string targetAssembly,
                 string targetType,
@@ -54,7 +59,9 @@ namespace Datadog.Trace.ClrProfiler
                 ushort targetMaximumMinor,
                 ushort targetMaximumPatch,
                 string wrapperAssembly,
-                string wrapperType)
+                string wrapperType,
+                string integrationName,
+                CallTarget.CallTargetKind callTargetKind = CallTarget.CallTargetKind.Default)
         {
             TargetAssembly = targetAssembly;
             TargetType = targetType;
@@ -80,6 +87,8 @@ namespace Datadog.Trace.ClrProfiler
             TargetMaximumPatch = targetMaximumPatch;
             WrapperAssembly = wrapperAssembly;
             WrapperType = wrapperType;
+            IntegrationName = integrationName;
+            CallTargetKind = (ushort)callTargetKind;
         }
 
         public void Dispose()
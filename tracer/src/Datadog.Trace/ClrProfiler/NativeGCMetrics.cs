@@ -0,0 +1,46 @@
+// <copyright file="NativeGCMetrics.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
+// </copyright>
+
+using System.Runtime.InteropServices;
+
+namespace Datadog.Trace.ClrProfiler
+{
+    /// <summary>
+    /// Snapshot of the GC metrics collected by the native profiler, filled by the native GetGCMetrics export.
+    /// Counters are cumulative since the profiler started, heap sizes are the ones of the last collection.
+    /// NOTE: Must keep this layout in sync with GCMetricsSnapshot in gc_metrics.h!
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct NativeGCMetrics
+    {
+        public const uint CurrentVersion = 1;
+
+        public uint Version;
+        public uint HistogramBucketCount;
+
+        /// <summary>
+        /// Collections by the oldest generation collected: gen0, gen1 and gen2.
+        /// </summary>
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 3)]
+        public ulong[] Collections;
+        public ulong InducedCollections;
+        public ulong PauseTotalNanoseconds;
+        public ulong PauseMaxNanoseconds;
+        public ulong LastPauseNanoseconds;
+
+        /// <summary>
+        /// Heap sizes after the last collection: gen0, gen1, gen2, LOH and POH.
+        /// </summary>
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 5)]
+        public ulong[] HeapSize;
+
+        /// <summary>
+        /// Durations of the runtime suspensions for a GC, bucket i counts the pauses under 2^i microseconds,
+        /// the last one everything above. A background gen2 collection accounts for two short pauses.
+        /// </summary>
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 20)]
+        public uint[] PauseHistogram;
+    }
+}
@@ -35,6 +35,96 @@ namespace Datadog.Trace.ClrProfiler
             }
         }
 
+        public static uint SetIntegrationEnabled(string integrationName, bool enabled)
+        {
+            if (IsWindows)
+            {
+                return Windows.SetIntegrationEnabled(integrationName, enabled);
+            }
+
+            return NonWindows.SetIntegrationEnabled(integrationName, enabled);
+        }
+
+        public static uint GetIntegrationRewrittenMethodCount(string integrationName)
+        {
+            if (IsWindows)
+            {
+                return Windows.GetIntegrationRewrittenMethodCount(integrationName);
+            }
+
+            return NonWindows.GetIntegrationRewrittenMethodCount(integrationName);
+        }
+
+        /// <summary>
+        /// Serializes a <see cref="NativeSpanBuffer"/> into an agent MessagePack payload. The payload is owned by
+        /// the native library and stays valid until the next call from the same thread.
+        /// </summary>
+        public static int SerializeSpans(IntPtr buffer, int size, out IntPtr payload, out int payloadSize)
+        {
+            if (IsWindows)
+            {
+                return Windows.SerializeSpans(buffer, size, out payload, out payloadSize);
+            }
+
+            return NonWindows.SerializeSpans(buffer, size, out payload, out payloadSize);
+        }
+
+        /// <summary>
+        /// Hands a <see cref="NativeSpanBuffer"/> over to the native span buffer, which copies it and flushes it from
+        /// a native thread. Returns S_OK (0) when accepted, S_FALSE (1) when accepted while the buffer is filling up,
+        /// and a negative HRESULT when the spans were dropped or the native span buffer is not enabled.
+        /// </summary>
+        public static int EnqueueSpans(IntPtr buffer, int size)
+        {
+            if (IsWindows)
+            {
+                return Windows.EnqueueSpans(buffer, size);
+            }
+
+            return NonWindows.EnqueueSpans(buffer, size);
+        }
+
+        /// <summary>
+        /// Waits until the spans handed to <see cref="EnqueueSpans"/> so far have been written by the native span buffer.
+        /// </summary>
+        public static int FlushSpans(int timeoutMilliseconds)
+        {
+            if (IsWindows)
+            {
+                return Windows.FlushSpans(timeoutMilliseconds);
+            }
+
+            return NonWindows.FlushSpans(timeoutMilliseconds);
+        }
+
+        /// <summary>
+        /// Reads the GC metrics collected by the native profiler. Returns a negative HRESULT when the native GC metrics are not enabled.
+        /// </summary>
+        public static int GetGCMetrics(out NativeGCMetrics metrics)
+        {
+            var size = Marshal.SizeOf(typeof(NativeGCMetrics));
+            if (IsWindows)
+            {
+                return Windows.GetGCMetrics(out metrics, size);
+            }
+
+            return NonWindows.GetGCMetrics(out metrics, size);
+        }
+
+        /// <summary>
+        /// Reads the runtime event metrics aggregated by the native EventPipe consumer. Returns a negative HRESULT when the consumer is not enabled.
+        /// </summary>
+        public static int GetRuntimeEventMetrics(out NativeRuntimeEventMetrics metrics)
+        {
+            var size = Marshal.SizeOf(typeof(NativeRuntimeEventMetrics));
+            if (IsWindows)
+            {
+                return Windows.GetRuntimeEventMetrics(out metrics, size);
+            }
+
+            return NonWindows.GetRuntimeEventMetrics(out metrics, size);
+        }
+
         // the "dll" extension is required on .NET Framework
         // and optional on .NET Core
         private static class Windows
@@ -44,6 +134,27 @@ namespace Datadog.Trace.ClrProfiler
 
             [DllImport("Datadog.Trace.ClrProfiler.Native.dll")]
             public static extern void InitializeProfiler([MarshalAs(UnmanagedType.LPWStr)] string id, [In] NativeCallTargetDefinition[] methodArrays, int size);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native.dll")]
+            public static extern uint SetIntegrationEnabled([MarshalAs(UnmanagedType.LPWStr)] string integrationName, bool enabled);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native.dll")]
+            public static extern uint GetIntegrationRewrittenMethodCount([MarshalAs(UnmanagedType.LPWStr)] string integrationName);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native.dll")]
+            public static extern int SerializeSpans(IntPtr buffer, int size, out IntPtr payload, out int payloadSize);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native.dll")]
+            public static extern int EnqueueSpans(IntPtr buffer, int size);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native.dll")]
+            public static extern int FlushSpans(int timeoutMilliseconds);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native.dll")]
+            public static extern int GetGCMetrics(out NativeGCMetrics metrics, int size);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native.dll")]
+            public static extern int GetRuntimeEventMetrics(out NativeRuntimeEventMetrics metrics, int size);
         }
 
         // assume .NET Core if not running on Windows
@@ -54,6 +165,27 @@ namespace Datadog.Trace.ClrProfiler
 
             [DllImport("Datadog.Trace.ClrProfiler.Native")]
             public static extern void InitializeProfiler([MarshalAs(UnmanagedType.LPWStr)] string id, [In] NativeCallTargetDefinition[] methodArrays, int size);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native")]
+            public static extern uint SetIntegrationEnabled([MarshalAs(UnmanagedType.LPWStr)] string integrationName, bool enabled);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native")]
+            public static extern uint GetIntegrationRewrittenMethodCount([MarshalAs(UnmanagedType.LPWStr)] string integrationName);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native")]
+            public static extern int SerializeSpans(IntPtr buffer, int size, out IntPtr payload, out int payloadSize);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native")]
+            public static extern int EnqueueSpans(IntPtr buffer, int size);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native")]
+            public static extern int FlushSpans(int timeoutMilliseconds);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native")]
+            public static extern int GetGCMetrics(out NativeGCMetrics metrics, int size);
+
+            [DllImport("Datadog.Trace.ClrProfiler.Native")]
+            public static extern int GetRuntimeEventMetrics(out NativeRuntimeEventMetrics metrics, int size);
         }
     }
 }
@@ -0,0 +1,42 @@
+// <copyright file="NativeRuntimeEventMetrics.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
+// </copyright>
+
+using System.Runtime.InteropServices;
+
+namespace Datadog.Trace.ClrProfiler
+{
+    /// <summary>
+    /// Snapshot of the runtime event metrics aggregated by the native EventPipe consumer, filled by the native GetRuntimeEventMetrics export.
+    /// Counters are cumulative since the session started, thread pool values are the ones of the last event.
+    /// NOTE: Must keep this layout in sync with RuntimeEventMetricsSnapshot in event_pipe_consumer.h!
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct NativeRuntimeEventMetrics
+    {
+        public const uint CurrentVersion = 1;
+
+        public uint Version;
+        public uint HistogramBucketCount;
+        public ulong EventsAggregated;
+        public ulong EventsDropped;
+        public ulong EventsIgnored;
+        public ulong ContentionCount;
+        public ulong ContentionTotalNanoseconds;
+        public ulong ContentionMaxNanoseconds;
+        public ulong ThreadPoolWorkerStarts;
+        public ulong ThreadPoolWorkerStops;
+        public ulong ThreadPoolAdjustments;
+        public uint ThreadPoolActiveWorkers;
+        public uint ThreadPoolAdjustmentReason;
+        public double ThreadPoolThroughput;
+        public ulong ExceptionCount;
+
+        /// <summary>
+        /// Contention durations, bucket i counts the contentions under 2^i microseconds, the last one everything above.
+        /// </summary>
+        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 20)]
+        public uint[] ContentionHistogram;
+    }
+}
@@ -0,0 +1,83 @@
+// <copyright file="NativeSpanBuffer.cs" company="Datadog">
+// Unless explicitly stated otherwise all files in this repository are licensed under the Apache 2 License.
+// This product includes software developed at Datadog (https://www.datadoghq.com/). Copyright 2017 Datadog, Inc.
+// </copyright>
+
+using System.Runtime.InteropServices;
+
+namespace Datadog.Trace.ClrProfiler
+{
+    /// <summary>
+    /// Layout of the flat span buffer serialized by the native SerializeSpans export.
+    /// Sections follow each other without padding: Header, Trace[], Span[], Tag[], Metric[]
+    /// and the UTF-16 string table.
+    /// NOTE: Must keep these layouts in sync with span_serializer.h!
+    /// </summary>
+    internal static class NativeSpanBuffer
+    {
+        public const uint Version = 1;
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct Header
+        {
+            public uint Version;
+            public uint TraceCount;
+            public uint SpanCount;
+            public uint TagCount;
+            public uint MetricCount;
+            public uint StringLength;
+        }
+
+        /// <summary>
+        /// Range of the string table, a negative length is a null string.
+        /// Reusing the same range for repeated strings lets the native side encode them once.
+        /// </summary>
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct StringRef
+        {
+            public uint Offset;
+            public int Length;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct Trace
+        {
+            public uint FirstSpan;
+            public uint SpanCount;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct Span
+        {
+            public ulong TraceId;
+            public ulong SpanId;
+            public ulong ParentId;
+            public long Start;
+            public long Duration;
+            public StringRef Name;
+            public StringRef Resource;
+            public StringRef Service;
+            public StringRef Type;
+            public uint FirstTag;
+            public uint TagCount;
+            public uint FirstMetric;
+            public uint MetricCount;
+            public int Error;
+            public uint Reserved;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct Tag
+        {
+            public StringRef Key;
+            public StringRef Value;
+        }
+
+        [StructLayout(LayoutKind.Sequential)]
+        internal struct Metric
+        {
+            public StringRef Key;
+            public double Value;
+        }
+    }
+}
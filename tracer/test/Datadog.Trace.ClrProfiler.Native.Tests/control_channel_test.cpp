@@ -0,0 +1,126 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/control_channel.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/cor_profiler.h"
+
+#include <string>
+
+#ifndef _WIN32
+#include <cstdio>
+#include <cstdlib>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace trace;
+
+namespace {
+
+#ifdef _WIN32
+const std::string channel_path = "dd-trace-control-channel-test";
+#else
+// A private directory per test run, nobody else can create or replace the socket
+struct ChannelDirectory {
+  std::string path;
+
+  ChannelDirectory() {
+    char directory[] = "/tmp/dd-trace-control-channel-XXXXXX";
+    path = mkdtemp(directory) != nullptr ? directory : "";
+  }
+
+  ~ChannelDirectory() { rmdir(path.c_str()); }
+};
+
+const ChannelDirectory channel_directory;
+const std::string channel_path = channel_directory.path + "/control.sock";
+#endif
+
+}  // namespace
+
+TEST(ControlChannelTest, AnswersRequests) {
+  ControlChannel channel(channel_path, [](const std::string& request) { return "echo:" + request; });
+  ASSERT_TRUE(channel.Start());
+  EXPECT_TRUE(channel.IsRunning());
+
+  std::string response;
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "stats", response));
+  EXPECT_EQ(response, "echo:stats");
+
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "dumpil Some.Type.Method", response));
+  EXPECT_EQ(response, "echo:dumpil Some.Type.Method");
+
+  channel.Stop();
+  EXPECT_FALSE(channel.IsRunning());
+  EXPECT_FALSE(ControlChannel::SendRequest(channel_path, "stats", response));
+}
+
+TEST(ControlChannelTest, HandlerExceptionsAreReported) {
+  ControlChannel channel(channel_path, [](const std::string& request) -> std::string { throw std::exception(); });
+  ASSERT_TRUE(channel.Start());
+
+  std::string response;
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "stats", response));
+  EXPECT_EQ(response, "error: request failed\n");
+
+  channel.Stop();
+}
+
+TEST(ControlChannelTest, ServesProfilerCommands) {
+  CorProfiler profiler;
+  ControlChannel channel(channel_path,
+                         [&profiler](const std::string& request) { return profiler.HandleControlRequest(request); });
+  ASSERT_TRUE(channel.Start());
+
+  std::string response;
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "stats", response));
+  EXPECT_EQ(0u, response.find("Total "));
+
+  // The optional features are off until Initialize enables them
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "gc", response));
+  EXPECT_EQ(response, "error: native gc metrics are not enabled\n");
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "methods", response));
+  EXPECT_EQ(response, "error: calltarget is not enabled\n");
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "exceptions", response));
+  EXPECT_EQ(response, "error: native exception metrics are not enabled\n");
+
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "loglevel verbose", response));
+  EXPECT_EQ(response, "error: expected 'loglevel debug' or 'loglevel info'\n");
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "dumpil", response));
+  EXPECT_EQ(response, "error: expected 'dumpil <Type.Method>'\n");
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "dumpil Some.Type.Method", response));
+  EXPECT_EQ(response, "ok 0\n");
+
+  ASSERT_TRUE(ControlChannel::SendRequest(channel_path, "unknown", response));
+  EXPECT_EQ(0u, response.find("commands: "));
+
+  channel.Stop();
+}
+
+#ifndef _WIN32
+TEST(ControlChannelTest, SocketIsOnlyAccessibleByTheUser) {
+  ControlChannel channel(channel_path, [](const std::string& request) { return request; });
+  ASSERT_TRUE(channel.Start());
+
+  struct stat socketStat;
+  ASSERT_EQ(0, lstat(channel_path.c_str(), &socketStat));
+  EXPECT_TRUE(S_ISSOCK(socketStat.st_mode));
+  EXPECT_EQ(0, socketStat.st_mode & (S_IRWXG | S_IRWXO));
+
+  channel.Stop();
+}
+
+TEST(ControlChannelTest, DoesNotReplaceOtherFiles) {
+  const auto file_path = channel_directory.path + "/not-a-socket";
+  FILE* file = fopen(file_path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  fclose(file);
+
+  ControlChannel channel(file_path, [](const std::string& request) { return request; });
+  EXPECT_FALSE(channel.Start());
+
+  struct stat fileStat;
+  ASSERT_EQ(0, lstat(file_path.c_str(), &fileStat));
+  EXPECT_TRUE(S_ISREG(fileStat.st_mode));
+  remove(file_path.c_str());
+}
+#endif
@@ -0,0 +1,287 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/event_pipe_consumer.h"
+
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+using namespace trace;
+
+namespace
+{
+class PayloadBuilder
+{
+public:
+  std::vector<BYTE> data;
+
+  template <typename T>
+  PayloadBuilder& Add(T value)
+  {
+    const auto bytes = reinterpret_cast<const BYTE*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+    return *this;
+  }
+
+  PayloadBuilder& AddString(const WSTRING& value)
+  {
+    for (auto c : value)
+    {
+      Add((uint16_t) c);
+    }
+    return Add((uint16_t) 0);
+  }
+};
+
+std::vector<BYTE> ContentionPayload()
+{
+  return PayloadBuilder().Add((uint8_t) 0).Add((uint16_t) 0).data;
+}
+
+std::vector<BYTE> ContentionStopPayload(double durationNs)
+{
+  return PayloadBuilder().Add((uint8_t) 0).Add((uint16_t) 0).Add(durationNs).data;
+}
+
+std::vector<BYTE> WorkerPayload(uint32_t active)
+{
+  return PayloadBuilder().Add(active).Add((uint32_t) 0).Add((uint16_t) 0).data;
+}
+
+std::vector<BYTE> AdjustmentPayload(double throughput, uint32_t workers, uint32_t reason)
+{
+  return PayloadBuilder().Add(throughput).Add(workers).Add(reason).Add((uint16_t) 0).data;
+}
+
+std::vector<BYTE> ExceptionPayload(const WSTRING& type)
+{
+  return PayloadBuilder()
+      .AddString(type)
+      .AddString(WStr("message"))
+      .Add((void*) nullptr)
+      .Add((uint32_t) 0x80131500)
+      .Add((uint16_t) 0)
+      .Add((uint16_t) 0)
+      .data;
+}
+
+EventPipeConsumerOptions TestOptions()
+{
+  EventPipeConsumerOptions options;
+  options.capacity = 1024;
+  options.batch_size = 64;
+  options.aggregation_interval = std::chrono::milliseconds(10);
+  return options;
+}
+} // namespace
+
+TEST(EventPipeConsumerTest, ParsesRuntimeEvents) {
+  RuntimeEvent event;
+
+  auto payload = ContentionStopPayload(1500.0);
+  ASSERT_TRUE(ParseRuntimeEvent(runtime_event_contention_stop_id, 1, payload.data(), (ULONG) payload.size(), &event));
+  EXPECT_EQ(RuntimeEventKind::ContentionStop, event.kind);
+  EXPECT_EQ(1500U, event.duration_ns);
+
+  // Version 0 has no duration, it is computed from the start event
+  ASSERT_TRUE(ParseRuntimeEvent(runtime_event_contention_stop_id, 0, payload.data(), (ULONG) payload.size(), &event));
+  EXPECT_EQ(0U, event.duration_ns);
+
+  payload = AdjustmentPayload(12.5, 7, 3);
+  ASSERT_TRUE(
+      ParseRuntimeEvent(runtime_event_threadpool_adjustment_id, 0, payload.data(), (ULONG) payload.size(), &event));
+  EXPECT_EQ(RuntimeEventKind::ThreadPoolAdjustment, event.kind);
+  EXPECT_EQ(12.5, event.throughput);
+  EXPECT_EQ(7U, event.worker_count);
+  EXPECT_EQ(3U, event.reason);
+
+  payload = ExceptionPayload(WStr("System.InvalidOperationException"));
+  ASSERT_TRUE(ParseRuntimeEvent(runtime_event_exception_thrown_id, 1, payload.data(), (ULONG) payload.size(), &event));
+  EXPECT_EQ(RuntimeEventKind::ExceptionThrown, event.kind);
+  EXPECT_EQ(WSTRING(WStr("System.InvalidOperationException")), WSTRING(event.type_name, event.type_name_length));
+  EXPECT_EQ(0x80131500U, event.reason);
+
+  // Long type names are truncated
+  const WSTRING longName(200, 'A');
+  payload = ExceptionPayload(longName);
+  ASSERT_TRUE(ParseRuntimeEvent(runtime_event_exception_thrown_id, 1, payload.data(), (ULONG) payload.size(), &event));
+  EXPECT_EQ((uint32_t) runtime_event_type_name_length, event.type_name_length);
+}
+
+TEST(EventPipeConsumerTest, RejectsTruncatedAndUnknownEvents) {
+  RuntimeEvent event;
+
+  auto payload = AdjustmentPayload(1.0, 2, 3);
+  EXPECT_FALSE(ParseRuntimeEvent(runtime_event_threadpool_adjustment_id, 0, payload.data(), 10, &event));
+
+  payload = ExceptionPayload(WStr("System.Exception"));
+  // Cut in the middle of the message
+  EXPECT_FALSE(ParseRuntimeEvent(runtime_event_exception_thrown_id, 1, payload.data(), 40, &event));
+
+  payload = WorkerPayload(1);
+  EXPECT_FALSE(ParseRuntimeEvent(1, 0, payload.data(), (ULONG) payload.size(), &event));
+  EXPECT_FALSE(ParseRuntimeEvent(runtime_event_threadpool_worker_start_id, 0, payload.data(), 2, &event));
+}
+
+TEST(EventPipeConsumerTest, ParsesProviders) {
+  std::vector<EventPipeProviderOptions> providers;
+
+  ASSERT_TRUE(ParseEventPipeProviders(WStr(""), &providers));
+  ASSERT_EQ(1U, providers.size());
+  EXPECT_EQ(runtime_event_provider_name, providers[0].name);
+  EXPECT_EQ(0x1C000U, providers[0].keywords);
+  EXPECT_EQ(4U, providers[0].level);
+
+  ASSERT_TRUE(ParseEventPipeProviders(
+      WStr("Microsoft-Windows-DotNETRuntime:0x4000:5, System.Threading.Tasks.TplEventSource"), &providers));
+  ASSERT_EQ(2U, providers.size());
+  EXPECT_EQ(0x4000U, providers[0].keywords);
+  EXPECT_EQ(5U, providers[0].level);
+  EXPECT_EQ(WSTRING(WStr("System.Threading.Tasks.TplEventSource")), providers[1].name);
+  EXPECT_EQ(UINT64_MAX, providers[1].keywords);
+  EXPECT_EQ(4U, providers[1].level);
+
+  EXPECT_FALSE(ParseEventPipeProviders(WStr("Provider:zz"), &providers));
+  EXPECT_FALSE(ParseEventPipeProviders(WStr("Provider:1:9"), &providers));
+  EXPECT_FALSE(ParseEventPipeProviders(WStr(":1:4"), &providers));
+}
+
+TEST(EventPipeConsumerTest, AggregatesOffTheCallingThread) {
+  EventPipeConsumer consumer(nullptr, TestOptions());
+  ASSERT_EQ(S_OK, consumer.Start());
+
+  const auto start = ContentionPayload();
+  const auto stop = ContentionStopPayload(0);
+  const auto stopWithDuration = ContentionStopPayload(10000000.0);
+  const auto worker = WorkerPayload(4);
+  const auto adjustment = AdjustmentPayload(42.0, 6, 2);
+  const auto exception = ExceptionPayload(WStr("System.TimeoutException"));
+  const auto other = ExceptionPayload(WStr("System.IO.IOException"));
+
+  // Version 0 contention, measured between start and stop
+  EXPECT_TRUE(consumer.OnRuntimeEvent(runtime_event_contention_start_id, 0, start.data(), (ULONG) start.size(), 1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  EXPECT_TRUE(consumer.OnRuntimeEvent(runtime_event_contention_stop_id, 0, stop.data(), (ULONG) stop.size(), 1));
+  // Version 1 contention, measured by the runtime
+  EXPECT_TRUE(consumer.OnRuntimeEvent(runtime_event_contention_start_id, 1, start.data(), (ULONG) start.size(), 2));
+  EXPECT_TRUE(consumer.OnRuntimeEvent(runtime_event_contention_stop_id, 1, stopWithDuration.data(),
+                                      (ULONG) stopWithDuration.size(), 2));
+
+  EXPECT_TRUE(
+      consumer.OnRuntimeEvent(runtime_event_threadpool_worker_start_id, 0, worker.data(), (ULONG) worker.size(), 3));
+  EXPECT_TRUE(consumer.OnRuntimeEvent(runtime_event_threadpool_adjustment_id, 0, adjustment.data(),
+                                      (ULONG) adjustment.size(), 3));
+
+  for (int i = 0; i < 3; i++)
+  {
+    EXPECT_TRUE(
+        consumer.OnRuntimeEvent(runtime_event_exception_thrown_id, 1, exception.data(), (ULONG) exception.size(), 4));
+  }
+  EXPECT_TRUE(consumer.OnRuntimeEvent(runtime_event_exception_thrown_id, 1, other.data(), (ULONG) other.size(), 4));
+  EXPECT_FALSE(consumer.OnRuntimeEvent(1, 0, worker.data(), (ULONG) worker.size(), 4));
+
+  ASSERT_TRUE(consumer.Drain(std::chrono::seconds(5)));
+
+  RuntimeEventMetricsSnapshot snapshot;
+  consumer.GetSnapshot(&snapshot);
+  EXPECT_EQ(runtime_event_metrics_version, snapshot.version);
+  EXPECT_EQ(10U, snapshot.events_aggregated);
+  EXPECT_EQ(0U, snapshot.events_dropped);
+  EXPECT_EQ(1U, snapshot.events_ignored);
+  EXPECT_EQ(2U, snapshot.contention_count);
+  EXPECT_EQ(10000000U, snapshot.contention_max_ns);
+  EXPECT_GE(snapshot.contention_total_ns, 12000000U);
+  EXPECT_EQ(1U, snapshot.threadpool_worker_starts);
+  EXPECT_EQ(4U, snapshot.threadpool_active_workers);
+  EXPECT_EQ(1U, snapshot.threadpool_adjustments);
+  EXPECT_EQ(2U, snapshot.threadpool_adjustment_reason);
+  EXPECT_EQ(42.0, snapshot.threadpool_throughput);
+  EXPECT_EQ(4U, snapshot.exception_count);
+
+  uint64_t contentions = 0;
+  for (int i = 0; i < SWHistogram::BucketCount; i++)
+  {
+    contentions += snapshot.contention_histogram[i];
+  }
+  EXPECT_EQ(2U, contentions);
+
+  const auto text = consumer.ToString();
+  EXPECT_NE(std::string::npos, text.find("System.TimeoutException: 3"));
+  EXPECT_LT(text.find("System.TimeoutException"), text.find("System.IO.IOException"));
+
+  consumer.Stop();
+  EXPECT_FALSE(consumer.IsRunning());
+}
+
+TEST(EventPipeConsumerTest, DropsEventsWhenTheQueueIsFull) {
+  auto options = TestOptions();
+  options.capacity = 16;
+  EventPipeConsumer consumer(nullptr, options);
+
+  // Not started: nothing drains the queue
+  const auto worker = WorkerPayload(1);
+  int accepted = 0;
+  for (int i = 0; i < 20; i++)
+  {
+    if (consumer.OnRuntimeEvent(runtime_event_threadpool_worker_wait_id, 0, worker.data(), (ULONG) worker.size(), 1))
+    {
+      accepted++;
+    }
+  }
+  EXPECT_EQ(16, accepted);
+
+  RuntimeEventMetricsSnapshot snapshot;
+  consumer.GetSnapshot(&snapshot);
+  EXPECT_EQ(4U, snapshot.events_dropped);
+
+  // Stop aggregates what was queued
+  ASSERT_EQ(S_OK, consumer.Start());
+  consumer.Stop();
+  consumer.GetSnapshot(&snapshot);
+  EXPECT_EQ(16U, snapshot.events_aggregated);
+}
+
+// Run with --gtest_also_run_disabled_tests --gtest_filter=EventPipeConsumerTest.DISABLED_Benchmark
+TEST(EventPipeConsumerTest, DISABLED_Benchmark) {
+  EventPipeConsumerOptions options;
+  options.capacity = 65536;
+  EventPipeConsumer consumer(nullptr, options);
+  ASSERT_EQ(S_OK, consumer.Start());
+
+  const auto start = ContentionPayload();
+  const auto stop = ContentionStopPayload(1000.0);
+  const auto exception = ExceptionPayload(WStr("System.OperationCanceledException"));
+  const int producers = 4;
+  const int events = 500000;
+
+  std::atomic_ullong deliveryNs = {0};
+
+  const auto begin = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++)
+  {
+    threads.emplace_back([&, p] {
+      const auto threadStart = std::chrono::steady_clock::now();
+      for (int i = 0; i < events; i += 3)
+      {
+        consumer.OnRuntimeEvent(runtime_event_contention_start_id, 1, start.data(), (ULONG) start.size(), p);
+        consumer.OnRuntimeEvent(runtime_event_contention_stop_id, 1, stop.data(), (ULONG) stop.size(), p);
+        consumer.OnRuntimeEvent(runtime_event_exception_thrown_id, 1, exception.data(), (ULONG) exception.size(), p);
+      }
+      deliveryNs += (std::chrono::steady_clock::now() - threadStart).count();
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  consumer.Stop();
+  const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+  RuntimeEventMetricsSnapshot snapshot;
+  consumer.GetSnapshot(&snapshot);
+  const auto total = snapshot.events_aggregated + snapshot.events_dropped;
+  std::cout << "EventPipeConsumer: " << deliveryNs.load() / total << " ns per delivered event, "
+            << (uint64_t)(snapshot.events_aggregated / elapsed) << " events/s aggregated, " << producers
+            << " producers, " << snapshot.events_dropped << "/" << total << " dropped" << std::endl;
+}
@@ -0,0 +1,173 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/exception_metrics.h"
+
+#include <thread>
+
+using namespace trace;
+
+TEST(ExceptionMetricsTest, CountsByTypeAndThrowingFunction) {
+  ExceptionMetrics metrics(nullptr);
+
+  EXPECT_TRUE(metrics.Record(0x100, 0x10));
+  EXPECT_TRUE(metrics.Record(0x100, 0x10));
+  EXPECT_TRUE(metrics.Record(0x100, 0x10));
+  EXPECT_TRUE(metrics.Record(0x100, 0x20));
+  EXPECT_TRUE(metrics.Record(0x200, 0x10));
+  EXPECT_TRUE(metrics.Record(0x200, 0x10));
+  EXPECT_EQ(3U, metrics.GetSiteCount());
+
+  std::vector<ExceptionSiteCount> sites;
+  ExceptionRateBaseline baseline;
+  metrics.GetTopSites(2, &sites, &baseline);
+  ASSERT_EQ(2U, sites.size());
+  EXPECT_EQ((ClassID) 0x100, sites[0].class_id);
+  EXPECT_EQ((FunctionID) 0x10, sites[0].function_id);
+  EXPECT_EQ(3U, sites[0].count);
+  EXPECT_EQ((ClassID) 0x200, sites[1].class_id);
+  EXPECT_EQ(2U, sites[1].count);
+  EXPECT_GT(sites[0].rate, 0);
+
+  // Rates only cover the exceptions since the previous read
+  metrics.Record(0x200, 0x10);
+  metrics.GetTopSites(10, &sites, &baseline);
+  ASSERT_EQ(3U, sites.size());
+  for (const auto& site : sites)
+  {
+    if (site.class_id == 0x200)
+    {
+      EXPECT_EQ(3U, site.count);
+      EXPECT_GT(site.rate, 0);
+    }
+    else
+    {
+      EXPECT_EQ(0, site.rate);
+    }
+  }
+}
+
+TEST(ExceptionMetricsTest, ReadersKeepTheirOwnRates) {
+  ExceptionMetrics metrics(nullptr);
+  metrics.Record(0x100, 0x10);
+
+  std::vector<ExceptionSiteCount> sites;
+  ExceptionRateBaseline control_channel;
+  metrics.GetTopSites(10, &sites, &control_channel);
+  ASSERT_EQ(1U, sites.size());
+  EXPECT_GT(sites[0].rate, 0);
+
+  // Another reader, or a read without a baseline, does not reset the rates of the first one
+  metrics.Record(0x100, 0x10);
+  ExceptionRateBaseline other;
+  metrics.GetTopSites(10, &sites, &other);
+  metrics.GetTopSites(10, &sites);
+  metrics.GetTopSites(10, &sites, &control_channel);
+  ASSERT_EQ(1U, sites.size());
+  EXPECT_EQ(2U, sites[0].count);
+  EXPECT_GT(sites[0].rate, 0);
+
+  metrics.GetTopSites(10, &sites, &control_channel);
+  EXPECT_EQ(0, sites[0].rate);
+  metrics.GetTopSites(10, &sites);
+  EXPECT_GT(sites[0].rate, 0);
+}
+
+TEST(ExceptionMetricsTest, AttributesExceptionToFirstSearchedFunction) {
+  ExceptionMetrics metrics(nullptr);
+
+  // Without ICorProfilerInfo the class of the exception is unknown
+  metrics.OnExceptionThrown(0x1000);
+  metrics.OnExceptionSearchFunctionEnter(0x10);
+  metrics.OnExceptionSearchFunctionEnter(0x20);
+  metrics.OnExceptionSearchFunctionEnter(0x30);
+
+  // Thrown again before any managed frame was searched
+  metrics.OnExceptionThrown(0x1000);
+  metrics.OnExceptionThrown(0x1000);
+  metrics.OnExceptionSearchFunctionEnter(0x20);
+
+  EXPECT_EQ(3U, metrics.GetThrownCount());
+
+  std::vector<ExceptionSiteCount> sites;
+  metrics.GetTopSites(10, &sites);
+  ASSERT_EQ(3U, sites.size());
+  for (const auto& site : sites)
+  {
+    EXPECT_EQ(1U, site.count);
+    EXPECT_NE((FunctionID) 0x30, site.function_id);
+  }
+
+  const auto text = metrics.ToString();
+  EXPECT_NE(std::string::npos, text.find("Exceptions [Thrown=3, Sites=3, Dropped=0]"));
+  EXPECT_NE(std::string::npos, text.find("[unknown type] at [native code]: 1"));
+  EXPECT_NE(std::string::npos, text.find("[unknown type] at [function 0x10]: 1"));
+  EXPECT_NE(std::string::npos, text.find("[unknown type]: 3"));
+}
+
+TEST(ExceptionMetricsTest, CountsExceptionWithoutManagedFrameWhenItUnwinds) {
+  ExceptionMetrics metrics(nullptr);
+
+  metrics.OnExceptionThrown(0x1000);
+  metrics.OnExceptionSearchFinished();
+  EXPECT_EQ(1U, metrics.GetSiteCount());
+
+  // Already counted by its first searched function
+  metrics.OnExceptionThrown(0x1000);
+  metrics.OnExceptionSearchFunctionEnter(0x10);
+  metrics.OnExceptionSearchFinished();
+  metrics.OnExceptionSearchFinished();
+
+  std::vector<ExceptionSiteCount> sites;
+  metrics.GetTopSites(10, &sites);
+  ASSERT_EQ(2U, sites.size());
+  for (const auto& site : sites)
+  {
+    EXPECT_EQ(1U, site.count);
+  }
+  EXPECT_EQ("[native code]", sites[0].function_id == 0 ? sites[0].function_name : sites[1].function_name);
+}
+
+TEST(ExceptionMetricsTest, DropsNewSitesWhenFull) {
+  ExceptionMetrics metrics(nullptr, 16);
+
+  for (ClassID classId = 1; classId <= 16; classId++)
+  {
+    EXPECT_TRUE(metrics.Record(classId, 0x10));
+  }
+  EXPECT_FALSE(metrics.Record(17, 0x10));
+  EXPECT_TRUE(metrics.Record(16, 0x10));
+  EXPECT_EQ(1U, metrics.GetDroppedCount());
+  EXPECT_EQ(16U, metrics.GetSiteCount());
+}
+
+TEST(ExceptionMetricsTest, CountsConcurrentThrows) {
+  ExceptionMetrics metrics(nullptr);
+  const int threadCount = 4;
+  const int iterations = 100000;
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threadCount; i++)
+  {
+    threads.emplace_back([&metrics] {
+      for (int j = 0; j < iterations; j++)
+      {
+        metrics.Record(0x100 + (j % 8), 0x10 + (j % 16));
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::vector<ExceptionSiteCount> sites;
+  metrics.GetTopSites(100, &sites);
+  EXPECT_EQ(16U, sites.size());
+  uint64_t total = 0;
+  for (const auto& site : sites)
+  {
+    total += site.count;
+  }
+  EXPECT_EQ((uint64_t) threadCount * iterations, total);
+  EXPECT_EQ(0U, metrics.GetDroppedCount());
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace trace {
+
+#define DD_FAKE_NOT_IMPLEMENTED(name, params)                                                                         \
+  HRESULT STDMETHODCALLTYPE name params override { return E_NOTIMPL; }
+
+// ICorProfilerInfo4 without a runtime behind it: it records the ReJIT and revert requests of the RejitHandler
+// and answers E_NOTIMPL to everything else.
+class FakeProfilerInfo : public ICorProfilerInfo4 {
+ public:
+  std::vector<std::pair<ModuleID, mdMethodDef>> GetRejitRequests() {
+    std::lock_guard<std::mutex> guard(requests_lock_);
+    return rejit_requests_;
+  }
+
+  std::vector<std::pair<ModuleID, mdMethodDef>> GetRevertRequests() {
+    std::lock_guard<std::mutex> guard(requests_lock_);
+    return revert_requests_;
+  }
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override { return E_NOINTERFACE; }
+  ULONG STDMETHODCALLTYPE AddRef() override { return 1; }
+  ULONG STDMETHODCALLTYPE Release() override { return 1; }
+
+  // Blocks until a thread, like the ReJIT thread of the RejitHandler, called InitializeCurrentThread
+  void WaitForInitializedThread() {
+    std::unique_lock<std::mutex> lock(requests_lock_);
+    thread_initialized_.wait(lock, [this] { return initialized_threads_ > 0; });
+  }
+
+  HRESULT STDMETHODCALLTYPE InitializeCurrentThread() override {
+    std::lock_guard<std::mutex> guard(requests_lock_);
+    initialized_threads_++;
+    thread_initialized_.notify_all();
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE RequestReJIT(ULONG cFunctions, ModuleID moduleIds[], mdMethodDef methodIds[]) override {
+    std::lock_guard<std::mutex> guard(requests_lock_);
+    for (ULONG i = 0; i < cFunctions; i++) {
+      rejit_requests_.emplace_back(moduleIds[i], methodIds[i]);
+    }
+    return S_OK;
+  }
+
+  HRESULT STDMETHODCALLTYPE RequestRevert(ULONG cFunctions, ModuleID moduleIds[], mdMethodDef methodIds[],
+                                          HRESULT status[]) override {
+    std::lock_guard<std::mutex> guard(requests_lock_);
+    for (ULONG i = 0; i < cFunctions; i++) {
+      revert_requests_.emplace_back(moduleIds[i], methodIds[i]);
+      status[i] = S_OK;
+    }
+    return S_OK;
+  }
+
+  // ICorProfilerInfo
+  DD_FAKE_NOT_IMPLEMENTED(GetClassFromObject, (ObjectID objectId, ClassID* pClassId))
+  DD_FAKE_NOT_IMPLEMENTED(GetClassFromToken, (ModuleID moduleId, mdTypeDef typeDef, ClassID* pClassId))
+  DD_FAKE_NOT_IMPLEMENTED(GetCodeInfo, (FunctionID functionId, LPCBYTE* pStart, ULONG* pcSize))
+  DD_FAKE_NOT_IMPLEMENTED(GetEventMask, (DWORD* pdwEvents))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionFromIP, (LPCBYTE ip, FunctionID* pFunctionId))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionFromToken, (ModuleID moduleId, mdToken token, FunctionID* pFunctionId))
+  DD_FAKE_NOT_IMPLEMENTED(GetHandleFromThread, (ThreadID threadId, HANDLE* phThread))
+  DD_FAKE_NOT_IMPLEMENTED(GetObjectSize, (ObjectID objectId, ULONG* pcSize))
+  DD_FAKE_NOT_IMPLEMENTED(IsArrayClass, (ClassID classId, CorElementType* pBaseElemType, ClassID* pBaseClassId,
+                                         ULONG* pcRank))
+  DD_FAKE_NOT_IMPLEMENTED(GetThreadInfo, (ThreadID threadId, DWORD* pdwWin32ThreadId))
+  DD_FAKE_NOT_IMPLEMENTED(GetCurrentThreadID, (ThreadID* pThreadId))
+  DD_FAKE_NOT_IMPLEMENTED(GetClassIDInfo, (ClassID classId, ModuleID* pModuleId, mdTypeDef* pTypeDefToken))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionInfo, (FunctionID functionId, ClassID* pClassId, ModuleID* pModuleId,
+                                            mdToken* pToken))
+  DD_FAKE_NOT_IMPLEMENTED(SetEventMask, (DWORD dwEvents))
+  DD_FAKE_NOT_IMPLEMENTED(SetEnterLeaveFunctionHooks, (FunctionEnter* pFuncEnter, FunctionLeave* pFuncLeave,
+                                                       FunctionTailcall* pFuncTailcall))
+  DD_FAKE_NOT_IMPLEMENTED(SetFunctionIDMapper, (FunctionIDMapper* pFunc))
+  DD_FAKE_NOT_IMPLEMENTED(GetTokenAndMetaDataFromFunction, (FunctionID functionId, REFIID riid, IUnknown** ppImport,
+                                                            mdToken* pToken))
+  DD_FAKE_NOT_IMPLEMENTED(GetModuleInfo, (ModuleID moduleId, LPCBYTE* ppBaseLoadAddress, ULONG cchName, ULONG* pcchName,
+                                          WCHAR szName[], AssemblyID* pAssemblyId))
+  DD_FAKE_NOT_IMPLEMENTED(GetModuleMetaData, (ModuleID moduleId, DWORD dwOpenFlags, REFIID riid, IUnknown** ppOut))
+  DD_FAKE_NOT_IMPLEMENTED(GetILFunctionBody, (ModuleID moduleId, mdMethodDef methodId, LPCBYTE* ppMethodHeader,
+                                              ULONG* pcbMethodSize))
+  DD_FAKE_NOT_IMPLEMENTED(GetILFunctionBodyAllocator, (ModuleID moduleId, IMethodMalloc** ppMalloc))
+  DD_FAKE_NOT_IMPLEMENTED(SetILFunctionBody, (ModuleID moduleId, mdMethodDef methodid, LPCBYTE pbNewILMethodHeader))
+  DD_FAKE_NOT_IMPLEMENTED(GetAppDomainInfo, (AppDomainID appDomainId, ULONG cchName, ULONG* pcchName, WCHAR szName[],
+                                             ProcessID* pProcessId))
+  DD_FAKE_NOT_IMPLEMENTED(GetAssemblyInfo, (AssemblyID assemblyId, ULONG cchName, ULONG* pcchName, WCHAR szName[],
+                                            AppDomainID* pAppDomainId, ModuleID* pModuleId))
+  DD_FAKE_NOT_IMPLEMENTED(SetFunctionReJIT, (FunctionID functionId))
+  DD_FAKE_NOT_IMPLEMENTED(ForceGC, ())
+  DD_FAKE_NOT_IMPLEMENTED(SetILInstrumentedCodeMap, (FunctionID functionId, BOOL fStartJit, ULONG cILMapEntries,
+                                                     COR_IL_MAP rgILMapEntries[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetInprocInspectionInterface, (IUnknown** ppicd))
+  DD_FAKE_NOT_IMPLEMENTED(GetInprocInspectionIThisThread, (IUnknown** ppicd))
+  DD_FAKE_NOT_IMPLEMENTED(GetThreadContext, (ThreadID threadId, ContextID* pContextId))
+  DD_FAKE_NOT_IMPLEMENTED(BeginInprocDebugging, (BOOL fThisThreadOnly, DWORD* pdwProfilerContext))
+  DD_FAKE_NOT_IMPLEMENTED(EndInprocDebugging, (DWORD dwProfilerContext))
+  DD_FAKE_NOT_IMPLEMENTED(GetILToNativeMapping, (FunctionID functionId, ULONG32 cMap, ULONG32* pcMap,
+                                                 COR_DEBUG_IL_TO_NATIVE_MAP map[]))
+
+  // ICorProfilerInfo2
+  DD_FAKE_NOT_IMPLEMENTED(DoStackSnapshot, (ThreadID thread, StackSnapshotCallback* callback, ULONG32 infoFlags,
+                                            void* clientData, BYTE context[], ULONG32 contextSize))
+  DD_FAKE_NOT_IMPLEMENTED(SetEnterLeaveFunctionHooks2, (FunctionEnter2* pFuncEnter, FunctionLeave2* pFuncLeave,
+                                                        FunctionTailcall2* pFuncTailcall))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionInfo2, (FunctionID funcId, COR_PRF_FRAME_INFO frameInfo, ClassID* pClassId,
+                                             ModuleID* pModuleId, mdToken* pToken, ULONG32 cTypeArgs,
+                                             ULONG32* pcTypeArgs, ClassID typeArgs[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetStringLayout, (ULONG* pBufferLengthOffset, ULONG* pStringLengthOffset,
+                                            ULONG* pBufferOffset))
+  DD_FAKE_NOT_IMPLEMENTED(GetClassLayout, (ClassID classID, COR_FIELD_OFFSET rFieldOffset[], ULONG cFieldOffset,
+                                           ULONG* pcFieldOffset, ULONG* pulClassSize))
+  DD_FAKE_NOT_IMPLEMENTED(GetClassIDInfo2, (ClassID classId, ModuleID* pModuleId, mdTypeDef* pTypeDefToken,
+                                            ClassID* pParentClassId, ULONG32 cNumTypeArgs, ULONG32* pcNumTypeArgs,
+                                            ClassID typeArgs[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetCodeInfo2, (FunctionID functionID, ULONG32 cCodeInfos, ULONG32* pcCodeInfos,
+                                         COR_PRF_CODE_INFO codeInfos[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetClassFromTokenAndTypeArgs, (ModuleID moduleID, mdTypeDef typeDef, ULONG32 cTypeArgs,
+                                                         ClassID typeArgs[], ClassID* pClassID))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionFromTokenAndTypeArgs, (ModuleID moduleID, mdMethodDef funcDef, ClassID classId,
+                                                            ULONG32 cTypeArgs, ClassID typeArgs[],
+                                                            FunctionID* pFunctionID))
+  DD_FAKE_NOT_IMPLEMENTED(EnumModuleFrozenObjects, (ModuleID moduleID, ICorProfilerObjectEnum** ppEnum))
+  DD_FAKE_NOT_IMPLEMENTED(GetArrayObjectInfo, (ObjectID objectId, ULONG32 cDimensions, ULONG32 pDimensionSizes[],
+                                               int pDimensionLowerBounds[], BYTE** ppData))
+  DD_FAKE_NOT_IMPLEMENTED(GetBoxClassLayout, (ClassID classId, ULONG32* pBufferOffset))
+  DD_FAKE_NOT_IMPLEMENTED(GetThreadAppDomain, (ThreadID threadId, AppDomainID* pAppDomainId))
+  DD_FAKE_NOT_IMPLEMENTED(GetRVAStaticAddress, (ClassID classId, mdFieldDef fieldToken, void** ppAddress))
+  DD_FAKE_NOT_IMPLEMENTED(GetAppDomainStaticAddress, (ClassID classId, mdFieldDef fieldToken, AppDomainID appDomainId,
+                                                      void** ppAddress))
+  DD_FAKE_NOT_IMPLEMENTED(GetThreadStaticAddress, (ClassID classId, mdFieldDef fieldToken, ThreadID threadId,
+                                                   void** ppAddress))
+  DD_FAKE_NOT_IMPLEMENTED(GetContextStaticAddress, (ClassID classId, mdFieldDef fieldToken, ContextID contextId,
+                                                    void** ppAddress))
+  DD_FAKE_NOT_IMPLEMENTED(GetStaticFieldInfo, (ClassID classId, mdFieldDef fieldToken, COR_PRF_STATIC_TYPE* pFieldInfo))
+  DD_FAKE_NOT_IMPLEMENTED(GetGenerationBounds, (ULONG cObjectRanges, ULONG* pcObjectRanges,
+                                                COR_PRF_GC_GENERATION_RANGE ranges[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetObjectGeneration, (ObjectID objectId, COR_PRF_GC_GENERATION_RANGE* range))
+  DD_FAKE_NOT_IMPLEMENTED(GetNotifiedExceptionClauseInfo, (COR_PRF_EX_CLAUSE_INFO* pinfo))
+
+  // ICorProfilerInfo3
+  DD_FAKE_NOT_IMPLEMENTED(EnumJITedFunctions, (ICorProfilerFunctionEnum** ppEnum))
+  DD_FAKE_NOT_IMPLEMENTED(RequestProfilerDetach, (DWORD dwExpectedCompletionMilliseconds))
+  DD_FAKE_NOT_IMPLEMENTED(SetFunctionIDMapper2, (FunctionIDMapper2* pFunc, void* clientData))
+  DD_FAKE_NOT_IMPLEMENTED(GetStringLayout2, (ULONG* pStringLengthOffset, ULONG* pBufferOffset))
+  DD_FAKE_NOT_IMPLEMENTED(SetEnterLeaveFunctionHooks3, (FunctionEnter3* pFuncEnter3, FunctionLeave3* pFuncLeave3,
+                                                        FunctionTailcall3* pFuncTailcall3))
+  DD_FAKE_NOT_IMPLEMENTED(SetEnterLeaveFunctionHooks3WithInfo, (FunctionEnter3WithInfo* pFuncEnter3WithInfo,
+                                                                FunctionLeave3WithInfo* pFuncLeave3WithInfo,
+                                                                FunctionTailcall3WithInfo* pFuncTailcall3WithInfo))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionEnter3Info, (FunctionID functionId, COR_PRF_ELT_INFO eltInfo,
+                                                  COR_PRF_FRAME_INFO* pFrameInfo, ULONG* pcbArgumentInfo,
+                                                  COR_PRF_FUNCTION_ARGUMENT_INFO* pArgumentInfo))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionLeave3Info, (FunctionID functionId, COR_PRF_ELT_INFO eltInfo,
+                                                  COR_PRF_FRAME_INFO* pFrameInfo,
+                                                  COR_PRF_FUNCTION_ARGUMENT_RANGE* pRetvalRange))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionTailcall3Info, (FunctionID functionId, COR_PRF_ELT_INFO eltInfo,
+                                                     COR_PRF_FRAME_INFO* pFrameInfo))
+  DD_FAKE_NOT_IMPLEMENTED(EnumModules, (ICorProfilerModuleEnum** ppEnum))
+  DD_FAKE_NOT_IMPLEMENTED(GetRuntimeInformation, (USHORT* pClrInstanceId, COR_PRF_RUNTIME_TYPE* pRuntimeType,
+                                                  USHORT* pMajorVersion, USHORT* pMinorVersion, USHORT* pBuildNumber,
+                                                  USHORT* pQFEVersion, ULONG cchVersionString, ULONG* pcchVersionString,
+                                                  WCHAR szVersionString[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetThreadStaticAddress2, (ClassID classId, mdFieldDef fieldToken, AppDomainID appDomainId,
+                                                    ThreadID threadId, void** ppAddress))
+  DD_FAKE_NOT_IMPLEMENTED(GetAppDomainsContainingModule, (ModuleID moduleId, ULONG32 cAppDomainIds,
+                                                          ULONG32* pcAppDomainIds, AppDomainID appDomainIds[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetModuleInfo2, (ModuleID moduleId, LPCBYTE* ppBaseLoadAddress, ULONG cchName,
+                                           ULONG* pcchName, WCHAR szName[], AssemblyID* pAssemblyId,
+                                           DWORD* pdwModuleFlags))
+
+  // ICorProfilerInfo4
+  DD_FAKE_NOT_IMPLEMENTED(EnumThreads, (ICorProfilerThreadEnum** ppEnum))
+  DD_FAKE_NOT_IMPLEMENTED(GetCodeInfo3, (FunctionID functionID, ReJITID reJitId, ULONG32 cCodeInfos,
+                                         ULONG32* pcCodeInfos, COR_PRF_CODE_INFO codeInfos[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetFunctionFromIP2, (LPCBYTE ip, FunctionID* pFunctionId, ReJITID* pReJitId))
+  DD_FAKE_NOT_IMPLEMENTED(GetReJITIDs, (FunctionID functionId, ULONG cReJitIds, ULONG* pcReJitIds, ReJITID reJitIds[]))
+  DD_FAKE_NOT_IMPLEMENTED(GetILToNativeMapping2, (FunctionID functionId, ReJITID reJitId, ULONG32 cMap, ULONG32* pcMap,
+                                                  COR_DEBUG_IL_TO_NATIVE_MAP map[]))
+  DD_FAKE_NOT_IMPLEMENTED(EnumJITedFunctions2, (ICorProfilerFunctionEnum** ppEnum))
+  DD_FAKE_NOT_IMPLEMENTED(GetObjectSize2, (ObjectID objectId, SIZE_T* pcSize))
+
+ private:
+  std::mutex requests_lock_;
+  std::vector<std::pair<ModuleID, mdMethodDef>> rejit_requests_;
+  std::vector<std::pair<ModuleID, mdMethodDef>> revert_requests_;
+  std::condition_variable thread_initialized_;
+  int initialized_threads_ = 0;
+};
+
+#undef DD_FAKE_NOT_IMPLEMENTED
+
+}  // namespace trace
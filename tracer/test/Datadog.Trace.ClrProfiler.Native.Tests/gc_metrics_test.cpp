@@ -0,0 +1,144 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/gc_metrics.h"
+
+#include <thread>
+
+using namespace trace;
+
+TEST(GCMetricsTest, CountsCollectionsByOldestGeneration) {
+  GCMetrics metrics(nullptr);
+
+  BOOL gen0[] = {TRUE, FALSE, FALSE, FALSE, FALSE};
+  BOOL gen1[] = {TRUE, TRUE, FALSE, FALSE, FALSE};
+  BOOL gen2[] = {TRUE, TRUE, TRUE, TRUE, TRUE};
+
+  metrics.OnGarbageCollectionStarted(5, gen0, COR_PRF_GC_OTHER);
+  metrics.OnGarbageCollectionFinished();
+  metrics.OnGarbageCollectionStarted(5, gen0, COR_PRF_GC_OTHER);
+  metrics.OnGarbageCollectionFinished();
+  metrics.OnGarbageCollectionStarted(5, gen1, COR_PRF_GC_OTHER);
+  metrics.OnGarbageCollectionFinished();
+  metrics.OnGarbageCollectionStarted(4, gen2, COR_PRF_GC_INDUCED);
+  metrics.OnGarbageCollectionFinished();
+
+  // Finished without Started: the profiler attached during a collection
+  metrics.OnGarbageCollectionFinished();
+
+  GCMetricsSnapshot snapshot;
+  metrics.GetSnapshot(&snapshot);
+  EXPECT_EQ(gc_metrics_version, snapshot.version);
+  EXPECT_EQ((uint32_t) SWHistogram::BucketCount, snapshot.histogram_bucket_count);
+  EXPECT_EQ(2U, snapshot.collections[0]);
+  EXPECT_EQ(1U, snapshot.collections[1]);
+  EXPECT_EQ(1U, snapshot.collections[2]);
+  EXPECT_EQ(1U, snapshot.induced_collections);
+
+  // Pauses only come from the runtime suspensions
+  for (int i = 0; i < SWHistogram::BucketCount; i++)
+  {
+    EXPECT_EQ(0U, snapshot.pause_histogram[i]);
+  }
+  EXPECT_EQ(0U, snapshot.pause_total_ns);
+}
+
+TEST(GCMetricsTest, MeasuresPauses) {
+  GCMetrics metrics(nullptr);
+  BOOL gen0[] = {TRUE, FALSE, FALSE};
+
+  metrics.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+  metrics.OnGarbageCollectionStarted(3, gen0, COR_PRF_GC_OTHER);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  metrics.OnGarbageCollectionFinished();
+  metrics.OnRuntimeResumeFinished();
+
+  GCMetricsSnapshot snapshot;
+  metrics.GetSnapshot(&snapshot);
+  EXPECT_GE(snapshot.last_pause_ns, 5000000U);
+  EXPECT_EQ(snapshot.last_pause_ns, snapshot.pause_max_ns);
+
+  metrics.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+  metrics.OnGarbageCollectionStarted(3, gen0, COR_PRF_GC_OTHER);
+  metrics.OnGarbageCollectionFinished();
+  metrics.OnRuntimeResumeFinished();
+  metrics.GetSnapshot(&snapshot);
+  EXPECT_EQ(2U, snapshot.collections[0]);
+  EXPECT_LT(snapshot.last_pause_ns, snapshot.pause_max_ns);
+
+  // Suspensions that are not for a GC, or that were aborted, are not pauses
+  const auto total = snapshot.pause_total_ns;
+  metrics.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_REJIT);
+  metrics.OnRuntimeResumeFinished();
+  metrics.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+  metrics.OnRuntimeSuspendAborted();
+  metrics.OnRuntimeResumeFinished();
+  metrics.GetSnapshot(&snapshot);
+  EXPECT_EQ(total, snapshot.pause_total_ns);
+}
+
+TEST(GCMetricsTest, KeepsEphemeralCollectionsDuringABackgroundGC) {
+  GCMetrics metrics(nullptr);
+  BOOL gen0[] = {TRUE, FALSE, FALSE};
+  BOOL gen2[] = {TRUE, TRUE, TRUE};
+
+  // The background gen2 only suspends the runtime to start and to finish, it runs for much longer
+  metrics.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+  metrics.OnGarbageCollectionStarted(3, gen2, COR_PRF_GC_OTHER);
+  metrics.OnRuntimeResumeFinished();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  metrics.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+  metrics.OnGarbageCollectionStarted(3, gen0, COR_PRF_GC_OTHER);
+  metrics.OnGarbageCollectionFinished();
+  metrics.OnRuntimeResumeFinished();
+
+  GCMetricsSnapshot snapshot;
+  metrics.GetSnapshot(&snapshot);
+  EXPECT_EQ(1U, snapshot.collections[0]);
+  EXPECT_EQ(1U, snapshot.collections[2]);
+
+  // The background gen2 finishes last
+  metrics.OnRuntimeSuspendStarted(COR_PRF_SUSPEND_FOR_GC);
+  metrics.OnGarbageCollectionFinished();
+  metrics.OnRuntimeResumeFinished();
+
+  metrics.GetSnapshot(&snapshot);
+
+  // Three short suspensions, none of them covers the 20ms of background work
+  uint64_t pauses = 0;
+  for (int i = 0; i < SWHistogram::BucketCount; i++)
+  {
+    pauses += snapshot.pause_histogram[i];
+  }
+  EXPECT_EQ(3U, pauses);
+  EXPECT_LT(snapshot.pause_total_ns, 20000000U);
+  EXPECT_LE(snapshot.pause_max_ns, snapshot.pause_total_ns);
+}
+
+TEST(GCMetricsTest, SumsGenerationBounds) {
+  GCMetrics metrics(nullptr);
+
+  const COR_PRF_GC_GENERATION_RANGE ranges[] = {{COR_PRF_GC_GEN_0, 0x1000, 100, 4096},
+                                                 {COR_PRF_GC_GEN_0, 0x9000, 50, 4096},
+                                                 {COR_PRF_GC_GEN_1, 0x2000, 200, 4096},
+                                                 {COR_PRF_GC_GEN_2, 0x3000, 3000, 8192},
+                                                 {COR_PRF_GC_LARGE_OBJECT_HEAP, 0x5000, 85000, 131072},
+                                                 {COR_PRF_GC_PINNED_OBJECT_HEAP, 0x8000, 10, 4096}};
+  metrics.RecordGenerationBounds(ranges, 6);
+
+  GCMetricsSnapshot snapshot;
+  metrics.GetSnapshot(&snapshot);
+  EXPECT_EQ(150U, snapshot.heap_size[0]);
+  EXPECT_EQ(200U, snapshot.heap_size[1]);
+  EXPECT_EQ(3000U, snapshot.heap_size[2]);
+  EXPECT_EQ(85000U, snapshot.heap_size[3]);
+  EXPECT_EQ(10U, snapshot.heap_size[4]);
+
+  // Sizes are replaced, not accumulated
+  metrics.RecordGenerationBounds(ranges, 1);
+  metrics.GetSnapshot(&snapshot);
+  EXPECT_EQ(100U, snapshot.heap_size[0]);
+  EXPECT_EQ(0U, snapshot.heap_size[3]);
+
+  EXPECT_NE(std::string::npos, metrics.ToString().find("Heap [Gen0=100B"));
+}
@@ -0,0 +1,167 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/il_flight_recorder.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace trace;
+
+namespace
+{
+// ldarg.0; ret
+const std::vector<uint8_t> original_code = {0x02, 0x2A};
+
+// nop; ldarg.0; call 0x0A000001; brtrue.s IL_000a; leave.s IL_000a; ret
+const std::vector<uint8_t> rewritten_code = {0x00, 0x02, 0x28, 0x01, 0x00, 0x00, 0x0A, 0x2D, 0x00, 0xDE, 0x00, 0x2A};
+const std::vector<uint8_t> rewritten_locals = {0x07, 0x01, 0x1C};
+const std::vector<ILFlightRecorderEHClause> rewritten_eh = {{0, 0, 9, 9, 2, 0x01000005}};
+
+ILFlightRecorderBody OriginalBody()
+{
+  ILFlightRecorderBody body;
+  body.code = original_code.data();
+  body.codeSize = (uint32_t) original_code.size();
+  return body;
+}
+
+ILFlightRecorderBody RewrittenBody()
+{
+  ILFlightRecorderBody body;
+  body.code = rewritten_code.data();
+  body.codeSize = (uint32_t) rewritten_code.size();
+  body.ehClauses = rewritten_eh.data();
+  body.ehCount = (uint32_t) rewritten_eh.size();
+  body.localSignature = rewritten_locals.data();
+  body.localSignatureSize = (uint32_t) rewritten_locals.size();
+  return body;
+}
+
+std::vector<uint8_t> ReadFile(const std::filesystem::path& path)
+{
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+} // namespace
+
+TEST(ILFlightRecorderTest, RecordsAndDecodesRewrite) {
+  const auto path = std::filesystem::temp_directory_path() / "dd-il-flight-recorder-test-1.bin";
+
+  {
+    ILFlightRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path.string(), kILFlightRecorderMinimumCapacity));
+    recorder.Record(0x1234, 0x06000001, ILFlightRecorderRewriteKind::CallTargetBeginOnly, 0, "Samples.Type.Method",
+                    OriginalBody(), RewrittenBody());
+  }
+
+  std::stringstream output;
+  ASSERT_TRUE(ILFlightRecorder::Decode(path.string(), output));
+  const auto text = output.str();
+
+  EXPECT_NE(text.find("Samples.Type.Method"), std::string::npos);
+  EXPECT_NE(text.find("module 0x1234, token 0x6000001, CallTarget.BeginOnly, hr 0x0"), std::string::npos);
+  EXPECT_NE(text.find("original: 2 bytes of IL, 0 EH clauses, 0 bytes of local signature"), std::string::npos);
+  EXPECT_NE(text.find("IL_0001: ret"), std::string::npos);
+  EXPECT_NE(text.find("IL_0002: call 0xA000001"), std::string::npos);
+  EXPECT_NE(text.find("IL_0007: brtrue.s IL_0009"), std::string::npos);
+  EXPECT_NE(text.find("IL_0009: leave.s IL_000b"), std::string::npos);
+  EXPECT_NE(text.find(".try IL_0000 to IL_0009 catch 0x1000005 handler IL_0009 to IL_000b"), std::string::npos);
+  EXPECT_NE(text.find(".locals 07 01 1C"), std::string::npos);
+  EXPECT_NE(text.find("1 records"), std::string::npos);
+
+  std::filesystem::remove(path);
+}
+
+#ifndef _WIN32
+TEST(ILFlightRecorderTest, OnlyTheOwnerCanReadTheFile) {
+  const auto path = std::filesystem::temp_directory_path() / "dd-il-flight-recorder-test-4.bin";
+  std::ofstream(path) << "left by an earlier process";
+  std::filesystem::permissions(path, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write |
+                                         std::filesystem::perms::group_read | std::filesystem::perms::others_read);
+
+  {
+    ILFlightRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path.string(), kILFlightRecorderMinimumCapacity));
+  }
+
+  EXPECT_EQ(std::filesystem::perms::owner_read | std::filesystem::perms::owner_write,
+            std::filesystem::status(path).permissions());
+  std::filesystem::remove(path);
+}
+#endif
+
+TEST(ILFlightRecorderTest, KeepsLatestRecordsAfterWrapping) {
+  const auto path = std::filesystem::temp_directory_path() / "dd-il-flight-recorder-test-2.bin";
+
+  {
+    ILFlightRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path.string(), kILFlightRecorderMinimumCapacity));
+    for (int i = 0; i < 5000; i++)
+    {
+      recorder.Record(1, 0x06000000 + i, ILFlightRecorderRewriteKind::CallTargetDefault, 0,
+                      "Method" + std::to_string(i) + ";", OriginalBody(), RewrittenBody());
+    }
+  }
+
+  std::stringstream output;
+  ASSERT_TRUE(ILFlightRecorder::Decode(path.string(), output));
+  const auto text = output.str();
+
+  EXPECT_EQ(text.find("Method0;"), std::string::npos);
+  EXPECT_NE(text.find("Method4999;"), std::string::npos);
+  EXPECT_EQ(text.find("5000 records"), std::string::npos);
+
+  std::filesystem::remove(path);
+}
+
+TEST(ILFlightRecorderTest, SkipsUnpublishedRecords) {
+  const auto path = std::filesystem::temp_directory_path() / "dd-il-flight-recorder-test-3.bin";
+
+  {
+    ILFlightRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path.string(), kILFlightRecorderMinimumCapacity));
+    recorder.Record(1, 0x06000001, ILFlightRecorderRewriteKind::CallTargetDefault, 0, "First", OriginalBody(),
+                    RewrittenBody());
+    recorder.Record(1, 0x06000002, ILFlightRecorderRewriteKind::CallTargetDefault, 0, "Second", OriginalBody(),
+                    RewrittenBody());
+  }
+
+  // Clear the magic of the first record, as if the process died while writing it
+  auto file = ReadFile(path);
+  std::fill(file.begin() + sizeof(ILFlightRecorderFileHeader),
+            file.begin() + sizeof(ILFlightRecorderFileHeader) + sizeof(uint32_t), 0);
+
+  std::stringstream output;
+  ASSERT_TRUE(ILFlightRecorder::Decode(file.data(), file.size(), output));
+  const auto text = output.str();
+
+  EXPECT_EQ(text.find("First"), std::string::npos);
+  EXPECT_NE(text.find("Second"), std::string::npos);
+  EXPECT_NE(text.find("1 records"), std::string::npos);
+
+  std::filesystem::remove(path);
+}
+
+TEST(ILFlightRecorderTest, RejectsOtherFiles) {
+  const std::vector<uint8_t> file(256, 0xAB);
+  std::stringstream output;
+  EXPECT_FALSE(ILFlightRecorder::Decode(file.data(), file.size(), output));
+  EXPECT_FALSE(ILFlightRecorder::Decode("missing-il-flight-recorder-file.bin", output));
+}
+
+TEST(ILFlightRecorderTest, DisassemblesSwitchAndTwoByteOpcodes) {
+  // switch (IL_000d, IL_000e); ceq; ret
+  const std::vector<uint8_t> code = {0x45, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                     0x00, 0x01, 0x00, 0x00, 0x00, 0xFE, 0x01, 0x2A};
+  std::stringstream output;
+  ILFlightRecorder::Disassemble(code.data(), (uint32_t) code.size(), output);
+  const auto text = output.str();
+
+  EXPECT_NE(text.find("IL_0000: switch (IL_000d, IL_000e)"), std::string::npos);
+  EXPECT_NE(text.find("IL_000d: ceq"), std::string::npos);
+  EXPECT_NE(text.find("IL_000f: ret"), std::string::npos);
+}
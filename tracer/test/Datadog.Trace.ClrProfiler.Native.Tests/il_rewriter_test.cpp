@@ -0,0 +1,481 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/il_rewriter.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+// Captures the method body produced by ILRewriter::Export()
+class CapturingFunctionControl : public ICorProfilerFunctionControl
+{
+public:
+  std::vector<BYTE> body;
+
+  HRESULT STDMETHODCALLTYPE QueryInterface(REFIID riid, void** ppvObject) override
+  {
+    return E_NOINTERFACE;
+  }
+  ULONG STDMETHODCALLTYPE AddRef() override
+  {
+    return 1;
+  }
+  ULONG STDMETHODCALLTYPE Release() override
+  {
+    return 1;
+  }
+  HRESULT STDMETHODCALLTYPE SetCodegenFlags(DWORD flags) override
+  {
+    return S_OK;
+  }
+  HRESULT STDMETHODCALLTYPE SetILFunctionBody(ULONG cbNewILMethodHeader, LPCBYTE pbNewILMethodHeader) override
+  {
+    body.assign(pbNewILMethodHeader, pbNewILMethodHeader + cbNewILMethodHeader);
+    return S_OK;
+  }
+  HRESULT STDMETHODCALLTYPE SetILInstrumentedCodeMap(ULONG cILMapEntries, COR_IL_MAP rgILMapEntries[]) override
+  {
+    return S_OK;
+  }
+};
+
+// Minimal IL assembler with forward label support
+class ILBuilder
+{
+private:
+  std::vector<BYTE> code_;
+  std::map<int, unsigned> labels_;
+  std::vector<std::tuple<size_t, int, int>> fixups_;
+
+public:
+  ILBuilder& Op(BYTE opcode)
+  {
+    code_.push_back(opcode);
+    return *this;
+  }
+  ILBuilder& Op2(BYTE opcode)
+  {
+    code_.push_back(0xFE);
+    code_.push_back(opcode);
+    return *this;
+  }
+  ILBuilder& U16(UINT16 value)
+  {
+    code_.push_back(value & 0xFF);
+    code_.push_back(value >> 8);
+    return *this;
+  }
+  ILBuilder& I32(INT32 value)
+  {
+    for (int i = 0; i < 4; i++)
+    {
+      code_.push_back((BYTE) (((UINT32) value) >> (8 * i)));
+    }
+    return *this;
+  }
+  ILBuilder& Mark(int label)
+  {
+    labels_[label] = (unsigned) code_.size();
+    return *this;
+  }
+  ILBuilder& Branch8(BYTE opcode, int label)
+  {
+    code_.push_back(opcode);
+    fixups_.emplace_back(code_.size(), label, 1);
+    code_.push_back(0);
+    return *this;
+  }
+  ILBuilder& Branch32(BYTE opcode, int label)
+  {
+    code_.push_back(opcode);
+    fixups_.emplace_back(code_.size(), label, 4);
+    return I32(0);
+  }
+  ILBuilder& Switch(const std::vector<int>& targets)
+  {
+    code_.push_back(0x45);
+    I32((INT32) targets.size());
+    const size_t base = code_.size() + 4 * targets.size();
+    for (const auto target : targets)
+    {
+      fixups_.emplace_back(code_.size(), target, -(int) base);
+      I32(0);
+    }
+    return *this;
+  }
+  unsigned Offset(int label)
+  {
+    return labels_.at(label);
+  }
+  std::vector<BYTE> Code()
+  {
+    for (const auto& fixup : fixups_)
+    {
+      const size_t position = std::get<0>(fixup);
+      const int size = std::get<2>(fixup);
+      const size_t next = size > 0 ? position + size : (size_t) -size;
+      const INT32 delta = (INT32) labels_.at(std::get<1>(fixup)) - (INT32) next;
+      if (size == 1)
+      {
+        code_[position] = (BYTE) (INT8) delta;
+      }
+      else
+      {
+        for (int i = 0; i < 4; i++)
+        {
+          code_[position + i] = (BYTE) (((UINT32) delta) >> (8 * i));
+        }
+      }
+    }
+    return code_;
+  }
+};
+
+std::vector<BYTE> FatBody(const std::vector<BYTE>& code, unsigned maxStack, mdToken localVarSig,
+                          const std::vector<IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT>& clauses = {})
+{
+  IMAGE_COR_ILMETHOD_FAT header{};
+  header.Flags = CorILMethod_FatFormat | CorILMethod_InitLocals | (clauses.empty() ? 0 : CorILMethod_MoreSects);
+  header.Size = sizeof(IMAGE_COR_ILMETHOD_FAT) / sizeof(DWORD);
+  header.MaxStack = maxStack;
+  header.CodeSize = (DWORD) code.size();
+  header.LocalVarSigTok = localVarSig;
+
+  std::vector<BYTE> body((BYTE*) &header, (BYTE*) &header + sizeof(header));
+  body.insert(body.end(), code.begin(), code.end());
+  body.resize((body.size() + 3) & ~3);
+
+  if (!clauses.empty())
+  {
+    IMAGE_COR_ILMETHOD_SECT_FAT section{};
+    section.Kind = CorILMethod_Sect_EHTable | CorILMethod_Sect_FatFormat;
+    section.DataSize = (unsigned) (sizeof(section) + sizeof(IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT) * clauses.size());
+    body.insert(body.end(), (BYTE*) &section, (BYTE*) &section + sizeof(section));
+    body.insert(body.end(), (const BYTE*) clauses.data(), (const BYTE*) (clauses.data() + clauses.size()));
+  }
+
+  return body;
+}
+
+IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT Clause(CorExceptionFlag flags, unsigned tryBegin, unsigned tryEnd,
+                                             unsigned handlerBegin, unsigned handlerEnd, DWORD classToken = 0)
+{
+  IMAGE_COR_ILMETHOD_SECT_EH_CLAUSE_FAT clause{};
+  clause.Flags = flags;
+  clause.TryOffset = tryBegin;
+  clause.TryLength = tryEnd - tryBegin;
+  clause.HandlerOffset = handlerBegin;
+  clause.HandlerLength = handlerEnd - handlerBegin;
+  clause.ClassToken = classToken;
+  return clause;
+}
+
+// Encoding independent view of a method: every instruction is reduced to its long form, with
+// branch operands replaced by the index of the target instruction.
+struct NormalizedMethod
+{
+  std::vector<std::tuple<unsigned, INT64>> instructions;
+  std::vector<std::tuple<unsigned, int, int, int, int, INT64>> clauses;
+
+  bool operator==(const NormalizedMethod& other) const
+  {
+    return instructions == other.instructions && clauses == other.clauses;
+  }
+};
+
+NormalizedMethod Normalize(ILRewriter& rewriter)
+{
+  std::map<const ILInstr*, int> indexes;
+  int index = 0;
+  for (ILInstr* pInstr = rewriter.GetILList()->m_pNext; pInstr != rewriter.GetILList(); pInstr = pInstr->m_pNext)
+  {
+    indexes[pInstr] = index++;
+  }
+  indexes[rewriter.GetILList()] = index;
+
+  NormalizedMethod method;
+  for (ILInstr* pInstr = rewriter.GetILList()->m_pNext; pInstr != rewriter.GetILList(); pInstr = pInstr->m_pNext)
+  {
+    unsigned opcode = pInstr->m_opcode;
+    INT64 operand = pInstr->m_Arg64;
+
+    if (opcode >= CEE_LDARG_0 && opcode <= CEE_LDARG_3)
+    {
+      operand = opcode - CEE_LDARG_0;
+      opcode = CEE_LDARG;
+    }
+    else if (opcode >= CEE_LDLOC_0 && opcode <= CEE_LDLOC_3)
+    {
+      operand = opcode - CEE_LDLOC_0;
+      opcode = CEE_LDLOC;
+    }
+    else if (opcode >= CEE_STLOC_0 && opcode <= CEE_STLOC_3)
+    {
+      operand = opcode - CEE_STLOC_0;
+      opcode = CEE_STLOC;
+    }
+    else if (opcode >= CEE_LDARG_S && opcode <= CEE_STLOC_S)
+    {
+      // ldarg.s, ldarga.s, starg.s, ldloc.s, ldloca.s, stloc.s
+      static const unsigned longForms[] = {CEE_LDARG, CEE_LDARGA, CEE_STARG, CEE_LDLOC, CEE_LDLOCA, CEE_STLOC};
+      operand = (BYTE) pInstr->m_Arg8;
+      opcode = longForms[opcode - CEE_LDARG_S];
+    }
+    else if (opcode == CEE_LDARG || opcode == CEE_LDARGA || opcode == CEE_STARG || opcode == CEE_LDLOC ||
+             opcode == CEE_LDLOCA || opcode == CEE_STLOC)
+    {
+      operand = (UINT16) pInstr->m_Arg16;
+    }
+    else if (opcode >= CEE_LDC_I4_M1 && opcode <= CEE_LDC_I4_8)
+    {
+      operand = (INT32) opcode - CEE_LDC_I4_0;
+      opcode = CEE_LDC_I4;
+    }
+    else if (opcode == CEE_LDC_I4_S)
+    {
+      operand = pInstr->m_Arg8;
+      opcode = CEE_LDC_I4;
+    }
+    else if (opcode == CEE_LDC_I4)
+    {
+      operand = pInstr->m_Arg32;
+    }
+    else if (opcode >= CEE_BR_S && opcode <= CEE_BLT_UN_S)
+    {
+      operand = indexes.at(pInstr->m_pTarget);
+      opcode = opcode - CEE_BR_S + CEE_BR;
+    }
+    else if ((opcode >= CEE_BR && opcode <= CEE_BLT_UN) || opcode == CEE_LEAVE || opcode == CEE_SWITCH_ARG)
+    {
+      operand = indexes.at(pInstr->m_pTarget);
+    }
+    else if (opcode == CEE_LEAVE_S)
+    {
+      operand = indexes.at(pInstr->m_pTarget);
+      opcode = CEE_LEAVE;
+    }
+
+    method.instructions.emplace_back(opcode, operand);
+  }
+
+  for (unsigned i = 0; i < rewriter.GetEHCount(); i++)
+  {
+    const EHClause& clause = rewriter.GetEHPointer()[i];
+    const INT64 classTokenOrFilter = (clause.m_Flags & COR_ILEXCEPTION_CLAUSE_FILTER) != 0
+                                         ? indexes.at(clause.m_pFilter)
+                                         : (INT64) clause.m_ClassToken;
+    method.clauses.emplace_back(clause.m_Flags, indexes.at(clause.m_pTryBegin), indexes.at(clause.m_pTryEnd),
+                                indexes.at(clause.m_pHandlerBegin), indexes.at(clause.m_pHandlerEnd),
+                                classTokenOrFilter);
+  }
+
+  return method;
+}
+
+std::vector<BYTE> ExportBody(const std::vector<BYTE>& body, bool compact)
+{
+  CapturingFunctionControl control;
+  ILRewriter rewriter(nullptr, &control, 0, 0x06000001);
+  rewriter.SetCompactEncoding(compact);
+  EXPECT_EQ(S_OK, rewriter.ImportMethodBody(body.data()));
+  EXPECT_EQ(S_OK, rewriter.Export());
+  return control.body;
+}
+
+struct CorpusMethod
+{
+  std::string name;
+  std::vector<BYTE> body;
+};
+
+// Method bodies in the shapes the rewriters produce, assembled with the long encodings
+std::vector<CorpusMethod> Corpus()
+{
+  std::vector<CorpusMethod> corpus;
+
+  {
+    // CallTarget-like body: state local, try/catch around the call, leave to a shared return block
+    enum { TryBegin, HandlerBegin, End };
+    ILBuilder il;
+    il.Op(0x14).Op2(0x0E).U16(0);                            // ldnull; stloc 0
+    il.Mark(TryBegin).Op2(0x09).U16(0).Op2(0x09).U16(1);      // ldarg 0; ldarg 1
+    il.Op(0x20).I32(3).Op(0x28).I32(0x0A000001);              // ldc.i4 3; call
+    il.Op2(0x0E).U16(1).Branch32(0xDD, End);                  // stloc 1; leave End
+    il.Mark(HandlerBegin).Op2(0x0E).U16(2).Op2(0x0C).U16(2);  // stloc 2; ldloc 2
+    il.Op(0x28).I32(0x0A000002).Branch32(0xDD, End);          // call; leave End
+    il.Mark(End).Op2(0x0C).U16(1).Op(0x2A);                   // ldloc 1; ret
+    const auto code = il.Code();
+    corpus.push_back({"calltarget-shape",
+                      FatBody(code, 4, 0x11000001,
+                              {Clause(COR_ILEXCEPTION_CLAUSE_NONE, il.Offset(TryBegin), il.Offset(HandlerBegin),
+                                      il.Offset(HandlerBegin), il.Offset(End), 0x01000001)})});
+  }
+
+  {
+    // Loop whose backward branch spans more than 127 bytes inside a try/finally
+    enum { TryBegin, Loop, HandlerBegin, End };
+    ILBuilder il;
+    il.Mark(TryBegin).Mark(Loop);
+    for (int i = 0; i < 30; i++)
+    {
+      il.Op(0x20).I32(1000 + i).Op(0x26); // ldc.i4; pop
+    }
+    il.Op2(0x09).U16(1).Branch32(0x3A, Loop).Branch32(0xDD, End); // ldarg 1; brtrue Loop; leave End
+    il.Mark(HandlerBegin).Op2(0x09).U16(0).Op(0x28).I32(0x0A000003).Op(0xDC); // ldarg 0; call; endfinally
+    il.Mark(End).Op(0x2A);
+    const auto code = il.Code();
+    corpus.push_back({"long-loop-finally",
+                      FatBody(code, 2, mdTokenNil,
+                              {Clause(COR_ILEXCEPTION_CLAUSE_FINALLY, il.Offset(TryBegin), il.Offset(HandlerBegin),
+                                      il.Offset(HandlerBegin), il.Offset(End))})});
+  }
+
+  {
+    // Switch, constants of every size and variables beyond the short forms
+    enum { Case0, Case1, Case2 };
+    ILBuilder il;
+    il.Op2(0x09).U16(0).Switch({Case0, Case1, Case2}).Branch32(0x38, Case2); // ldarg 0; switch; br
+    il.Mark(Case0).Op(0x20).I32(-1).Op(0x20).I32(8).Op(0x58);                  // ldc.i4 -1; ldc.i4 8; add
+    il.Op(0x20).I32(100).Op(0x58).Op(0x20).I32(100000).Op(0x58).Op(0x26);      // ldc.i4 100; add; ldc.i4 100000
+    il.Branch32(0x38, Case2);                                                 // br Case2
+    il.Mark(Case1).Op2(0x09).U16(300).Op2(0x0B).U16(300);                     // ldarg 300; starg 300
+    il.Op2(0x0A).U16(2).Op2(0x0D).U16(260).Op(0x26).Op(0x26);                 // ldarga 2; ldloca 260; pop; pop
+    il.Mark(Case2).Op(0x2A);
+    corpus.push_back({"switch-constants-variables", FatBody(il.Code(), 3, 0x11000002)});
+  }
+
+  {
+    // Small method without locals or EH clauses that still carries a fat header
+    ILBuilder il;
+    il.Op2(0x09).U16(1).Op2(0x09).U16(2).Op(0x58).Op(0x2A); // ldarg 1; ldarg 2; add; ret
+    corpus.push_back({"tiny-candidate", FatBody(il.Code(), 2, mdTokenNil)});
+  }
+
+  return corpus;
+}
+} // namespace
+
+TEST(ILRewriterTest, CompactEncodingRoundTripsCorpus) {
+  for (const auto& method : Corpus())
+  {
+    CapturingFunctionControl control;
+    ILRewriter rewriter(nullptr, &control, 0, 0x06000001);
+    rewriter.SetCompactEncoding(true);
+    ASSERT_EQ(S_OK, rewriter.ImportMethodBody(method.body.data())) << method.name;
+    const auto expected = Normalize(rewriter);
+
+    ASSERT_EQ(S_OK, rewriter.Export()) << method.name;
+
+    ILRewriter reimported(nullptr, nullptr, 0, 0x06000001);
+    ASSERT_EQ(S_OK, reimported.ImportMethodBody(control.body.data())) << method.name;
+    EXPECT_TRUE(expected == Normalize(reimported)) << method.name;
+  }
+}
+
+TEST(ILRewriterTest, CompactEncodingShrinksCorpus) {
+  size_t baselineTotal = 0;
+  size_t compactTotal = 0;
+  for (const auto& method : Corpus())
+  {
+    const auto baseline = ExportBody(method.body, false);
+    const auto compact = ExportBody(method.body, true);
+    EXPECT_LE(compact.size(), baseline.size()) << method.name;
+    baselineTotal += baseline.size();
+    compactTotal += compact.size();
+  }
+
+  EXPECT_LT(compactTotal, baselineTotal);
+}
+
+TEST(ILRewriterTest, CompactEncodingUsesTinyHeaderWhenPossible) {
+  const auto corpus = Corpus();
+  const auto& method = corpus.back();
+
+  const auto baseline = ExportBody(method.body, false);
+  const auto compact = ExportBody(method.body, true);
+
+  EXPECT_EQ(CorILMethod_FatFormat, baseline[0] & 0x3);
+  EXPECT_EQ(CorILMethod_TinyFormat, compact[0] & 0x3);
+  // ldarg.1; ldarg.2; add; ret
+  EXPECT_EQ(std::vector<BYTE>({0x03, 0x04, 0x58, 0x2A}), std::vector<BYTE>(compact.begin() + 1, compact.end()));
+}
+
+TEST(ILRewriterTest, CompactEncodingKeepsShortBranchesInRange) {
+  const auto corpus = Corpus();
+
+  CapturingFunctionControl control;
+  ILRewriter rewriter(nullptr, &control, 0, 0x06000001);
+  rewriter.SetCompactEncoding(true);
+  ASSERT_EQ(S_OK, rewriter.ImportMethodBody(corpus[0].body.data()));
+  ASSERT_EQ(S_OK, rewriter.ExportCode());
+
+  // Both leaves of the CallTarget-like body fit in a signed byte, the backward loop branch does not
+  std::vector<unsigned> opcodes;
+  for (ILInstr* pInstr = rewriter.GetILList()->m_pNext; pInstr != rewriter.GetILList(); pInstr = pInstr->m_pNext)
+  {
+    opcodes.push_back(pInstr->m_opcode);
+  }
+  EXPECT_EQ(2, std::count(opcodes.begin(), opcodes.end(), (unsigned) CEE_LEAVE_S));
+  EXPECT_EQ(0, std::count(opcodes.begin(), opcodes.end(), (unsigned) CEE_LEAVE));
+
+  ILRewriter loop(nullptr, &control, 0, 0x06000001);
+  loop.SetCompactEncoding(true);
+  ASSERT_EQ(S_OK, loop.ImportMethodBody(corpus[1].body.data()));
+  ASSERT_EQ(S_OK, loop.ExportCode());
+  opcodes.clear();
+  for (ILInstr* pInstr = loop.GetILList()->m_pNext; pInstr != loop.GetILList(); pInstr = pInstr->m_pNext)
+  {
+    opcodes.push_back(pInstr->m_opcode);
+  }
+  EXPECT_EQ(1, std::count(opcodes.begin(), opcodes.end(), (unsigned) CEE_BRTRUE));
+  EXPECT_EQ(1, std::count(opcodes.begin(), opcodes.end(), (unsigned) CEE_LEAVE_S));
+}
+
+TEST(ILRewriterTest, PromotesShortBranchesOnlyWhenNeeded) {
+  // try { ldarg.0; brfalse.s Skip; nop; Skip: leave.s End } finally { endfinally } End: ret
+  enum { TryBegin, Skip, HandlerBegin, End };
+  ILBuilder il;
+  il.Mark(TryBegin).Op(0x02).Branch8(0x2C, Skip).Op(0x00).Mark(Skip).Branch8(0xDE, End);
+  il.Mark(HandlerBegin).Op(0xDC).Mark(End).Op(0x2A);
+  const auto code = il.Code();
+  const auto body = FatBody(code, 1, mdTokenNil,
+                            {Clause(COR_ILEXCEPTION_CLAUSE_FINALLY, il.Offset(TryBegin), il.Offset(HandlerBegin),
+                                    il.Offset(HandlerBegin), il.Offset(End))});
+
+  CapturingFunctionControl control;
+  ILRewriter rewriter(nullptr, &control, 0, 0x06000001);
+  rewriter.SetCompactEncoding(true);
+  ASSERT_EQ(S_OK, rewriter.ImportMethodBody(body.data()));
+
+  ILInstr* brfalse = rewriter.GetILList()->m_pNext->m_pNext;
+  ILInstr* nop = brfalse->m_pNext;
+  ILInstr* leave = nop->m_pNext;
+  ILInstr* endfinally = leave->m_pNext;
+  ASSERT_EQ((unsigned) CEE_BRFALSE_S, brfalse->m_opcode);
+  ASSERT_EQ((unsigned) CEE_LEAVE_S, leave->m_opcode);
+
+  // Grow the code between the branches and their targets past the short range
+  for (int i = 0; i < 200; i++)
+  {
+    ILInstr* pNew = rewriter.NewILInstr();
+    pNew->m_opcode = CEE_NOP;
+    rewriter.InsertBefore(nop, pNew);
+
+    pNew = rewriter.NewILInstr();
+    pNew->m_opcode = CEE_NOP;
+    rewriter.InsertBefore(endfinally, pNew);
+  }
+  const auto expected = Normalize(rewriter);
+
+  ASSERT_EQ(S_OK, rewriter.Export());
+  EXPECT_EQ((unsigned) CEE_BRFALSE, brfalse->m_opcode);
+  EXPECT_EQ((unsigned) CEE_LEAVE, leave->m_opcode);
+
+  ILRewriter reimported(nullptr, nullptr, 0, 0x06000001);
+  ASSERT_EQ(S_OK, reimported.ImportMethodBody(control.body.data()));
+  EXPECT_TRUE(expected == Normalize(reimported));
+}
@@ -219,3 +219,29 @@ TEST(IntegrationLoaderTest, DeserializesSignatureTypeArray)
     EXPECT_STREQ(L"_", target.signature_types[1].c_str());
     EXPECT_STREQ(L"FakeClient.Pipeline'1<T>", target.signature_types[2].c_str());
 }
+
+TEST(IntegrationLoaderTest, DeserializesCallTargetKind)
+{
+    std::vector<IntegrationMethod> integrations;
+    std::stringstream str(R"TEXT(
+        [{
+            "name": "test-integration",
+            "method_replacements": [{
+                "target": { "assembly": "Assembly.One", "type": "Type.One", "method": "Method.One" },
+                "wrapper": { "assembly": "Assembly.Two", "type": "Type.Two", "action": "CallTargetModification" }
+            },{
+                "target": { "assembly": "Assembly.One", "type": "Type.One", "method": "Method.Two" },
+                "wrapper": { "assembly": "Assembly.Two", "type": "Type.Two", "action": "CallTargetModification", "calltarget_kind": "BeginOnly" }
+            },{
+                "target": { "assembly": "Assembly.One", "type": "Type.One", "method": "Method.Three" },
+                "wrapper": { "assembly": "Assembly.Two", "type": "Type.Two", "action": "CallTargetModification", "calltarget_kind": "EndOnly" }
+            }]
+        }]
+    )TEXT");
+
+    LoadIntegrationsFromStream(str, integrations, true, false, {});
+    ASSERT_EQ(3, integrations.size());
+    EXPECT_EQ(CallTargetKind::Default, integrations[0].replacement.wrapper_method.calltarget_kind);
+    EXPECT_EQ(CallTargetKind::BeginOnly, integrations[1].replacement.wrapper_method.calltarget_kind);
+    EXPECT_EQ(CallTargetKind::EndOnly, integrations[2].replacement.wrapper_method.calltarget_kind);
+}
@@ -43,4 +43,20 @@ TEST(IntegrationTest, AssemblyReferencePartialVersion) {
 TEST(IntegrationTest, AssemblyReferenceInvalidVersion) {
   AssemblyReference ref(L"Some.Assembly, Version=xyz");
   EXPECT_EQ(ref.version, Version(0, 0, 0, 0));
-}
\ No newline at end of file
+}
+
+TEST(IntegrationTest, MethodReferenceCacheKeys) {
+  const auto min_ver = Version(1, 0, 0, 0);
+  const auto max_ver = Version(2, USHRT_MAX, USHRT_MAX, USHRT_MAX);
+  const MethodReference add(L"Some.Assembly", L"Some.Type", L"Add", L"", min_ver, max_ver, {}, {});
+  const MethodReference add2(L"Some.Assembly", L"Some.Type", L"Add", L"", min_ver, max_ver, {}, {});
+  const MethodReference remove(L"Some.Assembly", L"Some.Type", L"Remove", L"", min_ver, max_ver, {}, {});
+  const MethodReference other(L"Some.Assembly", L"Some.Type", L"Add", L"", min_ver, Version(3, 0, 0, 0), {}, {});
+
+  EXPECT_EQ(add.get_method_cache_key(), add2.get_method_cache_key());
+  EXPECT_EQ(WrapperCacheKeyHash()(add.get_method_cache_key()), WrapperCacheKeyHash()(add2.get_method_cache_key()));
+  EXPECT_FALSE(add.get_method_cache_key() == remove.get_method_cache_key());
+  EXPECT_FALSE(add.get_method_cache_key() == other.get_method_cache_key());
+  EXPECT_FALSE(add.get_method_cache_key() == add.get_type_cache_key());
+  EXPECT_EQ(add.get_type_cache_key(), remove.get_type_cache_key());
+}
@@ -0,0 +1,172 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/managed_loader_image.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace trace;
+
+namespace {
+
+// gzip -9 of ManagedLoaderText(), compressed with dynamic Huffman codes
+const uint8_t dynamic_gzip[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x9a, 0x4d, 0x6e, 0x54, 0x41,
+    0x0c, 0x84, 0xf7, 0x9c, 0x82, 0x13, 0x8c, 0xda, 0xff, 0xf6, 0x9a, 0x2c, 0x41, 0x8a, 0x04, 0x17,
+    0x78, 0x62, 0x86, 0x08, 0x29, 0x62, 0xd0, 0x68, 0xb8, 0x3f, 0x9d, 0x23, 0xbc, 0x6f, 0x99, 0xc5,
+    0x93, 0xd3, 0xee, 0xea, 0xaa, 0x72, 0x79, 0x5e, 0x8e, 0xe7, 0x71, 0xbd, 0xbf, 0x5d, 0x7e, 0x3c,
+    0x8e, 0x9f, 0xb7, 0xcb, 0x97, 0xf7, 0xc7, 0xeb, 0xe3, 0xfe, 0xeb, 0xf7, 0xfb, 0xed, 0x71, 0xf9,
+    0x76, 0xfc, 0x39, 0xde, 0x6e, 0xd7, 0xcb, 0xd7, 0xfb, 0x71, 0xdd, 0x7f, 0x7e, 0x7f, 0x1e, 0x8f,
+    0xe7, 0xbf, 0xbf, 0x9f, 0xd7, 0xa7, 0x97, 0xb3, 0x9f, 0xc8, 0xf9, 0x4f, 0xfc, 0xfc, 0x27, 0x03,
+    0xfe, 0xb1, 0x3c, 0xff, 0x8d, 0xc6, 0xf9, 0x6f, 0x0c, 0xd4, 0x71, 0x70, 0x9e, 0x04, 0x6d, 0x6b,
+    0x70, 0x3b, 0xb2, 0x08, 0x0a, 0x94, 0x54, 0x72, 0x27, 0xd7, 0x4a, 0xb0, 0x30, 0x04, 0x0c, 0x04,
+    0x0d, 0x1a, 0xa4, 0x52, 0x83, 0x33, 0x99, 0x3a, 0x01, 0x2b, 0x79, 0xaf, 0x04, 0x11, 0xee, 0xa4,
+    0x52, 0x83, 0x33, 0x85, 0x82, 0xee, 0x45, 0x81, 0x7b, 0x4a, 0x82, 0x88, 0x24, 0x95, 0x8a, 0x9c,
+    0xa9, 0x48, 0xf7, 0x9a, 0xdc, 0xd3, 0x10, 0x44, 0x4c, 0x22, 0x36, 0x22, 0x30, 0x97, 0x45, 0x5e,
+    0x94, 0x08, 0x79, 0xbc, 0x82, 0x78, 0x42, 0x94, 0x50, 0x92, 0x18, 0x62, 0x3f, 0x47, 0x44, 0x1b,
+    0x88, 0xd3, 0x13, 0xc9, 0x47, 0x22, 0xa5, 0x2a, 0xa2, 0x89, 0xd2, 0x8e, 0x14, 0x84, 0xe8, 0xbc,
+    0x2e, 0xa4, 0x21, 0x82, 0xbc, 0x8b, 0x2e, 0x70, 0x2e, 0xb5, 0x05, 0x7a, 0xa8, 0xbe, 0x84, 0x68,
+    0x23, 0xc1, 0x86, 0x26, 0xaa, 0x55, 0xe8, 0x5c, 0x8d, 0x7a, 0x38, 0xe4, 0xbe, 0x0c, 0x61, 0xc3,
+    0x84, 0xe0, 0x70, 0x7b, 0x05, 0xe2, 0x30, 0x8c, 0xbc, 0x2f, 0x73, 0xf2, 0x96, 0x0d, 0xf1, 0x86,
+    0x15, 0xe1, 0x28, 0x6b, 0xc2, 0x87, 0x36, 0x84, 0x7b, 0x7d, 0x11, 0x9e, 0x77, 0xa4, 0x29, 0x6e,
+    0x44, 0xbf, 0xdc, 0x89, 0x56, 0x7a, 0x12, 0x5d, 0xf6, 0x42, 0xfe, 0x13, 0xd9, 0x8d, 0x58, 0xc4,
+    0xd9, 0x84, 0x20, 0x0b, 0x6a, 0xc8, 0x83, 0x3a, 0xb1, 0x86, 0x81, 0x5c, 0x68, 0x14, 0xaa, 0x35,
+    0xe4, 0x5c, 0xb9, 0x48, 0x0f, 0x37, 0xa0, 0x84, 0x4c, 0xc5, 0x04, 0x1b, 0x19, 0x04, 0x87, 0x59,
+    0x04, 0xf3, 0xd9, 0xe4, 0x7d, 0xd5, 0x0a, 0x34, 0x36, 0x10, 0x6c, 0x94, 0x11, 0x8e, 0xaa, 0x20,
+    0x7c, 0x58, 0x45, 0xb8, 0xb7, 0x86, 0xf0, 0x7c, 0xa3, 0x28, 0xa3, 0x95, 0xe8, 0x57, 0x3b, 0xca,
+    0x67, 0x92, 0xe8, 0x72, 0x37, 0xf1, 0x00, 0x83, 0xfc, 0xc6, 0x6e, 0x3c, 0xa9, 0xe5, 0xc4, 0x47,
+    0x4d, 0x12, 0xcf, 0x36, 0xbd, 0x58, 0xca, 0x85, 0x06, 0x95, 0xa5, 0xac, 0x9a, 0x2f, 0x34, 0xc6,
+    0x26, 0xe9, 0xe3, 0x9e, 0x7e, 0xc9, 0xa5, 0x89, 0x20, 0x84, 0x88, 0xa8, 0xa1, 0x6a, 0x8e, 0xe6,
+    0x30, 0x49, 0x34, 0xf4, 0x49, 0xa3, 0x09, 0x53, 0x61, 0x1a, 0x6a, 0x68, 0x76, 0xd6, 0x40, 0x83,
+    0xba, 0x16, 0x4a, 0x05, 0x74, 0x58, 0x04, 0xc1, 0xf2, 0x0e, 0xf3, 0x60, 0x81, 0x07, 0x4a, 0x72,
+    0x6c, 0x50, 0x6c, 0xe4, 0x92, 0x2c, 0xc7, 0x46, 0x28, 0xd9, 0x92, 0x81, 0xaa, 0x75, 0xa3, 0x38,
+    0x47, 0x88, 0x97, 0x93, 0x30, 0x62, 0x1c, 0x85, 0xb9, 0x54, 0x89, 0x46, 0xd5, 0x92, 0x9d, 0x2d,
+    0x0d, 0x75, 0x32, 0xd9, 0xbd, 0x25, 0x1a, 0x63, 0xa4, 0x18, 0x26, 0xcb, 0xd1, 0x0b, 0x28, 0xf6,
+    0xde, 0x6a, 0xd0, 0xeb, 0x6e, 0xc6, 0x25, 0xed, 0x88, 0xb9, 0x9a, 0xf1, 0xe4, 0x2c, 0xc4, 0xca,
+    0xc3, 0x34, 0x60, 0x58, 0x80, 0x3a, 0x48, 0xdf, 0xb6, 0x99, 0x21, 0x6a, 0xaa, 0x0b, 0x69, 0xb7,
+    0xae, 0x42, 0x21, 0xaa, 0xc0, 0x14, 0xd5, 0x50, 0x8c, 0x2a, 0xc8, 0x73, 0xe9, 0x07, 0x4c, 0x48,
+    0x68, 0x8b, 0xfc, 0xa4, 0xc2, 0x28, 0x55, 0x91, 0x57, 0x56, 0x13, 0x74, 0x36, 0x73, 0x96, 0x48,
+    0x17, 0xba, 0x37, 0x67, 0x28, 0x71, 0x43, 0x98, 0x74, 0x34, 0xb9, 0xe9, 0x26, 0x2e, 0xd2, 0xc9,
+    0x40, 0x33, 0xa9, 0x06, 0xe2, 0x12, 0x0d, 0x34, 0x6d, 0x6b, 0x2a, 0xe1, 0x49, 0x4d, 0x94, 0x23,
+    0xe8, 0xd6, 0x29, 0x72, 0x6f, 0x2c, 0x21, 0xd1, 0x0a, 0xb4, 0xd7, 0x2f, 0x94, 0xfd, 0xe8, 0x96,
+    0x45, 0xb4, 0xbc, 0x40, 0xa9, 0x96, 0x36, 0xf2, 0x25, 0x3a, 0x28, 0xaf, 0xd3, 0x09, 0xe2, 0xb9,
+    0xf6, 0xac, 0x42, 0x1c, 0x9e, 0x2d, 0x2d, 0xb4, 0x9a, 0x41, 0xee, 0xd5, 0xd6, 0xa0, 0x6a, 0x82,
+    0xd2, 0xe3, 0xad, 0x6e, 0xa4, 0x93, 0xa6, 0x28, 0x17, 0x37, 0x45, 0x33, 0x8e, 0x29, 0x4a, 0xfc,
+    0xcd, 0x04, 0xfd, 0xba, 0xc5, 0xd0, 0x2e, 0xc3, 0xac, 0xc9, 0xeb, 0x36, 0xb6, 0xa5, 0xd9, 0x83,
+    0xf0, 0xa0, 0x6a, 0x68, 0xff, 0x64, 0x61, 0x68, 0xd9, 0x15, 0x6c, 0xb3, 0x96, 0x28, 0x2f, 0xb1,
+    0x84, 0x3b, 0xc3, 0x46, 0x0b, 0xca, 0x62, 0xdb, 0xd0, 0x4a, 0xb4, 0x7a, 0x6d, 0xb6, 0xe7, 0x6d,
+    0x47, 0x4b, 0xe5, 0x46, 0x1b, 0x6c, 0x1b, 0x5d, 0x6c, 0x25, 0xba, 0xfd, 0xe4, 0x7f, 0x0d, 0x6c,
+    0x65, 0x23, 0x66, 0x2a, 0x00, 0x00,
+};
+
+// "hello hello hello world", compressed with the fixed Huffman codes
+const uint8_t fixed_gzip[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x57,
+    0xc8, 0x40, 0x22, 0xcb, 0xf3, 0x8b, 0x72, 0x52, 0x00, 0x26, 0xe6, 0x5a, 0x81, 0x17, 0x00, 0x00,
+    0x00,
+};
+
+// "MZ stored block bytes", stored without compression
+const uint8_t stored_gzip[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x01, 0x15, 0x00, 0xea, 0xff, 0x4d,
+    0x5a, 0x20, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x64, 0x20, 0x62, 0x6c, 0x6f, 0x63, 0x6b, 0x20, 0x62,
+    0x79, 0x74, 0x65, 0x73, 0x82, 0xfb, 0xc6, 0xad, 0x15, 0x00, 0x00, 0x00,
+};
+
+// "named", with the original file name in the header
+const uint8_t named_gzip[] = {
+    0x1f, 0x8b, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6c, 0x6f, 0x61, 0x64, 0x65, 0x72,
+    0x2e, 0x64, 0x6c, 0x6c, 0x00, 0xcb, 0x4b, 0xcc, 0x4d, 0x4d, 0x01, 0x00, 0x87, 0xcc, 0xe0, 0x71,
+    0x05, 0x00, 0x00, 0x00,
+};
+
+std::string ManagedLoaderText() {
+  std::string text;
+  for (int i = 0; i < 200; i++) {
+    text += "Datadog.Trace.ClrProfiler.Managed.Loader.Startup " + std::to_string(i * i) + "\n";
+  }
+  return text;
+}
+
+std::string Decompress(const uint8_t* source, size_t sourceSize) {
+  std::vector<uint8_t> destination(GetGzipSize(source, sourceSize));
+  if (!GzipDecompress(source, sourceSize, destination.data(), destination.size())) {
+    return "[failed]";
+  }
+  return std::string(destination.begin(), destination.end());
+}
+
+}  // namespace
+
+TEST(ManagedLoaderImageTest, UncompressedBytesAreHandedOutAsTheyAre) {
+  const uint8_t assembly[] = {'M', 'Z', 0x90, 0x00, 0x03};
+  ManagedLoaderImage image(assembly, sizeof(assembly));
+  EXPECT_FALSE(image.IsCompressed());
+
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+  ASSERT_TRUE(image.Get(&data, &size));
+  EXPECT_EQ(assembly, data);
+  EXPECT_EQ(sizeof(assembly), size);
+  EXPECT_EQ(0U, image.GetDecompressNanoseconds());
+
+  ManagedLoaderImage empty(nullptr, 0);
+  EXPECT_FALSE(empty.Get(&data, &size));
+}
+
+// The Windows resources are embedded uncompressed, only Linux and macOS inflate them
+#ifndef _WIN32
+
+TEST(ManagedLoaderImageTest, DecompressesEveryBlockType) {
+  EXPECT_EQ(ManagedLoaderText(), Decompress(dynamic_gzip, sizeof(dynamic_gzip)));
+  EXPECT_EQ("hello hello hello world", Decompress(fixed_gzip, sizeof(fixed_gzip)));
+  EXPECT_EQ("MZ stored block bytes", Decompress(stored_gzip, sizeof(stored_gzip)));
+  EXPECT_EQ("named", Decompress(named_gzip, sizeof(named_gzip)));
+}
+
+TEST(ManagedLoaderImageTest, RejectsCorruptedStreams) {
+  std::vector<uint8_t> corrupted(dynamic_gzip, dynamic_gzip + sizeof(dynamic_gzip));
+  corrupted[sizeof(dynamic_gzip) - 8] ^= 0xFF;
+  EXPECT_EQ("[failed]", Decompress(corrupted.data(), corrupted.size()));
+
+  corrupted.assign(dynamic_gzip, dynamic_gzip + sizeof(dynamic_gzip));
+  corrupted[200] ^= 0x55;
+  EXPECT_EQ("[failed]", Decompress(corrupted.data(), corrupted.size()));
+
+  // Truncated stream followed by the original trailer
+  corrupted.assign(dynamic_gzip, dynamic_gzip + sizeof(dynamic_gzip) / 2);
+  corrupted.insert(corrupted.end(), dynamic_gzip + sizeof(dynamic_gzip) - 8, dynamic_gzip + sizeof(dynamic_gzip));
+  EXPECT_EQ("[failed]", Decompress(corrupted.data(), corrupted.size()));
+
+  // The destination must have the size of the trailer
+  std::vector<uint8_t> destination(10);
+  EXPECT_FALSE(GzipDecompress(fixed_gzip, sizeof(fixed_gzip), destination.data(), destination.size()));
+}
+
+TEST(ManagedLoaderImageTest, DecompressesOnceForEveryCaller) {
+  ManagedLoaderImage image(dynamic_gzip, sizeof(dynamic_gzip));
+  EXPECT_TRUE(image.IsCompressed());
+  EXPECT_EQ(sizeof(dynamic_gzip), image.GetCompressedSize());
+
+  const uint8_t* data[4] = {};
+  size_t size[4] = {};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back([&, i] { image.Get(&data[i], &size[i]); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto text = ManagedLoaderText();
+  ASSERT_NE(nullptr, data[0]);
+  EXPECT_EQ(text, std::string(data[0], data[0] + size[0]));
+  for (int i = 1; i < 4; i++) {
+    EXPECT_EQ(data[0], data[i]);
+    EXPECT_EQ(size[0], size[i]);
+  }
+  EXPECT_GT(image.GetDecompressNanoseconds(), 0U);
+}
+
+#endif
@@ -0,0 +1,285 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/clr_helpers.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/module_id_list.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/module_metadata.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/rejit_handler.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/stats.h"
+#include "fake_profiler_info.h"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace trace;
+
+namespace
+{
+// Bytes currently allocated with operator new by the test executable. Every allocation is prefixed with its size so
+// the heap usage is measured independently of the accounting in Stats.
+std::atomic<long long> heap_bytes = {0};
+constexpr size_t heap_header = alignof(std::max_align_t);
+
+void* HeapAllocate(size_t size) noexcept
+{
+    auto block = static_cast<char*>(std::malloc(size + heap_header));
+    if (block == nullptr)
+    {
+        return nullptr;
+    }
+
+    *reinterpret_cast<size_t*>(block) = size;
+    heap_bytes += (long long) size;
+    return block + heap_header;
+}
+
+void HeapFree(void* ptr) noexcept
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    auto block = static_cast<char*>(ptr) - heap_header;
+    heap_bytes -= (long long) *reinterpret_cast<size_t*>(block);
+    std::free(block);
+}
+} // namespace
+
+void* operator new(size_t size)
+{
+    auto ptr = HeapAllocate(size);
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return HeapAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return HeapAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    HeapFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    HeapFree(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    HeapFree(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+    HeapFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    HeapFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    HeapFree(ptr);
+}
+
+namespace
+{
+const MemoryCategory all_categories[] = {
+    MemoryCategory::ModuleMetadata,    MemoryCategory::RejitModule,       MemoryCategory::RejitMethod,
+    MemoryCategory::FunctionInfo,      MemoryCategory::MethodReplacement, MemoryCategory::AssemblyReference,
+    MemoryCategory::ModuleId,          MemoryCategory::MethodSignature};
+
+constexpr size_t category_count = sizeof(all_categories) / sizeof(all_categories[0]);
+
+// Fixed size so taking a snapshot does not change the heap usage it records
+struct MemorySnapshot
+{
+    std::array<long long, category_count> objects;
+    std::array<long long, category_count> bytes;
+    long long heap;
+
+    static MemorySnapshot Take()
+    {
+        MemorySnapshot snapshot;
+        for (size_t i = 0; i < category_count; i++)
+        {
+            snapshot.objects[i] = Stats::Instance()->MemoryObjects(all_categories[i]);
+            snapshot.bytes[i] = Stats::Instance()->MemoryBytes(all_categories[i]);
+        }
+        snapshot.heap = heap_bytes.load();
+        return snapshot;
+    }
+};
+
+// void M(int32, string)
+const std::vector<COR_SIGNATURE> method_signature = {0x00, 0x02, 0x01, 0x08, 0x0E};
+
+MethodReplacement CreateMethodReplacement()
+{
+    const MethodReference target(WStr("Samples.Target"), WStr("Samples.Target.Client"), WStr("Send"), EmptyWStr,
+                                 Version(1, 0, 0, 0), Version(2, 0, 0, 0), {},
+                                 {WStr("System.Void"), WStr("System.Int32")});
+    const MethodReference wrapper(
+        WStr("Datadog.Trace, Version=1.0.0.0, Culture=neutral, PublicKeyToken=def86d061d0d2eeb"),
+        WStr("Datadog.Trace.ClientIntegration"), EmptyWStr, WStr("CallTargetModification"), Version(0, 0, 0, 0),
+        Version(0, 0, 0, 0), {}, {});
+    return MethodReplacement({}, target, wrapper);
+}
+
+// Stops the ReJIT thread before the handler is destroyed, also when an assertion ends the test early
+struct RejitHandlerShutdown
+{
+    RejitHandler& handler;
+
+    ~RejitHandlerShutdown()
+    {
+        handler.Shutdown();
+    }
+};
+
+// One module load: the metadata, the ReJIT handler entries of a few instrumented methods and their signatures. The
+// unload goes through the same calls as CorProfiler::ModuleUnloadStarted.
+void LoadAndUnloadModule(ModuleID module_id, RejitHandler& handler, MethodSignatureCache& cache,
+                         ModuleIdList& module_ids)
+{
+    const auto before = MemorySnapshot::Take();
+
+    // ModuleLoadFinished
+    module_ids.Add(module_id);
+
+    auto integrations = std::make_unique<std::vector<IntegrationMethod>>();
+    integrations->emplace_back(WStr("Client"), CreateMethodReplacement());
+
+    auto module = handler.GetOrAddModule(module_id);
+    ASSERT_NE(nullptr, module);
+    module->SetModuleMetadata(new ModuleMetadata({}, {}, {}, {}, WStr("Samples.Target"), 1, {},
+                                                 std::move(integrations), nullptr));
+    module->GetModuleMetadata()->SetWrapperParentTypeRef(
+        CreateMethodReplacement().wrapper_method.get_type_cache_key(), 0x01000001);
+
+    for (mdMethodDef method_def = 0x06000001; method_def < 0x06000005; method_def++)
+    {
+        FunctionInfo function_info(method_def, WStr("Send"), {}, MethodSignature(method_signature),
+                                   FunctionMethodSignature(method_signature.data(), (ULONG) method_signature.size()));
+        ASSERT_EQ(S_OK, function_info.method_signature.TryParse(&cache, module_id, method_def));
+
+        auto method = module->GetOrAddMethod(method_def);
+        method->SetFunctionInfo(function_info);
+        method->SetMethodReplacement(CreateMethodReplacement());
+        method->SetFunctionInfo(function_info);
+    }
+    EXPECT_TRUE(handler.HasModuleAndMethod(module_id, 0x06000001));
+
+    const auto loaded = MemorySnapshot::Take();
+    const long long expected_objects[] = {1, 1, 4, 4, 4, 0, 1, 4};
+    for (size_t i = 0; i < loaded.objects.size(); i++)
+    {
+        if (all_categories[i] != MemoryCategory::AssemblyReference)
+        {
+            EXPECT_EQ(before.objects[i] + expected_objects[i], loaded.objects[i]) << i;
+        }
+    }
+    EXPECT_GT(loaded.heap, before.heap);
+
+    // ModuleUnloadStarted
+    EXPECT_TRUE(module_ids.Remove(module_id));
+    handler.RemoveModule(module_id);
+    cache.Remove(module_id);
+
+    EXPECT_FALSE(module_ids.Contains(module_id));
+    EXPECT_FALSE(handler.HasModuleAndMethod(module_id, 0x06000001));
+}
+} // namespace
+
+TEST(MemoryAccountingTest, ReleasesEveryPerModuleStructureOnUnload)
+{
+    FakeProfilerInfo profiler_info;
+    RejitHandler handler(static_cast<ICorProfilerInfo4*>(&profiler_info), nullptr);
+    RejitHandlerShutdown shutdown{handler};
+    MethodSignatureCache cache;
+    ModuleIdList module_ids;
+
+    // The ReJIT thread allocates while it starts, it is idle afterwards
+    profiler_info.WaitForInitializedThread();
+    const auto initial = MemorySnapshot::Take();
+
+    // The first load fills the process wide caches (interned names, assembly references) and sizes the maps
+    LoadAndUnloadModule(0x1000, handler, cache, module_ids);
+    const auto baseline = MemorySnapshot::Take();
+
+    for (ModuleID module_id = 0x2000; module_id < 0x2000 + 1000; module_id++)
+    {
+        LoadAndUnloadModule(module_id, handler, cache, module_ids);
+
+        const auto current = MemorySnapshot::Take();
+        ASSERT_EQ(baseline.objects, current.objects) << "cycle " << module_id;
+        ASSERT_EQ(baseline.bytes, current.bytes) << "cycle " << module_id;
+        ASSERT_EQ(baseline.heap, current.heap) << "cycle " << module_id;
+    }
+
+    EXPECT_EQ(0U, cache.Size());
+    EXPECT_EQ(0U, module_ids.Size());
+    for (size_t i = 0; i < baseline.objects.size(); i++)
+    {
+        if (all_categories[i] != MemoryCategory::AssemblyReference)
+        {
+            EXPECT_EQ(initial.objects[i], baseline.objects[i]) << i;
+            EXPECT_EQ(initial.bytes[i], baseline.bytes[i]) << i;
+        }
+    }
+}
+
+TEST(MemoryAccountingTest, UnloadedModulesAreNotEnqueuedAgain)
+{
+    const auto before = Stats::Instance()->MemoryObjects(MemoryCategory::ModuleId);
+    ModuleIdList module_ids;
+    module_ids.Add(0x1000);
+    module_ids.Add(0x2000);
+    module_ids.Add(0x3000);
+    EXPECT_EQ(before + 3, Stats::Instance()->MemoryObjects(MemoryCategory::ModuleId));
+
+    // ModuleUnloadStarted of the second module, InitializeProfiler then enqueues the remaining ones
+    EXPECT_TRUE(module_ids.Remove(0x2000));
+    EXPECT_FALSE(module_ids.Remove(0x2000));
+    EXPECT_EQ((std::vector<ModuleID>{0x1000, 0x3000}), module_ids.Get());
+    EXPECT_FALSE(module_ids.Contains(0x2000));
+    EXPECT_EQ(before + 2, Stats::Instance()->MemoryObjects(MemoryCategory::ModuleId));
+
+    // An unloaded module is unknown to the list
+    EXPECT_FALSE(module_ids.Remove(0x4000));
+    EXPECT_TRUE(module_ids.Remove(0x1000));
+    EXPECT_TRUE(module_ids.Remove(0x3000));
+    EXPECT_EQ(0U, module_ids.Size());
+    EXPECT_EQ(before, Stats::Instance()->MemoryObjects(MemoryCategory::ModuleId));
+}
+
+TEST(MemoryAccountingTest, ReportsEveryCategory)
+{
+    const auto text = Stats::Instance()->MemoryToString();
+    EXPECT_NE(text.find("ModuleMetadata="), std::string::npos);
+    EXPECT_NE(text.find("RejitMethod="), std::string::npos);
+    EXPECT_NE(text.find("MethodSignature="), std::string::npos);
+    EXPECT_NE(Stats::Instance()->ToString().find(text), std::string::npos);
+}
@@ -93,19 +93,16 @@ TEST_F(MetadataBuilderTest, StoresWrapperMemberRef) {
   ASSERT_EQ(S_OK, hr);
 
   mdMemberRef tmp;
-  auto key_failed = module_metadata_->IsFailedWrapperMemberKey(
-      L"[Samples.ExampleLibrary]Class1.Add_vMin_0.0.0.0_vMax_65535.65535.65535.65535");
-  auto ok = module_metadata_->TryGetWrapperMemberRef(
-      L"[Samples.ExampleLibrary]Class1.Add_vMin_0.0.0.0_vMax_65535.65535.65535.65535", tmp);
+  auto key_failed = module_metadata_->IsFailedWrapperMemberKey(ref3.get_method_cache_key());
+  auto ok = module_metadata_->TryGetWrapperMemberRef(ref3.get_method_cache_key(), tmp);
   EXPECT_TRUE(ok);
   EXPECT_FALSE(key_failed);
   EXPECT_NE(tmp, 0);
 
   tmp = 0;
-  key_failed = module_metadata_->IsFailedWrapperMemberKey(
-      L"[Samples.ExampleLibrary]Class2.Add_vMin_0.0.0.0_vMax_65535.65535.65535.65535");
-  ok = module_metadata_->TryGetWrapperMemberRef(
-      L"[Samples.ExampleLibrary]Class2.Add_vMin_0.0.0.0_vMax_65535.65535.65535.65535", tmp);
+  const MethodReference ref4(L"Samples.ExampleLibrary", L"Class2", L"Add", L"ReplaceTargetMethod", min_ver, max_ver, {}, empty_sig_type_);
+  key_failed = module_metadata_->IsFailedWrapperMemberKey(ref4.get_method_cache_key());
+  ok = module_metadata_->TryGetWrapperMemberRef(ref4.get_method_cache_key(), tmp);
   EXPECT_FALSE(ok);
   EXPECT_FALSE(key_failed);
   EXPECT_EQ(tmp, 0);
@@ -124,9 +121,8 @@ TEST_F(MetadataBuilderTest, StoresWrapperMemberRefForSeparateAssembly) {
   ASSERT_EQ(S_OK, hr);
 
   mdMemberRef tmp;
-  auto key_failed = module_metadata_->IsFailedWrapperMemberKey(L"[Samples.ExampleLibraryTracer]Class1.Add_vMin_0.0.0.0_vMax_65535.65535.65535.65535");
-  auto ok = module_metadata_->TryGetWrapperMemberRef(
-      L"[Samples.ExampleLibraryTracer]Class1.Add_vMin_0.0.0.0_vMax_65535.65535.65535.65535", tmp);
+  auto key_failed = module_metadata_->IsFailedWrapperMemberKey(ref3.get_method_cache_key());
+  auto ok = module_metadata_->TryGetWrapperMemberRef(ref3.get_method_cache_key(), tmp);
   EXPECT_TRUE(ok);
   EXPECT_FALSE(key_failed);
   EXPECT_NE(tmp, 0);
@@ -144,9 +140,11 @@ TEST_F(MetadataBuilderTest, StoresWrapperMemberRefRecordsFailure) {
   auto hr = metadata_builder_->StoreWrapperMethodRef(mr1);
   ASSERT_NE(S_OK, hr);
 
-  auto key_failed = module_metadata_->IsFailedWrapperMemberKey(L"[Samples.ExampleLibraryTracer.AssemblyDoesNotExist]Class1.Add_vMin_0.0.0.0_vMax_65535.65535.65535.65535");
+  auto key_failed = module_metadata_->IsFailedWrapperMemberKey(ref3.get_method_cache_key());
   EXPECT_TRUE(key_failed);
 
-  key_failed = module_metadata_->IsFailedWrapperMemberKey(L"[Samples.ExampleLibraryTracer]Class1.Add_vMin_0.0.0.0_vMax_65535.65535.65535.65535");
+  const MethodReference ref4(L"Samples.ExampleLibraryTracer", L"Class1", L"Add", L"ReplaceTargetMethod",
+                             min_ver, max_ver, {}, empty_sig_type_);
+  key_failed = module_metadata_->IsFailedWrapperMemberKey(ref4.get_method_cache_key());
   EXPECT_FALSE(key_failed);
 }
\ No newline at end of file
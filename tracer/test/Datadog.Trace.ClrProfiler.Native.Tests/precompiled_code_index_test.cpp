@@ -0,0 +1,58 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/precompiled_code_index.h"
+
+#include <vector>
+
+using namespace trace;
+
+TEST(PrecompiledCodeIndexTest, ContainsTargetsAndInliners) {
+  PrecompiledCodeIndex index;
+  EXPECT_FALSE(index.ContainsMethod(1, 0x06000001));
+
+  // CallTarget target
+  EXPECT_TRUE(index.AddMethod(1, 0x06000001));
+  EXPECT_FALSE(index.AddMethod(1, 0x06000001));
+
+  // NGEN inliners of the target in two other modules
+  index.AddMethods({2, 3, 2}, {0x06000010, 0x06000020, 0x06000010});
+
+  EXPECT_TRUE(index.ContainsMethod(1, 0x06000001));
+  EXPECT_TRUE(index.ContainsMethod(2, 0x06000010));
+  EXPECT_TRUE(index.ContainsMethod(3, 0x06000020));
+  EXPECT_FALSE(index.ContainsMethod(1, 0x06000002));
+  EXPECT_FALSE(index.ContainsMethod(2, 0x06000001));
+  EXPECT_EQ(3U, index.MethodCount());
+}
+
+TEST(PrecompiledCodeIndexTest, KnowsTheAppDomainOfStartupHookModules) {
+  PrecompiledCodeIndex index;
+  index.AddStartupHookModule(1, 0x100);
+
+  AppDomainID app_domain_id = 0;
+  EXPECT_TRUE(index.TryGetStartupHookAppDomain(1, &app_domain_id));
+  EXPECT_EQ((AppDomainID) 0x100, app_domain_id);
+  EXPECT_FALSE(index.TryGetStartupHookAppDomain(2, &app_domain_id));
+
+  // A startup hook module only rejects the cached code through its AppDomain, not per method
+  EXPECT_FALSE(index.ContainsMethod(1, 0x06000001));
+}
+
+TEST(PrecompiledCodeIndexTest, ForgetsUnloadedModules) {
+  PrecompiledCodeIndex index;
+  index.AddMethods({1, 1, 2}, {0x06000001, 0x06000002, 0x06000001});
+  index.AddStartupHookModule(1, 0x100);
+
+  index.RemoveModule(1);
+
+  AppDomainID app_domain_id = 0;
+  EXPECT_FALSE(index.ContainsMethod(1, 0x06000001));
+  EXPECT_FALSE(index.ContainsMethod(1, 0x06000002));
+  EXPECT_FALSE(index.TryGetStartupHookAppDomain(1, &app_domain_id));
+  EXPECT_TRUE(index.ContainsMethod(2, 0x06000001));
+  EXPECT_EQ(1U, index.MethodCount());
+  EXPECT_EQ(0U, index.StartupHookModuleCount());
+
+  // A new module reusing the ModuleID starts empty
+  EXPECT_TRUE(index.AddMethod(1, 0x06000001));
+}
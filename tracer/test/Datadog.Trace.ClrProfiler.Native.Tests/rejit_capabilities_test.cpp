@@ -0,0 +1,84 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/rejit_capabilities.h"
+
+using namespace trace;
+
+TEST(RejitCapabilitiesTest, MatrixAllowsRejitWithInlinersOnlyOnKnownGoodRuntimes) {
+  EXPECT_FALSE(IsRequestReJITWithInlinersSupported(RuntimeInformation(COR_PRF_DESKTOP_CLR, 4, 8, 0, 0)));
+  EXPECT_FALSE(IsRequestReJITWithInlinersSupported(RuntimeInformation(COR_PRF_CORE_CLR, 2, 1, 0, 0)));
+  EXPECT_FALSE(IsRequestReJITWithInlinersSupported(RuntimeInformation(COR_PRF_CORE_CLR, 3, 1, 0, 0)));
+  EXPECT_FALSE(IsRequestReJITWithInlinersSupported(RuntimeInformation(COR_PRF_CORE_CLR, 5, 0, 0, 0)));
+  EXPECT_TRUE(IsRequestReJITWithInlinersSupported(RuntimeInformation(COR_PRF_CORE_CLR, 6, 0, 0, 0)));
+  EXPECT_TRUE(IsRequestReJITWithInlinersSupported(RuntimeInformation(COR_PRF_CORE_CLR, 7, 0, 0, 0)));
+
+  // Unknown runtime
+  EXPECT_EQ(nullptr, FindRejitCapabilityRule(RuntimeInformation()));
+  EXPECT_FALSE(IsRequestReJITWithInlinersSupported(RuntimeInformation()));
+}
+
+TEST(RejitCapabilitiesTest, SelfTestConfirmsTheMatrix) {
+  RejitInlinersCapability capability;
+  EXPECT_EQ(RejitInlinersMode::Manual, capability.GetMode());
+
+  capability.Configure(true);
+  EXPECT_EQ(RejitInlinersMode::Pending, capability.GetMode());
+  EXPECT_FALSE(capability.IsRuntimeTracked());
+
+  // The runtime reached the argument validation of the empty request
+  EXPECT_TRUE(capability.ApplySelfTest(E_INVALIDARG));
+  EXPECT_EQ(RejitInlinersMode::Runtime, capability.GetMode());
+
+  // Only the first self-test counts
+  EXPECT_TRUE(capability.ApplySelfTest(E_FAIL));
+}
+
+TEST(RejitCapabilitiesTest, FallsBackWhenTheRuntimeRejectsIt) {
+  RejitInlinersCapability capability;
+
+  capability.Configure(true);
+  EXPECT_FALSE(capability.ApplySelfTest(CORPROF_E_REJIT_INLINING_DISABLED));
+  EXPECT_EQ(RejitInlinersMode::Manual, capability.GetMode());
+
+  capability.Configure(true);
+  ASSERT_TRUE(capability.ApplySelfTest(E_INVALIDARG));
+  EXPECT_TRUE(capability.Fallback());
+  EXPECT_FALSE(capability.Fallback());
+  EXPECT_FALSE(capability.IsRuntimeTracked());
+
+  // Matrix or configuration said no: the self-test never upgrades it
+  capability.Configure(false);
+  EXPECT_FALSE(capability.ApplySelfTest(E_INVALIDARG));
+}
+
+TEST(RejitCapabilitiesTest, HandsOutTheInlinersRecordedBeforeTheFallback) {
+  RejitInlinersCapability capability;
+
+  // Manual mode vetoes the inlining instead
+  EXPECT_FALSE(capability.AddRuntimeTrackedInliner(0x1000, 0x06000001));
+
+  capability.Configure(true);
+  ASSERT_TRUE(capability.ApplySelfTest(E_INVALIDARG));
+  EXPECT_TRUE(capability.AddRuntimeTrackedInliner(0x1000, 0x06000001));
+  EXPECT_TRUE(capability.AddRuntimeTrackedInliner(0x1000, 0x06000001));
+  EXPECT_TRUE(capability.AddRuntimeTrackedInliner(0x1000, 0x06000002));
+  EXPECT_TRUE(capability.AddRuntimeTrackedInliner(0x2000, 0x06000001));
+  EXPECT_TRUE(capability.AddRuntimeTrackedInliner(0x3000, 0x06000003));
+
+  // Unloaded modules are not rejitted
+  capability.RemoveModule(0x2000);
+
+  EXPECT_TRUE(capability.Fallback());
+  EXPECT_FALSE(capability.AddRuntimeTrackedInliner(0x4000, 0x06000001));
+
+  std::vector<ModuleID> modules;
+  std::vector<mdMethodDef> method_defs;
+  capability.TakeRuntimeTrackedInliners(&modules, &method_defs);
+  EXPECT_EQ((std::vector<ModuleID>{0x1000, 0x1000, 0x3000}), modules);
+  EXPECT_EQ((std::vector<mdMethodDef>{0x06000001, 0x06000002, 0x06000003}), method_defs);
+
+  modules.clear();
+  method_defs.clear();
+  capability.TakeRuntimeTrackedInliners(&modules, &method_defs);
+  EXPECT_TRUE(modules.empty());
+}
@@ -0,0 +1,97 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/rejit_handler.h"
+#include "fake_profiler_info.h"
+
+using namespace trace;
+
+namespace
+{
+MethodReplacement CreateMethodReplacement(const WSTRING& wrapper_type)
+{
+  const MethodReference target(WStr("Samples.Target"), WStr("Samples.Target.Client"), WStr("Send"), EmptyWStr,
+                               Version(1, 0, 0, 0), Version(2, 0, 0, 0), {}, {WStr("System.Void")});
+  const MethodReference wrapper(
+      WStr("Datadog.Trace, Version=1.0.0.0, Culture=neutral, PublicKeyToken=def86d061d0d2eeb"), wrapper_type,
+      EmptyWStr, WStr("CallTargetModification"), Version(0, 0, 0, 0), Version(0, 0, 0, 0), {}, {});
+  return MethodReplacement({}, target, wrapper);
+}
+
+void AddMethod(RejitHandlerModule* module, mdMethodDef method_def, const WSTRING& integration_name, bool rewritten)
+{
+  auto method = module->GetOrAddMethod(method_def);
+  method->SetIntegrationName(integration_name);
+  method->SetRewritten(rewritten);
+}
+} // namespace
+
+TEST(RejitHandlerTest, IntegrationNameComesFromTheDefinition) {
+  const IntegrationMethod named(WStr("AdoNet"), CreateMethodReplacement(WStr("Datadog.Trace.AdoNetIntegration")));
+  EXPECT_EQ(WStr("AdoNet"), RejitHandler::GetIntegrationName(named));
+
+  // Definitions without a name fall back to the wrapper type
+  const IntegrationMethod unnamed(EmptyWStr, CreateMethodReplacement(WStr("Datadog.Trace.AdoNetIntegration")));
+  EXPECT_EQ(WStr("Datadog.Trace.AdoNetIntegration"), RejitHandler::GetIntegrationName(unnamed));
+}
+
+TEST(RejitHandlerTest, EnablesOnlyDisabledIntegrations) {
+  FakeProfilerInfo profiler_info;
+  RejitHandler handler(static_cast<ICorProfilerInfo4*>(&profiler_info), nullptr);
+
+  EXPECT_FALSE(handler.IsIntegrationDisabled(WStr("AdoNet")));
+  EXPECT_FALSE(handler.EnableIntegration(WStr("AdoNet")));
+
+  // Nothing was rewritten for the integration, so there is nothing to revert
+  EXPECT_EQ(0U, handler.DisableIntegration(WStr("AdoNet")));
+  EXPECT_TRUE(handler.IsIntegrationDisabled(WStr("AdoNet")));
+  EXPECT_FALSE(handler.IsIntegrationDisabled(WStr("Kafka")));
+  EXPECT_EQ(0U, handler.DisableIntegration(WStr("AdoNet")));
+
+  EXPECT_TRUE(handler.EnableIntegration(WStr("AdoNet")));
+  EXPECT_FALSE(handler.IsIntegrationDisabled(WStr("AdoNet")));
+  EXPECT_FALSE(handler.EnableIntegration(WStr("AdoNet")));
+
+  handler.Shutdown();
+}
+
+TEST(RejitHandlerTest, CountsTheRewrittenMethodsOfAnIntegration) {
+  FakeProfilerInfo profiler_info;
+  RejitHandler handler(static_cast<ICorProfilerInfo4*>(&profiler_info), nullptr);
+
+  auto first = handler.GetOrAddModule(0x1000);
+  AddMethod(first, 0x06000001, WStr("AdoNet"), true);
+  AddMethod(first, 0x06000002, WStr("AdoNet"), false);
+  AddMethod(first, 0x06000003, WStr("Kafka"), true);
+  auto second = handler.GetOrAddModule(0x2000);
+  AddMethod(second, 0x06000001, WStr("AdoNet"), true);
+
+  EXPECT_EQ(2U, handler.GetIntegrationRewrittenMethodCount(WStr("AdoNet")));
+  EXPECT_EQ(1U, handler.GetIntegrationRewrittenMethodCount(WStr("Kafka")));
+  EXPECT_EQ(0U, handler.GetIntegrationRewrittenMethodCount(WStr("Datadog.Trace.AdoNetIntegration")));
+
+  // Unloaded modules are not counted anymore
+  handler.RemoveModule(0x2000);
+  EXPECT_EQ(1U, handler.GetIntegrationRewrittenMethodCount(WStr("AdoNet")));
+
+  handler.Shutdown();
+}
+
+TEST(RejitHandlerTest, DisablingAnIntegrationRevertsItsRewrittenMethods) {
+  FakeProfilerInfo profiler_info;
+  RejitHandler handler(static_cast<ICorProfilerInfo4*>(&profiler_info), nullptr);
+
+  auto module = handler.GetOrAddModule(0x1000);
+  AddMethod(module, 0x06000001, WStr("AdoNet"), true);
+  AddMethod(module, 0x06000002, WStr("AdoNet"), false);
+  AddMethod(module, 0x06000003, WStr("Kafka"), true);
+
+  EXPECT_EQ(1U, handler.DisableIntegration(WStr("AdoNet")));
+  EXPECT_EQ(0U, handler.DisableIntegration(WStr("AdoNet")));
+
+  // The revert runs on the ReJIT thread, Shutdown waits for it
+  handler.Shutdown();
+  const auto reverts = profiler_info.GetRevertRequests();
+  ASSERT_EQ(1U, reverts.size());
+  EXPECT_EQ(ModuleID(0x1000), reverts[0].first);
+  EXPECT_EQ(mdMethodDef(0x06000001), reverts[0].second);
+}
@@ -0,0 +1,115 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/clr_helpers.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/sig_helpers.h"
+
+#include <vector>
+
+using namespace trace;
+
+namespace
+{
+// instance void M(int32, string&, valuetype TypeDef(3), class TypeRef(5)<int32>)
+const std::vector<COR_SIGNATURE> instance_method = {0x20, 0x04, 0x01, 0x08, 0x10, 0x0E,
+                                                    0x11, 0x0C, 0x15, 0x12, 0x15, 0x01, 0x08};
+
+// !!0 M<T>(!!0)
+const std::vector<COR_SIGNATURE> generic_method = {0x30, 0x01, 0x01, 0x1E, 0x00, 0x1E, 0x00};
+
+// void M(int32*)
+const std::vector<COR_SIGNATURE> pointer_method = {0x00, 0x01, 0x01, 0x0F, 0x08};
+} // namespace
+
+TEST(SigHelpersTest, DecodesArgumentsInOnePass) {
+  const auto decoded = DecodeMethodSignature(instance_method.data(), (unsigned) instance_method.size());
+  ASSERT_EQ(S_OK, decoded->hr);
+  EXPECT_EQ(0UL, decoded->numberOfTypeArguments);
+  ASSERT_EQ(4UL, decoded->numberOfArguments);
+  ASSERT_EQ(4U, decoded->params.size());
+
+  EXPECT_EQ((unsigned) ELEMENT_TYPE_VOID, decoded->ret.elementType);
+  EXPECT_EQ(TypeFlagVoid, decoded->ret.typeFlags);
+
+  const auto& args = decoded->params;
+  EXPECT_EQ(3UL, args[0].offset);
+  EXPECT_EQ(1UL, args[0].length);
+  EXPECT_EQ((unsigned) ELEMENT_TYPE_I4, args[0].elementType);
+  EXPECT_EQ(TypeFlagBoxedType, args[0].typeFlags);
+
+  EXPECT_EQ(4UL, args[1].offset);
+  EXPECT_EQ(2UL, args[1].length);
+  EXPECT_EQ((unsigned) ELEMENT_TYPE_STRING, args[1].elementType);
+  EXPECT_EQ(TypeFlagByRef, args[1].typeFlags);
+
+  EXPECT_EQ((unsigned) ELEMENT_TYPE_VALUETYPE, args[2].elementType);
+  EXPECT_EQ(TypeFlagBoxedType, args[2].typeFlags);
+  EXPECT_EQ(TokenFromRid(3, mdtTypeDef), args[2].typeToken);
+
+  EXPECT_EQ(8UL, args[3].offset);
+  EXPECT_EQ(5UL, args[3].length);
+  EXPECT_EQ((unsigned) ELEMENT_TYPE_GENERICINST, args[3].elementType);
+  EXPECT_EQ(0, args[3].typeFlags);
+  EXPECT_EQ(TokenFromRid(5, mdtTypeRef), args[3].typeToken);
+
+  unsigned element_type = 0;
+  EXPECT_EQ(TypeFlagByRef, args[1].GetTypeFlags(element_type));
+  EXPECT_EQ((unsigned) ELEMENT_TYPE_STRING, element_type);
+}
+
+TEST(SigHelpersTest, DecodesGenericMethods) {
+  FunctionMethodSignature signature(generic_method.data(), (unsigned) generic_method.size());
+  ASSERT_EQ(S_OK, signature.TryParse());
+  EXPECT_EQ(1UL, signature.NumberOfTypeArguments());
+  EXPECT_EQ(1UL, signature.NumberOfArguments());
+
+  unsigned element_type = 0;
+  EXPECT_EQ(TypeFlagBoxedType, signature.GetRet().GetTypeFlags(element_type));
+  EXPECT_EQ((unsigned) ELEMENT_TYPE_MVAR, element_type);
+  EXPECT_EQ(5UL, signature.GetMethodArguments()[0].offset);
+}
+
+TEST(SigHelpersTest, RejectsWhatCallTargetCannotInstrument) {
+  EXPECT_EQ(E_FAIL, DecodeMethodSignature(pointer_method.data(), (unsigned) pointer_method.size())->hr);
+
+  // The full grammar still walks it
+  PCCOR_SIGNATURE current = pointer_method.data();
+  const PCCOR_SIGNATURE end = pointer_method.data() + pointer_method.size();
+  EXPECT_TRUE(ParseMethod(current, end, SignatureGrammar::Full));
+  EXPECT_EQ(end, current);
+
+  current = pointer_method.data() + 3;
+  EXPECT_FALSE(ParseParam(current, end, SignatureGrammar::CallTarget));
+}
+
+TEST(SigHelpersTest, RejectsTruncatedSignatures) {
+  for (size_t size = 0; size < instance_method.size(); size++)
+  {
+    EXPECT_EQ(E_FAIL, DecodeMethodSignature(instance_method.data(), (unsigned) size)->hr) << size;
+  }
+
+  // A parameter count larger than the signature
+  const std::vector<COR_SIGNATURE> bad_count = {0x00, 0x7F, 0x01};
+  EXPECT_EQ(E_FAIL, DecodeMethodSignature(bad_count.data(), (unsigned) bad_count.size())->hr);
+}
+
+TEST(SigHelpersTest, CachesDecodedSignaturesPerModuleAndToken) {
+  MethodSignatureCache cache;
+
+  FunctionMethodSignature first(instance_method.data(), (unsigned) instance_method.size());
+  FunctionMethodSignature second(instance_method.data(), (unsigned) instance_method.size());
+  ASSERT_EQ(S_OK, first.TryParse(&cache, 1, 0x06000001));
+  ASSERT_EQ(S_OK, second.TryParse(&cache, 1, 0x06000001));
+  EXPECT_EQ(&first.GetMethodArguments(), &second.GetMethodArguments());
+
+  FunctionMethodSignature failed(pointer_method.data(), (unsigned) pointer_method.size());
+  EXPECT_EQ(E_FAIL, failed.TryParse(&cache, 2, 0x06000001));
+  EXPECT_EQ(2U, cache.Size());
+
+  cache.Remove(1);
+  EXPECT_EQ(1U, cache.Size());
+
+  FunctionMethodSignature third(instance_method.data(), (unsigned) instance_method.size());
+  ASSERT_EQ(S_OK, third.TryParse(&cache, 1, 0x06000001));
+  EXPECT_NE(&first.GetMethodArguments(), &third.GetMethodArguments());
+  EXPECT_EQ(4UL, third.NumberOfArguments());
+}
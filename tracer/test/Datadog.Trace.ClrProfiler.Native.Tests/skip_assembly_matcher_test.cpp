@@ -0,0 +1,200 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/dd_profiler_constants.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/skip_assembly_matcher.h"
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+using namespace trace;
+
+// Assemblies of the Microsoft.NETCore.App and Microsoft.AspNetCore.App shared frameworks,
+// plus a few application assemblies.
+static const std::vector<WSTRING> shared_framework_assemblies = {
+    WStr("Microsoft.CSharp"), WStr("Microsoft.VisualBasic.Core"), WStr("Microsoft.VisualBasic"),
+    WStr("Microsoft.Win32.Primitives"), WStr("Microsoft.Win32.Registry"), WStr("mscorlib"), WStr("netstandard"),
+    WStr("System.AppContext"), WStr("System.Buffers"), WStr("System.Collections.Concurrent"),
+    WStr("System.Collections.Immutable"), WStr("System.Collections.NonGeneric"), WStr("System.Collections.Specialized"),
+    WStr("System.Collections"), WStr("System.ComponentModel.Annotations"), WStr("System.ComponentModel.DataAnnotations"),
+    WStr("System.ComponentModel.EventBasedAsync"), WStr("System.ComponentModel.Primitives"),
+    WStr("System.ComponentModel.TypeConverter"), WStr("System.ComponentModel"), WStr("System.Configuration"),
+    WStr("System.Console"), WStr("System.Core"), WStr("System.Data.Common"), WStr("System.Data.DataSetExtensions"),
+    WStr("System.Data"), WStr("System.Diagnostics.Contracts"), WStr("System.Diagnostics.Debug"),
+    WStr("System.Diagnostics.DiagnosticSource"), WStr("System.Diagnostics.FileVersionInfo"),
+    WStr("System.Diagnostics.Process"), WStr("System.Diagnostics.StackTrace"),
+    WStr("System.Diagnostics.TextWriterTraceListener"), WStr("System.Diagnostics.Tools"),
+    WStr("System.Diagnostics.TraceSource"), WStr("System.Diagnostics.Tracing"), WStr("System.Drawing.Primitives"),
+    WStr("System.Drawing"), WStr("System.Dynamic.Runtime"), WStr("System.Formats.Asn1"),
+    WStr("System.Globalization.Calendars"), WStr("System.Globalization.Extensions"), WStr("System.Globalization"),
+    WStr("System.IO.Compression.Brotli"), WStr("System.IO.Compression.FileSystem"),
+    WStr("System.IO.Compression.ZipFile"), WStr("System.IO.Compression"), WStr("System.IO.FileSystem.AccessControl"),
+    WStr("System.IO.FileSystem.DriveInfo"), WStr("System.IO.FileSystem.Primitives"), WStr("System.IO.FileSystem.Watcher"),
+    WStr("System.IO.FileSystem"), WStr("System.IO.IsolatedStorage"), WStr("System.IO.MemoryMappedFiles"),
+    WStr("System.IO.Pipes.AccessControl"), WStr("System.IO.Pipes"), WStr("System.IO.UnmanagedMemoryStream"),
+    WStr("System.IO"), WStr("System.Linq.Expressions"), WStr("System.Linq.Parallel"), WStr("System.Linq.Queryable"),
+    WStr("System.Linq"), WStr("System.Memory"), WStr("System.Net.Http.Json"), WStr("System.Net.Http"),
+    WStr("System.Net.HttpListener"), WStr("System.Net.Mail"), WStr("System.Net.NameResolution"),
+    WStr("System.Net.NetworkInformation"), WStr("System.Net.Ping"), WStr("System.Net.Primitives"),
+    WStr("System.Net.Quic"), WStr("System.Net.Requests"), WStr("System.Net.Security"), WStr("System.Net.ServicePoint"),
+    WStr("System.Net.Sockets"), WStr("System.Net.WebClient"), WStr("System.Net.WebHeaderCollection"),
+    WStr("System.Net.WebProxy"), WStr("System.Net.WebSockets.Client"), WStr("System.Net.WebSockets"), WStr("System.Net"),
+    WStr("System.Numerics.Vectors"), WStr("System.Numerics"), WStr("System.ObjectModel"), WStr("System.Private.CoreLib"),
+    WStr("System.Private.DataContractSerialization"), WStr("System.Private.Uri"), WStr("System.Private.Xml.Linq"),
+    WStr("System.Private.Xml"), WStr("System.Reflection.DispatchProxy"), WStr("System.Reflection.Emit.ILGeneration"),
+    WStr("System.Reflection.Emit.Lightweight"), WStr("System.Reflection.Emit"), WStr("System.Reflection.Extensions"),
+    WStr("System.Reflection.Metadata"), WStr("System.Reflection.Primitives"), WStr("System.Reflection.TypeExtensions"),
+    WStr("System.Reflection"), WStr("System.Resources.Reader"), WStr("System.Resources.ResourceManager"),
+    WStr("System.Resources.Writer"), WStr("System.Runtime.CompilerServices.Unsafe"),
+    WStr("System.Runtime.CompilerServices.VisualC"), WStr("System.Runtime.Extensions"), WStr("System.Runtime.Handles"),
+    WStr("System.Runtime.InteropServices.RuntimeInformation"), WStr("System.Runtime.InteropServices"),
+    WStr("System.Runtime.Intrinsics"), WStr("System.Runtime.Loader"), WStr("System.Runtime.Numerics"),
+    WStr("System.Runtime.Serialization.Formatters"), WStr("System.Runtime.Serialization.Json"),
+    WStr("System.Runtime.Serialization.Primitives"), WStr("System.Runtime.Serialization.Xml"),
+    WStr("System.Runtime.Serialization"), WStr("System.Runtime"), WStr("System.Security.AccessControl"),
+    WStr("System.Security.Claims"), WStr("System.Security.Cryptography.Algorithms"),
+    WStr("System.Security.Cryptography.Cng"), WStr("System.Security.Cryptography.Csp"),
+    WStr("System.Security.Cryptography.Encoding"), WStr("System.Security.Cryptography.OpenSsl"),
+    WStr("System.Security.Cryptography.Primitives"), WStr("System.Security.Cryptography.X509Certificates"),
+    WStr("System.Security.Principal.Windows"), WStr("System.Security.Principal"), WStr("System.Security.SecureString"),
+    WStr("System.Security"), WStr("System.ServiceModel.Web"), WStr("System.ServiceProcess"),
+    WStr("System.Text.Encoding.CodePages"), WStr("System.Text.Encoding.Extensions"), WStr("System.Text.Encoding"),
+    WStr("System.Text.Encodings.Web"), WStr("System.Text.Json"), WStr("System.Text.RegularExpressions"),
+    WStr("System.Threading.Channels"), WStr("System.Threading.Overlapped"), WStr("System.Threading.Tasks.Dataflow"),
+    WStr("System.Threading.Tasks.Extensions"), WStr("System.Threading.Tasks.Parallel"), WStr("System.Threading.Tasks"),
+    WStr("System.Threading.Thread"), WStr("System.Threading.ThreadPool"), WStr("System.Threading.Timer"),
+    WStr("System.Threading"), WStr("System.Transactions.Local"), WStr("System.Transactions"), WStr("System.ValueTuple"),
+    WStr("System.Web.HttpUtility"), WStr("System.Web"), WStr("System.Windows"), WStr("System.Xml.Linq"),
+    WStr("System.Xml.ReaderWriter"), WStr("System.Xml.Serialization"), WStr("System.Xml.XDocument"),
+    WStr("System.Xml.XPath.XDocument"), WStr("System.Xml.XPath"), WStr("System.Xml.XmlDocument"),
+    WStr("System.Xml.XmlSerializer"), WStr("System.Xml"), WStr("System"), WStr("WindowsBase"),
+    WStr("Microsoft.AspNetCore.Antiforgery"), WStr("Microsoft.AspNetCore.Authentication.Abstractions"),
+    WStr("Microsoft.AspNetCore.Authentication.Cookies"), WStr("Microsoft.AspNetCore.Authentication.Core"),
+    WStr("Microsoft.AspNetCore.Authorization"), WStr("Microsoft.AspNetCore.Components"),
+    WStr("Microsoft.AspNetCore.Diagnostics"), WStr("Microsoft.AspNetCore.Hosting.Abstractions"),
+    WStr("Microsoft.AspNetCore.Hosting"), WStr("Microsoft.AspNetCore.Http.Abstractions"),
+    WStr("Microsoft.AspNetCore.Http"), WStr("Microsoft.AspNetCore.Mvc.Core"), WStr("Microsoft.AspNetCore.Mvc.RazorPages"),
+    WStr("Microsoft.AspNetCore.Mvc"), WStr("Microsoft.AspNetCore.Razor.Language"), WStr("Microsoft.AspNetCore.Routing"),
+    WStr("Microsoft.AspNetCore.Server.Kestrel.Core"), WStr("Microsoft.AspNetCore"),
+    WStr("Microsoft.Extensions.Caching.Memory"), WStr("Microsoft.Extensions.Configuration.Json"),
+    WStr("Microsoft.Extensions.DependencyInjection.Abstractions"), WStr("Microsoft.Extensions.FileProviders.Physical"),
+    WStr("Microsoft.Extensions.Hosting.Abstractions"), WStr("Microsoft.Extensions.Http"),
+    WStr("Microsoft.Extensions.Logging.Abstractions"), WStr("Microsoft.Extensions.Logging"),
+    WStr("Microsoft.Extensions.Options"), WStr("Microsoft.Extensions.Primitives"), WStr("Microsoft.Net.Http.Headers"),
+    WStr("Dapper"), WStr("Npgsql"), WStr("StackExchange.Redis"), WStr("Newtonsoft.Json"), WStr("Samples.Console"),
+    WStr("Datadog.Trace"), WStr("Datadog.Trace.ClrProfiler.Managed.Loader"),
+    WStr("Anonymously Hosted DynamicMethods Assembly"), WStr("ISymWrapper")};
+
+static SkipAssemblyMatch LinearMatch(const WSTRING& name)
+{
+  for (auto&& skip_assembly : skip_assemblies)
+  {
+    if (name == skip_assembly)
+    {
+      return SkipAssemblyMatch::Exact;
+    }
+  }
+
+  for (auto&& skip_assembly_pattern : skip_assembly_prefixes)
+  {
+    if (name.rfind(skip_assembly_pattern, 0) == 0)
+    {
+      return SkipAssemblyMatch::Prefix;
+    }
+  }
+
+  return SkipAssemblyMatch::None;
+}
+
+static WSTRING NameFromPath(const WSTRING& path)
+{
+  const WCHAR* name;
+  size_t length;
+  SkipAssemblyMatcher::GetAssemblyNameFromPath(path.c_str(), &name, &length);
+  return WSTRING(name, length);
+}
+
+TEST(SkipAssemblyMatcherTest, MatchesExactNamesAndPrefixes) {
+  SkipAssemblyMatcher matcher({WStr("mscorlib"), WStr("System")}, {WStr("System.IO"), WStr("Microsoft.Extensions.")});
+
+  EXPECT_EQ(SkipAssemblyMatch::Exact, matcher.Match(WStr("mscorlib")));
+  EXPECT_EQ(SkipAssemblyMatch::Exact, matcher.Match(WStr("System")));
+  EXPECT_EQ(SkipAssemblyMatch::Prefix, matcher.Match(WStr("System.IO")));
+  EXPECT_EQ(SkipAssemblyMatch::Prefix, matcher.Match(WStr("System.IO.Pipes")));
+  EXPECT_EQ(SkipAssemblyMatch::Prefix, matcher.Match(WStr("Microsoft.Extensions.Http")));
+
+  EXPECT_EQ(SkipAssemblyMatch::None, matcher.Match(WStr("")));
+  EXPECT_EQ(SkipAssemblyMatch::None, matcher.Match(WStr("mscorli")));
+  EXPECT_EQ(SkipAssemblyMatch::None, matcher.Match(WStr("mscorlib2")));
+  EXPECT_EQ(SkipAssemblyMatch::None, matcher.Match(WStr("System.I")));
+  EXPECT_EQ(SkipAssemblyMatch::None, matcher.Match(WStr("System.Net.Http")));
+  EXPECT_EQ(SkipAssemblyMatch::None, matcher.Match(WStr("Microsoft.Extensions")));
+}
+
+TEST(SkipAssemblyMatcherTest, HandlesEmptyLists) {
+  SkipAssemblyMatcher matcher({}, {});
+  EXPECT_EQ(SkipAssemblyMatch::None, matcher.Match(WStr("System")));
+  EXPECT_EQ(SkipAssemblyMatch::None, matcher.Match(WStr("")));
+}
+
+TEST(SkipAssemblyMatcherTest, DefaultMatcherAgreesWithSkipLists) {
+  for (const auto& name : shared_framework_assemblies)
+  {
+    EXPECT_EQ(LinearMatch(name), SkipAssemblyMatcher::Default().Match(name)) << ToString(name);
+  }
+
+  for (const auto& name : skip_assemblies)
+  {
+    EXPECT_EQ(SkipAssemblyMatch::Exact, SkipAssemblyMatcher::Default().Match(name)) << ToString(name);
+  }
+
+  for (const auto& prefix : skip_assembly_prefixes)
+  {
+    EXPECT_EQ(LinearMatch(prefix), SkipAssemblyMatcher::Default().Match(prefix)) << ToString(prefix);
+  }
+}
+
+TEST(SkipAssemblyMatcherTest, ExtractsAssemblyNameFromPath) {
+  EXPECT_EQ(WStr("System.Runtime"), NameFromPath(WStr("/usr/share/dotnet/shared/System.Runtime.dll")));
+  EXPECT_EQ(WStr("System.Runtime"), NameFromPath(WStr("C:\\Windows\\assembly\\NativeImages\\System.Runtime.ni.dll")));
+  EXPECT_EQ(WStr("Samples.Console.exe"), NameFromPath(WStr("C:\\app/bin\\Samples.Console.exe")));
+  EXPECT_EQ(WStr("System"), NameFromPath(WStr("System")));
+  EXPECT_EQ(WStr(""), NameFromPath(WStr("/tmp/")));
+  EXPECT_EQ(WStr(""), NameFromPath(WStr(".dll")));
+}
+
+TEST(SkipAssemblyMatcherTest, DISABLED_Benchmark) {
+  const int iterations = 2000;
+  const auto& matcher = SkipAssemblyMatcher::Default();
+
+  size_t linearSkipped = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+  {
+    for (const auto& name : shared_framework_assemblies)
+    {
+      linearSkipped += LinearMatch(name) != SkipAssemblyMatch::None;
+    }
+  }
+  const auto linear = std::chrono::steady_clock::now() - start;
+
+  size_t matcherSkipped = 0;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+  {
+    for (const auto& name : shared_framework_assemblies)
+    {
+      matcherSkipped += matcher.Match(name.c_str(), name.size()) != SkipAssemblyMatch::None;
+    }
+  }
+  const auto precomputed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(linearSkipped, matcherSkipped);
+
+  const auto lookups = (double) iterations * shared_framework_assemblies.size();
+  std::cout << "[ BENCHMARK] " << shared_framework_assemblies.size() << " assemblies: linear="
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(linear).count() / lookups
+            << "ns/lookup, matcher="
+            << std::chrono::duration_cast<std::chrono::nanoseconds>(precomputed).count() / lookups << "ns/lookup"
+            << std::endl;
+}
@@ -0,0 +1,317 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/span_flusher.h"
+#include "../../src/Datadog.Trace.ClrProfiler.Native/stats.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace trace;
+
+namespace
+{
+// A span buffer with a single trace of spanCount spans, every string being "web".
+std::vector<uint8_t> CreateSpanBuffer(uint64_t trace_id, uint32_t spanCount = 1)
+{
+  const WSTRING chars = WStr("web");
+  const SpanBufferHeader header = {span_buffer_version, 1, spanCount, 0, 0, (uint32_t) chars.size()};
+  const SpanBufferTrace trace = {0, spanCount};
+
+  std::vector<uint8_t> buffer(sizeof(header) + sizeof(trace) + spanCount * sizeof(SpanBufferSpan) +
+                              chars.size() * sizeof(WCHAR));
+  auto out = buffer.data();
+  std::memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  std::memcpy(out, &trace, sizeof(trace));
+  out += sizeof(trace);
+  for (uint32_t i = 0; i < spanCount; i++)
+  {
+    SpanBufferSpan span = {};
+    span.trace_id = trace_id;
+    span.span_id = trace_id + i;
+    span.parent_id = i == 0 ? 0 : trace_id;
+    span.name = {0, 3};
+    span.resource = {0, 3};
+    span.service = {0, 3};
+    span.type = {0, 3};
+    std::memcpy(out, &span, sizeof(span));
+    out += sizeof(span);
+  }
+  std::memcpy(out, chars.data(), chars.size() * sizeof(WCHAR));
+  return buffer;
+}
+
+// Number of traces of a payload: the array header the flusher writes is always an array32.
+uint32_t GetTraceCount(const std::vector<uint8_t>& payload)
+{
+  EXPECT_EQ(0xDD, payload[0]);
+  return ((uint32_t) payload[1] << 24) | ((uint32_t) payload[2] << 16) | ((uint32_t) payload[3] << 8) | payload[4];
+}
+
+template <typename Predicate>
+bool WaitFor(Predicate predicate)
+{
+  for (int i = 0; i < 500 && !predicate(); i++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return predicate();
+}
+} // namespace
+
+TEST(RecordRingBufferTest, KeepsRecordsInOrderUntilFull) {
+  RecordRingBuffer buffer(3, 16);
+  EXPECT_EQ(4U, buffer.Capacity());
+
+  const uint8_t records[5][2] = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+  EXPECT_EQ(RecordEnqueueResult::Accepted, buffer.TryEnqueue(records[0], 2));
+  EXPECT_EQ(RecordEnqueueResult::Accepted, buffer.TryEnqueue(records[1], 2));
+  EXPECT_EQ(RecordEnqueueResult::Accepted, buffer.TryEnqueue(records[2], 2));
+  EXPECT_EQ(RecordEnqueueResult::AcceptedAboveWatermark, buffer.TryEnqueue(records[3], 2));
+  EXPECT_EQ(RecordEnqueueResult::Full, buffer.TryEnqueue(records[4], 2));
+  EXPECT_EQ(RecordEnqueueResult::TooLarge, buffer.TryEnqueue(records[4], 17));
+  EXPECT_EQ(4U, buffer.ApproximateSize());
+
+  RingBufferRecord peeked[8];
+  ASSERT_EQ(4U, buffer.Peek(peeked, 8));
+  for (int i = 0; i < 4; i++)
+  {
+    ASSERT_EQ(2U, peeked[i].size);
+    EXPECT_EQ(i + 1, peeked[i].data[0]);
+  }
+
+  // Peek doesn't consume
+  ASSERT_EQ(2U, buffer.Peek(peeked, 2));
+  buffer.Release(2);
+  EXPECT_EQ(2U, buffer.ApproximateSize());
+
+  // The released slots are reused
+  EXPECT_EQ(RecordEnqueueResult::Accepted, buffer.TryEnqueue(records[4], 2));
+  ASSERT_EQ(3U, buffer.Peek(peeked, 8));
+  EXPECT_EQ(3, peeked[0].data[0]);
+  EXPECT_EQ(5, peeked[2].data[0]);
+  buffer.Release(3);
+  EXPECT_EQ(0U, buffer.Peek(peeked, 8));
+}
+
+TEST(RecordRingBufferTest, ConcurrentProducersKeepTheirOwnOrder) {
+  const int producers = 4;
+  const uint32_t records = 5000;
+  RecordRingBuffer buffer(256, 16);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++)
+  {
+    threads.emplace_back([&buffer, p] {
+      for (uint32_t i = 0; i < records; i++)
+      {
+        uint8_t record[8];
+        std::memcpy(record, &p, sizeof(int));
+        std::memcpy(record + 4, &i, sizeof(i));
+        while (buffer.TryEnqueue(record, sizeof(record)) == RecordEnqueueResult::Full)
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<uint32_t> next(producers, 0);
+  uint64_t received = 0;
+  bool ordered = true;
+  RingBufferRecord peeked[16];
+  while (received < (uint64_t) producers * records)
+  {
+    const auto count = buffer.Peek(peeked, 16);
+    for (size_t i = 0; i < count; i++)
+    {
+      int p;
+      uint32_t value;
+      std::memcpy(&p, peeked[i].data, sizeof(p));
+      std::memcpy(&value, peeked[i].data + 4, sizeof(value));
+      ordered = ordered && value == next[p];
+      next[p] = value + 1;
+    }
+    buffer.Release(count);
+    received += count;
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_TRUE(ordered);
+  for (int p = 0; p < producers; p++)
+  {
+    EXPECT_EQ(records, next[p]);
+  }
+}
+
+TEST(SpanFlusherTest, FlushesOnBatchSizeAndInterval) {
+  auto sink = std::make_unique<InProcessSpanSink>();
+  auto sinkPtr = sink.get();
+
+  SpanFlusherOptions options;
+  options.batch_size = 4;
+  options.flush_interval = std::chrono::milliseconds(200);
+  SpanFlusher flusher(std::move(sink), options);
+  ASSERT_TRUE(flusher.Start());
+
+  // Batch size reached
+  for (uint64_t i = 1; i <= 4; i++)
+  {
+    const auto buffer = CreateSpanBuffer(i * 100, 2);
+    EXPECT_EQ(S_OK, flusher.Enqueue(buffer.data(), buffer.size()));
+  }
+  ASSERT_TRUE(WaitFor([sinkPtr] { return sinkPtr->GetTraceCount() == 4; }));
+
+  // A single record waits for the interval
+  const auto buffer = CreateSpanBuffer(500);
+  EXPECT_EQ(S_OK, flusher.Enqueue(buffer.data(), buffer.size()));
+  ASSERT_TRUE(WaitFor([sinkPtr] { return sinkPtr->GetTraceCount() == 5; }));
+
+  uint32_t traces = 0;
+  for (const auto& payload : sinkPtr->GetPayloads())
+  {
+    traces += GetTraceCount(payload);
+  }
+  EXPECT_EQ(5U, traces);
+}
+
+TEST(SpanFlusherTest, ReportsBackpressureDropsAndErrors) {
+  auto sink = std::make_unique<InProcessSpanSink>();
+  auto sinkPtr = sink.get();
+
+  SpanFlusherOptions options;
+  options.capacity = 4;
+  options.batch_size = 100;
+  options.max_record_size = 4096;
+  options.flush_interval = std::chrono::hours(1);
+  SpanFlusher flusher(std::move(sink), options);
+
+  const auto stats = Stats::Instance();
+  const auto dropped = stats->SpanBufferDroppedCount();
+  const auto backpressure = stats->SpanBufferBackpressureCount();
+
+  // Not started yet, nothing drains the buffer
+  const auto buffer = CreateSpanBuffer(1);
+  EXPECT_EQ(S_OK, flusher.Enqueue(buffer.data(), buffer.size()));
+  EXPECT_EQ(S_OK, flusher.Enqueue(buffer.data(), buffer.size()));
+  EXPECT_EQ(S_OK, flusher.Enqueue(buffer.data(), buffer.size()));
+  EXPECT_EQ(S_FALSE, flusher.Enqueue(buffer.data(), buffer.size()));
+  EXPECT_EQ(E_OUTOFMEMORY, flusher.Enqueue(buffer.data(), buffer.size()));
+  const std::vector<uint8_t> large(4097);
+  EXPECT_EQ(E_INVALIDARG, flusher.Enqueue(large.data(), large.size()));
+  EXPECT_EQ(dropped + 2, stats->SpanBufferDroppedCount());
+  EXPECT_EQ(backpressure + 1, stats->SpanBufferBackpressureCount());
+
+  // Flush writes everything enqueued before the call, an invalid record doesn't fail the batch
+  ASSERT_TRUE(flusher.Start());
+  ASSERT_TRUE(flusher.Flush(std::chrono::seconds(5)));
+  EXPECT_EQ(4U, sinkPtr->GetTraceCount());
+  EXPECT_EQ(S_OK, flusher.Enqueue(large.data(), 16));
+  ASSERT_TRUE(flusher.Flush(std::chrono::seconds(5)));
+  EXPECT_EQ(4U, sinkPtr->GetTraceCount());
+
+  // Records are not retried when the sink fails
+  sinkPtr->SetFailing(true);
+  EXPECT_EQ(S_OK, flusher.Enqueue(buffer.data(), buffer.size()));
+  ASSERT_TRUE(flusher.Flush(std::chrono::seconds(5)));
+  sinkPtr->SetFailing(false);
+  ASSERT_TRUE(flusher.Flush(std::chrono::seconds(5)));
+  EXPECT_EQ(4U, sinkPtr->GetTraceCount());
+  EXPECT_EQ(1U, sinkPtr->GetPayloads().size());
+}
+
+TEST(SpanFlusherTest, StopWritesWhatIsLeftToTheFile) {
+  const std::string path = ::testing::TempDir() + "span_flusher_test.msgpack";
+  remove(path.c_str());
+
+  EXPECT_EQ(nullptr, CreateSpanSink("http://localhost:8126"));
+  EXPECT_EQ(nullptr, CreateSpanSink("file:"));
+
+  SpanFlusherOptions options;
+  options.flush_interval = std::chrono::hours(1);
+  auto sink = std::make_unique<FileSpanSink>(path);
+  auto sinkPtr = sink.get();
+  SpanFlusher flusher(std::move(sink), options);
+  ASSERT_TRUE(flusher.Start());
+  for (uint64_t i = 1; i <= 10; i++)
+  {
+    const auto buffer = CreateSpanBuffer(i);
+    ASSERT_EQ(S_OK, flusher.Enqueue(buffer.data(), buffer.size()));
+  }
+  flusher.Stop();
+  EXPECT_FALSE(flusher.IsRunning());
+  EXPECT_EQ(10U, sinkPtr->GetTraceCount());
+
+  // Nothing drains the buffer anymore
+  const auto dropped = Stats::Instance()->SpanBufferDroppedCount();
+  const auto buffer = CreateSpanBuffer(11);
+  EXPECT_EQ(E_ABORT, flusher.Enqueue(buffer.data(), buffer.size()));
+  EXPECT_EQ(dropped + 1, Stats::Instance()->SpanBufferDroppedCount());
+
+  FILE* file = fopen(path.c_str(), "rb");
+  ASSERT_NE(nullptr, file);
+  std::vector<uint8_t> content(64 * 1024);
+  content.resize(fread(content.data(), 1, content.size(), file));
+  fclose(file);
+  remove(path.c_str());
+
+  ASSERT_GT(content.size(), 5U);
+  EXPECT_EQ(10U, GetTraceCount(content));
+}
+
+// Run with --gtest_also_run_disabled_tests --gtest_filter=SpanFlusherTest.DISABLED_Benchmark
+TEST(SpanFlusherTest, DISABLED_Benchmark) {
+  const auto buffer = CreateSpanBuffer(1, 4);
+  const int producers = 4;
+  const int records = 200000;
+  const auto total = (unsigned long long) producers * records;
+
+  // Room for every record, so the figures are the throughput of the buffer and not the cost of dropping
+  auto sink = std::make_unique<InProcessSpanSink>();
+  auto sinkPtr = sink.get();
+  SpanFlusherOptions options;
+  options.capacity = (size_t) total;
+  options.max_record_size = buffer.size();
+  SpanFlusher flusher(std::move(sink), options);
+  ASSERT_TRUE(flusher.Start());
+
+  std::atomic_ullong rejected = {0};
+  std::atomic_ullong enqueueNs = {0};
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; p++)
+  {
+    threads.emplace_back([&] {
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < records; i++)
+      {
+        if (FAILED(flusher.Enqueue(buffer.data(), buffer.size())))
+        {
+          rejected++;
+        }
+      }
+      enqueueNs += (std::chrono::steady_clock::now() - start).count();
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  flusher.Stop();
+  const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  EXPECT_EQ(0U, rejected.load());
+  EXPECT_EQ(total, sinkPtr->GetTraceCount());
+  std::cout << "SpanFlusher: " << enqueueNs.load() / total << " ns per enqueue, " << producers << " producers, "
+            << (unsigned long long) (total / elapsed) << " traces/s written, " << rejected.load() << "/" << total
+            << " dropped" << std::endl;
+}
@@ -0,0 +1,523 @@
+#include "pch.h"
+
+#include "../../src/Datadog.Trace.ClrProfiler.Native/span_serializer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace trace;
+
+namespace
+{
+// Writes the flat span buffer the way the managed tracer does, interning repeated strings.
+class SpanBufferBuilder
+{
+public:
+  std::vector<SpanBufferTrace> traces;
+  std::vector<SpanBufferSpan> spans;
+  std::vector<SpanBufferTag> tags;
+  std::vector<SpanBufferMetric> metrics;
+  WSTRING chars;
+  std::unordered_map<WSTRING, SpanBufferString> interned;
+
+  SpanBufferString String(const WSTRING& value)
+  {
+    const auto find_res = interned.find(value);
+    if (find_res != interned.end())
+    {
+      return find_res->second;
+    }
+
+    const SpanBufferString result = {(uint32_t) chars.size(), (int32_t) value.size()};
+    chars += value;
+    interned[value] = result;
+    return result;
+  }
+
+  static SpanBufferString Null()
+  {
+    return {0, -1};
+  }
+
+  SpanBufferSpan& AddSpan(uint64_t trace_id, uint64_t span_id, uint64_t parent_id, const WSTRING& name)
+  {
+    SpanBufferSpan span = {};
+    span.trace_id = trace_id;
+    span.span_id = span_id;
+    span.parent_id = parent_id;
+    span.start = 1600000000000000000LL;
+    span.duration = 1500000;
+    span.name = String(name);
+    span.resource = String(WStr("GET /api/values"));
+    span.service = String(WStr("web-service"));
+    span.type = String(WStr("web"));
+    span.first_tag = (uint32_t) tags.size();
+    span.first_metric = (uint32_t) metrics.size();
+    spans.push_back(span);
+    return spans.back();
+  }
+
+  void AddTag(const WSTRING& key, const WSTRING& value)
+  {
+    tags.push_back({String(key), String(value)});
+    spans.back().tag_count++;
+  }
+
+  void AddMetric(const WSTRING& key, double value)
+  {
+    metrics.push_back({String(key), value});
+    spans.back().metric_count++;
+  }
+
+  void EndTrace(uint32_t first_span)
+  {
+    traces.push_back({first_span, (uint32_t) spans.size() - first_span});
+  }
+
+  std::vector<uint8_t> Build() const
+  {
+    const SpanBufferHeader header = {span_buffer_version,     (uint32_t) traces.size(),  (uint32_t) spans.size(),
+                                     (uint32_t) tags.size(), (uint32_t) metrics.size(), (uint32_t) chars.size()};
+    std::vector<uint8_t> buffer;
+    Append(buffer, &header, sizeof(header));
+    Append(buffer, traces.data(), traces.size() * sizeof(SpanBufferTrace));
+    Append(buffer, spans.data(), spans.size() * sizeof(SpanBufferSpan));
+    Append(buffer, tags.data(), tags.size() * sizeof(SpanBufferTag));
+    Append(buffer, metrics.data(), metrics.size() * sizeof(SpanBufferMetric));
+    Append(buffer, chars.data(), chars.size() * sizeof(WCHAR));
+    return buffer;
+  }
+
+private:
+  static void Append(std::vector<uint8_t>& buffer, const void* data, size_t size)
+  {
+    const auto bytes = static_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+  }
+};
+
+// Minimal MessagePack reader, enough to check the payload structure.
+class Reader
+{
+public:
+  Reader(const uint8_t* data, size_t size) : data(data), end(data + size)
+  {
+  }
+
+  bool AtEnd() const
+  {
+    return data == end;
+  }
+
+  uint32_t ArrayHeader()
+  {
+    const auto b = Byte();
+    if ((b & 0xF0) == 0x90) return b & 0x0F;
+    if (b == 0xDC) return (uint32_t) BigEndian(2);
+    EXPECT_EQ(0xDD, b);
+    return (uint32_t) BigEndian(4);
+  }
+
+  uint32_t MapHeader()
+  {
+    const auto b = Byte();
+    if ((b & 0xF0) == 0x80) return b & 0x0F;
+    if (b == 0xDE) return (uint32_t) BigEndian(2);
+    EXPECT_EQ(0xDF, b);
+    return (uint32_t) BigEndian(4);
+  }
+
+  bool Nil()
+  {
+    if (data < end && *data == 0xC0)
+    {
+      data++;
+      return true;
+    }
+    return false;
+  }
+
+  std::string String()
+  {
+    const auto b = Byte();
+    size_t length = 0;
+    if ((b & 0xE0) == 0xA0) length = b & 0x1F;
+    else if (b == 0xD9) length = (size_t) BigEndian(1);
+    else if (b == 0xDA) length = (size_t) BigEndian(2);
+    else
+    {
+      EXPECT_EQ(0xDB, b);
+      length = (size_t) BigEndian(4);
+    }
+    std::string value(reinterpret_cast<const char*>(data), length);
+    data += length;
+    return value;
+  }
+
+  uint64_t UInt()
+  {
+    const auto b = Byte();
+    if (b < 0x80) return b;
+    if (b == 0xCC) return BigEndian(1);
+    if (b == 0xCD) return BigEndian(2);
+    if (b == 0xCE) return BigEndian(4);
+    EXPECT_EQ(0xCF, b);
+    return BigEndian(8);
+  }
+
+  int64_t Int()
+  {
+    const auto b = *data;
+    if (b >= 0xE0)
+    {
+      data++;
+      return (int8_t) b;
+    }
+    if (b == 0xD0) return (data++, (int8_t) BigEndian(1));
+    if (b == 0xD1) return (data++, (int16_t) BigEndian(2));
+    if (b == 0xD2) return (data++, (int32_t) BigEndian(4));
+    if (b == 0xD3) return (data++, (int64_t) BigEndian(8));
+    return (int64_t) UInt();
+  }
+
+  double Double()
+  {
+    EXPECT_EQ(0xCB, Byte());
+    const auto bits = BigEndian(8);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+private:
+  const uint8_t* data;
+  const uint8_t* end;
+
+  uint8_t Byte()
+  {
+    EXPECT_LT(data, end);
+    return *data++;
+  }
+
+  uint64_t BigEndian(int size)
+  {
+    uint64_t value = 0;
+    for (int i = 0; i < size; i++)
+    {
+      value = (value << 8) | Byte();
+    }
+    return value;
+  }
+};
+
+// A web request with a database call, tags and metrics similar to what the integrations produce.
+SpanBufferBuilder CreateWebTraces(int traceCount)
+{
+  SpanBufferBuilder builder;
+  for (int i = 0; i < traceCount; i++)
+  {
+    const auto trace_id = 1000 + (uint64_t) i;
+    const auto first_span = (uint32_t) builder.spans.size();
+
+    builder.AddSpan(trace_id, trace_id * 10, 0, WStr("aspnet_core.request"));
+    builder.AddTag(WStr("http.method"), WStr("GET"));
+    builder.AddTag(WStr("http.url"), WStr("http://localhost:5000/api/values/") + ToWSTRING(std::to_string(i)));
+    builder.AddTag(WStr("http.status_code"), WStr("200"));
+    builder.AddTag(WStr("span.kind"), WStr("server"));
+    builder.AddTag(WStr("language"), WStr("dotnet"));
+    builder.AddTag(WStr("env"), WStr("production"));
+    builder.AddTag(WStr("version"), WStr("1.2.3"));
+    builder.AddTag(WStr("aspnet_core.route"), WStr("api/values/{id}"));
+    builder.AddMetric(WStr("_dd.agent_psr"), 1.0);
+    builder.AddMetric(WStr("_sampling_priority_v1"), 1.0);
+    builder.AddMetric(WStr("_dd.top_level"), 1.0);
+
+    builder.AddSpan(trace_id, trace_id * 10 + 1, trace_id * 10, WStr("sql-server.query"));
+    builder.spans.back().resource = builder.String(WStr("SELECT * FROM [dbo].[Values] WHERE [Id] = @id"));
+    builder.spans.back().type = builder.String(WStr("sql"));
+    builder.AddTag(WStr("db.type"), WStr("sql-server"));
+    builder.AddTag(WStr("db.name"), WStr("values"));
+    builder.AddTag(WStr("span.kind"), WStr("client"));
+    builder.AddTag(WStr("component"), WStr("SqlClient"));
+    builder.AddMetric(WStr("_dd.measured"), 1.0);
+
+    builder.EndTrace(first_span);
+  }
+  return builder;
+}
+} // namespace
+
+TEST(SpanSerializerTest, WritesAgentPayload) {
+  SpanBufferBuilder builder;
+  builder.AddSpan(1, 2, 0, WStr("aspnet_core.request"));
+  builder.AddTag(WStr("http.method"), WStr("GET"));
+  builder.AddMetric(WStr("_sampling_priority_v1"), 2.0);
+  builder.AddSpan(1, 3, 2, WStr("http.request"));
+  builder.spans.back().type = SpanBufferBuilder::Null();
+  builder.spans.back().error = 1;
+  builder.spans.back().start = -5;
+  builder.EndTrace(0);
+  const auto buffer = builder.Build();
+
+  SpanSerializer serializer;
+  const uint8_t* payload = nullptr;
+  size_t payloadSize = 0;
+  ASSERT_EQ(S_OK, serializer.Serialize(buffer.data(), buffer.size(), &payload, &payloadSize));
+
+  Reader reader(payload, payloadSize);
+  ASSERT_EQ(1U, reader.ArrayHeader());
+  ASSERT_EQ(2U, reader.ArrayHeader());
+
+  // Root span: no parent_id and no error
+  ASSERT_EQ(10U, reader.MapHeader());
+  EXPECT_EQ("trace_id", reader.String());
+  EXPECT_EQ(1U, reader.UInt());
+  EXPECT_EQ("span_id", reader.String());
+  EXPECT_EQ(2U, reader.UInt());
+  EXPECT_EQ("name", reader.String());
+  EXPECT_EQ("aspnet_core.request", reader.String());
+  EXPECT_EQ("resource", reader.String());
+  EXPECT_EQ("GET /api/values", reader.String());
+  EXPECT_EQ("service", reader.String());
+  EXPECT_EQ("web-service", reader.String());
+  EXPECT_EQ("type", reader.String());
+  EXPECT_EQ("web", reader.String());
+  EXPECT_EQ("start", reader.String());
+  EXPECT_EQ(1600000000000000000LL, reader.Int());
+  EXPECT_EQ("duration", reader.String());
+  EXPECT_EQ(1500000, reader.Int());
+  EXPECT_EQ("meta", reader.String());
+  ASSERT_EQ(1U, reader.MapHeader());
+  EXPECT_EQ("http.method", reader.String());
+  EXPECT_EQ("GET", reader.String());
+  EXPECT_EQ("metrics", reader.String());
+  ASSERT_EQ(1U, reader.MapHeader());
+  EXPECT_EQ("_sampling_priority_v1", reader.String());
+  EXPECT_EQ(2.0, reader.Double());
+
+  // Child span
+  ASSERT_EQ(12U, reader.MapHeader());
+  EXPECT_EQ("trace_id", reader.String());
+  EXPECT_EQ(1U, reader.UInt());
+  EXPECT_EQ("span_id", reader.String());
+  EXPECT_EQ(3U, reader.UInt());
+  EXPECT_EQ("name", reader.String());
+  EXPECT_EQ("http.request", reader.String());
+  EXPECT_EQ("resource", reader.String());
+  EXPECT_EQ("GET /api/values", reader.String());
+  EXPECT_EQ("service", reader.String());
+  EXPECT_EQ("web-service", reader.String());
+  EXPECT_EQ("type", reader.String());
+  EXPECT_TRUE(reader.Nil());
+  EXPECT_EQ("start", reader.String());
+  EXPECT_EQ(-5, reader.Int());
+  EXPECT_EQ("duration", reader.String());
+  EXPECT_EQ(1500000, reader.Int());
+  EXPECT_EQ("parent_id", reader.String());
+  EXPECT_EQ(2U, reader.UInt());
+  EXPECT_EQ("error", reader.String());
+  EXPECT_EQ(1U, reader.UInt());
+  EXPECT_EQ("meta", reader.String());
+  EXPECT_EQ(0U, reader.MapHeader());
+  EXPECT_EQ("metrics", reader.String());
+  EXPECT_EQ(0U, reader.MapHeader());
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(SpanSerializerTest, EncodesUtf8AndLongStrings) {
+  MessagePackWriter writer;
+
+  // e, a CJK character, a surrogate pair and an unpaired surrogate
+  const WCHAR text[] = {'c', 'a', 'f', 0x00E9, ' ', 0x6F22, 0xD83D, 0xDE00, 0xD800, 'x'};
+  writer.WriteString(text, sizeof(text) / sizeof(WCHAR));
+  Reader reader(writer.Data(), writer.Size());
+  EXPECT_EQ("caf\xC3\xA9 \xE6\xBC\xA2\xF0\x9F\x98\x80\xEF\xBF\xBDx", reader.String());
+
+  const WSTRING long_value(300, 'a');
+  writer.Reset();
+  writer.WriteString(long_value.c_str(), long_value.size());
+  EXPECT_EQ(0xDA, writer.Data()[0]);
+  EXPECT_EQ(std::string(300, 'a'), Reader(writer.Data(), writer.Size()).String());
+}
+
+TEST(SpanSerializerTest, RejectsInvalidBuffers) {
+  auto builder = CreateWebTraces(2);
+  const auto buffer = builder.Build();
+
+  SpanSerializer serializer;
+  const uint8_t* payload = nullptr;
+  size_t payloadSize = 0;
+  ASSERT_EQ(S_OK, serializer.Serialize(buffer.data(), buffer.size(), &payload, &payloadSize));
+
+  // Truncated
+  EXPECT_EQ(E_INVALIDARG, serializer.Serialize(buffer.data(), buffer.size() - 1, &payload, &payloadSize));
+  EXPECT_EQ(E_INVALIDARG, serializer.Serialize(buffer.data(), 4, &payload, &payloadSize));
+  EXPECT_EQ(E_INVALIDARG, serializer.Serialize(nullptr, 0, &payload, &payloadSize));
+
+  // A string outside of the string table
+  auto bad_string = builder;
+  bad_string.tags[1].value.length = (int32_t) bad_string.chars.size();
+  const auto bad_string_buffer = bad_string.Build();
+  EXPECT_EQ(E_INVALIDARG, serializer.Serialize(bad_string_buffer.data(), bad_string_buffer.size(), &payload,
+                                               &payloadSize));
+
+  // Tags of a span outside of the tag table
+  auto bad_tags = builder;
+  bad_tags.spans[0].first_tag = (uint32_t) bad_tags.tags.size();
+  const auto bad_tags_buffer = bad_tags.Build();
+  EXPECT_EQ(E_INVALIDARG, serializer.Serialize(bad_tags_buffer.data(), bad_tags_buffer.size(), &payload,
+                                               &payloadSize));
+
+  // Unknown layout version
+  auto bad_version = buffer;
+  bad_version[0] = 2;
+  EXPECT_EQ(E_INVALIDARG, serializer.Serialize(bad_version.data(), bad_version.size(), &payload, &payloadSize));
+}
+
+TEST(SpanSerializerTest, CopiesRepeatedStringsAndReusesTheArena) {
+  const auto buffer = CreateWebTraces(100).Build();
+
+  SpanSerializer serializer;
+  const uint8_t* payload = nullptr;
+  size_t payloadSize = 0;
+  ASSERT_EQ(S_OK, serializer.Serialize(buffer.data(), buffer.size(), &payload, &payloadSize));
+  const std::vector<uint8_t> first(payload, payload + payloadSize);
+  const auto arena = payload;
+
+  // Same bytes and same arena the second time
+  ASSERT_EQ(S_OK, serializer.Serialize(buffer.data(), buffer.size(), &payload, &payloadSize));
+  EXPECT_EQ(arena, payload);
+  EXPECT_EQ(first, std::vector<uint8_t>(payload, payload + payloadSize));
+
+  // The cached copies decode like the transcoded strings
+  Reader reader(payload, payloadSize);
+  ASSERT_EQ(100U, reader.ArrayHeader());
+  for (int i = 0; i < 100; i++)
+  {
+    ASSERT_EQ(2U, reader.ArrayHeader());
+    ASSERT_EQ(10U, reader.MapHeader());
+    for (int field = 0; field < 8; field++)
+    {
+      const auto key = reader.String();
+      if (key == "trace_id" || key == "span_id")
+      {
+        reader.UInt();
+      }
+      else if (key == "start" || key == "duration")
+      {
+        reader.Int();
+      }
+      else if (key == "service")
+      {
+        EXPECT_EQ("web-service", reader.String());
+      }
+      else
+      {
+        reader.String();
+      }
+    }
+    EXPECT_EQ("meta", reader.String());
+    ASSERT_EQ(8U, reader.MapHeader());
+    for (int tag = 0; tag < 8; tag++)
+    {
+      const auto key = reader.String();
+      const auto value = reader.String();
+      if (key == "http.status_code")
+      {
+        EXPECT_EQ("200", value);
+      }
+      else if (key == "http.url")
+      {
+        EXPECT_EQ("http://localhost:5000/api/values/" + std::to_string(i), value);
+      }
+    }
+    EXPECT_EQ("metrics", reader.String());
+    ASSERT_EQ(3U, reader.MapHeader());
+    for (int metric = 0; metric < 3; metric++)
+    {
+      reader.String();
+      EXPECT_EQ(1.0, reader.Double());
+    }
+
+    // Database span
+    ASSERT_EQ(11U, reader.MapHeader());
+    for (int field = 0; field < 9; field++)
+    {
+      const auto key = reader.String();
+      if (key == "resource")
+      {
+        EXPECT_EQ("SELECT * FROM [dbo].[Values] WHERE [Id] = @id", reader.String());
+      }
+      else if (key == "name" || key == "service" || key == "type")
+      {
+        reader.String();
+      }
+      else
+      {
+        reader.Int();
+      }
+    }
+    EXPECT_EQ("meta", reader.String());
+    const auto tags = reader.MapHeader();
+    for (uint32_t tag = 0; tag < tags * 2; tag++)
+    {
+      reader.String();
+    }
+    EXPECT_EQ("metrics", reader.String());
+    ASSERT_EQ(1U, reader.MapHeader());
+    EXPECT_EQ("_dd.measured", reader.String());
+    reader.Double();
+  }
+  EXPECT_TRUE(reader.AtEnd());
+}
+
+TEST(SpanSerializerTest, WritesPayloadToFile) {
+  const auto buffer = CreateWebTraces(10).Build();
+  const uint8_t* payload = nullptr;
+  size_t payloadSize = 0;
+  ASSERT_EQ(S_OK, SpanSerializer::ForCurrentThread().Serialize(buffer.data(), buffer.size(), &payload, &payloadSize));
+
+  // The file can be replayed to an agent with: curl -X PUT -H "Content-Type: application/msgpack"
+  // -H "X-Datadog-Trace-Count: 10" --data-binary @traces.msgpack http://localhost:8126/v0.4/traces
+  const std::string path = ::testing::TempDir() + "traces.msgpack";
+  FILE* file = fopen(path.c_str(), "wb");
+  ASSERT_NE(nullptr, file);
+  ASSERT_EQ(payloadSize, fwrite(payload, 1, payloadSize, file));
+  fclose(file);
+
+  file = fopen(path.c_str(), "rb");
+  ASSERT_NE(nullptr, file);
+  std::vector<uint8_t> content(payloadSize + 1);
+  EXPECT_EQ(payloadSize, fread(content.data(), 1, content.size(), file));
+  fclose(file);
+  remove(path.c_str());
+
+  Reader reader(content.data(), payloadSize);
+  EXPECT_EQ(10U, reader.ArrayHeader());
+}
+
+// Run with --gtest_also_run_disabled_tests --gtest_filter=SpanSerializerTest.DISABLED_Benchmark
+TEST(SpanSerializerTest, DISABLED_Benchmark) {
+  const auto buffer = CreateWebTraces(1000).Build();
+  SpanSerializer serializer;
+  const uint8_t* payload = nullptr;
+  size_t payloadSize = 0;
+
+  const int iterations = 200;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+  {
+    ASSERT_EQ(S_OK, serializer.Serialize(buffer.data(), buffer.size(), &payload, &payloadSize));
+  }
+  const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  const auto spans = 2000.0 * iterations;
+  std::cout << "SpanSerializer: " << (long long) (spans / elapsed) << " spans/s, "
+            << (long long) (payloadSize * iterations / elapsed / (1024 * 1024)) << " MB/s, " << payloadSize
+            << " bytes per 1000 traces" << std::endl;
+}
@@ -11,7 +11,7 @@ namespace CallTargetNativeTest.NoOp
         public static CallTargetState OnMethodBegin<TTarget, TArg1, TArg2, TArg3, TArg4, TArg5, TArg6, TArg7, TArg8, TArg9>(TTarget instance, TArg1 arg1, TArg2 arg2, TArg3 arg3, TArg4 arg4, TArg5 arg5, TArg6 arg6, TArg7 arg7, TArg8 arg8, TArg9 arg9)
         {
             CallTargetState returnValue = CallTargetState.GetDefault();
-            Console.WriteLine($"ProfilerOK: BeginMethod(Array)<{typeof(Noop9ArgumentsVoidIntegration)}, {typeof(TTarget)}>({instance})");
+            Console.WriteLine($"ProfilerOK: BeginMethod(9)<{typeof(Noop9ArgumentsVoidIntegration)}, {typeof(TTarget)}, {typeof(TArg1)}, {typeof(TArg2)}, {typeof(TArg3)}, {typeof(TArg4)}, {typeof(TArg5)}, {typeof(TArg6)}, {typeof(TArg7)}, {typeof(TArg8)}, {typeof(TArg9)}>({instance}, {arg1}, {arg2}, {arg3}, {arg4}, {arg5}, {arg6}, {arg7}, {arg8}, {arg9})");
             if (instance?.GetType().Name.Contains("ThrowOnBegin") == true)
             {
                 Console.WriteLine("Exception thrown.");
@@ -28,6 +28,20 @@ namespace Samples.AspNetCoreSimpleController
 
             Console.WriteLine();
 
+            if (args.Length > 0 && args[0] == "no-wait")
+            {
+                // Start the host, serve the first request and exit, used by the startup time benchmarks.
+                using (var host = CreateHostBuilder(Array.Empty<string>()).Build())
+                using (var client = new HttpClient())
+                {
+                    host.Start();
+                    Console.WriteLine(client.GetStringAsync("http://localhost:5000/hello").GetAwaiter().GetResult());
+                    host.StopAsync().GetAwaiter().GetResult();
+                }
+
+                return;
+            }
+
             CreateHostBuilder(args).Build().Run();
         }
 